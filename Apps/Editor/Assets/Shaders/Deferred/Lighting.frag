@@ -0,0 +1,25 @@
+#version 430 core
+#include "/Assets/Shaders/Include/ClusteredLights.inc"
+
+in vec2 passTexCoords;
+
+out vec4 fragColour;
+
+uniform sampler2D inputPosition;
+uniform sampler2D inputNormal;
+uniform sampler2D inputAlbedoRoughness;
+uniform sampler2D inputAmbientMetalness;
+uniform sampler2D inputDepth;
+
+void main()
+{
+	if(texture(inputDepth, passTexCoords).r >= 1.0)
+		discard; // Nothing drawn to G-Buffer
+
+	vec4 albedoRoughness = texture(inputAlbedoRoughness, passTexCoords);
+
+	vec3 position = texture(inputPosition, passTexCoords).xyz;
+	vec3 normal = normalize(texture(inputNormal, passTexCoords).xyz);
+
+	fragColour = vec4(ClusteredBlinnPhong(albedoRoughness.rgb, position, normal, gl_FragCoord.xy), 1.0);
+}
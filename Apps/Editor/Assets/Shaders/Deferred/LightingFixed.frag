@@ -0,0 +1,66 @@
+#version 330 core
+#include "/Assets/Shaders/Include/Camera.inc"
+
+// Used instead of Lighting.frag when shader storage buffers are unsupported (below OpenGL 4.3).
+// Lights are set as uniforms instead of being clustered.
+
+// Matches DeferredRenderPipeline::MaxFixedLights
+const int MaxLights = 32;
+
+struct PointLight
+{
+	vec3 Position;
+	float Radius;
+	vec3 Colour;
+};
+
+uniform int lightCount;
+uniform PointLight lights[MaxLights];
+
+in vec2 passTexCoords;
+
+out vec4 fragColour;
+
+uniform sampler2D inputPosition;
+uniform sampler2D inputNormal;
+uniform sampler2D inputAlbedoRoughness;
+uniform sampler2D inputAmbientMetalness;
+uniform sampler2D inputDepth;
+
+vec3 BlinnPhong(vec3 albedo, vec3 fragPosition, vec3 normal)
+{
+	vec3 lighting = albedo * vec3(0.1);
+	vec3 viewDir = normalize(camera.Position - fragPosition);
+	for(int i = 0; i < min(lightCount, MaxLights); i++)
+	{
+		vec3 toLight = lights[i].Position - fragPosition;
+		float distance = length(toLight);
+		if(distance >= lights[i].Radius)
+			continue;
+
+		vec3 lightDir = toLight / distance;
+		vec3 halfwayDir = normalize(lightDir + viewDir);
+		float spec = pow(max(dot(normal, halfwayDir), 0.0), 16.0);
+		vec3 diffuse = max(dot(normal, lightDir), 0.0) * albedo;
+
+		// Fade out towards edge of radius
+		float attenuation = 1.0 - smoothstep(0.0, lights[i].Radius, distance);
+
+		lighting += (diffuse + spec) * lights[i].Colour * attenuation;
+	}
+
+	return lighting;
+}
+
+void main()
+{
+	if(texture(inputDepth, passTexCoords).r >= 1.0)
+		discard; // Nothing drawn to G-Buffer
+
+	vec4 albedoRoughness = texture(inputAlbedoRoughness, passTexCoords);
+
+	vec3 position = texture(inputPosition, passTexCoords).xyz;
+	vec3 normal = normalize(texture(inputNormal, passTexCoords).xyz);
+
+	fragColour = vec4(BlinnPhong(albedoRoughness.rgb, position, normal), 1.0);
+}
@@ -1,11 +1,10 @@
 #version 330 core
+#include "assets://Shaders/Include/DrawData.inc"
 #include "assets://Shaders/Include/Camera.inc"
 
 layout(location = 0) in vec3 position;
 
-uniform mat4 modelMatrix;
-
 void main()
 {
-	gl_Position = camera.ProjectionMatrix * camera.ViewMatrix * modelMatrix * vec4(position, 1.0);
+	gl_Position = camera.ProjectionMatrix * camera.ViewMatrix * GetModelMatrix() * vec4(position, 1.0);
 }
\ No newline at end of file
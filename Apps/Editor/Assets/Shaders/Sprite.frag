@@ -3,11 +3,39 @@
 out vec4 fragColour;
 
 in vec2 passTexCoords;
+in vec4 passColour;
+flat in int passTextureSlot;
 
-uniform sampler2D inputTexture;
+// Must match SpriteBatch::MaxTextureSlots
+uniform sampler2D inputTextures[16];
 uniform vec4 colour = vec4(1.0);
 
+// Sampler arrays can only be indexed by constant expressions in GLSL 3.30
+vec4 SampleSprite(int slot, vec2 uv)
+{
+	switch(slot)
+	{
+	default:
+	case 0:  return texture(inputTextures[0],  uv);
+	case 1:  return texture(inputTextures[1],  uv);
+	case 2:  return texture(inputTextures[2],  uv);
+	case 3:  return texture(inputTextures[3],  uv);
+	case 4:  return texture(inputTextures[4],  uv);
+	case 5:  return texture(inputTextures[5],  uv);
+	case 6:  return texture(inputTextures[6],  uv);
+	case 7:  return texture(inputTextures[7],  uv);
+	case 8:  return texture(inputTextures[8],  uv);
+	case 9:  return texture(inputTextures[9],  uv);
+	case 10: return texture(inputTextures[10], uv);
+	case 11: return texture(inputTextures[11], uv);
+	case 12: return texture(inputTextures[12], uv);
+	case 13: return texture(inputTextures[13], uv);
+	case 14: return texture(inputTextures[14], uv);
+	case 15: return texture(inputTextures[15], uv);
+	}
+}
+
 void main()
 {
-	fragColour = texture(inputTexture, passTexCoords) * colour;
+	fragColour = SampleSprite(passTextureSlot, passTexCoords) * passColour * colour;
 }
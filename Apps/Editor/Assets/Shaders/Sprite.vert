@@ -2,14 +2,21 @@
 #include "assets://Shaders/Include/Camera.inc"
 layout(location = 0) in vec3 position;
 layout(location = 2) in vec2 texCoords;
+layout(location = 4) in vec4 vertexColour;
+layout(location = 5) in float textureSlot;
 
 out vec2 passTexCoords;
+out vec4 passColour;
+flat out int passTextureSlot;
 
+// Sprites are batched with transforms already applied, this is identity
 uniform mat4 modelMatrix;
 
 void main()
 {
 	passTexCoords = texCoords;
+	passColour = vertexColour;
+	passTextureSlot = int(textureSlot + 0.5);
 
 	// passTexCoords.y = 1.0f - passTexCoords.y;
     
@@ -25,6 +25,93 @@ namespace Yonai
 			set => _SetOutputDevice(value.Index);
 		}
 
+		/// <summary>
+		/// Maximum amount of sources mixed at once, or 0 for no limit.
+		/// When more are playing, the least important are made virtual - their play time advances without being mixed.
+		/// </summary>
+		public static uint MaxVoices
+		{
+			get => _GetMaxVoices();
+			set => _SetMaxVoices(value);
+		}
+
+		/// <summary>
+		/// Amount of playing sources being mixed
+		/// </summary>
+		public static uint RealVoiceCount => _GetRealVoiceCount();
+
+		/// <summary>
+		/// Amount of playing sources not being mixed, because they are inaudible or exceed <see cref="MaxVoices"/>
+		/// </summary>
+		public static uint VirtualVoiceCount => _GetVirtualVoiceCount();
+
+		/// <summary>
+		/// Amount of playing sources not being mixed, because they are beyond their maximum attenuation distance from every listener
+		/// </summary>
+		public static uint CulledSourceCount => _GetCulledSourceCount();
+
+		/// <summary>
+		/// Width of cells used to find sources in range of listeners, best set to roughly the maximum attenuation distance of most sources
+		/// </summary>
+		public static float CullingCellSize
+		{
+			get => _GetCullingCellSize();
+			set => _SetCullingCellSize(value);
+		}
+
+		/// <summary>
+		/// Maximum bytes of decoded audio held for short clips, which are decoded once and shared by every source playing them.
+		/// Other clips stay compressed in memory and are decoded while playing. 0 disables the cache.
+		/// </summary>
+		public static ulong DecodeCacheBudget
+		{
+			get => _GetDecodeCacheBudget();
+			set => _SetDecodeCacheBudget(value);
+		}
+
+		/// <summary>
+		/// Longest clip held in the decode cache, in seconds
+		/// </summary>
+		public static float DecodeCacheMaxClipLength
+		{
+			get => _GetDecodeCacheMaxClipLength();
+			set => _SetDecodeCacheMaxClipLength(value);
+		}
+
+		/// <summary>
+		/// Bytes of decoded audio held by the decode cache
+		/// </summary>
+		public static ulong DecodeCacheMemoryUsage => _GetDecodeCacheMemoryUsage();
+
+		/// <summary>
+		/// Clips played that were already decoded, since <see cref="ResetDecodeCacheStats"/>
+		/// </summary>
+		public static uint DecodeCacheHits => _GetDecodeCacheHits();
+
+		/// <summary>
+		/// Clips played that needed decoding, since <see cref="ResetDecodeCacheStats"/>
+		/// </summary>
+		public static uint DecodeCacheMisses => _GetDecodeCacheMisses();
+
+		/// <summary>
+		/// Clips removed to stay within <see cref="DecodeCacheBudget"/>, since <see cref="ResetDecodeCacheStats"/>
+		/// </summary>
+		public static uint DecodeCacheEvictions => _GetDecodeCacheEvictions();
+
+		public static void ResetDecodeCacheStats() => _ResetDecodeCacheStats();
+
+		/// <summary>
+		/// True when there is no output device, and audio is only mixed when rendered with <see cref="RenderToFile"/>.
+		/// Enabled when no playback devices are found, or with the "OfflineAudio" launch argument.
+		/// </summary>
+		public static bool IsOffline => _IsOffline();
+
+		/// <summary>
+		/// Mixes all playing sources in to a WAV file, as fast as possible. Only available when <see cref="IsOffline"/>.
+		/// </summary>
+		/// <returns>True if the file was written</returns>
+		public static bool RenderToFile(string path, float seconds) => _RenderToFile(path, seconds);
+
 		// Called from native code
 		private static void _RefreshDevices()
 		{
@@ -44,7 +131,7 @@ namespace Yonai
 		private static void _OutputDeviceChanged()
 		{
 			uint output = _GetOutputDevice();
-			if(output > Devices.Length)
+			if(output >= Devices.Length)
 				return; // Out of bounds
 
 			m_OutputDevice = Devices[_GetOutputDevice()];
@@ -71,6 +158,27 @@ namespace Yonai
 		[MethodImpl(MethodImplOptions.InternalCall)] private static extern uint _GetOutputDevice();
 		[MethodImpl(MethodImplOptions.InternalCall)] private static extern string _GetDeviceName(uint index);
 		[MethodImpl(MethodImplOptions.InternalCall)] private static extern void _SetOutputDevice(uint index);
+
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern uint _GetMaxVoices();
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern void _SetMaxVoices(uint count);
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern uint _GetRealVoiceCount();
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern uint _GetVirtualVoiceCount();
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern uint _GetCulledSourceCount();
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern float _GetCullingCellSize();
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern void _SetCullingCellSize(float size);
+
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern ulong _GetDecodeCacheBudget();
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern void _SetDecodeCacheBudget(ulong bytes);
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern float _GetDecodeCacheMaxClipLength();
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern void _SetDecodeCacheMaxClipLength(float seconds);
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern ulong _GetDecodeCacheMemoryUsage();
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern uint _GetDecodeCacheHits();
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern uint _GetDecodeCacheMisses();
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern uint _GetDecodeCacheEvictions();
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern void _ResetDecodeCacheStats();
+
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern bool _IsOffline();
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern bool _RenderToFile(string path, float seconds);
 		#endregion
 	}
 }
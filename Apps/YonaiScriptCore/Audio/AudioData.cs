@@ -1,13 +1,38 @@
 using System;
+using System.IO;
 using Yonai.IO;
 using System.Runtime.CompilerServices;
 
 namespace Yonai
 {
-	public struct SoundImportSettings : IImportSettings {}
+	public struct SoundImportSettings : IImportSettings
+	{
+		/// <summary>
+		/// Decodes the clip from disk while playing, instead of holding it in memory.
+		/// Suited to long clips such as music and ambience. Clips in packs are only streamed when stored uncompressed.
+		/// </summary>
+		public bool Stream;
+
+		public SoundImportSettings(bool stream) => Stream = stream;
+	}
 
 	public class AudioData : NativeResourceBase
 	{
+		/// <summary>
+		/// Clips larger than this, in bytes, are streamed when they have no import settings
+		/// </summary>
+		public static long StreamSizeThreshold = 1024 * 1024;
+
+		/// <summary>
+		/// True when the clip is decoded from disk while playing
+		/// </summary>
+		public bool IsStreaming => _IsStreaming(Handle);
+
+		/// <summary>
+		/// Length of the clip, in seconds
+		/// </summary>
+		public float Length => _GetLength(Handle);
+
 		protected override void OnLoad()
 		{
 			ulong resourceID = ResourceID;
@@ -21,16 +46,48 @@ namespace Yonai
 
 		protected override void OnImported()
 		{
+			// Files on disk stream from the file, packed files stream from the mapped pack when stored uncompressed
+			string filePath = null;
+			string packPath = null;
+			string entryPath = null;
+			long size = -1;
+
+			VFSPackMapping pack = VFS.GetMapping(ResourcePath) as VFSPackMapping;
+			if (pack != null)
+			{
+				entryPath = pack.GetPackPath(ResourcePath);
+				if (pack.Archive.GetEntry(entryPath, out ulong entrySize, out bool compressed) && !compressed)
+				{
+					packPath = pack.Archive.Path;
+					size = (long)entrySize;
+				}
+			}
+			else
+			{
+				filePath = VFS.ExpandPath(ResourcePath, true)?.FullPath;
+				if (!string.IsNullOrEmpty(filePath) && File.Exists(filePath))
+					size = new FileInfo(filePath).Length;
+			}
+
 			SoundImportSettings settings;
-			if (TryGetImportSettings(out settings))
-				settings = new SoundImportSettings();
+			if (!TryGetImportSettings(out settings))
+				settings = new SoundImportSettings(size > StreamSizeThreshold);
 
-			_Import(Handle, VFS.Read(ResourcePath));
+			if (settings.Stream && packPath != null)
+				_ImportPackStream(Handle, packPath, entryPath);
+			else if (settings.Stream && size >= 0)
+				_ImportStream(Handle, filePath);
+			else
+				_Import(Handle, VFS.Read(ResourcePath));
 		}
 
 		#region Internal Calls
 		[MethodImpl(MethodImplOptions.InternalCall)] private static extern void _Load(string path, out ulong resourceID, out IntPtr handle);
 		[MethodImpl(MethodImplOptions.InternalCall)] private static extern void _Import(IntPtr handle, byte[] data);
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern void _ImportStream(IntPtr handle, string path);
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern void _ImportPackStream(IntPtr handle, string packPath, string path);
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern bool _IsStreaming(IntPtr handle);
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern float _GetLength(IntPtr handle);
 		#endregion
 	}
-}
\ No newline at end of file
+}
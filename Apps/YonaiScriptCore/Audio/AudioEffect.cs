@@ -0,0 +1,343 @@
+using System;
+using System.Runtime.CompilerServices;
+
+namespace Yonai
+{
+	public enum AudioEffectType : uint
+	{
+		LowPass = 0,
+		HighPass,
+		Compressor,
+		Limiter,
+		Reverb,
+
+		/// <summary>
+		/// Lowers volume while another mixer is playing
+		/// </summary>
+		Ducking
+	}
+
+	public struct AudioEffectSettings
+	{
+		public AudioEffectType Type;
+		public bool Enabled;
+		public float[] Parameters;
+
+		/// <summary>
+		/// Mixer followed by ducking effects
+		/// </summary>
+		public UUID Sidechain;
+	}
+
+	/// <summary>
+	/// Processes audio passing through an <see cref="AudioMixer"/>, added with <see cref="AudioMixer.AddEffect{T}"/>
+	/// </summary>
+	public abstract class AudioEffect
+	{
+		internal IntPtr Handle;
+
+		/// <summary>
+		/// Mixer this effect is applied to, or null once removed
+		/// </summary>
+		public AudioMixer Mixer { get; internal set; }
+
+		public abstract AudioEffectType Type { get; }
+
+		/// <summary>
+		/// Disabled effects pass audio through unchanged
+		/// </summary>
+		public bool Enabled
+		{
+			get => Handle != IntPtr.Zero && _IsEnabled(Handle);
+			set { if (Handle != IntPtr.Zero) _SetEnabled(Handle, value); }
+		}
+
+		public uint ParameterCount => Handle == IntPtr.Zero ? 0 : _GetParameterCount(Handle);
+
+		public float GetParameter(uint index) => Handle == IntPtr.Zero ? 0.0f : _GetParameter(Handle, index);
+
+		/// <summary>
+		/// Sets a parameter, clamped to its range
+		/// </summary>
+		public void SetParameter(uint index, float value)
+		{
+			if (Handle != IntPtr.Zero)
+				_SetParameter(Handle, index, value);
+		}
+
+		internal static AudioEffect Create(AudioEffectType type)
+		{
+			switch (type)
+			{
+				case AudioEffectType.LowPass: return new LowPassEffect();
+				case AudioEffectType.HighPass: return new HighPassEffect();
+				case AudioEffectType.Compressor: return new CompressorEffect();
+				case AudioEffectType.Limiter: return new LimiterEffect();
+				case AudioEffectType.Reverb: return new ReverbEffect();
+				case AudioEffectType.Ducking: return new DuckingEffect();
+				default: return null;
+			}
+		}
+
+		internal virtual AudioEffectSettings GetSettings()
+		{
+			float[] parameters = new float[ParameterCount];
+			for (uint i = 0; i < parameters.Length; i++)
+				parameters[i] = GetParameter(i);
+
+			return new AudioEffectSettings()
+			{
+				Type = Type,
+				Enabled = Enabled,
+				Parameters = parameters,
+				Sidechain = UUID.Invalid
+			};
+		}
+
+		internal virtual void ApplySettings(AudioEffectSettings settings)
+		{
+			Enabled = settings.Enabled;
+			for (uint i = 0; i < (settings.Parameters?.Length ?? 0); i++)
+				SetParameter(i, settings.Parameters[i]);
+		}
+
+		#region Internal Calls
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern bool _IsEnabled(IntPtr handle);
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern void _SetEnabled(IntPtr handle, bool value);
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern uint _GetParameterCount(IntPtr handle);
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern float _GetParameter(IntPtr handle, uint index);
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern void _SetParameter(IntPtr handle, uint index, float value);
+		[MethodImpl(MethodImplOptions.InternalCall)] protected static extern void _SetSidechain(IntPtr handle, ulong mixerID);
+		#endregion
+	}
+
+	public class LowPassEffect : AudioEffect
+	{
+		public override AudioEffectType Type => AudioEffectType.LowPass;
+
+		/// <summary>
+		/// Frequency above which audio is reduced, in Hz
+		/// </summary>
+		public float Cutoff
+		{
+			get => GetParameter(0);
+			set => SetParameter(0, value);
+		}
+
+		public float Resonance
+		{
+			get => GetParameter(1);
+			set => SetParameter(1, value);
+		}
+	}
+
+	public class HighPassEffect : AudioEffect
+	{
+		public override AudioEffectType Type => AudioEffectType.HighPass;
+
+		/// <summary>
+		/// Frequency below which audio is reduced, in Hz
+		/// </summary>
+		public float Cutoff
+		{
+			get => GetParameter(0);
+			set => SetParameter(0, value);
+		}
+
+		public float Resonance
+		{
+			get => GetParameter(1);
+			set => SetParameter(1, value);
+		}
+	}
+
+	public class CompressorEffect : AudioEffect
+	{
+		public override AudioEffectType Type => AudioEffectType.Compressor;
+
+		/// <summary>
+		/// Level above which volume is reduced, in dB
+		/// </summary>
+		public float Threshold
+		{
+			get => GetParameter(0);
+			set => SetParameter(0, value);
+		}
+
+		/// <summary>
+		/// Amount of dB above the threshold for each dB of output above the threshold
+		/// </summary>
+		public float Ratio
+		{
+			get => GetParameter(1);
+			set => SetParameter(1, value);
+		}
+
+		/// <summary>
+		/// Time taken to react to rising levels, in milliseconds
+		/// </summary>
+		public float Attack
+		{
+			get => GetParameter(2);
+			set => SetParameter(2, value);
+		}
+
+		/// <summary>
+		/// Time taken to recover after levels fall, in milliseconds
+		/// </summary>
+		public float Release
+		{
+			get => GetParameter(3);
+			set => SetParameter(3, value);
+		}
+
+		/// <summary>
+		/// Gain applied after compressing, in dB
+		/// </summary>
+		public float MakeupGain
+		{
+			get => GetParameter(4);
+			set => SetParameter(4, value);
+		}
+	}
+
+	public class LimiterEffect : AudioEffect
+	{
+		public override AudioEffectType Type => AudioEffectType.Limiter;
+
+		/// <summary>
+		/// Maximum output level, in dB
+		/// </summary>
+		public float Threshold
+		{
+			get => GetParameter(0);
+			set => SetParameter(0, value);
+		}
+
+		/// <summary>
+		/// Time taken to recover after levels fall, in milliseconds
+		/// </summary>
+		public float Release
+		{
+			get => GetParameter(1);
+			set => SetParameter(1, value);
+		}
+	}
+
+	public class ReverbEffect : AudioEffect
+	{
+		public override AudioEffectType Type => AudioEffectType.Reverb;
+
+		/// <summary>
+		/// Length of the reverb tail, from 0.0 to 1.0
+		/// </summary>
+		public float RoomSize
+		{
+			get => GetParameter(0);
+			set => SetParameter(0, value);
+		}
+
+		/// <summary>
+		/// Reduction of high frequencies in the tail, from 0.0 to 1.0
+		/// </summary>
+		public float Damping
+		{
+			get => GetParameter(1);
+			set => SetParameter(1, value);
+		}
+
+		public float Wet
+		{
+			get => GetParameter(2);
+			set => SetParameter(2, value);
+		}
+
+		public float Dry
+		{
+			get => GetParameter(3);
+			set => SetParameter(3, value);
+		}
+
+		/// <summary>
+		/// Stereo width of the tail, from 0.0 to 1.0
+		/// </summary>
+		public float Width
+		{
+			get => GetParameter(4);
+			set => SetParameter(4, value);
+		}
+	}
+
+	/// <summary>
+	/// Lowers volume while the <see cref="Sidechain"/> mixer is above a threshold, such as lowering music while dialog plays
+	/// </summary>
+	public class DuckingEffect : AudioEffect
+	{
+		public override AudioEffectType Type => AudioEffectType.Ducking;
+
+		private UUID m_SidechainID = UUID.Invalid;
+
+		/// <summary>
+		/// Mixer whose level lowers the volume of this effect's mixer
+		/// </summary>
+		public AudioMixer Sidechain
+		{
+			get => m_SidechainID == UUID.Invalid ? null : Resource.Get<AudioMixer>(m_SidechainID);
+			set => SidechainID = value?.ResourceID ?? UUID.Invalid;
+		}
+
+		public UUID SidechainID
+		{
+			get => m_SidechainID;
+			set
+			{
+				m_SidechainID = value;
+				if (Handle != IntPtr.Zero)
+					_SetSidechain(Handle, m_SidechainID);
+			}
+		}
+
+		/// <summary>
+		/// Sidechain level above which volume is lowered, in dB
+		/// </summary>
+		public float Threshold
+		{
+			get => GetParameter(0);
+			set => SetParameter(0, value);
+		}
+
+		/// <summary>
+		/// Amount volume is lowered, in dB
+		/// </summary>
+		public float Amount
+		{
+			get => GetParameter(1);
+			set => SetParameter(1, value);
+		}
+
+		public float Attack
+		{
+			get => GetParameter(2);
+			set => SetParameter(2, value);
+		}
+
+		public float Release
+		{
+			get => GetParameter(3);
+			set => SetParameter(3, value);
+		}
+
+		internal override AudioEffectSettings GetSettings()
+		{
+			AudioEffectSettings settings = base.GetSettings();
+			settings.Sidechain = m_SidechainID;
+			return settings;
+		}
+
+		internal override void ApplySettings(AudioEffectSettings settings)
+		{
+			base.ApplySettings(settings);
+			SidechainID = settings.Sidechain;
+		}
+	}
+}
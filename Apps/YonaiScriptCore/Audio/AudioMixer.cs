@@ -1,6 +1,7 @@
 ﻿using Yonai.IO;
 using Newtonsoft.Json.Linq;
 using System;
+using System.Collections.Generic;
 using System.Runtime.CompilerServices;
 using System.Net.Configuration;
 
@@ -11,6 +12,7 @@ namespace Yonai
 		public string Name;
 		public float Volume;
 		public UUID ParentMixer;
+		public AudioEffectSettings[] Effects;
 	}
 
 	public class AudioMixer : NativeResourceBase, ISerializable
@@ -19,6 +21,7 @@ namespace Yonai
 		private float m_Volume;
 		private AudioMixer m_ParentMixer;
 		private UUID m_ParentMixerID = UUID.Invalid;
+		private List<AudioEffect> m_Effects = new List<AudioEffect>();
 
 		public string Name
 		{
@@ -59,6 +62,55 @@ namespace Yonai
 			set => ParentMixerID = value?.ResourceID ?? UUID.Invalid;
 		}
 
+		/// <summary>
+		/// Effects applied in order to audio passing through this mixer
+		/// </summary>
+		public IReadOnlyList<AudioEffect> Effects => m_Effects;
+
+		/// <summary>
+		/// Peak output level, after effects
+		/// </summary>
+		public float Level => _GetLevel(Handle);
+
+		/// <summary>
+		/// Adds an effect after all existing effects
+		/// </summary>
+		/// <returns>Added effect, or null if it could not be created</returns>
+		public T AddEffect<T>() where T : AudioEffect, new() => (T)AddEffect(new T());
+
+		/// <inheritdoc cref="AddEffect{T}"/>
+		public AudioEffect AddEffect(AudioEffectType type) => AddEffect(AudioEffect.Create(type));
+
+		private AudioEffect AddEffect(AudioEffect effect)
+		{
+			if (effect == null)
+				return null;
+
+			effect.Handle = _AddEffect(Handle, (uint)effect.Type);
+			if (effect.Handle == IntPtr.Zero)
+				return null;
+
+			effect.Mixer = this;
+			m_Effects.Add(effect);
+			return effect;
+		}
+
+		public void RemoveEffect(AudioEffect effect)
+		{
+			if (effect == null || !m_Effects.Remove(effect))
+				return;
+
+			_RemoveEffect(Handle, effect.Handle);
+			effect.Handle = IntPtr.Zero;
+			effect.Mixer = null;
+		}
+
+		public void ClearEffects()
+		{
+			while (m_Effects.Count > 0)
+				RemoveEffect(m_Effects[m_Effects.Count - 1]);
+		}
+
 		protected override void OnLoad()
 		{
 			ulong resourceID = ResourceID;
@@ -82,20 +134,59 @@ namespace Yonai
 			_SetParent(Handle, m_ParentMixerID = settings.ParentMixer);
 
 			m_ParentMixer = ParentMixerID == UUID.Invalid ? null : Resource.Get<AudioMixer>(ParentMixerID);
+
+			ClearEffects();
+			foreach (AudioEffectSettings effectSettings in settings.Effects ?? new AudioEffectSettings[0])
+				AddEffect(effectSettings.Type)?.ApplySettings(effectSettings);
 		}
 
-		public JObject OnSerialize() => new JObject(
+		public JObject OnSerialize()
+		{
+			JArray effects = new JArray();
+			foreach (AudioEffect effect in m_Effects)
+			{
+				AudioEffectSettings settings = effect.GetSettings();
+				effects.Add(new JObject(
+					new JProperty("Type", settings.Type.ToString()),
+					new JProperty("Enabled", settings.Enabled),
+					new JProperty("Parameters", new JArray(settings.Parameters)),
+					new JProperty("Sidechain", settings.Sidechain.ToString())
+				));
+			}
+
+			return new JObject(
 				new JProperty("Name", Name),
 				new JProperty("Volume", Volume),
-				new JProperty("ParentMixer", ParentMixerID.ToString())
+				new JProperty("ParentMixer", ParentMixerID.ToString()),
+				new JProperty("Effects", effects)
 			);
+		}
 
-		public void OnDeserialize(JObject json) => Import(new AudioMixerImportSettings()
+		public void OnDeserialize(JObject json)
 		{
-			Name		= json["Name"].Value<string>(),
-			Volume		= json["Volume"].Value<float>(),
-			ParentMixer = ulong.Parse(json["ParentMixer"].Value<string>())
-		});
+			List<AudioEffectSettings> effects = new List<AudioEffectSettings>();
+			foreach (JToken effect in (JArray)json["Effects"] ?? new JArray())
+			{
+				if (!Enum.TryParse(effect["Type"].Value<string>(), out AudioEffectType type))
+					continue;
+
+				effects.Add(new AudioEffectSettings()
+				{
+					Type		= type,
+					Enabled		= effect["Enabled"]?.Value<bool>() ?? true,
+					Parameters	= effect["Parameters"]?.ToObject<float[]>() ?? new float[0],
+					Sidechain	= ulong.Parse(effect["Sidechain"]?.Value<string>() ?? "0")
+				});
+			}
+
+			Import(new AudioMixerImportSettings()
+			{
+				Name		= json["Name"].Value<string>(),
+				Volume		= json["Volume"].Value<float>(),
+				ParentMixer = ulong.Parse(json["ParentMixer"].Value<string>()),
+				Effects		= effects.ToArray()
+			});
+		}
 
 		#region Internal Calls
 		[MethodImpl(MethodImplOptions.InternalCall)] private static extern void _Load(string path, out ulong resourceID, out IntPtr handle);
@@ -108,6 +199,10 @@ namespace Yonai
 
 		[MethodImpl(MethodImplOptions.InternalCall)] private static extern ulong _GetParent(IntPtr handle);
 		[MethodImpl(MethodImplOptions.InternalCall)] private static extern void _SetParent(IntPtr handle, ulong value);
+
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern IntPtr _AddEffect(IntPtr handle, uint type);
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern void _RemoveEffect(IntPtr handle, IntPtr effect);
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern float _GetLevel(IntPtr handle);
 		#endregion
 	}
 }
@@ -68,6 +68,7 @@ namespace Yonai
 		private float m_Panning;
 		private bool m_IsLooping;
 		private bool m_Is3D;
+		private int m_Priority;
 		private AudioMixer m_Mixer;
 		private SoundState m_State;
 		private AttenuationSettings m_Attenuation;
@@ -166,6 +167,27 @@ namespace Yonai
 			}
 		}
 
+		/// <summary>
+		/// Sources with a higher priority are mixed before lower priority sources,
+		/// when more are playing than <see cref="Audio.MaxVoices"/>
+		/// </summary>
+		public int Priority
+		{
+			get => m_Priority;
+			set { if (m_Priority != value) _SetPriority(Handle, m_Priority = value); }
+		}
+
+		/// <summary>
+		/// True while playing without being mixed, because the source is inaudible or too many sources are playing
+		/// </summary>
+		public bool IsVirtual => _IsVirtual(Handle);
+
+		/// <summary>
+		/// True while playing beyond the maximum attenuation distance from every listener.
+		/// Culled sources are virtual until back in range.
+		/// </summary>
+		public bool IsCulled => _IsCulled(Handle);
+
 		public bool PlayOnStart { get; set; } = true;
 
 		public bool IsPlaying => _IsPlaying(Handle);
@@ -232,6 +254,7 @@ namespace Yonai
 			m_Panning =	_GetPanning(Handle);
 			m_IsLooping = _GetLooping(Handle);
 			m_Is3D = _GetIs3D(Handle);
+			m_Priority = _GetPriority(Handle);
 			m_State = (SoundState)_GetState(Handle);
 
 			m_Attenuation = new AttenuationSettings();
@@ -289,6 +312,11 @@ namespace Yonai
 		[MethodImpl(MethodImplOptions.InternalCall)] private static extern float _GetAttenuationRolloff(IntPtr handle);
 		[MethodImpl(MethodImplOptions.InternalCall)] private static extern void _SetAttenuationRolloff(IntPtr handle, float value);
 
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern int _GetPriority(IntPtr handle);
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern void _SetPriority(IntPtr handle, int value);
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern bool _IsVirtual(IntPtr handle);
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern bool _IsCulled(IntPtr handle);
+
 		[MethodImpl(MethodImplOptions.InternalCall)] private static extern int _GetAttenuationModel(IntPtr handle);
 		[MethodImpl(MethodImplOptions.InternalCall)] private static extern void _SetAttenuationModel(IntPtr handle, int value);
 		#endregion
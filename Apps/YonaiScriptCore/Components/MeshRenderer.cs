@@ -27,12 +27,43 @@ namespace Yonai
 			}
 		}
 
+		/// <summary>
+		/// Offsets level of detail selection. Each increase of 1 switches to lower detail levels at twice the screen size.
+		/// </summary>
+		public float LODBias
+		{
+			get => _GetLODBias(Handle);
+			set => _SetLODBias(Handle, value);
+		}
+
+		/// <summary>
+		/// Fraction screen size must pass a level's threshold by before switching levels of detail
+		/// </summary>
+		public float LODHysteresis
+		{
+			get => _GetLODHysteresis(Handle);
+			set => _SetLODHysteresis(Handle, value);
+		}
+
+		/// <summary>
+		/// Level of detail drawn last frame
+		/// </summary>
+		public uint CurrentLOD => _GetCurrentLOD(Handle);
+
 		#region Internal Calls
 		[MethodImpl(MethodImplOptions.InternalCall)] private static extern uint _GetMesh(IntPtr handle);
 		[MethodImpl(MethodImplOptions.InternalCall)] private static extern void _SetMesh(IntPtr handle, ulong mesh);
 
 		[MethodImpl(MethodImplOptions.InternalCall)] private static extern uint _GetMaterial(IntPtr handle);
 		[MethodImpl(MethodImplOptions.InternalCall)] private static extern void _SetMaterial(IntPtr handle, ulong material);
+
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern float _GetLODBias(IntPtr handle);
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern void _SetLODBias(IntPtr handle, float value);
+
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern float _GetLODHysteresis(IntPtr handle);
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern void _SetLODHysteresis(IntPtr handle, float value);
+
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern uint _GetCurrentLOD(IntPtr handle);
 		#endregion
 	}
 }
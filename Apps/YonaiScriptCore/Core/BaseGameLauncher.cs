@@ -21,9 +21,9 @@ namespace Yonai
 		private static void Launch()
 		{
 			VFS.Mount("build://", Application.ExecutableDirectory + "/Assets");
-			VFS.Mount("assets://", "build://Editor");
-			VFS.Mount("assets://", "build://ProjectFiles");
-			VFS.Mount("project://Assets/", "build://ProjectFiles");
+			MountAssets("assets://", "build://Editor");
+			MountAssets("assets://", "build://ProjectFiles");
+			MountAssets("project://Assets/", "build://ProjectFiles");
 
 			JSON = LoadJSON("build://Launch.json");
 
@@ -41,6 +41,17 @@ namespace Yonai
 				LoadInitialScene();
 		}
 
+		/// <summary>
+		/// Mounts the pack built from <paramref name="directory"/> if one exists, otherwise the loose directory
+		/// </summary>
+		private static void MountAssets(string mountPoint, string directory)
+		{
+			if (VFS.Exists(directory + ".pak"))
+				VFS.Mount<VFSPackMapping>(mountPoint, directory + ".pak");
+			else
+				VFS.Mount(mountPoint, directory);
+		}
+
 		private static void LoadAssemblies()
 		{
 			foreach (string path in JSON["Assemblies"].Values<string>())
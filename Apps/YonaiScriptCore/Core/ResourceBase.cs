@@ -24,8 +24,14 @@ namespace Yonai
 		/// </summary>
 		protected virtual void OnImported() { }
 
+		/// <summary>
+		/// When a resource this depends on was reloaded, see <see cref="Resource.AddDependency"/>
+		/// </summary>
+		protected virtual void OnDependencyReloaded() { }
+
 		internal void _Load() => OnLoad();
 		internal void _Unload() => OnUnload();
+		internal void _OnDependencyReloaded() => OnDependencyReloaded();
 
 		public void Import(IImportSettings settings)
 		{
@@ -167,6 +167,64 @@ namespace Yonai
 			_Unload(resourceID);
 		}
 
+		/// <summary>
+		/// Queues a resource, and resources depending on it, to be reloaded at the start of the next frame
+		/// </summary>
+		public static void Invalidate(UUID resourceID) => _Invalidate(resourceID);
+
+		/// <summary>
+		/// Queues the resource at <paramref name="path"/>, and resources using the file at <paramref name="path"/>, to be reloaded
+		/// </summary>
+		public static void Invalidate(string path)
+		{
+			// Resources only known to scripts
+			if (s_Paths.TryGetValue(path, out UUID resourceID))
+				_Invalidate(resourceID);
+			_InvalidatePath(path);
+		}
+
+		/// <summary>
+		/// Reloads <paramref name="dependent"/> after <paramref name="dependency"/> is reloaded
+		/// </summary>
+		public static void AddDependency(UUID dependent, UUID dependency) => _AddDependency(dependent, dependency);
+		public static void RemoveDependency(UUID dependent, UUID dependency) => _RemoveDependency(dependent, dependency);
+
+		/// <returns>IDs of resources directly depending on <paramref name="resourceID"/></returns>
+		public static UUID[] GetDependents(UUID resourceID) =>
+			Array.ConvertAll(_GetDependents(resourceID), id => (UUID)id);
+
+		/// <summary>
+		/// Called by the engine when a resource, or one of its dependencies, has changed
+		/// </summary>
+		/// <returns>True if reloaded</returns>
+		private static bool _Reload(ulong resourceID, bool sourceChanged)
+		{
+			ResourceBase resource = Get(resourceID);
+			if (!resource)
+				return false;
+
+			if (!sourceChanged)
+			{
+				resource._OnDependencyReloaded();
+				return true;
+			}
+
+			// Resources stored as their own serialized file, such as materials
+			if (resource is ISerializable serializable &&
+				resource.GetType().GetCustomAttribute<SerializeFileOptionsAttribute>() == null &&
+				VFS.Exists(resource.ResourcePath))
+			{
+				Log.Trace($"Reloading resource '{resource.ResourcePath}' from disk");
+				serializable.OnDeserialize(VFS.ReadJSON(resource.ResourcePath));
+				return true;
+			}
+
+			// Resources imported from a source file, such as textures and models
+			Log.Trace($"Reimporting resource '{resource.ResourcePath}'");
+			resource.Import(resource.ImportSettings);
+			return true;
+		}
+
 		/// <returns>Instance of resource with matching ID, or null if ID is invalid</returns>
 		public static T Get<T>(UUID resourceID) where T : ResourceBase, new()
 		{
@@ -399,6 +457,11 @@ namespace Yonai
 		[MethodImpl(MethodImplOptions.InternalCall)] private static extern ulong _Duplicate(ulong resourceID, string newPath);
 		[MethodImpl(MethodImplOptions.InternalCall)] private static extern string _GetPath(ulong resourceID);
 		[MethodImpl(MethodImplOptions.InternalCall)] private static extern IntPtr _GetInstance(ulong resourceID);
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern void _Invalidate(ulong resourceID);
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern void _InvalidatePath(string path);
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern void _AddDependency(ulong dependent, ulong dependency);
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern void _RemoveDependency(ulong dependent, ulong dependency);
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern ulong[] _GetDependents(ulong resourceID);
 
 		[MethodImpl(MethodImplOptions.InternalCall)] internal static extern void _Print();
 		#endregion
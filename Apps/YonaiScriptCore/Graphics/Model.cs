@@ -10,7 +10,22 @@ namespace Yonai.Graphics
 	{
 		public bool ImportMaterials;
 
-		public ModelImportSettings(bool importMaterials = true) => ImportMaterials = importMaterials;
+		/// <summary>
+		/// Reorders meshes for the GPU's vertex cache and uploads them with quantised vertices
+		/// </summary>
+		public bool OptimiseMeshes;
+
+		/// <summary>
+		/// Amount of simplified levels of detail generated for each mesh, each with half the triangles of the previous level
+		/// </summary>
+		public uint LODCount;
+
+		public ModelImportSettings(bool importMaterials = true, bool optimiseMeshes = false, uint lodCount = 0)
+		{
+			ImportMaterials = importMaterials;
+			OptimiseMeshes = optimiseMeshes;
+			LODCount = lodCount;
+		}
 	}
 
 	[SerializeFileOptions(SaveSeparateFile = true)]
@@ -20,6 +35,10 @@ namespace Yonai.Graphics
 		
 		public bool ImportMaterials { get; private set; }
 
+		public bool OptimiseMeshes { get; private set; }
+
+		public uint LODCount { get; private set; }
+
 		public struct MeshData
 		{
 			public Mesh Mesh;
@@ -53,7 +72,10 @@ namespace Yonai.Graphics
 			// Load model
 			TryGetImportSettings(out ModelImportSettings settings);
 			byte[] modelData = VFS.Read(ResourcePath);
-			_Import(Handle, ResourcePath, modelData, ImportMaterials = settings.ImportMaterials);
+			_Import(Handle, ResourcePath, modelData,
+				ImportMaterials = settings.ImportMaterials,
+				OptimiseMeshes = settings.OptimiseMeshes,
+				LODCount = settings.LODCount);
 
 			// Get meshes
 			_GetMeshes(Handle, out ulong[] meshIDs, out ulong[] materialIDs);
@@ -65,14 +87,20 @@ namespace Yonai.Graphics
 		}
 
 		public JObject OnSerialize() => new JObject(
-				new JProperty("ImportMaterials", ImportMaterials)
+				new JProperty("ImportMaterials", ImportMaterials),
+				new JProperty("OptimiseMeshes", OptimiseMeshes),
+				new JProperty("LODCount", LODCount)
 			);
 
-		public void OnDeserialize(JObject json) => Import(new ModelImportSettings(json["ImportMaterials"].Value<bool>()));
+		public void OnDeserialize(JObject json) => Import(new ModelImportSettings(
+				json["ImportMaterials"].Value<bool>(),
+				json["OptimiseMeshes"]?.Value<bool>() ?? false,
+				json["LODCount"]?.Value<uint>() ?? 0
+			));
 
 		#region Internal Calls
 		[MethodImpl(MethodImplOptions.InternalCall)] private static extern void _Load(string path, out ulong resourceID, out IntPtr handle);
-		[MethodImpl(MethodImplOptions.InternalCall)] private static extern void _Import(IntPtr handle, string filepath, byte[] modelData, bool importMaterials);
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern void _Import(IntPtr handle, string filepath, byte[] modelData, bool importMaterials, bool optimiseMeshes, uint lodCount);
 
 		[MethodImpl(MethodImplOptions.InternalCall)] private static extern void _GetMeshes(IntPtr handle, out ulong[] meshIDs, out ulong[] materialIDs);
 		#endregion
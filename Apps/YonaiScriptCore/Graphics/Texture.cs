@@ -2,6 +2,7 @@ using Yonai.IO;
 using Newtonsoft.Json.Linq;
 using System;
 using System.IO;
+using System.Threading.Tasks;
 using System.Runtime.CompilerServices;
 
 namespace Yonai.Graphics
@@ -41,7 +42,47 @@ namespace Yonai.Graphics
 
 		public TextureFiltering Filter => m_ImportSettings.Filtering;
 
+		/// <summary>
+		/// True while texture data is being decoded or uploaded in the background
+		/// </summary>
+		public bool IsLoading => _IsLoading(Handle);
+
+		/// <summary>
+		/// Completes once the latest upload has finished, with a value of true if successful
+		/// </summary>
+		public Task<bool> Loaded => m_UploadCompletion?.Task ?? Task.FromResult(true);
+
+		/// <summary>
+		/// Invoked on the main thread when an asynchronous upload has finished
+		/// </summary>
+		public event Action<Texture, bool> Uploaded;
+
 		private TextureImportSettings m_ImportSettings => (TextureImportSettings)ImportSettings;
+		private TaskCompletionSource<bool> m_UploadCompletion = null;
+
+		/// <summary>
+		/// Loads a texture, decoding and uploading it in the background.
+		/// </summary>
+		/// <param name="onLoaded">Called once the texture is ready, or immediately if already loaded</param>
+		public static Texture Load(string path, Action<Texture, bool> onLoaded, TextureImportSettings? settings = null)
+		{
+			Texture texture = Resources.Load<Texture>(path, settings);
+			if (!texture)
+				onLoaded?.Invoke(null, false);
+			else if (!texture.IsLoading)
+				onLoaded?.Invoke(texture, true);
+			else if (onLoaded != null)
+			{
+				Action<Texture, bool> callback = null;
+				callback = (loaded, success) =>
+				{
+					texture.Uploaded -= callback;
+					onLoaded(loaded, success);
+				};
+				texture.Uploaded += callback;
+			}
+			return texture;
+		}
 
 		protected override void OnLoad()
 		{
@@ -65,7 +106,13 @@ namespace Yonai.Graphics
 				ImportSettings = importSettings;
 			else
 				ImportSettings = new TextureImportSettings(TextureFiltering.Linear);
-			Upload(VFS.Read(ResourcePath), (TextureImportSettings)ImportSettings);
+
+			// Files on disk are cooked through the import cache, packed files are already cooked
+			string filePath = VFS.ExpandPath(ResourcePath, true)?.FullPath;
+			if (!string.IsNullOrEmpty(filePath) && File.Exists(filePath))
+				ImportAsync(filePath, (TextureImportSettings)ImportSettings);
+			else
+				UploadAsync(VFS.Read(ResourcePath), (TextureImportSettings)ImportSettings);
 		}
 
 		public void Bind(uint index = 0) => _Bind(Handle, index);
@@ -73,6 +120,43 @@ namespace Yonai.Graphics
 		public void Upload(byte[] data, TextureImportSettings settings) =>
 			_Upload(Handle, data, settings.HDR, (int)Filter);
 
+		/// <summary>
+		/// Decodes <paramref name="data"/> on a worker thread, then uploads it over the following frames.
+		/// A placeholder texture is bound until finished.
+		/// </summary>
+		public Task<bool> UploadAsync(byte[] data, TextureImportSettings settings)
+		{
+			// Previous upload is superseded
+			m_UploadCompletion?.TrySetResult(false);
+			m_UploadCompletion = new TaskCompletionSource<bool>();
+
+			_UploadAsync(Handle, ResourceID, data, settings.HDR, (int)settings.Filtering);
+			return m_UploadCompletion.Task;
+		}
+
+		/// <summary>
+		/// Reads and cooks the image file at <paramref name="filePath"/> on a worker thread, then uploads it like <see cref="UploadAsync"/>.
+		/// Unchanged images are read from the import cache.
+		/// </summary>
+		/// <param name="filePath">Path on the device's filesystem</param>
+		public Task<bool> ImportAsync(string filePath, TextureImportSettings settings)
+		{
+			m_UploadCompletion?.TrySetResult(false);
+			m_UploadCompletion = new TaskCompletionSource<bool>();
+
+			_ImportAsync(Handle, ResourceID, filePath, settings.HDR, (int)settings.Filtering);
+			return m_UploadCompletion.Task;
+		}
+
+		private static void _OnUploaded(ulong resourceID, bool success)
+		{
+			if (!(Resources.Get(resourceID) is Texture texture))
+				return;
+
+			texture.Uploaded?.Invoke(texture, success);
+			texture.m_UploadCompletion?.TrySetResult(success);
+		}
+
 		public JObject OnSerialize() =>
 			new JObject(
 				new JProperty("HDR", HDR),
@@ -90,6 +174,9 @@ namespace Yonai.Graphics
 		#region Internal Calls
 		[MethodImpl(MethodImplOptions.InternalCall)] private static extern void _Load(string path, out ulong resourceID, out IntPtr handle);
 		[MethodImpl(MethodImplOptions.InternalCall)] private static extern void _Upload(IntPtr handle, byte[] data, bool hdr, int filter);
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern void _UploadAsync(IntPtr handle, ulong resourceID, byte[] data, bool hdr, int filter);
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern void _ImportAsync(IntPtr handle, ulong resourceID, string path, bool hdr, int filter);
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern bool _IsLoading(IntPtr handle);
 		[MethodImpl(MethodImplOptions.InternalCall)] private static extern void _Bind(IntPtr handle, uint index);
 
 		[MethodImpl(MethodImplOptions.InternalCall)] private static extern string _GetPath(IntPtr handle);
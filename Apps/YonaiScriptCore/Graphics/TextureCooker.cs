@@ -0,0 +1,48 @@
+using System.Runtime.CompilerServices;
+
+namespace Yonai.Graphics
+{
+	public struct TextureCookSettings
+	{
+		/// <summary>
+		/// Decodes source as floating point
+		/// </summary>
+		public bool HDR;
+
+		/// <summary>
+		/// Stores the full mip chain, otherwise only the base level is stored
+		/// </summary>
+		public bool GenerateMips;
+
+		/// <summary>
+		/// Block compresses 8-bit RGB(A) textures
+		/// </summary>
+		public bool Compress;
+
+		public TextureCookSettings(bool hdr, bool generateMips = true, bool compress = false)
+		{
+			HDR = hdr;
+			GenerateMips = generateMips;
+			Compress = compress;
+		}
+	}
+
+	/// <summary>
+	/// Converts source images in to a GPU-ready format with precomputed mip levels.
+	/// Cooked data can be passed to <see cref="Texture.Upload"/> in place of the source image.
+	/// </summary>
+	public static class TextureCooker
+	{
+		/// <returns>Cooked texture, or null if <paramref name="source"/> could not be decoded</returns>
+		public static byte[] Cook(byte[] source, TextureCookSettings settings) =>
+			_Cook(source, settings.HDR, settings.GenerateMips, settings.Compress);
+
+		/// <returns>True if <paramref name="data"/> is already a cooked texture</returns>
+		public static bool IsCooked(byte[] data) => _IsCooked(data);
+
+		#region Internal Calls
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern byte[] _Cook(byte[] source, bool hdr, bool generateMips, bool compress);
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern bool _IsCooked(byte[] data);
+		#endregion
+	}
+}
@@ -0,0 +1,67 @@
+using System;
+using System.Collections.Generic;
+using System.Runtime.CompilerServices;
+
+namespace Yonai.IO
+{
+	public enum FileWatchStatus { Created, Removed, Modified }
+
+	/// <summary>
+	/// Watches a file, or a directory recursively, on the device's filesystem for changes.
+	/// Changes are delivered once per frame on the main thread.
+	/// </summary>
+	public class FileWatcher : IDisposable
+	{
+		private IntPtr m_Handle;
+
+		private static Dictionary<IntPtr, FileWatcher> s_Watchers = new Dictionary<IntPtr, FileWatcher>();
+
+		/// <summary>
+		/// Absolute path being watched
+		/// </summary>
+		public string Path { get; private set; }
+
+		public bool IsWatching => m_Handle != IntPtr.Zero;
+
+		/// <summary>
+		/// Called with the absolute path of a changed file or directory
+		/// </summary>
+		public event Action<string, FileWatchStatus> Changed;
+
+		/// <param name="path">Absolute path on the device's filesystem</param>
+		/// <param name="intervalMs">Time between checking for changes, on platforms where changes are polled</param>
+		public FileWatcher(string path, int intervalMs = 1000)
+		{
+			Path = path;
+			m_Handle = _Create(path, intervalMs);
+			s_Watchers.Add(m_Handle, this);
+
+			// Native watchers outlive the domain, stop them before scripts are reloaded
+			AppDomain.CurrentDomain.DomainUnload += OnDomainUnload;
+		}
+
+		public void Dispose()
+		{
+			if (m_Handle == IntPtr.Zero)
+				return;
+
+			AppDomain.CurrentDomain.DomainUnload -= OnDomainUnload;
+			s_Watchers.Remove(m_Handle);
+			_Destroy(m_Handle);
+			m_Handle = IntPtr.Zero;
+		}
+
+		private void OnDomainUnload(object sender, EventArgs args) => Dispose();
+
+		private static void _OnChanged(IntPtr handle, string path, int status)
+		{
+			if (s_Watchers.TryGetValue(handle, out FileWatcher watcher))
+				watcher.Changed?.Invoke(path.Replace('\\', '/'), (FileWatchStatus)status);
+		}
+
+		#region Internal Calls
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern IntPtr _Create(string path, int intervalMs);
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern void _Destroy(IntPtr handle);
+		#endregion
+	}
+}
@@ -0,0 +1,35 @@
+using System.Runtime.CompilerServices;
+
+namespace Yonai.IO
+{
+	/// <summary>
+	/// Persistent cache of imported assets, keyed by the contents of their source files.
+	/// Unchanged sources are read from the cache instead of being imported again.
+	/// </summary>
+	public static class ImportCache
+	{
+		/// <summary>
+		/// Directory on the device's filesystem containing cached imports
+		/// </summary>
+		public static string Directory
+		{
+			get => _GetDirectory();
+			set => _SetDirectory(value);
+		}
+
+		/// <summary>
+		/// Writes remembered source hashes to disk, also done when the application exits
+		/// </summary>
+		public static void Flush() => _Flush();
+
+		/// <summary>
+		/// Removes all cached imports, sources are imported again when next loaded
+		/// </summary>
+		public static void Clear() => _Clear();
+
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern string _GetDirectory();
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern void _SetDirectory(string directory);
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern void _Flush();
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern void _Clear();
+	}
+}
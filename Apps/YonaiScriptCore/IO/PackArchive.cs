@@ -0,0 +1,91 @@
+using System;
+using System.Runtime.CompilerServices;
+
+namespace Yonai.IO
+{
+	/// <summary>
+	/// Read-only archive of many files in a single memory mapped file, used by shipped builds to avoid a file open per asset
+	/// </summary>
+	public class PackArchive : IDisposable
+	{
+		internal IntPtr Handle { get; private set; }
+
+		/// <summary>
+		/// Absolute path of the pack file on the device's filesystem
+		/// </summary>
+		public string Path { get; private set; }
+
+		public bool IsOpen => Handle != IntPtr.Zero;
+
+		/// <param name="path">Absolute path of the pack file on the device's filesystem</param>
+		public PackArchive(string path)
+		{
+			Path = path;
+			Handle = _Open(path);
+		}
+
+		public void Dispose()
+		{
+			if (Handle != IntPtr.Zero)
+				_Close(Handle);
+			Handle = IntPtr.Zero;
+		}
+
+		/// <param name="path">Path relative to the root of the pack</param>
+		public bool Exists(string path) => IsOpen && _Exists(Handle, path);
+
+		/// <returns>Contents of <paramref name="path"/>, decompressed if required, or null if not in this pack</returns>
+		public byte[] Read(string path) => IsOpen ? _Read(Handle, path) : null;
+
+		/// <summary>
+		/// Gets the size of a file in the pack without reading it
+		/// </summary>
+		/// <param name="size">Size of the file once decompressed, in bytes</param>
+		/// <param name="compressed">True if the file is stored compressed, and can not be read straight from the mapped pack</param>
+		/// <returns>False if <paramref name="path"/> is not in this pack</returns>
+		public bool GetEntry(string path, out ulong size, out bool compressed)
+		{
+			size = 0;
+			compressed = false;
+			return IsOpen && _GetEntry(Handle, path, out size, out compressed);
+		}
+
+		/// <returns>Paths of all files in the pack, relative to its root</returns>
+		public string[] GetFiles() => IsOpen ? _GetFiles(Handle) : new string[0];
+
+		/// <summary>
+		/// Writes files from the device's filesystem in to a new pack
+		/// </summary>
+		/// <param name="outputPath">Absolute path of the pack file to create</param>
+		/// <param name="paths">Path of each file inside the pack</param>
+		/// <param name="filePaths">Absolute path of each file to add, matching <paramref name="paths"/></param>
+		/// <param name="compress">When true, files are LZ4 compressed if that reduces their size</param>
+		public static bool Create(string outputPath, string[] paths, string[] filePaths, bool compress)
+		{
+			bool[] compressFiles = new bool[paths.Length];
+			for (int i = 0; i < compressFiles.Length; i++)
+				compressFiles[i] = compress;
+			return _Create(outputPath, paths, filePaths, compressFiles);
+		}
+
+		/// <summary>
+		/// Writes files from the device's filesystem in to a new pack
+		/// </summary>
+		/// <param name="outputPath">Absolute path of the pack file to create</param>
+		/// <param name="paths">Path of each file inside the pack</param>
+		/// <param name="filePaths">Absolute path of each file to add, matching <paramref name="paths"/></param>
+		/// <param name="compress">Whether each file is LZ4 compressed if that reduces its size, matching <paramref name="paths"/></param>
+		public static bool Create(string outputPath, string[] paths, string[] filePaths, bool[] compress) =>
+			_Create(outputPath, paths, filePaths, compress);
+
+		#region Internal Calls
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern IntPtr _Open(string path);
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern void _Close(IntPtr handle);
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern bool _Exists(IntPtr handle, string path);
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern bool _GetEntry(IntPtr handle, string path, out ulong size, out bool compressed);
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern byte[] _Read(IntPtr handle, string path);
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern string[] _GetFiles(IntPtr handle);
+		[MethodImpl(MethodImplOptions.InternalCall)] private static extern bool _Create(string outputPath, string[] paths, string[] filePaths, bool[] compress);
+		#endregion
+	}
+}
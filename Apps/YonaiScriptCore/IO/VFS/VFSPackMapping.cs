@@ -0,0 +1,163 @@
+using System.IO;
+using System.Collections.Generic;
+
+namespace Yonai.IO
+{
+	/// <summary>
+	/// Read-only mapping of a <see cref="PackArchive"/>, where <see cref="VFSMapping.MountPath"/> is the path of the pack file.
+	/// The pack is opened when first accessed.
+	/// </summary>
+	public class VFSPackMapping : VFSMapping
+	{
+		public override FilePermissions Permissions => FilePermissions.Read;
+
+		private PackArchive m_Archive = null;
+		private string[] m_Files = null;
+		private HashSet<string> m_Directories = null;
+
+		internal PackArchive Archive
+		{
+			get
+			{
+				if (m_Archive == null)
+				{
+					string packPath = VFS.ExpandPath(MountPath, true) ?? MountPath;
+					m_Archive = new PackArchive(packPath);
+					if (!m_Archive.IsOpen)
+						Log.Warning($"Failed to open pack '{MountPath}' mounted at '{MountPoint}'");
+				}
+				return m_Archive;
+			}
+		}
+
+		/// <summary>
+		/// All file paths in the pack, and the directories containing them
+		/// </summary>
+		private string[] Files
+		{
+			get
+			{
+				if (m_Files != null)
+					return m_Files;
+
+				m_Files = Archive.GetFiles();
+				m_Directories = new HashSet<string>();
+				foreach (string file in m_Files)
+					for (int separator = file.IndexOf('/'); separator >= 0; separator = file.IndexOf('/', separator + 1))
+						m_Directories.Add(file.Substring(0, separator + 1));
+				return m_Files;
+			}
+		}
+
+		/// <returns><paramref name="file"/> relative to the root of the pack</returns>
+		internal string GetPackPath(VFSFile file) => file.FullPath.Replace(MountPoint, string.Empty).TrimStart('/');
+
+		/// <returns><paramref name="file"/>, files inside a pack have no path on the device's filesystem</returns>
+		public override VFSFile ExpandPath(VFSFile file, bool needExistingFile = false) => file;
+
+		public override bool Exists(VFSFile path)
+		{
+			string packPath = GetPackPath(path);
+			if (string.IsNullOrEmpty(packPath))
+				return Archive.IsOpen;
+			if (Archive.Exists(packPath))
+				return true;
+
+			// Directories are only stored as part of file paths
+			return Files != null && m_Directories.Contains(packPath.TrimEnd('/') + "/");
+		}
+
+		public override VFSFile[] GetFiles(VFSFile directory, bool recursive = false)
+		{
+			string root = GetPackPath(directory);
+			if (root.Length > 0 && !root.EndsWith("/"))
+				root += "/";
+
+			string outputRoot = directory.FullPath;
+			if (!outputRoot.EndsWith("/"))
+				outputRoot += "/";
+
+			List<VFSFile> output = new List<VFSFile>();
+			HashSet<string> addedDirectories = new HashSet<string>();
+			foreach (string file in Files)
+			{
+				if (!file.StartsWith(root))
+					continue;
+				string relative = file.Substring(root.Length);
+
+				// Add directories
+				for (int separator = relative.IndexOf('/'); separator >= 0; separator = relative.IndexOf('/', separator + 1))
+				{
+					string subdirectory = relative.Substring(0, separator + 1);
+					if (addedDirectories.Add(subdirectory))
+						output.Add(outputRoot + subdirectory);
+					if (!recursive)
+						break;
+				}
+
+				// Add file
+				if (recursive || relative.IndexOf('/') < 0)
+					output.Add(outputRoot + relative);
+			}
+			return output.ToArray();
+		}
+
+		/// <returns>Data from file, or empty array if failed</returns>
+		public override byte[] Read(VFSFile path) => Archive.Read(GetPackPath(path)) ?? new byte[0];
+
+		/// <returns>Data from file, or empty string if failed</returns>
+		public override string ReadText(VFSFile path)
+		{
+			byte[] data = Archive.Read(GetPackPath(path));
+			if (data == null)
+				return string.Empty;
+
+			// Detects encoding from byte order marks, matching File.ReadAllText
+			using (StreamReader reader = new StreamReader(new MemoryStream(data), true))
+				return reader.ReadToEnd();
+		}
+
+		public override void Copy(VFSFile source, VFSFile destination)
+		{
+			VFSMapping destinationMapping = VFS.GetMapping(destination, false, FilePermissions.Write);
+			if (!destinationMapping)
+			{
+				Log.Warning($"Failed to copy from '{source}' to '{destination}' - no writable VFS mapping found for destination");
+				return;
+			}
+
+			if (!source.IsDirectory && destination.IsDirectory)
+				destination += source.FileName;
+
+			if (!source.IsDirectory)
+			{
+				destinationMapping.Write(destination, Read(source));
+				return;
+			}
+
+			// Source is directory, copy all files recursively
+			foreach (VFSFile file in GetFiles(source, true))
+				if (!file.IsDirectory)
+					destinationMapping.Write($"{destination}/{file.FullPath.Replace(source.FullPath, "")}", Read(file));
+		}
+
+		private void ReadOnlyWarning(VFSFile path) => Log.Warning($"Cannot modify '{path}' - pack '{MountPath}' is read-only");
+
+		public override void Write(VFSFile path, byte[] data) => ReadOnlyWarning(path);
+		public override void Write(VFSFile path, string data, bool append = false) => ReadOnlyWarning(path);
+		public override void Remove(VFSFile path) => ReadOnlyWarning(path);
+		public override void Move(VFSFile source, VFSFile destination) => ReadOnlyWarning(source);
+
+		public override bool CreateDirectory(VFSFile target)
+		{
+			ReadOnlyWarning(target);
+			return false;
+		}
+
+		public override bool RemoveDirectory(VFSFile target)
+		{
+			ReadOnlyWarning(target);
+			return false;
+		}
+	}
+}
@@ -1,6 +1,8 @@
 using System;
 using Yonai;
 using System.Linq;
+using Yonai.IO;
+using Yonai.Graphics;
 using YonaiEditor.Systems;
 using System.Collections.Generic;
 
@@ -14,7 +16,8 @@ namespace YonaiEditor.BuildProcess
 		private static Dictionary<Platform, IBuildProcess> BuildProcesses = new Dictionary<Platform, IBuildProcess>()
 		{
 			{ Platform.Windows, new WindowsBuildProcess() },
-			{ Platform.Mac, new MacBuildProcess() }
+			{ Platform.Mac, new MacBuildProcess() },
+			{ Platform.Linux, new LinuxBuildProcess() }
 		};
 
 		/// <summary>
@@ -23,7 +26,8 @@ namespace YonaiEditor.BuildProcess
 		private static Dictionary<Platform, Platform[]> BuildPlatformMatrix = new Dictionary<Platform, Platform[]>()
 		{
 			{ Platform.Windows, new Platform[] { Platform.Windows } },
-			{ Platform.Mac, new Platform[] { Platform.Mac} }
+			{ Platform.Mac, new Platform[] { Platform.Mac} },
+			{ Platform.Linux, new Platform[] { Platform.Linux } }
 		};
 
 		/// <summary>
@@ -33,9 +37,36 @@ namespace YonaiEditor.BuildProcess
 		private static Dictionary<Platform, string> PlatformIcons = new Dictionary<Platform, string>()
 		{
 			{ Platform.Windows, "Windows" },
-			{ Platform.Mac, "Mac" }
+			{ Platform.Mac, "Mac" },
+			{ Platform.Linux, "Linux" }
 		};
 
+		/// <summary>
+		/// Image file extensions converted by <see cref="CookTextures(VFSFile)"/>
+		/// </summary>
+		private static readonly string[] CookableTextureExtensions = { ".png", ".jpg", ".jpeg", ".tga", ".bmp", ".psd", ".gif", ".hdr" };
+
+		/// <summary>
+		/// Audio file extensions stored uncompressed in packs, so <see cref="AudioData"/> can stream them straight from the mapped pack.
+		/// Encoded audio gains little from LZ4.
+		/// </summary>
+		private static readonly string[] StreamableAudioExtensions = { ".mp3", ".ogg", ".wav", ".flac" };
+
+		/// <summary>
+		/// When true, textures are block compressed while cooking
+		/// </summary>
+		public static bool CompressTextures { get; set; } = false;
+
+		/// <summary>
+		/// When true, built assets are stored in <see cref="PackArchive"/>s instead of loose files
+		/// </summary>
+		public static bool PackAssets { get; set; } = true;
+
+		/// <summary>
+		/// When true, files inside packs are LZ4 compressed if that reduces their size
+		/// </summary>
+		public static bool CompressPacks { get; set; } = true;
+
 		public static Platform ActivePlatform { get; private set; } = Platform.Unknown;
 		public static IBuildProcess BuildProcess { get; private set; } = null;
 		public static Platform[] AvailableBuildPlatforms => BuildPlatformMatrix[Application.Platform];
@@ -78,6 +109,83 @@ namespace YonaiEditor.BuildProcess
 		public static void StartBuild(string outputFolder = null) => BuildProcess.Execute(outputFolder, ProjectHubService.ActiveProject);
 		public static void StartBuild(ProjectFile project, string outputFolder = null) => BuildProcess.Execute(outputFolder, project);
 
+		/// <summary>
+		/// Cooks all images inside <paramref name="directory"/> in place.
+		/// Filenames are kept, so resource paths remain valid and <see cref="Texture"/> detects the cooked data when loading.
+		/// </summary>
+		public static void CookTextures(VFSFile directory)
+		{
+			int cooked = 0;
+			VFSFile[] files = VFS.GetFiles(directory, true /* Recurse */);
+			foreach (VFSFile file in files)
+			{
+				string extension = file.Extension.ToLower();
+				if (!CookableTextureExtensions.Contains(extension))
+					continue;
+
+				byte[] source = VFS.Read(file);
+				if (source == null || TextureCooker.IsCooked(source))
+					continue;
+
+				byte[] output = TextureCooker.Cook(source, new TextureCookSettings(extension == ".hdr", true, CompressTextures));
+				if (output == null)
+				{
+					Log.Warning($"Failed to cook texture '{file.FullPath}', source image is kept");
+					continue;
+				}
+
+				VFS.Write(file, output);
+				cooked++;
+			}
+			Log.Debug($"Cooked {cooked} texture(s) in '{directory.FullPath}'");
+		}
+
+		/// <summary>
+		/// When <see cref="PackAssets"/> is enabled, replaces the Editor and ProjectFiles directories inside <paramref name="assetsDirectory"/>
+		/// with packs of the same name, which are mounted in place of the directories when the game launches.
+		/// </summary>
+		public static void PackBuildAssets(VFSFile assetsDirectory)
+		{
+			if (!PackAssets)
+				return;
+
+			PackDirectory($"{assetsDirectory.FullPath}Editor", $"{assetsDirectory.FullPath}Editor.pak");
+			PackDirectory($"{assetsDirectory.FullPath}ProjectFiles", $"{assetsDirectory.FullPath}ProjectFiles.pak");
+		}
+
+		/// <summary>
+		/// Writes all files inside <paramref name="directory"/> to a <see cref="PackArchive"/>, then removes <paramref name="directory"/>.
+		/// Paths inside the pack are relative to <paramref name="directory"/>.
+		/// </summary>
+		/// <returns>True if the pack was written</returns>
+		public static bool PackDirectory(VFSFile directory, VFSFile output)
+		{
+			List<string> paths = new List<string>();
+			List<string> filePaths = new List<string>();
+			List<bool> compress = new List<bool>();
+			VFSFile[] files = VFS.GetFiles(directory, true /* Recurse */);
+			foreach (VFSFile file in files)
+			{
+				if (file.IsDirectory)
+					continue;
+
+				paths.Add(file.FullPath.Replace(directory.FullPath, string.Empty).TrimStart('/'));
+				filePaths.Add(VFS.ExpandPath(file, true)?.FullPath ?? file.FullPath);
+				compress.Add(CompressPacks && !StreamableAudioExtensions.Contains(file.Extension.ToLower()));
+			}
+
+			string outputPath = VFS.ExpandPath(output)?.FullPath ?? output.FullPath;
+			if (!PackArchive.Create(outputPath, paths.ToArray(), filePaths.ToArray(), compress.ToArray()))
+			{
+				Log.Error($"Failed to pack '{directory.FullPath}', files are kept");
+				return false;
+			}
+
+			VFS.RemoveDirectory(directory);
+			Log.Debug($"Packed {paths.Count} file(s) from '{directory.FullPath}' in to '{output.FullPath}'");
+			return true;
+		}
+
 		internal static bool Initialise()
 		{
 			Platform platform = LocalProjectSettings.BuildTarget;
@@ -0,0 +1,90 @@
+using System;
+using System.IO;
+using Yonai;
+using Yonai.IO;
+using Newtonsoft.Json;
+using Newtonsoft.Json.Linq;
+
+namespace YonaiEditor.BuildProcess
+{
+	public class LinuxBuildProcess : IBuildProcess
+	{
+		public bool OutputIsFolder => true;
+
+		public void Execute(string outputFolder, ProjectFile project)
+		{
+			if(string.IsNullOrEmpty(outputFolder))
+			{
+				outputFolder = FileDialog.OpenFolder("Build Output");
+				if(string.IsNullOrEmpty(outputFolder))
+				{
+					Log.Error("Cannot build - not output folder selected");
+					return;
+				}
+			}
+
+			VFSMapping mapping = VFS.Mount("build://", outputFolder);
+
+			// Launching executable
+			// Copy explicitly using the native file API to preserve file permissions
+			File.Copy(VFS.ExpandPath("app://BaseGame"), mapping.ExpandPath($"build://{project.Name}"), overwrite: true);
+
+			// Resources file
+			// Read in resource file as JSON, write as JSON without indentation/whitespace
+			JArray resources = JsonConvert.DeserializeObject<JArray>(VFS.ReadText("project://Resources.json"));
+			VFS.Write("build://Assets/Resources.json", JsonConvert.SerializeObject(resources, Formatting.None));
+
+			// Project assemblies
+			VFS.CreateDirectory("build://Assets/Assemblies");
+			foreach(string assemblyPath in project.Assemblies)
+				VFS.Copy(assemblyPath, "build://Assets/Assemblies/" + Path.GetFileName(assemblyPath));
+
+			// Copy editor default assets
+			VFS.Copy("app://Assets/", "build://Assets/Editor/");
+
+			// Project files
+			VFS.CreateDirectory("build://Assets/ProjectFiles");
+			VFS.Copy("project://Assets/", "build://Assets/ProjectFiles");
+			GameBuilder.CookTextures("build://Assets/ProjectFiles");
+			GameBuilder.PackBuildAssets("build://Assets/");
+
+			// Copy all required .so files
+			VFSFile[] localFiles = VFS.GetFiles("app://", recursive: false);
+			foreach(var file in localFiles)
+				if(file.Extension == ".so")
+					VFS.Copy(file, "build://");
+
+			CreateLaunchJSON(project);
+
+			// Unmount virtual mount
+			VFS.Unmount("build://");
+		}
+
+		private void CreateLaunchJSON(ProjectFile project)
+		{
+			JObject json = new JObject();
+
+			// Assemblies
+			JArray assemblies = new JArray();
+			foreach(string assembly in project.Assemblies)
+				assemblies.Add(new VFSFile(assembly).FileName);
+			json["Assemblies"] = assemblies;
+
+			// Systems
+			json["GlobalSystems"] = new JArray();
+
+			// Scenes
+			// NOTE: Currently just adds all .json files in project://Scenes
+			// TODO: Give user ability to re-order scenes and exclude scenes
+			JArray scenes = new JArray();
+			VFSFile[] sceneFiles = VFS.GetFiles("project://Assets/Scenes", true /* Recurse */);
+			foreach(VFSFile sceneFile in sceneFiles)
+				if(sceneFile.Extension == ".json")
+					scenes.Add(sceneFile.FullPath);
+			json["Scenes"] = scenes;
+
+			// Save to output folder
+			VFS.WriteJSON("build://Assets/Launch.json", json, false /* Indent */);
+		}
+	}
+}
@@ -56,6 +56,8 @@ namespace YonaiEditor.BuildProcess
 			// Project files
 			VFS.CreateDirectory("build://Assets/ProjectFiles");
 			VFS.Copy("project://Assets/", "build://Assets/ProjectFiles");
+			GameBuilder.CookTextures("build://Assets/ProjectFiles");
+			GameBuilder.PackBuildAssets("build://Assets/");
 
 			// Copy all required .dylib files
 			VFSFile[] localFiles = VFS.GetFiles("app://", recursive: false);
@@ -49,6 +49,8 @@ namespace YonaiEditor.BuildProcess
 			// Project files
 			VFS.CreateDirectory("build://Assets/ProjectFiles");
 			VFS.Copy("project://Assets/", "build://Assets/ProjectFiles");
+			GameBuilder.CookTextures("build://Assets/ProjectFiles");
+			GameBuilder.PackBuildAssets("build://Assets/");
 
 			// If base game was compiled as shared library, will need to copy dependency .dll files
 			if (VFS.Exists("app://AquaEngine.dll") || VFS.Exists("app://AquaEngined.dll"))
@@ -17,6 +17,9 @@ namespace YonaiEditor.Systems
 		private Dictionary<string, ProjectFile> m_Projects = new Dictionary<string, ProjectFile>();
 		private const string ProjectCacheFile = "editor://Projects.json";
 
+		private static FileWatcher s_AssetWatcher = null;
+		private static string s_AssetDirectory = string.Empty;
+
 		protected override void Start()
 		{
 			Window.Resolution = new IVector2(600, 400);
@@ -122,6 +125,11 @@ namespace YonaiEditor.Systems
 			VFS.Mount("project://", project.Path.ParentDirectory);
 			VFS.Mount("assets://", "project://Assets");
 
+			// Imported assets are cached per project
+			VFSFile? dataDirectory = VFS.ExpandPath("project://.data/ImportCache/");
+			if (dataDirectory.HasValue)
+				ImportCache.Directory = dataDirectory.Value.FullPath;
+
 			// Load project resources
 			if (!Scripting.IsAssemblyReloading())
 			{
@@ -137,6 +145,7 @@ namespace YonaiEditor.Systems
 			}
 
 			Resource.LoadDatabase();
+			WatchAssets();
 
 			// Add global systems
 			Add<EditorUIService>();
@@ -155,6 +164,34 @@ namespace YonaiEditor.Systems
 			GameBuilder.Initialise();
 		}
 
+		/// <summary>
+		/// Reloads resources, and resources depending on them, when files in the project's assets change
+		/// </summary>
+		private static void WatchAssets()
+		{
+			s_AssetWatcher?.Dispose();
+			s_AssetWatcher = null;
+
+			VFSFile? directory = VFS.ExpandPath("project://Assets/", true);
+			if (!directory.HasValue)
+				return;
+
+			s_AssetDirectory = directory.Value.FullPath.Replace('\\', '/').TrimEnd('/') + "/";
+			s_AssetWatcher = new FileWatcher(s_AssetDirectory);
+			s_AssetWatcher.Changed += OnAssetChanged;
+		}
+
+		private static void OnAssetChanged(string path, FileWatchStatus status)
+		{
+			if (status == FileWatchStatus.Removed || !path.StartsWith(s_AssetDirectory))
+				return;
+
+			// Resources can be loaded through either mount
+			string relativePath = path.Substring(s_AssetDirectory.Length);
+			Resource.Invalidate("assets://" + relativePath);
+			Resource.Invalidate("project://Assets/" + relativePath);
+		}
+
 		/// <summary>
 		/// Fills <see cref="m_Projects"/> from <see cref="ProjectCacheFile"/>
 		/// </summary>
@@ -0,0 +1,97 @@
+#include <chrono>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+#include <filesystem>
+#include <Yonai/IO/ImportCache.hpp>
+#include <Yonai/Graphics/Model.hpp>
+#include <Yonai/Graphics/TextureCooker.hpp>
+
+using namespace std;
+using namespace Yonai::IO;
+using namespace Yonai::Graphics;
+
+namespace fs = std::filesystem;
+
+const string ImageExtensions[] = { ".png", ".jpg", ".jpeg", ".tga", ".bmp", ".psd", ".gif", ".hdr" };
+const string ModelExtensions[] = { ".fbx", ".obj", ".gltf", ".glb", ".dae", ".3ds", ".blend", ".ply", ".stl" };
+
+template<size_t N>
+bool Contains(const string (&extensions)[N], const string& extension)
+{
+	return find(begin(extensions), end(extensions), extension) != end(extensions);
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 3)
+	{
+		cout << "Usage: " << argv[0] << " [options] <AssetsDirectory> <CacheDirectory>" << endl;
+		cout << "Imports all textures and models in the assets directory, recursively, that are not already in the import cache." << endl;
+		cout << "Options:" << endl;
+		cout << " -threads N\tAmount of worker threads, defaults to one per hardware thread" << endl;
+		cout << " -optimise\tImport models with optimised meshes" << endl;
+		cout << " -lods N\tAmount of levels of detail generated for each model mesh" << endl;
+		cout << " -clear\t\tRemove all cached imports first" << endl;
+		return -1;
+	}
+
+	fs::path input = argv[argc - 2];
+	string cacheDirectory = argv[argc - 1];
+
+	unsigned int threadCount = 0;
+	bool optimiseMeshes = false;
+	unsigned int lodCount = 0;
+	bool clear = false;
+	for (int i = 1; i < argc - 2; i++)
+	{
+		string arg(argv[i]);
+		if (arg == "-threads" && i + 1 < argc - 2)
+			threadCount = (unsigned int)stoul(argv[++i]);
+		else if (arg == "-optimise")
+			optimiseMeshes = true;
+		else if (arg == "-lods" && i + 1 < argc - 2)
+			lodCount = (unsigned int)stoul(argv[++i]);
+		else if (arg == "-clear")
+			clear = true;
+		else
+			cerr << "Unknown option '" << arg << "'" << endl;
+	}
+
+	if (!fs::is_directory(input))
+	{
+		cerr << "Assets directory '" << input.string() << "' could not be found" << endl;
+		return -2;
+	}
+
+	ImportCache::SetDirectory(cacheDirectory);
+	if (clear)
+		ImportCache::Clear();
+
+	// Same settings as assets imported with default import settings
+	vector<ImportCacheJob> jobs;
+	for (fs::recursive_directory_iterator it(input), end; it != end; it++)
+	{
+		if (!it->is_regular_file())
+			continue;
+
+		string extension = it->path().extension().string();
+		transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+		if (Contains(ImageExtensions, extension))
+		{
+			TextureCookSettings settings;
+			settings.HDR = extension == ".hdr";
+			jobs.push_back({ "Texture", it->path().string(), settings.GetFlags() });
+		}
+		else if (Contains(ModelExtensions, extension))
+			jobs.push_back({ "Model", it->path().string(), Model::GetImportFlags(optimiseMeshes, lodCount) });
+	}
+
+	auto start = chrono::high_resolution_clock::now();
+	ImportCacheWarmResult result = ImportCache::Warm(jobs, threadCount);
+	auto duration = chrono::duration<double>(chrono::high_resolution_clock::now() - start);
+
+	cout << "Imported " << result.Imported << " asset(s), " << result.Cached << " already cached, " << result.Failed << " failed in " << duration.count() << "s" << endl;
+	return result.Failed > 0 ? -3 : 0;
+}
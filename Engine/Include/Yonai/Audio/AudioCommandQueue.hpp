@@ -0,0 +1,158 @@
+#pragma once
+#include <atomic>
+#include <vector>
+#include <miniaudio.h>
+#include <Yonai/API.hpp>
+
+namespace Yonai
+{
+	enum class AudioCommandType : unsigned char
+	{
+		None = 0,
+		Start,
+		Stop,
+
+		/// <summary>
+		/// Seeks to Frame, in PCM frames of the sound
+		/// </summary>
+		Seek,
+
+		/// <summary>
+		/// Ramps volume to Values[0] over a short time, instead of changing in a single step
+		/// </summary>
+		SetVolume,
+
+		SetPan,
+		SetPitch,
+		SetLooping,
+		SetPosition,
+
+		/// <summary>
+		/// Enables 3D spatialisation when Values[0] is non-zero
+		/// </summary>
+		Set3D,
+
+		/// <summary>
+		/// Sets the minimum and maximum attenuation distances to Values[0] and Values[1]
+		/// </summary>
+		SetRolloffDistance,
+
+		/// <summary>
+		/// Sets the minimum and maximum attenuation gains to Values[0] and Values[1]
+		/// </summary>
+		SetRolloffGain,
+
+		SetAttenuationRolloff,
+
+		/// <summary>
+		/// Sets the attenuation model to Frame, as an ma_attenuation_model
+		/// </summary>
+		SetAttenuationModel,
+
+		/// <summary>
+		/// Fades from Values[0] to Values[1] over Frame engine frames. Values[0] of -1 fades from the current volume.
+		/// </summary>
+		Fade,
+
+		/// <summary>
+		/// Stops the sound once the engine reaches time Frame
+		/// </summary>
+		SetStopTime
+	};
+
+	/// <summary>
+	/// Change to a sound, made on the game thread and applied on the audio thread
+	/// </summary>
+	struct AudioCommand
+	{
+		AudioCommandType Type = AudioCommandType::None;
+		ma_sound* Sound = nullptr;
+		float Values[3] = { 0, 0, 0 };
+		ma_uint64 Frame = 0;
+	};
+
+	typedef void (*AudioCommandHandler)(const AudioCommand& command);
+
+	/// <summary>
+	/// Lock-free single producer, single consumer ring of audio commands.
+	/// The game thread pushes commands during a frame and publishes them together with Flush.
+	/// The audio thread applies all published commands with Apply, at the start of each buffer it mixes.
+	///
+	/// Apply never blocks. When another thread is already applying commands, it returns immediately
+	/// and the commands are applied at the next buffer instead.
+	/// </summary>
+	class AudioCommandQueue
+	{
+		AudioCommandHandler m_Handler;
+		std::vector<AudioCommand> m_Commands;
+		size_t m_Mask;
+
+		/// <summary>
+		/// Total commands pushed, only accessed by the game thread
+		/// </summary>
+		size_t m_Write;
+
+		/// <summary>
+		/// Total commands visible to the audio thread
+		/// </summary>
+		std::atomic<size_t> m_Published;
+
+		/// <summary>
+		/// Total commands applied
+		/// </summary>
+		std::atomic<size_t> m_Read;
+
+		/// <summary>
+		/// Set while a thread is applying commands, so only one thread consumes at a time
+		/// </summary>
+		std::atomic_flag m_Applying = ATOMIC_FLAG_INIT;
+
+		size_t ApplyPublished();
+
+	public:
+		/// <param name="handler">Applies each command, called on the consuming thread</param>
+		/// <param name="capacity">Maximum commands waiting to be applied, rounded up to a power of two</param>
+		YonaiAPI AudioCommandQueue(AudioCommandHandler handler = ApplyToSound, size_t capacity = 4096);
+
+		AudioCommandQueue(const AudioCommandQueue&) = delete;
+		AudioCommandQueue& operator=(const AudioCommandQueue&) = delete;
+
+		/// <summary>
+		/// Adds a command, applied after the next Flush. Called from the game thread.
+		/// When full, waiting commands are applied on the calling thread to make space.
+		/// </summary>
+		YonaiAPI void Push(const AudioCommand& command);
+
+		/// <summary>
+		/// Makes pushed commands visible to the audio thread, as a single batch. Called from the game thread once per frame.
+		/// </summary>
+		YonaiAPI void Flush();
+
+		/// <summary>
+		/// Applies all flushed commands. Called from the audio thread before mixing.
+		/// </summary>
+		/// <returns>Amount of commands applied, 0 if another thread is currently applying</returns>
+		YonaiAPI size_t Apply();
+
+		/// <summary>
+		/// Flushes, then applies every command on the calling thread, waiting if the audio thread is applying.
+		/// Used before releasing a sound referenced by commands, or when there is no audio thread.
+		/// </summary>
+		YonaiAPI void Synchronise();
+
+		/// <returns>Amount of commands pushed but not yet applied</returns>
+		YonaiAPI size_t GetPending();
+
+		YonaiAPI size_t GetCapacity();
+
+		/// <summary>
+		/// Applies a command to its miniaudio sound
+		/// </summary>
+		YonaiAPI static void ApplyToSound(const AudioCommand& command);
+
+		/// <summary>
+		/// Time taken for SetVolume to reach its new volume, in milliseconds
+		/// </summary>
+		static constexpr unsigned int VolumeRampMilliseconds = 10;
+	};
+}
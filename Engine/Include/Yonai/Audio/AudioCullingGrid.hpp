@@ -0,0 +1,85 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include <glm/vec3.hpp>
+#include <Yonai/API.hpp>
+
+namespace Yonai
+{
+	/// <summary>
+	/// Sparse uniform grid of sound sources, each audible within a radius of its position.
+	/// Finds the sources in range of any listener without testing every source.
+	///
+	/// Sources are only moved between cells when updated, so unchanged sources cost nothing.
+	/// Sources with a radius too large to search for efficiently, or that are never culled,
+	/// are kept outside the grid and tested against every listener.
+	/// </summary>
+	class AudioCullingGrid
+	{
+		struct Entry
+		{
+			const void* Key = nullptr;
+			glm::vec3 Position = glm::vec3(0.0f);
+			float Radius = 0.0f;
+
+			bool InGrid = false;
+			uint64_t Cell = 0;
+
+			// Value of m_QueryCount when last found in range, to skip duplicates across listeners
+			unsigned int LastFound = 0;
+		};
+
+		float m_CellSize;
+		unsigned int m_QueryCount;
+
+		// Node based, so pointers to entries held by cells remain valid as entries are added
+		std::unordered_map<const void*, Entry> m_Entries;
+		std::unordered_map<uint64_t, std::vector<Entry*>> m_Cells;
+
+		// Entries with a radius larger than a query searches, tested against every listener
+		std::vector<Entry*> m_Unbounded;
+
+		uint64_t GetCell(const glm::vec3& position);
+		void Link(Entry& entry);
+		void Unlink(Entry& entry);
+
+	public:
+		/// <summary>
+		/// Cells searched in each direction around a listener.
+		/// Sources with a radius over QueryCells * cell size are kept outside the grid.
+		/// </summary>
+		static constexpr int QueryCells = 2;
+
+		YonaiAPI AudioCullingGrid(float cellSize = 32.0f);
+
+		/// <summary>
+		/// Adds a source, or moves an existing source
+		/// </summary>
+		/// <param name="radius">Distance the source can be heard from, or infinity if never culled</param>
+		YonaiAPI void Update(const void* key, const glm::vec3& position, float radius);
+
+		YonaiAPI void Remove(const void* key);
+		YonaiAPI void Clear();
+
+		YonaiAPI bool Contains(const void* key);
+		YonaiAPI size_t GetCount();
+
+		/// <returns>Sources kept outside the grid, tested against every listener</returns>
+		YonaiAPI size_t GetUnboundedCount();
+
+		/// <summary>
+		/// Finds sources within their radius of at least one listener
+		/// </summary>
+		/// <param name="output">Cleared, then filled with the key of each source in range, once each</param>
+		YonaiAPI void Query(const std::vector<glm::vec3>& listeners, std::vector<const void*>& output);
+
+		YonaiAPI float GetCellSize();
+
+		/// <summary>
+		/// Sets the width of each cell, moving every source in to the resized cells.
+		/// Best set to roughly the typical audible radius of sources.
+		/// </summary>
+		YonaiAPI void SetCellSize(float size);
+	};
+}
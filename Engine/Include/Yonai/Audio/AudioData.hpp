@@ -1,26 +1,63 @@
 #pragma once
+#include <memory>
+#include <string>
+#include <vector>
 #include <miniaudio.h>
 #include <Yonai/API.hpp>
+#include <Yonai/IO/ByteSpan.hpp>
+#include <Yonai/IO/PackArchive.hpp>
 
 namespace Yonai
 {
 	namespace Components { struct AudioSource; }
 
 	/// <summary>
-	/// Resource for an audio clip
+	/// Resource for an audio clip.
+	/// Either holds the encoded clip in memory, or streams it from a file on disk or inside a pack while playing.
 	/// </summary>
 	struct AudioData
 	{
 		YonaiAPI AudioData();
-		YonaiAPI AudioData(std::vector<unsigned char>& data);
+		YonaiAPI AudioData(IO::ByteSpan data);
+		YonaiAPI ~AudioData();
 
-		YonaiAPI void Import(std::vector<unsigned char>& data);
+		/// <summary>
+		/// Holds a copy of the encoded clip in memory.
+		/// Short clips are decoded once in to AudioSystem's decode cache while there is room, otherwise by each source playing it.
+		/// </summary>
+		YonaiAPI void Import(IO::ByteSpan data);
+
+		/// <summary>
+		/// Streams the clip from a file while playing, decoding a few chunks ahead on a background thread.
+		/// Suited to long clips such as music and ambience, as only the decoded chunks are held in memory.
+		/// </summary>
+		YonaiAPI void ImportStream(const std::string& path);
+
+		/// <summary>
+		/// Streams the clip from an uncompressed entry of a pack file while playing, decoding straight from the mapped pack.
+		/// Compressed entries can not be streamed, and are held in memory as with Import.
+		/// </summary>
+		/// <param name="packPath">Path of the pack file on disk</param>
+		/// <param name="path">Path of the clip inside the pack</param>
+		YonaiAPI void ImportPackStream(const std::string& packPath, const std::string& path);
+
+		/// <returns>True if the clip is streamed from disk</returns>
+		YonaiAPI bool IsStreaming();
 
 		/// <returns>Length of the clip, in seconds</returns>
 		YonaiAPI float GetLength();
 
+		/// <returns>Bytes of the clip held in memory, not including decoded audio held by sources or the decode cache</returns>
+		YonaiAPI size_t GetMemoryUsage();
+
 	private:
 		std::vector<unsigned char> m_Data;
+		std::string m_StreamPath;
+
+		// Pack containing the streamed clip, mapped for as long as the clip is imported
+		std::unique_ptr<IO::PackArchive> m_StreamPack;
+		IO::ByteSpan m_StreamData;
+		float m_Length;
 
 		friend struct Yonai::Components::AudioSource;
 	};
@@ -0,0 +1,114 @@
+#pragma once
+#include <list>
+#include <memory>
+#include <vector>
+#include <unordered_map>
+#include <miniaudio.h>
+#include <Yonai/API.hpp>
+#include <Yonai/IO/ByteSpan.hpp>
+
+namespace Yonai
+{
+	/// <summary>
+	/// Fully decoded PCM frames of a clip, shared by every source playing it
+	/// </summary>
+	struct AudioDecodedClip
+	{
+		std::vector<unsigned char> Frames;
+		ma_format Format = ma_format_unknown;
+		ma_uint32 Channels = 0;
+		ma_uint32 SampleRate = 0;
+		ma_uint64 FrameCount = 0;
+	};
+
+	/// <summary>
+	/// Least recently used cache of decoded clips, so short clips played often are decoded once instead of by every source.
+	/// Clips stay compressed in memory, only decoded clips within the memory budget are held.
+	///
+	/// Evicted clips are freed once no sources are playing them.
+	/// Clips too long or too large for the budget are not cached, and are decoded by each source while playing.
+	/// Used from the game thread.
+	/// </summary>
+	class AudioDecodeCache
+	{
+		struct Entry
+		{
+			const void* Key;
+			std::shared_ptr<AudioDecodedClip> Clip;
+		};
+
+		// Most recently used at the front
+		std::list<Entry> m_Entries;
+		std::unordered_map<const void*, std::list<Entry>::iterator> m_Lookup;
+
+		size_t m_Budget;
+		size_t m_MemoryUsage;
+		float m_MaxClipLength;
+		ma_format m_Format;
+
+		unsigned int m_Hits;
+		unsigned int m_Misses;
+		unsigned int m_Evictions;
+
+		/// <summary>
+		/// Removes least recently used clips until within budget
+		/// </summary>
+		void Trim(size_t budget);
+
+	public:
+		YonaiAPI AudioDecodeCache(size_t budget = 32 * 1024 * 1024, float maxClipLength = 10.0f, ma_format format = ma_format_s16);
+
+		/// <summary>
+		/// Finds a decoded clip, decoding and adding it to the cache if missing
+		/// </summary>
+		/// <param name="key">Identifies the clip, such as the AudioData holding it</param>
+		/// <param name="encoded">Compressed clip, decoded on a miss</param>
+		/// <returns>Decoded clip, or nullptr if it can not be cached</returns>
+		YonaiAPI std::shared_ptr<AudioDecodedClip> Get(const void* key, IO::ByteSpan encoded);
+
+		/// <returns>True if key is decoded in the cache</returns>
+		YonaiAPI bool Contains(const void* key);
+
+		/// <summary>
+		/// Removes a clip, such as after it is re-imported
+		/// </summary>
+		YonaiAPI void Remove(const void* key);
+		YonaiAPI void Clear();
+
+		/// <returns>Maximum bytes of decoded audio held</returns>
+		YonaiAPI size_t GetBudget();
+
+		/// <summary>
+		/// Sets the maximum bytes of decoded audio held, evicting clips if over.
+		/// A budget of 0 disables caching.
+		/// </summary>
+		YonaiAPI void SetBudget(size_t bytes);
+
+		/// <returns>Longest clip cached, in seconds</returns>
+		YonaiAPI float GetMaxClipLength();
+		YonaiAPI void SetMaxClipLength(float seconds);
+
+		YonaiAPI ma_format GetFormat();
+
+		/// <summary>
+		/// Sets the format clips are decoded to, clearing the cache.
+		/// 16-bit takes half the memory of 32-bit float, and is enough for most clips.
+		/// </summary>
+		YonaiAPI void SetFormat(ma_format format);
+
+		/// <returns>Bytes of decoded audio currently held</returns>
+		YonaiAPI size_t GetMemoryUsage();
+		YonaiAPI unsigned int GetCount();
+
+		/// <returns>Clips found already decoded</returns>
+		YonaiAPI unsigned int GetHits();
+
+		/// <returns>Clips that needed decoding, or could not be cached</returns>
+		YonaiAPI unsigned int GetMisses();
+
+		/// <returns>Clips removed to stay within budget</returns>
+		YonaiAPI unsigned int GetEvictions();
+
+		YonaiAPI void ResetStats();
+	};
+}
@@ -0,0 +1,125 @@
+#pragma once
+#include <atomic>
+#include <vector>
+#include <miniaudio.h>
+#include <Yonai/API.hpp>
+
+namespace Yonai
+{
+	class AudioEffect;
+
+	enum class AudioEffectType : unsigned int
+	{
+		LowPass = 0,
+		HighPass,
+		Compressor,
+		Limiter,
+		Reverb,
+
+		/// <summary>
+		/// Lowers volume while another mixer is playing
+		/// </summary>
+		Ducking,
+
+		/// <summary>
+		/// Passes audio through unchanged, measuring its level
+		/// </summary>
+		Meter
+	};
+
+	/// <summary>
+	/// Node handed to miniaudio's node graph, which casts it to ma_node_base
+	/// </summary>
+	struct AudioEffectNode
+	{
+		ma_node_base Base;
+		AudioEffect* Effect;
+	};
+
+	struct AudioEffectParameter
+	{
+		const char* Name;
+		float Min;
+		float Max;
+		float Default;
+	};
+
+	/// <summary>
+	/// Processes audio passing through an AudioMixer, as a node in miniaudio's node graph.
+	///
+	/// Parameters are set on the game thread and read by Process on the audio thread,
+	/// so are stored as atomics and picked up at the start of the next processed block.
+	/// </summary>
+	class AudioEffect
+	{
+		AudioEffectNode m_Node;
+		AudioEffectType m_Type;
+		bool m_Valid;
+		std::atomic_bool m_Enabled;
+
+		const AudioEffectParameter* m_ParameterInfo;
+		std::vector<std::atomic<float>> m_Parameters;
+
+		static ma_node_vtable s_VTable;
+
+		static void OnProcess(ma_node* node, const float** framesIn, ma_uint32* frameCountIn, float** framesOut, ma_uint32* frameCountOut);
+
+	protected:
+		ma_uint32 m_Channels;
+		ma_uint32 m_SampleRate;
+
+		/// <param name="parameters">Information for each parameter, with static lifetime</param>
+		AudioEffect(ma_engine* engine, AudioEffectType type, const AudioEffectParameter* parameters, unsigned int parameterCount);
+
+		/// <summary>
+		/// Frames processed by effects at a time, for buffers held by effects
+		/// </summary>
+		static constexpr ma_uint32 BlockFrames = 256;
+
+	public:
+		/// <summary>
+		/// Creates an effect for engine, which must be attached to a node in the engine's graph to be processed
+		/// </summary>
+		/// <returns>New effect, or nullptr if invalid</returns>
+		YonaiAPI static AudioEffect* Create(AudioEffectType type, ma_engine* engine);
+
+		/// <returns>Information for each parameter of an effect type</returns>
+		YonaiAPI static const AudioEffectParameter* GetParameterInfo(AudioEffectType type, unsigned int* count);
+
+		YonaiAPI virtual ~AudioEffect();
+
+		AudioEffect(const AudioEffect&) = delete;
+		AudioEffect& operator=(const AudioEffect&) = delete;
+
+		/// <summary>
+		/// Removes this effect from the node graph, after which it is no longer processed.
+		/// Called before deleting an effect that may be processing on the audio thread.
+		/// </summary>
+		YonaiAPI void ReleaseNode();
+
+		/// <summary>
+		/// Processes interleaved f32 frames, with the engine's channel count. Called on the audio thread.
+		/// </summary>
+		YonaiAPI virtual void Process(const float* input, float* output, ma_uint32 frameCount) = 0;
+
+		YonaiAPI bool IsValid();
+		YonaiAPI ma_node* GetNode();
+		YonaiAPI AudioEffectType GetType();
+
+		/// <summary>
+		/// Disabled effects pass audio through unchanged
+		/// </summary>
+		YonaiAPI bool IsEnabled();
+		YonaiAPI void SetEnabled(bool enabled);
+
+		YonaiAPI unsigned int GetParameterCount();
+		YonaiAPI const AudioEffectParameter& GetParameterInfo(unsigned int index);
+
+		YonaiAPI float GetParameter(unsigned int index);
+
+		/// <summary>
+		/// Sets a parameter, clamped to its range
+		/// </summary>
+		YonaiAPI void SetParameter(unsigned int index, float value);
+	};
+}
@@ -0,0 +1,149 @@
+#pragma once
+#include <memory>
+#include <cstdint>
+#include <utility>
+#include <Yonai/Audio/AudioEffect.hpp>
+#include <Yonai/Audio/AudioKernels.hpp>
+
+namespace Yonai
+{
+	/// <summary>
+	/// Second order low-pass or high-pass filter
+	/// </summary>
+	class FilterEffect : public AudioEffect
+	{
+		std::vector<float> m_State;
+		AudioKernels::BiquadCoefficients m_Coefficients;
+		float m_Cutoff;
+		float m_Resonance;
+
+	public:
+		enum Parameter : unsigned int { Cutoff = 0, Resonance };
+
+		YonaiAPI FilterEffect(ma_engine* engine, AudioEffectType type);
+
+		YonaiAPI void Process(const float* input, float* output, ma_uint32 frameCount) override;
+	};
+
+	/// <summary>
+	/// Reduces volume above a threshold, following the loudest channel
+	/// </summary>
+	class CompressorEffect : public AudioEffect
+	{
+		float m_Envelope = 0.0f;
+		float m_Peaks[BlockFrames];
+		float m_Gains[BlockFrames];
+
+	protected:
+		CompressorEffect(ma_engine* engine, AudioEffectType type, const AudioEffectParameter* parameters, unsigned int parameterCount);
+
+		/// <param name="slope">Gain change in dB for each dB above threshold, (1 / ratio) - 1</param>
+		void Compress(const float* input, float* output, ma_uint32 frameCount, float thresholdDb, float slope, float attackMs, float releaseMs, float makeupDb);
+
+	public:
+		enum Parameter : unsigned int { Threshold = 0, Ratio, Attack, Release, MakeupGain };
+
+		YonaiAPI CompressorEffect(ma_engine* engine);
+
+		YonaiAPI void Process(const float* input, float* output, ma_uint32 frameCount) override;
+	};
+
+	/// <summary>
+	/// Compressor with an infinite ratio and instant attack, keeping output at or below the threshold.
+	/// Has no lookahead, so sudden peaks are reduced instantly, which can be heard as distortion.
+	/// </summary>
+	class LimiterEffect : public CompressorEffect
+	{
+	public:
+		enum Parameter : unsigned int { Threshold = 0, Release };
+
+		YonaiAPI LimiterEffect(ma_engine* engine);
+
+		YonaiAPI void Process(const float* input, float* output, ma_uint32 frameCount) override;
+	};
+
+	/// <summary>
+	/// Stereo reverb of parallel comb filters followed by series all-pass filters, based on Freeverb.
+	/// Each channel's four comb filters are processed together.
+	/// </summary>
+	class ReverbEffect : public AudioEffect
+	{
+	public:
+		static constexpr unsigned int CombCount = 8;
+		static constexpr unsigned int AllPassCount = 4;
+
+	private:
+		// Comb filters 0-3 are the left channel, 4-7 the right
+		std::vector<float> m_Combs[CombCount];
+		unsigned int m_CombIndex[CombCount] = {};
+		alignas(16) float m_CombFilter[CombCount] = {};
+
+		// All-pass filters 0-1 are the left channel, 2-3 the right
+		std::vector<float> m_AllPasses[AllPassCount];
+		unsigned int m_AllPassIndex[AllPassCount] = {};
+
+	public:
+		enum Parameter : unsigned int { RoomSize = 0, Damping, Wet, Dry, Width };
+
+		YonaiAPI ReverbEffect(ma_engine* engine);
+
+		YonaiAPI void Process(const float* input, float* output, ma_uint32 frameCount) override;
+	};
+
+	/// <summary>
+	/// Passes audio through unchanged, measuring the peak level.
+	/// The level is shared with other effects, such as ducking, which may outlive the meter.
+	/// </summary>
+	class MeterEffect : public AudioEffect
+	{
+		std::shared_ptr<std::atomic<float>> m_Level;
+
+	public:
+		enum Parameter : unsigned int { Release = 0 };
+
+		YonaiAPI MeterEffect(ma_engine* engine);
+
+		YonaiAPI void Process(const float* input, float* output, ma_uint32 frameCount) override;
+
+		/// <returns>Peak level, falling over the release time</returns>
+		YonaiAPI float GetLevel();
+		YonaiAPI std::shared_ptr<std::atomic<float>> GetSharedLevel();
+	};
+
+	/// <summary>
+	/// Lowers volume while the level of a sidechain, another mixer's meter, is above a threshold.
+	/// Such as lowering music while dialog plays.
+	/// </summary>
+	class DuckingEffect : public AudioEffect
+	{
+		// Sidechain level read by the audio thread, owned by m_Sidechain
+		std::atomic<std::atomic<float>*> m_SidechainLevel;
+		std::shared_ptr<std::atomic<float>> m_Sidechain;
+
+		// Replaced sidechains and the processed block count when replaced.
+		// Kept alive until another block has been processed, as the audio thread may still be reading them.
+		std::vector<std::pair<std::shared_ptr<std::atomic<float>>, uint64_t>> m_RetiredSidechains;
+
+		// Blocks processed by the audio thread
+		std::atomic<uint64_t> m_ProcessedBlocks;
+
+		// Gain at the end of the last processed block
+		std::atomic<float> m_Gain;
+		float m_Gains[BlockFrames];
+
+	public:
+		enum Parameter : unsigned int { Threshold = 0, Amount, Attack, Release };
+
+		YonaiAPI DuckingEffect(ma_engine* engine);
+
+		YonaiAPI void Process(const float* input, float* output, ma_uint32 frameCount) override;
+
+		/// <summary>
+		/// Sets the level to follow, from MeterEffect::GetSharedLevel, or nullptr to stop ducking
+		/// </summary>
+		YonaiAPI void SetSidechain(std::shared_ptr<std::atomic<float>> level);
+
+		/// <returns>Current gain applied, 1.0 when not ducking</returns>
+		YonaiAPI float GetGain();
+	};
+}
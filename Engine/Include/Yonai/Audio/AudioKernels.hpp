@@ -0,0 +1,62 @@
+#pragma once
+#include <cstddef>
+#include <miniaudio.h>
+#include <Yonai/API.hpp>
+
+// SSE2 is available on every x64 target, other architectures use the scalar kernels
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define YONAI_AUDIO_SSE 1
+#endif
+
+/// <summary>
+/// Processing shared by audio effects, operating on interleaved f32 frames.
+/// Each kernel vectorises across channels or frames when SSE is available.
+/// </summary>
+namespace Yonai::AudioKernels
+{
+	struct BiquadCoefficients
+	{
+		float B0 = 1.0f, B1 = 0.0f, B2 = 0.0f;
+		float A1 = 0.0f, A2 = 0.0f;
+	};
+
+	/// <summary>
+	/// Second order low-pass filter, from the Audio EQ Cookbook
+	/// </summary>
+	YonaiAPI BiquadCoefficients LowPass(ma_uint32 sampleRate, float cutoff, float q);
+
+	/// <summary>
+	/// Second order high-pass filter, from the Audio EQ Cookbook
+	/// </summary>
+	YonaiAPI BiquadCoefficients HighPass(ma_uint32 sampleRate, float cutoff, float q);
+
+	/// <summary>
+	/// Filters each channel independently, in transposed direct form II.
+	/// Channels are filtered in parallel, up to four at a time.
+	/// </summary>
+	/// <param name="state">Filter memory, each channel's first delay followed by each channel's second, zeroed before first use</param>
+	YonaiAPI void Biquad(const float* input, float* output, ma_uint32 frameCount, ma_uint32 channels, const BiquadCoefficients& coefficients, float* state);
+
+	/// <summary>
+	/// Multiplies every sample by gain
+	/// </summary>
+	YonaiAPI void Gain(float* samples, size_t count, float gain);
+
+	/// <summary>
+	/// Adds input to output, multiplied by gain
+	/// </summary>
+	YonaiAPI void MixInto(float* output, const float* input, size_t count, float gain);
+
+	/// <returns>Largest absolute sample</returns>
+	YonaiAPI float Peak(const float* samples, size_t count);
+
+	/// <summary>
+	/// Finds the largest absolute sample across channels of each frame
+	/// </summary>
+	YonaiAPI void PeakPerFrame(const float* input, float* peaks, ma_uint32 frameCount, ma_uint32 channels);
+
+	/// <summary>
+	/// Multiplies every channel of each frame by that frame's gain
+	/// </summary>
+	YonaiAPI void GainPerFrame(const float* input, float* output, const float* gains, ma_uint32 frameCount, ma_uint32 channels);
+}
@@ -1,8 +1,10 @@
 #pragma once
 #include <string>
+#include <vector>
 #include <miniaudio.h>
 #include <Yonai/API.hpp>
 #include <Yonai/Resource.hpp>
+#include <Yonai/Audio/AudioEffects.hpp>
 
 namespace Yonai
 {
@@ -13,6 +15,24 @@ namespace Yonai
 		ResourceID m_Parent;
 		ma_sound_group m_Group;
 
+		/// <summary>
+		/// Effects applied in order, between this mixer and its parent
+		/// </summary>
+		std::vector<AudioEffect*> m_Effects;
+
+		/// <summary>
+		/// Measures output after all effects, created when first requested
+		/// </summary>
+		MeterEffect* m_Meter;
+
+		/// <returns>Node that output is sent to, the parent mixer or the engine's endpoint</returns>
+		ma_node* GetParentNode();
+
+		/// <summary>
+		/// Attaches the group, effects and meter in series, then to the parent
+		/// </summary>
+		void ConnectEffects();
+
 	public:
 		std::string Name;
 
@@ -30,5 +50,26 @@ namespace Yonai
 		YonaiAPI void SetParent(ResourceID parent);
 
 		YonaiAPI ResourceID GetParent();
+
+		/// <summary>
+		/// Adds an effect after all existing effects
+		/// </summary>
+		/// <returns>Effect, owned by this mixer, or nullptr if it could not be created</returns>
+		YonaiAPI AudioEffect* AddEffect(AudioEffectType type);
+
+		/// <summary>
+		/// Removes and deletes an effect
+		/// </summary>
+		YonaiAPI void RemoveEffect(AudioEffect* effect);
+
+		YonaiAPI void ClearEffects();
+
+		YonaiAPI unsigned int GetEffectCount();
+		YonaiAPI AudioEffect* GetEffect(unsigned int index);
+
+		/// <summary>
+		/// Gets the meter measuring this mixer's output, such as for ducking other mixers
+		/// </summary>
+		YonaiAPI MeterEffect* GetMeter();
 	};
 }
\ No newline at end of file
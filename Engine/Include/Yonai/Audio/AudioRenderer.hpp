@@ -0,0 +1,73 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <miniaudio.h>
+#include <Yonai/API.hpp>
+#include <Yonai/Audio/AudioCommandQueue.hpp>
+
+namespace Yonai
+{
+	/// <summary>
+	/// Mixes an engine on the calling thread as fast as possible, instead of at the pace of an output device.
+	/// Used when there is no audio device, and to measure the cost of mixing.
+	///
+	/// Audio is mixed in blocks of a fixed size, applying queued commands before each block as the device callback would,
+	/// so the same scene and commands always render the same output.
+	/// </summary>
+	class AudioRenderer
+	{
+		ma_engine* m_Engine;
+		AudioCommandQueue* m_Commands;
+		ma_uint32 m_BlockFrames;
+
+		ma_uint64 m_FramesRendered;
+
+		/// <summary>
+		/// Time spent mixing, in seconds
+		/// </summary>
+		double m_RenderTime;
+
+		/// <summary>
+		/// Mixes a single block in to output, which has space for at least frameCount frames
+		/// </summary>
+		ma_uint64 RenderBlock(float* output, ma_uint64 frameCount);
+
+	public:
+		/// <param name="engine">Engine to mix, initialised with noDevice</param>
+		/// <param name="commands">Applied before mixing each block, or nullptr</param>
+		/// <param name="blockFrames">Frames mixed at a time, similar to a device's period size</param>
+		YonaiAPI AudioRenderer(ma_engine* engine, AudioCommandQueue* commands = nullptr, ma_uint32 blockFrames = 512);
+
+		/// <summary>
+		/// Mixes frameCount frames in to output, interleaved f32 with the engine's channel count
+		/// </summary>
+		/// <returns>Frames rendered</returns>
+		YonaiAPI ma_uint64 Render(float* output, ma_uint64 frameCount);
+
+		/// <summary>
+		/// Mixes frameCount frames, resizing output to fit
+		/// </summary>
+		/// <returns>Frames rendered</returns>
+		YonaiAPI ma_uint64 Render(std::vector<float>& output, ma_uint64 frameCount);
+
+		/// <summary>
+		/// Mixes frameCount frames in to a 32-bit float WAV file
+		/// </summary>
+		/// <returns>True if the file was written</returns>
+		YonaiAPI bool RenderToFile(const std::string& path, ma_uint64 frameCount);
+
+		YonaiAPI ma_uint32 GetChannels();
+		YonaiAPI ma_uint32 GetSampleRate();
+
+		/// <returns>Total frames rendered since creation or ResetStats</returns>
+		YonaiAPI ma_uint64 GetFramesRendered();
+
+		/// <returns>Total time spent mixing since creation or ResetStats, in seconds</returns>
+		YonaiAPI double GetRenderTime();
+
+		/// <returns>Milliseconds spent mixing for each second of audio rendered</returns>
+		YonaiAPI double GetCostPerSecond();
+
+		YonaiAPI void ResetStats();
+	};
+}
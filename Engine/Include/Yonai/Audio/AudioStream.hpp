@@ -0,0 +1,172 @@
+#pragma once
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include <condition_variable>
+#include <miniaudio.h>
+#include <Yonai/API.hpp>
+#include <Yonai/IO/ByteSpan.hpp>
+
+namespace Yonai
+{
+	class AudioStream;
+
+	/// <summary>
+	/// Data source handed to miniaudio, which casts it to ma_data_source_base
+	/// </summary>
+	struct AudioStreamSource
+	{
+		ma_data_source_base Base;
+		AudioStream* Stream;
+	};
+
+	/// <summary>
+	/// Decodes an audio file ahead of playback in small chunks, on a background thread shared by all streams.
+	/// Only a few chunks of decoded audio are held in memory, instead of the entire clip.
+	///
+	/// Read by miniaudio's mixer through GetDataSource, which never waits on decoding -
+	/// if decoding falls behind, silence is output and counted by GetUnderrunCount.
+	/// </summary>
+	class AudioStream
+	{
+		AudioStreamSource m_Source;
+		ma_decoder m_Decoder;
+		bool m_Valid;
+
+		ma_uint32 m_Channels;
+		ma_uint32 m_SampleRate;
+		ma_channel m_ChannelMap[MA_MAX_CHANNELS];
+
+		/// <summary>
+		/// Total length in PCM frames, or 0 if unknown
+		/// </summary>
+		ma_uint64 m_Length;
+
+		/// <summary>
+		/// Decoded frames, written by the decoding thread and read by the mixer
+		/// </summary>
+		std::vector<float> m_Buffer;
+		ma_uint64 m_BufferFrames;
+
+		/// <summary>
+		/// Total frames written to and read from m_Buffer, position in buffer is modulo m_BufferFrames
+		/// </summary>
+		std::atomic<ma_uint64> m_WriteFrame;
+		std::atomic<ma_uint64> m_ReadFrame;
+
+		/// <summary>
+		/// Frame of the clip that will next be read by the mixer
+		/// </summary>
+		std::atomic<ma_uint64> m_Cursor;
+
+		/// <summary>
+		/// Decoder has reached the end of a non-looping clip
+		/// </summary>
+		std::atomic_bool m_AtEnd;
+
+		/// <summary>
+		/// Seeks are requested by the mixer and performed by the decoding thread.
+		/// A seek is pending while m_SeekRequest differs from m_SeekHandled.
+		/// </summary>
+		std::atomic<ma_uint64> m_SeekTarget;
+		std::atomic_uint m_SeekRequest;
+		std::atomic_uint m_SeekHandled;
+
+		std::atomic_uint m_Underruns;
+
+		static std::mutex s_Mutex;
+		static std::thread s_Thread;
+		static bool s_Running;
+		static std::condition_variable s_Wake;
+		static std::vector<AudioStream*> s_Streams;
+
+		static void DecodeLoop();
+
+		AudioStream();
+
+		/// <summary>
+		/// Reads the format of the newly initialised decoder and starts decoding
+		/// </summary>
+		/// <param name="name">Describes the clip in errors</param>
+		void Open(ma_result decoderResult, const std::string& name);
+
+		/// <summary>
+		/// Performs pending seeks and decodes a single chunk, if there is space. Called with s_Mutex held.
+		/// </summary>
+		/// <returns>True if there is space for more chunks</returns>
+		bool Fill();
+
+		/// <summary>
+		/// Decodes up to frameCount frames in to the buffer, in a single contiguous region
+		/// </summary>
+		ma_uint64 Decode(ma_uint64 frameCount);
+
+		static ma_result OnRead(ma_data_source* source, void* output, ma_uint64 frameCount, ma_uint64* framesRead);
+		static ma_result OnSeek(ma_data_source* source, ma_uint64 frame);
+		static ma_result OnGetDataFormat(ma_data_source* source, ma_format* format, ma_uint32* channels, ma_uint32* sampleRate, ma_channel* channelMap, size_t channelMapCapacity);
+		static ma_result OnGetCursor(ma_data_source* source, ma_uint64* cursor);
+		static ma_result OnGetLength(ma_data_source* source, ma_uint64* length);
+
+		static ma_data_source_vtable s_VTable;
+
+		friend struct AudioStreamShutdown;
+
+	public:
+		/// <summary>
+		/// Frames decoded at a time by the decoding thread
+		/// </summary>
+		static constexpr ma_uint32 ChunkFrames = 4096;
+
+		/// <summary>
+		/// Chunks of decoded audio held ahead of the mixer
+		/// </summary>
+		static constexpr ma_uint32 BufferedChunks = 4;
+
+		/// <summary>
+		/// Opens an audio file for streaming. Check IsValid before use.
+		/// </summary>
+		YonaiAPI AudioStream(const std::string& path);
+
+		/// <summary>
+		/// Streams an encoded clip already in memory, such as an uncompressed entry of a mapped pack file.
+		/// Data is not copied and must outlive the stream. Check IsValid before use.
+		/// </summary>
+		/// <param name="name">Describes the clip in errors</param>
+		YonaiAPI AudioStream(IO::ByteSpan data, const std::string& name);
+		YonaiAPI ~AudioStream();
+
+		AudioStream(const AudioStream&) = delete;
+		AudioStream& operator=(const AudioStream&) = delete;
+
+		YonaiAPI bool IsValid();
+
+		/// <returns>Data source to pass to miniaudio, such as ma_sound_init_from_data_source</returns>
+		YonaiAPI ma_data_source* GetDataSource();
+
+		/// <returns>Total length in PCM frames, as reported by the decoder</returns>
+		YonaiAPI ma_uint64 GetLength();
+
+		/// <returns>Total length in seconds, as reported by the decoder</returns>
+		YonaiAPI float GetLengthSeconds();
+
+		YonaiAPI ma_uint32 GetChannels();
+		YonaiAPI ma_uint32 GetSampleRate();
+
+		/// <returns>Decoded frames waiting to be read</returns>
+		YonaiAPI ma_uint64 GetBufferedFrames();
+
+		/// <returns>True while a seek is waiting on the decoding thread, during which silence is read</returns>
+		YonaiAPI bool IsSeeking();
+
+		/// <returns>True once all frames of a non-looping clip have been decoded</returns>
+		YonaiAPI bool IsDecodeFinished();
+
+		/// <returns>Amount of reads that output silence because decoding had fallen behind</returns>
+		YonaiAPI unsigned int GetUnderrunCount();
+
+		/// <returns>Bytes held by this stream and its decoded audio, not including allocations made by the decoder</returns>
+		YonaiAPI size_t GetMemoryUsage();
+	};
+}
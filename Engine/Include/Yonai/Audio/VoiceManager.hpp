@@ -0,0 +1,108 @@
+#pragma once
+#include <vector>
+#include <miniaudio.h>
+#include <Yonai/API.hpp>
+
+namespace Yonai
+{
+	/// <summary>
+	/// A playing sound competing for one of the limited real voices
+	/// </summary>
+	struct AudioVoice
+	{
+		/// <summary>
+		/// Higher priority voices are chosen before lower priority voices, regardless of audibility
+		/// </summary>
+		int Priority = 0;
+
+		/// <summary>
+		/// Volume heard at the closest listener, after attenuation
+		/// </summary>
+		float Audibility = 0.0f;
+
+		/// <summary>
+		/// True if currently being mixed
+		/// </summary>
+		bool Real = false;
+
+		/// <summary>
+		/// Set by VoiceManager::Assign, true if this voice should be mixed
+		/// </summary>
+		bool ShouldBeReal = false;
+	};
+
+	/// <summary>
+	/// Chooses which playing sounds are mixed when there are more than the mixer can afford.
+	/// The rest are virtual - their play time continues to advance, without being mixed.
+	/// </summary>
+	class VoiceManager
+	{
+		unsigned int m_MaxRealVoices;
+		float m_AudibilityThreshold;
+		float m_Hysteresis;
+
+		unsigned int m_RealCount;
+		unsigned int m_VirtualCount;
+		unsigned int m_Promotions;
+		unsigned int m_Demotions;
+
+		/// <summary>
+		/// Voice indices sorted by importance, kept between calls to avoid reallocating
+		/// </summary>
+		std::vector<unsigned int> m_Order;
+
+	public:
+		/// <summary>
+		/// Time taken to fade voices in when becoming real, and out when becoming virtual
+		/// </summary>
+		static constexpr unsigned int FadeMilliseconds = 50;
+
+		YonaiAPI VoiceManager(unsigned int maxRealVoices = 64);
+
+		/// <summary>
+		/// Sets ShouldBeReal of each voice, choosing up to the maximum real voices by priority and then audibility.
+		/// Voices quieter than the audibility threshold are never real.
+		/// </summary>
+		/// <returns>Amount of real voices</returns>
+		YonaiAPI unsigned int Assign(std::vector<AudioVoice>& voices);
+
+		/// <summary>
+		/// Gain applied by miniaudio's distance attenuation, matching ma_sound's spatialisation
+		/// </summary>
+		YonaiAPI static float GetAttenuation(ma_attenuation_model model, float distance, float minDistance, float maxDistance, float rolloff, float minGain, float maxGain);
+
+		YonaiAPI unsigned int GetMaxRealVoices();
+
+		/// <summary>
+		/// Sets the maximum amount of voices mixed at once, or 0 for no limit
+		/// </summary>
+		YonaiAPI void SetMaxRealVoices(unsigned int count);
+
+		YonaiAPI float GetAudibilityThreshold();
+
+		/// <summary>
+		/// Sets the volume, after attenuation, below which voices are virtual even when real voices are available
+		/// </summary>
+		YonaiAPI void SetAudibilityThreshold(float threshold);
+
+		YonaiAPI float GetHysteresis();
+
+		/// <summary>
+		/// Sets how much louder, as a fraction, a virtual voice must be to replace a real voice of the same priority.
+		/// Stops voices of similar audibility repeatedly swapping.
+		/// </summary>
+		YonaiAPI void SetHysteresis(float hysteresis);
+
+		/// <returns>Amount of real voices after the last Assign</returns>
+		YonaiAPI unsigned int GetRealCount();
+
+		/// <returns>Amount of virtual voices after the last Assign</returns>
+		YonaiAPI unsigned int GetVirtualCount();
+
+		/// <returns>Amount of voices that became real in the last Assign</returns>
+		YonaiAPI unsigned int GetPromotions();
+
+		/// <returns>Amount of voices that became virtual in the last Assign</returns>
+		YonaiAPI unsigned int GetDemotions();
+	};
+}
@@ -1,9 +1,14 @@
 #pragma once
+#include <memory>
 #include <miniaudio.h>
 #include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
 #include <Yonai/API.hpp>
 #include <Yonai/ResourceID.hpp>
 #include <Yonai/Audio/AudioMixer.hpp>
+#include <Yonai/Audio/AudioStream.hpp>
+#include <Yonai/Audio/AudioDecodeCache.hpp>
+#include <Yonai/Audio/AudioCommandQueue.hpp>
 #include <Yonai/Components/Component.hpp>
 
 namespace Yonai
@@ -108,6 +113,26 @@ namespace Yonai
 			YonaiAPI float GetAttenuationRolloff();
 			YonaiAPI void SetAttenuationRolloff(float factor);
 
+			YonaiAPI int GetPriority();
+
+			/// <summary>
+			/// Sources with a higher priority are chosen to be mixed before lower priority sources,
+			/// when more sources are playing than AudioSystem's maximum voices
+			/// </summary>
+			YonaiAPI void SetPriority(int priority);
+
+			/// <summary>
+			/// True while playing without being mixed, such as when inaudible or there are too many sources playing.
+			/// Play time continues to advance while virtual.
+			/// </summary>
+			YonaiAPI bool IsVirtual();
+
+			/// <summary>
+			/// True while playing beyond the maximum rolloff distance from every listener.
+			/// Culled sources are virtual, and are not considered for mixing until back in range.
+			/// </summary>
+			YonaiAPI bool IsCulled();
+
 			/// <summary>
 			/// Sets the output mixer, or nullptr for master output
 			/// <summary>
@@ -121,6 +146,14 @@ namespace Yonai
 		private:
 			ma_sound m_Data = {};
 			ma_decoder m_Decoder = {};
+
+			// Decodes the clip when streamed from disk, instead of m_Decoder
+			AudioStream* m_Stream = nullptr;
+
+			// Reads the clip when already decoded by AudioSystem's decode cache, instead of m_Decoder
+			ma_audio_buffer m_Buffer = {};
+			std::shared_ptr<AudioDecodedClip> m_Clip;
+
 			ResourceID m_Sound = InvalidResourceID;
 			ResourceID m_Mixer = InvalidResourceID;
 
@@ -144,8 +177,63 @@ namespace Yonai
 			// Where to seek when resuming
 			ma_uint64 m_PausedFrames = 0;
 
+			// Sample rate and length of loaded sound, in PCM frames
+			ma_uint32 m_SampleRate = 0;
+			ma_uint64 m_LengthFrames = 0;
+
+			int m_Priority = 0;
+
+			// Virtual voice state, play time advances from m_VirtualCursor since engine time m_VirtualTime
+			bool m_Virtual = false;
+			ma_uint64 m_VirtualCursor = 0;
+			ma_uint64 m_VirtualTime = 0;
+
 			SoundState m_State = SoundState::Stopped;
 
+			// Distance culling, position is only read from the transform when it has changed
+			bool m_CullingTracked = false;
+			bool m_Culled = false;
+			uint64_t m_TransformChange = 0;
+			glm::vec3 m_Position = { 0, 0, 0 };
+			float m_CullRadius = 0.0f;
+
+			// AudioSystem's culling query count when last found in range of a listener
+			unsigned int m_InRangeQuery = 0;
+
+			/// <returns>Distance beyond which this source is culled, or infinity if never culled</returns>
+			float GetCullRadius();
+
+			/// <summary>
+			/// Releases the miniaudio sound and the decoder or stream feeding it
+			/// </summary>
+			void ReleaseSound();
+
+			/// <summary>
+			/// Queues a change to this sound, applied by the audio thread
+			/// </summary>
+			void Submit(AudioCommandType type, float x = 0.0f, float y = 0.0f, float z = 0.0f, ma_uint64 frame = 0);
+
+			/// <returns>Time taken to fade between real and virtual, in engine frames</returns>
+			ma_uint64 GetVoiceFadeFrames();
+
+			/// <returns>Current play position in PCM frames of the sound, including while virtual</returns>
+			ma_uint64 GetCursor();
+
+			/// <summary>
+			/// Fades out and stops mixing, while continuing to track play time
+			/// </summary>
+			void MakeVirtual();
+
+			/// <summary>
+			/// Resumes mixing from the tracked play time, fading in
+			/// </summary>
+			void MakeReal();
+
+			/// <summary>
+			/// Clears virtual state and any fade, leaving the sound stopped
+			/// </summary>
+			void ResetVoice();
+
 			/// <summary>
 			/// Calls UpdateState(uint state) in managed C# code for this component
 			/// </summary>
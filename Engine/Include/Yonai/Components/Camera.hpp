@@ -21,6 +21,13 @@ namespace Yonai::Components
 		YonaiAPI glm::mat4 GetProjectionMatrix(glm::ivec2 resolution);
 		YonaiAPI glm::mat4 GetProjectionMatrix(int resolutionWidth, int resolutionHeight);
 
+		/// <summary>
+		/// Projected size of a sphere, as the ratio of its radius to half the smaller screen dimension.
+		/// A sphere exactly filling the screen's height or width is 1.
+		/// </summary>
+		/// <param name="centre">World space centre of the sphere</param>
+		YonaiAPI float GetScreenSize(glm::vec3 centre, float radius, glm::ivec2 resolution);
+
 		YonaiAPI void FillShader(Graphics::Shader* shader, glm::ivec2 resolution);
 
 	private:
@@ -1,7 +1,14 @@
 #pragma once
 #include <vector>
+#include <glm/glm.hpp>
+#include <Yonai/Resource.hpp>
 #include <Yonai/ResourceID.hpp>
+#include <Yonai/Graphics/Mesh.hpp>
+#include <Yonai/Components/Camera.hpp>
 #include <Yonai/Components/Component.hpp>
+#include <Yonai/Components/Transform.hpp>
+
+namespace Yonai::Graphics { struct Material; }
 
 namespace Yonai::Components
 {
@@ -9,5 +16,37 @@ namespace Yonai::Components
 	{
 		ResourceID Mesh;
 		ResourceID Material;
+
+		/// <summary>
+		/// Offsets level of detail selection. Each increase of 1 switches to lower detail levels at twice the screen size.
+		/// </summary>
+		float LODBias = 0.0f;
+
+		/// <summary>
+		/// Fraction screen size must pass a level's threshold by before switching, prevents flickering between levels
+		/// </summary>
+		float LODHysteresis = 0.1f;
+
+		/// <summary>
+		/// Level of detail drawn last frame
+		/// </summary>
+		unsigned int CurrentLOD = 0;
+
+		/// <summary>
+		/// Selects the level of detail to draw, based on the mesh's bounding sphere as seen by camera.
+		/// Meshes in an arena are always drawn at full detail.
+		/// </summary>
+		/// <returns>The new CurrentLOD</returns>
+		YonaiAPI unsigned int UpdateLOD(Graphics::Mesh* mesh, Transform* transform, Camera* camera, glm::ivec2 resolution);
+
+		/// <returns>Resource of Mesh, or null if not loaded. Only looked up again when Mesh changes or is unloaded.</returns>
+		YonaiAPI Graphics::Mesh* GetMesh();
+
+		/// <returns>Resource of Material, or null if not loaded. Only looked up again when Material changes or is unloaded.</returns>
+		YonaiAPI Graphics::Material* GetMaterial();
+
+	private:
+		CachedResource<Graphics::Mesh> m_MeshCache;
+		CachedResource<Graphics::Material> m_MaterialCache;
 	};
-}
\ No newline at end of file
+}
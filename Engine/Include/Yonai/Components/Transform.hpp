@@ -45,6 +45,12 @@ namespace Yonai::Components
 		YonaiAPI void UpdateModelMatrices(bool force = false);
 
 		YonaiAPI glm::mat4 GetModelMatrix(bool global = true);
+
+		/// <summary>
+		/// Increases whenever this transform, or any of its parents, are moved, rotated, scaled or re-parented.
+		/// Compared against a previously returned value to skip work for transforms that have not changed.
+		/// </summary>
+		YonaiAPI uint64_t GetLastChange();
 		YonaiAPI void SetModelMatrix(glm::mat4& matrix, bool global);
 
 		#pragma region Getters
@@ -109,6 +115,15 @@ namespace Yonai::Components
 		// When true, local and/or global matrices need updating
 		bool m_IsDirty = true;
 
+		// Value of s_ChangeCounter when this transform, or any of its parents, last changed
+		uint64_t m_LastChange = ++s_ChangeCounter;
+		static uint64_t s_ChangeCounter;
+
+		void MarkDirty();
+
+		// Sets the last change of this transform and all of its children, so GetLastChange does not walk up the hierarchy
+		void PropagateChange(uint64_t change);
+
 		Transform* m_Parent = nullptr;
 		std::unordered_map<UUID, Transform*> m_Children = {};
 
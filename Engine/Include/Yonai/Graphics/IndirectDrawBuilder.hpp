@@ -0,0 +1,168 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include <glm/glm.hpp>
+#include <Yonai/API.hpp>
+#include <Yonai/ResourceID.hpp>
+#include <Yonai/Graphics/MeshArena.hpp>
+
+namespace Yonai::Graphics
+{
+	/// <summary>
+	/// Builds DrawElementsIndirectCommand records and per-draw data for meshes stored in a MeshArena,
+	/// so each group of draws sharing an arena, shader and material is submitted with a single glMultiDrawElementsIndirect.
+	///
+	/// Command generation happens on the CPU in End(),
+	/// OpenGL resources are only created once Upload() is called.
+	/// </summary>
+	class IndirectDrawBuilder
+	{
+	public:
+		/// <summary>
+		/// Matches the layout expected by glMultiDrawElementsIndirect
+		/// </summary>
+		struct DrawElementsIndirectCommand
+		{
+			unsigned int Count;
+			unsigned int InstanceCount;
+			unsigned int FirstIndex;
+			int BaseVertex;
+
+			/// <summary>
+			/// Index of this draw in the draw data buffer
+			/// </summary>
+			unsigned int BaseInstance;
+		};
+
+		/// <summary>
+		/// Per-draw data, matches std430 layout of "DrawData" in Shaders/Include/DrawData.inc
+		/// </summary>
+		struct DrawData
+		{
+			glm::mat4 ModelMatrix;
+
+			/// <summary>
+			/// Index in to GetMaterials()
+			/// </summary>
+			unsigned int MaterialIndex;
+			unsigned int Padding[3];
+		};
+
+		struct Group
+		{
+			MeshArena* Arena = nullptr;
+			ResourceID Shader = InvalidResourceID;
+			ResourceID Material = InvalidResourceID;
+			GLenum DrawMode = GL_TRIANGLES;
+
+			unsigned int FirstCommand = 0;
+			unsigned int CommandCount = 0;
+		};
+
+		/// <summary>
+		/// Shader storage binding of the draw data buffer
+		/// </summary>
+		static constexpr unsigned int DrawDataBinding = 0;
+
+		/// <summary>
+		/// Per-instance vertex attribute holding the draw index, sourced using each command's BaseInstance.
+		/// Allows shaders to index draw data without requiring gl_DrawID or gl_BaseInstance.
+		/// </summary>
+		static constexpr unsigned int DrawIndexAttribute = 3;
+
+	private:
+		struct DrawInfo
+		{
+			MeshArena* Arena;
+			ResourceID Shader;
+			ResourceID Material;
+			GLenum DrawMode;
+			MeshArena::Allocation Allocation;
+			glm::mat4 ModelMatrix;
+		};
+
+		struct ShaderSupport
+		{
+			unsigned int Program = 0; // Never a valid program
+			bool Supported = false;
+		};
+
+		/// <summary>
+		/// Whether each shader declares "DrawDataBuffer", requeried when the shader's program changes
+		/// </summary>
+		static std::unordered_map<ResourceID, ShaderSupport> s_ShaderSupport;
+
+		bool m_Building = false;
+		std::vector<Group> m_Groups;
+		std::vector<DrawInfo> m_Draws;
+		std::vector<DrawData> m_DrawData;
+		std::vector<ResourceID> m_Materials;
+		std::vector<DrawElementsIndirectCommand> m_Commands;
+
+		// OpenGL resources //
+		unsigned int m_CommandBuffer, m_DrawDataBuffer, m_DrawIndexBuffer;
+		unsigned int m_CommandCapacity = 0;
+		unsigned int m_DrawIndexCapacity = 0;
+
+		void Setup();
+
+	public:
+		YonaiAPI IndirectDrawBuilder();
+		YonaiAPI ~IndirectDrawBuilder();
+
+		/// <summary>
+		/// Clears previously submitted draws
+		/// </summary>
+		YonaiAPI void Begin();
+
+		/// <summary>
+		/// Adds an indexed mesh stored in an arena
+		/// </summary>
+		/// <returns>False if the allocation has no indices, and must be drawn another way</returns>
+		YonaiAPI bool Submit(
+			MeshArena* arena,
+			const MeshArena::Allocation& allocation,
+			ResourceID shader,
+			ResourceID material,
+			const glm::mat4& modelMatrix,
+			GLenum drawMode = GL_TRIANGLES
+		);
+
+		/// <summary>
+		/// Sorts submitted draws by arena, shader then material and generates commands and draw data
+		/// </summary>
+		YonaiAPI void End();
+
+		/// <summary>
+		/// Uploads commands and draw data, binding the command buffer and draw data buffer.
+		/// End() must be called beforehand.
+		/// </summary>
+		YonaiAPI void Upload();
+
+		/// <summary>
+		/// Binds the group's arena and issues a single multi-draw for all its commands.
+		/// Upload() must be called beforehand, and the group's shader bound.
+		/// </summary>
+		YonaiAPI void Draw(const Group& group);
+
+		YonaiAPI std::vector<Group>& GetGroups();
+		YonaiAPI std::vector<DrawData>& GetDrawData();
+		YonaiAPI std::vector<ResourceID>& GetMaterials();
+		YonaiAPI std::vector<DrawElementsIndirectCommand>& GetCommands();
+
+		/// <returns>Amount of draws submitted since Begin()</returns>
+		YonaiAPI unsigned int GetDrawCount();
+
+		/// <summary>
+		/// Checks if the OpenGL context supports glMultiDrawElementsIndirect and shader storage buffers (4.3+)
+		/// </summary>
+		YonaiAPI static bool IsSupported();
+
+		/// <summary>
+		/// Checks if a shader reads per-draw data from the "DrawDataBuffer" storage block,
+		/// such as shaders including Shaders/Include/DrawData.inc
+		/// </summary>
+		/// <param name="program">Linked program of the shader, result is cached until this changes</param>
+		YonaiAPI static bool ShaderSupportsIndirect(ResourceID shader, unsigned int program);
+	};
+}
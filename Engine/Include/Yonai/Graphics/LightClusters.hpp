@@ -0,0 +1,149 @@
+#pragma once
+#include <vector>
+#include <glm/glm.hpp>
+#include <Yonai/API.hpp>
+#include <Yonai/Graphics/Shader.hpp>
+
+// Forward declarations
+namespace Yonai::Components
+{
+	struct Light;
+	struct Camera;
+	struct Transform;
+}
+
+namespace Yonai::Graphics
+{
+	/// <summary>
+	/// Bins point lights in to a grid of view-space clusters ("froxels"), so shading only evaluates lights
+	/// overlapping the cluster a fragment lies in.
+	///
+	/// Clusters are uniform tiles in screen space, and exponentially distributed slices in depth.
+	/// Binning happens on the CPU in Build(), OpenGL resources are only created once Upload() is called.
+	/// </summary>
+	class LightClusters
+	{
+	public:
+		/// <summary>
+		/// Matches std430 layout of "ClusterLight" in Shaders/Include/ClusteredLights.inc
+		/// </summary>
+		struct LightData
+		{
+			/// <summary>
+			/// World space position in xyz, radius in w
+			/// </summary>
+			glm::vec4 PositionRadius;
+
+			/// <summary>
+			/// RGB colour, intensity in w
+			/// </summary>
+			glm::vec4 Colour;
+		};
+
+		/// <summary>
+		/// Range in to GetLightIndices() of lights affecting a cluster
+		/// </summary>
+		struct Cluster
+		{
+			unsigned int Offset;
+			unsigned int Count;
+		};
+
+		static constexpr unsigned int DefaultGridX = 16;
+		static constexpr unsigned int DefaultGridY = 9;
+		static constexpr unsigned int DefaultGridZ = 24;
+
+		/// <summary>
+		/// Shader storage bindings, DrawData uses binding 0
+		/// </summary>
+		static constexpr unsigned int LightsBinding = 1;
+		static constexpr unsigned int ClustersBinding = 2;
+		static constexpr unsigned int LightIndicesBinding = 3;
+
+	private:
+		glm::uvec3 m_GridSize;
+		float m_Near = 0.1f, m_Far = 1000.0f;
+
+		std::vector<LightData> m_Lights;
+		std::vector<Cluster> m_Clusters;
+		std::vector<unsigned int> m_LightIndices;
+
+		/// <summary>
+		/// View space bounds of each cluster, min in [0] and max in [1]
+		/// </summary>
+		std::vector<glm::vec3> m_ClusterBounds;
+
+		/// <summary>
+		/// Scratch space for binning, pairs of (cluster, light)
+		/// </summary>
+		std::vector<glm::uvec2> m_Pairs;
+
+		// OpenGL resources //
+		unsigned int m_LightsBuffer, m_ClustersBuffer, m_LightIndicesBuffer;
+
+		void Setup();
+		void CalculateClusterBounds(const glm::mat4& projection, bool orthographic);
+
+		/// <returns>Depth slice containing a view space depth, can be outside of grid</returns>
+		int GetSlice(float depth) const;
+
+	public:
+		YonaiAPI LightClusters(glm::uvec3 gridSize = { DefaultGridX, DefaultGridY, DefaultGridZ });
+		YonaiAPI ~LightClusters();
+
+		/// <summary>
+		/// Bins lights in to clusters of the camera's view frustum
+		/// </summary>
+		/// <param name="view">Camera view matrix, looking down -Z</param>
+		/// <param name="projection">Camera projection matrix</param>
+		/// <param name="near">Near plane distance, used for depth slices</param>
+		/// <param name="far">Far plane distance, used for depth slices</param>
+		YonaiAPI void Build(
+			const glm::mat4& view,
+			const glm::mat4& projection,
+			float near,
+			float far,
+			bool orthographic,
+			const std::vector<LightData>& lights
+		);
+
+		/// <summary>
+		/// Bins light components in to clusters of a camera's view frustum
+		/// </summary>
+		YonaiAPI void Build(
+			Components::Camera* camera,
+			glm::ivec2 resolution,
+			std::vector<std::pair<Components::Light*, Components::Transform*>>& lights
+		);
+
+		/// <summary>
+		/// Uploads lights and cluster lists to shader storage buffers, and binds them.
+		/// Build() must be called beforehand.
+		/// </summary>
+		YonaiAPI void Upload();
+
+		/// <summary>
+		/// Sets uniforms required to find the cluster of a fragment
+		/// </summary>
+		YonaiAPI void FillShader(Shader* shader, glm::ivec2 resolution);
+
+		YonaiAPI glm::uvec3 GetGridSize();
+		YonaiAPI void SetGridSize(glm::uvec3 gridSize);
+
+		YonaiAPI unsigned int GetClusterIndex(glm::uvec3 cluster);
+
+		YonaiAPI std::vector<LightData>& GetLights();
+		YonaiAPI std::vector<Cluster>& GetClusters();
+		YonaiAPI std::vector<unsigned int>& GetLightIndices();
+
+		/// <summary>
+		/// Lights affecting a single cluster
+		/// </summary>
+		YonaiAPI std::vector<unsigned int> GetClusterLights(glm::uvec3 cluster);
+
+		/// <summary>
+		/// Checks if the OpenGL context supports shader storage buffers (4.3+)
+		/// </summary>
+		YonaiAPI static bool IsSupported();
+	};
+}
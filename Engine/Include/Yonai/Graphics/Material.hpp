@@ -2,12 +2,13 @@
 #include <glm/glm.hpp>
 #include <unordered_map>
 #include <Yonai/ResourceID.hpp>
+#include <Yonai/ResourceBase.hpp>
 #include <Yonai/Application.hpp>
 #include <Yonai/Graphics/Shader.hpp>
 
 namespace Yonai::Graphics
 {
-	struct Material
+	struct Material : public ResourceBase
 	{
 		/// <summary>
 		/// Shader program to draw attached meshes
@@ -98,6 +99,17 @@ namespace Yonai::Graphics
 		/// Enables translucency and transparency on rendered mesh
 		/// </summary>
 		bool Transparent = false;
+
+		/// <summary>
+		/// Model this material was imported from, if any
+		/// </summary>
+		ResourceID Source = InvalidResourceID;
+
+		/// <summary>
+		/// Registers the shader, textures and source model as dependencies of this material, so it is reloaded after them.
+		/// Call after changing any of them.
+		/// </summary>
+		YonaiAPI void UpdateDependencies();
 		
 		/// <summary>
 		/// Retrieves the relevant shader, binds it and and textures.
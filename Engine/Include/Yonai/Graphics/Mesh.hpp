@@ -1,11 +1,14 @@
 #pragma once
 #include <vector>
+#include <cstdint>
 #include <glm/glm.hpp>
 #include <glad/glad.h>
 #include <Yonai/ResourceID.hpp>
 
 namespace Yonai::Graphics
 {
+	class MeshArena;
+
 	class Mesh
 	{
 	public:
@@ -28,14 +31,90 @@ namespace Yonai::Graphics
 			glm::vec2 TexCoords;
 		};
 
+		/// <summary>
+		/// Vertex layout uploaded by quantised meshes, 20 bytes instead of 32
+		/// </summary>
+		struct PackedVertex
+		{
+			glm::vec3 Position;
+
+			/// <summary>
+			/// Normalised GL_INT_2_10_10_10_REV, read by shaders as a vec3
+			/// </summary>
+			uint32_t Normal;
+
+			/// <summary>
+			/// Half floats
+			/// </summary>
+			uint16_t TexCoords[2];
+		};
+
+		/// <summary>
+		/// Range of the index buffer drawn for a level of detail
+		/// </summary>
+		struct LOD
+		{
+			unsigned int FirstIndex;
+			unsigned int IndexCount;
+
+			/// <summary>
+			/// This level is used while the mesh's screen size, its bounding sphere radius relative to half the screen, is below this value
+			/// </summary>
+			float ScreenSize;
+		};
+
 	private:
 		unsigned int m_VBO, m_VAO, m_EBO;
 
+		/// <summary>
+		/// When true, vertices are uploaded as PackedVertex and indices as 16-bit when possible
+		/// </summary>
+		bool m_Quantised;
+
+		/// <summary>
+		/// Type of uploaded indices, GL_UNSIGNED_INT or GL_UNSIGNED_SHORT
+		/// </summary>
+		unsigned int m_IndexType;
+
 		DrawMode m_DrawMode;
 		std::vector<Vertex> m_Vertices;
 		std::vector<unsigned int> m_Indices;
 
+		/// <summary>
+		/// Levels of detail, first is always the full index list
+		/// </summary>
+		std::vector<LOD> m_LODs;
+
+		/// <summary>
+		/// Indices of all levels after the first, uploaded after m_Indices in the index buffer
+		/// </summary>
+		std::vector<unsigned int> m_LODIndices;
+
+		/// <summary>
+		/// Bounding sphere of vertex positions, in local space
+		/// </summary>
+		glm::vec3 m_BoundsCentre;
+		float m_BoundsRadius;
+
+		/// <summary>
+		/// When set, vertex and index data is stored in this shared arena instead of buffers owned by the mesh
+		/// </summary>
+		MeshArena* m_Arena;
+		unsigned int m_ArenaHandle;
+
+		/// <summary>
+		/// Arena used by newly created meshes
+		/// </summary>
+		static MeshArena* s_DefaultArena;
+
 		void Setup();
+		void Release();
+		void UploadIndices();
+
+		/// <summary>
+		/// Fills level of detail ranges and indices, without uploading them
+		/// </summary>
+		void BuildLODs(const std::vector<std::vector<unsigned int>>& lods, const std::vector<float>& screenSizes);
 
 	public:
 		Mesh();
@@ -43,13 +122,81 @@ namespace Yonai::Graphics
 		~Mesh();
 
 		YonaiAPI void Draw();
+
+		/// <summary>
+		/// Draws a level of detail, clamped to the available levels. Meshes in an arena always draw the first level.
+		/// </summary>
+		YonaiAPI void Draw(unsigned int lod);
 		YonaiAPI void Import(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices, DrawMode drawMode = DrawMode::Triangles);
 
+		/// <summary>
+		/// Imports a mesh with levels of detail after the first, uploading indices once. See SetLODs.
+		/// </summary>
+		YonaiAPI void Import(
+			std::vector<Vertex>& vertices,
+			std::vector<unsigned int>& indices,
+			const std::vector<std::vector<unsigned int>>& lods,
+			DrawMode drawMode = DrawMode::Triangles
+		);
+
 		YonaiAPI std::vector<Vertex>& GetVertices();
 		YonaiAPI void SetVertices(std::vector<Vertex>& vertices);
 		YonaiAPI std::vector<unsigned int>& GetIndices();
 		YonaiAPI void SetIndices(std::vector<unsigned int>& indices);
 
+		/// <summary>
+		/// Replaces levels of detail after the first, which is always GetIndices().
+		/// Each level's indices reference the existing vertices. Levels are cleared when indices change.
+		/// </summary>
+		/// <param name="screenSizes">Screen size each level is used below, defaults to halving for each level</param>
+		YonaiAPI void SetLODs(const std::vector<std::vector<unsigned int>>& lods, const std::vector<float>& screenSizes = {});
+
+		/// <summary>
+		/// Simplifies the mesh to create levels of detail, each with approximately reduction times the previous level's triangles.
+		/// Stops early when the mesh cannot be reduced further. Only triangle lists are simplified.
+		/// </summary>
+		YonaiAPI void GenerateLODs(unsigned int count, float reduction = 0.5f);
+
+		/// <returns>Amount of levels of detail, including the full detail mesh</returns>
+		YonaiAPI unsigned int GetLODCount();
+		YonaiAPI const LOD& GetLOD(unsigned int level);
+
+		/// <summary>
+		/// Chooses a level of detail based on screen size.
+		/// Levels only change once screen size passes a threshold by the hysteresis fraction, avoiding flickering between levels.
+		/// </summary>
+		YonaiAPI unsigned int SelectLOD(float screenSize, unsigned int currentLOD, float hysteresis = 0.1f);
+		YonaiAPI static unsigned int SelectLOD(const std::vector<LOD>& lods, float screenSize, unsigned int currentLOD, float hysteresis = 0.1f);
+
+		YonaiAPI glm::vec3 GetBoundsCentre();
+		YonaiAPI float GetBoundsRadius();
+
+		/// <summary>
+		/// Moves vertex and index data in to a shared arena, or back to buffers owned by this mesh when null.
+		/// Meshes in the same arena can be drawn without rebinding vertex arrays.
+		/// </summary>
+		YonaiAPI void SetArena(MeshArena* arena);
+		YonaiAPI MeshArena* GetArena();
+
+		/// <returns>Handle of this mesh's allocation in GetArena()</returns>
+		YonaiAPI unsigned int GetArenaHandle();
+
+		YonaiAPI DrawMode GetDrawMode();
+
+		/// <summary>
+		/// Uploads normals as 10-bit integers and texture coordinates as half floats, with 16-bit indices when there are at most 65536 vertices.
+		/// Vertices returned by GetVertices keep full precision. Ignored while the mesh is stored in an arena.
+		/// </summary>
+		YonaiAPI void SetQuantised(bool quantised);
+		YonaiAPI bool IsQuantised();
+
+		/// <summary>
+		/// Sets the arena meshes are created in. Null (default) gives each mesh its own buffers.
+		/// The arena must outlive all meshes created in it.
+		/// </summary>
+		YonaiAPI static void SetDefaultArena(MeshArena* arena);
+		YonaiAPI static MeshArena* GetDefaultArena();
+
 		YonaiAPI static ResourceID Quad();
 		YonaiAPI static ResourceID Cube();
 		YonaiAPI static ResourceID Sphere();
@@ -0,0 +1,166 @@
+#pragma once
+#include <map>
+#include <vector>
+#include <Yonai/API.hpp>
+#include <Yonai/Graphics/Mesh.hpp>
+
+namespace Yonai::Graphics
+{
+	/// <summary>
+	/// First-fit free-list allocator for ranges inside a larger buffer.
+	/// Freed ranges are coalesced with neighbouring free ranges.
+	/// Units are abstract, e.g. vertices or indices.
+	/// </summary>
+	class RangeAllocator
+	{
+	public:
+		static constexpr unsigned int InvalidOffset = ~0u;
+
+		/// <summary>
+		/// A relocated allocation, generated by Compact()
+		/// </summary>
+		struct Move
+		{
+			unsigned int From;
+			unsigned int To;
+			unsigned int Size;
+		};
+
+	private:
+		unsigned int m_Used;
+		unsigned int m_Capacity;
+
+		/// <summary>
+		/// Offset -> size of unused ranges, ordered by offset for coalescing
+		/// </summary>
+		std::map<unsigned int, unsigned int> m_FreeBlocks;
+
+		/// <summary>
+		/// Offset -> size of allocated ranges
+		/// </summary>
+		std::map<unsigned int, unsigned int> m_Allocations;
+
+		void AddFreeBlock(unsigned int offset, unsigned int size);
+
+	public:
+		YonaiAPI RangeAllocator(unsigned int capacity = 0);
+
+		/// <returns>Offset of allocated range, or InvalidOffset if there is no free block large enough</returns>
+		YonaiAPI unsigned int Allocate(unsigned int size);
+
+		/// <summary>
+		/// Releases the range starting at offset
+		/// </summary>
+		YonaiAPI void Free(unsigned int offset);
+
+		/// <summary>
+		/// Increases capacity, adding the new space to the end of the range
+		/// </summary>
+		YonaiAPI void Grow(unsigned int capacity);
+
+		/// <summary>
+		/// Moves all allocations to the start of the range, leaving a single free block at the end.
+		/// </summary>
+		/// <returns>Allocations that changed offset, in ascending order</returns>
+		YonaiAPI std::vector<Move> Compact();
+
+		YonaiAPI unsigned int GetUsed();
+		YonaiAPI unsigned int GetCapacity();
+		YonaiAPI unsigned int GetLargestFreeBlock();
+		YonaiAPI unsigned int GetFreeBlockCount();
+
+		/// <returns>Size of allocation at offset, or 0 if not allocated</returns>
+		YonaiAPI unsigned int GetSize(unsigned int offset);
+	};
+
+	/// <summary>
+	/// Packs many meshes sharing the Mesh::Vertex layout in to a single vertex and index buffer.
+	/// All meshes in an arena share one vertex array, drawing them only requires
+	/// a single bind followed by glDrawElementsBaseVertex per mesh.
+	/// </summary>
+	class MeshArena
+	{
+	public:
+		typedef unsigned int Handle;
+		static constexpr Handle InvalidHandle = ~0u;
+
+		static constexpr unsigned int DefaultVertexCapacity = 1 << 16;
+		static constexpr unsigned int DefaultIndexCapacity = 1 << 18;
+
+		struct Allocation
+		{
+			/// <summary>
+			/// Offset of first vertex in vertex buffer, added to each index when drawing
+			/// </summary>
+			unsigned int BaseVertex = RangeAllocator::InvalidOffset;
+			unsigned int VertexCount = 0;
+
+			/// <summary>
+			/// Offset of first index in index buffer
+			/// </summary>
+			unsigned int FirstIndex = RangeAllocator::InvalidOffset;
+			unsigned int IndexCount = 0;
+
+			bool IsValid = false;
+		};
+
+	private:
+		unsigned int m_VAO, m_VBO, m_EBO;
+
+		RangeAllocator m_VertexAllocator;
+		RangeAllocator m_IndexAllocator;
+
+		std::vector<Allocation> m_Allocations;
+		std::vector<Handle> m_FreeHandles;
+
+		void SetupAttributes();
+		unsigned int AllocateVertices(unsigned int count);
+		unsigned int AllocateIndices(unsigned int count);
+
+		/// <summary>
+		/// Creates a new buffer of newSize bytes, copies regions from the old buffer and releases it
+		/// </summary>
+		static void ReplaceBuffer(unsigned int& buffer, size_t newSize, const std::vector<RangeAllocator::Move>& copies);
+
+	public:
+		YonaiAPI MeshArena(unsigned int vertexCapacity = DefaultVertexCapacity, unsigned int indexCapacity = DefaultIndexCapacity);
+		YonaiAPI ~MeshArena();
+
+		/// <summary>
+		/// Copies mesh data in to the arena
+		/// </summary>
+		YonaiAPI Handle Allocate(const std::vector<Mesh::Vertex>& vertices, const std::vector<unsigned int>& indices);
+
+		/// <summary>
+		/// Replaces mesh data, reallocating when the vertex or index count changes
+		/// </summary>
+		YonaiAPI void Update(Handle handle, const std::vector<Mesh::Vertex>& vertices, const std::vector<unsigned int>& indices);
+
+		YonaiAPI void Free(Handle handle);
+
+		/// <summary>
+		/// Removes gaps left by freed meshes. Handles remain valid.
+		/// </summary>
+		YonaiAPI void Compact();
+
+		YonaiAPI const Allocation& Get(Handle handle);
+
+		/// <summary>
+		/// Binds the shared vertex array
+		/// </summary>
+		YonaiAPI void Bind();
+
+		/// <summary>
+		/// Binds the shared vertex array and draws a single mesh.
+		/// The vertex array is left bound so consecutive draws from this arena don't rebind.
+		/// </summary>
+		YonaiAPI void Draw(Handle handle, GLenum drawMode = GL_TRIANGLES);
+
+		YonaiAPI unsigned int GetVAO();
+		YonaiAPI unsigned int GetVertexBuffer();
+		YonaiAPI unsigned int GetIndexBuffer();
+
+		YonaiAPI RangeAllocator& GetVertexAllocator();
+		YonaiAPI RangeAllocator& GetIndexAllocator();
+	};
+}
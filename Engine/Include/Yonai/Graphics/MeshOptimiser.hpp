@@ -0,0 +1,72 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <Yonai/API.hpp>
+#include <Yonai/Graphics/Mesh.hpp>
+
+namespace Yonai::Graphics
+{
+	/// <summary>
+	/// Reorders triangle lists to make better use of the GPU's post-transform vertex cache and reduce overdraw,
+	/// and packs vertices in to the quantised Mesh::PackedVertex layout
+	/// </summary>
+	class MeshOptimiser
+	{
+	public:
+		/// <summary>
+		/// Size of the simulated LRU cache used when reordering triangles
+		/// </summary>
+		static constexpr unsigned int OptimiseCacheSize = 32;
+
+		/// <summary>
+		/// Size of the FIFO cache used when measuring, close to the cache size of common hardware
+		/// </summary>
+		static constexpr unsigned int DefaultCacheSize = 16;
+
+		/// <summary>
+		/// Vertex cache, overdraw and vertex fetch optimisation, in that order.
+		/// Unused vertices are removed.
+		/// </summary>
+		YonaiAPI static void Optimise(std::vector<Mesh::Vertex>& vertices, std::vector<unsigned int>& indices);
+
+		/// <summary>
+		/// Reorders triangles to reduce vertex cache misses, using Forsyth's linear-speed vertex cache optimisation
+		/// </summary>
+		YonaiAPI static void OptimiseVertexCache(std::vector<unsigned int>& indices, size_t vertexCount);
+
+		/// <summary>
+		/// Splits triangles in to clusters at vertex cache restarts, then sorts clusters so outward facing ones are drawn first.
+		/// Expects indices already optimised with OptimiseVertexCache, which this leaves mostly intact.
+		/// </summary>
+		YonaiAPI static void OptimiseOverdraw(std::vector<unsigned int>& indices, const std::vector<Mesh::Vertex>& vertices);
+
+		/// <summary>
+		/// Reorders vertices in the order they are first referenced by indices, and removes unreferenced vertices
+		/// </summary>
+		YonaiAPI static void OptimiseVertexFetch(std::vector<Mesh::Vertex>& vertices, std::vector<unsigned int>& indices);
+
+		/// <summary>
+		/// Reduces triangle count using quadric error metric edge collapses. Vertices are collapsed on to neighbouring vertices,
+		/// so output indices reference the same vertex buffer. Vertices on open borders and attribute seams are not moved.
+		/// </summary>
+		/// <param name="targetIndexCount">Desired amount of indices, output can be larger when the mesh cannot be reduced further</param>
+		YonaiAPI static void Simplify(const std::vector<Mesh::Vertex>& vertices, const std::vector<unsigned int>& indices, size_t targetIndexCount, std::vector<unsigned int>& output);
+
+		/// <returns>Average cache miss ratio, vertex shader invocations per triangle. 0.5 is optimal for large grids, 3 is the worst case.</returns>
+		YonaiAPI static float CalculateACMR(const std::vector<unsigned int>& indices, size_t vertexCount, unsigned int cacheSize = DefaultCacheSize);
+
+		/// <summary>
+		/// Packs a unit vector in to GL_INT_2_10_10_10_REV, as normalised signed integers
+		/// </summary>
+		YonaiAPI static uint32_t PackNormal(const glm::vec3& normal);
+		YonaiAPI static glm::vec3 UnpackNormal(uint32_t packed);
+
+		/// <summary>
+		/// Converts to a 16-bit IEEE half float, rounding to nearest
+		/// </summary>
+		YonaiAPI static uint16_t ToHalf(float value);
+		YonaiAPI static float FromHalf(uint16_t value);
+
+		YonaiAPI static Mesh::PackedVertex Pack(const Mesh::Vertex& vertex);
+	};
+}
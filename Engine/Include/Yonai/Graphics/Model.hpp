@@ -6,6 +6,7 @@
 #include <Yonai/Application.hpp>
 #include <Yonai/Graphics/Mesh.hpp>
 #include <Yonai/Graphics/Material.hpp>
+#include <Yonai/Graphics/ModelCache.hpp>
 
 namespace Yonai::Graphics
 {
@@ -20,27 +21,71 @@ namespace Yonai::Graphics
 			std::vector<ResourceID> MaterialIDs;
 		};
 
+		/// <summary>
+		/// When true, meshes of a model are converted on worker threads
+		/// </summary>
+		static bool s_ParallelImport;
+
 		MeshData m_Root;
 		std::string m_Path;
 		bool m_ImportMaterials;
+		bool m_OptimiseMeshes;
+		unsigned int m_LODCount;
 		std::vector<ResourceID> m_MeshIDs;
 
-		void Load(std::vector<unsigned char>& data);
-		ResourceID CreateMaterial(aiMaterial* material);
-		ResourceID ProcessMesh(aiMesh* mesh, const aiScene* scene);
-		void ProcessNode(aiNode* node, MeshData* parent, const aiScene* scene);
+		void Load(IO::ByteSpan data);
+
+		static void ProcessMaterial(aiMaterial* material, CachedMaterial& output);
+		static void ProcessMesh(aiMesh* mesh, bool optimise, unsigned int lodCount, CachedMesh& output);
+		static void ProcessNode(aiNode* node, CachedNode& output);
+
+		/// <summary>
+		/// Creates mesh and material resources from an imported model
+		/// </summary>
+		void Build(CachedModel& model);
+		void BuildNode(const CachedNode& node, const CachedModel& model, std::vector<ResourceID>& materialIDs, MeshData& output);
+		ResourceID CreateMaterial(const CachedMaterial& material);
+
 		void CreateMeshMaterialPair(const MeshData& data, std::vector<std::pair<ResourceID, ResourceID>>& output);
 
 	public:
-		void Import(std::string path, std::vector<unsigned char>& data, bool importMaterials = true);
+		void Import(std::string path, IO::ByteSpan data, bool importMaterials = true, bool optimiseMeshes = false, unsigned int lodCount = 0);
 
 		/// <summary>
 		/// When true, materials are imported
 		/// </summary>
 		bool ImportMaterials();
 
+		/// <summary>
+		/// When true, meshes are reordered for the vertex cache and uploaded quantised
+		/// </summary>
+		bool OptimiseMeshes();
+
+		/// <summary>
+		/// Amount of simplified levels of detail generated for each mesh, not including the full detail mesh
+		/// </summary>
+		unsigned int GetLODCount();
+
 		std::vector<ResourceID> GetMeshes();
 
+		/// <summary>
+		/// Converts meshes of multi-mesh models on worker threads. Resources are still created on the calling thread,
+		/// in the same order as a serial import. Enabled by default.
+		/// </summary>
+		YonaiAPI static void SetParallelImport(bool enabled);
+		YonaiAPI static bool IsParallelImport();
+
+		/// <summary>
+		/// Packs import options in to flags for the ImportCache "Model" importer
+		/// </summary>
+		YonaiAPI static uint32_t GetImportFlags(bool optimiseMeshes, unsigned int lodCount);
+
+		/// <summary>
+		/// Reads source data using Assimp. Safe to call from any thread.
+		/// </summary>
+		/// <param name="importFlags">Import options, created by GetImportFlags</param>
+		YonaiAPI static bool ImportScene(IO::ByteSpan data, const std::string& extension, uint32_t importFlags, CachedModel& output);
+
 		/// <returns>Meshes and their generated materials</returns>
 		std::vector<std::pair<ResourceID, ResourceID>> GetMeshesAndMaterials();
 	};
@@ -0,0 +1,99 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <Yonai/API.hpp>
+#include <Yonai/IO/ByteSpan.hpp>
+#include <Yonai/Graphics/Mesh.hpp>
+
+namespace Yonai::Graphics
+{
+	struct CachedMaterial
+	{
+		std::string Name;
+
+		/// <summary>
+		/// Texture paths, relative to the model's directory. Empty when not used.
+		/// </summary>
+		std::string AlbedoMap, NormalMap, MetalnessMap, RoughnessMap, AmbientOcclusionMap;
+	};
+
+	struct CachedMesh
+	{
+		std::string Name;
+
+		/// <summary>
+		/// Index of CachedModel::Materials
+		/// </summary>
+		unsigned int MaterialIndex = 0;
+
+		std::vector<Mesh::Vertex> Vertices;
+		std::vector<unsigned int> Indices;
+
+		/// <summary>
+		/// Simplified levels of detail, indices of Vertices
+		/// </summary>
+		std::vector<std::vector<unsigned int>> LODs;
+	};
+
+	struct CachedNode
+	{
+		std::string Name;
+
+		/// <summary>
+		/// Row-major transformation, relative to parent node
+		/// </summary>
+		float Transformation[16] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+
+		/// <summary>
+		/// Indices of CachedModel::Meshes
+		/// </summary>
+		std::vector<unsigned int> MeshIndices;
+
+		std::vector<CachedNode> Children;
+	};
+
+	/// <summary>
+	/// Imported model, independent of the source file format
+	/// </summary>
+	struct CachedModel
+	{
+		std::vector<CachedMesh> Meshes;
+		std::vector<CachedMaterial> Materials;
+		CachedNode Root;
+	};
+
+	/// <summary>
+	/// Layout of imported models, stored by the ImportCache "Model" importer.
+	/// Reading a cached model does not require Assimp.
+	/// </summary>
+	class ModelCache
+	{
+	public:
+		/// <summary>
+		/// Identifies cached models, "YMDL"
+		/// </summary>
+		static constexpr uint32_t FileMagic = 0x4C444D59;
+
+		/// <summary>
+		/// Increment when the cached model layout, or the import process, changes
+		/// </summary>
+		static constexpr uint32_t FileVersion = 2;
+
+		/// <summary>
+		/// Maximum depth of the node hierarchy accepted when reading a cached model
+		/// </summary>
+		static constexpr unsigned int MaxNodeDepth = 256;
+
+		/// <summary>
+		/// Writes a model in the cache file layout
+		/// </summary>
+		YonaiAPI static void Serialize(const CachedModel& model, std::vector<unsigned char>& output);
+
+		/// <summary>
+		/// Reads a model written by Serialize
+		/// </summary>
+		/// <returns>False if data is not a valid cached model</returns>
+		YonaiAPI static bool Deserialize(IO::ByteSpan data, CachedModel& output);
+	};
+}
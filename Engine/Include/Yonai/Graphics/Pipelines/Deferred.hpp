@@ -2,6 +2,9 @@
 #include <vector>
 #include <Yonai/Graphics/Mesh.hpp>
 #include <Yonai/Graphics/Material.hpp>
+#include <Yonai/Graphics/SpriteBatch.hpp>
+#include <Yonai/Graphics/LightClusters.hpp>
+#include <Yonai/Graphics/IndirectDrawBuilder.hpp>
 #include <Yonai/Components/Transform.hpp>
 #include <Yonai/Graphics/RenderPipeline.hpp>
 #include <Yonai/Components/MeshRenderer.hpp>
@@ -10,7 +13,34 @@ namespace Yonai::Graphics::Pipelines
 {
 	class DeferredRenderPipeline : public RenderPipeline
 	{
+	public:
+		enum class SubmissionMode
+		{
+			/// <summary>
+			/// A draw call for each mesh
+			/// </summary>
+			PerDraw,
+
+			/// <summary>
+			/// Meshes stored in a MeshArena, using shaders with a "DrawDataBuffer" storage block,
+			/// are drawn with a single glMultiDrawElementsIndirect per arena, shader and material.
+			/// The default Lit shader supports this through Shaders/Include/DrawData.inc.
+			/// Other meshes, or when unsupported by the OpenGL context, fall back to PerDraw.
+			/// </summary>
+			MultiDrawIndirect
+		};
+
+		/// <summary>
+		/// Most lights shaded when clustered lights are unsupported, matches MaxLights in Deferred/LightingFixed.frag
+		/// </summary>
+		static constexpr unsigned int MaxFixedLights = 32;
+
+	private:
 		Mesh* m_QuadMesh;
+		SpriteBatch m_SpriteBatch;
+		LightClusters m_LightClusters;
+		IndirectDrawBuilder m_IndirectBuilder;
+		SubmissionMode m_SubmissionMode = SubmissionMode::PerDraw;
 		glm::ivec2 m_CurrentResolution;
 		Components::Camera* m_CurrentCamera;
 		std::vector<Components::MeshRenderer*> m_CurrentMeshes;
@@ -22,13 +52,18 @@ namespace Yonai::Graphics::Pipelines
 		/// <summary>
 		/// Draws a mesh to the current framebuffer
 		/// </summary>
-		void DrawMesh(Components::Transform* transform, Mesh* mesh, Shader* shader);
+		void DrawMesh(Components::Transform* transform, Mesh* mesh, Shader* shader, unsigned int lod = 0);
 
 		/// <summary>
 		/// Draws opaque meshes
 		/// </summary>
 		void MeshPass();
 
+		/// <summary>
+		/// Draws all groups collected by the indirect draw builder
+		/// </summary>
+		void DrawIndirect();
+
 		/// <summary>
 		/// Draws & lights transparent meshes, as well as sprites
 		/// </summary>
@@ -39,11 +74,19 @@ namespace Yonai::Graphics::Pipelines
 		/// </summary>
 		void LightingPass();
 
+		/// <summary>
+		/// Sets light uniforms on the lighting shader, used when clustered lights are unsupported
+		/// </summary>
+		void FillFixedLights(std::vector<std::pair<Components::Light*, Components::Transform*>>& lights);
+
 	public:
 		YonaiAPI DeferredRenderPipeline();
 		YonaiAPI ~DeferredRenderPipeline();
 
 		YonaiAPI Framebuffer* GetOutput() override;
 		YonaiAPI void Draw(Components::Camera* camera) override;
+
+		YonaiAPI SubmissionMode GetSubmissionMode();
+		YonaiAPI void SetSubmissionMode(SubmissionMode mode);
 	};
 }
\ No newline at end of file
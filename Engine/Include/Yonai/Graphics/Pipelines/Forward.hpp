@@ -3,6 +3,7 @@
 #include <Yonai/Graphics/Mesh.hpp>
 #include <Yonai/Components/Camera.hpp>
 #include <Yonai/Graphics/Framebuffer.hpp>
+#include <Yonai/Graphics/SpriteBatch.hpp>
 #include <Yonai/Graphics/RenderPipeline.hpp>
 #include <Yonai/Systems/Global/SceneSystem.hpp>
 
@@ -11,6 +12,7 @@ namespace Yonai::Graphics::Pipelines
 	class ForwardRenderPipeline : public RenderPipeline
 	{
 		Mesh* m_QuadMesh = nullptr;
+		SpriteBatch m_SpriteBatch;
 		Framebuffer* m_Framebuffer = nullptr;
 		Systems::SceneSystem* m_SceneSystem = nullptr;
 		
@@ -5,7 +5,7 @@
 #include <glm/glm.hpp>
 #include <glad/glad.h>
 #include <Yonai/Application.hpp>
-#include <Yonai/IO/FileWatcher.hpp>
+#include <Yonai/ResourceBase.hpp>
 
 namespace Yonai::Graphics
 {
@@ -31,7 +31,7 @@ namespace Yonai::Graphics
 		GLenum Type;
 	};
 
-	class Shader
+	class Shader : public ResourceBase
 	{
 		bool m_IsDirty;
 		unsigned int m_Program;
@@ -41,7 +41,6 @@ namespace Yonai::Graphics
 		void Destroy();
 		void CreateShaders();
 		void CacheUniformLocations();
-		void ShaderSourceChangedCallback(std::string path, IO::FileWatchStatus changeType);
 		GLuint CreateShader(const std::string & source, const GLenum type, const std::string& debugName);
 
 	public:
@@ -0,0 +1,63 @@
+#pragma once
+#include <string>
+#include <cstdint>
+#include <Yonai/API.hpp>
+#include <Yonai/Graphics/Shader.hpp>
+
+namespace Yonai::Graphics
+{
+	/// <summary>
+	/// Persistent cache of linked shader program binaries, stored in the application's persistent directory.
+	/// Entries are keyed by the shader's stage sources and the OpenGL driver, so a driver update invalidates the cache.
+	/// </summary>
+	class ShaderCache
+	{
+		static bool s_Enabled;
+
+	public:
+		/// <summary>
+		/// Identifies cache files, "YSPB"
+		/// </summary>
+		static constexpr uint32_t FileMagic = 0x42505359;
+
+		/// <summary>
+		/// Increment when the cache file layout changes
+		/// </summary>
+		static constexpr uint32_t FileVersion = 1;
+
+		/// <summary>
+		/// Generates a cache key from shader stage contents and driver information
+		/// </summary>
+		YonaiAPI static uint64_t GetKey(const ShaderStageInfo& stages, const std::string& driver);
+
+		/// <returns>OpenGL vendor, renderer and version of the current context</returns>
+		YonaiAPI static std::string GetDriverString();
+
+		/// <returns>Directory containing cached program binaries</returns>
+		YonaiAPI static std::string GetDirectory();
+
+		/// <summary>
+		/// Creates a program from a cached binary
+		/// </summary>
+		/// <returns>Linked program, or GL_INVALID_VALUE if not cached or the binary was rejected by the driver</returns>
+		YonaiAPI static unsigned int Load(uint64_t key);
+
+		/// <summary>
+		/// Stores a linked program's binary. Program should be linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT set.
+		/// </summary>
+		YonaiAPI static void Save(uint64_t key, unsigned int program);
+
+		/// <summary>
+		/// Removes all cached program binaries
+		/// </summary>
+		YonaiAPI static void Clear();
+
+		YonaiAPI static bool IsEnabled();
+		YonaiAPI static void SetEnabled(bool enabled);
+
+		/// <summary>
+		/// Checks the current context supports program binaries (4.1+), and has at least one binary format
+		/// </summary>
+		YonaiAPI static bool IsSupported();
+	};
+}
@@ -0,0 +1,151 @@
+#pragma once
+#include <vector>
+#include <functional>
+#include <unordered_map>
+#include <glm/glm.hpp>
+#include <Yonai/API.hpp>
+#include <Yonai/ResourceID.hpp>
+
+// Forward declaration
+namespace Yonai::Components { struct Camera; }
+
+namespace Yonai::Graphics
+{
+	/// <summary>
+	/// Collects sprites and writes their transformed quads in to a single streaming vertex buffer.
+	/// Sprites are drawn in submission order, consecutive sprites sharing a shader are merged in to one draw call.
+	///
+	/// Vertex generation and grouping happen on the CPU in End(),
+	/// OpenGL resources are only created once Draw() is called.
+	/// </summary>
+	class SpriteBatch
+	{
+	public:
+		struct Vertex
+		{
+			glm::vec3 Position;
+			glm::vec2 TexCoords;
+			glm::vec4 Colour;
+
+			/// <summary>
+			/// Index in to the batch's texture list, passed to the shader as a float
+			/// </summary>
+			float TextureSlot;
+		};
+
+		struct Batch
+		{
+			ResourceID Shader = InvalidResourceID;
+
+			/// <summary>
+			/// Textures used by this batch, where the index is the vertex's TextureSlot
+			/// </summary>
+			std::vector<ResourceID> Textures;
+
+			/// <summary>
+			/// Index of first sprite in the batch, each sprite has 4 vertices and 6 indices
+			/// </summary>
+			unsigned int FirstSprite = 0;
+			unsigned int SpriteCount = 0;
+		};
+
+		/// <summary>
+		/// Default maximum amount of textures able to be bound in a single batch.
+		/// OpenGL 3.3 guarantees at least 16 fragment texture units.
+		/// </summary>
+		static constexpr unsigned int MaxTextureSlots = 16;
+
+		/// <summary>
+		/// Vertices per sprite
+		/// </summary>
+		static constexpr unsigned int QuadVertexCount = 4;
+
+		/// <summary>
+		/// Indices per sprite
+		/// </summary>
+		static constexpr unsigned int QuadIndexCount = 6;
+
+	private:
+		struct SpriteInfo
+		{
+			ResourceID Shader;
+			ResourceID Texture;
+			glm::mat4 ModelMatrix;
+			glm::vec4 Colour;
+		};
+
+		struct SamplerLocations
+		{
+			unsigned int Program = 0; // Never a valid program
+			std::vector<int> Locations;
+		};
+
+		/// <summary>
+		/// Locations of each shader's "inputTextures" elements, requeried when the shader's program changes
+		/// </summary>
+		static std::unordered_map<ResourceID, SamplerLocations> s_SamplerLocations;
+
+		bool m_Building = false;
+		std::vector<Batch> m_Batches;
+		std::vector<Vertex> m_Vertices;
+		std::vector<SpriteInfo> m_Sprites;
+
+		// OpenGL resources //
+		unsigned int m_VAO, m_VBO, m_EBO;
+
+		/// <summary>
+		/// Amount of sprites the index buffer has been generated for
+		/// </summary>
+		unsigned int m_IndexCapacity = 0;
+
+		/// <summary>
+		/// Size of the vertex buffer, in vertices
+		/// </summary>
+		unsigned int m_VertexCapacity = 0;
+
+		void Setup();
+		void Upload();
+
+		static const std::vector<int>& GetSamplerLocations(ResourceID shader, unsigned int program);
+
+	public:
+		YonaiAPI SpriteBatch();
+		YonaiAPI ~SpriteBatch();
+
+		/// <summary>
+		/// Clears previously submitted sprites and begins a new batch
+		/// </summary>
+		YonaiAPI void Begin();
+
+		/// <summary>
+		/// Adds a sprite to the current batch
+		/// </summary>
+		YonaiAPI void Submit(ResourceID shader, ResourceID texture, const glm::mat4& modelMatrix, const glm::vec4& colour = glm::vec4(1.0f));
+
+		/// <summary>
+		/// Generates vertices and splits submitted sprites in to batches, keeping submission order.
+		/// </summary>
+		/// <param name="getTextureSlots">
+		/// Optional function returning the amount of texture slots a shader supports.
+		/// When not set, MaxTextureSlots is used for all shaders.
+		/// </param>
+		YonaiAPI void End(std::function<unsigned int(ResourceID)> getTextureSlots = nullptr);
+
+		/// <summary>
+		/// Uploads generated vertices and draws all batches.
+		/// End() must be called beforehand.
+		/// </summary>
+		YonaiAPI void Draw(Components::Camera* camera, glm::ivec2 resolution);
+
+		YonaiAPI std::vector<Batch>& GetBatches();
+		YonaiAPI std::vector<Vertex>& GetVertices();
+
+		/// <returns>Amount of sprites submitted since Begin()</returns>
+		YonaiAPI unsigned int GetSpriteCount();
+
+		/// <summary>
+		/// Amount of texture slots supported by a shader, based on the presence of an "inputTextures" sampler array
+		/// </summary>
+		YonaiAPI static unsigned int GetShaderTextureSlots(ResourceID shader);
+	};
+}
@@ -1,7 +1,11 @@
 #pragma once
+#include <memory>
 #include <string>
+#include <vector>
+#include <functional>
 #include <glm/glm.hpp>
 #include <Yonai/API.hpp>
+#include <Yonai/IO/ByteSpan.hpp>
 
 #ifndef GL_LINEAR
 #define GL_LINEAR 0x2601
@@ -9,6 +13,25 @@
 
 namespace Yonai::Graphics
 {
+	class Texture;
+	struct TextureLoadJob;
+
+	/// <summary>
+	/// Called on the main thread once an asynchronous upload has finished, or failed
+	/// </summary>
+	typedef std::function<void(Texture* texture, bool success)> TextureLoadCallback;
+
+	/// <summary>
+	/// Decoded image, ready to be uploaded to the GPU
+	/// </summary>
+	struct TexturePixels
+	{
+		void* Data = nullptr;
+		glm::ivec2 Resolution = { 0, 0 };
+		int Channels = 0;
+		bool HDR = false;
+	};
+
 	class Texture
 	{
 		bool m_HDR;
@@ -16,18 +39,63 @@ namespace Yonai::Graphics
 		unsigned int m_ID;
 		glm::ivec2 m_Resolution;
 
+		/// <summary>
+		/// Asynchronous upload in progress, or null
+		/// </summary>
+		std::shared_ptr<TextureLoadJob> m_PendingLoad;
+
+		void CancelPendingLoad();
+
+		friend class TextureLoader;
+
 	public:
 		YonaiAPI Texture();
 		YonaiAPI ~Texture();
 
-		YonaiAPI bool Upload(std::vector<unsigned char>& textureData, bool hdr = false, int filter = GL_LINEAR);
+		/// <summary>
+		/// Decodes and uploads texture data, cooked textures are detected and uploaded with UploadCooked
+		/// </summary>
+		YonaiAPI bool Upload(IO::ByteSpan textureData, bool hdr = false, int filter = GL_LINEAR);
+
+		/// <summary>
+		/// Decodes texture data on a worker thread, then uploads it to the GPU during TextureLoader::ProcessUploads.
+		/// Until then, binding this texture binds TextureLoader's placeholder.
+		/// </summary>
+		YonaiAPI void UploadAsync(std::vector<unsigned char> textureData, bool hdr = false, int filter = GL_LINEAR, TextureLoadCallback callback = nullptr);
+
+		/// <summary>
+		/// Reads and cooks an image file on a worker thread through the ImportCache, then uploads it like UploadAsync.
+		/// Unchanged images are read from the cache, without being decoded.
+		/// </summary>
+		YonaiAPI void ImportAsync(std::string path, bool hdr = false, int filter = GL_LINEAR, TextureLoadCallback callback = nullptr);
+
+		/// <summary>
+		/// Uploads already decoded pixels. Must be called on the thread owning the OpenGL context.
+		/// </summary>
+		YonaiAPI bool Upload(const TexturePixels& pixels, int filter = GL_LINEAR);
+
+		/// <summary>
+		/// Uploads a texture created by TextureCooker, with one upload per stored mip level.
+		/// Must be called on the thread owning the OpenGL context.
+		/// </summary>
+		YonaiAPI bool UploadCooked(IO::ByteSpan cookedData, int filter = GL_LINEAR);
+
+		/// <summary>
+		/// Decodes an image file in memory. Safe to call from any thread.
+		/// </summary>
+		/// <returns>True if decoded, output must later be released with FreePixels</returns>
+		YonaiAPI static bool Decode(IO::ByteSpan textureData, bool hdr, TexturePixels& output);
+		YonaiAPI static void FreePixels(TexturePixels& pixels);
 
 		YonaiAPI bool GetHDR();
 		YonaiAPI bool IsValid();
 		YonaiAPI int GetFilter();
 		YonaiAPI unsigned int GetID();
 		YonaiAPI glm::ivec2& GetResolution();
-		
+
+		/// <returns>True while an asynchronous upload is in progress</returns>
+		YonaiAPI bool IsLoading();
+
 		YonaiAPI void Bind(unsigned int index = 0);
 	};
 }
@@ -0,0 +1,149 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <Yonai/API.hpp>
+#include <Yonai/Graphics/Texture.hpp>
+
+namespace Yonai::Graphics
+{
+	enum class CookedTextureFormat : uint32_t
+	{
+		R8 = 0,
+		RGB8,
+		RGBA8,
+		R32F,
+		RGB32F,
+		RGBA32F,
+
+		/// <summary>
+		/// 4x4 blocks of 8 bytes, RGB with no alpha
+		/// </summary>
+		BC1,
+
+		/// <summary>
+		/// 4x4 blocks of 16 bytes, RGB with interpolated alpha
+		/// </summary>
+		BC3
+	};
+
+	/// <summary>
+	/// Start of a cooked texture file
+	/// </summary>
+	struct CookedTextureHeader
+	{
+		uint32_t Magic;
+		uint32_t Version;
+		CookedTextureFormat Format;
+		uint32_t Width;
+		uint32_t Height;
+		uint32_t LevelCount;
+	};
+
+	/// <summary>
+	/// Location of a mip level inside a cooked texture file, follows the header for each level
+	/// </summary>
+	struct CookedTextureLevel
+	{
+		uint32_t Width;
+		uint32_t Height;
+
+		/// <summary>
+		/// Offset from start of file, in bytes
+		/// </summary>
+		uint64_t Offset;
+		uint64_t Size;
+	};
+
+	struct TextureCookSettings
+	{
+		/// <summary>
+		/// Decodes source as floating point
+		/// </summary>
+		bool HDR = false;
+
+		/// <summary>
+		/// Stores the full mip chain, otherwise only the base level is stored
+		/// </summary>
+		bool GenerateMips = true;
+
+		/// <summary>
+		/// Block compresses 8-bit RGB(A) textures to BC1 or BC3
+		/// </summary>
+		bool Compress = false;
+
+		/// <returns>Settings packed in to ImportCache import flags</returns>
+		YonaiAPI uint32_t GetFlags() const;
+
+		/// <summary>
+		/// Unpacks settings from flags created by GetFlags
+		/// </summary>
+		YonaiAPI static TextureCookSettings FromFlags(uint32_t flags);
+	};
+
+	/// <summary>
+	/// Converts source images (PNG, JPG, HDR, ...) in to a GPU-ready container holding all mip levels,
+	/// so loading at runtime is a single read followed by one upload per level.
+	///
+	/// Layout is a CookedTextureHeader, followed by a CookedTextureLevel for each level,
+	/// followed by level data aligned to DataAlignment bytes.
+	/// </summary>
+	class TextureCooker
+	{
+	public:
+		/// <summary>
+		/// Identifies cooked textures, "YTEX"
+		/// </summary>
+		static constexpr uint32_t FileMagic = 0x58455459;
+
+		/// <summary>
+		/// Increment when the container layout changes
+		/// </summary>
+		static constexpr uint32_t FileVersion = 1;
+
+		static constexpr unsigned int DataAlignment = 16;
+
+		/// <summary>
+		/// Decodes and cooks an image file in memory
+		/// </summary>
+		/// <returns>True if successful, with the cooked texture in output</returns>
+		YonaiAPI static bool Cook(IO::ByteSpan source, const TextureCookSettings& settings, std::vector<unsigned char>& output);
+
+		/// <summary>
+		/// Cooks already decoded pixels
+		/// </summary>
+		YonaiAPI static bool Cook(const TexturePixels& pixels, const TextureCookSettings& settings, std::vector<unsigned char>& output);
+
+		/// <summary>
+		/// Reads an image from inputPath and writes the cooked texture to outputPath. Paths can be the same.
+		/// </summary>
+		YonaiAPI static bool CookFile(const std::string& inputPath, const std::string& outputPath, const TextureCookSettings& settings);
+
+		/// <returns>True if data begins with a cooked texture header</returns>
+		YonaiAPI static bool IsCooked(IO::ByteSpan data);
+
+		/// <summary>
+		/// Validates a cooked texture and gets its level information
+		/// </summary>
+		/// <returns>False if data is not a valid cooked texture</returns>
+		YonaiAPI static bool Read(IO::ByteSpan data, CookedTextureHeader& header, std::vector<CookedTextureLevel>& levels);
+
+		/// <returns>Size in bytes of a single level</returns>
+		YonaiAPI static size_t GetLevelSize(CookedTextureFormat format, unsigned int width, unsigned int height);
+
+		/// <returns>Amount of levels in a full mip chain, down to 1x1</returns>
+		YonaiAPI static unsigned int GetLevelCount(unsigned int width, unsigned int height);
+
+		YonaiAPI static bool IsCompressed(CookedTextureFormat format);
+
+		/// <summary>
+		/// Block compresses an RGBA8 image in to BC1
+		/// </summary>
+		YonaiAPI static void CompressBC1(const unsigned char* rgba, unsigned int width, unsigned int height, unsigned char* output);
+
+		/// <summary>
+		/// Block compresses an RGBA8 image in to BC3
+		/// </summary>
+		YonaiAPI static void CompressBC3(const unsigned char* rgba, unsigned int width, unsigned int height, unsigned char* output);
+	};
+}
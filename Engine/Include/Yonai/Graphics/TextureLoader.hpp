@@ -0,0 +1,107 @@
+#pragma once
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <Yonai/API.hpp>
+#include <Yonai/ThreadPool.hpp>
+#include <Yonai/Graphics/Texture.hpp>
+
+namespace Yonai::Graphics
+{
+	/// <summary>
+	/// Asynchronous upload of a single texture
+	/// </summary>
+	struct TextureLoadJob
+	{
+		Texture* Target = nullptr;
+		std::vector<unsigned char> Data;
+
+		/// <summary>
+		/// When set, Data is read through the ImportCache from this file on the worker thread
+		/// </summary>
+		std::string SourcePath;
+		bool HDR = false;
+		int Filter = GL_LINEAR;
+		TextureLoadCallback Callback;
+
+		/// <summary>
+		/// Output of decoding, valid when Decoded is true
+		/// </summary>
+		TexturePixels Pixels;
+		bool Decoded = false;
+
+		/// <summary>
+		/// Data is a cooked texture, uploaded directly without decoding
+		/// </summary>
+		bool Cooked = false;
+
+		/// <summary>
+		/// Set when the target texture is destroyed or re-uploaded before this job finishes
+		/// </summary>
+		std::atomic_bool Cancelled { false };
+	};
+
+	/// <summary>
+	/// Decodes textures on worker threads, and uploads decoded textures to the GPU
+	/// on the main thread within a time budget each frame.
+	/// </summary>
+	class TextureLoader
+	{
+		static ThreadPool* s_Pool;
+		static std::mutex s_Mutex;
+		static float s_UploadBudget;
+		static unsigned int s_Placeholder;
+		static std::atomic_uint s_PendingCount;
+
+		/// <summary>
+		/// Jobs that have finished decoding, awaiting upload
+		/// </summary>
+		static std::deque<std::shared_ptr<TextureLoadJob>> s_Decoded;
+
+		static void Decode(std::shared_ptr<TextureLoadJob> job);
+		static void Finish(std::shared_ptr<TextureLoadJob>& job);
+
+	public:
+		/// <summary>
+		/// Default time, in milliseconds, spent uploading textures each frame
+		/// </summary>
+		static constexpr float DefaultUploadBudget = 2.0f;
+
+		/// <summary>
+		/// Queues a job for decoding on a worker thread
+		/// </summary>
+		YonaiAPI static void Enqueue(std::shared_ptr<TextureLoadJob> job);
+
+		/// <summary>
+		/// Uploads decoded textures until the upload budget is exceeded, at least one texture is uploaded if available.
+		/// Must be called on the thread owning the OpenGL context.
+		/// </summary>
+		/// <returns>Amount of textures processed</returns>
+		YonaiAPI static unsigned int ProcessUploads();
+
+		/// <param name="budget">Maximum time to spend uploading, in milliseconds</param>
+		YonaiAPI static unsigned int ProcessUploads(float budget);
+
+		/// <summary>
+		/// Blocks until all queued textures are decoded and uploaded
+		/// </summary>
+		YonaiAPI static void Flush();
+
+		/// <summary>
+		/// Stops worker threads and releases resources, pending uploads are discarded
+		/// </summary>
+		YonaiAPI static void Shutdown();
+
+		/// <returns>Amount of textures waiting to be decoded or uploaded</returns>
+		YonaiAPI static unsigned int GetPendingCount();
+
+		YonaiAPI static float GetUploadBudget();
+		YonaiAPI static void SetUploadBudget(float milliseconds);
+
+		/// <returns>Texture bound in place of textures that are still loading</returns>
+		YonaiAPI static unsigned int GetPlaceholder();
+	};
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+
+namespace Yonai::IO
+{
+	/// <summary>
+	/// Read-only view of contiguous bytes, such as a MappedFile or vector, without copying them.
+	/// The viewed data must outlive the span.
+	/// </summary>
+	struct ByteSpan
+	{
+		ByteSpan() = default;
+		ByteSpan(const unsigned char* data, size_t size) : m_Data(data), m_Size(size) { }
+		ByteSpan(const std::vector<unsigned char>& data) : m_Data(data.data()), m_Size(data.size()) { }
+
+		const unsigned char* data() const { return m_Data; }
+		size_t size() const { return m_Size; }
+		bool empty() const { return m_Size == 0; }
+
+		const unsigned char* begin() const { return m_Data; }
+		const unsigned char* end() const { return m_Data + m_Size; }
+
+		const unsigned char& operator[](size_t index) const { return m_Data[index]; }
+
+		/// <returns>View of count bytes starting at offset, clamped to the end of this span</returns>
+		ByteSpan subspan(size_t offset, size_t count = (size_t)-1) const
+		{
+			if (offset > m_Size)
+				offset = m_Size;
+			if (count > m_Size - offset)
+				count = m_Size - offset;
+			return ByteSpan(m_Data + offset, count);
+		}
+
+	private:
+		const unsigned char* m_Data = nullptr;
+		size_t m_Size = 0;
+	};
+}
@@ -1,9 +1,13 @@
-// Based on https://solarianprogrammer.com/2019/01/13/cpp-17-filesystem-write-file-watcher-monitor/
+// Polling fallback based on https://solarianprogrammer.com/2019/01/13/cpp-17-filesystem-write-file-watcher-monitor/
 #pragma once
+#include <map>
+#include <mutex>
+#include <condition_variable>
 #include <atomic>
 #include <chrono>
 #include <thread>
 #include <string>
+#include <vector>
 #include <functional>
 #include <filesystem>
 #include <unordered_map>
@@ -13,28 +17,128 @@ namespace Yonai::IO
 {
 	enum class FileWatchStatus { Created, Removed, Modified };
 
+	typedef std::function<void(const std::string&, FileWatchStatus)> FileWatchCallback;
+
+	/// <summary>
+	/// Change to a watched path, waiting to be delivered by FileWatcher::ProcessEvents
+	/// </summary>
+	struct FileWatchEvent
+	{
+		unsigned int WatcherID;
+		std::string Path;
+		FileWatchStatus Status;
+	};
+
+	/// <summary>
+	/// Watches a file, or a directory recursively, for changes.
+	/// All watchers share a single background thread, using inotify on Linux and polling elsewhere.
+	/// Changes to the same path in quick succession are coalesced into one event,
+	/// and callbacks are invoked on the thread calling ProcessEvents.
+	/// </summary>
 	class FileWatcher
 	{
-		bool m_Multithread;
+		unsigned int m_ID;
+		bool m_Watching;
+		bool m_IsDirectory;
 		std::string m_Path;
-		std::thread m_LoopThread;
-		std::atomic_bool m_Running;
-		std::chrono::duration<int, std::milli> m_Interval; // Time between checking for changes
-		std::function<void(const std::string&, FileWatchStatus)> m_Callback;
+		std::chrono::milliseconds m_Interval; // Time between polling for changes, when inotify is unavailable
+
+		/// <summary>
+		/// Last write times of files when polling, only used by the watch thread
+		/// </summary>
 		std::unordered_map<std::string, std::filesystem::file_time_type> m_WatchedPaths;
+		std::chrono::steady_clock::time_point m_NextPoll;
+
+		/// <summary>
+		/// Guards watchers and platform watch state
+		/// </summary>
+		static std::mutex s_Mutex;
+
+		/// <summary>
+		/// Guards pending & queued events, and callbacks
+		/// </summary>
+		static std::mutex s_EventMutex;
+
+		static std::thread s_Thread;
+		static std::atomic_bool s_Running;
+		static std::atomic_uint s_NextID;
+		static std::unordered_map<unsigned int, FileWatcher*> s_Watchers;
+		static std::unordered_map<unsigned int, FileWatchCallback> s_Callbacks;
+
+		struct PendingEvent
+		{
+			FileWatchStatus Status;
+			std::chrono::steady_clock::time_point LastChange;
+		};
+
+		/// <summary>
+		/// Changes waiting for CoalesceDelay to pass without further changes, keyed by watcher ID & path
+		/// </summary>
+		static std::map<std::pair<unsigned int, std::string>, PendingEvent> s_Pending;
+
+		/// <summary>
+		/// Coalesced changes, ready to be delivered on the main thread
+		/// </summary>
+		static std::vector<FileWatchEvent> s_Queue;
 
-		void BeginWatching();
+#if defined(YONAI_PLATFORM_LINUX)
+		static int s_INotify;
+		static int s_WakeEvent;
+
+		struct WatchedDirectory
+		{
+			std::string Path;
+			std::vector<unsigned int> Watchers;
+		};
+
+		/// <summary>
+		/// Directories watched by inotify, keyed by watch descriptor
+		/// </summary>
+		static std::unordered_map<int, WatchedDirectory> s_Directories;
+
+		void AddDirectory(const std::string& path, bool recursive);
+		void RemoveDirectories();
+		static void ReadEvents();
+#else
+		static bool s_WakeRequested;
+		static std::condition_variable s_WakeCondition;
+
+		void Poll();
+#endif
+
+		void Unwatch();
+
+		static void WatchLoop();
+		static void Wake();
+		static void StartThread();
+		static void StopThread();
+		static void AddEvent(unsigned int watcherID, const std::string& path, FileWatchStatus status);
+
+		/// <returns>Time until the next pending change can be queued, or -1 if there are none</returns>
+		static int FlushPending();
+
+		friend struct FileWatcherShutdown;
 
 	public:
-		/// <param name="intervalMs">Time between checking for file changes, in milliseconds</param>
-		YonaiAPI FileWatcher(std::string path, int intervalMs = 1000, bool multithread = true);
+		/// <summary>
+		/// Time without further changes to a path, in milliseconds, before its change is delivered
+		/// </summary>
+		static constexpr int CoalesceDelay = 100;
 
-		// Constructor using default interval of 1000ms
-		YonaiAPI FileWatcher(std::string path, bool multithread);
+		/// <param name="intervalMs">Time between checking for file changes when polling, in milliseconds</param>
+		YonaiAPI FileWatcher(std::string path, int intervalMs = 1000);
 
 		YonaiAPI ~FileWatcher();
 
-		YonaiAPI void Start(std::function<void(const std::string&, FileWatchStatus)> callback);
+		YonaiAPI void Start(FileWatchCallback callback);
 		YonaiAPI void Stop();
+
+		YonaiAPI const std::string& GetPath();
+
+		/// <summary>
+		/// Invokes callbacks of all changes queued by watchers. Called once per frame by Application.
+		/// </summary>
+		/// <returns>Amount of changes delivered</returns>
+		YonaiAPI static unsigned int ProcessEvents();
 	};
-}
\ No newline at end of file
+}
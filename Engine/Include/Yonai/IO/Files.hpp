@@ -2,14 +2,32 @@
 #include <string>
 #include <vector>
 #include <Yonai/API.hpp>
+#include <Yonai/IO/ByteSpan.hpp>
 
 namespace Yonai::IO
 {
+	/// <summary>
+	/// Reads a file as text, converting CRLF line endings to LF
+	/// </summary>
 	YonaiAPI std::string ReadText(std::string path);
+
+	/// <summary>
+	/// Copies a file in to memory. Prefer MappedFile when the contents are only read.
+	/// </summary>
 	YonaiAPI std::vector<unsigned char> Read(std::string path);
 
+	/// <summary>
+	/// Copies text, converting CRLF line endings to LF in a single pass
+	/// </summary>
+	YonaiAPI std::string NormaliseLineEndings(ByteSpan text);
+
+	/// <summary>
+	/// Converts CRLF line endings to LF in place
+	/// </summary>
+	YonaiAPI void NormaliseLineEndings(std::string& text);
+
 	YonaiAPI void Write(std::string path, std::string& contents);
-	YonaiAPI void Write(std::string path, std::vector<unsigned char>& contents);
+	YonaiAPI void Write(std::string path, ByteSpan contents);
 
 	YonaiAPI bool Exists(std::string path);
-}
\ No newline at end of file
+}
@@ -0,0 +1,187 @@
+#pragma once
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <Yonai/API.hpp>
+#include <Yonai/IO/ByteSpan.hpp>
+
+namespace Yonai::IO
+{
+	/// <summary>
+	/// Converts source data in to its imported form.
+	/// Flags hold any import settings that change the output, and are part of the cache key.
+	/// </summary>
+	/// <returns>True if imported, with the result in output</returns>
+	typedef std::function<bool(ByteSpan source, const std::string& extension, uint32_t flags, std::vector<unsigned char>& output)> ImportFunction;
+
+	/// <summary>
+	/// Source file to import when warming the cache
+	/// </summary>
+	struct ImportCacheJob
+	{
+		std::string Importer;
+		std::string SourcePath;
+		uint32_t Flags = 0;
+	};
+
+	struct ImportCacheWarmResult
+	{
+		/// <summary>
+		/// Sources already in the cache
+		/// </summary>
+		unsigned int Cached = 0;
+
+		/// <summary>
+		/// Sources imported and added to the cache
+		/// </summary>
+		unsigned int Imported = 0;
+
+		/// <summary>
+		/// Sources that could not be read or imported
+		/// </summary>
+		unsigned int Failed = 0;
+	};
+
+	/// <summary>
+	/// Persistent cache of imported assets, so unchanged sources are never imported again.
+	/// Entries are keyed by a hash of the source contents, the importer's name & version, the source extension and import flags.
+	/// Identical sources at different paths share an entry, and renaming or touching a source does not invalidate it.
+	///
+	/// Content hashes of source files are remembered by path, size and modification time,
+	/// so unchanged sources are not read to look up their entry.
+	/// </summary>
+	class ImportCache
+	{
+		struct RegisteredImporter
+		{
+			uint32_t Version;
+			ImportFunction Function;
+		};
+
+		struct SourceInfo
+		{
+			uint64_t Size;
+			int64_t ModifiedTime;
+			uint64_t Hash;
+		};
+
+		static std::atomic<bool> s_Enabled;
+		static bool s_SourcesLoaded;
+		static bool s_SourcesDirty;
+		static std::string s_Directory;
+
+		/// <summary>
+		/// Guards importers, sources and the cache directory. Importers run without the lock held.
+		/// </summary>
+		static std::mutex s_Mutex;
+
+		static std::unordered_map<std::string, RegisteredImporter> s_Importers;
+
+		/// <summary>
+		/// Content hashes of source files, keyed by path
+		/// </summary>
+		static std::unordered_map<std::string, SourceInfo> s_Sources;
+
+		static void RegisterDefaultImporters();
+		static void LoadSources();
+
+		/// <summary>
+		/// Gets the cache directory, assigning the default when unset. Requires s_Mutex to be held.
+		/// </summary>
+		static const std::string& GetDirectoryLocked();
+
+		/// <returns>False if importer is not registered</returns>
+		static bool GetImporter(const std::string& name, RegisteredImporter& output);
+
+		/// <summary>
+		/// Gets the content hash of a source file, only reading it when changed since last hashed
+		/// </summary>
+		/// <param name="contents">Optionally holds the source's contents, if it was read</param>
+		static bool GetSourceHash(const std::string& path, uint64_t& output, std::vector<unsigned char>* contents = nullptr);
+
+		static std::string GetEntryPath(const std::string& importer, uint64_t key);
+		static bool LoadEntry(const std::string& path, uint32_t importerVersion, uint64_t sourceHash, std::vector<unsigned char>& output);
+		static void SaveEntry(const std::string& path, uint32_t importerVersion, uint64_t sourceHash, ByteSpan data);
+
+		/// <summary>
+		/// Runs an importer and stores its output
+		/// </summary>
+		static bool Import(const std::string& importer, const RegisteredImporter& registered, ByteSpan source, uint64_t sourceHash, const std::string& extension, uint32_t flags, std::vector<unsigned char>& output);
+		static std::string GetExtension(const std::string& path);
+
+	public:
+		/// <summary>
+		/// Identifies cache entries, "YIMP"
+		/// </summary>
+		static constexpr uint32_t FileMagic = 0x504D4959;
+
+		/// <summary>
+		/// Increment when the entry or source index layout changes
+		/// </summary>
+		static constexpr uint32_t FileVersion = 1;
+
+		/// <summary>
+		/// Adds or replaces an importer. Increment version whenever its output changes, so existing entries are replaced.
+		/// "Texture" and "Model" importers are registered by default.
+		/// </summary>
+		YonaiAPI static void RegisterImporter(const std::string& name, uint32_t version, ImportFunction importer);
+		YonaiAPI static void UnregisterImporter(const std::string& name);
+
+		/// <summary>
+		/// Generates the cache key of an import
+		/// </summary>
+		YonaiAPI static uint64_t GetKey(const std::string& importer, uint32_t importerVersion, uint64_t sourceHash, const std::string& extension, uint32_t flags);
+
+		/// <summary>
+		/// Gets the imported form of a source file, importing and storing it when not cached
+		/// </summary>
+		/// <param name="fromCache">Optionally set to true when output was read from the cache</param>
+		/// <returns>False if the source could not be read or imported. When the importer fails, output holds the unmodified source data.</returns>
+		YonaiAPI static bool Import(const std::string& importer, const std::string& sourcePath, uint32_t flags, std::vector<unsigned char>& output, bool* fromCache = nullptr);
+
+		/// <summary>
+		/// Gets the imported form of source data already in memory
+		/// </summary>
+		/// <param name="extension">Extension of the source file, including the leading '.'</param>
+		YonaiAPI static bool Import(const std::string& importer, ByteSpan source, const std::string& extension, uint32_t flags, std::vector<unsigned char>& output, bool* fromCache = nullptr);
+
+		/// <returns>True if an up to date entry exists for the source file</returns>
+		YonaiAPI static bool IsCached(const std::string& importer, const std::string& sourcePath, uint32_t flags);
+
+		/// <summary>
+		/// Imports all sources not already cached, across threadCount worker threads
+		/// </summary>
+		/// <param name="threadCount">Amount of worker threads, or 0 to use one per hardware thread</param>
+		YonaiAPI static ImportCacheWarmResult Warm(const std::vector<ImportCacheJob>& jobs, unsigned int threadCount = 0);
+
+		/// <summary>
+		/// Writes the source index to disk. Called when the application shuts down.
+		/// </summary>
+		YonaiAPI static void Flush();
+
+		/// <summary>
+		/// Removes all entries and the source index
+		/// </summary>
+		YonaiAPI static void Clear();
+
+		/// <returns>Directory containing cache entries, defaults to "ImportCache/" in the application's persistent directory</returns>
+		YonaiAPI static std::string GetDirectory();
+
+		/// <summary>
+		/// Changes the cache directory, such as to a project's ".data/ImportCache/".
+		/// The source index of the previous directory is flushed.
+		/// </summary>
+		YonaiAPI static void SetDirectory(std::string directory);
+
+		YonaiAPI static bool IsEnabled();
+
+		/// <summary>
+		/// When disabled, every call to Import runs the importer and nothing is stored
+		/// </summary>
+		YonaiAPI static void SetEnabled(bool enabled);
+	};
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <Yonai/API.hpp>
+#include <Yonai/IO/ByteSpan.hpp>
+
+namespace Yonai::IO
+{
+	/// <summary>
+	/// Fast lossless compression, writing the LZ4 block format so data can also be read by the reference LZ4 library.
+	/// Favours decompression speed over ratio, suited to assets read at load time.
+	/// </summary>
+	class LZ4
+	{
+	public:
+		/// <returns>Largest possible compressed size of inputSize bytes</returns>
+		YonaiAPI static size_t GetMaxCompressedSize(size_t inputSize);
+
+		/// <returns>Largest size compressedSize bytes can decompress to, for validating sizes read from files</returns>
+		YonaiAPI static uint64_t GetMaxDecompressedSize(uint64_t compressedSize);
+
+		/// <summary>
+		/// Compresses input as a single LZ4 block, replacing the contents of output
+		/// </summary>
+		YonaiAPI static void Compress(ByteSpan input, std::vector<unsigned char>& output);
+
+		/// <summary>
+		/// Decompresses an LZ4 block. Input is bounds checked, so corrupt data fails rather than reading or writing out of range.
+		/// </summary>
+		/// <param name="outputSize">Exact size of the uncompressed data</param>
+		/// <returns>True if input decompressed to exactly outputSize bytes</returns>
+		YonaiAPI static bool Decompress(ByteSpan input, unsigned char* output, size_t outputSize);
+	};
+}
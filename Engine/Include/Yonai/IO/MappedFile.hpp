@@ -0,0 +1,53 @@
+#pragma once
+#include <string>
+#include <Yonai/API.hpp>
+#include <Yonai/IO/ByteSpan.hpp>
+
+namespace Yonai::IO
+{
+	/// <summary>
+	/// Read-only memory mapped file. Contents are paged in by the OS as they are accessed,
+	/// rather than copied in to a buffer up front.
+	/// </summary>
+	class MappedFile
+	{
+		bool m_Open = false;
+		size_t m_Size = 0;
+		const unsigned char* m_Data = nullptr;
+
+#if defined(YONAI_PLATFORM_WINDOWS)
+		void* m_File = nullptr;
+		void* m_Mapping = nullptr;
+#endif
+
+	public:
+		MappedFile() = default;
+		YonaiAPI MappedFile(const std::string& path);
+		YonaiAPI ~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+		YonaiAPI MappedFile(MappedFile&& other) noexcept;
+		YonaiAPI MappedFile& operator=(MappedFile&& other) noexcept;
+
+		/// <summary>
+		/// Maps a file, closing any previously mapped file
+		/// </summary>
+		/// <returns>True if the file exists and was mapped. Empty files open with no data.</returns>
+		YonaiAPI bool Open(const std::string& path);
+
+		/// <summary>
+		/// Unmaps the file, invalidating all spans of its contents.
+		/// Files must be closed before they can be written to or removed on some platforms.
+		/// </summary>
+		YonaiAPI void Close();
+
+		YonaiAPI bool IsOpen() const;
+		YonaiAPI size_t GetSize() const;
+		YonaiAPI const unsigned char* GetData() const;
+
+		/// <returns>Contents of the file, valid until closed</returns>
+		YonaiAPI ByteSpan GetSpan() const;
+		operator ByteSpan() const { return GetSpan(); }
+	};
+}
@@ -0,0 +1,176 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include <Yonai/API.hpp>
+#include <Yonai/IO/ByteSpan.hpp>
+#include <Yonai/IO/MappedFile.hpp>
+
+namespace Yonai::IO
+{
+	enum class PackCompression : uint32_t
+	{
+		None = 0,
+		LZ4
+	};
+
+	/// <summary>
+	/// Start of a pack file
+	/// </summary>
+	struct PackHeader
+	{
+		uint32_t Magic;
+		uint32_t Version;
+		uint32_t EntryCount;
+
+		/// <summary>
+		/// Alignment of each entry's data, in bytes
+		/// </summary>
+		uint32_t Alignment;
+
+		/// <summary>
+		/// Offset of the PackEntry table, sorted by path hash
+		/// </summary>
+		uint64_t TableOffset;
+
+		/// <summary>
+		/// Offset and size of all entry paths, stored without null terminators
+		/// </summary>
+		uint64_t PathsOffset;
+		uint64_t PathsSize;
+	};
+
+	/// <summary>
+	/// Location of a file inside a pack
+	/// </summary>
+	struct PackEntry
+	{
+		/// <summary>
+		/// Hash of the normalised path, entries are sorted by this
+		/// </summary>
+		uint64_t PathHash;
+
+		/// <summary>
+		/// Offset and size of stored data from the start of the pack
+		/// </summary>
+		uint64_t Offset;
+		uint64_t Size;
+
+		/// <summary>
+		/// Size once decompressed, matches Size when not compressed
+		/// </summary>
+		uint64_t UncompressedSize;
+
+		/// <summary>
+		/// Offset of this entry's path from PackHeader::PathsOffset
+		/// </summary>
+		uint32_t PathOffset;
+		uint32_t PathLength;
+
+		PackCompression Compression;
+		uint32_t Reserved;
+	};
+
+	/// <summary>
+	/// Read-only archive of many files in a single memory mapped file.
+	/// Lookups binary search a table of path hashes, avoiding a file open per asset.
+	/// </summary>
+	class PackArchive
+	{
+		MappedFile m_File;
+		std::string m_Path;
+		const PackHeader* m_Header = nullptr;
+		const PackEntry* m_Entries = nullptr;
+		const char* m_Paths = nullptr;
+
+	public:
+		static constexpr uint32_t FileMagic = 0x4B415059; // 'YPAK'
+		static constexpr uint32_t FileVersion = 1;
+
+		/// <summary>
+		/// Default alignment of entry data, enough to use data as any scalar or SIMD type
+		/// </summary>
+		static constexpr uint32_t DefaultAlignment = 16;
+
+		PackArchive() = default;
+		YonaiAPI PackArchive(const std::string& path);
+
+		/// <summary>
+		/// Maps a pack file and validates its table, closing any previously opened pack
+		/// </summary>
+		YonaiAPI bool Open(const std::string& path);
+		YonaiAPI void Close();
+		YonaiAPI bool IsOpen() const;
+
+		/// <returns>Path of the pack file</returns>
+		YonaiAPI const std::string& GetPath() const;
+
+		/// <returns>Entry with a matching path, or null</returns>
+		YonaiAPI const PackEntry* Find(const std::string& path) const;
+		YonaiAPI bool Exists(const std::string& path) const;
+
+		YonaiAPI size_t GetEntryCount() const;
+		YonaiAPI const PackEntry& GetEntry(size_t index) const;
+		YonaiAPI std::string GetPath(const PackEntry& entry) const;
+
+		/// <summary>
+		/// Stored data of an entry, without copying. Compressed entries must be passed to Read instead.
+		/// </summary>
+		YonaiAPI ByteSpan GetData(const PackEntry& entry) const;
+
+		/// <summary>
+		/// Copies an entry in to output, decompressing if required
+		/// </summary>
+		YonaiAPI bool Read(const PackEntry& entry, std::vector<unsigned char>& output) const;
+		YonaiAPI bool Read(const std::string& path, std::vector<unsigned char>& output) const;
+
+		/// <summary>
+		/// Converts to the form stored in packs. Forward slashes, without a leading "./" or "/".
+		/// </summary>
+		YonaiAPI static std::string NormalisePath(std::string path);
+	};
+
+	/// <summary>
+	/// Builds a pack file from files on disk or in memory
+	/// </summary>
+	class PackWriter
+	{
+		struct Source
+		{
+			std::string Path;
+
+			/// <summary>
+			/// File read when writing the pack, otherwise Data is used
+			/// </summary>
+			std::string FilePath;
+			std::vector<unsigned char> Data;
+
+			PackCompression Compression;
+		};
+
+		std::vector<Source> m_Sources;
+		std::unordered_map<std::string, size_t> m_SourceIndices;
+
+		Source& AddSource(const std::string& path, PackCompression compression);
+
+	public:
+		/// <summary>
+		/// Adds a copy of data. Adding a path again replaces the previous entry.
+		/// </summary>
+		YonaiAPI void Add(const std::string& path, ByteSpan data, PackCompression compression = PackCompression::None);
+
+		/// <summary>
+		/// Adds a file, read once the pack is written. Adding a path again replaces the previous entry.
+		/// </summary>
+		YonaiAPI void AddFile(const std::string& path, const std::string& filePath, PackCompression compression = PackCompression::None);
+
+		YonaiAPI size_t GetEntryCount() const;
+
+		/// <summary>
+		/// Writes all added entries to a pack file. Entries are stored uncompressed when compression does not reduce their size.
+		/// </summary>
+		/// <param name="alignment">Alignment of entry data, must be a power of two</param>
+		YonaiAPI bool Write(const std::string& outputPath, uint32_t alignment = PackArchive::DefaultAlignment);
+	};
+}
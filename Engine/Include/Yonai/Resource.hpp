@@ -1,53 +1,228 @@
 #pragma once
+#include <mutex>
+#include <atomic>
 #include <memory>
 #include <string>
+#include <vector>
 #include <typeinfo>
 #include <typeindex>
+#include <condition_variable>
 #include <algorithm>
 #include <functional>
+#include <type_traits>
+#include <shared_mutex>
 #include <unordered_map>
 #include <spdlog/spdlog.h>
+#include <Yonai/ThreadPool.hpp>
 #include <Yonai/ResourceID.hpp>
+#include <Yonai/ResourceHandle.hpp>
 #include <Yonai/ResourceBase.hpp>
 #include <Yonai/Scripting/Assembly.hpp>
 
 namespace Yonai
 {
+	enum class ResourceState : unsigned char
+	{
+		/// <summary>
+		/// Not loaded, or unloaded
+		/// </summary>
+		Unloaded,
+
+		/// <summary>
+		/// Waiting for a worker thread to start loading
+		/// </summary>
+		Queued,
+
+		Loading,
+		Ready,
+
+		/// <summary>
+		/// Loader did not create the resource, the ID stays reserved until unloaded
+		/// </summary>
+		Failed
+	};
+
+	/// <summary>
+	/// Resource reloaded by Resource::ProcessReloads
+	/// </summary>
+	struct ResourceReload
+	{
+		ResourceID ID;
+		std::string Path;
+
+		/// <summary>
+		/// True if the resource's own source changed, false if only a dependency was reloaded
+		/// </summary>
+		bool SourceChanged = false;
+
+		/// <summary>
+		/// True if a reloader handled the resource, and succeeded
+		/// </summary>
+		bool Reloaded = false;
+
+		float Milliseconds = 0.0f;
+	};
+
+	/// <summary>
+	/// Reloads a resource. sourceChanged is false when only a dependency of the resource was reloaded.
+	/// </summary>
+	/// <returns>True if reloaded</returns>
+	typedef std::function<bool(ResourceID id, void* resource, bool sourceChanged)> ResourceReloader;
+
+	/// <summary>
+	/// Registry of loaded resources, safe to use from any thread.
+	/// Lookups by handle are lock-free, lookups by ID or path take a shared lock.
+	/// Unloaded resources are destroyed by DestroyPending, called at the end of each frame,
+	/// so pointers fetched during a frame stay valid until it ends.
+	/// </summary>
 	class Resource
 	{
-		struct ResourceInstance
+		typedef void(*ResourceDeleter)(void*);
+
+		struct ResourceSlot
 		{
-			void* Data;
-			std::type_index Type;
-			bool IsResourceBaseType;
+			/// <summary>
+			/// Loaded resource, only set while State is Ready
+			/// </summary>
+			std::atomic<void*> Data { nullptr };
 
-			ResourceInstance() : Data(nullptr), Type(typeid(void)), IsResourceBaseType(false) { }
-			ResourceInstance(ResourceInstance& other) : Data(other.Data), Type(other.Type), IsResourceBaseType(other.IsResourceBaseType) { }
-			ResourceInstance(const ResourceInstance& other) : Data(other.Data), Type(other.Type), IsResourceBaseType(other.IsResourceBaseType) { }
-			ResourceInstance(void* data, std::type_index& type) : Data(data), Type(type), IsResourceBaseType(false) { }
+			/// <summary>
+			/// Incremented each time the slot is released
+			/// </summary>
+			std::atomic<uint32_t> Generation { 0 };
 
-			ResourceInstance& operator =(ResourceInstance& other)
-			{
-				Data = other.Data;
-				Type = other.Type;
-				IsResourceBaseType = other.IsResourceBaseType;
-				return *this;
-			}
+			std::atomic<ResourceState> State { ResourceState::Unloaded };
+			std::atomic<int> References { 0 };
+
+			// Only changed while holding s_Mutex exclusively
+			std::type_index Type = typeid(void);
+			ResourceDeleter Deleter = nullptr;
+			ResourceID ID = InvalidResourceID;
+			std::string Path;
 		};
 
-		YonaiAPI static std::vector<ResourceInstance> s_Instances;
+		/// <summary>
+		/// Resource waiting to be destroyed at the end of the frame
+		/// </summary>
+		struct PendingDestruction
+		{
+			void* Data;
+			ResourceDeleter Deleter;
+			uint32_t SlotIndex;
+		};
+
+		static constexpr uint32_t SlotsPerPage = 1024;
+		static constexpr uint32_t MaxPages = 4096;
+
+		/// <summary>
+		/// Slots are allocated in pages which never move, so lock-free readers are not affected by new slots
+		/// </summary>
+		YonaiAPI static std::atomic<ResourceSlot*> s_Pages[MaxPages];
+		YonaiAPI static std::atomic<uint32_t> s_SlotCount;
 
 		/// <summary>
-		/// Links a string (often filepath) to a valid ResourceID
+		/// Indices of unused slots
+		/// </summary>
+		YonaiAPI static std::vector<uint32_t> s_FreeSlots;
+
+		/// <summary>
+		/// Links a string (often filepath) to a valid ResourceID.
+		/// The reverse is stored in each ResourceSlot.
 		/// </summary>
 		YonaiAPI static std::unordered_map<std::string, ResourceID> s_InstancePaths;
 
 		/// <summary>
-		/// Links a ResourceID to an index in s_Instances
+		/// Links a ResourceID to its slot
+		/// </summary>
+		YonaiAPI static std::unordered_map<ResourceID, ResourceHandle> s_ResourceIDs;
+
+		YonaiAPI static std::vector<PendingDestruction> s_PendingDestruction;
+
+		/// <summary>
+		/// Guards everything except reading slot atomics
+		/// </summary>
+		YonaiAPI static std::shared_mutex s_Mutex;
+
+		/// <summary>
+		/// Notified with s_Mutex held when a resource finishes loading or is released
+		/// </summary>
+		YonaiAPI static std::condition_variable_any s_LoadedCondition;
+
+		/// <summary>
+		/// Resources each resource depends on, and the reverse
+		/// </summary>
+		YonaiAPI static std::unordered_map<ResourceID, std::vector<ResourceID>> s_Dependencies;
+		YonaiAPI static std::unordered_map<ResourceID, std::vector<ResourceID>> s_Dependents;
+
+		/// <summary>
+		/// Files that are not resources themselves, such as shader sources, and the resources using them
+		/// </summary>
+		YonaiAPI static std::unordered_map<ResourceID, std::vector<std::string>> s_FileDependencies;
+		YonaiAPI static std::unordered_map<std::string, std::vector<ResourceID>> s_FileDependents;
+
+		YonaiAPI static std::unordered_map<std::type_index, ResourceReloader> s_Reloaders;
+		YonaiAPI static ResourceReloader s_DefaultReloader;
+
+		/// <summary>
+		/// Resources whose source changed, waiting for ProcessReloads
+		/// </summary>
+		YonaiAPI static std::vector<ResourceID> s_Invalidated;
+
+		/// <summary>
+		/// Guards dependencies, reloaders and invalidated resources.
+		/// May be locked while holding s_Mutex, but not the other way around.
+		/// </summary>
+		YonaiAPI static std::mutex s_DependencyMutex;
+
+		/// <summary>
+		/// Removes resources that id depends on. Requires s_DependencyMutex to be held.
 		/// </summary>
-		YonaiAPI static std::unordered_map<ResourceID, size_t> s_ResourceIDs;
+		YonaiAPI static void ClearDependencies(ResourceID id);
 
-		YonaiAPI static ResourceInstance* GetInstance(ResourceID id);
+		/// <returns>Slot at index, or null if not allocated</returns>
+		YonaiAPI static ResourceSlot* GetSlot(uint32_t index);
+
+		/// <summary>
+		/// Finds the resource at path, or reserves a slot for a new resource in state.
+		/// References to existing resources are incremented.
+		/// </summary>
+		/// <param name="created">Set to true when a slot was reserved, and the caller must Publish the resource</param>
+		/// <returns>ID of resource at path, or InvalidResourceID if an existing resource is of a different type</returns>
+		YonaiAPI static ResourceID Reserve(ResourceID id, const std::string& path, std::type_index type, ResourceState state, bool& created);
+
+		/// <summary>
+		/// Makes a reserved resource available, or marks it as failed when data is null.
+		/// Data is destroyed if the resource was unloaded while loading.
+		/// </summary>
+		YonaiAPI static void Publish(ResourceID id, void* data, ResourceDeleter deleter);
+
+		YonaiAPI static void SetState(ResourceID id, ResourceState state);
+
+		/// <summary>
+		/// Removes a resource from lookups and queues it for destruction. Requires s_Mutex to be held exclusively.
+		/// </summary>
+		YonaiAPI static void ReleaseSlot(ResourceID id);
+
+		/// <summary>
+		/// Blocks until the resource is no longer queued or loading
+		/// </summary>
+		YonaiAPI static void WaitUntilLoaded(ResourceID id);
+
+		/// <returns>Worker threads used by LoadAsync</returns>
+		YonaiAPI static ThreadPool& GetLoadPool();
+
+		YonaiAPI static void* Get(ResourceID id, std::type_index type);
+		YonaiAPI static void PrintResourceTypes(const std::type_index* type);
+
+		template<typename T>
+		static void Delete(void* data) { delete (T*)data; }
+
+		template<typename T>
+		static void AssignID(T* instance, ResourceID id)
+		{
+			if constexpr (std::is_base_of<ResourceBase, T>())
+				static_cast<ResourceBase*>(instance)->m_ResourceID = id;
+		}
 
 	public:
 		template<typename T, class... ArgTypes>
@@ -56,48 +231,66 @@ namespace Yonai
 			return Load<T, ArgTypes...>(ResourceID(), path, constructorArgs...);
 		}
 		
+		/// <summary>
+		/// Creates a resource, or returns the existing resource at path.
+		/// When another thread is loading the same path, blocks until it has finished.
+		/// </summary>
 		template<typename T, class... ArgTypes>
 		static ResourceID Load(ResourceID id, std::string path, ArgTypes... constructorArgs)
 		{
 			replace(path.begin(), path.end(), '\\', '/');
 
-			std::type_index loadType = typeid(T);
-
-			// Check if instance already exists
-			auto cacheIt = s_InstancePaths.find(path);
-			if (cacheIt != s_InstancePaths.end())
+			bool created = false;
+			ResourceID existing = Reserve(id, path, typeid(T), ResourceState::Loading, created);
+			if (!created)
 			{
-				ResourceInstance* loadedInstance = GetInstance(cacheIt->second);
-				if (loadedInstance->Type != loadType)
-				{
-					spdlog::error("Tried loading cached resource '{}' of type '{}' but expected '{}'", path, loadedInstance->Type.name(), loadType.name());
-					return InvalidResourceID;
-				}
-				return cacheIt->second;
+				WaitUntilLoaded(existing);
+				return existing;
 			}
 
-			// Create new resource
+			// Created outside of the lock, constructors may load other resources
 			T* instance = new T(constructorArgs...);
-			ResourceInstance resourceInstance(instance, loadType);
-
-			// Set resourceID in instance, if derived from ResourceBase
-			if (std::is_base_of<ResourceBase, T>())
-			{
-				((ResourceBase*)instance)->m_ResourceID = id;
-				resourceInstance.IsResourceBaseType = true;
-			}
-
-			s_Instances.emplace_back(resourceInstance);
-			s_InstancePaths.emplace(path, id);
-			s_ResourceIDs.emplace(id, s_Instances.size() - 1);
+			AssignID(instance, id);
+			Publish(id, instance, &Delete<T>);
 
 #if 1
-			spdlog::trace("Created new resource '{}' [{}][{}]", path.c_str(), loadType.name(), id);
+			spdlog::trace("Created new resource '{}' [{}][{}]", path.c_str(), typeid(T).name(), id);
 #endif
 
 			return id;
 		}
 
+		/// <summary>
+		/// Reserves an ID for path, then calls loader on a worker thread to create the resource.
+		/// Loader returning null marks the resource as Failed. Use GetState to check progress.
+		/// Loaders must not use the graphics context.
+		/// </summary>
+		/// <returns>ID of the resource, or existing resource at path</returns>
+		template<typename T>
+		static ResourceID LoadAsync(std::string path, std::function<T*()> loader)
+		{
+			replace(path.begin(), path.end(), '\\', '/');
+
+			ResourceID id;
+			bool created = false;
+			ResourceID existing = Reserve(id, path, typeid(T), ResourceState::Queued, created);
+			if (!created)
+				return existing;
+
+			GetLoadPool().Enqueue([id, loader]()
+			{
+				if (GetState(id) != ResourceState::Queued)
+					return; // Unloaded before loading started
+
+				SetState(id, ResourceState::Loading);
+				T* instance = loader();
+				if (instance)
+					AssignID(instance, id);
+				Publish(id, instance, &Delete<T>);
+			});
+			return id;
+		}
+
 		template<typename T, class... ArgTypes>
 		static T* LoadPtr(std::string path, ArgTypes... constructorArgs)
 		{
@@ -109,25 +302,44 @@ namespace Yonai
 		/// </summary>
 		YonaiAPI static std::type_index GetType(ResourceID id);
 
+		/// <returns>Loading state of resource, or Unloaded if the ID is not known</returns>
+		YonaiAPI static ResourceState GetState(ResourceID id);
+
 		/// <summary>
 		/// Generic getter for resources whose types have a parameterless constructor
 		/// </summary>
 		template<typename T>
-		static T* Get(std::string path)
-		{
-			if (!Exists(path))
-				return (T*)nullptr;
-			ResourceInstance* instance = GetInstance(s_InstancePaths[path]);
-			return (T*)(instance && instance->Type == typeid(T) ? instance->Data : nullptr);
-		}
+		static T* Get(std::string path) { return (T*)Get(GetID(path), typeid(T)); }
+
+		/// <returns>Resource, or null if not ready or not of type T</returns>
+		template<typename T>
+		static T* Get(ResourceID id) { return (T*)Get(id, typeid(T)); }
 
+		/// <summary>
+		/// Lock-free constant time lookup, without hashing or checking the resource's type
+		/// </summary>
+		/// <returns>Resource, or null if it is not ready or has been unloaded</returns>
 		template<typename T>
-		static T* Get(ResourceID id)
+		static T* Get(TypedResourceHandle<T> handle) { return (T*)Get((ResourceHandle)handle); }
+		YonaiAPI static void* Get(ResourceHandle handle);
+
+		/// <returns>Handle to the resource's slot, or an invalid handle if not loaded</returns>
+		YonaiAPI static ResourceHandle GetHandle(ResourceID id);
+
+		/// <returns>Handle to the resource's slot, or an invalid handle if not loaded or not of type T</returns>
+		template<typename T>
+		static TypedResourceHandle<T> GetHandle(ResourceID id)
 		{
-			ResourceInstance* instance = GetInstance(id);
-			return (T*)(instance && instance->Type == typeid(T) ? instance->Data : nullptr);
+			TypedResourceHandle<T> output;
+			if (GetType(id) != typeid(T))
+				return output;
+			(ResourceHandle&)output = GetHandle(id);
+			return output;
 		}
 
+		/// <returns>True if handle refers to a ready resource</returns>
+		YonaiAPI static bool IsValid(ResourceHandle handle);
+
 		YonaiAPI static void* Get(ResourceID id);
 		YonaiAPI static void* Get(std::string path);
 
@@ -142,40 +354,144 @@ namespace Yonai
 		YonaiAPI static std::string GetPath(ResourceID id);
 
 		/// <summary>
-		/// Releases resources associated with ResourceID
+		/// Adds a reference to a resource, keeping it loaded until a matching Release.
+		/// Load adds a reference each time it is called.
+		/// </summary>
+		YonaiAPI static void AddReference(ResourceID id);
+
+		/// <summary>
+		/// Removes a reference, unloading the resource once none remain
+		/// </summary>
+		YonaiAPI static void Release(ResourceID id);
+
+		/// <returns>Amount of references to resource, or 0 if not loaded</returns>
+		YonaiAPI static int GetReferenceCount(ResourceID id);
+
+		/// <summary>
+		/// Releases resources associated with ResourceID, regardless of remaining references.
+		/// The ID and path are immediately available for new resources, the resource is destroyed by DestroyPending.
 		/// </summary>
 		YonaiAPI static void Unload(ResourceID resource);
 
 		/// <summary>
-		/// Releases all associated resources
+		/// Releases and destroys all associated resources
 		/// </summary>
 		YonaiAPI static void UnloadAll();
 
+		/// <summary>
+		/// Destroys unloaded resources. Called at the end of each frame, on the main thread.
+		/// </summary>
+		YonaiAPI static void DestroyPending();
+
 		YonaiAPI static bool Exists(std::string path);
 		YonaiAPI static bool IsValidResourceID(ResourceID id);
 
+		/// <summary>
+		/// Records that dependent must be reloaded after dependency is reloaded
+		/// </summary>
+		YonaiAPI static void AddDependency(ResourceID dependent, ResourceID dependency);
+		YonaiAPI static void RemoveDependency(ResourceID dependent, ResourceID dependency);
+
+		/// <summary>
+		/// Replaces all resources that dependent depends on. Invalid IDs are ignored.
+		/// </summary>
+		YonaiAPI static void SetDependencies(ResourceID dependent, const std::vector<ResourceID>& dependencies);
+
+		/// <summary>
+		/// Replaces all files, which are not resources themselves, that dependent is reloaded after
+		/// </summary>
+		YonaiAPI static void SetFileDependencies(ResourceID dependent, const std::vector<std::string>& paths);
+
+		/// <returns>Resources that id directly depends on</returns>
+		YonaiAPI static std::vector<ResourceID> GetDependencies(ResourceID id);
+
+		/// <returns>Resources directly depending on id</returns>
+		YonaiAPI static std::vector<ResourceID> GetDependents(ResourceID id);
+
+		/// <summary>
+		/// Finds changed resources and everything depending on them, directly or indirectly.
+		/// Each resource is included once, after all of its dependencies. Resources in a dependency cycle are placed last.
+		/// </summary>
+		YonaiAPI static std::vector<ResourceID> GetReloadOrder(const std::vector<ResourceID>& changed);
+
+		/// <summary>
+		/// Queues a resource, and resources depending on it, to be reloaded by ProcessReloads. Safe to call from any thread.
+		/// </summary>
+		YonaiAPI static void Invalidate(ResourceID id);
+
+		/// <summary>
+		/// Invalidates the resource at path, and resources depending on the file at path
+		/// </summary>
+		YonaiAPI static void Invalidate(std::string path);
+
+		/// <summary>
+		/// Reloads all invalidated resources and their dependents, each at most once, dependencies first.
+		/// Called once per frame by Application, on the main thread.
+		/// </summary>
+		/// <returns>Resources visited, and the time spent reloading each</returns>
+		YonaiAPI static std::vector<ResourceReload> ProcessReloads();
+
+		/// <summary>
+		/// Immediately reloads changed resources and their dependents, each at most once, dependencies first
+		/// </summary>
+		YonaiAPI static std::vector<ResourceReload> Reload(const std::vector<ResourceID>& changed);
+		YonaiAPI static std::vector<ResourceReload> Reload(ResourceID id);
+
+		/// <summary>
+		/// Sets the function reloading resources of type T
+		/// </summary>
 		template<typename T>
-		static bool IsValidType(ResourceID id)
+		static void SetReloader(std::function<bool(ResourceID, T&, bool)> reloader)
 		{
-			if (!IsValidResourceID(id))
-				return false;
-			ResourceInstance* instance = GetInstance(id);
-			return instance && instance->Type == typeid(T);
+			std::lock_guard lock(s_DependencyMutex);
+			if (reloader)
+				s_Reloaders[typeid(T)] = [reloader](ResourceID id, void* data, bool sourceChanged)
+				{ return reloader(id, *(T*)data, sourceChanged); };
+			else
+				s_Reloaders.erase(typeid(T));
 		}
 
+		/// <summary>
+		/// Sets the function reloading resources of types without their own reloader, such as resources created by scripts.
+		/// The resource is null if not loaded natively.
+		/// </summary>
+		YonaiAPI static void SetDefaultReloader(ResourceReloader reloader);
+
+		template<typename T>
+		static bool IsValidType(ResourceID id) { return GetType(id) == typeid(T); }
+
 		YonaiAPI static void PrintResourceTypes();
 
 		template<typename T>
 		static void PrintResourceTypes()
 		{
-			const std::type_info& typeInfo = typeid(T);
-			spdlog::trace("Printing resources [{}]", typeInfo.name());
-			for (auto& pair : s_InstancePaths)
-			{
-				ResourceInstance* instance = GetInstance(pair.second);
-				if (instance->Type == typeInfo)
-					spdlog::trace(" [{}->{}] {}", pair.second, s_ResourceIDs[pair.second], pair.first);
-			}
+			std::type_index type = typeid(T);
+			PrintResourceTypes(&type);
+		}
+	};
+
+	/// <summary>
+	/// Pointer to a resource, only looked up again when the resource ID changes or the resource is unloaded.
+	/// Suited to components fetching the same resource every frame.
+	/// </summary>
+	template<typename T>
+	class CachedResource
+	{
+		ResourceID m_ID = InvalidResourceID;
+		TypedResourceHandle<T> m_Handle;
+		T* m_Pointer = nullptr;
+
+	public:
+		/// <returns>Resource with ID id, or null if not loaded or not of type T</returns>
+		T* Get(ResourceID id)
+		{
+			if (id == m_ID && Resource::IsValid(m_Handle))
+				return m_Pointer;
+
+			m_ID = id;
+			m_Handle = Resource::GetHandle<T>(id);
+			m_Pointer = Resource::Get<T>(m_Handle);
+			return m_Pointer;
 		}
 	};
 }
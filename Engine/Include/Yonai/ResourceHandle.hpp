@@ -0,0 +1,27 @@
+#pragma once
+#include <cstdint>
+
+namespace Yonai
+{
+	/// <summary>
+	/// Slot of a loaded resource, valid until that resource is unloaded.
+	/// The generation changes each time a slot is released, so handles to unloaded resources are never valid again,
+	/// even after the slot is reused.
+	/// </summary>
+	struct ResourceHandle
+	{
+		static constexpr uint32_t InvalidIndex = ~0u;
+
+		uint32_t Index = InvalidIndex;
+		uint32_t Generation = 0;
+
+		bool operator ==(const ResourceHandle& other) const { return Index == other.Index && Generation == other.Generation; }
+		bool operator !=(const ResourceHandle& other) const { return !(*this == other); }
+	};
+
+	/// <summary>
+	/// Handle to a resource known to be of type T, lookups skip checking the resource's type
+	/// </summary>
+	template<typename T>
+	struct TypedResourceHandle : public ResourceHandle { };
+}
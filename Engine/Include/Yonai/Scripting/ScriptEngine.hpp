@@ -4,6 +4,7 @@
 #include <mono/jit/jit.h>
 #include <Yonai/API.hpp>
 #include <Yonai/Systems/System.hpp>
+#include <Yonai/IO/ByteSpan.hpp>
 #include <Yonai/IO/FileWatcher.hpp>
 #include <Yonai/Scripting/Assembly.hpp>
 
@@ -86,7 +87,7 @@ namespace Yonai::Scripting
 		/// Loads an assembly from memory
 		/// </summary>
 		/// <param name="friendlyName">Name for debugging, warnings and errors</param>
-		YonaiAPI static Assembly* LoadAssembly(std::vector<unsigned char>& assemblyData, const char* friendlyName);
+		YonaiAPI static Assembly* LoadAssembly(IO::ByteSpan assemblyData, const char* friendlyName);
 
 
 		/// <returns>All assemblies currently loaded</summary>
@@ -1,6 +1,13 @@
 #pragma once
 
+#include <vector>
 #include <miniaudio.h>
+#include <glm/vec3.hpp>
+#include <Yonai/Audio/VoiceManager.hpp>
+#include <Yonai/Audio/AudioRenderer.hpp>
+#include <Yonai/Audio/AudioCullingGrid.hpp>
+#include <Yonai/Audio/AudioDecodeCache.hpp>
+#include <Yonai/Audio/AudioCommandQueue.hpp>
 #include <Yonai/Systems/ScriptSystem.hpp>
 #include <Yonai/Systems/Global/SceneSystem.hpp>
 
@@ -31,14 +38,54 @@ namespace Yonai::Systems
 
 		// Resource Manager //
 		static ma_resource_manager s_ResourceManager;
+		static bool s_ResourceManagerReady;
+
+		/// <summary>
+		/// Short clips decoded once and shared by every source playing them
+		/// </summary>
+		static AudioDecodeCache s_DecodeCache;
 
 		// Engine //
 		static ma_engine s_Engine;
 
+		/// <summary>
+		/// True when the engine has no output device, and is only mixed by calls to Render
+		/// </summary>
+		static bool s_Offline;
+		static AudioRenderer s_Renderer;
+
+		/// <summary>
+		/// Changes to sounds made on the game thread, applied by the audio thread before mixing each buffer
+		/// </summary>
+		static AudioCommandQueue s_Commands;
+
+		// Voices //
+		static VoiceManager s_VoiceManager;
+
+		/// <summary>
+		/// Playing sources and their voices, rebuilt each update
+		/// </summary>
+		static std::vector<AudioVoice> s_Voices;
+		static std::vector<Components::AudioSource*> s_VoiceSources;
+
+		static std::vector<glm::vec3> s_ListenerPositions;
+
+		// Culling //
+		static AudioCullingGrid s_CullingGrid;
+		static unsigned int s_CullingQuery;
+		static unsigned int s_CulledCount;
+
+		/// <summary>
+		/// Playing sources and those in range of a listener, rebuilt each update
+		/// </summary>
+		static std::vector<Components::AudioSource*> s_PlayingSources;
+		static std::vector<const void*> s_InRangeSources;
+
 		// Scripting //
 		static Scripting::Class* s_ScriptClass;
 
 		static void SetupEngine();
+		static void ReleaseEngine();
 		static void RefreshDevices();
 		static void GetScriptClass();
 		static void SetupResourceManager();
@@ -84,5 +131,59 @@ namespace Yonai::Systems
 
 		/// <returns>Sample rate for the current output device</returns>
 		YonaiAPI static unsigned int GetSampleRate();
+
+		/// <summary>
+		/// Replaces the output device with an engine that is only mixed by calling Render, as fast as possible.
+		/// Used automatically when there are no playback devices, or the "OfflineAudio" launch argument is given.
+		/// </summary>
+		YonaiAPI static bool SetOffline(unsigned int channels = 2, unsigned int sampleRate = 48000);
+
+		/// <summary>
+		/// Replaces the output device with one on miniaudio's null backend, which discards its output.
+		/// Mixed in real time on the device's thread like any other output device, for headless machines where sounds should play over time.
+		/// </summary>
+		YonaiAPI static bool SetNullDevice(unsigned int channels = 2, unsigned int sampleRate = 48000);
+
+		/// <returns>True when mixing without an output device</returns>
+		YonaiAPI static bool IsOffline();
+
+		/// <summary>
+		/// Mixes frameCount frames in to output while offline, applying changes to sources before each block
+		/// </summary>
+		/// <returns>Frames rendered, 0 if not offline</returns>
+		YonaiAPI static ma_uint64 Render(std::vector<float>& output, ma_uint64 frameCount);
+
+		/// <summary>
+		/// Mixes frameCount frames in to a WAV file while offline
+		/// </summary>
+		YonaiAPI static bool RenderToFile(const std::string& path, ma_uint64 frameCount);
+
+		/// <summary>
+		/// Mixes offline, and measures the time taken to mix
+		/// </summary>
+		YonaiAPI static AudioRenderer& GetRenderer();
+
+		/// <summary>
+		/// Limits how many sources are mixed at once, choosing the rest to be virtual
+		/// </summary>
+		YonaiAPI static VoiceManager& GetVoiceManager();
+
+		/// <summary>
+		/// Sources beyond their maximum rolloff distance from every listener are culled, and not mixed
+		/// </summary>
+		YonaiAPI static AudioCullingGrid& GetCullingGrid();
+
+		/// <summary>
+		/// Holds short clips decoded, within a memory budget, while all other clips stay compressed in memory
+		/// </summary>
+		YonaiAPI static AudioDecodeCache& GetDecodeCache();
+
+		/// <summary>
+		/// Changes to sounds made on the game thread, applied by the output device's thread before mixing each buffer
+		/// </summary>
+		YonaiAPI static AudioCommandQueue& GetCommands();
+
+		/// <returns>Playing sources culled by distance in the last update</returns>
+		YonaiAPI static unsigned int GetCulledCount();
 	};
 }
\ No newline at end of file
@@ -22,6 +22,12 @@ namespace Yonai::Systems
 		YonaiAPI void Draw() override;
 		YonaiAPI void OnEnabled() override;
 
+		/// <summary>
+		/// Uploads textures that have finished decoding, within TextureLoader's upload budget
+		/// </summary>
+		YonaiAPI void Update() override;
+		YonaiAPI void Destroy() override;
+
 		YonaiAPI Graphics::RenderPipeline* GetPipeline();
 
 		template<typename T>
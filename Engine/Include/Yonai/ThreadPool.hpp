@@ -0,0 +1,57 @@
+#pragma once
+#include <queue>
+#include <mutex>
+#include <vector>
+#include <thread>
+#include <functional>
+#include <condition_variable>
+#include <Yonai/API.hpp>
+
+namespace Yonai
+{
+	typedef std::function<void()> ThreadPoolJob;
+
+	/// <summary>
+	/// Fixed set of worker threads, executing jobs in the order they are enqueued
+	/// </summary>
+	class ThreadPool
+	{
+		bool m_Running;
+		unsigned int m_ActiveJobs;
+		std::vector<std::thread> m_Threads;
+		std::queue<ThreadPoolJob> m_Jobs;
+
+		std::mutex m_Mutex;
+		std::condition_variable m_JobAvailable;
+		std::condition_variable m_JobsFinished;
+
+		void WorkerLoop();
+
+	public:
+		/// <param name="threadCount">Amount of worker threads, or 0 to use one less than the hardware thread count</param>
+		YonaiAPI ThreadPool(unsigned int threadCount = 0);
+
+		/// <summary>
+		/// Finishes all queued jobs, then joins worker threads
+		/// </summary>
+		YonaiAPI ~ThreadPool();
+
+		/// <summary>
+		/// Adds a job to the queue, to be executed on a worker thread
+		/// </summary>
+		YonaiAPI void Enqueue(ThreadPoolJob job);
+
+		/// <summary>
+		/// Blocks until all queued jobs have finished
+		/// </summary>
+		YonaiAPI void Wait();
+
+		/// <summary>
+		/// Calls job for each index in [0, count), spread across worker threads and the calling thread.
+		/// Blocks until every index has been processed, other queued jobs are not waited on.
+		/// </summary>
+		YonaiAPI void ParallelFor(size_t count, const std::function<void(size_t)>& job);
+
+		YonaiAPI unsigned int GetThreadCount();
+	};
+}
@@ -1,9 +1,22 @@
 #pragma once
 #include <string>
+#include <cstdint>
 #include <glm/glm.hpp>
 #include <Yonai/API.hpp>
 
 namespace Yonai
 {
 	YonaiAPI std::string& ToLower(std::string& input);
+
+	/// <summary>
+	/// Initial value for Hash, the 64-bit FNV-1a offset basis
+	/// </summary>
+	constexpr uint64_t HashSeed = 0xcbf29ce484222325ull;
+
+	/// <summary>
+	/// 64-bit FNV-1a hash of data. Not cryptographically secure.
+	/// </summary>
+	/// <param name="seed">Previous hash, to combine multiple inputs</param>
+	YonaiAPI uint64_t Hash(const void* data, size_t size, uint64_t seed = HashSeed);
+	YonaiAPI uint64_t Hash(const std::string& input, uint64_t seed = HashSeed);
 }
\ No newline at end of file
@@ -2,7 +2,10 @@
 #include <Yonai/Time.hpp>
 #include <Yonai/Utils.hpp>
 #include <Yonai/Window.hpp>
+#include <Yonai/Resource.hpp>
 #include <Yonai/Application.hpp>
+#include <Yonai/IO/FileWatcher.hpp>
+#include <Yonai/IO/ImportCache.hpp>
 #include <Yonai/Scripting/Assembly.hpp>
 
 // spdlog //
@@ -133,6 +136,10 @@ void Application::Cleanup() {}
 Application::~Application()
 {
 	SystemManager::Global()->Destroy();
+
+	// Remember hashes of imported sources for next launch
+	ImportCache::Flush();
+
 	spdlog::shutdown();
 
 	s_Instance = nullptr;
@@ -147,10 +154,15 @@ void Application::Run()
 
 	while (IsRunning())
 	{
+		// Deliver file changes, and reload resources they affect, before anything reacts to them this frame
+		FileWatcher::ProcessEvents();
+		Resource::ProcessReloads();
+
 		OnUpdate();
 
 		SystemManager::Global()->Update();
 
+		Resource::DestroyPending();
 		Time::OnFrameEnd();
 	}
 
@@ -273,6 +285,9 @@ void WindowedApplication::Run()
 		// if OpenGL
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
+		FileWatcher::ProcessEvents();
+		Resource::ProcessReloads();
+
 		OnUpdate();
 		SystemManager::Global()->Update();
 			
@@ -283,6 +298,9 @@ void WindowedApplication::Run()
 		Window::SwapBuffers();
 		Window::PollEvents();
 
+		// Resources unloaded this frame are no longer in use
+		Resource::DestroyPending();
+
 		Time::OnFrameEnd();
 	}
 
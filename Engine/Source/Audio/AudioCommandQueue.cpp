@@ -0,0 +1,98 @@
+#include <thread>
+#include <Yonai/Audio/AudioCommandQueue.hpp>
+
+using namespace std;
+using namespace Yonai;
+
+AudioCommandQueue::AudioCommandQueue(AudioCommandHandler handler, size_t capacity) :
+	m_Handler(handler), m_Commands(), m_Mask(0), m_Write(0), m_Published(0), m_Read(0)
+{
+	size_t size = 1;
+	while (size < capacity)
+		size <<= 1;
+	m_Commands.resize(size);
+	m_Mask = size - 1;
+}
+
+void AudioCommandQueue::Push(const AudioCommand& command)
+{
+	if (m_Write - m_Read.load(memory_order_acquire) >= m_Commands.size())
+		Synchronise();
+
+	m_Commands[m_Write & m_Mask] = command;
+	m_Write++;
+}
+
+void AudioCommandQueue::Flush() { m_Published.store(m_Write, memory_order_release); }
+
+size_t AudioCommandQueue::Apply()
+{
+	if (m_Applying.test_and_set(memory_order_acquire))
+		return 0;
+
+	size_t applied = ApplyPublished();
+	m_Applying.clear(memory_order_release);
+	return applied;
+}
+
+void AudioCommandQueue::Synchronise()
+{
+	Flush();
+	while (m_Applying.test_and_set(memory_order_acquire))
+		this_thread::yield();
+
+	ApplyPublished();
+	m_Applying.clear(memory_order_release);
+}
+
+size_t AudioCommandQueue::ApplyPublished()
+{
+	size_t read = m_Read.load(memory_order_relaxed);
+	const size_t published = m_Published.load(memory_order_acquire);
+	for (size_t i = read; i != published; i++)
+		m_Handler(m_Commands[i & m_Mask]);
+
+	// Slots are only reused by the game thread once marked as read
+	m_Read.store(published, memory_order_release);
+	return published - read;
+}
+
+size_t AudioCommandQueue::GetPending() { return m_Write - m_Read.load(memory_order_acquire); }
+size_t AudioCommandQueue::GetCapacity() { return m_Commands.size(); }
+
+void AudioCommandQueue::ApplyToSound(const AudioCommand& command)
+{
+	ma_sound* sound = command.Sound;
+	switch (command.Type)
+	{
+	default:
+	case AudioCommandType::None: break;
+	case AudioCommandType::Start: ma_sound_start(sound); break;
+	case AudioCommandType::Stop: ma_sound_stop(sound); break;
+	case AudioCommandType::Seek: ma_sound_seek_to_pcm_frame(sound, command.Frame); break;
+	case AudioCommandType::SetPan: ma_sound_set_pan(sound, command.Values[0]); break;
+	case AudioCommandType::SetPitch: ma_sound_set_pitch(sound, command.Values[0]); break;
+	case AudioCommandType::SetLooping: ma_sound_set_looping(sound, command.Values[0] != 0.0f); break;
+	case AudioCommandType::SetPosition: ma_sound_set_position(sound, command.Values[0], command.Values[1], command.Values[2]); break;
+	case AudioCommandType::Set3D: ma_sound_set_spatialization_enabled(sound, command.Values[0] != 0.0f); break;
+	case AudioCommandType::SetAttenuationRolloff: ma_sound_set_rolloff(sound, command.Values[0]); break;
+	case AudioCommandType::SetAttenuationModel: ma_sound_set_attenuation_model(sound, (ma_attenuation_model)command.Frame); break;
+	case AudioCommandType::SetRolloffDistance:
+		ma_sound_set_min_distance(sound, command.Values[0]);
+		ma_sound_set_max_distance(sound, command.Values[1]);
+		break;
+	case AudioCommandType::SetRolloffGain:
+		ma_sound_set_min_gain(sound, command.Values[0]);
+		ma_sound_set_max_gain(sound, command.Values[1]);
+		break;
+	case AudioCommandType::SetStopTime: ma_sound_set_stop_time_in_pcm_frames(sound, command.Frame); break;
+	case AudioCommandType::Fade: ma_sound_set_fade_in_pcm_frames(sound, command.Values[0], command.Values[1], command.Frame); break;
+	case AudioCommandType::SetVolume:
+	{
+		// Ramped from the current volume to avoid zipper noise
+		ma_uint64 rampFrames = (ma_uint64)VolumeRampMilliseconds * ma_engine_get_sample_rate(ma_sound_get_engine(sound)) / 1000;
+		ma_sound_set_fade_in_pcm_frames(sound, -1.0f, command.Values[0], rampFrames);
+		break;
+	}
+	}
+}
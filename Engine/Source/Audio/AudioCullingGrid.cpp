@@ -0,0 +1,170 @@
+#include <cmath>
+#include <algorithm>
+#include <glm/glm.hpp>
+#include <Yonai/Audio/AudioCullingGrid.hpp>
+
+using namespace std;
+using namespace Yonai;
+
+// Cell coordinates are packed in to 21 bits per axis
+static const int64_t CellBits = 21;
+static const int64_t CellMask = (1 << CellBits) - 1;
+
+static uint64_t PackCell(int64_t x, int64_t y, int64_t z)
+{ return ((uint64_t)(x & CellMask) << (CellBits * 2)) | ((uint64_t)(y & CellMask) << CellBits) | (uint64_t)(z & CellMask); }
+
+AudioCullingGrid::AudioCullingGrid(float cellSize) : m_CellSize((std::max)(cellSize, 0.01f)), m_QueryCount(0) { }
+
+uint64_t AudioCullingGrid::GetCell(const glm::vec3& position)
+{
+	return PackCell(
+		(int64_t)floorf(position.x / m_CellSize),
+		(int64_t)floorf(position.y / m_CellSize),
+		(int64_t)floorf(position.z / m_CellSize));
+}
+
+void AudioCullingGrid::Link(Entry& entry)
+{
+	entry.InGrid = entry.Radius <= m_CellSize * QueryCells;
+	if (!entry.InGrid)
+	{
+		m_Unbounded.emplace_back(&entry);
+		return;
+	}
+
+	entry.Cell = GetCell(entry.Position);
+	m_Cells[entry.Cell].emplace_back(&entry);
+}
+
+void AudioCullingGrid::Unlink(Entry& entry)
+{
+	vector<Entry*>* entries = &m_Unbounded;
+	unordered_map<uint64_t, vector<Entry*>>::iterator cell = m_Cells.end();
+	if (entry.InGrid)
+	{
+		cell = m_Cells.find(entry.Cell);
+		if (cell == m_Cells.end())
+			return;
+		entries = &cell->second;
+	}
+
+	// Order within a cell does not matter, swap with the last entry to remove
+	auto it = find(entries->begin(), entries->end(), &entry);
+	if (it != entries->end())
+	{
+		*it = entries->back();
+		entries->pop_back();
+	}
+
+	if (cell != m_Cells.end() && entries->empty())
+		m_Cells.erase(cell);
+}
+
+void AudioCullingGrid::Update(const void* key, const glm::vec3& position, float radius)
+{
+	auto it = m_Entries.find(key);
+	if (it == m_Entries.end())
+	{
+		Entry& entry = m_Entries[key];
+		entry.Key = key;
+		entry.Position = position;
+		entry.Radius = radius;
+		Link(entry);
+		return;
+	}
+
+	Entry& entry = it->second;
+	bool inGrid = radius <= m_CellSize * QueryCells;
+	bool relink = inGrid != entry.InGrid || (inGrid && GetCell(position) != entry.Cell);
+
+	if (relink)
+		Unlink(entry);
+
+	entry.Position = position;
+	entry.Radius = radius;
+
+	if (relink)
+		Link(entry);
+}
+
+void AudioCullingGrid::Remove(const void* key)
+{
+	auto it = m_Entries.find(key);
+	if (it == m_Entries.end())
+		return;
+
+	Unlink(it->second);
+	m_Entries.erase(it);
+}
+
+void AudioCullingGrid::Clear()
+{
+	m_Cells.clear();
+	m_Entries.clear();
+	m_Unbounded.clear();
+}
+
+bool AudioCullingGrid::Contains(const void* key) { return m_Entries.find(key) != m_Entries.end(); }
+size_t AudioCullingGrid::GetCount() { return m_Entries.size(); }
+size_t AudioCullingGrid::GetUnboundedCount() { return m_Unbounded.size(); }
+float AudioCullingGrid::GetCellSize() { return m_CellSize; }
+
+void AudioCullingGrid::SetCellSize(float size)
+{
+	m_CellSize = (std::max)(size, 0.01f);
+
+	m_Cells.clear();
+	m_Unbounded.clear();
+	for (auto& pair : m_Entries)
+		Link(pair.second);
+}
+
+void AudioCullingGrid::Query(const vector<glm::vec3>& listeners, vector<const void*>& output)
+{
+	output.clear();
+	if (++m_QueryCount == 0)
+	{
+		// Wrapped around, reset so old values are not mistaken for this query
+		for (auto& pair : m_Entries)
+			pair.second.LastFound = 0;
+		m_QueryCount = 1;
+	}
+
+	auto test = [&](Entry* entry, const glm::vec3& listener)
+	{
+		if (entry->LastFound == m_QueryCount)
+			return;
+
+		glm::vec3 offset = entry->Position - listener;
+		if (isinf(entry->Radius) || glm::dot(offset, offset) <= entry->Radius * entry->Radius)
+		{
+			entry->LastFound = m_QueryCount;
+			output.emplace_back(entry->Key);
+		}
+	};
+
+	for (const glm::vec3& listener : listeners)
+	{
+		for (Entry* entry : m_Unbounded)
+			test(entry, listener);
+
+		if (m_Cells.empty())
+			continue;
+
+		// Sources in the grid are never heard further than QueryCells away
+		int64_t cx = (int64_t)floorf(listener.x / m_CellSize);
+		int64_t cy = (int64_t)floorf(listener.y / m_CellSize);
+		int64_t cz = (int64_t)floorf(listener.z / m_CellSize);
+		for (int64_t x = cx - QueryCells; x <= cx + QueryCells; x++)
+			for (int64_t y = cy - QueryCells; y <= cy + QueryCells; y++)
+				for (int64_t z = cz - QueryCells; z <= cz + QueryCells; z++)
+				{
+					auto cell = m_Cells.find(PackCell(x, y, z));
+					if (cell == m_Cells.end())
+						continue;
+
+					for (Entry* entry : cell->second)
+						test(entry, listener);
+				}
+	}
+}
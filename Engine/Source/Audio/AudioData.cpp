@@ -7,19 +7,107 @@ using namespace std;
 using namespace Yonai;
 using namespace Yonai::Systems;
 
-AudioData::AudioData() : m_Data() { }
-AudioData::AudioData(std::vector<unsigned char>& data) : m_Data() { Import(data); }
+AudioData::AudioData() : m_Data(), m_StreamPath(), m_StreamPack(), m_StreamData(), m_Length(0.0f) { }
+AudioData::AudioData(IO::ByteSpan data) : m_Data(), m_StreamPath(), m_StreamPack(), m_StreamData(), m_Length(0.0f) { Import(data); }
+AudioData::~AudioData() { AudioSystem::GetDecodeCache().Remove(this); }
 
-float AudioData::GetLength()
+/// <returns>Length of the decoder's clip in seconds, or 0 if unknown</returns>
+static float GetDecoderLength(ma_decoder& decoder)
 {
-	float seconds = m_Data.empty() ? 0 : m_Data.size() / (float)AudioSystem::s_Device.playback.internalSampleRate;
-	return seconds;
+	ma_uint64 frames = 0;
+	ma_uint32 sampleRate = 0;
+	if (ma_decoder_get_length_in_pcm_frames(&decoder, &frames) != MA_SUCCESS ||
+		ma_decoder_get_data_format(&decoder, nullptr, nullptr, &sampleRate, nullptr, 0) != MA_SUCCESS ||
+		sampleRate == 0)
+		return 0.0f;
+	return frames / (float)sampleRate;
 }
 
-void AudioData::Import(vector<unsigned char>& data)
+float AudioData::GetLength() { return m_Length; }
+bool AudioData::IsStreaming() { return !m_StreamPath.empty(); }
+size_t AudioData::GetMemoryUsage() { return sizeof(AudioData) + m_Data.capacity() + m_StreamPath.capacity(); }
+
+void AudioData::Import(IO::ByteSpan data)
 {
+	// Previously decoded clip is out of date, sources already playing it keep their copy
+	AudioSystem::GetDecodeCache().Remove(this);
+
 	// Copy data
-	m_Data = data;
+	m_Data.assign(data.begin(), data.end());
+	m_StreamPath.clear();
+	m_StreamPack.reset();
+	m_StreamData = {};
+	m_Length = 0.0f;
+
+	ma_decoder decoder;
+	ma_decoder_config config = ma_decoder_config_init_default();
+	if (m_Data.empty() || ma_decoder_init_memory(m_Data.data(), m_Data.size(), &config, &decoder) != MA_SUCCESS)
+	{
+		spdlog::warn("Failed to read audio clip length - unsupported format");
+		return;
+	}
+	m_Length = GetDecoderLength(decoder);
+	ma_decoder_uninit(&decoder);
+}
+
+void AudioData::ImportStream(const string& path)
+{
+	AudioSystem::GetDecodeCache().Remove(this);
+	m_Data.clear();
+	m_Data.shrink_to_fit();
+	m_StreamPath = path;
+	m_StreamPack.reset();
+	m_StreamData = {};
+	m_Length = 0.0f;
+
+	// Only the header is read to get the length, audio is decoded once playing
+	ma_decoder decoder;
+	ma_decoder_config config = ma_decoder_config_init_default();
+	if (ma_decoder_init_file(path.c_str(), &config, &decoder) != MA_SUCCESS)
+	{
+		spdlog::warn("Failed to open audio stream '{}'", path);
+		return;
+	}
+	m_Length = GetDecoderLength(decoder);
+	ma_decoder_uninit(&decoder);
+}
+
+void AudioData::ImportPackStream(const string& packPath, const string& path)
+{
+	// Mapped separately to the VFS's pack, so the clip's data outlives it being unmounted
+	unique_ptr<IO::PackArchive> pack = make_unique<IO::PackArchive>(packPath);
+	const IO::PackEntry* entry = pack->IsOpen() ? pack->Find(path) : nullptr;
+	if (!entry)
+	{
+		spdlog::warn("Failed to open audio stream '{}' - not found in pack '{}'", path, packPath);
+		return;
+	}
+
+	if (entry->Compression != IO::PackCompression::None)
+	{
+		vector<unsigned char> data;
+		if (pack->Read(*entry, data))
+			Import(data);
+		return;
+	}
+
+	AudioSystem::GetDecodeCache().Remove(this);
+	m_Data.clear();
+	m_Data.shrink_to_fit();
+	m_StreamPath = path;
+	m_StreamPack = move(pack);
+	m_StreamData = m_StreamPack->GetData(*entry);
+	m_Length = 0.0f;
+
+	ma_decoder decoder;
+	ma_decoder_config config = ma_decoder_config_init_default();
+	if (ma_decoder_init_memory(m_StreamData.data(), m_StreamData.size(), &config, &decoder) != MA_SUCCESS)
+	{
+		spdlog::warn("Failed to open audio stream '{}' in pack '{}'", path, packPath);
+		return;
+	}
+	m_Length = GetDecoderLength(decoder);
+	ma_decoder_uninit(&decoder);
 }
 
 #pragma region Scripting Bindings
@@ -38,11 +126,29 @@ ADD_MANAGED_METHOD(AudioData, Load, void, (MonoString* path, unsigned long long*
 
 ADD_MANAGED_METHOD(AudioData, Import, void, (void* instance, MonoArray* audioDataRaw))
 {
-	vector<unsigned char> audioData;
-	audioData.resize(mono_array_length(audioDataRaw));
-	for (size_t i = 0; i < audioData.size(); i++)
-		audioData[i] = mono_array_get(audioDataRaw, unsigned char, i);
-
+	IO::ByteSpan audioData(mono_array_addr(audioDataRaw, unsigned char, 0), mono_array_length(audioDataRaw));
 	((AudioData*)instance)->Import(audioData);
 }
+
+ADD_MANAGED_METHOD(AudioData, ImportStream, void, (void* instance, MonoString* pathRaw))
+{
+	char* path = mono_string_to_utf8(pathRaw);
+	((AudioData*)instance)->ImportStream(path);
+	mono_free(path);
+}
+
+ADD_MANAGED_METHOD(AudioData, ImportPackStream, void, (void* instance, MonoString* packPathRaw, MonoString* pathRaw))
+{
+	char* packPath = mono_string_to_utf8(packPathRaw);
+	char* path = mono_string_to_utf8(pathRaw);
+	((AudioData*)instance)->ImportPackStream(packPath, path);
+	mono_free(packPath);
+	mono_free(path);
+}
+
+ADD_MANAGED_METHOD(AudioData, IsStreaming, bool, (void* instance))
+{ return ((AudioData*)instance)->IsStreaming(); }
+
+ADD_MANAGED_METHOD(AudioData, GetLength, float, (void* instance))
+{ return ((AudioData*)instance)->GetLength(); }
 #pragma endregion
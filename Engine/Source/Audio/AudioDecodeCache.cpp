@@ -0,0 +1,134 @@
+#include <spdlog/spdlog.h>
+#include <Yonai/Audio/AudioDecodeCache.hpp>
+
+using namespace std;
+using namespace Yonai;
+
+AudioDecodeCache::AudioDecodeCache(size_t budget, float maxClipLength, ma_format format) :
+	m_Entries(), m_Lookup(), m_Budget(budget), m_MemoryUsage(0), m_MaxClipLength(maxClipLength), m_Format(format),
+	m_Hits(0), m_Misses(0), m_Evictions(0) { }
+
+/// <summary>
+/// Decodes an entire clip, at its native channel count and sample rate
+/// </summary>
+/// <returns>Decoded clip, or nullptr if invalid, too long, or larger than maxBytes</returns>
+static shared_ptr<AudioDecodedClip> Decode(IO::ByteSpan encoded, ma_format format, float maxLength, size_t maxBytes)
+{
+	ma_decoder decoder;
+	ma_decoder_config config = ma_decoder_config_init(format, 0, 0);
+	if (encoded.size() == 0 || ma_decoder_init_memory(encoded.data(), encoded.size(), &config, &decoder) != MA_SUCCESS)
+		return nullptr;
+
+	shared_ptr<AudioDecodedClip> clip = make_shared<AudioDecodedClip>();
+	clip->Format = format;
+	ma_decoder_get_data_format(&decoder, nullptr, &clip->Channels, &clip->SampleRate, nullptr, 0);
+
+	ma_uint64 length = 0;
+	ma_decoder_get_length_in_pcm_frames(&decoder, &length);
+	const size_t frameSize = (size_t)ma_get_bytes_per_frame(format, clip->Channels);
+	if (length == 0 || clip->SampleRate == 0 || frameSize == 0 ||
+		length / (float)clip->SampleRate > maxLength ||
+		length * frameSize > maxBytes)
+	{
+		ma_decoder_uninit(&decoder);
+		return nullptr;
+	}
+
+	clip->Frames.resize((size_t)(length * frameSize));
+	ma_decoder_read_pcm_frames(&decoder, clip->Frames.data(), length, &clip->FrameCount);
+	ma_decoder_uninit(&decoder);
+
+	// Length can be an estimate for some formats
+	clip->Frames.resize((size_t)(clip->FrameCount * frameSize));
+	clip->Frames.shrink_to_fit();
+	return clip->FrameCount > 0 ? clip : nullptr;
+}
+
+shared_ptr<AudioDecodedClip> AudioDecodeCache::Get(const void* key, IO::ByteSpan encoded)
+{
+	auto it = m_Lookup.find(key);
+	if (it != m_Lookup.end())
+	{
+		m_Hits++;
+		m_Entries.splice(m_Entries.begin(), m_Entries, it->second);
+		return it->second->Clip;
+	}
+
+	m_Misses++;
+	if (m_Budget == 0)
+		return nullptr;
+
+	shared_ptr<AudioDecodedClip> clip = Decode(encoded, m_Format, m_MaxClipLength, m_Budget);
+	if (!clip)
+		return nullptr;
+
+	Trim(m_Budget - clip->Frames.size());
+
+	m_Entries.push_front({ key, clip });
+	m_Lookup[key] = m_Entries.begin();
+	m_MemoryUsage += clip->Frames.size();
+	return clip;
+}
+
+void AudioDecodeCache::Trim(size_t budget)
+{
+	while (m_MemoryUsage > budget && !m_Entries.empty())
+	{
+		Entry& entry = m_Entries.back();
+		m_MemoryUsage -= entry.Clip->Frames.size();
+		m_Lookup.erase(entry.Key);
+		m_Entries.pop_back();
+		m_Evictions++;
+	}
+}
+
+bool AudioDecodeCache::Contains(const void* key) { return m_Lookup.find(key) != m_Lookup.end(); }
+
+void AudioDecodeCache::Remove(const void* key)
+{
+	auto it = m_Lookup.find(key);
+	if (it == m_Lookup.end())
+		return;
+
+	m_MemoryUsage -= it->second->Clip->Frames.size();
+	m_Entries.erase(it->second);
+	m_Lookup.erase(it);
+}
+
+void AudioDecodeCache::Clear()
+{
+	m_Entries.clear();
+	m_Lookup.clear();
+	m_MemoryUsage = 0;
+}
+
+size_t AudioDecodeCache::GetBudget() { return m_Budget; }
+void AudioDecodeCache::SetBudget(size_t bytes)
+{
+	m_Budget = bytes;
+	Trim(m_Budget);
+}
+
+float AudioDecodeCache::GetMaxClipLength() { return m_MaxClipLength; }
+void AudioDecodeCache::SetMaxClipLength(float seconds) { m_MaxClipLength = seconds; }
+
+ma_format AudioDecodeCache::GetFormat() { return m_Format; }
+void AudioDecodeCache::SetFormat(ma_format format)
+{
+	if (format != ma_format_s16 && format != ma_format_f32)
+	{
+		spdlog::warn("Decoded audio can only be cached as 16-bit or 32-bit float");
+		return;
+	}
+
+	if (format != m_Format)
+		Clear();
+	m_Format = format;
+}
+
+size_t AudioDecodeCache::GetMemoryUsage() { return m_MemoryUsage; }
+unsigned int AudioDecodeCache::GetCount() { return (unsigned int)m_Entries.size(); }
+unsigned int AudioDecodeCache::GetHits() { return m_Hits; }
+unsigned int AudioDecodeCache::GetMisses() { return m_Misses; }
+unsigned int AudioDecodeCache::GetEvictions() { return m_Evictions; }
+void AudioDecodeCache::ResetStats() { m_Hits = m_Misses = m_Evictions = 0; }
@@ -0,0 +1,155 @@
+#include <cstring>
+#include <algorithm>
+#include <spdlog/spdlog.h>
+#include <Yonai/Audio/AudioEffect.hpp>
+#include <Yonai/Audio/AudioEffects.hpp>
+
+#if YONAI_AUDIO_SSE
+#include <xmmintrin.h>
+#endif
+
+using namespace std;
+using namespace Yonai;
+
+// Effects keep processing without input, so filters and reverb can ring out after their sources stop
+ma_node_vtable AudioEffect::s_VTable = { OnProcess, nullptr, 1, 1, MA_NODE_FLAG_CONTINUOUS_PROCESSING };
+
+AudioEffect::AudioEffect(ma_engine* engine, AudioEffectType type, const AudioEffectParameter* parameters, unsigned int parameterCount) :
+	m_Node(), m_Type(type), m_Valid(false), m_Enabled(true), m_ParameterInfo(parameters), m_Parameters(parameterCount),
+	m_Channels(ma_engine_get_channels(engine)), m_SampleRate(ma_engine_get_sample_rate(engine))
+{
+	m_Node.Effect = this;
+	for (unsigned int i = 0; i < parameterCount; i++)
+		m_Parameters[i].store(parameters[i].Default);
+
+	ma_node_config config = ma_node_config_init();
+	config.vtable = &s_VTable;
+	config.pInputChannels = &m_Channels;
+	config.pOutputChannels = &m_Channels;
+
+	ma_result result = ma_node_init(ma_engine_get_node_graph(engine), &config, nullptr, &m_Node.Base);
+	if (result != MA_SUCCESS)
+	{
+		spdlog::error("Failed to create audio effect [{}]", (int)result);
+		return;
+	}
+	m_Valid = true;
+}
+
+AudioEffect::~AudioEffect() { ReleaseNode(); }
+
+void AudioEffect::ReleaseNode()
+{
+	if (!m_Valid)
+		return;
+
+	ma_node_uninit(&m_Node.Base, nullptr);
+	m_Valid = false;
+}
+
+AudioEffect* AudioEffect::Create(AudioEffectType type, ma_engine* engine)
+{
+	AudioEffect* effect = nullptr;
+	switch (type)
+	{
+	case AudioEffectType::LowPass:
+	case AudioEffectType::HighPass:		effect = new FilterEffect(engine, type); break;
+	case AudioEffectType::Compressor:	effect = new CompressorEffect(engine); break;
+	case AudioEffectType::Limiter:		effect = new LimiterEffect(engine); break;
+	case AudioEffectType::Reverb:		effect = new ReverbEffect(engine); break;
+	case AudioEffectType::Ducking:		effect = new DuckingEffect(engine); break;
+	case AudioEffectType::Meter:		effect = new MeterEffect(engine); break;
+	default:
+		spdlog::warn("Unknown audio effect type {}", (unsigned int)type);
+		return nullptr;
+	}
+
+	if (!effect->IsValid())
+	{
+		delete effect;
+		return nullptr;
+	}
+	return effect;
+}
+
+void AudioEffect::OnProcess(ma_node* node, const float** framesIn, ma_uint32* frameCountIn, float** framesOut, ma_uint32* frameCountOut)
+{
+	AudioEffect* effect = ((AudioEffectNode*)node)->Effect;
+	const ma_uint32 frameCount = *frameCountOut;
+	float* output = framesOut[0];
+
+	// No input is treated as silence
+	const float* input = framesIn ? framesIn[0] : nullptr;
+	if (!input)
+	{
+		memset(output, 0, (size_t)frameCount * effect->m_Channels * sizeof(float));
+		input = output;
+	}
+
+#if YONAI_AUDIO_SSE
+	// Flush denormals to zero, which are otherwise very slow while filters and reverb decay in to silence
+	const unsigned int controlState = _mm_getcsr();
+	_mm_setcsr(controlState | 0x8040);
+#endif
+
+	if (effect->m_Enabled.load(memory_order_relaxed))
+		effect->Process(input, output, frameCount);
+	else if (input != output)
+		memcpy(output, input, (size_t)frameCount * effect->m_Channels * sizeof(float));
+
+#if YONAI_AUDIO_SSE
+	_mm_setcsr(controlState);
+#endif
+}
+
+bool AudioEffect::IsValid() { return m_Valid; }
+ma_node* AudioEffect::GetNode() { return &m_Node.Base; }
+AudioEffectType AudioEffect::GetType() { return m_Type; }
+bool AudioEffect::IsEnabled() { return m_Enabled; }
+void AudioEffect::SetEnabled(bool enabled) { m_Enabled = enabled; }
+unsigned int AudioEffect::GetParameterCount() { return (unsigned int)m_Parameters.size(); }
+const AudioEffectParameter& AudioEffect::GetParameterInfo(unsigned int index) { return m_ParameterInfo[(std::min)(index, GetParameterCount() - 1)]; }
+
+float AudioEffect::GetParameter(unsigned int index)
+{
+	return index < m_Parameters.size() ? m_Parameters[index].load(memory_order_relaxed) : 0.0f;
+}
+
+void AudioEffect::SetParameter(unsigned int index, float value)
+{
+	if (index >= m_Parameters.size())
+		return;
+	m_Parameters[index].store(std::clamp(value, m_ParameterInfo[index].Min, m_ParameterInfo[index].Max), memory_order_relaxed);
+}
+
+#pragma region Scripting Bindings
+#include <Yonai/Resource.hpp>
+#include <Yonai/Audio/AudioMixer.hpp>
+#include <Yonai/Scripting/InternalCalls.hpp>
+
+ADD_MANAGED_METHOD(AudioEffect, IsEnabled, bool, (void* handle))
+{ return ((AudioEffect*)handle)->IsEnabled(); }
+
+ADD_MANAGED_METHOD(AudioEffect, SetEnabled, void, (void* handle, bool value))
+{ ((AudioEffect*)handle)->SetEnabled(value); }
+
+ADD_MANAGED_METHOD(AudioEffect, GetParameterCount, unsigned int, (void* handle))
+{ return ((AudioEffect*)handle)->GetParameterCount(); }
+
+ADD_MANAGED_METHOD(AudioEffect, GetParameter, float, (void* handle, unsigned int index))
+{ return ((AudioEffect*)handle)->GetParameter(index); }
+
+ADD_MANAGED_METHOD(AudioEffect, SetParameter, void, (void* handle, unsigned int index, float value))
+{ ((AudioEffect*)handle)->SetParameter(index, value); }
+
+ADD_MANAGED_METHOD(AudioEffect, SetSidechain, void, (void* handle, uint64_t mixerID))
+{
+	AudioEffect* effect = (AudioEffect*)handle;
+	if (effect->GetType() != AudioEffectType::Ducking)
+		return;
+
+	AudioMixer* mixer = Resource::IsValidType<AudioMixer>(mixerID) ? Resource::Get<AudioMixer>(mixerID) : nullptr;
+	MeterEffect* meter = mixer ? mixer->GetMeter() : nullptr;
+	((DuckingEffect*)effect)->SetSidechain(meter ? meter->GetSharedLevel() : nullptr);
+}
+#pragma endregion
@@ -0,0 +1,362 @@
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <Yonai/Audio/AudioEffects.hpp>
+
+#if YONAI_AUDIO_SSE
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+using namespace Yonai;
+using namespace Yonai::AudioKernels;
+
+#pragma region Parameters
+static const AudioEffectParameter LowPassParameters[] =
+{
+	{ "Cutoff", 10.0f, 22000.0f, 1000.0f },
+	{ "Resonance", 0.1f, 10.0f, 0.7071f }
+};
+
+static const AudioEffectParameter HighPassParameters[] =
+{
+	{ "Cutoff", 10.0f, 22000.0f, 500.0f },
+	{ "Resonance", 0.1f, 10.0f, 0.7071f }
+};
+
+static const AudioEffectParameter CompressorParameters[] =
+{
+	{ "Threshold", -60.0f, 0.0f, -18.0f },
+	{ "Ratio", 1.0f, 20.0f, 4.0f },
+	{ "Attack", 0.1f, 200.0f, 10.0f },
+	{ "Release", 1.0f, 2000.0f, 100.0f },
+	{ "MakeupGain", 0.0f, 24.0f, 0.0f }
+};
+
+static const AudioEffectParameter LimiterParameters[] =
+{
+	{ "Threshold", -30.0f, 0.0f, -1.0f },
+	{ "Release", 1.0f, 1000.0f, 50.0f }
+};
+
+static const AudioEffectParameter ReverbParameters[] =
+{
+	{ "RoomSize", 0.0f, 1.0f, 0.5f },
+	{ "Damping", 0.0f, 1.0f, 0.5f },
+	{ "Wet", 0.0f, 1.0f, 0.33f },
+	{ "Dry", 0.0f, 1.0f, 1.0f },
+	{ "Width", 0.0f, 1.0f, 1.0f }
+};
+
+static const AudioEffectParameter DuckingParameters[] =
+{
+	{ "Threshold", -60.0f, 0.0f, -30.0f },
+	{ "Amount", 0.0f, 40.0f, 12.0f },
+	{ "Attack", 1.0f, 500.0f, 20.0f },
+	{ "Release", 10.0f, 5000.0f, 300.0f }
+};
+
+static const AudioEffectParameter MeterParameters[] =
+{
+	{ "Release", 1.0f, 2000.0f, 100.0f }
+};
+
+#define PARAMETER_COUNT(parameters) (unsigned int)(sizeof(parameters) / sizeof(AudioEffectParameter))
+
+const AudioEffectParameter* AudioEffect::GetParameterInfo(AudioEffectType type, unsigned int* count)
+{
+	const AudioEffectParameter* parameters = nullptr;
+	unsigned int parameterCount = 0;
+	switch (type)
+	{
+	case AudioEffectType::LowPass:		parameters = LowPassParameters;		parameterCount = PARAMETER_COUNT(LowPassParameters); break;
+	case AudioEffectType::HighPass:		parameters = HighPassParameters;	parameterCount = PARAMETER_COUNT(HighPassParameters); break;
+	case AudioEffectType::Compressor:	parameters = CompressorParameters;	parameterCount = PARAMETER_COUNT(CompressorParameters); break;
+	case AudioEffectType::Limiter:		parameters = LimiterParameters;		parameterCount = PARAMETER_COUNT(LimiterParameters); break;
+	case AudioEffectType::Reverb:		parameters = ReverbParameters;		parameterCount = PARAMETER_COUNT(ReverbParameters); break;
+	case AudioEffectType::Ducking:		parameters = DuckingParameters;		parameterCount = PARAMETER_COUNT(DuckingParameters); break;
+	case AudioEffectType::Meter:		parameters = MeterParameters;		parameterCount = PARAMETER_COUNT(MeterParameters); break;
+	default: break;
+	}
+
+	if (count)
+		*count = parameterCount;
+	return parameters;
+}
+#pragma endregion
+
+static float DecibelsToGain(float decibels) { return powf(10.0f, decibels / 20.0f); }
+
+/// <returns>Smoothing coefficient, reaching ~63% of a change after milliseconds</returns>
+static float GetSmoothing(float milliseconds, ma_uint32 sampleRate)
+{
+	if (milliseconds <= 0.0f)
+		return 0.0f;
+	return expf(-1.0f / (milliseconds * 0.001f * sampleRate));
+}
+
+#pragma region Filter
+static const AudioEffectParameter* GetFilterParameters(AudioEffectType type)
+{
+	return type == AudioEffectType::HighPass ? HighPassParameters : LowPassParameters;
+}
+
+FilterEffect::FilterEffect(ma_engine* engine, AudioEffectType type) :
+	AudioEffect(engine, type, GetFilterParameters(type), PARAMETER_COUNT(LowPassParameters)), m_Cutoff(0), m_Resonance(0)
+{
+	m_State.resize((size_t)m_Channels * 2, 0.0f);
+}
+
+void FilterEffect::Process(const float* input, float* output, ma_uint32 frameCount)
+{
+	float cutoff = GetParameter(Cutoff);
+	float resonance = GetParameter(Resonance);
+	if (cutoff != m_Cutoff || resonance != m_Resonance)
+	{
+		m_Cutoff = cutoff;
+		m_Resonance = resonance;
+		m_Coefficients = GetType() == AudioEffectType::HighPass ?
+			HighPass(m_SampleRate, cutoff, resonance) :
+			LowPass(m_SampleRate, cutoff, resonance);
+	}
+
+	Biquad(input, output, frameCount, m_Channels, m_Coefficients, m_State.data());
+}
+#pragma endregion
+
+#pragma region Compressor
+CompressorEffect::CompressorEffect(ma_engine* engine) :
+	CompressorEffect(engine, AudioEffectType::Compressor, CompressorParameters, PARAMETER_COUNT(CompressorParameters)) { }
+
+CompressorEffect::CompressorEffect(ma_engine* engine, AudioEffectType type, const AudioEffectParameter* parameters, unsigned int parameterCount) :
+	AudioEffect(engine, type, parameters, parameterCount) { }
+
+void CompressorEffect::Process(const float* input, float* output, ma_uint32 frameCount)
+{
+	Compress(input, output, frameCount,
+		GetParameter(Threshold),
+		1.0f / GetParameter(Ratio) - 1.0f,
+		GetParameter(Attack),
+		GetParameter(Release),
+		GetParameter(MakeupGain));
+}
+
+void CompressorEffect::Compress(const float* input, float* output, ma_uint32 frameCount, float thresholdDb, float slope, float attackMs, float releaseMs, float makeupDb)
+{
+	const float threshold = DecibelsToGain(thresholdDb);
+	const float inverseThreshold = 1.0f / threshold;
+	const float makeup = DecibelsToGain(makeupDb);
+	const float attack = GetSmoothing(attackMs, m_SampleRate);
+	const float release = GetSmoothing(releaseMs, m_SampleRate);
+
+	for (ma_uint32 offset = 0; offset < frameCount; offset += BlockFrames)
+	{
+		const ma_uint32 count = (std::min)(BlockFrames, frameCount - offset);
+		const size_t sampleOffset = (size_t)offset * m_Channels;
+		PeakPerFrame(input + sampleOffset, m_Peaks, count, m_Channels);
+
+		// Envelope follows the loudest channel, so every channel is reduced equally
+		for (ma_uint32 i = 0; i < count; i++)
+		{
+			float peak = m_Peaks[i];
+			float smoothing = peak > m_Envelope ? attack : release;
+			m_Envelope = peak + (m_Envelope - peak) * smoothing;
+
+			m_Gains[i] = makeup;
+			if (m_Envelope > threshold)
+				m_Gains[i] *= powf(m_Envelope * inverseThreshold, slope);
+		}
+
+		GainPerFrame(input + sampleOffset, output + sampleOffset, m_Gains, count, m_Channels);
+	}
+}
+
+LimiterEffect::LimiterEffect(ma_engine* engine) :
+	CompressorEffect(engine, AudioEffectType::Limiter, LimiterParameters, PARAMETER_COUNT(LimiterParameters)) { }
+
+void LimiterEffect::Process(const float* input, float* output, ma_uint32 frameCount)
+{
+	// Infinite ratio, instant attack
+	Compress(input, output, frameCount, GetParameter(Threshold), -1.0f, 0.0f, GetParameter(Release), 0.0f);
+}
+#pragma endregion
+
+#pragma region Reverb
+// Freeverb's tunings, in frames at 44.1kHz
+static const unsigned int CombLengths[] = { 1116, 1188, 1277, 1356 };
+static const unsigned int AllPassLengths[] = { 556, 441 };
+static const unsigned int StereoSpread = 23;
+
+static const float ReverbInputGain = 0.015f;
+static const float ReverbWetScale = 3.0f;
+static const float RoomScale = 0.28f;
+static const float RoomOffset = 0.7f;
+static const float DampingScale = 0.4f;
+static const float AllPassFeedback = 0.5f;
+
+ReverbEffect::ReverbEffect(ma_engine* engine) : AudioEffect(engine, AudioEffectType::Reverb, ReverbParameters, PARAMETER_COUNT(ReverbParameters))
+{
+	const float scale = m_SampleRate / 44100.0f;
+	for (unsigned int i = 0; i < CombCount; i++)
+	{
+		unsigned int length = CombLengths[i % 4] + (i >= 4 ? StereoSpread : 0);
+		m_Combs[i].resize((std::max)(1u, (unsigned int)(length * scale)), 0.0f);
+	}
+	for (unsigned int i = 0; i < AllPassCount; i++)
+	{
+		unsigned int length = AllPassLengths[i % 2] + (i >= 2 ? StereoSpread : 0);
+		m_AllPasses[i].resize((std::max)(1u, (unsigned int)(length * scale)), 0.0f);
+	}
+}
+
+void ReverbEffect::Process(const float* input, float* output, ma_uint32 frameCount)
+{
+	const float feedback = GetParameter(RoomSize) * RoomScale + RoomOffset;
+	const float damping = GetParameter(Damping) * DampingScale;
+	const float wet = GetParameter(Wet) * ReverbWetScale;
+	const float dry = GetParameter(Dry);
+	const float width = GetParameter(Width);
+	const float wetSame = wet * (width / 2.0f + 0.5f);
+	const float wetOther = wet * ((1.0f - width) / 2.0f);
+	const float inputGain = ReverbInputGain * 2.0f / m_Channels;
+
+#if YONAI_AUDIO_SSE
+	const __m128 feedbacks = _mm_set1_ps(feedback);
+	const __m128 damp1 = _mm_set1_ps(damping), damp2 = _mm_set1_ps(1.0f - damping);
+	__m128 filterLeft = _mm_load_ps(m_CombFilter), filterRight = _mm_load_ps(m_CombFilter + 4);
+#endif
+
+	for (ma_uint32 i = 0; i < frameCount; i++)
+	{
+		const float* frame = input + (size_t)i * m_Channels;
+		float mono = 0.0f;
+		for (ma_uint32 channel = 0; channel < m_Channels; channel++)
+			mono += frame[channel];
+		mono *= inputGain;
+
+		// Parallel comb filters
+		alignas(16) float combOutput[CombCount];
+		for (unsigned int c = 0; c < CombCount; c++)
+			combOutput[c] = m_Combs[c][m_CombIndex[c]];
+
+		alignas(16) float combInput[CombCount];
+#if YONAI_AUDIO_SSE
+		const __m128 in = _mm_set1_ps(mono);
+		__m128 outLeft = _mm_load_ps(combOutput), outRight = _mm_load_ps(combOutput + 4);
+		filterLeft = _mm_add_ps(_mm_mul_ps(outLeft, damp2), _mm_mul_ps(filterLeft, damp1));
+		filterRight = _mm_add_ps(_mm_mul_ps(outRight, damp2), _mm_mul_ps(filterRight, damp1));
+		_mm_store_ps(combInput, _mm_add_ps(in, _mm_mul_ps(filterLeft, feedbacks)));
+		_mm_store_ps(combInput + 4, _mm_add_ps(in, _mm_mul_ps(filterRight, feedbacks)));
+#else
+		for (unsigned int c = 0; c < CombCount; c++)
+		{
+			m_CombFilter[c] = combOutput[c] * (1.0f - damping) + m_CombFilter[c] * damping;
+			combInput[c] = mono + m_CombFilter[c] * feedback;
+		}
+#endif
+
+		float left = 0.0f, right = 0.0f;
+		for (unsigned int c = 0; c < CombCount; c++)
+		{
+			m_Combs[c][m_CombIndex[c]] = combInput[c];
+			if (++m_CombIndex[c] >= m_Combs[c].size())
+				m_CombIndex[c] = 0;
+			(c < 4 ? left : right) += combOutput[c];
+		}
+
+		// Series all-pass filters
+		for (unsigned int a = 0; a < AllPassCount; a++)
+		{
+			float& value = a < 2 ? left : right;
+			float& buffered = m_AllPasses[a][m_AllPassIndex[a]];
+			float result = buffered - value;
+			buffered = value + buffered * AllPassFeedback;
+			value = result;
+			if (++m_AllPassIndex[a] >= m_AllPasses[a].size())
+				m_AllPassIndex[a] = 0;
+		}
+
+		float* out = output + (size_t)i * m_Channels;
+		if (m_Channels == 2)
+		{
+			float inLeft = frame[0], inRight = frame[1];
+			out[0] = left * wetSame + right * wetOther + inLeft * dry;
+			out[1] = right * wetSame + left * wetOther + inRight * dry;
+		}
+		else
+		{
+			float reverb = (left + right) * 0.5f * wet;
+			for (ma_uint32 channel = 0; channel < m_Channels; channel++)
+				out[channel] = frame[channel] * dry + reverb;
+		}
+	}
+
+#if YONAI_AUDIO_SSE
+	_mm_store_ps(m_CombFilter, filterLeft);
+	_mm_store_ps(m_CombFilter + 4, filterRight);
+#endif
+}
+#pragma endregion
+
+#pragma region Meter
+MeterEffect::MeterEffect(ma_engine* engine) :
+	AudioEffect(engine, AudioEffectType::Meter, MeterParameters, PARAMETER_COUNT(MeterParameters)), m_Level(make_shared<atomic<float>>(0.0f)) { }
+
+void MeterEffect::Process(const float* input, float* output, ma_uint32 frameCount)
+{
+	const size_t sampleCount = (size_t)frameCount * m_Channels;
+	if (input != output)
+		memcpy(output, input, sampleCount * sizeof(float));
+
+	// Falls by the release coefficient for every frame in the block
+	float decay = powf(GetSmoothing(GetParameter(Release), m_SampleRate), (float)frameCount);
+	float level = (std::max)(Peak(input, sampleCount), m_Level->load(memory_order_relaxed) * decay);
+	m_Level->store(level, memory_order_relaxed);
+}
+
+float MeterEffect::GetLevel() { return m_Level->load(memory_order_relaxed); }
+shared_ptr<atomic<float>> MeterEffect::GetSharedLevel() { return m_Level; }
+#pragma endregion
+
+#pragma region Ducking
+DuckingEffect::DuckingEffect(ma_engine* engine) :
+	AudioEffect(engine, AudioEffectType::Ducking, DuckingParameters, PARAMETER_COUNT(DuckingParameters)), m_SidechainLevel(nullptr), m_ProcessedBlocks(0), m_Gain(1.0f) { }
+
+void DuckingEffect::Process(const float* input, float* output, ma_uint32 frameCount)
+{
+	// Sequentially consistent with SetSidechain, so a retired sidechain is not loaded after the count it was retired at
+	atomic<float>* sidechain = m_SidechainLevel.load();
+	float level = sidechain ? sidechain->load(memory_order_relaxed) : 0.0f;
+	float target = level > DecibelsToGain(GetParameter(Threshold)) ? DecibelsToGain(-GetParameter(Amount)) : 1.0f;
+
+	float gain = m_Gain.load(memory_order_relaxed);
+	const float smoothing = GetSmoothing(GetParameter(target < gain ? Attack : Release), m_SampleRate);
+	for (ma_uint32 offset = 0; offset < frameCount; offset += BlockFrames)
+	{
+		const ma_uint32 count = (std::min)(BlockFrames, frameCount - offset);
+		for (ma_uint32 i = 0; i < count; i++)
+			m_Gains[i] = gain = target + (gain - target) * smoothing;
+
+		const size_t sampleOffset = (size_t)offset * m_Channels;
+		GainPerFrame(input + sampleOffset, output + sampleOffset, m_Gains, count, m_Channels);
+	}
+	m_Gain.store(gain, memory_order_relaxed);
+	m_ProcessedBlocks.fetch_add(1);
+}
+
+void DuckingEffect::SetSidechain(shared_ptr<atomic<float>> level)
+{
+	shared_ptr<atomic<float>> previous = m_Sidechain;
+	m_Sidechain = level;
+	m_SidechainLevel.store(m_Sidechain.get());
+
+	// Blocks are processed one at a time, once the count changes any block that loaded a retired sidechain has finished
+	uint64_t processed = m_ProcessedBlocks.load();
+	m_RetiredSidechains.erase(remove_if(m_RetiredSidechains.begin(), m_RetiredSidechains.end(),
+		[=](const auto& retired) { return retired.second != processed; }), m_RetiredSidechains.end());
+	if (previous)
+		m_RetiredSidechains.emplace_back(previous, processed);
+}
+
+float DuckingEffect::GetGain() { return m_Gain.load(memory_order_relaxed); }
+#pragma endregion
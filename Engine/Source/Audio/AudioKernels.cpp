@@ -0,0 +1,217 @@
+#include <cmath>
+#include <algorithm>
+#include <Yonai/Audio/AudioKernels.hpp>
+
+#if YONAI_AUDIO_SSE
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+using namespace Yonai;
+using namespace Yonai::AudioKernels;
+
+static const float Pi = 3.14159265358979f;
+
+#if YONAI_AUDIO_SSE
+/// <summary>
+/// Clears the sign bit of each lane
+/// </summary>
+static inline __m128 Abs(__m128 value) { return _mm_and_ps(value, _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF))); }
+
+/// <summary>
+/// Loads two floats in to the lower lanes
+/// </summary>
+static inline __m128 LoadPair(const float* values) { return _mm_loadl_pi(_mm_setzero_ps(), (const __m64*)values); }
+static inline void StorePair(float* values, __m128 value) { _mm_storel_pi((__m64*)values, value); }
+#endif
+
+/// <summary>
+/// Cutoff is kept below the Nyquist frequency, where the filter is unstable
+/// </summary>
+static void GetFilterTerms(ma_uint32 sampleRate, float cutoff, float q, float& cosine, float& alpha)
+{
+	cutoff = std::clamp(cutoff, 1.0f, sampleRate * 0.49f);
+	float omega = 2.0f * Pi * cutoff / sampleRate;
+	cosine = cosf(omega);
+	alpha = sinf(omega) / (2.0f * (std::max)(q, 0.01f));
+}
+
+static BiquadCoefficients Normalise(float b0, float b1, float b2, float a0, float a1, float a2)
+{
+	BiquadCoefficients coefficients;
+	coefficients.B0 = b0 / a0;
+	coefficients.B1 = b1 / a0;
+	coefficients.B2 = b2 / a0;
+	coefficients.A1 = a1 / a0;
+	coefficients.A2 = a2 / a0;
+	return coefficients;
+}
+
+BiquadCoefficients AudioKernels::LowPass(ma_uint32 sampleRate, float cutoff, float q)
+{
+	float cosine, alpha;
+	GetFilterTerms(sampleRate, cutoff, q, cosine, alpha);
+	return Normalise((1.0f - cosine) / 2.0f, 1.0f - cosine, (1.0f - cosine) / 2.0f, 1.0f + alpha, -2.0f * cosine, 1.0f - alpha);
+}
+
+BiquadCoefficients AudioKernels::HighPass(ma_uint32 sampleRate, float cutoff, float q)
+{
+	float cosine, alpha;
+	GetFilterTerms(sampleRate, cutoff, q, cosine, alpha);
+	return Normalise((1.0f + cosine) / 2.0f, -(1.0f + cosine), (1.0f + cosine) / 2.0f, 1.0f + alpha, -2.0f * cosine, 1.0f - alpha);
+}
+
+static void BiquadChannel(const float* input, float* output, ma_uint32 frameCount, ma_uint32 channels, const BiquadCoefficients& c, float& z1, float& z2)
+{
+	for (ma_uint32 i = 0; i < frameCount; i++)
+	{
+		float x = input[i * channels];
+		float y = c.B0 * x + z1;
+		z1 = c.B1 * x - c.A1 * y + z2;
+		z2 = c.B2 * x - c.A2 * y;
+		output[i * channels] = y;
+	}
+}
+
+void AudioKernels::Biquad(const float* input, float* output, ma_uint32 frameCount, ma_uint32 channels, const BiquadCoefficients& c, float* state)
+{
+	float* z1 = state;
+	float* z2 = state + channels;
+	ma_uint32 channel = 0;
+
+#if YONAI_AUDIO_SSE
+	const __m128 b0 = _mm_set1_ps(c.B0), b1 = _mm_set1_ps(c.B1), b2 = _mm_set1_ps(c.B2);
+	const __m128 a1 = _mm_set1_ps(c.A1), a2 = _mm_set1_ps(c.A2);
+
+	// Four channels at a time, each in their own lane
+	for (; channel + 4 <= channels; channel += 4)
+	{
+		__m128 s1 = _mm_loadu_ps(z1 + channel), s2 = _mm_loadu_ps(z2 + channel);
+		for (ma_uint32 i = 0; i < frameCount; i++)
+		{
+			__m128 x = _mm_loadu_ps(input + i * channels + channel);
+			__m128 y = _mm_add_ps(_mm_mul_ps(b0, x), s1);
+			s1 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(b1, x), _mm_mul_ps(a1, y)), s2);
+			s2 = _mm_sub_ps(_mm_mul_ps(b2, x), _mm_mul_ps(a2, y));
+			_mm_storeu_ps(output + i * channels + channel, y);
+		}
+		_mm_storeu_ps(z1 + channel, s1);
+		_mm_storeu_ps(z2 + channel, s2);
+	}
+
+	// Remaining pair, such as stereo
+	if (channel + 2 <= channels)
+	{
+		__m128 s1 = LoadPair(z1 + channel), s2 = LoadPair(z2 + channel);
+		for (ma_uint32 i = 0; i < frameCount; i++)
+		{
+			__m128 x = LoadPair(input + i * channels + channel);
+			__m128 y = _mm_add_ps(_mm_mul_ps(b0, x), s1);
+			s1 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(b1, x), _mm_mul_ps(a1, y)), s2);
+			s2 = _mm_sub_ps(_mm_mul_ps(b2, x), _mm_mul_ps(a2, y));
+			StorePair(output + i * channels + channel, y);
+		}
+		StorePair(z1 + channel, s1);
+		StorePair(z2 + channel, s2);
+		channel += 2;
+	}
+#endif
+
+	for (; channel < channels; channel++)
+		BiquadChannel(input + channel, output + channel, frameCount, channels, c, z1[channel], z2[channel]);
+}
+
+void AudioKernels::Gain(float* samples, size_t count, float gain)
+{
+	size_t i = 0;
+#if YONAI_AUDIO_SSE
+	const __m128 g = _mm_set1_ps(gain);
+	for (; i + 4 <= count; i += 4)
+		_mm_storeu_ps(samples + i, _mm_mul_ps(_mm_loadu_ps(samples + i), g));
+#endif
+	for (; i < count; i++)
+		samples[i] *= gain;
+}
+
+void AudioKernels::MixInto(float* output, const float* input, size_t count, float gain)
+{
+	size_t i = 0;
+#if YONAI_AUDIO_SSE
+	const __m128 g = _mm_set1_ps(gain);
+	for (; i + 4 <= count; i += 4)
+		_mm_storeu_ps(output + i, _mm_add_ps(_mm_loadu_ps(output + i), _mm_mul_ps(_mm_loadu_ps(input + i), g)));
+#endif
+	for (; i < count; i++)
+		output[i] += input[i] * gain;
+}
+
+float AudioKernels::Peak(const float* samples, size_t count)
+{
+	float peak = 0.0f;
+	size_t i = 0;
+#if YONAI_AUDIO_SSE
+	__m128 peaks = _mm_setzero_ps();
+	for (; i + 4 <= count; i += 4)
+		peaks = _mm_max_ps(peaks, Abs(_mm_loadu_ps(samples + i)));
+
+	alignas(16) float lanes[4];
+	_mm_store_ps(lanes, peaks);
+	peak = (std::max)((std::max)(lanes[0], lanes[1]), (std::max)(lanes[2], lanes[3]));
+#endif
+	for (; i < count; i++)
+		peak = (std::max)(peak, fabsf(samples[i]));
+	return peak;
+}
+
+void AudioKernels::PeakPerFrame(const float* input, float* peaks, ma_uint32 frameCount, ma_uint32 channels)
+{
+	ma_uint32 i = 0;
+#if YONAI_AUDIO_SSE
+	if (channels == 1)
+	{
+		for (; i + 4 <= frameCount; i += 4)
+			_mm_storeu_ps(peaks + i, Abs(_mm_loadu_ps(input + i)));
+	}
+	else if (channels == 2)
+	{
+		// Two frames at a time, [L0 R0 L1 R1]
+		for (; i + 2 <= frameCount; i += 2)
+		{
+			__m128 samples = Abs(_mm_loadu_ps(input + i * 2));
+			__m128 maximum = _mm_max_ps(samples, _mm_shuffle_ps(samples, samples, _MM_SHUFFLE(2, 3, 0, 1)));
+			StorePair(peaks + i, _mm_shuffle_ps(maximum, maximum, _MM_SHUFFLE(2, 0, 2, 0)));
+		}
+	}
+#endif
+	for (; i < frameCount; i++)
+	{
+		float peak = 0.0f;
+		for (ma_uint32 channel = 0; channel < channels; channel++)
+			peak = (std::max)(peak, fabsf(input[i * channels + channel]));
+		peaks[i] = peak;
+	}
+}
+
+void AudioKernels::GainPerFrame(const float* input, float* output, const float* gains, ma_uint32 frameCount, ma_uint32 channels)
+{
+	ma_uint32 i = 0;
+#if YONAI_AUDIO_SSE
+	if (channels == 1)
+	{
+		for (; i + 4 <= frameCount; i += 4)
+			_mm_storeu_ps(output + i, _mm_mul_ps(_mm_loadu_ps(input + i), _mm_loadu_ps(gains + i)));
+	}
+	else if (channels == 2)
+	{
+		// Gains [g0 g1] are spread to [g0 g0 g1 g1]
+		for (; i + 2 <= frameCount; i += 2)
+		{
+			__m128 gain = LoadPair(gains + i);
+			_mm_storeu_ps(output + i * 2, _mm_mul_ps(_mm_loadu_ps(input + i * 2), _mm_unpacklo_ps(gain, gain)));
+		}
+	}
+#endif
+	for (; i < frameCount; i++)
+		for (ma_uint32 channel = 0; channel < channels; channel++)
+			output[i * channels + channel] = input[i * channels + channel] * gains[i];
+}
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <Yonai/Audio/AudioMixer.hpp>
 #include <Yonai/Systems/Global/AudioSystem.hpp>
 
@@ -5,7 +6,7 @@ using namespace std;
 using namespace Yonai;
 using namespace Yonai::Systems;
 
-AudioMixer::AudioMixer(string name, ResourceID parent) : Name(name), m_Volume(1.0f), m_Parent(parent)
+AudioMixer::AudioMixer(string name, ResourceID parent) : Name(name), m_Volume(1.0f), m_Parent(parent), m_Meter(nullptr)
 {
 	ma_sound_group_config config = ma_sound_group_config_init();
 	ma_sound_group_init(AudioSystem::GetEngine(), 0, nullptr, &m_Group);
@@ -14,7 +15,17 @@ AudioMixer::AudioMixer(string name, ResourceID parent) : Name(name), m_Volume(1.
 		SetParent(m_Parent);
 }
 
-AudioMixer::~AudioMixer() { ma_sound_group_uninit(&m_Group); }
+AudioMixer::~AudioMixer()
+{
+	ClearEffects();
+	if (m_Meter)
+	{
+		m_Meter->ReleaseNode();
+		delete m_Meter;
+	}
+
+	ma_sound_group_uninit(&m_Group);
+}
 
 ma_sound_group* AudioMixer::GetHandle() { return &m_Group; }
 
@@ -28,16 +39,86 @@ void AudioMixer::SetVolume(float value)
 void AudioMixer::SetParent(ResourceID parent)
 {
 	m_Parent = parent;
-	ma_node* output = nullptr;
+	ConnectEffects();
+}
+
+ResourceID AudioMixer::GetParent() { return m_Parent; }
+
+ma_node* AudioMixer::GetParentNode()
+{
 	if(m_Parent == InvalidResourceID || !Resource::IsValidType<AudioMixer>(m_Parent)) // Set to output to the engine directly (AKA master)
-		output = ma_engine_get_endpoint(AudioSystem::GetEngine());
-	else
-		output = &(Resource::Get<AudioMixer>(m_Parent)->m_Group);
+		return ma_engine_get_endpoint(AudioSystem::GetEngine());
+	return &(Resource::Get<AudioMixer>(m_Parent)->m_Group);
+}
 
-	ma_node_attach_output_bus(&m_Group, 0, output, 0);
+void AudioMixer::ConnectEffects()
+{
+	ma_node* previous = &m_Group;
+	for (AudioEffect* effect : m_Effects)
+	{
+		ma_node_attach_output_bus(previous, 0, effect->GetNode(), 0);
+		previous = effect->GetNode();
+	}
+
+	if (m_Meter)
+	{
+		ma_node_attach_output_bus(previous, 0, m_Meter->GetNode(), 0);
+		previous = m_Meter->GetNode();
+	}
+
+	ma_node_attach_output_bus(previous, 0, GetParentNode(), 0);
 }
 
-ResourceID AudioMixer::GetParent() { return m_Parent; }
+AudioEffect* AudioMixer::AddEffect(AudioEffectType type)
+{
+	AudioEffect* effect = AudioEffect::Create(type, AudioSystem::GetEngine());
+	if (!effect)
+		return nullptr;
+
+	m_Effects.emplace_back(effect);
+	ConnectEffects();
+	return effect;
+}
+
+void AudioMixer::RemoveEffect(AudioEffect* effect)
+{
+	auto it = find(m_Effects.begin(), m_Effects.end(), effect);
+	if (it == m_Effects.end())
+		return;
+
+	// Reconnected around the effect before it is released, so output is not interrupted
+	m_Effects.erase(it);
+	ConnectEffects();
+
+	effect->ReleaseNode();
+	delete effect;
+}
+
+void AudioMixer::ClearEffects()
+{
+	vector<AudioEffect*> effects;
+	effects.swap(m_Effects);
+	ConnectEffects();
+
+	for (AudioEffect* effect : effects)
+	{
+		effect->ReleaseNode();
+		delete effect;
+	}
+}
+
+unsigned int AudioMixer::GetEffectCount() { return (unsigned int)m_Effects.size(); }
+AudioEffect* AudioMixer::GetEffect(unsigned int index) { return index < m_Effects.size() ? m_Effects[index] : nullptr; }
+
+MeterEffect* AudioMixer::GetMeter()
+{
+	if (!m_Meter)
+	{
+		m_Meter = (MeterEffect*)AudioEffect::Create(AudioEffectType::Meter, AudioSystem::GetEngine());
+		ConnectEffects();
+	}
+	return m_Meter;
+}
 
 #pragma region Scripting Bindings
 #include <Yonai/Resource.hpp>
@@ -72,4 +153,16 @@ ADD_MANAGED_METHOD(AudioMixer, GetParent, uint64_t, (void* handle))
 
 ADD_MANAGED_METHOD(AudioMixer, SetParent, void, (void* handle, uint64_t value))
 { return ((AudioMixer*)handle)->SetParent(value); }
+
+ADD_MANAGED_METHOD(AudioMixer, AddEffect, void*, (void* handle, unsigned int type))
+{ return ((AudioMixer*)handle)->AddEffect((AudioEffectType)type); }
+
+ADD_MANAGED_METHOD(AudioMixer, RemoveEffect, void, (void* handle, void* effect))
+{ ((AudioMixer*)handle)->RemoveEffect((AudioEffect*)effect); }
+
+ADD_MANAGED_METHOD(AudioMixer, GetLevel, float, (void* handle))
+{
+	MeterEffect* meter = ((AudioMixer*)handle)->GetMeter();
+	return meter ? meter->GetLevel() : 0.0f;
+}
 #pragma endregion
\ No newline at end of file
@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <chrono>
+#include <spdlog/spdlog.h>
+#include <Yonai/Audio/AudioRenderer.hpp>
+
+using namespace std;
+using namespace Yonai;
+
+AudioRenderer::AudioRenderer(ma_engine* engine, AudioCommandQueue* commands, ma_uint32 blockFrames) :
+	m_Engine(engine), m_Commands(commands), m_BlockFrames((std::max)(blockFrames, 1u)), m_FramesRendered(0), m_RenderTime(0) { }
+
+ma_uint64 AudioRenderer::RenderBlock(float* output, ma_uint64 frameCount)
+{
+	auto start = chrono::high_resolution_clock::now();
+
+	if (m_Commands)
+		m_Commands->Apply();
+
+	ma_uint64 read = 0;
+	ma_engine_read_pcm_frames(m_Engine, output, frameCount, &read);
+
+	m_RenderTime += chrono::duration<double>(chrono::high_resolution_clock::now() - start).count();
+	m_FramesRendered += read;
+	return read;
+}
+
+ma_uint64 AudioRenderer::Render(float* output, ma_uint64 frameCount)
+{
+	const ma_uint32 channels = GetChannels();
+	ma_uint64 rendered = 0;
+	while (rendered < frameCount)
+	{
+		ma_uint64 read = RenderBlock(output + rendered * channels, (std::min)((ma_uint64)m_BlockFrames, frameCount - rendered));
+		if (read == 0)
+			break;
+		rendered += read;
+	}
+	return rendered;
+}
+
+ma_uint64 AudioRenderer::Render(vector<float>& output, ma_uint64 frameCount)
+{
+	output.resize(frameCount * GetChannels());
+	ma_uint64 rendered = Render(output.data(), frameCount);
+	output.resize(rendered * GetChannels());
+	return rendered;
+}
+
+bool AudioRenderer::RenderToFile(const string& path, ma_uint64 frameCount)
+{
+	ma_encoder encoder;
+	ma_encoder_config config = ma_encoder_config_init(ma_encoding_format_wav, ma_format_f32, GetChannels(), GetSampleRate());
+	ma_result result = ma_encoder_init_file(path.c_str(), &config, &encoder);
+	if (result != MA_SUCCESS)
+	{
+		spdlog::error("Failed to render audio to '{}' [{}]", path, (int)result);
+		return false;
+	}
+
+	// Written a block at a time, so long renders do not need to be held in memory
+	vector<float> block((size_t)m_BlockFrames * GetChannels());
+	for (ma_uint64 rendered = 0; rendered < frameCount;)
+	{
+		ma_uint64 read = RenderBlock(block.data(), (std::min)((ma_uint64)m_BlockFrames, frameCount - rendered));
+		if (read == 0)
+			break;
+
+		result = ma_encoder_write_pcm_frames(&encoder, block.data(), read, nullptr);
+		if (result != MA_SUCCESS)
+		{
+			spdlog::error("Failed to write rendered audio to '{}' [{}]", path, (int)result);
+			break;
+		}
+		rendered += read;
+	}
+
+	ma_encoder_uninit(&encoder);
+	return result == MA_SUCCESS;
+}
+
+ma_uint32 AudioRenderer::GetChannels() { return ma_engine_get_channels(m_Engine); }
+ma_uint32 AudioRenderer::GetSampleRate() { return ma_engine_get_sample_rate(m_Engine); }
+ma_uint64 AudioRenderer::GetFramesRendered() { return m_FramesRendered; }
+double AudioRenderer::GetRenderTime() { return m_RenderTime; }
+
+double AudioRenderer::GetCostPerSecond()
+{
+	if (m_FramesRendered == 0)
+		return 0.0;
+	return m_RenderTime * 1000.0 / (m_FramesRendered / (double)GetSampleRate());
+}
+
+void AudioRenderer::ResetStats()
+{
+	m_FramesRendered = 0;
+	m_RenderTime = 0;
+}
@@ -0,0 +1,312 @@
+#include <chrono>
+#include <cstring>
+#include <algorithm>
+#include <spdlog/spdlog.h>
+#include <Yonai/Audio/AudioStream.hpp>
+
+using namespace std;
+using namespace Yonai;
+
+mutex AudioStream::s_Mutex;
+thread AudioStream::s_Thread;
+bool AudioStream::s_Running = false;
+condition_variable AudioStream::s_Wake;
+vector<AudioStream*> AudioStream::s_Streams;
+
+ma_data_source_vtable AudioStream::s_VTable = { OnRead, OnSeek, OnGetDataFormat, OnGetCursor, OnGetLength };
+
+/// <summary>
+/// Time between the decoding thread checking streams for space, in milliseconds.
+/// Well below the time taken to play BufferedChunks, so buffers are refilled long before running out.
+/// </summary>
+static const int DecodeInterval = 10;
+
+namespace Yonai
+{
+	/// <summary>
+	/// Stops the decoding thread before the static members it uses are destroyed
+	/// </summary>
+	struct AudioStreamShutdown
+	{
+		~AudioStreamShutdown()
+		{
+			{
+				lock_guard lock(AudioStream::s_Mutex);
+				AudioStream::s_Running = false;
+			}
+			AudioStream::s_Wake.notify_all();
+
+			if (AudioStream::s_Thread.joinable())
+				AudioStream::s_Thread.join();
+		}
+	};
+}
+
+static AudioStreamShutdown s_Shutdown;
+
+AudioStream::AudioStream() :
+	m_Source(), m_Decoder(), m_Valid(false), m_Channels(0), m_SampleRate(0), m_ChannelMap(), m_Length(0), m_BufferFrames(0),
+	m_WriteFrame(0), m_ReadFrame(0), m_Cursor(0), m_AtEnd(false), m_SeekTarget(0), m_SeekRequest(0), m_SeekHandled(0), m_Underruns(0)
+{
+	m_Source.Stream = this;
+}
+
+// Decoded to the engine's mixing format, keeping the source's channels and sample rate
+AudioStream::AudioStream(const string& path) : AudioStream()
+{
+	ma_decoder_config config = ma_decoder_config_init(ma_format_f32, 0, 0);
+	Open(ma_decoder_init_file(path.c_str(), &config, &m_Decoder), path);
+}
+
+AudioStream::AudioStream(IO::ByteSpan data, const string& name) : AudioStream()
+{
+	ma_decoder_config config = ma_decoder_config_init(ma_format_f32, 0, 0);
+	Open(ma_decoder_init_memory(data.data(), data.size(), &config, &m_Decoder), name);
+}
+
+void AudioStream::Open(ma_result result, const string& name)
+{
+	if (result != MA_SUCCESS)
+	{
+		spdlog::error("Failed to open audio stream '{}' [{}]", name, (int)result);
+		return;
+	}
+
+	ma_format format;
+	ma_decoder_get_data_format(&m_Decoder, &format, &m_Channels, &m_SampleRate, m_ChannelMap, MA_MAX_CHANNELS);
+	if (ma_decoder_get_length_in_pcm_frames(&m_Decoder, &m_Length) != MA_SUCCESS)
+		m_Length = 0;
+
+	ma_data_source_config sourceConfig = ma_data_source_config_init();
+	sourceConfig.vtable = &s_VTable;
+	if (m_Channels == 0 || ma_data_source_init(&sourceConfig, &m_Source.Base) != MA_SUCCESS)
+	{
+		spdlog::error("Failed to open audio stream '{}' - invalid format", name);
+		ma_decoder_uninit(&m_Decoder);
+		return;
+	}
+
+	m_BufferFrames = (ma_uint64)ChunkFrames * BufferedChunks;
+	m_Buffer.resize(m_BufferFrames * m_Channels);
+	m_Valid = true;
+
+	lock_guard lock(s_Mutex);
+
+	// Filled before the first read, so playback starts without waiting on the decoding thread
+	while (Fill());
+
+	s_Streams.emplace_back(this);
+	if (!s_Running)
+	{
+		s_Running = true;
+		s_Thread = thread(DecodeLoop);
+	}
+}
+
+AudioStream::~AudioStream()
+{
+	if (!m_Valid)
+		return;
+
+	{
+		lock_guard lock(s_Mutex);
+		s_Streams.erase(remove(s_Streams.begin(), s_Streams.end(), this), s_Streams.end());
+	}
+
+	ma_data_source_uninit(&m_Source.Base);
+	ma_decoder_uninit(&m_Decoder);
+}
+
+void AudioStream::DecodeLoop()
+{
+	unique_lock lock(s_Mutex);
+	while (s_Running)
+	{
+		bool remainingSpace = false;
+		for (AudioStream* stream : s_Streams)
+			remainingSpace |= stream->Fill();
+
+		if (remainingSpace)
+		{
+			// Let streams be added and removed between chunks
+			lock.unlock();
+			this_thread::yield();
+			lock.lock();
+		}
+		else
+			s_Wake.wait_for(lock, chrono::milliseconds(DecodeInterval));
+	}
+}
+
+bool AudioStream::Fill()
+{
+	// Mixer does not read while a seek is pending, so buffered frames can be discarded
+	unsigned int seekRequest = m_SeekRequest.load(memory_order_acquire);
+	if (seekRequest != m_SeekHandled.load(memory_order_relaxed))
+	{
+		ma_decoder_seek_to_pcm_frame(&m_Decoder, m_SeekTarget.load());
+		m_WriteFrame.store(m_ReadFrame.load(memory_order_acquire), memory_order_release);
+		m_AtEnd.store(false, memory_order_release);
+
+		Decode(ChunkFrames);
+		m_SeekHandled.store(seekRequest, memory_order_release);
+		return true;
+	}
+
+	if (m_AtEnd.load(memory_order_relaxed))
+	{
+		// Looping was enabled after reaching the end
+		if (!ma_data_source_is_looping(&m_Source.Base) || m_Length == 0)
+			return false;
+		ma_decoder_seek_to_pcm_frame(&m_Decoder, 0);
+		m_AtEnd.store(false, memory_order_release);
+	}
+
+	ma_uint64 space = m_BufferFrames - (m_WriteFrame.load(memory_order_relaxed) - m_ReadFrame.load(memory_order_acquire));
+	if (space < ChunkFrames)
+		return false;
+
+	Decode(ChunkFrames);
+	return space >= (ma_uint64)ChunkFrames * 2 && !m_AtEnd.load(memory_order_relaxed);
+}
+
+ma_uint64 AudioStream::Decode(ma_uint64 frameCount)
+{
+	ma_uint64 write = m_WriteFrame.load(memory_order_relaxed);
+	ma_uint64 offset = write % m_BufferFrames;
+	frameCount = (std::min)(frameCount, m_BufferFrames - offset);
+
+	bool atEnd = false;
+	bool restarted = false;
+	ma_uint64 decoded = 0;
+	while (decoded < frameCount)
+	{
+		ma_uint64 requested = frameCount - decoded;
+		ma_uint64 read = 0;
+		ma_result result = ma_decoder_read_pcm_frames(&m_Decoder, m_Buffer.data() + (offset + decoded) * m_Channels, requested, &read);
+		decoded += read;
+		if (read > 0)
+			restarted = false;
+		if (result == MA_SUCCESS && read == requested)
+			continue;
+
+		// Reached end of clip, looping clips continue from the start.
+		// Stops if nothing could be read since restarting, such as an empty clip.
+		if (restarted || !ma_data_source_is_looping(&m_Source.Base) || ma_decoder_seek_to_pcm_frame(&m_Decoder, 0) != MA_SUCCESS)
+		{
+			atEnd = true;
+			break;
+		}
+		restarted = true;
+	}
+
+	// End is published after the final frames, so the mixer sees every frame before seeing the end
+	m_WriteFrame.store(write + decoded, memory_order_release);
+	if (atEnd)
+		m_AtEnd.store(true, memory_order_release);
+	return decoded;
+}
+
+#pragma region Data Source
+ma_result AudioStream::OnRead(ma_data_source* source, void* output, ma_uint64 frameCount, ma_uint64* framesRead)
+{
+	AudioStream* stream = ((AudioStreamSource*)source)->Stream;
+	float* samples = (float*)output;
+	const ma_uint32 channels = stream->m_Channels;
+
+	// Silence until the decoding thread has moved to the new position
+	if (stream->m_SeekRequest.load(memory_order_acquire) != stream->m_SeekHandled.load(memory_order_acquire))
+	{
+		memset(samples, 0, frameCount * channels * sizeof(float));
+		*framesRead = frameCount;
+		return MA_SUCCESS;
+	}
+
+	bool atEnd = stream->m_AtEnd.load(memory_order_acquire);
+	ma_uint64 read = stream->m_ReadFrame.load(memory_order_relaxed);
+	ma_uint64 available = stream->m_WriteFrame.load(memory_order_acquire) - read;
+	ma_uint64 count = (std::min)(available, frameCount);
+
+	// Copy, wrapping around the end of the buffer
+	ma_uint64 offset = read % stream->m_BufferFrames;
+	ma_uint64 first = (std::min)(count, stream->m_BufferFrames - offset);
+	memcpy(samples, stream->m_Buffer.data() + offset * channels, first * channels * sizeof(float));
+	memcpy(samples + first * channels, stream->m_Buffer.data(), (count - first) * channels * sizeof(float));
+	stream->m_ReadFrame.store(read + count, memory_order_release);
+
+	ma_uint64 cursor = stream->m_Cursor.load(memory_order_relaxed) + count;
+	if (stream->m_Length > 0 && cursor >= stream->m_Length)
+		cursor %= stream->m_Length;
+	stream->m_Cursor.store(cursor, memory_order_relaxed);
+
+	if (count == frameCount)
+	{
+		*framesRead = count;
+		return MA_SUCCESS;
+	}
+
+	// Looping may have been enabled after decoding reached the end, in which case decoding restarts shortly
+	if (atEnd && !ma_data_source_is_looping(source))
+	{
+		*framesRead = count;
+		return MA_AT_END;
+	}
+
+	// Decoding has fallen behind, output silence instead of waiting
+	memset(samples + count * channels, 0, (frameCount - count) * channels * sizeof(float));
+	stream->m_Underruns++;
+	*framesRead = frameCount;
+	return MA_SUCCESS;
+}
+
+ma_result AudioStream::OnSeek(ma_data_source* source, ma_uint64 frame)
+{
+	AudioStream* stream = ((AudioStreamSource*)source)->Stream;
+	if (stream->m_Length > 0)
+		frame = (std::min)(frame, stream->m_Length);
+
+	stream->m_SeekTarget.store(frame);
+	stream->m_Cursor.store(frame);
+	stream->m_SeekRequest.fetch_add(1, memory_order_release);
+	s_Wake.notify_one();
+	return MA_SUCCESS;
+}
+
+ma_result AudioStream::OnGetDataFormat(ma_data_source* source, ma_format* format, ma_uint32* channels, ma_uint32* sampleRate, ma_channel* channelMap, size_t channelMapCapacity)
+{
+	AudioStream* stream = ((AudioStreamSource*)source)->Stream;
+	if (format)
+		*format = ma_format_f32;
+	if (channels)
+		*channels = stream->m_Channels;
+	if (sampleRate)
+		*sampleRate = stream->m_SampleRate;
+	if (channelMap)
+		memcpy(channelMap, stream->m_ChannelMap, (std::min)(channelMapCapacity, (size_t)stream->m_Channels) * sizeof(ma_channel));
+	return MA_SUCCESS;
+}
+
+ma_result AudioStream::OnGetCursor(ma_data_source* source, ma_uint64* cursor)
+{
+	*cursor = ((AudioStreamSource*)source)->Stream->m_Cursor.load(memory_order_relaxed);
+	return MA_SUCCESS;
+}
+
+ma_result AudioStream::OnGetLength(ma_data_source* source, ma_uint64* length)
+{
+	*length = ((AudioStreamSource*)source)->Stream->m_Length;
+	return *length > 0 ? MA_SUCCESS : MA_NOT_IMPLEMENTED;
+}
+#pragma endregion
+
+bool AudioStream::IsValid() { return m_Valid; }
+ma_data_source* AudioStream::GetDataSource() { return &m_Source; }
+ma_uint64 AudioStream::GetLength() { return m_Length; }
+float AudioStream::GetLengthSeconds() { return m_SampleRate == 0 ? 0.0f : m_Length / (float)m_SampleRate; }
+ma_uint32 AudioStream::GetChannels() { return m_Channels; }
+ma_uint32 AudioStream::GetSampleRate() { return m_SampleRate; }
+ma_uint64 AudioStream::GetBufferedFrames() { return m_WriteFrame.load(memory_order_acquire) - m_ReadFrame.load(memory_order_acquire); }
+bool AudioStream::IsSeeking() { return m_SeekRequest.load(memory_order_acquire) != m_SeekHandled.load(memory_order_acquire); }
+bool AudioStream::IsDecodeFinished() { return m_AtEnd.load(memory_order_acquire); }
+unsigned int AudioStream::GetUnderrunCount() { return m_Underruns; }
+size_t AudioStream::GetMemoryUsage() { return sizeof(AudioStream) + m_Buffer.capacity() * sizeof(float); }
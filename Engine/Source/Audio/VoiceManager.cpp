@@ -0,0 +1,87 @@
+#include <cmath>
+#include <numeric>
+#include <algorithm>
+#include <Yonai/Audio/VoiceManager.hpp>
+
+using namespace std;
+using namespace Yonai;
+
+VoiceManager::VoiceManager(unsigned int maxRealVoices) :
+	m_MaxRealVoices(maxRealVoices), m_AudibilityThreshold(0.0001f), m_Hysteresis(0.25f),
+	m_RealCount(0), m_VirtualCount(0), m_Promotions(0), m_Demotions(0), m_Order() { }
+
+unsigned int VoiceManager::Assign(vector<AudioVoice>& voices)
+{
+	const unsigned int maxReal = m_MaxRealVoices == 0 ? (unsigned int)voices.size() : m_MaxRealVoices;
+
+	m_Order.resize(voices.size());
+	iota(m_Order.begin(), m_Order.end(), 0u);
+
+	// Real voices are favoured, so similar voices don't swap every update
+	auto score = [&](const AudioVoice& voice) { return voice.Audibility * (voice.Real ? 1.0f + m_Hysteresis : 1.0f); };
+	auto compare = [&](unsigned int a, unsigned int b)
+	{
+		if (voices[a].Priority != voices[b].Priority)
+			return voices[a].Priority > voices[b].Priority;
+		float scoreA = score(voices[a]), scoreB = score(voices[b]);
+		return scoreA != scoreB ? scoreA > scoreB : a < b;
+	};
+
+	// Only the most important voices need to be in order
+	if (maxReal < m_Order.size())
+		nth_element(m_Order.begin(), m_Order.begin() + maxReal, m_Order.end(), compare);
+
+	m_RealCount = m_Promotions = m_Demotions = 0;
+	for (unsigned int i = 0; i < (unsigned int)m_Order.size(); i++)
+	{
+		AudioVoice& voice = voices[m_Order[i]];
+		voice.ShouldBeReal = i < maxReal && voice.Audibility >= m_AudibilityThreshold;
+
+		if (voice.ShouldBeReal)
+			m_RealCount++;
+		if (voice.ShouldBeReal && !voice.Real)
+			m_Promotions++;
+		else if (!voice.ShouldBeReal && voice.Real)
+			m_Demotions++;
+	}
+	m_VirtualCount = (unsigned int)voices.size() - m_RealCount;
+	return m_RealCount;
+}
+
+float VoiceManager::GetAttenuation(ma_attenuation_model model, float distance, float minDistance, float maxDistance, float rolloff, float minGain, float maxGain)
+{
+	float gain = 1.0f;
+	if (model != ma_attenuation_model_none && minDistance < maxDistance)
+	{
+		distance = std::clamp(distance, minDistance, maxDistance);
+		switch (model)
+		{
+		default: break;
+		case ma_attenuation_model_inverse:
+			gain = minDistance / (minDistance + rolloff * (distance - minDistance));
+			break;
+		case ma_attenuation_model_linear:
+			gain = 1.0f - rolloff * (distance - minDistance) / (maxDistance - minDistance);
+			break;
+		case ma_attenuation_model_exponential:
+			if (minDistance > 0.0f)
+				gain = powf(distance / minDistance, -rolloff);
+			break;
+		}
+	}
+	return std::clamp(gain, minGain, maxGain);
+}
+
+unsigned int VoiceManager::GetMaxRealVoices() { return m_MaxRealVoices; }
+void VoiceManager::SetMaxRealVoices(unsigned int count) { m_MaxRealVoices = count; }
+
+float VoiceManager::GetAudibilityThreshold() { return m_AudibilityThreshold; }
+void VoiceManager::SetAudibilityThreshold(float threshold) { m_AudibilityThreshold = (std::max)(threshold, 0.0f); }
+
+float VoiceManager::GetHysteresis() { return m_Hysteresis; }
+void VoiceManager::SetHysteresis(float hysteresis) { m_Hysteresis = (std::max)(hysteresis, 0.0f); }
+
+unsigned int VoiceManager::GetRealCount() { return m_RealCount; }
+unsigned int VoiceManager::GetVirtualCount() { return m_VirtualCount; }
+unsigned int VoiceManager::GetPromotions() { return m_Promotions; }
+unsigned int VoiceManager::GetDemotions() { return m_Demotions; }
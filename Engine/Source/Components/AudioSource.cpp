@@ -1,5 +1,7 @@
+#include <cmath>
 #include <Yonai/Resource.hpp>
 #include <Yonai/Audio/AudioData.hpp>
+#include <Yonai/Audio/VoiceManager.hpp>
 #include <Yonai/Scripting/ScriptEngine.hpp>
 #include <Yonai/Components/AudioSource.hpp>
 #include <Yonai/Systems/Global/AudioSystem.hpp>
@@ -14,7 +16,44 @@ AudioSource::~AudioSource()
 {
 	// Clear sound
 	if (m_Sound != InvalidResourceID)
-		ma_sound_uninit(&m_Data);
+		ReleaseSound();
+
+	if (m_CullingTracked)
+		AudioSystem::s_CullingGrid.Remove(this);
+}
+
+void AudioSource::Submit(AudioCommandType type, float x, float y, float z, ma_uint64 frame)
+{
+	AudioCommand command;
+	command.Type = type;
+	command.Sound = &m_Data;
+	command.Values[0] = x;
+	command.Values[1] = y;
+	command.Values[2] = z;
+	command.Frame = frame;
+	AudioSystem::s_Commands.Push(command);
+}
+
+void AudioSource::ReleaseSound()
+{
+	// Commands referencing this sound are applied before it is released
+	AudioSystem::s_Commands.Synchronise();
+
+	ma_sound_uninit(&m_Data);
+	m_Virtual = false;
+
+	if (m_Stream)
+	{
+		delete m_Stream;
+		m_Stream = nullptr;
+	}
+	else if (m_Clip)
+	{
+		ma_audio_buffer_uninit(&m_Buffer);
+		m_Clip.reset();
+	}
+	else
+		ma_decoder_uninit(&m_Decoder);
 }
 
 void AudioSource::Play()
@@ -23,7 +62,7 @@ void AudioSource::Play()
 		m_Sound == InvalidResourceID) // or sound not loaded
 		return;
 	
-	ma_sound_start(&m_Data);
+	Submit(AudioCommandType::Start);
 
 	m_State = SoundState::Playing;
 
@@ -41,10 +80,10 @@ void AudioSource::Pause()
 	m_State = SoundState::Paused;
 
 	// Store current cursor position
-	ma_sound_get_cursor_in_pcm_frames(&m_Data, &m_PausedFrames);
+	m_PausedFrames = GetCursor();
 
 	// Stop playing sound
-	ma_sound_stop(&m_Data);
+	ResetVoice();
 
 	UpdateManagedState();
 }
@@ -57,10 +96,10 @@ void AudioSource::Resume()
 	m_State = SoundState::Playing;
 
 	// Start sound
-	ma_sound_start(&m_Data);
+	Submit(AudioCommandType::Start);
 
 	// Seek to previous position
-	ma_sound_seek_to_pcm_frame(&m_Data, m_PausedFrames);
+	Submit(AudioCommandType::Seek, 0, 0, 0, m_PausedFrames);
 
 	UpdateManagedState();
 }
@@ -73,8 +112,8 @@ void AudioSource::Stop()
 	// Set state
 	m_State = SoundState::Stopped;
 
-	ma_sound_stop(&m_Data);
-	ma_sound_seek_to_pcm_frame(&m_Data, 0);
+	ResetVoice();
+	Submit(AudioCommandType::Seek, 0, 0, 0, 0);
 
 	// Reset pause state
 	m_PausedFrames = 0;
@@ -92,9 +131,82 @@ float AudioSource::GetPlayTime()
 	if (m_State == SoundState::Stopped)
 		return 0.0f;
 
-	float position;
-	ma_sound_get_cursor_in_seconds(&m_Data, &position);
-	return position;
+	return m_SampleRate == 0 ? 0.0f : GetCursor() / (float)m_SampleRate;
+}
+
+ma_uint64 AudioSource::GetCursor()
+{
+	ma_uint64 cursor = 0;
+	if (!m_Virtual)
+	{
+		ma_sound_get_cursor_in_pcm_frames(&m_Data, &cursor);
+		return cursor;
+	}
+
+	// Advance from when made virtual, by engine time converted to frames of this sound
+	ma_uint32 engineSampleRate = ma_engine_get_sample_rate(&AudioSystem::s_Engine);
+	ma_uint64 engineTime = ma_engine_get_time(&AudioSystem::s_Engine);
+	ma_uint64 elapsed = engineTime > m_VirtualTime ? engineTime - m_VirtualTime : 0; // Engine time restarts when output device changes
+	if (engineSampleRate > 0)
+		cursor = m_VirtualCursor + (ma_uint64)(elapsed * (double)m_Pitch * m_SampleRate / engineSampleRate);
+
+	if (m_LengthFrames == 0)
+		return cursor;
+	return m_Looping ? cursor % m_LengthFrames : (std::min)(cursor, m_LengthFrames);
+}
+
+void AudioSource::MakeVirtual()
+{
+	if (m_Virtual || m_Sound == InvalidResourceID)
+		return;
+
+	m_VirtualCursor = GetCursor();
+	m_VirtualTime = ma_engine_get_time(&AudioSystem::s_Engine);
+	m_Virtual = true;
+
+	// Fade out, then stop mixing once silent
+	ma_uint64 fadeFrames = GetVoiceFadeFrames();
+	Submit(AudioCommandType::Fade, -1.0f, 0.0f, 0, fadeFrames);
+	Submit(AudioCommandType::SetStopTime, 0, 0, 0, m_VirtualTime + fadeFrames);
+}
+
+void AudioSource::MakeReal()
+{
+	if (!m_Virtual)
+		return;
+
+	ma_uint64 cursor = GetCursor();
+	m_Virtual = false;
+	Submit(AudioCommandType::SetStopTime, 0, 0, 0, ~(ma_uint64)0);
+
+	// Still fading out, fade back in from current volume
+	if (ma_sound_is_playing(&m_Data))
+	{
+		Submit(AudioCommandType::Fade, -1.0f, m_Volume, 0, GetVoiceFadeFrames());
+		return;
+	}
+
+	Submit(AudioCommandType::Seek, 0, 0, 0, cursor);
+	Submit(AudioCommandType::Fade, 0.0f, m_Volume, 0, GetVoiceFadeFrames());
+	Submit(AudioCommandType::Start);
+}
+
+ma_uint64 AudioSource::GetVoiceFadeFrames()
+{
+	return (ma_uint64)VoiceManager::FadeMilliseconds * ma_engine_get_sample_rate(&AudioSystem::s_Engine) / 1000;
+}
+
+void AudioSource::ResetVoice()
+{
+	m_Culled = false;
+	Submit(AudioCommandType::Stop);
+	if (!m_Virtual)
+		return;
+
+	// Cancel the fade out and scheduled stop from becoming virtual
+	m_Virtual = false;
+	Submit(AudioCommandType::SetStopTime, 0, 0, 0, ~(ma_uint64)0);
+	Submit(AudioCommandType::Fade, m_Volume, m_Volume, 0, 0);
 }
 
 void AudioSource::Seek(float seconds)
@@ -106,10 +218,16 @@ void AudioSource::Seek(float seconds)
 	// Ensure value is within bounds
 	seconds = std::clamp(seconds, 0.0f, GetLength());
 
-	// Time to seek to
-	ma_uint64 pcmTime = (ma_uint64)std::floor(seconds * AudioSystem::GetSampleRate());
+	// Time to seek to, in frames of the clip rather than the output device
+	ma_uint64 pcmTime = (ma_uint64)std::floor(seconds * m_SampleRate);
 
-	ma_sound_seek_to_pcm_frame(&m_Data, pcmTime);
+	if (m_Virtual)
+	{
+		m_VirtualCursor = pcmTime;
+		m_VirtualTime = ma_engine_get_time(&AudioSystem::s_Engine);
+	}
+	else
+		Submit(AudioCommandType::Seek, 0, 0, 0, pcmTime);
 }
 
 void AudioSource::SetVolume(float volume)
@@ -117,32 +235,37 @@ void AudioSource::SetVolume(float volume)
 	// Ensure volume is at least 0
 	m_Volume = (std::max)(volume, 0.0f);
 
-	if(m_Sound != InvalidResourceID)
-		ma_sound_set_volume(&m_Data, m_Volume);
+	// Virtual sources fade in to the new volume once real
+	if(m_Sound != InvalidResourceID && !m_Virtual)
+		Submit(AudioCommandType::SetVolume, m_Volume);
 }
 
 bool AudioSource::IsLooping() { return m_Looping; }
-void AudioSource::SetLooping(bool loop) { ma_sound_set_looping(&m_Data, m_Looping = loop); }
+void AudioSource::SetLooping(bool loop)
+{
+	m_Looping = loop;
+	if (m_Sound != InvalidResourceID) Submit(AudioCommandType::SetLooping, m_Looping ? 1.0f : 0.0f);
+}
 
 float AudioSource::GetPanning() { return m_Panning; }
 void AudioSource::SetPanning(float pan)
 {
 	m_Panning = std::clamp(pan, -1.0f, 1.0f);
-	if(m_Sound != InvalidResourceID) ma_sound_set_pan(&m_Data, m_Panning);
+	if(m_Sound != InvalidResourceID) Submit(AudioCommandType::SetPan, m_Panning);
 }
 
 float AudioSource::GetPitch() { return m_Pitch; }
 void AudioSource::SetPitch(float pitch)
 {
 	m_Pitch = (std::max)(pitch, 0.0f);
-	if (m_Sound != InvalidResourceID) ma_sound_set_pitch(&m_Data, m_Pitch);
+	if (m_Sound != InvalidResourceID) Submit(AudioCommandType::SetPitch, m_Pitch);
 }
 
 bool AudioSource::Get3D() { return m_Is3D; }
 void AudioSource::Set3D(bool enable)
 {
 	m_Is3D = enable;
-	if(m_Sound != InvalidResourceID) ma_sound_set_spatialization_enabled(&m_Data, enable);
+	if(m_Sound != InvalidResourceID) Submit(AudioCommandType::Set3D, m_Is3D ? 1.0f : 0.0f);
 }
 
 glm::vec2 AudioSource::GetRolloffDistance() { return m_RolloffRange; }
@@ -150,11 +273,8 @@ void AudioSource::SetRolloffDistance(float min, float max) { SetRolloffDistance(
 void AudioSource::SetRolloffDistance(glm::vec2 range)
 {
 	m_RolloffRange = range;
-	if (m_Sound == InvalidResourceID)
-		return;
-
-	ma_sound_set_min_distance(&m_Data, m_RolloffRange.x);
-	ma_sound_set_max_distance(&m_Data, m_RolloffRange.y);
+	if (m_Sound != InvalidResourceID)
+		Submit(AudioCommandType::SetRolloffDistance, m_RolloffRange.x, m_RolloffRange.y);
 }
 
 glm::vec2 AudioSource::GetRolloffGain() { return m_RolloffGain; }
@@ -162,11 +282,8 @@ void AudioSource::SetRolloffGain(float min, float max) { SetRolloffGain(glm::vec
 void AudioSource::SetRolloffGain(glm::vec2 range)
 {
 	m_RolloffGain = range;
-	if (m_Sound == InvalidResourceID)
-		return;
-
-	ma_sound_set_min_gain(&m_Data, m_RolloffGain.x);
-	ma_sound_set_max_gain(&m_Data, m_RolloffGain.y);
+	if (m_Sound != InvalidResourceID)
+		Submit(AudioCommandType::SetRolloffGain, m_RolloffGain.x, m_RolloffGain.y);
 }
 
 float AudioSource::GetAttenuationRolloff() { return m_RolloffFactor; }
@@ -174,7 +291,7 @@ void AudioSource::SetAttenuationRolloff(float factor)
 {
 	m_RolloffFactor = factor;
 	if (m_Sound != InvalidResourceID)
-		ma_sound_set_rolloff(&m_Data, m_RolloffFactor);
+		Submit(AudioCommandType::SetAttenuationRolloff, m_RolloffFactor);
 }
 
 ma_attenuation_model AudioSource::GetAttenuationModel() { return m_AttenuationModel; }
@@ -182,7 +299,7 @@ void AudioSource::SetAttenuationModel(ma_attenuation_model model)
 {
 	m_AttenuationModel = model;
 	if (m_Sound != InvalidResourceID)
-		ma_sound_set_attenuation_model(&m_Data, m_AttenuationModel);
+		Submit(AudioCommandType::SetAttenuationModel, 0, 0, 0, (ma_uint64)m_AttenuationModel);
 }
 
 ResourceID AudioSource::GetSound() { return m_Sound; }
@@ -193,8 +310,7 @@ void AudioSource::SetSound(ResourceID id)
 	{
 		// Uninitialise
 		m_Sound = InvalidResourceID;
-		ma_sound_uninit(&m_Data);
-		ma_decoder_uninit(&m_Decoder);
+		ReleaseSound();
 		return;
 	}
 
@@ -205,13 +321,14 @@ void AudioSource::SetSound(ResourceID id)
 	if (m_Sound != InvalidResourceID)
 	{
 		// Release previously loaded sound
-		ma_sound_uninit(&m_Data);
-		ma_decoder_uninit(&m_Decoder);
+		ReleaseSound();
 	}
 
 	m_Sound = id;
 	AudioData* sound = Resource::Get<AudioData>(m_Sound);
 	m_Length = 0;
+	m_LengthFrames = 0;
+	m_SampleRate = 0;
 
 	if (!sound || sound->GetLength() <= 0.0f)
 	{
@@ -220,14 +337,52 @@ void AudioSource::SetSound(ResourceID id)
 		return;
 	}
 	
-	ma_decoder_config config = ma_decoder_config_init_default();
-	ma_result result = ma_decoder_init_memory(sound->m_Data.data(), sound->m_Data.size(), &config, &m_Decoder);
-	if (result != MA_SUCCESS)
-		spdlog::error("Failed to decode audio data [{}]", (int)result);
+	ma_data_source* source = &m_Decoder;
+	if (sound->IsStreaming())
+	{
+		m_Stream = sound->m_StreamPack ?
+			new AudioStream(sound->m_StreamData, sound->m_StreamPath) :
+			new AudioStream(sound->m_StreamPath);
+		if (!m_Stream->IsValid())
+		{
+			spdlog::error("Failed to initialise sound source - could not open stream '{}'", sound->m_StreamPath);
+			delete m_Stream;
+			m_Stream = nullptr;
+			m_Sound = InvalidResourceID;
+			return;
+		}
+		source = m_Stream->GetDataSource();
+	}
+	else
+	{
+		// Short clips are shared already decoded, others are decoded by this source while playing
+		AudioDecodeCache& cache = AudioSystem::s_DecodeCache;
+		if (sound->GetLength() <= cache.GetMaxClipLength())
+			m_Clip = cache.Get(sound, sound->m_Data);
+
+		if (m_Clip)
+		{
+			ma_audio_buffer_config config = ma_audio_buffer_config_init(
+				m_Clip->Format, m_Clip->Channels, m_Clip->FrameCount, m_Clip->Frames.data(), nullptr);
+			config.sampleRate = m_Clip->SampleRate;
+			if (ma_audio_buffer_init(&config, &m_Buffer) == MA_SUCCESS)
+				source = &m_Buffer;
+			else
+				m_Clip.reset();
+		}
+
+		if (!m_Clip)
+		{
+			ma_decoder_config config = ma_decoder_config_init_default();
+			ma_result result = ma_decoder_init_memory(sound->m_Data.data(), sound->m_Data.size(), &config, &m_Decoder);
+			if (result != MA_SUCCESS)
+				spdlog::error("Failed to decode audio data [{}]", (int)result);
+		}
+	}
 
-	result = ma_sound_init_from_data_source(
+	ma_result result = ma_sound_init_from_data_source(
 		&AudioSystem::s_Engine,
-		&m_Decoder,
+		source,
 		0,
 		nullptr,
 		&m_Data
@@ -235,7 +390,14 @@ void AudioSource::SetSound(ResourceID id)
 	if (result != MA_SUCCESS)
 		spdlog::error("Failed to initialise sound source - sound engine error [{}]", (int)result);
 	else
+	{
 		ma_sound_get_length_in_seconds(&m_Data, &m_Length);
+		ma_sound_get_length_in_pcm_frames(&m_Data, &m_LengthFrames);
+		ma_sound_get_data_format(&m_Data, nullptr, nullptr, &m_SampleRate, nullptr, 0);
+	}
+
+	// Volume is applied by fading, so SetVolume can ramp between volumes
+	ma_sound_set_fade_in_pcm_frames(&m_Data, m_Volume, m_Volume, 0);
 
 	// Update values //
 	SetLooping(m_Looping);
@@ -247,11 +409,27 @@ void AudioSource::SetSound(ResourceID id)
 	SetRolloffDistance(m_RolloffRange);
 	SetAttenuationRolloff(m_RolloffFactor);
 	SetAttenuationModel(m_AttenuationModel);
+
+	// New sound starts at the origin, position is sent again on the next update
+	m_TransformChange = 0;
 	
 	if(m_Mixer) // If mixer is not default output
 		SetMixer(m_Mixer);
 }
 
+int AudioSource::GetPriority() { return m_Priority; }
+void AudioSource::SetPriority(int priority) { m_Priority = priority; }
+bool AudioSource::IsVirtual() { return m_Virtual; }
+bool AudioSource::IsCulled() { return m_Culled; }
+
+float AudioSource::GetCullRadius()
+{
+	// Attenuation stops at the max distance, so sources are only silent beyond it when the minimum gain is silent
+	if (!m_Is3D || m_AttenuationModel == ma_attenuation_model_none || m_RolloffGain.x > 0.0f)
+		return INFINITY;
+	return m_RolloffRange.y;
+}
+
 ResourceID AudioSource::GetMixer() { return m_Mixer; }
 void AudioSource::SetMixer(ResourceID mixer)
 {
@@ -368,6 +546,18 @@ ADD_MANAGED_METHOD(AudioSource, GetAttenuationRolloff, float, (void* instance))
 ADD_MANAGED_METHOD(AudioSource, SetAttenuationRolloff, void, (void* instance, float input))
 { ((AudioSource*)instance)->SetAttenuationRolloff(input); }
 
+ADD_MANAGED_METHOD(AudioSource, GetPriority, int, (void* instance))
+{ return ((AudioSource*)instance)->GetPriority(); }
+
+ADD_MANAGED_METHOD(AudioSource, SetPriority, void, (void* instance, int value))
+{ ((AudioSource*)instance)->SetPriority(value); }
+
+ADD_MANAGED_METHOD(AudioSource, IsVirtual, bool, (void* instance))
+{ return ((AudioSource*)instance)->IsVirtual(); }
+
+ADD_MANAGED_METHOD(AudioSource, IsCulled, bool, (void* instance))
+{ return ((AudioSource*)instance)->IsCulled(); }
+
 ADD_MANAGED_METHOD(AudioSource, GetAttenuationModel, int, (void* instance))
 { return (int)((AudioSource*)instance)->GetAttenuationModel(); }
 
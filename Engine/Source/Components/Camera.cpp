@@ -1,4 +1,5 @@
 #include <string>
+#include <limits>
 #include <spdlog/spdlog.h>
 #include <glm/gtx/quaternion.hpp>
 #include <Yonai/Components/Camera.hpp>
@@ -39,6 +40,22 @@ mat4 Camera::GetProjectionMatrix(int resolutionWidth, int resolutionHeight)
 }
 mat4 Camera::GetProjectionMatrix(glm::ivec2 resolution) { return GetProjectionMatrix(resolution.x, resolution.y); }
 
+float Camera::GetScreenSize(vec3 centre, float radius, ivec2 resolution)
+{
+	float aspectRatio = resolution.y > 0 ? resolution.x / (float)resolution.y : 1.0f;
+	float halfExtent = std::min(1.0f, aspectRatio); // Fraction of the view's half height covered by the smaller dimension
+
+	if (Orthographic)
+		return radius / (OrthographicSize * halfExtent);
+
+	Transform* transform = Entity.GetComponent<Transform>();
+	float distanceToCamera = glm::distance(centre, transform ? transform->GetGlobalPosition() : vec3(0, 0, 0));
+	if (distanceToCamera <= radius)
+		return numeric_limits<float>::max(); // Camera is inside sphere
+
+	return radius / (distanceToCamera * tan(radians(FieldOfView) * 0.5f) * halfExtent);
+}
+
 void Camera::FillShader(Shader* shader, ivec2 resolution)
 {
 	if (!shader)
@@ -1,11 +1,42 @@
+#include <cmath>
 #include <Yonai/Scripting/Assembly.hpp>
 #include <Yonai/Components/Component.hpp>
 #include <Yonai/Scripting/InternalCalls.hpp>
+#include <Yonai/Graphics/Material.hpp>
 #include <Yonai/Components/MeshRenderer.hpp>
 
+using namespace glm;
 using namespace Yonai;
+using namespace Yonai::Graphics;
 using namespace Yonai::Scripting;
 using namespace Yonai::Components;
 
+unsigned int MeshRenderer::UpdateLOD(Graphics::Mesh* mesh, Transform* transform, Camera* camera, ivec2 resolution)
+{
+	// Arena allocations only hold the full detail indices
+	if (!mesh || !camera || mesh->GetLODCount() <= 1 || mesh->GetArena())
+		return (CurrentLOD = 0);
+
+	vec3 centre = mesh->GetBoundsCentre();
+	float radius = mesh->GetBoundsRadius();
+	if (transform)
+	{
+		vec3 scale = abs(transform->GetGlobalScale());
+		centre = vec3(transform->GetModelMatrix() * vec4(centre, 1.0f));
+		radius *= std::max(scale.x, std::max(scale.y, scale.z));
+	}
+
+	float screenSize = camera->GetScreenSize(centre, radius, resolution) * exp2f(-LODBias);
+	return (CurrentLOD = mesh->SelectLOD(screenSize, CurrentLOD, LODHysteresis));
+}
+
+Mesh* MeshRenderer::GetMesh() { return m_MeshCache.Get(Mesh); }
+Material* MeshRenderer::GetMaterial() { return m_MaterialCache.Get(Material); }
+
+#pragma region Internal Calls
 ADD_MANAGED_GET_SET(MeshRenderer, Mesh, uint64_t)
 ADD_MANAGED_GET_SET(MeshRenderer, Material, uint64_t)
+ADD_MANAGED_GET_SET(MeshRenderer, LODBias, float)
+ADD_MANAGED_GET_SET(MeshRenderer, LODHysteresis, float)
+ADD_MANAGED_GET(MeshRenderer, CurrentLOD, unsigned int)
+#pragma endregion
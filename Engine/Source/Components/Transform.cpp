@@ -10,6 +10,8 @@ using namespace Yonai;
 using namespace Yonai::Graphics;
 using namespace Yonai::Components;
 
+uint64_t Transform::s_ChangeCounter = 0;
+
 vec3 Transform::GetPosition() { return Position; }
 quat Transform::GetRotation() { return Rotation; }
 vec3 Transform::GetScale() { return Scale; }
@@ -40,6 +42,21 @@ vec3 Transform::GlobalUp()		{ return vec3(0, 1, 0) * GetGlobalRotation(); }
 vec3 Transform::GlobalRight()	{ return vec3(1, 0, 0) * GetGlobalRotation(); }
 vec3 Transform::GlobalForward() { return vec3(0, 0, 1) * GetGlobalRotation(); }
 
+void Transform::MarkDirty()
+{
+	m_IsDirty = true;
+	PropagateChange(++s_ChangeCounter);
+}
+
+void Transform::PropagateChange(uint64_t change)
+{
+	m_LastChange = change;
+	for (const auto& pair : m_Children)
+		pair.second->PropagateChange(change);
+}
+
+uint64_t Transform::GetLastChange() { return m_LastChange; }
+
 Transform* Transform::GetParent() { return m_Parent; }
 void Transform::SetParent(Transform* parent)
 {
@@ -56,7 +73,7 @@ void Transform::AddChild(Transform* child)
 	if (m_Children.find(id) == m_Children.end())
 		m_Children.emplace(id, child);
 	child->m_Parent = this;
-	child->m_IsDirty = true;
+	child->MarkDirty();
 }
 
 void Transform::RemoveChild(Transform* child)
@@ -65,7 +82,7 @@ void Transform::RemoveChild(Transform* child)
 	if (m_Children.find(id) != m_Children.end())
 		m_Children.erase(id);
 	child->m_Parent = nullptr;
-	child->m_IsDirty = true;
+	child->MarkDirty();
 }
 
 vector<Transform*> Transform::GetChildren()
@@ -79,25 +96,25 @@ vector<Transform*> Transform::GetChildren()
 
 void Transform::SetPosition(vec3 position)
 {
-	m_IsDirty = true;
+	MarkDirty();
 	Position = position;
 }
 
 void Transform::SetRotation(quat rotation)
 {
-	m_IsDirty = true;
+	MarkDirty();
 	Rotation = rotation;
 }
 
 void Transform::SetRotation(vec3 euler)
 {
-	m_IsDirty = true;
+	MarkDirty();
 	Rotation = quat(radians(euler));
 }
 
 void Transform::SetScale(vec3 scale)
 {
-	m_IsDirty = true;
+	MarkDirty();
 	Scale = scale;
 }
 
@@ -107,7 +124,7 @@ void Transform::SetGlobalPosition(vec3 position)
 		position -= m_Parent->GetGlobalPosition();
 
 	Position = position;
-	m_IsDirty = true;
+	MarkDirty();
 }
 
 void Transform::SetGlobalRotation(vec3 euler, bool degrees)
@@ -115,7 +132,7 @@ void Transform::SetGlobalRotation(vec3 euler, bool degrees)
 	Rotation = glm::quat(degrees ? glm::radians(euler) : euler);
 	if (m_Parent)
 		Rotation = m_Parent->GetGlobalRotation() * inverse(Rotation);
-	m_IsDirty = true;
+	MarkDirty();
 }
 
 void Transform::SetGlobalRotation(quat rotation)
@@ -123,7 +140,7 @@ void Transform::SetGlobalRotation(quat rotation)
 	Rotation = rotation;
 	if (m_Parent)
 		Rotation *= m_Parent->GetGlobalRotation();
-	m_IsDirty = true;
+	MarkDirty();
 }
 
 void Transform::SetGlobalScale(vec3 scale)
@@ -131,7 +148,7 @@ void Transform::SetGlobalScale(vec3 scale)
 	Scale = scale;
 	if (m_Parent)
 		Scale /= m_Parent->GetGlobalScale();
-	m_IsDirty = true;
+	MarkDirty();
 }
 
 void Transform::UpdateModelMatrices(bool force)
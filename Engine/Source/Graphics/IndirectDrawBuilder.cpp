@@ -0,0 +1,220 @@
+#include <numeric>
+#include <algorithm>
+#include <glad/glad.h>
+#include <spdlog/spdlog.h>
+#include <Yonai/Graphics/IndirectDrawBuilder.hpp>
+
+using namespace glm;
+using namespace std;
+using namespace Yonai;
+using namespace Yonai::Graphics;
+
+IndirectDrawBuilder::IndirectDrawBuilder() :
+	m_CommandBuffer(GL_INVALID_VALUE), m_DrawDataBuffer(GL_INVALID_VALUE), m_DrawIndexBuffer(GL_INVALID_VALUE) { }
+
+IndirectDrawBuilder::~IndirectDrawBuilder()
+{
+	if (m_CommandBuffer == GL_INVALID_VALUE)
+		return; // Not set up
+
+	glDeleteBuffers(1, &m_CommandBuffer);
+	glDeleteBuffers(1, &m_DrawDataBuffer);
+	glDeleteBuffers(1, &m_DrawIndexBuffer);
+}
+
+void IndirectDrawBuilder::Begin()
+{
+	m_Building = true;
+	m_Draws.clear();
+	m_Groups.clear();
+	m_Commands.clear();
+	m_DrawData.clear();
+	m_Materials.clear();
+}
+
+bool IndirectDrawBuilder::Submit(
+	MeshArena* arena,
+	const MeshArena::Allocation& allocation,
+	ResourceID shader,
+	ResourceID material,
+	const mat4& modelMatrix,
+	GLenum drawMode)
+{
+	if (!m_Building)
+	{
+		spdlog::warn("Cannot submit indirect draw, Begin() has not been called");
+		return false;
+	}
+
+	if (!allocation.IsValid || allocation.IndexCount == 0)
+		return false; // Only indexed draws are supported
+
+	m_Draws.emplace_back(DrawInfo { arena, shader, material, drawMode, allocation, modelMatrix });
+	return true;
+}
+
+void IndirectDrawBuilder::End()
+{
+	m_Building = false;
+	m_Groups.clear();
+	m_Commands.clear();
+	m_DrawData.clear();
+	m_Materials.clear();
+
+	m_Commands.reserve(m_Draws.size());
+	m_DrawData.reserve(m_Draws.size());
+
+	// Group by arena, shader, material then draw mode. Stable sort keeps submission order within each group
+	stable_sort(m_Draws.begin(), m_Draws.end(), [](const DrawInfo& a, const DrawInfo& b)
+	{
+		if (a.Arena != b.Arena)
+			return less<MeshArena*>()(a.Arena, b.Arena);
+		if (a.Shader != b.Shader)
+			return (uint64_t)a.Shader < (uint64_t)b.Shader;
+		if (a.Material != b.Material)
+			return (uint64_t)a.Material < (uint64_t)b.Material;
+		return a.DrawMode < b.DrawMode;
+	});
+
+	unsigned int materialIndex = 0;
+	for (unsigned int i = 0; i < (unsigned int)m_Draws.size(); i++)
+	{
+		DrawInfo& draw = m_Draws[i];
+
+		bool newGroup = m_Groups.empty();
+		if (!newGroup)
+		{
+			Group& previous = m_Groups.back();
+			newGroup = previous.Arena != draw.Arena ||
+					   previous.Shader != draw.Shader ||
+					   previous.Material != draw.Material ||
+					   previous.DrawMode != draw.DrawMode;
+		}
+
+		if (newGroup)
+		{
+			Group group;
+			group.Arena = draw.Arena;
+			group.Shader = draw.Shader;
+			group.Material = draw.Material;
+			group.DrawMode = draw.DrawMode;
+			group.FirstCommand = i;
+			m_Groups.emplace_back(group);
+
+			// Same material can appear in multiple arenas
+			materialIndex = (unsigned int)(find(m_Materials.begin(), m_Materials.end(), draw.Material) - m_Materials.begin());
+			if (materialIndex == (unsigned int)m_Materials.size())
+				m_Materials.emplace_back(draw.Material);
+		}
+		m_Groups.back().CommandCount++;
+
+		m_Commands.emplace_back(DrawElementsIndirectCommand
+		{
+			draw.Allocation.IndexCount,
+			1, // Instance count
+			draw.Allocation.FirstIndex,
+			(int)draw.Allocation.BaseVertex,
+			i  // Base instance, used to index draw data
+		});
+
+		DrawData data = {};
+		data.ModelMatrix = draw.ModelMatrix;
+		data.MaterialIndex = materialIndex;
+		m_DrawData.emplace_back(data);
+	}
+}
+
+void IndirectDrawBuilder::Setup()
+{
+	glGenBuffers(1, &m_CommandBuffer);
+	glGenBuffers(1, &m_DrawDataBuffer);
+	glGenBuffers(1, &m_DrawIndexBuffer);
+}
+
+void IndirectDrawBuilder::Upload()
+{
+	if (m_Commands.empty())
+		return; // Nothing to draw
+
+	if (m_CommandBuffer == GL_INVALID_VALUE)
+		Setup();
+
+	unsigned int commandCount = (unsigned int)m_Commands.size();
+	if (commandCount > m_CommandCapacity)
+		m_CommandCapacity = std::max(commandCount, m_CommandCapacity * 2);
+
+	// Orphan previous buffers, so the driver doesn't wait on last frame's draws
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_CommandBuffer);
+	glBufferData(GL_DRAW_INDIRECT_BUFFER, m_CommandCapacity * sizeof(DrawElementsIndirectCommand), nullptr, GL_STREAM_DRAW);
+	glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, commandCount * sizeof(DrawElementsIndirectCommand), m_Commands.data());
+
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_DrawDataBuffer);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, m_CommandCapacity * sizeof(DrawData), nullptr, GL_STREAM_DRAW);
+	glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, commandCount * sizeof(DrawData), m_DrawData.data());
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, DrawDataBinding, m_DrawDataBuffer);
+
+	// Draw indices never change, only regenerate when more draws are made than previously allocated
+	if (commandCount > m_DrawIndexCapacity)
+	{
+		m_DrawIndexCapacity = m_CommandCapacity;
+
+		vector<unsigned int> drawIndices(m_DrawIndexCapacity);
+		iota(drawIndices.begin(), drawIndices.end(), 0u);
+
+		glBindBuffer(GL_COPY_WRITE_BUFFER, m_DrawIndexBuffer);
+		glBufferData(GL_COPY_WRITE_BUFFER, drawIndices.size() * sizeof(unsigned int), drawIndices.data(), GL_STATIC_DRAW);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	}
+}
+
+void IndirectDrawBuilder::Draw(const Group& group)
+{
+	if (!group.Arena || group.CommandCount == 0 || m_CommandBuffer == GL_INVALID_VALUE)
+		return;
+
+	group.Arena->Bind();
+
+	// Source draw index from each command's base instance
+	glBindBuffer(GL_ARRAY_BUFFER, m_DrawIndexBuffer);
+	glEnableVertexAttribArray(DrawIndexAttribute);
+	glVertexAttribIPointer(DrawIndexAttribute, 1, GL_UNSIGNED_INT, sizeof(unsigned int), (void*)0);
+	glVertexAttribDivisor(DrawIndexAttribute, 1);
+
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_CommandBuffer);
+	glMultiDrawElementsIndirect(
+		group.DrawMode,
+		GL_UNSIGNED_INT,
+		(void*)(size_t)(group.FirstCommand * sizeof(DrawElementsIndirectCommand)),
+		(GLsizei)group.CommandCount,
+		0 // Tightly packed
+	);
+
+	// Arena vertex array is shared with regular draws, don't leave it referencing this builder's buffer
+	glDisableVertexAttribArray(DrawIndexAttribute);
+	glVertexAttribDivisor(DrawIndexAttribute, 0);
+}
+
+vector<IndirectDrawBuilder::Group>& IndirectDrawBuilder::GetGroups() { return m_Groups; }
+vector<IndirectDrawBuilder::DrawData>& IndirectDrawBuilder::GetDrawData() { return m_DrawData; }
+vector<ResourceID>& IndirectDrawBuilder::GetMaterials() { return m_Materials; }
+vector<IndirectDrawBuilder::DrawElementsIndirectCommand>& IndirectDrawBuilder::GetCommands() { return m_Commands; }
+unsigned int IndirectDrawBuilder::GetDrawCount() { return (unsigned int)m_Draws.size(); }
+
+bool IndirectDrawBuilder::IsSupported() { return GLAD_GL_VERSION_4_3 != 0; }
+
+unordered_map<ResourceID, IndirectDrawBuilder::ShaderSupport> IndirectDrawBuilder::s_ShaderSupport = {};
+
+bool IndirectDrawBuilder::ShaderSupportsIndirect(ResourceID shader, unsigned int program)
+{
+	if (!IsSupported() || program == GL_INVALID_VALUE)
+		return false;
+
+	ShaderSupport& cached = s_ShaderSupport[shader];
+	if (cached.Program != program)
+	{
+		// Shader was created or recompiled since last cached
+		cached.Program = program;
+		cached.Supported = glGetProgramResourceIndex(program, GL_SHADER_STORAGE_BLOCK, "DrawDataBuffer") != GL_INVALID_INDEX;
+	}
+	return cached.Supported;
+}
@@ -0,0 +1,262 @@
+#include <cmath>
+#include <algorithm>
+#include <glad/glad.h>
+#include <Yonai/Components/Light.hpp>
+#include <Yonai/Components/Camera.hpp>
+#include <Yonai/Components/Transform.hpp>
+#include <Yonai/Graphics/LightClusters.hpp>
+
+using namespace glm;
+using namespace std;
+using namespace Yonai;
+using namespace Yonai::Graphics;
+using namespace Yonai::Components;
+
+LightClusters::LightClusters(uvec3 gridSize) :
+	m_GridSize(max(gridSize, uvec3(1))), m_LightsBuffer(GL_INVALID_VALUE), m_ClustersBuffer(GL_INVALID_VALUE), m_LightIndicesBuffer(GL_INVALID_VALUE) { }
+
+LightClusters::~LightClusters()
+{
+	if (m_LightsBuffer == GL_INVALID_VALUE)
+		return; // Not set up
+
+	glDeleteBuffers(1, &m_LightsBuffer);
+	glDeleteBuffers(1, &m_ClustersBuffer);
+	glDeleteBuffers(1, &m_LightIndicesBuffer);
+}
+
+int LightClusters::GetSlice(float depth) const
+{
+	return (int)std::floor(std::log(depth / m_Near) / std::log(m_Far / m_Near) * m_GridSize.z);
+}
+
+void LightClusters::CalculateClusterBounds(const mat4& projection, bool orthographic)
+{
+	m_ClusterBounds.resize((size_t)m_GridSize.x * m_GridSize.y * m_GridSize.z * 2);
+
+	mat4 inverseProjection = inverse(projection);
+	auto sliceDepth = [&](unsigned int slice) { return m_Near * std::pow(m_Far / m_Near, slice / (float)m_GridSize.z); };
+
+	for (unsigned int z = 0; z < m_GridSize.z; z++)
+	{
+		float depths[2] = { sliceDepth(z), sliceDepth(z + 1) };
+		for (unsigned int y = 0; y < m_GridSize.y; y++)
+		{
+			for (unsigned int x = 0; x < m_GridSize.x; x++)
+			{
+				vec3 boundsMin(numeric_limits<float>::max());
+				vec3 boundsMax(numeric_limits<float>::lowest());
+
+				for (unsigned int corner = 0; corner < 4; corner++)
+				{
+					vec2 ndc = vec2(
+						(x + (corner & 1)) / (float)m_GridSize.x,
+						(y + (corner >> 1)) / (float)m_GridSize.y
+					) * 2.0f - 1.0f;
+
+					// Point on near plane
+					vec4 nearPoint = inverseProjection * vec4(ndc, -1.0f, 1.0f);
+					nearPoint /= nearPoint.w;
+
+					for (float depth : depths)
+					{
+						vec3 point = orthographic ?
+							vec3(nearPoint.x, nearPoint.y, -depth) :
+							vec3(nearPoint) * (depth / -nearPoint.z);
+
+						boundsMin = min(boundsMin, point);
+						boundsMax = max(boundsMax, point);
+					}
+				}
+
+				unsigned int index = GetClusterIndex(uvec3(x, y, z));
+				m_ClusterBounds[index * 2 + 0] = boundsMin;
+				m_ClusterBounds[index * 2 + 1] = boundsMax;
+			}
+		}
+	}
+}
+
+void LightClusters::Build(
+	const mat4& view,
+	const mat4& projection,
+	float near,
+	float far,
+	bool orthographic,
+	const vector<LightData>& lights)
+{
+	m_Lights = lights;
+	m_Near = std::max(near, 0.0001f);
+	m_Far = std::max(far, m_Near + 0.0001f);
+
+	CalculateClusterBounds(projection, orthographic);
+
+	unsigned int clusterCount = m_GridSize.x * m_GridSize.y * m_GridSize.z;
+	m_Clusters.assign(clusterCount, Cluster { 0, 0 });
+	m_Pairs.clear();
+
+	for (unsigned int i = 0; i < (unsigned int)m_Lights.size(); i++)
+	{
+		vec3 centre = vec3(view * vec4(vec3(m_Lights[i].PositionRadius), 1.0f));
+		float radius = m_Lights[i].PositionRadius.w;
+		float depth = -centre.z;
+
+		if (radius <= 0.0f || depth + radius < m_Near || depth - radius > m_Far)
+			continue; // Outside of depth range
+
+		int sliceMin = std::max(GetSlice(std::max(depth - radius, m_Near)), 0);
+		int sliceMax = std::min(GetSlice(std::min(depth + radius, m_Far)), (int)m_GridSize.z - 1);
+
+		// Screen space bounds of the sphere's bounding box, clamped in front of near plane.
+		// Projected x/depth is monotonic over the box, so the corners give conservative bounds
+		vec2 ndcMin(numeric_limits<float>::max());
+		vec2 ndcMax(numeric_limits<float>::lowest());
+		for (unsigned int corner = 0; corner < 8; corner++)
+		{
+			vec3 point = centre + vec3(
+				(corner & 1) ? radius : -radius,
+				(corner & 2) ? radius : -radius,
+				(corner & 4) ? radius : -radius
+			);
+			point.z = std::min(point.z, -m_Near);
+
+			vec4 clip = projection * vec4(point, 1.0f);
+			vec2 ndc = vec2(clip) / clip.w;
+			ndcMin = min(ndcMin, ndc);
+			ndcMax = max(ndcMax, ndc);
+		}
+
+		if (ndcMax.x < -1.0f || ndcMax.y < -1.0f || ndcMin.x > 1.0f || ndcMin.y > 1.0f)
+			continue; // Off screen
+
+		ivec2 tileMin = clamp(ivec2(floor((ndcMin * 0.5f + 0.5f) * vec2(m_GridSize))), ivec2(0), ivec2(m_GridSize) - 1);
+		ivec2 tileMax = clamp(ivec2(floor((ndcMax * 0.5f + 0.5f) * vec2(m_GridSize))), ivec2(0), ivec2(m_GridSize) - 1);
+
+		for (int z = sliceMin; z <= sliceMax; z++)
+		{
+			for (int y = tileMin.y; y <= tileMax.y; y++)
+			{
+				for (int x = tileMin.x; x <= tileMax.x; x++)
+				{
+					unsigned int index = GetClusterIndex(uvec3(x, y, z));
+
+					// Sphere against cluster bounds
+					vec3 closest = clamp(centre, m_ClusterBounds[index * 2 + 0], m_ClusterBounds[index * 2 + 1]);
+					vec3 offset = closest - centre;
+					if (dot(offset, offset) > radius * radius)
+						continue;
+
+					m_Pairs.emplace_back(index, i);
+					m_Clusters[index].Count++;
+				}
+			}
+		}
+	}
+
+	// Counting sort pairs in to contiguous per-cluster lists
+	unsigned int offset = 0;
+	for (Cluster& cluster : m_Clusters)
+	{
+		cluster.Offset = offset;
+		offset += cluster.Count;
+		cluster.Count = 0;
+	}
+
+	m_LightIndices.resize(m_Pairs.size());
+	for (uvec2& pair : m_Pairs)
+	{
+		Cluster& cluster = m_Clusters[pair.x];
+		m_LightIndices[cluster.Offset + cluster.Count++] = pair.y;
+	}
+}
+
+void LightClusters::Build(Camera* camera, ivec2 resolution, vector<pair<Light*, Transform*>>& lights)
+{
+	vector<LightData> lightData;
+	lightData.reserve(lights.size());
+	for (auto& lightPair : lights)
+		lightData.emplace_back(LightData
+		{
+			vec4(lightPair.second->GetGlobalPosition(), lightPair.first->Radius),
+			vec4(lightPair.first->Colour, 1.0f)
+		});
+
+	Build(
+		camera->GetViewMatrix(),
+		camera->GetProjectionMatrix(resolution),
+		camera->Near,
+		camera->Far,
+		camera->Orthographic,
+		lightData
+	);
+}
+
+void LightClusters::Setup()
+{
+	glGenBuffers(1, &m_LightsBuffer);
+	glGenBuffers(1, &m_ClustersBuffer);
+	glGenBuffers(1, &m_LightIndicesBuffer);
+}
+
+template<typename T>
+void UploadStorageBuffer(unsigned int buffer, unsigned int binding, const vector<T>& data)
+{
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
+
+	// Orphan previous buffer so the driver doesn't wait on last frame's draws.
+	// Always allocate at least one element, empty buffers can't be bound
+	glBufferData(GL_SHADER_STORAGE_BUFFER, std::max(data.size(), (size_t)1) * sizeof(T), nullptr, GL_STREAM_DRAW);
+	if (!data.empty())
+		glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, data.size() * sizeof(T), data.data());
+
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, buffer);
+}
+
+void LightClusters::Upload()
+{
+	if (m_LightsBuffer == GL_INVALID_VALUE)
+		Setup();
+
+	UploadStorageBuffer(m_LightsBuffer, LightsBinding, m_Lights);
+	UploadStorageBuffer(m_ClustersBuffer, ClustersBinding, m_Clusters);
+	UploadStorageBuffer(m_LightIndicesBuffer, LightIndicesBinding, m_LightIndices);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+void LightClusters::FillShader(Shader* shader, ivec2 resolution)
+{
+	if (!shader)
+		return;
+
+	shader->Set("clusters.GridSize", vec3(m_GridSize));
+	shader->Set("clusters.Near", m_Near);
+	shader->Set("clusters.Far", m_Far);
+	shader->Set("clusters.Resolution", vec2(resolution));
+}
+
+uvec3 LightClusters::GetGridSize() { return m_GridSize; }
+void LightClusters::SetGridSize(uvec3 gridSize) { m_GridSize = max(gridSize, uvec3(1)); }
+
+unsigned int LightClusters::GetClusterIndex(uvec3 cluster)
+{
+	return cluster.x + cluster.y * m_GridSize.x + cluster.z * m_GridSize.x * m_GridSize.y;
+}
+
+vector<LightClusters::LightData>& LightClusters::GetLights() { return m_Lights; }
+vector<LightClusters::Cluster>& LightClusters::GetClusters() { return m_Clusters; }
+vector<unsigned int>& LightClusters::GetLightIndices() { return m_LightIndices; }
+
+vector<unsigned int> LightClusters::GetClusterLights(uvec3 clusterPosition)
+{
+	unsigned int index = GetClusterIndex(clusterPosition);
+	if (index >= m_Clusters.size())
+		return {};
+
+	Cluster& cluster = m_Clusters[index];
+	return vector<unsigned int>(
+		m_LightIndices.begin() + cluster.Offset,
+		m_LightIndices.begin() + cluster.Offset + cluster.Count
+	);
+}
+
+bool LightClusters::IsSupported() { return GLAD_GL_VERSION_4_3 != 0; }
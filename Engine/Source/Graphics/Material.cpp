@@ -1,6 +1,5 @@
 #include <spdlog/spdlog.h>
 #include <Yonai/Resource.hpp>
-#include <Yonai/Resource.hpp>
 #include <Yonai/Graphics/Shader.hpp>
 #include <Yonai/Graphics/Texture.hpp>
 #include <Yonai/Graphics/Material.hpp>
@@ -22,6 +21,17 @@ void BindTexture(unsigned int index, string shaderName, ResourceID textureID, Sh
 		glBindTexture(GL_TEXTURE_2D, 0);
 }
 
+/// <summary>
+/// Checks if a texture is assigned and has contents to sample, textures still loading for the first time are skipped
+/// </summary>
+bool HasTexture(ResourceID textureID)
+{
+	if (textureID == InvalidResourceID)
+		return false;
+	Texture* texture = Resource::Get<Texture>(textureID);
+	return !texture || !texture->IsLoading() || texture->IsValid();
+}
+
 Shader* Material::PrepareShader()
 {
 	if (Shader == InvalidResourceID)
@@ -39,11 +49,11 @@ Shader* Material::PrepareShader()
 	shader->Set("metalness", Metalness);
 	shader->Set("transparent", Transparent);
 	
-	shader->Set("hasAlbedoMap", AlbedoMap != InvalidResourceID);
-	shader->Set("hasNormalMap", NormalMap != InvalidResourceID);
-	shader->Set("hasRoughnessMap", RoughnessMap != InvalidResourceID);
-	shader->Set("hasMetalnessMap", MetalnessMap != InvalidResourceID);
-	shader->Set("hasAmbientOcclusionMap", AmbientOcclusionMap != InvalidResourceID);
+	shader->Set("hasAlbedoMap", HasTexture(AlbedoMap));
+	shader->Set("hasNormalMap", HasTexture(NormalMap));
+	shader->Set("hasRoughnessMap", HasTexture(RoughnessMap));
+	shader->Set("hasMetalnessMap", HasTexture(MetalnessMap));
+	shader->Set("hasAmbientOcclusionMap", HasTexture(AmbientOcclusionMap));
 
 	BindTexture(0, "albedoMap", AlbedoMap, shader);
 	BindTexture(1, "normalMap", NormalMap, shader);
@@ -54,6 +64,11 @@ Shader* Material::PrepareShader()
 	return shader;
 }
 
+void Material::UpdateDependencies()
+{
+	Resource::SetDependencies(ID(), { Shader, AlbedoMap, NormalMap, RoughnessMap, MetalnessMap, AmbientOcclusionMap, Source });
+}
+
 #pragma region Internal Calls
 // _Load(string path, out uint resourceID, out IntPtr handle);
 ADD_MANAGED_METHOD(Material, Load, void, (MonoString* pathRaw, uint64_t* resourceID, void** outHandle), Yonai.Graphics)
@@ -67,16 +82,46 @@ ADD_MANAGED_METHOD(Material, Load, void, (MonoString* pathRaw, uint64_t* resourc
 	mono_free(path);
 }
 
-ADD_MANAGED_GET_SET(Material, Shader, uint64_t, Yonai.Graphics)
-ADD_MANAGED_GET_SET(Material, AlbedoMap, uint64_t, Yonai.Graphics)
+ADD_MANAGED_GET(Material, Shader, uint64_t, Yonai.Graphics)
+ADD_MANAGED_METHOD(Material, SetShader, void, (void* handle, uint64_t value), Yonai.Graphics)
+{
+	((Material*)handle)->Shader = value;
+	((Material*)handle)->UpdateDependencies();
+}
+ADD_MANAGED_GET(Material, AlbedoMap, uint64_t, Yonai.Graphics)
+ADD_MANAGED_METHOD(Material, SetAlbedoMap, void, (void* handle, uint64_t value), Yonai.Graphics)
+{
+	((Material*)handle)->AlbedoMap = value;
+	((Material*)handle)->UpdateDependencies();
+}
 ADD_MANAGED_GET_SET(Material, AlphaClipping, bool, Yonai.Graphics)
 ADD_MANAGED_GET_SET(Material, AlphaClipThreshold, float, Yonai.Graphics)
 ADD_MANAGED_GET_SET(Material, Roughness, float, Yonai.Graphics)
-ADD_MANAGED_GET_SET(Material, RoughnessMap, uint64_t, Yonai.Graphics)
+ADD_MANAGED_GET(Material, RoughnessMap, uint64_t, Yonai.Graphics)
+ADD_MANAGED_METHOD(Material, SetRoughnessMap, void, (void* handle, uint64_t value), Yonai.Graphics)
+{
+	((Material*)handle)->RoughnessMap = value;
+	((Material*)handle)->UpdateDependencies();
+}
 ADD_MANAGED_GET_SET(Material, Metalness, float, Yonai.Graphics)
-ADD_MANAGED_GET_SET(Material, MetalnessMap, uint64_t, Yonai.Graphics)
-ADD_MANAGED_GET_SET(Material, NormalMap, uint64_t, Yonai.Graphics)
-ADD_MANAGED_GET_SET(Material, AmbientOcclusionMap, uint64_t, Yonai.Graphics)
+ADD_MANAGED_GET(Material, MetalnessMap, uint64_t, Yonai.Graphics)
+ADD_MANAGED_METHOD(Material, SetMetalnessMap, void, (void* handle, uint64_t value), Yonai.Graphics)
+{
+	((Material*)handle)->MetalnessMap = value;
+	((Material*)handle)->UpdateDependencies();
+}
+ADD_MANAGED_GET(Material, NormalMap, uint64_t, Yonai.Graphics)
+ADD_MANAGED_METHOD(Material, SetNormalMap, void, (void* handle, uint64_t value), Yonai.Graphics)
+{
+	((Material*)handle)->NormalMap = value;
+	((Material*)handle)->UpdateDependencies();
+}
+ADD_MANAGED_GET(Material, AmbientOcclusionMap, uint64_t, Yonai.Graphics)
+ADD_MANAGED_METHOD(Material, SetAmbientOcclusionMap, void, (void* handle, uint64_t value), Yonai.Graphics)
+{
+	((Material*)handle)->AmbientOcclusionMap = value;
+	((Material*)handle)->UpdateDependencies();
+}
 ADD_MANAGED_GET_SET(Material, Transparent, bool, Yonai.Graphics)
 
 ADD_MANAGED_METHOD(Material, GetAlbedo, void, (void* handle, glm::vec4* value), Yonai.Graphics)
@@ -1,15 +1,27 @@
+#include <limits>
+#include <algorithm>
 #include <glad/glad.h>
+#include <spdlog/spdlog.h>
 #include <Yonai/Resource.hpp>
 #include <Yonai/Graphics/Mesh.hpp>
+#include <Yonai/Graphics/MeshArena.hpp>
+#include <Yonai/Graphics/MeshOptimiser.hpp>
 
 using namespace glm;
 using namespace std;
 using namespace Yonai;
 using namespace Yonai::Graphics;
 
-Mesh::Mesh() : m_Vertices(), m_Indices(), m_VAO(GL_INVALID_VALUE), m_VBO(), m_EBO(), m_DrawMode(DrawMode::Triangles)
+MeshArena* Mesh::s_DefaultArena = nullptr;
+
+Mesh::Mesh() : m_Vertices(), m_Indices(), m_VAO(GL_INVALID_VALUE), m_VBO(), m_EBO(), m_DrawMode(DrawMode::Triangles),
+	m_Quantised(false), m_IndexType(GL_UNSIGNED_INT), m_Arena(nullptr), m_ArenaHandle(MeshArena::InvalidHandle),
+	m_LODs({ { 0, 0, numeric_limits<float>::infinity() } }), m_LODIndices(), m_BoundsCentre(0.0f), m_BoundsRadius(0.0f)
 {
-	Setup();
+	if (s_DefaultArena)
+		SetArena(s_DefaultArena);
+	else
+		Setup();
 }
 
 Mesh::Mesh(vector<Vertex> vertices, vector<unsigned int> indices, DrawMode drawMode) : Mesh()
@@ -17,14 +29,24 @@ Mesh::Mesh(vector<Vertex> vertices, vector<unsigned int> indices, DrawMode drawM
 	Import(vertices, indices, drawMode);
 }
 
-Mesh::~Mesh()
+Mesh::~Mesh() { Release(); }
+
+void Mesh::Release()
 {
+	if (m_Arena)
+	{
+		m_Arena->Free(m_ArenaHandle);
+		m_Arena = nullptr;
+		m_ArenaHandle = MeshArena::InvalidHandle;
+	}
+
 	if (m_VAO == GL_INVALID_VALUE)
 		return; // Not set up
 
 	glDeleteBuffers(1, &m_VBO);
 	glDeleteBuffers(1, &m_EBO);
 	glDeleteVertexArrays(1, &m_VAO);
+	m_VAO = GL_INVALID_VALUE;
 }
 
 void Mesh::Import(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices, DrawMode drawMode)
@@ -35,6 +57,19 @@ void Mesh::Import(std::vector<Vertex>& vertices, std::vector<unsigned int>& indi
 	SetVertices(vertices);
 }
 
+void Mesh::Import(vector<Vertex>& vertices, vector<unsigned int>& indices, const vector<vector<unsigned int>>& lods, DrawMode drawMode)
+{
+	m_DrawMode = drawMode;
+
+	// Levels of detail share the index buffer, build them first so indices are only uploaded once
+	m_Indices = indices;
+	SetVertices(vertices);
+	BuildLODs(lods, {});
+
+	if (!m_Arena)
+		UploadIndices();
+}
+
 void Mesh::Setup()
 {
 	// Generate buffers
@@ -47,25 +82,47 @@ void Mesh::Setup()
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
 
 	// Vertex data layout
-	// Position
 	glEnableVertexAttribArray(0);
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
-	// Normal
 	glEnableVertexAttribArray(1);
-	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Normal));
-	// Texture Coords
 	glEnableVertexAttribArray(2);
-	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, TexCoords));
+	if (m_Quantised)
+	{
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(PackedVertex), (void*)0);
+		glVertexAttribPointer(1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, sizeof(PackedVertex), (void*)offsetof(PackedVertex, Normal));
+		glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, sizeof(PackedVertex), (void*)offsetof(PackedVertex, TexCoords));
+	}
+	else
+	{
+		// Position
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
+		// Normal
+		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Normal));
+		// Texture Coords
+		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, TexCoords));
+	}
 
 	// Unbind VAO to prevent data being overriden accidentally
 	glBindVertexArray(0);
 }
 
-void Mesh::Draw()
+void Mesh::Draw() { Draw(0); }
+
+void Mesh::Draw(unsigned int lod)
 {
+	if (m_Arena)
+	{
+		// Arena leaves its vertex array bound, consecutive arena meshes skip rebinding
+		m_Arena->Draw(m_ArenaHandle, (GLenum)m_DrawMode);
+		return;
+	}
+
 	glBindVertexArray(m_VAO);
 	if (m_Indices.size() > 0)
-		glDrawElements((GLenum)m_DrawMode, (GLsizei)m_Indices.size(), GL_UNSIGNED_INT, 0);
+	{
+		const LOD& level = m_LODs[std::min(lod, (unsigned int)m_LODs.size() - 1)];
+		size_t indexSize = m_IndexType == GL_UNSIGNED_SHORT ? sizeof(uint16_t) : sizeof(unsigned int);
+		glDrawElements((GLenum)m_DrawMode, (GLsizei)level.IndexCount, m_IndexType, (void*)(level.FirstIndex * indexSize));
+	}
 	else
 		glDrawArrays((GLenum)m_DrawMode, 0, (GLint)m_Vertices.size());
 	glBindVertexArray(0);
@@ -78,22 +135,220 @@ void Mesh::SetVertices(vector<Vertex>& vertices)
 {
 	m_Vertices = vertices;
 
+	// Sphere around the centre of the bounding box, slightly larger than optimal but stable
+	m_BoundsCentre = vec3(0.0f);
+	m_BoundsRadius = 0.0f;
+	if (!m_Vertices.empty())
+	{
+		vec3 boundsMin = m_Vertices[0].Position, boundsMax = m_Vertices[0].Position;
+		for (const Vertex& vertex : m_Vertices)
+		{
+			boundsMin = glm::min(boundsMin, vertex.Position);
+			boundsMax = glm::max(boundsMax, vertex.Position);
+		}
+		m_BoundsCentre = (boundsMin + boundsMax) * 0.5f;
+		for (const Vertex& vertex : m_Vertices)
+			m_BoundsRadius = std::max(m_BoundsRadius, distance(m_BoundsCentre, vertex.Position));
+	}
+
+	if (m_Arena)
+	{
+		m_Arena->Update(m_ArenaHandle, m_Vertices, m_Indices);
+		return;
+	}
+
 	glBindVertexArray(m_VAO);
-	glBufferData(GL_ARRAY_BUFFER, m_Vertices.size() * sizeof(Vertex), &m_Vertices[0], GL_STATIC_DRAW);
+	if (m_Quantised)
+	{
+		vector<PackedVertex> packed(m_Vertices.size());
+		for (size_t i = 0; i < m_Vertices.size(); i++)
+			packed[i] = MeshOptimiser::Pack(m_Vertices[i]);
+		glBufferData(GL_ARRAY_BUFFER, packed.size() * sizeof(PackedVertex), packed.data(), GL_STATIC_DRAW);
+	}
+	else
+		glBufferData(GL_ARRAY_BUFFER, m_Vertices.size() * sizeof(Vertex), m_Vertices.data(), GL_STATIC_DRAW);
 	glBindVertexArray(0);
 }
 
 void Mesh::SetIndices(vector<unsigned int>& indices)
 {
 	m_Indices = indices;
+
+	// Previous levels of detail may reference removed vertices
+	m_LODIndices.clear();
+	m_LODs = { { 0, (unsigned int)m_Indices.size(), numeric_limits<float>::infinity() } };
+
+	if (m_Arena)
+	{
+		m_Arena->Update(m_ArenaHandle, m_Vertices, m_Indices);
+		return;
+	}
+
+	UploadIndices();
+}
+
+void Mesh::UploadIndices()
+{
 	if (m_Indices.empty())
 		return;
 
+	// All levels of detail share the index buffer, each a range after the full detail indices
+	vector<unsigned int> allIndices;
+	const vector<unsigned int>* uploaded = &m_Indices;
+	if (!m_LODIndices.empty())
+	{
+		allIndices.reserve(m_Indices.size() + m_LODIndices.size());
+		allIndices.insert(allIndices.end(), m_Indices.begin(), m_Indices.end());
+		allIndices.insert(allIndices.end(), m_LODIndices.begin(), m_LODIndices.end());
+		uploaded = &allIndices;
+	}
+
+	m_IndexType = GL_UNSIGNED_INT;
+	if (m_Quantised && *max_element(uploaded->begin(), uploaded->end()) <= UINT16_MAX)
+		m_IndexType = GL_UNSIGNED_SHORT;
+
 	glBindVertexArray(m_VAO);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_Indices.size() * sizeof(unsigned int), &m_Indices[0], GL_STATIC_DRAW);
+	if (m_IndexType == GL_UNSIGNED_SHORT)
+	{
+		vector<uint16_t> shortIndices(uploaded->begin(), uploaded->end());
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, shortIndices.size() * sizeof(uint16_t), shortIndices.data(), GL_STATIC_DRAW);
+	}
+	else
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, uploaded->size() * sizeof(unsigned int), uploaded->data(), GL_STATIC_DRAW);
 	glBindVertexArray(0);
 }
 
+void Mesh::SetLODs(const vector<vector<unsigned int>>& lods, const vector<float>& screenSizes)
+{
+	BuildLODs(lods, screenSizes);
+	if (!m_Arena)
+		UploadIndices();
+}
+
+void Mesh::BuildLODs(const vector<vector<unsigned int>>& lods, const vector<float>& screenSizes)
+{
+	m_LODIndices.clear();
+	m_LODs = { { 0, (unsigned int)m_Indices.size(), numeric_limits<float>::infinity() } };
+	if (m_Indices.empty())
+		return; // Levels of detail are ranges of the index buffer
+
+	float screenSize = 1.0f;
+	for (size_t i = 0; i < lods.size(); i++)
+	{
+		if (lods[i].empty())
+			continue;
+		if (*max_element(lods[i].begin(), lods[i].end()) >= m_Vertices.size())
+		{
+			spdlog::warn("Level of detail {} references vertices outside of mesh, ignoring remaining levels", i + 1);
+			break;
+		}
+
+		screenSize = i < screenSizes.size() ? screenSizes[i] : screenSize * 0.5f;
+		m_LODs.push_back({ (unsigned int)(m_Indices.size() + m_LODIndices.size()), (unsigned int)lods[i].size(), screenSize });
+		m_LODIndices.insert(m_LODIndices.end(), lods[i].begin(), lods[i].end());
+	}
+}
+
+void Mesh::GenerateLODs(unsigned int count, float reduction)
+{
+	if (m_DrawMode != DrawMode::Triangles || m_Indices.empty())
+		return;
+
+	vector<vector<unsigned int>> lods;
+	const vector<unsigned int>* previous = &m_Indices;
+	for (unsigned int i = 0; i < count; i++)
+	{
+		size_t target = (size_t)(previous->size() / 3 * reduction) * 3;
+		vector<unsigned int> lod;
+		MeshOptimiser::Simplify(m_Vertices, *previous, target, lod);
+		if (lod.empty() || lod.size() >= previous->size())
+			break; // No further reduction possible
+
+		lods.emplace_back(std::move(lod));
+		previous = &lods.back();
+	}
+
+	SetLODs(lods);
+}
+
+unsigned int Mesh::GetLODCount() { return (unsigned int)m_LODs.size(); }
+const Mesh::LOD& Mesh::GetLOD(unsigned int level) { return m_LODs[std::min(level, (unsigned int)m_LODs.size() - 1)]; }
+
+unsigned int Mesh::SelectLOD(float screenSize, unsigned int currentLOD, float hysteresis) { return SelectLOD(m_LODs, screenSize, currentLOD, hysteresis); }
+
+unsigned int Mesh::SelectLOD(const vector<LOD>& lods, float screenSize, unsigned int currentLOD, float hysteresis)
+{
+	if (lods.size() <= 1)
+		return 0;
+	currentLOD = std::min(currentLOD, (unsigned int)lods.size() - 1);
+
+	// Switch to a coarser level once screen size is clearly below its threshold
+	unsigned int coarser = 0;
+	for (unsigned int i = 1; i < lods.size(); i++)
+		if (screenSize < lods[i].ScreenSize * (1.0f - hysteresis))
+			coarser = i;
+	if (coarser > currentLOD)
+		return coarser;
+
+	// Switch to a finer level once screen size is clearly above the current level's threshold
+	unsigned int finer = 0;
+	for (unsigned int i = 1; i < lods.size(); i++)
+		if (screenSize < lods[i].ScreenSize * (1.0f + hysteresis))
+			finer = i;
+	return std::min(finer, currentLOD);
+}
+
+vec3 Mesh::GetBoundsCentre() { return m_BoundsCentre; }
+float Mesh::GetBoundsRadius() { return m_BoundsRadius; }
+
+void Mesh::SetArena(MeshArena* arena)
+{
+	if (arena && arena == m_Arena)
+		return; // No change
+	if (!arena && !m_Arena && m_VAO != GL_INVALID_VALUE)
+		return; // Already using own buffers
+
+	Release();
+
+	if (arena)
+	{
+		m_Arena = arena;
+		m_ArenaHandle = arena->Allocate(m_Vertices, m_Indices);
+		return;
+	}
+
+	Setup();
+	UploadIndices();
+	if (!m_Vertices.empty())
+		SetVertices(m_Vertices);
+}
+
+void Mesh::SetQuantised(bool quantised)
+{
+	if (m_Quantised == quantised)
+		return;
+	m_Quantised = quantised;
+
+	if (m_Arena)
+		return; // Arena layout is fixed, applied if the mesh returns to its own buffers
+
+	// Recreate buffers with the new layout
+	Release();
+	Setup();
+	UploadIndices();
+	if (!m_Vertices.empty())
+		SetVertices(m_Vertices);
+}
+
+bool Mesh::IsQuantised() { return m_Quantised; }
+
+MeshArena* Mesh::GetArena() { return m_Arena; }
+unsigned int Mesh::GetArenaHandle() { return m_ArenaHandle; }
+Mesh::DrawMode Mesh::GetDrawMode() { return m_DrawMode; }
+
+void Mesh::SetDefaultArena(MeshArena* arena) { s_DefaultArena = arena; }
+MeshArena* Mesh::GetDefaultArena() { return s_DefaultArena; }
+
 ResourceID QuadID = InvalidResourceID;
 ResourceID CubeID = InvalidResourceID;
 ResourceID SphereID = InvalidResourceID;
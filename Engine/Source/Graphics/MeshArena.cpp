@@ -0,0 +1,407 @@
+#include <algorithm>
+#include <glad/glad.h>
+#include <spdlog/spdlog.h>
+#include <Yonai/Graphics/MeshArena.hpp>
+
+using namespace std;
+using namespace Yonai;
+using namespace Yonai::Graphics;
+
+#pragma region RangeAllocator
+RangeAllocator::RangeAllocator(unsigned int capacity) : m_Used(0), m_Capacity(0) { Grow(capacity); }
+
+void RangeAllocator::AddFreeBlock(unsigned int offset, unsigned int size)
+{
+	if (size == 0)
+		return;
+
+	auto next = m_FreeBlocks.lower_bound(offset);
+
+	// Merge with following block
+	if (next != m_FreeBlocks.end() && offset + size == next->first)
+	{
+		size += next->second;
+		next = m_FreeBlocks.erase(next);
+	}
+
+	// Merge with preceding block
+	if (next != m_FreeBlocks.begin())
+	{
+		auto previous = std::prev(next);
+		if (previous->first + previous->second == offset)
+		{
+			previous->second += size;
+			return;
+		}
+	}
+
+	m_FreeBlocks.emplace(offset, size);
+}
+
+unsigned int RangeAllocator::Allocate(unsigned int size)
+{
+	if (size == 0)
+		return InvalidOffset;
+
+	// First fit, lowest offset keeps allocations packed towards the start of the buffer
+	for (auto it = m_FreeBlocks.begin(); it != m_FreeBlocks.end(); it++)
+	{
+		if (it->second < size)
+			continue;
+
+		unsigned int offset = it->first;
+		unsigned int remaining = it->second - size;
+		m_FreeBlocks.erase(it);
+		if (remaining > 0)
+			m_FreeBlocks.emplace(offset + size, remaining);
+
+		m_Allocations.emplace(offset, size);
+		m_Used += size;
+		return offset;
+	}
+
+	return InvalidOffset;
+}
+
+void RangeAllocator::Free(unsigned int offset)
+{
+	auto it = m_Allocations.find(offset);
+	if (it == m_Allocations.end())
+		return; // Not allocated
+
+	unsigned int size = it->second;
+	m_Allocations.erase(it);
+	m_Used -= size;
+
+	AddFreeBlock(offset, size);
+}
+
+void RangeAllocator::Grow(unsigned int capacity)
+{
+	if (capacity <= m_Capacity)
+		return;
+
+	AddFreeBlock(m_Capacity, capacity - m_Capacity);
+	m_Capacity = capacity;
+}
+
+vector<RangeAllocator::Move> RangeAllocator::Compact()
+{
+	vector<Move> moves;
+	map<unsigned int, unsigned int> allocations;
+
+	// Allocations are ordered by offset, sliding each one down never overlaps a later one
+	unsigned int offset = 0;
+	for (auto& pair : m_Allocations)
+	{
+		if (pair.first != offset)
+			moves.emplace_back(Move { pair.first, offset, pair.second });
+
+		allocations.emplace(offset, pair.second);
+		offset += pair.second;
+	}
+
+	m_Allocations = std::move(allocations);
+	m_FreeBlocks.clear();
+	AddFreeBlock(offset, m_Capacity - offset);
+	return moves;
+}
+
+unsigned int RangeAllocator::GetUsed() { return m_Used; }
+unsigned int RangeAllocator::GetCapacity() { return m_Capacity; }
+unsigned int RangeAllocator::GetFreeBlockCount() { return (unsigned int)m_FreeBlocks.size(); }
+
+unsigned int RangeAllocator::GetLargestFreeBlock()
+{
+	unsigned int largest = 0;
+	for (auto& pair : m_FreeBlocks)
+		largest = std::max(largest, pair.second);
+	return largest;
+}
+
+unsigned int RangeAllocator::GetSize(unsigned int offset)
+{
+	auto it = m_Allocations.find(offset);
+	return it == m_Allocations.end() ? 0 : it->second;
+}
+#pragma endregion
+
+#pragma region MeshArena
+MeshArena::MeshArena(unsigned int vertexCapacity, unsigned int indexCapacity) :
+	m_VAO(GL_INVALID_VALUE), m_VBO(GL_INVALID_VALUE), m_EBO(GL_INVALID_VALUE),
+	m_VertexAllocator(std::max(vertexCapacity, 1u)), m_IndexAllocator(std::max(indexCapacity, 1u))
+{
+	glGenBuffers(1, &m_VBO);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, m_VBO);
+	glBufferData(GL_COPY_WRITE_BUFFER, m_VertexAllocator.GetCapacity() * sizeof(Mesh::Vertex), nullptr, GL_STATIC_DRAW);
+
+	glGenBuffers(1, &m_EBO);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, m_EBO);
+	glBufferData(GL_COPY_WRITE_BUFFER, m_IndexAllocator.GetCapacity() * sizeof(unsigned int), nullptr, GL_STATIC_DRAW);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+	glGenVertexArrays(1, &m_VAO);
+	SetupAttributes();
+}
+
+MeshArena::~MeshArena()
+{
+	if (m_VAO == GL_INVALID_VALUE)
+		return; // Not set up
+
+	// Deleting a bound vertex array reverts the binding to 0
+	glDeleteBuffers(1, &m_VBO);
+	glDeleteBuffers(1, &m_EBO);
+	glDeleteVertexArrays(1, &m_VAO);
+}
+
+void MeshArena::SetupAttributes()
+{
+	// Vertex arrays store the buffer bound at the time of glVertexAttribPointer,
+	// so this needs to be called again whenever the buffers are replaced
+	glBindVertexArray(m_VAO);
+
+	glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+
+	// Vertex data layout, matches Mesh
+	// Position
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Mesh::Vertex), (void*)0);
+	// Normal
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Mesh::Vertex), (void*)offsetof(Mesh::Vertex, Normal));
+	// Texture Coords
+	glEnableVertexAttribArray(2);
+	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Mesh::Vertex), (void*)offsetof(Mesh::Vertex, TexCoords));
+
+	// Unbind VAO to prevent data being overriden accidentally
+	glBindVertexArray(0);
+}
+
+void MeshArena::ReplaceBuffer(unsigned int& buffer, size_t newSize, const vector<RangeAllocator::Move>& copies)
+{
+	unsigned int newBuffer = 0;
+	glGenBuffers(1, &newBuffer);
+
+	// Copy targets don't affect vertex array state
+	glBindBuffer(GL_COPY_WRITE_BUFFER, newBuffer);
+	glBufferData(GL_COPY_WRITE_BUFFER, newSize, nullptr, GL_STATIC_DRAW);
+
+	glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+	for (const RangeAllocator::Move& copy : copies)
+		glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, copy.From, copy.To, copy.Size);
+
+	glBindBuffer(GL_COPY_READ_BUFFER, 0);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+	glDeleteBuffers(1, &buffer);
+	buffer = newBuffer;
+}
+
+unsigned int MeshArena::AllocateVertices(unsigned int count)
+{
+	unsigned int offset = m_VertexAllocator.Allocate(count);
+	if (offset != RangeAllocator::InvalidOffset || count == 0)
+		return offset;
+
+	// Out of space, double capacity until there is a large enough block
+	unsigned int oldCapacity = m_VertexAllocator.GetCapacity();
+	unsigned int capacity = oldCapacity;
+	while (m_VertexAllocator.GetLargestFreeBlock() < count)
+		m_VertexAllocator.Grow(capacity *= 2);
+
+	ReplaceBuffer(m_VBO, capacity * sizeof(Mesh::Vertex), { { 0, 0, (unsigned int)(oldCapacity * sizeof(Mesh::Vertex)) } });
+	SetupAttributes();
+
+	return m_VertexAllocator.Allocate(count);
+}
+
+unsigned int MeshArena::AllocateIndices(unsigned int count)
+{
+	unsigned int offset = m_IndexAllocator.Allocate(count);
+	if (offset != RangeAllocator::InvalidOffset || count == 0)
+		return offset;
+
+	// Out of space, double capacity until there is a large enough block
+	unsigned int oldCapacity = m_IndexAllocator.GetCapacity();
+	unsigned int capacity = oldCapacity;
+	while (m_IndexAllocator.GetLargestFreeBlock() < count)
+		m_IndexAllocator.Grow(capacity *= 2);
+
+	ReplaceBuffer(m_EBO, capacity * sizeof(unsigned int), { { 0, 0, (unsigned int)(oldCapacity * sizeof(unsigned int)) } });
+	SetupAttributes();
+
+	return m_IndexAllocator.Allocate(count);
+}
+
+MeshArena::Handle MeshArena::Allocate(const vector<Mesh::Vertex>& vertices, const vector<unsigned int>& indices)
+{
+	Handle handle;
+	if (!m_FreeHandles.empty())
+	{
+		handle = m_FreeHandles.back();
+		m_FreeHandles.pop_back();
+	}
+	else
+	{
+		handle = (Handle)m_Allocations.size();
+		m_Allocations.emplace_back();
+	}
+
+	m_Allocations[handle].IsValid = true;
+	Update(handle, vertices, indices);
+	return handle;
+}
+
+void MeshArena::Update(Handle handle, const vector<Mesh::Vertex>& vertices, const vector<unsigned int>& indices)
+{
+	if (handle >= m_Allocations.size() || !m_Allocations[handle].IsValid)
+	{
+		spdlog::warn("Cannot update mesh arena allocation, invalid handle {}", handle);
+		return;
+	}
+
+	Allocation& allocation = m_Allocations[handle];
+
+	if (allocation.VertexCount != (unsigned int)vertices.size())
+	{
+		m_VertexAllocator.Free(allocation.BaseVertex);
+		allocation.VertexCount = (unsigned int)vertices.size();
+		allocation.BaseVertex = AllocateVertices(allocation.VertexCount);
+	}
+
+	if (allocation.IndexCount != (unsigned int)indices.size())
+	{
+		m_IndexAllocator.Free(allocation.FirstIndex);
+		allocation.IndexCount = (unsigned int)indices.size();
+		allocation.FirstIndex = AllocateIndices(allocation.IndexCount);
+	}
+
+	if (!vertices.empty())
+	{
+		glBindBuffer(GL_COPY_WRITE_BUFFER, m_VBO);
+		glBufferSubData(GL_COPY_WRITE_BUFFER, allocation.BaseVertex * sizeof(Mesh::Vertex), vertices.size() * sizeof(Mesh::Vertex), vertices.data());
+	}
+
+	if (!indices.empty())
+	{
+		glBindBuffer(GL_COPY_WRITE_BUFFER, m_EBO);
+		glBufferSubData(GL_COPY_WRITE_BUFFER, allocation.FirstIndex * sizeof(unsigned int), indices.size() * sizeof(unsigned int), indices.data());
+	}
+
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+void MeshArena::Free(Handle handle)
+{
+	if (handle >= m_Allocations.size() || !m_Allocations[handle].IsValid)
+		return;
+
+	Allocation& allocation = m_Allocations[handle];
+	m_VertexAllocator.Free(allocation.BaseVertex);
+	m_IndexAllocator.Free(allocation.FirstIndex);
+
+	allocation = Allocation();
+	m_FreeHandles.emplace_back(handle);
+}
+
+void MeshArena::Compact()
+{
+	vector<RangeAllocator::Move> vertexMoves = m_VertexAllocator.Compact();
+	vector<RangeAllocator::Move> indexMoves = m_IndexAllocator.Compact();
+	if (vertexMoves.empty() && indexMoves.empty())
+		return; // Already packed
+
+	// Update allocation offsets
+	map<unsigned int, unsigned int> vertexRemap, indexRemap;
+	for (auto& move : vertexMoves) vertexRemap.emplace(move.From, move.To);
+	for (auto& move : indexMoves)  indexRemap.emplace(move.From, move.To);
+
+	for (Allocation& allocation : m_Allocations)
+	{
+		if (!allocation.IsValid)
+			continue;
+
+		auto it = vertexRemap.find(allocation.BaseVertex);
+		if (it != vertexRemap.end())
+			allocation.BaseVertex = it->second;
+
+		it = indexRemap.find(allocation.FirstIndex);
+		if (it != indexRemap.end())
+			allocation.FirstIndex = it->second;
+	}
+
+	// Copy every live range in to a fresh buffer, unmoved ranges still need to be carried across.
+	// Ranges are converted from elements to bytes
+	auto toByteCopies = [](RangeAllocator& allocator, const vector<RangeAllocator::Move>& moves, size_t elementSize)
+	{
+		map<unsigned int, unsigned int> movedFrom;
+		for (auto& move : moves)
+			movedFrom.emplace(move.To, move.From);
+
+		vector<RangeAllocator::Move> copies;
+		unsigned int offset = 0;
+		while (offset < allocator.GetCapacity())
+		{
+			unsigned int size = allocator.GetSize(offset);
+			if (size == 0)
+				break; // Reached free space at end of compacted range
+
+			auto it = movedFrom.find(offset);
+			unsigned int from = it == movedFrom.end() ? offset : it->second;
+			copies.emplace_back(RangeAllocator::Move
+			{
+				(unsigned int)(from * elementSize),
+				(unsigned int)(offset * elementSize),
+				(unsigned int)(size * elementSize)
+			});
+			offset += size;
+		}
+		return copies;
+	};
+
+	if (!vertexMoves.empty())
+		ReplaceBuffer(m_VBO, m_VertexAllocator.GetCapacity() * sizeof(Mesh::Vertex), toByteCopies(m_VertexAllocator, vertexMoves, sizeof(Mesh::Vertex)));
+	if (!indexMoves.empty())
+		ReplaceBuffer(m_EBO, m_IndexAllocator.GetCapacity() * sizeof(unsigned int), toByteCopies(m_IndexAllocator, indexMoves, sizeof(unsigned int)));
+
+	SetupAttributes();
+}
+
+const MeshArena::Allocation& MeshArena::Get(Handle handle)
+{
+	static const Allocation EmptyAllocation = {};
+	return handle < m_Allocations.size() ? m_Allocations[handle] : EmptyAllocation;
+}
+
+void MeshArena::Bind() { glBindVertexArray(m_VAO); }
+
+void MeshArena::Draw(Handle handle, GLenum drawMode)
+{
+	if (handle >= m_Allocations.size() || !m_Allocations[handle].IsValid)
+		return;
+
+	Allocation& allocation = m_Allocations[handle];
+	if (allocation.VertexCount == 0)
+		return;
+
+	Bind();
+	if (allocation.IndexCount > 0)
+		glDrawElementsBaseVertex(
+			drawMode,
+			(GLsizei)allocation.IndexCount,
+			GL_UNSIGNED_INT,
+			(void*)(size_t)(allocation.FirstIndex * sizeof(unsigned int)),
+			(GLint)allocation.BaseVertex
+		);
+	else
+		glDrawArrays(drawMode, (GLint)allocation.BaseVertex, (GLsizei)allocation.VertexCount);
+}
+
+unsigned int MeshArena::GetVAO() { return m_VAO; }
+unsigned int MeshArena::GetVertexBuffer() { return m_VBO; }
+unsigned int MeshArena::GetIndexBuffer() { return m_EBO; }
+RangeAllocator& MeshArena::GetVertexAllocator() { return m_VertexAllocator; }
+RangeAllocator& MeshArena::GetIndexAllocator() { return m_IndexAllocator; }
+#pragma endregion
@@ -0,0 +1,621 @@
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <unordered_map>
+#include <spdlog/spdlog.h>
+#include <Yonai/Graphics/MeshOptimiser.hpp>
+
+using namespace glm;
+using namespace std;
+using namespace Yonai::Graphics;
+
+#pragma region Vertex Cache
+// Scoring constants from Tom Forsyth's "Linear-Speed Vertex Cache Optimisation"
+const float CacheDecayPower = 1.5f;
+const float LastTriangleScore = 0.75f;
+const float ValenceBoostScale = 2.0f;
+const float ValenceBoostPower = 0.5f;
+
+/// <summary>
+/// Remaining triangle counts above this share the same valence score
+/// </summary>
+const unsigned int MaxValence = 32;
+
+struct VertexScoreTable
+{
+	float Cache[MeshOptimiser::OptimiseCacheSize];
+	float Valence[MaxValence + 1];
+
+	VertexScoreTable()
+	{
+		const unsigned int CacheSize = MeshOptimiser::OptimiseCacheSize;
+		for (unsigned int i = 0; i < CacheSize; i++)
+			Cache[i] = i < 3 ? LastTriangleScore : powf(1.0f - (i - 3) / (float)(CacheSize - 3), CacheDecayPower);
+
+		Valence[0] = 0.0f;
+		for (unsigned int i = 1; i <= MaxValence; i++)
+			Valence[i] = ValenceBoostScale * powf((float)i, -ValenceBoostPower);
+	}
+
+	float Get(int cachePosition, unsigned int remainingTriangles) const
+	{
+		if (remainingTriangles == 0)
+			return -1.0f; // Vertex is no longer used
+		return (cachePosition >= 0 ? Cache[cachePosition] : 0.0f) + Valence[std::min(remainingTriangles, MaxValence)];
+	}
+};
+
+void MeshOptimiser::OptimiseVertexCache(vector<unsigned int>& indices, size_t vertexCount)
+{
+	static const VertexScoreTable scores;
+	const size_t triangleCount = indices.size() / 3;
+	if (triangleCount == 0 || indices.size() % 3 != 0)
+		return;
+
+	// Count triangles using each vertex
+	vector<unsigned int> remaining(vertexCount, 0);
+	for (unsigned int index : indices)
+	{
+		if (index >= vertexCount)
+		{
+			spdlog::warn("Cannot optimise mesh - index {} is out of range", index);
+			return;
+		}
+		remaining[index]++;
+	}
+
+	// Triangles adjacent to each vertex, vertex v owns adjacency[offsets[v]] onwards
+	vector<unsigned int> offsets(vertexCount + 1, 0);
+	for (size_t i = 0; i < vertexCount; i++)
+		offsets[i + 1] = offsets[i] + remaining[i];
+
+	vector<unsigned int> adjacency(indices.size());
+	{
+		vector<unsigned int> filled(offsets.begin(), offsets.end() - 1);
+		for (size_t i = 0; i < indices.size(); i++)
+			adjacency[filled[indices[i]]++] = (unsigned int)(i / 3);
+	}
+
+	vector<int> cachePositions(vertexCount, -1);
+	vector<float> vertexScores(vertexCount);
+	for (size_t i = 0; i < vertexCount; i++)
+		vertexScores[i] = scores.Get(-1, remaining[i]);
+
+	vector<float> triangleScores(triangleCount);
+	vector<bool> emitted(triangleCount, false);
+	size_t bestTriangle = 0;
+	for (size_t i = 0; i < triangleCount; i++)
+	{
+		triangleScores[i] = vertexScores[indices[i * 3]] + vertexScores[indices[i * 3 + 1]] + vertexScores[indices[i * 3 + 2]];
+		if (triangleScores[i] > triangleScores[bestTriangle])
+			bestTriangle = i;
+	}
+
+	vector<unsigned int> output;
+	output.reserve(indices.size());
+
+	// Cache holds up to 3 extra entries while adding a triangle, these are evicted
+	unsigned int cache[OptimiseCacheSize + 3], newCache[OptimiseCacheSize + 3];
+	unsigned int cacheCount = 0;
+	size_t nextUnemitted = 0;
+
+	while (bestTriangle < triangleCount)
+	{
+		emitted[bestTriangle] = true;
+		const unsigned int* triangle = &indices[bestTriangle * 3];
+		output.insert(output.end(), triangle, triangle + 3);
+
+		// Remove triangle from its vertices' adjacency
+		for (unsigned int i = 0; i < 3; i++)
+		{
+			unsigned int vertex = triangle[i];
+			unsigned int* begin = &adjacency[offsets[vertex]];
+			unsigned int* end = begin + remaining[vertex];
+			unsigned int* it = std::find(begin, end, (unsigned int)bestTriangle);
+			*it = *(end - 1);
+			remaining[vertex]--;
+		}
+
+		// Triangle's vertices move to the front of the cache
+		unsigned int newCount = 0;
+		for (unsigned int i = 0; i < 3; i++)
+			if (std::find(newCache, newCache + newCount, triangle[i]) == newCache + newCount)
+				newCache[newCount++] = triangle[i];
+		for (unsigned int i = 0; i < cacheCount; i++)
+			if (std::find(triangle, triangle + 3, cache[i]) == triangle + 3)
+				newCache[newCount++] = cache[i];
+
+		// Update scores of cached and evicted vertices, and their remaining triangles
+		for (unsigned int i = 0; i < newCount; i++)
+		{
+			unsigned int vertex = newCache[i];
+			cachePositions[vertex] = i < OptimiseCacheSize ? (int)i : -1;
+
+			float score = scores.Get(cachePositions[vertex], remaining[vertex]);
+			float delta = score - vertexScores[vertex];
+			vertexScores[vertex] = score;
+
+			for (unsigned int j = 0; j < remaining[vertex]; j++)
+				triangleScores[adjacency[offsets[vertex] + j]] += delta;
+		}
+
+		cacheCount = std::min(newCount, OptimiseCacheSize);
+		memcpy(cache, newCache, cacheCount * sizeof(unsigned int));
+
+		// Best candidate is a triangle using a cached vertex
+		float bestScore = -1.0f;
+		bestTriangle = triangleCount;
+		for (unsigned int i = 0; i < cacheCount; i++)
+		{
+			unsigned int vertex = cache[i];
+			for (unsigned int j = 0; j < remaining[vertex]; j++)
+			{
+				unsigned int candidate = adjacency[offsets[vertex] + j];
+				if (triangleScores[candidate] > bestScore)
+				{
+					bestScore = triangleScores[candidate];
+					bestTriangle = candidate;
+				}
+			}
+		}
+
+		// No cached candidates, continue from the next triangle not yet emitted
+		if (bestTriangle == triangleCount)
+		{
+			while (nextUnemitted < triangleCount && emitted[nextUnemitted])
+				nextUnemitted++;
+			bestTriangle = nextUnemitted;
+		}
+	}
+
+	indices.swap(output);
+}
+
+float MeshOptimiser::CalculateACMR(const vector<unsigned int>& indices, size_t vertexCount, unsigned int cacheSize)
+{
+	if (indices.size() < 3)
+		return 0.0f;
+
+	// FIFO cache, a vertex is cached if it was added within the last cacheSize misses
+	vector<unsigned int> addedAt(vertexCount, 0);
+	unsigned int time = cacheSize + 1;
+	size_t misses = 0;
+	for (unsigned int index : indices)
+	{
+		if (index >= vertexCount)
+			continue;
+		if (time - addedAt[index] > cacheSize)
+		{
+			addedAt[index] = time++;
+			misses++;
+		}
+	}
+	return misses / (float)(indices.size() / 3);
+}
+#pragma endregion
+
+void MeshOptimiser::OptimiseOverdraw(vector<unsigned int>& indices, const vector<Mesh::Vertex>& vertices)
+{
+	const size_t triangleCount = indices.size() / 3;
+	if (triangleCount < 2 || indices.size() % 3 != 0)
+		return;
+	for (unsigned int index : indices)
+		if (index >= vertices.size())
+			return;
+
+	// Clusters start where all vertices of a triangle miss the cache,
+	// reordering clusters then only adds misses already present at their boundaries
+	vector<size_t> clusterStarts;
+	vector<unsigned int> addedAt(vertices.size(), 0);
+	unsigned int time = DefaultCacheSize + 1;
+	for (size_t i = 0; i < triangleCount; i++)
+	{
+		unsigned int misses = 0;
+		for (unsigned int j = 0; j < 3; j++)
+		{
+			unsigned int index = indices[i * 3 + j];
+			if (time - addedAt[index] > DefaultCacheSize)
+			{
+				addedAt[index] = time++;
+				misses++;
+			}
+		}
+		if (i == 0 || misses == 3)
+			clusterStarts.emplace_back(i);
+	}
+	if (clusterStarts.size() < 2)
+		return;
+	clusterStarts.emplace_back(triangleCount);
+
+	// Area weighted centroid and normal of each cluster
+	const size_t clusterCount = clusterStarts.size() - 1;
+	vector<vec3> centroids(clusterCount, vec3(0.0f)), normals(clusterCount, vec3(0.0f));
+	vector<float> areas(clusterCount, 0.0f);
+	vec3 meshCentroid(0.0f);
+	float meshArea = 0.0f;
+	for (size_t cluster = 0; cluster < clusterCount; cluster++)
+	{
+		for (size_t i = clusterStarts[cluster]; i < clusterStarts[cluster + 1]; i++)
+		{
+			const vec3& a = vertices[indices[i * 3]].Position;
+			const vec3& b = vertices[indices[i * 3 + 1]].Position;
+			const vec3& c = vertices[indices[i * 3 + 2]].Position;
+
+			vec3 normal = cross(b - a, c - a);
+			float area = length(normal);
+			centroids[cluster] += (a + b + c) * (area / 3.0f);
+			normals[cluster] += normal;
+			areas[cluster] += area;
+		}
+		meshCentroid += centroids[cluster];
+		meshArea += areas[cluster];
+	}
+	if (meshArea <= 0.0f)
+		return;
+	meshCentroid /= meshArea;
+
+	// Clusters facing away from the centre are drawn first, as they are more likely to occlude
+	vector<float> sortKeys(clusterCount, 0.0f);
+	vector<size_t> order(clusterCount);
+	for (size_t cluster = 0; cluster < clusterCount; cluster++)
+	{
+		order[cluster] = cluster;
+		float normalLength = length(normals[cluster]);
+		if (areas[cluster] > 0.0f && normalLength > 0.0f)
+			sortKeys[cluster] = dot(centroids[cluster] / areas[cluster] - meshCentroid, normals[cluster] / normalLength);
+	}
+	stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return sortKeys[a] > sortKeys[b]; });
+
+	vector<unsigned int> output;
+	output.reserve(indices.size());
+	for (size_t cluster : order)
+		output.insert(output.end(), indices.begin() + clusterStarts[cluster] * 3, indices.begin() + clusterStarts[cluster + 1] * 3);
+	indices.swap(output);
+}
+
+void MeshOptimiser::OptimiseVertexFetch(vector<Mesh::Vertex>& vertices, vector<unsigned int>& indices)
+{
+	const unsigned int Unused = ~0u;
+	vector<unsigned int> remap(vertices.size(), Unused);
+	vector<Mesh::Vertex> output;
+	output.reserve(vertices.size());
+
+	for (unsigned int index : indices)
+		if (index >= vertices.size())
+			return;
+
+	for (unsigned int& index : indices)
+	{
+		if (remap[index] == Unused)
+		{
+			remap[index] = (unsigned int)output.size();
+			output.emplace_back(vertices[index]);
+		}
+		index = remap[index];
+	}
+	vertices.swap(output);
+}
+
+void MeshOptimiser::Optimise(vector<Mesh::Vertex>& vertices, vector<unsigned int>& indices)
+{
+	if (indices.empty() || indices.size() % 3 != 0)
+		return; // Only triangle lists are optimised
+
+	OptimiseVertexCache(indices, vertices.size());
+	OptimiseOverdraw(indices, vertices);
+	OptimiseVertexFetch(vertices, indices);
+}
+
+#pragma region Simplification
+/// <summary>
+/// Symmetric 4x4 matrix, evaluating to the sum of weighted squared distances from a set of planes
+/// </summary>
+struct Quadric
+{
+	double A00 = 0, A01 = 0, A02 = 0, A03 = 0;
+	double A11 = 0, A12 = 0, A13 = 0;
+	double A22 = 0, A23 = 0;
+	double A33 = 0;
+
+	static Quadric FromPlane(const dvec3& normal, double distance, double weight)
+	{
+		Quadric q;
+		q.A00 = weight * normal.x * normal.x; q.A01 = weight * normal.x * normal.y; q.A02 = weight * normal.x * normal.z; q.A03 = weight * normal.x * distance;
+		q.A11 = weight * normal.y * normal.y; q.A12 = weight * normal.y * normal.z; q.A13 = weight * normal.y * distance;
+		q.A22 = weight * normal.z * normal.z; q.A23 = weight * normal.z * distance;
+		q.A33 = weight * distance * distance;
+		return q;
+	}
+
+	void Add(const Quadric& other)
+	{
+		A00 += other.A00; A01 += other.A01; A02 += other.A02; A03 += other.A03;
+		A11 += other.A11; A12 += other.A12; A13 += other.A13;
+		A22 += other.A22; A23 += other.A23;
+		A33 += other.A33;
+	}
+
+	double Evaluate(const vec3& p) const
+	{
+		double x = p.x, y = p.y, z = p.z;
+		return A00 * x * x + 2 * A01 * x * y + 2 * A02 * x * z + 2 * A03 * x +
+			A11 * y * y + 2 * A12 * y * z + 2 * A13 * y +
+			A22 * z * z + 2 * A23 * z +
+			A33;
+	}
+};
+
+/// <summary>
+/// Maps each vertex to the lowest index of vertices comparing equal over the first size bytes
+/// </summary>
+static vector<unsigned int> GenerateRemap(const vector<Mesh::Vertex>& vertices, size_t size)
+{
+	vector<unsigned int> order(vertices.size());
+	for (unsigned int i = 0; i < order.size(); i++)
+		order[i] = i;
+	stable_sort(order.begin(), order.end(), [&](unsigned int a, unsigned int b) { return memcmp(&vertices[a], &vertices[b], size) < 0; });
+
+	vector<unsigned int> remap(vertices.size());
+	for (size_t i = 0; i < order.size(); i++)
+		remap[order[i]] = (i > 0 && memcmp(&vertices[order[i]], &vertices[order[i - 1]], size) == 0) ? remap[order[i - 1]] : order[i];
+	return remap;
+}
+
+static void RemoveDegenerateTriangles(vector<unsigned int>& indices)
+{
+	size_t write = 0;
+	for (size_t i = 0; i < indices.size(); i += 3)
+	{
+		unsigned int a = indices[i], b = indices[i + 1], c = indices[i + 2];
+		if (a == b || b == c || a == c)
+			continue;
+		indices[write++] = a;
+		indices[write++] = b;
+		indices[write++] = c;
+	}
+	indices.resize(write);
+}
+
+void MeshOptimiser::Simplify(const vector<Mesh::Vertex>& vertices, const vector<unsigned int>& indices, size_t targetIndexCount, vector<unsigned int>& output)
+{
+	output = indices;
+	if (indices.size() % 3 != 0 || indices.size() <= targetIndexCount)
+		return;
+	for (unsigned int index : indices)
+		if (index >= vertices.size())
+			return;
+
+	const size_t vertexCount = vertices.size();
+
+	// Identical vertices are merged, so meshes with separate vertices per triangle can be simplified
+	vector<unsigned int> remap = GenerateRemap(vertices, sizeof(Mesh::Vertex));
+	vector<unsigned int> positionRemap = GenerateRemap(vertices, sizeof(vec3));
+	for (unsigned int& index : output)
+		index = remap[index];
+	RemoveDegenerateTriangles(output);
+
+	// Moving vertices on attribute seams or open borders would tear the surface, these stay in place
+	vector<bool> lockedPositions(vertexCount, false);
+	{
+		vector<unsigned int> wedges(vertexCount, 0);
+		for (size_t i = 0; i < vertexCount; i++)
+			if (remap[i] == i)
+				wedges[positionRemap[i]]++;
+		for (size_t i = 0; i < vertexCount; i++)
+			lockedPositions[i] = wedges[i] > 1;
+
+		unordered_map<uint64_t, unsigned int> edgeUses;
+		auto edgeKey = [&](unsigned int a, unsigned int b)
+		{
+			a = positionRemap[a];
+			b = positionRemap[b];
+			return ((uint64_t)std::min(a, b) << 32) | std::max(a, b);
+		};
+		for (size_t i = 0; i < output.size(); i += 3)
+			for (unsigned int j = 0; j < 3; j++)
+				edgeUses[edgeKey(output[i + j], output[i + (j + 1) % 3])]++;
+		for (size_t i = 0; i < output.size(); i += 3)
+			for (unsigned int j = 0; j < 3; j++)
+			{
+				unsigned int a = output[i + j], b = output[i + (j + 1) % 3];
+				if (edgeUses[edgeKey(a, b)] == 1)
+					lockedPositions[positionRemap[a]] = lockedPositions[positionRemap[b]] = true;
+			}
+	}
+
+	// Area weighted plane quadrics of each vertex's triangles
+	vector<Quadric> quadrics(vertexCount);
+	for (size_t i = 0; i < output.size(); i += 3)
+	{
+		const vec3& a = vertices[output[i]].Position;
+		dvec3 normal = cross(dvec3(vertices[output[i + 1]].Position - a), dvec3(vertices[output[i + 2]].Position - a));
+		double area = length(normal);
+		if (area <= 0.0)
+			continue;
+		normal /= area;
+
+		Quadric quadric = Quadric::FromPlane(normal, -dot(normal, dvec3(a)), area * 0.5);
+		for (unsigned int j = 0; j < 3; j++)
+			quadrics[output[i + j]].Add(quadric);
+	}
+
+	struct Collapse
+	{
+		unsigned int From;
+		unsigned int To;
+		double Cost;
+	};
+	vector<Collapse> collapses;
+	vector<unsigned int> collapsedTo(vertexCount);
+	vector<unsigned int> offsets(vertexCount + 1), adjacency;
+	vector<bool> touched(vertexCount);
+
+	// Each pass performs the cheapest independent collapses, then rebuilds the triangle list
+	while (output.size() > targetIndexCount)
+	{
+		fill(offsets.begin(), offsets.end(), 0);
+		for (unsigned int index : output)
+			offsets[index + 1]++;
+		for (size_t i = 0; i < vertexCount; i++)
+			offsets[i + 1] += offsets[i];
+		adjacency.resize(output.size());
+		{
+			vector<unsigned int> filled(offsets.begin(), offsets.end() - 1);
+			for (size_t i = 0; i < output.size(); i++)
+				adjacency[filled[output[i]]++] = (unsigned int)(i / 3);
+		}
+
+		collapses.clear();
+		for (size_t i = 0; i < output.size(); i += 3)
+			for (unsigned int j = 0; j < 3; j++)
+			{
+				unsigned int a = output[i + j], b = output[i + (j + 1) % 3];
+				const vec3& positionA = vertices[a].Position;
+				const vec3& positionB = vertices[b].Position;
+				if (!lockedPositions[positionRemap[a]])
+					collapses.push_back({ a, b, quadrics[a].Evaluate(positionB) + quadrics[b].Evaluate(positionB) });
+				if (!lockedPositions[positionRemap[b]])
+					collapses.push_back({ b, a, quadrics[a].Evaluate(positionA) + quadrics[b].Evaluate(positionA) });
+			}
+		sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b) { return a.Cost < b.Cost; });
+
+		for (size_t i = 0; i < vertexCount; i++)
+			collapsedTo[i] = (unsigned int)i;
+		fill(touched.begin(), touched.end(), false);
+
+		size_t trianglesToRemove = (output.size() - targetIndexCount + 2) / 3;
+		size_t removed = 0;
+		for (const Collapse& collapse : collapses)
+		{
+			if (removed >= trianglesToRemove)
+				break;
+			if (touched[collapse.From] || touched[collapse.To])
+				continue;
+
+			// Reject collapses flipping any remaining triangle
+			bool flips = false;
+			unsigned int removes = 0;
+			const vec3& target = vertices[collapse.To].Position;
+			for (unsigned int j = offsets[collapse.From]; j < offsets[collapse.From + 1] && !flips; j++)
+			{
+				const unsigned int* triangle = &output[adjacency[j] * 3];
+				if (triangle[0] == collapse.To || triangle[1] == collapse.To || triangle[2] == collapse.To)
+				{
+					removes++;
+					continue;
+				}
+
+				vec3 before[3], after[3];
+				for (unsigned int k = 0; k < 3; k++)
+				{
+					before[k] = vertices[triangle[k]].Position;
+					after[k] = triangle[k] == collapse.From ? target : before[k];
+				}
+				vec3 normalBefore = cross(before[1] - before[0], before[2] - before[0]);
+				vec3 normalAfter = cross(after[1] - after[0], after[2] - after[0]);
+				flips = dot(normalBefore, normalAfter) <= 0.0f;
+			}
+			if (flips)
+				continue;
+
+			collapsedTo[collapse.From] = collapse.To;
+			quadrics[collapse.To].Add(quadrics[collapse.From]);
+			removed += removes;
+
+			// Neighbourhood has changed, skip further collapses touching it this pass
+			touched[collapse.From] = touched[collapse.To] = true;
+			for (unsigned int j = offsets[collapse.From]; j < offsets[collapse.From + 1]; j++)
+				for (unsigned int k = 0; k < 3; k++)
+					touched[output[adjacency[j] * 3 + k]] = true;
+		}
+
+		if (removed == 0)
+			break; // Cannot be reduced further
+
+		for (unsigned int& index : output)
+			index = collapsedTo[index];
+		RemoveDegenerateTriangles(output);
+	}
+}
+#pragma endregion
+
+#pragma region Quantisation
+uint32_t MeshOptimiser::PackNormal(const vec3& normal)
+{
+	auto pack = [](float value) { return (uint32_t)((int32_t)roundf(std::clamp(value, -1.0f, 1.0f) * 511.0f) & 0x3FF); };
+	return pack(normal.x) | (pack(normal.y) << 10) | (pack(normal.z) << 20);
+}
+
+vec3 MeshOptimiser::UnpackNormal(uint32_t packed)
+{
+	// Sign extend each 10-bit component
+	auto unpack = [packed](unsigned int shift) { return std::max((int32_t)(packed << (22 - shift)) >> 22, -511) / 511.0f; };
+	return { unpack(0), unpack(10), unpack(20) };
+}
+
+uint16_t MeshOptimiser::ToHalf(float value)
+{
+	uint32_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+
+	uint32_t sign = (bits >> 16) & 0x8000;
+	uint32_t mantissa = bits & 0x7FFFFF;
+	int32_t exponent = (int32_t)((bits >> 23) & 0xFF) - 127 + 15;
+
+	if (((bits >> 23) & 0xFF) == 0xFF)
+		return (uint16_t)(sign | 0x7C00 | (mantissa ? 0x200 : 0)); // Infinity or NaN
+	if (exponent >= 31)
+		return (uint16_t)(sign | 0x7C00); // Overflow to infinity
+
+	if (exponent <= 0)
+	{
+		// Denormalised half, or too small and flushed to zero
+		if (exponent < -10)
+			return (uint16_t)sign;
+
+		mantissa |= 0x800000;
+		uint32_t shift = (uint32_t)(14 - exponent);
+		uint32_t half = mantissa >> shift;
+		uint32_t remainder = mantissa & ((1u << shift) - 1);
+		uint32_t halfway = 1u << (shift - 1);
+		if (remainder > halfway || (remainder == halfway && (half & 1)))
+			half++;
+		return (uint16_t)(sign | half);
+	}
+
+	// Rounding may carry in to the exponent, which is the correctly rounded result
+	uint32_t half = sign | ((uint32_t)exponent << 10) | (mantissa >> 13);
+	uint32_t remainder = mantissa & 0x1FFF;
+	if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1)))
+		half++;
+	return (uint16_t)half;
+}
+
+float MeshOptimiser::FromHalf(uint16_t value)
+{
+	uint32_t sign = (uint32_t)(value & 0x8000) << 16;
+	uint32_t exponent = (value >> 10) & 0x1F;
+	uint32_t mantissa = value & 0x3FF;
+
+	if (exponent == 0)
+	{
+		float denormal = ldexpf((float)mantissa, -24);
+		return sign ? -denormal : denormal;
+	}
+
+	uint32_t bits = sign | (exponent == 31 ? (0xFFu << 23) : ((exponent - 15 + 127) << 23)) | (mantissa << 13);
+	float output;
+	memcpy(&output, &bits, sizeof(output));
+	return output;
+}
+
+Mesh::PackedVertex MeshOptimiser::Pack(const Mesh::Vertex& vertex)
+{
+	return
+	{
+		vertex.Position,
+		PackNormal(vertex.Normal),
+		{ ToHalf(vertex.TexCoords.x), ToHalf(vertex.TexCoords.y) }
+	};
+}
+#pragma endregion
@@ -1,9 +1,13 @@
+#include <cstring>
 #include <spdlog/spdlog.h>
 #include <assimp/Importer.hpp>
 #include <Yonai/Timer.hpp>
 #include <assimp/postprocess.h>
 #include <Yonai/Resource.hpp>
+#include <Yonai/ThreadPool.hpp>
+#include <Yonai/IO/ImportCache.hpp>
 #include <Yonai/Graphics/Model.hpp>
+#include <Yonai/Graphics/MeshOptimiser.hpp>
 #include <Yonai/Graphics/Shader.hpp>
 #include <Yonai/Graphics/Texture.hpp>
 #include <Yonai/Components/Transform.hpp>
@@ -18,7 +22,15 @@ using namespace Yonai::IO;
 using namespace Yonai::Graphics;
 using namespace Yonai::Components;
 
-void Model::Import(string path, vector<unsigned char>& modelData, bool importMaterials)
+bool Model::s_ParallelImport = true;
+
+static ThreadPool& GetImportPool()
+{
+	static ThreadPool pool;
+	return pool;
+}
+
+void Model::Import(string path, IO::ByteSpan modelData, bool importMaterials, bool optimiseMeshes, unsigned int lodCount)
 {
 	if (!m_Path.empty())
 		// Release previous model
@@ -26,6 +38,8 @@ void Model::Import(string path, vector<unsigned char>& modelData, bool importMat
 
 	m_Path = path;
 	m_ImportMaterials = importMaterials;
+	m_OptimiseMeshes = optimiseMeshes;
+	m_LODCount = lodCount;
 
 	Load(modelData);
 }
@@ -43,8 +57,13 @@ void ApplyAssimpTransformation(aiMatrix4x4 transformation, Transform* transform)
 }
 
 bool Model::ImportMaterials() { return m_ImportMaterials; }
+bool Model::OptimiseMeshes() { return m_OptimiseMeshes; }
+unsigned int Model::GetLODCount() { return m_LODCount; }
 vector<ResourceID> Model::GetMeshes() { return m_MeshIDs; }
 
+bool Model::IsParallelImport() { return s_ParallelImport; }
+void Model::SetParallelImport(bool enabled) { s_ParallelImport = enabled; }
+
 void Model::CreateMeshMaterialPair(const MeshData& data, vector<pair<ResourceID, ResourceID>>& output)
 {
 	size_t meshCount = data.MeshIDs.size();
@@ -68,16 +87,11 @@ vector<pair<ResourceID, ResourceID>> Model::GetMeshesAndMaterials()
 	return output;
 } 
 
-void Model::Load(vector<unsigned char>& modelData)
+void Model::Load(IO::ByteSpan modelData)
 {
 	if (m_Path.empty())
 		return;
 
-	Importer importer;
-
-	const aiScene* scene = nullptr;
-	unsigned int postProcessing = aiProcess_Triangulate | aiProcess_FlipUVs;
-
 	if (modelData.size() == 0)
 	{
 		spdlog::error("Failed to load model '{}' - Empty data", m_Path);
@@ -85,7 +99,30 @@ void Model::Load(vector<unsigned char>& modelData)
 	}
 	string extension = filesystem::path(m_Path).extension().string();
 
-	scene = importer.ReadFileFromMemory(
+	// Assimp is only required when the source has changed since it was last imported
+	vector<unsigned char> imported;
+	CachedModel model;
+	if (!ImportCache::Import("Model", modelData, extension, GetImportFlags(m_OptimiseMeshes, m_LODCount), imported) ||
+		!ModelCache::Deserialize(imported, model))
+	{
+		spdlog::error("Failed to load model '{}'", m_Path);
+		return;
+	}
+
+	Build(model);
+}
+
+uint32_t Model::GetImportFlags(bool optimiseMeshes, unsigned int lodCount) { return (optimiseMeshes ? 1 : 0) | (lodCount << 1); }
+
+bool Model::ImportScene(IO::ByteSpan modelData, const string& extension, uint32_t importFlags, CachedModel& output)
+{
+	bool optimise = importFlags & 1;
+	unsigned int lodCount = importFlags >> 1;
+
+	Importer importer;
+	unsigned int postProcessing = aiProcess_Triangulate | aiProcess_FlipUVs;
+
+	const aiScene* scene = importer.ReadFileFromMemory(
 		modelData.data(),
 		modelData.size(),
 		postProcessing,
@@ -94,123 +131,191 @@ void Model::Load(vector<unsigned char>& modelData)
 	// Safety check
 	if (!scene)
 	{
-		spdlog::error("Failed to load model '{}' - {}", m_Path, importer.GetErrorString());
-		return;
+		spdlog::error("Failed to import model - {}", importer.GetErrorString());
+		return false;
 	}
 
-	// Read in meshes
-	m_MeshIDs.reserve(scene->mNumMeshes);
-	for (unsigned int i = 0; i < scene->mNumMeshes; i++)
-		m_MeshIDs.emplace_back(ProcessMesh(scene->mMeshes[i], scene));
+	output.Materials.resize(scene->mNumMaterials);
+	for (unsigned int i = 0; i < scene->mNumMaterials; i++)
+		ProcessMaterial(scene->mMaterials[i], output.Materials[i]);
 
-	m_Root = {};
+	// Each mesh is converted in to its own output, GL resources are created afterwards in mesh order by Build
+	output.Meshes.resize(scene->mNumMeshes);
+	if (s_ParallelImport && scene->mNumMeshes > 1)
+		GetImportPool().ParallelFor(scene->mNumMeshes, [&](size_t i) { ProcessMesh(scene->mMeshes[i], optimise, lodCount, output.Meshes[i]); });
+	else
+		for (unsigned int i = 0; i < scene->mNumMeshes; i++)
+			ProcessMesh(scene->mMeshes[i], optimise, lodCount, output.Meshes[i]);
 
-	// Create mesh data hierarchy
-	ProcessNode(scene->mRootNode, nullptr, scene);
+	ProcessNode(scene->mRootNode, output.Root);
+	return true;
 }
 
-void LoadMaterialTextures(
-	string currentDirectory,
-	aiTextureType textureType,
-	aiMaterial* aiMat,
-	ResourceID& outputID)
+string GetMaterialTexturePath(aiTextureType textureType, aiMaterial* aiMat)
 {
-	int textureCount = aiMat->GetTextureCount(textureType);
-
 	if (aiMat->GetTextureCount(textureType) <= 0)
-	{
-		outputID = InvalidResourceID;
-		return;
-	}
+		return "";
 
 	aiString aiTexturePath;
 	aiMat->GetTexture(textureType, 0, &aiTexturePath);
 
-	string texturePath = currentDirectory + aiTexturePath.C_Str();
+	string texturePath = aiTexturePath.C_Str();
 	replace(texturePath.begin(), texturePath.end(), '\\', '/');
-
-	outputID = Resource::Load<Texture>(texturePath);
+	return texturePath;
 }
 
-ResourceID Model::CreateMaterial(aiMaterial* aiMat)
+void Model::ProcessMaterial(aiMaterial* aiMat, CachedMaterial& output)
 {
-	filesystem::path path(m_Path);
-	string currentDirectory = path.parent_path().string() + "/"; // Get directory of model path
-	string materialName = "Materials/" + path.filename().string() + "/" + aiMat->GetName().C_Str();
-
-	ResourceID materialID = Resource::Load<Material>(materialName);
-	Material* material = Resource::Get<Material>(materialID);
+	output.Name = aiMat->GetName().C_Str();
 
 	// Albedo / Base Colour
-	LoadMaterialTextures(currentDirectory, aiTextureType_DIFFUSE, aiMat, material->AlbedoMap);
-	if (material->AlbedoMap == InvalidResourceID)
-		LoadMaterialTextures(currentDirectory, aiTextureType_BASE_COLOR, aiMat, material->AlbedoMap);
-
-	LoadMaterialTextures(currentDirectory, aiTextureType_NORMALS, aiMat, material->NormalMap);
-	LoadMaterialTextures(currentDirectory, aiTextureType_METALNESS, aiMat, material->MetalnessMap);
-	LoadMaterialTextures(currentDirectory, aiTextureType_DIFFUSE_ROUGHNESS, aiMat, material->RoughnessMap);
-	LoadMaterialTextures(currentDirectory, aiTextureType_AMBIENT_OCCLUSION, aiMat, material->AmbientOcclusionMap);
-
-	return materialID;
+	output.AlbedoMap = GetMaterialTexturePath(aiTextureType_DIFFUSE, aiMat);
+	if (output.AlbedoMap.empty())
+		output.AlbedoMap = GetMaterialTexturePath(aiTextureType_BASE_COLOR, aiMat);
+
+	output.NormalMap = GetMaterialTexturePath(aiTextureType_NORMALS, aiMat);
+	output.MetalnessMap = GetMaterialTexturePath(aiTextureType_METALNESS, aiMat);
+	output.RoughnessMap = GetMaterialTexturePath(aiTextureType_DIFFUSE_ROUGHNESS, aiMat);
+	output.AmbientOcclusionMap = GetMaterialTexturePath(aiTextureType_AMBIENT_OCCLUSION, aiMat);
 }
 
-void Model::ProcessNode(aiNode* node, MeshData* parent, const aiScene* scene)
+void Model::ProcessNode(aiNode* node, CachedNode& output)
 {
-	MeshData meshData = { node->mName.C_Str(), node->mTransformation };
-
-	// Process meshes in node
-	for (unsigned int i = 0; i < node->mNumMeshes; i++)
-	{
-		meshData.MeshIDs.emplace_back(node->mMeshes[i]);
-
-		if (!m_ImportMaterials)
-			continue;
+	output.Name = node->mName.C_Str();
+	memcpy(output.Transformation, &node->mTransformation, sizeof(output.Transformation));
 
-		// Import material
-		aiMaterial* material = scene->mMaterials[scene->mMeshes[node->mMeshes[i]]->mMaterialIndex];
-		meshData.MaterialIDs.emplace_back(CreateMaterial(material));
-	}
+	output.MeshIndices.assign(node->mMeshes, node->mMeshes + node->mNumMeshes);
 
-	// Process mesh's children
+	// Process node's children
+	output.Children.resize(node->mNumChildren);
 	for (unsigned int i = 0; i < node->mNumChildren; i++)
-		ProcessNode(node->mChildren[i], &meshData, scene);
-
-	if (parent)
-		parent->Children.emplace_back(meshData);
-	else
-		m_Root = meshData;
+		ProcessNode(node->mChildren[i], output.Children[i]);
 }
 
-ResourceID Model::ProcessMesh(aiMesh* mesh, const aiScene* scene)
+void Model::ProcessMesh(aiMesh* mesh, bool optimise, unsigned int lodCount, CachedMesh& output)
 {
-	vector<Mesh::Vertex> vertices;
-	vector<unsigned int> indices;
+	output.Name = mesh->mName.C_Str();
+	output.MaterialIndex = mesh->mMaterialIndex;
 
 	// Process vertices
+	output.Vertices.resize(mesh->mNumVertices);
 	for (unsigned int i = 0; i < mesh->mNumVertices; i++)
 	{
-		Mesh::Vertex vertex =
-		{
-			/* Position */ { mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z },
-			/* Normals  */ { mesh->mNormals[i].x, mesh->mNormals[i].y, mesh->mNormals[i].z }
-		};
+		Mesh::Vertex& vertex = output.Vertices[i];
+		vertex.Position = { mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z };
+		vertex.Normal = mesh->mNormals ? vec3{ mesh->mNormals[i].x, mesh->mNormals[i].y, mesh->mNormals[i].z } : vec3(0.0f);
 
 		if (mesh->mTextureCoords[0])
 			vertex.TexCoords = { mesh->mTextureCoords[0][i].x, mesh->mTextureCoords[0][i].y };
 		else
 			vertex.TexCoords = { 0, 0 };
-
-		vertices.emplace_back(vertex);
 	}
 
-	// Process indices
+	// Process indices, faces are triangulated during import
+	output.Indices.clear();
+	output.Indices.reserve((size_t)mesh->mNumFaces * 3);
 	for (unsigned int i = 0; i < mesh->mNumFaces; i++)
-		for (unsigned int j = 0; j < mesh->mFaces[i].mNumIndices; j++)
-			indices.emplace_back(mesh->mFaces[i].mIndices[j]);
+		output.Indices.insert(output.Indices.end(), mesh->mFaces[i].mIndices, mesh->mFaces[i].mIndices + mesh->mFaces[i].mNumIndices);
+
+	if (mesh->mPrimitiveTypes != aiPrimitiveType_TRIANGLE)
+		return;
+
+	if (optimise)
+		MeshOptimiser::Optimise(output.Vertices, output.Indices);
+
+	// Each level is simplified from the previous, halving triangle count
+	output.LODs.clear();
+	const vector<unsigned int>* previous = &output.Indices;
+	for (unsigned int i = 0; i < lodCount; i++)
+	{
+		vector<unsigned int> lod;
+		MeshOptimiser::Simplify(output.Vertices, *previous, previous->size() / 6 * 3, lod);
+		if (lod.empty() || lod.size() >= previous->size())
+			break; // Cannot be reduced further
+
+		if (optimise)
+			MeshOptimiser::OptimiseVertexCache(lod, output.Vertices.size());
+		output.LODs.emplace_back(std::move(lod));
+		previous = &output.LODs.back();
+	}
+}
+
+void Model::Build(CachedModel& model)
+{
+	m_MeshIDs.clear();
+	m_MeshIDs.reserve(model.Meshes.size());
+	ResourceID modelID = Resource::GetID(m_Path);
+	for (CachedMesh& cachedMesh : model.Meshes)
+	{
+		ResourceID meshID = Resource::Load<Mesh>(m_Path + "/Mesh/" + cachedMesh.Name);
+		Mesh* mesh = Resource::Get<Mesh>(meshID);
+		Resource::AddDependency(meshID, modelID);
+
+		// Layout and levels of detail are set before uploading, so data is only uploaded once
+		mesh->SetQuantised(m_OptimiseMeshes);
+		mesh->Import(cachedMesh.Vertices, cachedMesh.Indices, cachedMesh.LODs);
+		m_MeshIDs.emplace_back(meshID);
+	}
+
+	// Materials are created when first used by a node
+	vector<ResourceID> materialIDs(model.Materials.size(), InvalidResourceID);
+
+	m_Root = {};
+	BuildNode(model.Root, model, materialIDs, m_Root);
+}
 
-	return Resource::Load<Mesh>(
-		m_Path + "/Mesh/" + mesh->mName.C_Str(),
-		vertices, indices);
+void Model::BuildNode(const CachedNode& node, const CachedModel& model, vector<ResourceID>& materialIDs, MeshData& output)
+{
+	output.Name = node.Name;
+	memcpy(&output.Transformation, node.Transformation, sizeof(node.Transformation));
+	output.MeshIDs = node.MeshIndices;
+
+	if (m_ImportMaterials)
+	{
+		output.MaterialIDs.reserve(node.MeshIndices.size());
+		for (unsigned int meshIndex : node.MeshIndices)
+		{
+			unsigned int materialIndex = model.Meshes[meshIndex].MaterialIndex;
+			if (materialIndex >= materialIDs.size())
+			{
+				output.MaterialIDs.emplace_back(InvalidResourceID);
+				continue;
+			}
+
+			if (materialIDs[materialIndex] == InvalidResourceID)
+				materialIDs[materialIndex] = CreateMaterial(model.Materials[materialIndex]);
+			output.MaterialIDs.emplace_back(materialIDs[materialIndex]);
+		}
+	}
+
+	output.Children.resize(node.Children.size());
+	for (size_t i = 0; i < node.Children.size(); i++)
+		BuildNode(node.Children[i], model, materialIDs, output.Children[i]);
+}
+
+void LoadMaterialTexture(const string& currentDirectory, const string& texturePath, ResourceID& outputID)
+{
+	outputID = texturePath.empty() ? InvalidResourceID : Resource::Load<Texture>(currentDirectory + texturePath);
+}
+
+ResourceID Model::CreateMaterial(const CachedMaterial& cachedMaterial)
+{
+	filesystem::path path(m_Path);
+	string currentDirectory = path.parent_path().string() + "/"; // Get directory of model path
+	string materialName = "Materials/" + path.filename().string() + "/" + cachedMaterial.Name;
+
+	ResourceID materialID = Resource::Load<Material>(materialName);
+	Material* material = Resource::Get<Material>(materialID);
+
+	LoadMaterialTexture(currentDirectory, cachedMaterial.AlbedoMap, material->AlbedoMap);
+	LoadMaterialTexture(currentDirectory, cachedMaterial.NormalMap, material->NormalMap);
+	LoadMaterialTexture(currentDirectory, cachedMaterial.MetalnessMap, material->MetalnessMap);
+	LoadMaterialTexture(currentDirectory, cachedMaterial.RoughnessMap, material->RoughnessMap);
+	LoadMaterialTexture(currentDirectory, cachedMaterial.AmbientOcclusionMap, material->AmbientOcclusionMap);
+
+	material->Source = Resource::GetID(m_Path);
+	material->UpdateDependencies();
+	return materialID;
 }
 
 
@@ -230,13 +335,10 @@ ADD_MANAGED_METHOD(Model, Load, void, (MonoString* pathRaw, uint64_t* outID, voi
 	mono_free(path);
 }
 
-ADD_MANAGED_METHOD(Model, Import, void, (void* handle, MonoString* filepath, MonoArray* modelData, bool importMaterials), Yonai.Graphics)
+ADD_MANAGED_METHOD(Model, Import, void, (void* handle, MonoString* filepath, MonoArray* modelData, bool importMaterials, bool optimiseMeshes, unsigned int lodCount), Yonai.Graphics)
 {
-	vector<unsigned char> data;
-	data.resize(mono_array_length(modelData));
-	for (size_t i = 0; i < data.size(); i++)
-		data[i] = mono_array_get(modelData, unsigned char, i);
-	((Model*)handle)->Import(mono_string_to_utf8(filepath), data, importMaterials);
+	IO::ByteSpan data(mono_array_addr(modelData, unsigned char, 0), mono_array_length(modelData));
+	((Model*)handle)->Import(mono_string_to_utf8(filepath), data, importMaterials, optimiseMeshes, lodCount);
 }
 
 ADD_MANAGED_METHOD(Model, GetMeshes, void, (void* handle, MonoArray** outMeshIDs, MonoArray** outMaterialIDs), Yonai.Graphics)
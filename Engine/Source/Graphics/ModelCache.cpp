@@ -0,0 +1,223 @@
+#include <cstring>
+#include <Yonai/Graphics/ModelCache.hpp>
+
+using namespace std;
+using namespace Yonai;
+using namespace Yonai::Graphics;
+
+/// <summary>
+/// Start of each cached model
+/// </summary>
+struct ModelCacheHeader
+{
+	uint32_t Magic;
+	uint32_t Version;
+	uint32_t MeshCount;
+	uint32_t MaterialCount;
+};
+
+#pragma region Writing
+static void Write(vector<unsigned char>& output, const void* data, size_t size)
+{
+	if (size == 0)
+		return;
+	size_t offset = output.size();
+	output.resize(offset + size);
+	memcpy(output.data() + offset, data, size);
+}
+
+template<typename T>
+static void Write(vector<unsigned char>& output, const T& value) { Write(output, &value, sizeof(T)); }
+
+static void Write(vector<unsigned char>& output, const string& value)
+{
+	Write(output, (uint32_t)value.size());
+	Write(output, value.data(), value.size());
+}
+
+static void WriteNode(vector<unsigned char>& output, const CachedNode& node)
+{
+	Write(output, node.Name);
+	Write(output, node.Transformation, sizeof(node.Transformation));
+
+	Write(output, (uint32_t)node.MeshIndices.size());
+	Write(output, node.MeshIndices.data(), node.MeshIndices.size() * sizeof(unsigned int));
+
+	Write(output, (uint32_t)node.Children.size());
+	for (const CachedNode& child : node.Children)
+		WriteNode(output, child);
+}
+#pragma endregion
+
+#pragma region Reading
+/// <summary>
+/// Bounds checked reads from a cache file
+/// </summary>
+struct ModelCacheReader
+{
+	IO::ByteSpan Data;
+	size_t Offset = 0;
+
+	bool Read(void* output, size_t size)
+	{
+		if (size > Data.size() - Offset)
+			return false;
+		if (size > 0)
+			memcpy(output, Data.data() + Offset, size);
+		Offset += size;
+		return true;
+	}
+
+	template<typename T>
+	bool Read(T& value) { return Read(&value, sizeof(T)); }
+
+	bool Read(string& value)
+	{
+		uint32_t length;
+		if (!Read(length) || length > Data.size() - Offset)
+			return false;
+		value.assign((const char*)Data.data() + Offset, length);
+		Offset += length;
+		return true;
+	}
+
+	/// <summary>
+	/// Reads a count, checking the remaining data can hold that many elements of elementSize bytes
+	/// </summary>
+	bool ReadCount(uint32_t& count, size_t elementSize)
+	{
+		return Read(count) && (size_t)count * elementSize <= Data.size() - Offset;
+	}
+};
+
+static bool ReadNode(ModelCacheReader& reader, CachedNode& node, unsigned int depth, uint32_t meshCount)
+{
+	if (depth > ModelCache::MaxNodeDepth)
+		return false;
+
+	uint32_t count;
+	if (!reader.Read(node.Name) ||
+		!reader.Read(node.Transformation, sizeof(node.Transformation)) ||
+		!reader.ReadCount(count, sizeof(unsigned int)))
+		return false;
+
+	node.MeshIndices.resize(count);
+	reader.Read(node.MeshIndices.data(), count * sizeof(unsigned int));
+	for (unsigned int index : node.MeshIndices)
+		if (index >= meshCount)
+			return false;
+
+	// Each child is at least a name length and transformation
+	if (!reader.ReadCount(count, sizeof(uint32_t) + sizeof(node.Transformation)))
+		return false;
+
+	node.Children.resize(count);
+	for (CachedNode& child : node.Children)
+		if (!ReadNode(reader, child, depth + 1, meshCount))
+			return false;
+	return true;
+}
+#pragma endregion
+
+void ModelCache::Serialize(const CachedModel& model, vector<unsigned char>& output)
+{
+	output.clear();
+
+	ModelCacheHeader header = { FileMagic, FileVersion, (uint32_t)model.Meshes.size(), (uint32_t)model.Materials.size() };
+	Write(output, header);
+
+	for (const CachedMaterial& material : model.Materials)
+		for (const string* value : { &material.Name, &material.AlbedoMap, &material.NormalMap, &material.MetalnessMap, &material.RoughnessMap, &material.AmbientOcclusionMap })
+			Write(output, *value);
+
+	for (const CachedMesh& mesh : model.Meshes)
+	{
+		Write(output, mesh.Name);
+		Write(output, (uint32_t)mesh.MaterialIndex);
+		Write(output, (uint32_t)mesh.Vertices.size());
+		Write(output, (uint32_t)mesh.Indices.size());
+
+		// Stored in the same layout as the vertex and index buffers
+		Write(output, mesh.Vertices.data(), mesh.Vertices.size() * sizeof(Mesh::Vertex));
+		Write(output, mesh.Indices.data(), mesh.Indices.size() * sizeof(unsigned int));
+
+		Write(output, (uint32_t)mesh.LODs.size());
+		for (const vector<unsigned int>& lod : mesh.LODs)
+		{
+			Write(output, (uint32_t)lod.size());
+			Write(output, lod.data(), lod.size() * sizeof(unsigned int));
+		}
+	}
+
+	WriteNode(output, model.Root);
+}
+
+bool ModelCache::Deserialize(IO::ByteSpan data, CachedModel& output)
+{
+	ModelCacheReader reader = { data };
+
+	ModelCacheHeader header;
+	if (!reader.Read(header) || header.Magic != FileMagic || header.Version != FileVersion)
+		return false;
+
+	output = {};
+
+	// Each material is at least six string lengths
+	if ((size_t)header.MaterialCount * sizeof(uint32_t) * 6 > data.size())
+		return false;
+	output.Materials.resize(header.MaterialCount);
+	for (CachedMaterial& material : output.Materials)
+		for (string* value : { &material.Name, &material.AlbedoMap, &material.NormalMap, &material.MetalnessMap, &material.RoughnessMap, &material.AmbientOcclusionMap })
+			if (!reader.Read(*value))
+				return false;
+
+	// Each mesh is at least a name length, material index, vertex count and index count
+	if ((size_t)header.MeshCount * sizeof(uint32_t) * 4 > data.size())
+		return false;
+	output.Meshes.resize(header.MeshCount);
+	for (CachedMesh& mesh : output.Meshes)
+	{
+		uint32_t materialIndex, vertexCount, indexCount;
+		if (!reader.Read(mesh.Name) ||
+			!reader.Read(materialIndex) ||
+			!reader.Read(vertexCount) ||
+			!reader.Read(indexCount))
+			return false;
+
+		if (header.MaterialCount > 0 && materialIndex >= header.MaterialCount)
+			return false;
+		mesh.MaterialIndex = materialIndex;
+
+		size_t vertexSize = (size_t)vertexCount * sizeof(Mesh::Vertex);
+		size_t indexSize = (size_t)indexCount * sizeof(unsigned int);
+		if (vertexSize + indexSize > data.size() - reader.Offset)
+			return false;
+
+		mesh.Vertices.resize(vertexCount);
+		mesh.Indices.resize(indexCount);
+		reader.Read(mesh.Vertices.data(), vertexSize);
+		reader.Read(mesh.Indices.data(), indexSize);
+
+		for (unsigned int index : mesh.Indices)
+			if (index >= vertexCount)
+				return false;
+
+		uint32_t lodCount;
+		if (!reader.ReadCount(lodCount, sizeof(uint32_t)))
+			return false;
+		mesh.LODs.resize(lodCount);
+		for (vector<unsigned int>& lod : mesh.LODs)
+		{
+			if (!reader.ReadCount(indexCount, sizeof(unsigned int)))
+				return false;
+			lod.resize(indexCount);
+			reader.Read(lod.data(), (size_t)indexCount * sizeof(unsigned int));
+
+			for (unsigned int index : lod)
+				if (index >= vertexCount)
+					return false;
+		}
+	}
+
+	return ReadNode(reader, output.Root, 0, header.MeshCount) && reader.Offset == data.size();
+}
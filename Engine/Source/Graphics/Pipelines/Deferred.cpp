@@ -1,6 +1,8 @@
 #include <Yonai/Time.hpp>
 #include <Yonai/Resource.hpp>
 #include <Yonai/Graphics/Mesh.hpp>
+#include <Yonai/Graphics/Texture.hpp>
+#include <Yonai/Graphics/MeshArena.hpp>
 #include <Yonai/Components/Light.hpp>
 #include <Yonai/Graphics/Material.hpp>
 #include <Yonai/Components/SpriteRenderer.hpp>
@@ -14,8 +16,6 @@ using namespace Yonai::Graphics;
 using namespace Yonai::Components;
 using namespace Yonai::Graphics::Pipelines;
 
-void FillLightInfo(Shader* shader, vector<pair<Light*, Transform*>>& lights);
-
 DeferredRenderPipeline::DeferredRenderPipeline() : RenderPipeline(), m_CurrentCamera(nullptr), m_CurrentResolution(0, 0)
 {
 	FramebufferSpec framebufferSpecs = { Window::GetResolution() };
@@ -40,12 +40,20 @@ DeferredRenderPipeline::DeferredRenderPipeline() : RenderPipeline(), m_CurrentCa
 	};
 	m_LightingFB = new Framebuffer(framebufferSpecs);
 
-	m_LightingShader = Resource::LoadPtr<Shader>("Shaders/Deferred/Lighting",
-		ShaderStageInfo
-		{
-			"/Assets/Shaders/Deferred/Lighting.vert",
-			"/Assets/Shaders/Deferred/Lighting.frag",
-		});
+	// Clustered lights need shader storage buffers, otherwise fall back to a fixed amount of light uniforms
+	m_LightingShader = LightClusters::IsSupported() ?
+		Resource::LoadPtr<Shader>("Shaders/Deferred/Lighting",
+			ShaderStageInfo
+			{
+				"/Assets/Shaders/Deferred/Lighting.vert",
+				"/Assets/Shaders/Deferred/Lighting.frag",
+			}) :
+		Resource::LoadPtr<Shader>("Shaders/Deferred/LightingFixed",
+			ShaderStageInfo
+			{
+				"/Assets/Shaders/Deferred/Lighting.vert",
+				"/Assets/Shaders/Deferred/LightingFixed.frag",
+			});
 
 	// Transparent Forward Pass //
 	m_ForwardFB = new Framebuffer(framebufferSpecs);
@@ -87,7 +95,7 @@ void DeferredRenderPipeline::Draw(Camera* camera)
 	m_CurrentCamera = nullptr;
 }
 
-void DeferredRenderPipeline::DrawMesh(Transform* transform, Mesh* mesh, Shader* shader)
+void DeferredRenderPipeline::DrawMesh(Transform* transform, Mesh* mesh, Shader* shader, unsigned int lod)
 {
 	// Fill shader
 	shader->Set("time", Time::SinceLaunch());
@@ -96,11 +104,8 @@ void DeferredRenderPipeline::DrawMesh(Transform* transform, Mesh* mesh, Shader*
 	m_CurrentCamera->FillShader(shader, m_CurrentResolution);
 	shader->Set("modelMatrix", transform->GetModelMatrix());
 
-	auto lights = m_CurrentCamera->Entity.GetWorld()->GetComponents<Light, Transform>();
-	FillLightInfo(m_LightingShader, lights);
-
 	// Draw mesh
-	mesh->Draw();
+	mesh->Draw(lod);
 
 	// Unbind resources
 	shader->Unbind();
@@ -116,6 +121,10 @@ void DeferredRenderPipeline::MeshPass()
 
 	m_MeshFB->Bind();
 
+	bool indirect = m_SubmissionMode == SubmissionMode::MultiDrawIndirect && IndirectDrawBuilder::IsSupported();
+	if (indirect)
+		m_IndirectBuilder.Begin();
+
 	for (MeshRenderer* renderer : m_CurrentMeshes)
 	{
 		if (renderer->Mesh == InvalidResourceID ||
@@ -123,11 +132,9 @@ void DeferredRenderPipeline::MeshPass()
 			continue; // Invalid parameters
 
 #pragma region Getting pointerrsss
-		Mesh* mesh = Resource::Get<Mesh>(renderer->Mesh);
-		Material* material = Resource::Get<Material>(renderer->Material);
+		Mesh* mesh = renderer->GetMesh();
+		Material* material = renderer->GetMaterial();
 		Transform* transform = renderer->Entity.GetComponent<Transform>();
-		if (!mesh || material)
-			continue; // Invalid parameters
 
 		if (!mesh || !material || !transform ||
 			material->Shader == InvalidResourceID ||
@@ -135,11 +142,60 @@ void DeferredRenderPipeline::MeshPass()
 			continue; // Invalid resource(s), or not opaque
 #pragma endregion
 
-		DrawMesh(transform, mesh, material->PrepareShader());
+		unsigned int lod = renderer->UpdateLOD(mesh, transform, m_CurrentCamera, m_CurrentResolution);
+		if (indirect && mesh->GetArena())
+		{
+			Shader* shader = Resource::Get<Shader>(material->Shader);
+			if (shader && IndirectDrawBuilder::ShaderSupportsIndirect(material->Shader, shader->GetProgram()) &&
+				m_IndirectBuilder.Submit(
+					mesh->GetArena(),
+					mesh->GetArena()->Get(mesh->GetArenaHandle()),
+					material->Shader,
+					renderer->Material,
+					transform->GetModelMatrix(),
+					(GLenum)mesh->GetDrawMode()))
+				continue; // Drawn in DrawIndirect
+		}
+
+		DrawMesh(transform, mesh, material->PrepareShader(), lod);
+	}
+
+	if (indirect)
+	{
+		m_IndirectBuilder.End();
+		DrawIndirect();
 	}
+
 	m_MeshFB->Unbind();
 }
 
+void DeferredRenderPipeline::DrawIndirect()
+{
+	if (m_IndirectBuilder.GetCommands().empty())
+		return;
+
+	m_IndirectBuilder.Upload();
+	for (auto& group : m_IndirectBuilder.GetGroups())
+	{
+		Material* material = Resource::Get<Material>(group.Material);
+		Shader* shader = material ? material->PrepareShader() : nullptr;
+		if (!shader)
+			continue;
+
+		shader->Set("time", Time::SinceLaunch());
+		shader->Set("resolution", m_CurrentResolution);
+		m_CurrentCamera->FillShader(shader, m_CurrentResolution);
+
+		// Shaders read model matrices from the draw data buffer instead of "modelMatrix"
+		shader->Set("drawIndirect", true);
+		m_IndirectBuilder.Draw(group);
+		shader->Set("drawIndirect", false);
+
+		shader->Unbind();
+	}
+	glBindVertexArray(0);
+}
+
 void DeferredRenderPipeline::LightingPass()
 {
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -169,8 +225,16 @@ void DeferredRenderPipeline::LightingPass()
 	m_LightingShader->Set("inputDepth", 4);
 
 	// FILL LIGHT DATA //
+	m_CurrentCamera->FillShader(m_LightingShader, m_CurrentResolution);
 	auto lights = m_CurrentCamera->Entity.GetWorld()->GetComponents<Light, Transform>();
-	FillLightInfo(m_LightingShader, lights);
+	if (LightClusters::IsSupported())
+	{
+		m_LightClusters.Build(m_CurrentCamera, m_CurrentResolution, lights);
+		m_LightClusters.Upload();
+		m_LightClusters.FillShader(m_LightingShader, m_CurrentResolution);
+	}
+	else
+		FillFixedLights(lights);
 
 	// DRAW FULLSCREEN QUAD //
 	Resource::Get<Mesh>(Mesh::Quad())->Draw();
@@ -199,8 +263,8 @@ void DeferredRenderPipeline::ForwardPass()
 			continue; // Invalid parameters
 
 #pragma region Getting pointerrsss
-		Mesh* mesh = Resource::Get<Mesh>(renderer->Mesh);
-		Material* material = Resource::Get<Material>(renderer->Material);
+		Mesh* mesh = renderer->GetMesh();
+		Material* material = renderer->GetMaterial();
 		Transform* transform = renderer->Entity.GetComponent<Transform>();
 
 		if (material->Shader == InvalidResourceID ||
@@ -208,24 +272,28 @@ void DeferredRenderPipeline::ForwardPass()
 			continue; // Invalid shader, or not opaque
 #pragma endregion
 
-		DrawMesh(transform, mesh, material->PrepareShader());
+		unsigned int lod = renderer->UpdateLOD(mesh, transform, m_CurrentCamera, m_CurrentResolution);
+		DrawMesh(transform, mesh, material->PrepareShader(), lod);
 	}
 
 	// Draw sprites
 	vector<SpriteRenderer*> sprites = m_CurrentCamera->Entity.GetWorld()->GetComponents<SpriteRenderer>();
+	m_SpriteBatch.Begin();
 	for (SpriteRenderer* renderer : sprites)
 	{
 		if (renderer->Shader == InvalidResourceID)
 			continue; // Invalid parameters
 
-		Shader* shader = Resource::Get<Shader>(renderer->Shader);
 		Transform* transform = renderer->Entity.GetComponent<Transform>();
+		if (!transform ||
+			!Resource::IsValidType<Shader>(renderer->Shader) ||
+			!Resource::IsValidType<Texture>(renderer->Sprite))
+			continue; // Invalid resource(s)
 
-		if (!shader || !transform)
-			continue; // Invalid parameters
-
-		DrawMesh(transform, m_QuadMesh, shader);
+		m_SpriteBatch.Submit(renderer->Shader, renderer->Sprite, transform->GetModelMatrix(), renderer->Colour);
 	}
+	m_SpriteBatch.End(SpriteBatch::GetShaderTextureSlots);
+	m_SpriteBatch.Draw(m_CurrentCamera, m_CurrentResolution);
 
 	// Draw skybox
 	// DrawSkybox();
@@ -237,20 +305,18 @@ void DeferredRenderPipeline::ForwardPass()
 		m_ForwardFB->CopyAttachmentTo(m_CurrentCamera->RenderTarget);
 }
 
-const unsigned int MaxLights = 4;
-void FillLightInfo(Shader* shader, vector<pair<Light*, Transform*>>& lights)
+void DeferredRenderPipeline::FillFixedLights(vector<pair<Light*, Transform*>>& lights)
 {
-	unsigned int lightIndex = 0;
-	unsigned int lightCount = std::min((unsigned int)lights.size(), MaxLights);
-
-	shader->Set("lightCount", (int)lightCount);
-	for (auto& lightPair : lights)
+	unsigned int lightCount = std::min((unsigned int)lights.size(), MaxFixedLights);
+	m_LightingShader->Set("lightCount", (int)lightCount);
+	for (unsigned int i = 0; i < lightCount; i++)
 	{
-		shader->Set("lights[" + to_string(lightIndex) + "].Colour", lightPair.first->Colour);
-		shader->Set("lights[" + to_string(lightIndex) + "].Radius", lightPair.first->Radius);
-		shader->Set("lights[" + to_string(lightIndex) + "].Position", lightPair.second->GetPosition());
-
-		if (++lightIndex >= MaxLights)
-			break;
+		string prefix = "lights[" + to_string(i) + "].";
+		m_LightingShader->Set(prefix + "Position", lights[i].second->GetGlobalPosition());
+		m_LightingShader->Set(prefix + "Radius", lights[i].first->Radius);
+		m_LightingShader->Set(prefix + "Colour", lights[i].first->Colour);
 	}
-}
\ No newline at end of file
+}
+
+DeferredRenderPipeline::SubmissionMode DeferredRenderPipeline::GetSubmissionMode() { return m_SubmissionMode; }
+void DeferredRenderPipeline::SetSubmissionMode(SubmissionMode mode) { m_SubmissionMode = mode; }
@@ -52,7 +52,7 @@ void ForwardRenderPipeline::Draw(Camera* camera)
 
 Framebuffer* ForwardRenderPipeline::GetOutput() { return m_Framebuffer; }
 
-void DrawMesh(Mesh* mesh, Shader* shader, Transform* transform, Camera* camera, ivec2 resolution)
+void DrawMesh(Mesh* mesh, Shader* shader, Transform* transform, Camera* camera, ivec2 resolution, unsigned int lod)
 {
 	// Fill shader
 	shader->Set("time", Time::SinceLaunch());
@@ -62,7 +62,7 @@ void DrawMesh(Mesh* mesh, Shader* shader, Transform* transform, Camera* camera,
 	shader->Set("modelMatrix", transform->GetModelMatrix());
 
 	// Draw mesh
-	mesh->Draw();
+	mesh->Draw(lod);
 
 	// Unbind resources
 	shader->Unbind();
@@ -93,6 +93,7 @@ void ForwardRenderPipeline::ForwardPass(Camera* camera)
 	glEnable(GL_CULL_FACE);
 	glCullFace(GL_BACK);
 
+	m_SpriteBatch.Begin();
 	for(World* scene : scenes)
 	{
 		vector<MeshRenderer*> meshes = scene->GetComponents<MeshRenderer>();
@@ -105,8 +106,8 @@ void ForwardRenderPipeline::ForwardPass(Camera* camera)
 				continue; // Invalid parameters
 
 	#pragma region Getting pointers
-			Mesh* mesh = Resource::Get<Mesh>(renderer->Mesh);
-			Material* material = Resource::Get<Material>(renderer->Material);
+			Mesh* mesh = renderer->GetMesh();
+			Material* material = renderer->GetMaterial();
 			Transform* transform = renderer->Entity.GetComponent<Transform>();
 
 			if (!mesh || !material || !transform ||
@@ -115,33 +116,31 @@ void ForwardRenderPipeline::ForwardPass(Camera* camera)
 	#pragma endregion
 
 			Shader* shader = material->PrepareShader();
-			DrawMesh(mesh, shader, transform, camera, currentResolution);
+			unsigned int lod = renderer->UpdateLOD(mesh, transform, camera, currentResolution);
+			DrawMesh(mesh, shader, transform, camera, currentResolution, lod);
 		}
 
-		glDisable(GL_CULL_FACE);
-
-		// Draw sprites
+		// Gather sprites
 		vector<SpriteRenderer*> sprites = scene->GetComponents<SpriteRenderer>();
 		for(SpriteRenderer* renderer : sprites)
 		{
 			if (renderer->Shader == InvalidResourceID)
 				continue; // Invalid parameters
 
-			Shader* shader = Resource::Get<Shader>(renderer->Shader);
-			Texture* texture = Resource::Get<Texture>(renderer->Sprite);
 			Transform* transform = renderer->Entity.GetComponent<Transform>();
-
-			if (!shader || !transform || !texture)
+			if (!transform ||
+				!Resource::IsValidType<Shader>(renderer->Shader) ||
+				!Resource::IsValidType<Texture>(renderer->Sprite))
 				continue; // Invalid resource(s)
 
-			shader->Bind();
-			texture->Bind();
-			shader->Set("inputTexture", 0);
-			shader->Set("colour", renderer->Colour);
-
-			DrawMesh(m_QuadMesh, shader, transform, camera, currentResolution);
+			m_SpriteBatch.Submit(renderer->Shader, renderer->Sprite, transform->GetModelMatrix(), renderer->Colour);
 		}
 	}
+	m_SpriteBatch.End(SpriteBatch::GetShaderTextureSlots);
+
+	// Draw sprites
+	glDisable(GL_CULL_FACE);
+	m_SpriteBatch.Draw(camera, currentResolution);
 
 	// Draw skybox
 	// DrawSkybox();
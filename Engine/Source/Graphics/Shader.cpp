@@ -4,12 +4,13 @@
 #include <glad/glad.h>
 #include <spdlog/spdlog.h>
 #include <glm/gtc/type_ptr.hpp>
+#include <Yonai/Resource.hpp>
 #include <Yonai/Graphics/Shader.hpp>
+#include <Yonai/Graphics/ShaderCache.hpp>
 
 using namespace glm;
 using namespace std;
 using namespace Yonai;
-using namespace Yonai::IO;
 using namespace Yonai::Graphics;
 
 // Create a shader from source code
@@ -69,12 +70,15 @@ void Shader::UpdateStages(ShaderStageInfo stageInfo)
 	m_IsDirty = true;
 	m_ShaderStages = stageInfo;
 	CreateShaders();
-}
 
-void Shader::ShaderSourceChangedCallback(std::string path, FileWatchStatus changeType)
-{
-	spdlog::debug("Shader file(s) changed, reloading..");
-	m_IsDirty = true;
+	// Reload shader when any of its stage files change
+	if (ID() != InvalidResourceID)
+		Resource::SetFileDependencies(ID(), {
+			m_ShaderStages.VertexPath,
+			m_ShaderStages.FragmentPath,
+			m_ShaderStages.ComputePath,
+			m_ShaderStages.GeometryPath
+		});
 }
 
 void Shader::CreateShaders()
@@ -83,15 +87,6 @@ void Shader::CreateShaders()
 		return;
 
 	m_IsDirty = false;
-	unsigned int programID = 0;
-
-	vector<GLuint> shaders =
-	{
-		CreateShader(m_ShaderStages.VertexContents, GL_VERTEX_SHADER, "vertex"),
-		CreateShader(m_ShaderStages.FragmentContents, GL_FRAGMENT_SHADER, "fragment"),
-		CreateShader(m_ShaderStages.ComputeContents, GL_COMPUTE_SHADER, "compute"),
-		CreateShader(m_ShaderStages.GeometryContents, GL_GEOMETRY_SHADER, "geometry")
-	};
 
 	// Debug info
 	spdlog::debug("Creating shader with following sources:");
@@ -100,7 +95,33 @@ void Shader::CreateShaders()
 	if (!m_ShaderStages.ComputePath.empty())  spdlog::debug("  Compute:  {}", m_ShaderStages.ComputePath);
 	if (!m_ShaderStages.GeometryPath.empty()) spdlog::debug("  Geometry: {}", m_ShaderStages.GeometryPath);
 
-	const bool invalidShaders = shaders.size() == 0 || shaders[0] == GL_INVALID_VALUE || shaders[1] == GL_INVALID_VALUE;
+	if (m_ShaderStages.VertexContents.empty() || m_ShaderStages.FragmentContents.empty())
+		return;
+
+	// Check for previously linked program
+	const uint64_t cacheKey = ShaderCache::GetKey(m_ShaderStages, ShaderCache::GetDriverString());
+	unsigned int programID = ShaderCache::Load(cacheKey);
+	if (programID != GL_INVALID_VALUE)
+	{
+		Destroy();
+		m_Program = programID;
+		CacheUniformLocations();
+
+		spdlog::debug("Created shader program from cache [{}]", m_Program);
+		return;
+	}
+
+	// Only compile stages that have contents
+	vector<GLuint> shaders;
+	shaders.reserve(4);
+	shaders.emplace_back(CreateShader(m_ShaderStages.VertexContents, GL_VERTEX_SHADER, "vertex"));
+	shaders.emplace_back(CreateShader(m_ShaderStages.FragmentContents, GL_FRAGMENT_SHADER, "fragment"));
+	if (!m_ShaderStages.ComputeContents.empty())
+		shaders.emplace_back(CreateShader(m_ShaderStages.ComputeContents, GL_COMPUTE_SHADER, "compute"));
+	if (!m_ShaderStages.GeometryContents.empty())
+		shaders.emplace_back(CreateShader(m_ShaderStages.GeometryContents, GL_GEOMETRY_SHADER, "geometry"));
+
+	const bool invalidShaders = shaders[0] == GL_INVALID_VALUE || shaders[1] == GL_INVALID_VALUE;
 	programID = invalidShaders ? GL_INVALID_VALUE : glCreateProgram();
 
 	for (GLuint shader : shaders)
@@ -116,6 +137,9 @@ void Shader::CreateShaders()
 	if (invalidShaders)
 		return;
 
+	if (ShaderCache::IsEnabled() && ShaderCache::IsSupported())
+		glProgramParameteri(programID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
 	// Finalise shader program
 	glLinkProgram(programID);
 
@@ -151,6 +175,7 @@ void Shader::CreateShaders()
 	m_Program = programID;
 
 	CacheUniformLocations();
+	ShaderCache::Save(cacheKey, m_Program);
 
 	spdlog::debug("Created shader program successfully [{}]", m_Program);
 }
@@ -226,7 +251,6 @@ ShaderUniform Shader::GetUniformInfo(std::string locationName) const
 }
 
 #pragma region Managed Binding
-#include <Yonai/Resource.hpp>
 #include <Yonai/Scripting/InternalCalls.hpp>
 
 ADD_MANAGED_METHOD(Shader, Load, void, (MonoString* path, uint64_t* outResourceID, void** outHandle), Yonai.Graphics)
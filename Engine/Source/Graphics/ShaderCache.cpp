@@ -0,0 +1,171 @@
+#include <vector>
+#include <cstring>
+#include <filesystem>
+#include <glad/glad.h>
+#include <spdlog/spdlog.h>
+#include <Yonai/Utils.hpp>
+#include <Yonai/IO/Files.hpp>
+#include <Yonai/IO/MappedFile.hpp>
+#include <Yonai/Application.hpp>
+#include <Yonai/Graphics/ShaderCache.hpp>
+
+using namespace std;
+using namespace Yonai;
+using namespace Yonai::Graphics;
+
+namespace fs = std::filesystem;
+
+bool ShaderCache::s_Enabled = true;
+
+/// <summary>
+/// Prepended to each cached program binary
+/// </summary>
+struct ShaderCacheHeader
+{
+	uint32_t Magic;
+	uint32_t Version;
+	uint64_t Key;
+	uint32_t Format;
+	uint32_t Length;
+};
+
+static string GetCachePath(uint64_t key)
+{
+	char filename[32];
+	snprintf(filename, sizeof(filename), "%016llx.bin", (unsigned long long)key);
+	return ShaderCache::GetDirectory() + filename;
+}
+
+uint64_t ShaderCache::GetKey(const ShaderStageInfo& stages, const string& driver)
+{
+	// Stages are hashed along with their length, so moving text between stages changes the key
+	uint64_t key = HashSeed;
+	for (const string* contents : { &stages.VertexContents, &stages.FragmentContents, &stages.ComputeContents, &stages.GeometryContents })
+	{
+		uint64_t length = contents->size();
+		key = Hash(&length, sizeof(length), key);
+		key = Hash(*contents, key);
+	}
+	return Hash(driver, key);
+}
+
+string ShaderCache::GetDriverString()
+{
+	static string driver;
+	if (!driver.empty())
+		return driver;
+
+	const char* vendor = (const char*)glGetString(GL_VENDOR);
+	const char* renderer = (const char*)glGetString(GL_RENDERER);
+	const char* version = (const char*)glGetString(GL_VERSION);
+	if (!vendor || !renderer || !version)
+		return "";
+
+	driver = string(vendor) + "|" + renderer + "|" + version;
+	return driver;
+}
+
+string ShaderCache::GetDirectory() { return Application::GetPersistentDirectory() + "ShaderCache/"; }
+
+unsigned int ShaderCache::Load(uint64_t key)
+{
+	if (!s_Enabled || !IsSupported())
+		return GL_INVALID_VALUE;
+
+	string path = GetCachePath(key);
+	if (!fs::exists(path))
+		return GL_INVALID_VALUE;
+
+	// Binary is uploaded straight from the mapped file
+	IO::MappedFile file(path);
+	IO::ByteSpan contents = file.GetSpan();
+
+	ShaderCacheHeader header;
+	if (contents.size() < sizeof(header))
+	{
+		file.Close();
+		fs::remove(path);
+		return GL_INVALID_VALUE;
+	}
+	memcpy(&header, contents.data(), sizeof(header));
+
+	if (header.Magic != FileMagic ||
+		header.Version != FileVersion ||
+		header.Key != key ||
+		header.Length != contents.size() - sizeof(header))
+	{
+		spdlog::debug("Discarding invalid shader cache entry '{}'", path);
+		file.Close();
+		fs::remove(path);
+		return GL_INVALID_VALUE;
+	}
+
+	GLuint program = glCreateProgram();
+	glProgramBinary(program, header.Format, contents.data() + sizeof(header), (GLsizei)header.Length);
+	file.Close();
+
+	// Drivers reject binaries from different versions or hardware, fallback to compiling from source
+	int success = 0;
+	glGetProgramiv(program, GL_LINK_STATUS, &success);
+	if (!success)
+	{
+		spdlog::debug("Shader cache entry '{}' rejected by driver", path);
+		glDeleteProgram(program);
+		fs::remove(path);
+		return GL_INVALID_VALUE;
+	}
+
+	spdlog::debug("Loaded shader program from cache '{}'", path);
+	return program;
+}
+
+void ShaderCache::Save(uint64_t key, unsigned int program)
+{
+	if (!s_Enabled || !IsSupported() || program == GL_INVALID_VALUE)
+		return;
+
+	int length = 0;
+	glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+	if (length <= 0)
+		return;
+
+	ShaderCacheHeader header = { FileMagic, FileVersion, key, 0, 0 };
+	vector<unsigned char> contents(sizeof(header) + length);
+
+	GLenum format = 0;
+	glGetProgramBinary(program, length, &length, &format, contents.data() + sizeof(header));
+	header.Format = format;
+	header.Length = (uint32_t)length;
+	memcpy(contents.data(), &header, sizeof(header));
+	contents.resize(sizeof(header) + length);
+
+	error_code error;
+	fs::create_directories(GetDirectory(), error);
+	if (error)
+	{
+		spdlog::warn("Failed to create shader cache directory '{}' - {}", GetDirectory(), error.message());
+		return;
+	}
+
+	IO::Write(GetCachePath(key), contents);
+}
+
+void ShaderCache::Clear()
+{
+	error_code error;
+	fs::remove_all(GetDirectory(), error);
+}
+
+bool ShaderCache::IsEnabled() { return s_Enabled; }
+void ShaderCache::SetEnabled(bool enabled) { s_Enabled = enabled; }
+
+bool ShaderCache::IsSupported()
+{
+	static int formatCount = -1;
+	if (GLAD_GL_VERSION_4_1 == 0)
+		return false;
+
+	if (formatCount < 0)
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+	return formatCount > 0;
+}
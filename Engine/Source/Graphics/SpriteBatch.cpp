@@ -0,0 +1,287 @@
+#include <string>
+#include <algorithm>
+#include <glad/glad.h>
+#include <spdlog/spdlog.h>
+#include <Yonai/Time.hpp>
+#include <Yonai/Resource.hpp>
+#include <Yonai/Graphics/Shader.hpp>
+#include <Yonai/Graphics/Texture.hpp>
+#include <Yonai/Components/Camera.hpp>
+#include <Yonai/Graphics/SpriteBatch.hpp>
+
+using namespace glm;
+using namespace std;
+using namespace Yonai;
+using namespace Yonai::Graphics;
+using namespace Yonai::Components;
+
+// Matches the layout of Mesh::Quad
+const vec2 QuadPositions[SpriteBatch::QuadVertexCount] =
+{
+	{  1.0f,  1.0f },
+	{  1.0f, -1.0f },
+	{ -1.0f, -1.0f },
+	{ -1.0f,  1.0f }
+};
+
+const vec2 QuadTexCoords[SpriteBatch::QuadVertexCount] =
+{
+	{ 1.0f, 1.0f },
+	{ 1.0f, 0.0f },
+	{ 0.0f, 0.0f },
+	{ 0.0f, 1.0f }
+};
+
+const unsigned int QuadIndices[SpriteBatch::QuadIndexCount] =
+{
+	0, 1, 3, // Triangle 1
+	1, 2, 3  // Triangle 2
+};
+
+SpriteBatch::SpriteBatch() : m_VAO(GL_INVALID_VALUE), m_VBO(GL_INVALID_VALUE), m_EBO(GL_INVALID_VALUE) { }
+
+SpriteBatch::~SpriteBatch()
+{
+	if (m_VAO == GL_INVALID_VALUE)
+		return; // Not set up
+
+	glDeleteBuffers(1, &m_VBO);
+	glDeleteBuffers(1, &m_EBO);
+	glDeleteVertexArrays(1, &m_VAO);
+}
+
+void SpriteBatch::Begin()
+{
+	m_Building = true;
+	m_Sprites.clear();
+	m_Batches.clear();
+	m_Vertices.clear();
+}
+
+void SpriteBatch::Submit(ResourceID shader, ResourceID texture, const mat4& modelMatrix, const vec4& colour)
+{
+	if (!m_Building)
+	{
+		spdlog::warn("Cannot submit sprite to batch, Begin() has not been called");
+		return;
+	}
+
+	m_Sprites.emplace_back(SpriteInfo { shader, texture, modelMatrix, colour });
+}
+
+void SpriteBatch::End(function<unsigned int(ResourceID)> getTextureSlots)
+{
+	m_Building = false;
+	m_Batches.clear();
+	m_Vertices.clear();
+	m_Vertices.reserve(m_Sprites.size() * QuadVertexCount);
+
+	// Sprites are drawn in submission order so blending stays correct,
+	// only consecutive sprites sharing a shader are merged in to a batch
+	unsigned int textureSlots = MaxTextureSlots;
+	for (unsigned int i = 0; i < (unsigned int)m_Sprites.size(); i++)
+	{
+		SpriteInfo& sprite = m_Sprites[i];
+
+		bool newBatch = m_Batches.empty() || m_Batches.back().Shader != sprite.Shader;
+		if (newBatch)
+			textureSlots = getTextureSlots ? std::max(getTextureSlots(sprite.Shader), 1u) : MaxTextureSlots;
+
+		unsigned int textureSlot = 0;
+		bool newTexture = newBatch;
+		if (!newBatch)
+		{
+			vector<ResourceID>& textures = m_Batches.back().Textures;
+			textureSlot = (unsigned int)(find(textures.begin(), textures.end(), sprite.Texture) - textures.begin());
+			newTexture = textureSlot == (unsigned int)textures.size();
+			if (newTexture && textures.size() >= textureSlots)
+			{
+				newBatch = true; // Out of texture slots
+				textureSlot = 0;
+			}
+		}
+
+		if (newBatch)
+		{
+			Batch batch;
+			batch.Shader = sprite.Shader;
+			batch.FirstSprite = i;
+			m_Batches.emplace_back(batch);
+		}
+
+		Batch& batch = m_Batches.back();
+		if (newTexture)
+			batch.Textures.emplace_back(sprite.Texture);
+
+		for (unsigned int v = 0; v < QuadVertexCount; v++)
+		{
+			vec4 position = sprite.ModelMatrix * vec4(QuadPositions[v].x, QuadPositions[v].y, 0.0f, 1.0f);
+			m_Vertices.emplace_back(Vertex
+			{
+				{ position.x, position.y, position.z },
+				QuadTexCoords[v],
+				sprite.Colour,
+				(float)textureSlot
+			});
+		}
+
+		batch.SpriteCount++;
+	}
+}
+
+void SpriteBatch::Setup()
+{
+	glGenBuffers(1, &m_VBO);
+	glGenBuffers(1, &m_EBO);
+	glGenVertexArrays(1, &m_VAO);
+	glBindVertexArray(m_VAO);
+
+	glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+
+	// Vertex data layout, position and texture coordinates match the Mesh layout
+	// Colour and texture slot use locations not taken by the Mesh or indirect draw layouts
+	// Position
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Position));
+	// Texture Coords
+	glEnableVertexAttribArray(2);
+	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, TexCoords));
+	// Colour
+	glEnableVertexAttribArray(4);
+	glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Colour));
+	// Texture Slot
+	glEnableVertexAttribArray(5);
+	glVertexAttribPointer(5, 1, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, TextureSlot));
+
+	// Unbind VAO to prevent data being overriden accidentally
+	glBindVertexArray(0);
+}
+
+void SpriteBatch::Upload()
+{
+	if (m_VAO == GL_INVALID_VALUE)
+		Setup();
+
+	unsigned int spriteCount = GetSpriteCount();
+	glBindVertexArray(m_VAO);
+
+	// Quad indices never change, only regenerate when more sprites are drawn than previously allocated
+	if (spriteCount > m_IndexCapacity)
+	{
+		m_IndexCapacity = std::max(spriteCount, m_IndexCapacity * 2);
+
+		vector<unsigned int> indices(m_IndexCapacity * QuadIndexCount);
+		for (unsigned int i = 0; i < m_IndexCapacity; i++)
+			for (unsigned int j = 0; j < QuadIndexCount; j++)
+				indices[i * QuadIndexCount + j] = i * QuadVertexCount + QuadIndices[j];
+
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+	if (m_Vertices.size() > m_VertexCapacity)
+	{
+		// Grow buffer
+		m_VertexCapacity = std::max((unsigned int)m_Vertices.size(), m_VertexCapacity * 2);
+		glBufferData(GL_ARRAY_BUFFER, m_VertexCapacity * sizeof(Vertex), nullptr, GL_STREAM_DRAW);
+	}
+	else // Orphan previous buffer, so the driver doesn't wait on last frame's draws
+		glBufferData(GL_ARRAY_BUFFER, m_VertexCapacity * sizeof(Vertex), nullptr, GL_STREAM_DRAW);
+
+	glBufferSubData(GL_ARRAY_BUFFER, 0, m_Vertices.size() * sizeof(Vertex), m_Vertices.data());
+
+	glBindVertexArray(0);
+}
+
+void SpriteBatch::Draw(Camera* camera, ivec2 resolution)
+{
+	if (m_Vertices.empty())
+		return; // Nothing to draw
+
+	Upload();
+
+	glBindVertexArray(m_VAO);
+	for (Batch& batch : m_Batches)
+	{
+		Shader* shader = Resource::Get<Shader>(batch.Shader);
+		if (!shader)
+			continue;
+
+		shader->Bind();
+
+		const vector<int>& samplers = GetSamplerLocations(batch.Shader, shader->GetProgram());
+		for (unsigned int slot = 0; slot < (unsigned int)batch.Textures.size(); slot++)
+		{
+			Texture* texture = Resource::Get<Texture>(batch.Textures[slot]);
+			if (texture)
+				texture->Bind(slot);
+			else
+			{
+				glActiveTexture(GL_TEXTURE0 + slot);
+				glBindTexture(GL_TEXTURE_2D, 0);
+			}
+
+			if (slot < samplers.size())
+				shader->Set(samplers[slot], (int)slot);
+		}
+
+		// Single texture shaders
+		shader->Set("inputTexture", 0);
+
+		// Colour and transform are already applied to vertices
+		shader->Set("colour", vec4(1.0f));
+		shader->Set("modelMatrix", mat4(1.0f));
+
+		shader->Set("time", Time::SinceLaunch());
+		shader->Set("resolution", resolution);
+		camera->FillShader(shader, resolution);
+
+		glDrawElements(
+			GL_TRIANGLES,
+			(GLsizei)(batch.SpriteCount * QuadIndexCount),
+			GL_UNSIGNED_INT,
+			(void*)(size_t)(batch.FirstSprite * QuadIndexCount * sizeof(unsigned int))
+		);
+
+		shader->Unbind();
+	}
+	glBindVertexArray(0);
+}
+
+vector<SpriteBatch::Batch>& SpriteBatch::GetBatches() { return m_Batches; }
+vector<SpriteBatch::Vertex>& SpriteBatch::GetVertices() { return m_Vertices; }
+unsigned int SpriteBatch::GetSpriteCount() { return (unsigned int)m_Sprites.size(); }
+
+unordered_map<ResourceID, SpriteBatch::SamplerLocations> SpriteBatch::s_SamplerLocations = {};
+
+const vector<int>& SpriteBatch::GetSamplerLocations(ResourceID shaderID, unsigned int program)
+{
+	SamplerLocations& cached = s_SamplerLocations[shaderID];
+	if (cached.Program == program)
+		return cached.Locations;
+
+	// Shader was created or recompiled since last cached.
+	// Elements of sampler arrays aren't cached by the shader, query directly
+	cached.Program = program;
+	cached.Locations.clear();
+	for (unsigned int slot = 0; slot < MaxTextureSlots && program != GL_INVALID_VALUE; slot++)
+	{
+		string uniformName = "inputTextures[" + to_string(slot) + "]";
+		int location = glGetUniformLocation(program, uniformName.c_str());
+		if (location < 0)
+			break;
+		cached.Locations.emplace_back(location);
+	}
+	return cached.Locations;
+}
+
+unsigned int SpriteBatch::GetShaderTextureSlots(ResourceID shaderID)
+{
+	Shader* shader = Resource::Get<Shader>(shaderID);
+	if (!shader || shader->GetProgram() == GL_INVALID_VALUE)
+		return 1;
+
+	// Shaders without an "inputTextures" array only sample from "inputTexture"
+	return std::max((unsigned int)GetSamplerLocations(shaderID, shader->GetProgram()).size(), 1u);
+}
@@ -1,14 +1,25 @@
 #define STB_IMAGE_IMPLEMENTATION
 
+#include <cstring>
 #include <glad/glad.h>
 #include <stb_image.h>
 #include <spdlog/spdlog.h>
 #include <Yonai/Graphics/Texture.hpp>
+#include <Yonai/Graphics/TextureLoader.hpp>
+#include <Yonai/Graphics/TextureCooker.hpp>
 
 #ifndef NDEBUG
 #include <Yonai/Timer.hpp>
 #endif
 
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
 using namespace std;
 using namespace Yonai;
 using namespace Yonai::Graphics;
@@ -17,43 +28,115 @@ Texture::Texture() : m_Filter(GL_LINEAR), m_ID(GL_INVALID_VALUE), m_Resolution()
 
 Texture::~Texture()
 {
+	CancelPendingLoad();
+
 	if(m_ID != GL_INVALID_VALUE)
 		glDeleteTextures(1, &m_ID);
 }
 
-bool Texture::Upload(vector<unsigned char>& textureData, bool hdr, int filter)
+void Texture::CancelPendingLoad()
+{
+	if (m_PendingLoad)
+		m_PendingLoad->Cancelled = true;
+	m_PendingLoad = nullptr;
+}
+
+bool Texture::Decode(IO::ByteSpan textureData, bool hdr, TexturePixels& output)
 {
 	if (textureData.empty())
 	{
-		spdlog::warn("Cannot generate texture with empty path");
+		spdlog::warn("Cannot decode texture with empty data");
 		return false;
 	}
 
+	// Flip loaded textures, so OpenGL loads them right way up.
+	// Thread local, as decoding can happen on worker threads
+	stbi_set_flip_vertically_on_load_thread(true);
+
+	output.HDR = hdr;
+	if (!hdr)
+		output.Data = stbi_load_from_memory(textureData.data(), (int)textureData.size(), &output.Resolution.x, &output.Resolution.y, &output.Channels, 0);
+	else
+		output.Data = stbi_loadf_from_memory(textureData.data(), (int)textureData.size(), &output.Resolution.x, &output.Resolution.y, &output.Channels, 0);
+
+	if (!output.Data)
+	{
+		spdlog::warn("Failed to load texture - {}", stbi_failure_reason());
+		return false;
+	}
+	return true;
+}
+
+void Texture::FreePixels(TexturePixels& pixels)
+{
+	if (pixels.Data)
+		stbi_image_free(pixels.Data);
+	pixels.Data = nullptr;
+}
+
+bool Texture::Upload(IO::ByteSpan textureData, bool hdr, int filter)
+{
+	CancelPendingLoad();
+
+	if (TextureCooker::IsCooked(textureData))
+		return UploadCooked(textureData, filter);
+
 #ifndef NDEBUG
 	Timer profileTimer;
 #endif
 
-	// Read image data
-	int width, height, channelCount;
-	void* data = nullptr;
+	TexturePixels pixels;
+	if (!Decode(textureData, hdr, pixels))
+		return false;
 
-	// Flip loaded textures, so OpenGL loads them right way up
-	stbi_set_flip_vertically_on_load(true);
-	
-	if (!m_HDR)
-		data = stbi_load_from_memory(textureData.data(), (int)textureData.size(), &width, &height, &channelCount, 0);
-	else
-		data = stbi_loadf_from_memory(textureData.data(), (int)textureData.size(), &width, &height, &channelCount, 0);
+	bool success = Upload(pixels, filter);
 
-	// Check for validity
-	if (!data)
-	{
-		// Release resources, these are now stored inside OpenGL's texture buffer
-		stbi_image_free(data);
+	// Release resources, these are now stored inside OpenGL's texture buffer
+	FreePixels(pixels);
 
-		spdlog::warn("Failed to load texture - {}", stbi_failure_reason());
+#ifndef NDEBUG
+	profileTimer.Stop();
+	spdlog::debug("Loaded texture ({}x{}) in {}ms {}", m_Resolution.x, m_Resolution.y, profileTimer.ElapsedTime().count(), m_HDR ? "[HDR]" : "");
+#endif
+
+	return success;
+}
+
+void Texture::UploadAsync(vector<unsigned char> textureData, bool hdr, int filter, TextureLoadCallback callback)
+{
+	CancelPendingLoad();
+
+	m_PendingLoad = make_shared<TextureLoadJob>();
+	m_PendingLoad->Target = this;
+	m_PendingLoad->Data = std::move(textureData);
+	m_PendingLoad->HDR = hdr;
+	m_PendingLoad->Filter = filter;
+	m_PendingLoad->Callback = callback;
+
+	TextureLoader::Enqueue(m_PendingLoad);
+}
+
+void Texture::ImportAsync(string path, bool hdr, int filter, TextureLoadCallback callback)
+{
+	CancelPendingLoad();
+
+	m_PendingLoad = make_shared<TextureLoadJob>();
+	m_PendingLoad->Target = this;
+	m_PendingLoad->SourcePath = path;
+	m_PendingLoad->HDR = hdr;
+	m_PendingLoad->Filter = filter;
+	m_PendingLoad->Callback = callback;
+
+	TextureLoader::Enqueue(m_PendingLoad);
+}
+
+bool Texture::Upload(const TexturePixels& pixels, int filter)
+{
+	if (!pixels.Data)
 		return false;
-	}
+
+	m_HDR = pixels.HDR;
+	m_Filter = filter;
 
 	// Generate texture ID
 	if(m_ID == GL_INVALID_VALUE)
@@ -70,7 +153,7 @@ bool Texture::Upload(vector<unsigned char>& textureData, bool hdr, int filter)
 
 	// Get texture format based on channels
 	GLenum internalFormat = GL_INVALID_ENUM, textureFormat = GL_INVALID_ENUM;
-	switch (channelCount)
+	switch (pixels.Channels)
 	{
 	case 1:
 		textureFormat = GL_R;
@@ -87,19 +170,111 @@ bool Texture::Upload(vector<unsigned char>& textureData, bool hdr, int filter)
 	}
 
 	// Fill OpenGL texture data with binary data
-	glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, textureFormat, m_HDR ? GL_FLOAT : GL_UNSIGNED_BYTE, data);
-
-	// Release resources, these are now stored inside OpenGL's texture buffer
-	stbi_image_free(data);
+	glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, pixels.Resolution.x, pixels.Resolution.y, 0, textureFormat, m_HDR ? GL_FLOAT : GL_UNSIGNED_BYTE, pixels.Data);
 
 	// Generate mipmaps
 	glGenerateMipmap(GL_TEXTURE_2D);
 
-	m_Resolution = glm::ivec2(width, height);
+	m_Resolution = pixels.Resolution;
+	return true;
+}
+
+/// <summary>
+/// Checks for S3TC support, required for BC1 & BC3 textures
+/// </summary>
+static bool SupportsS3TC()
+{
+	static int supported = -1;
+	if (supported >= 0)
+		return supported;
+
+	int extensionCount = 0;
+	glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+
+	supported = 0;
+	for (int i = 0; i < extensionCount; i++)
+	{
+		const char* extension = (const char*)glGetStringi(GL_EXTENSIONS, i);
+		if (extension && strcmp(extension, "GL_EXT_texture_compression_s3tc") == 0)
+		{
+			supported = 1;
+			break;
+		}
+	}
+	return supported;
+}
+
+bool Texture::UploadCooked(IO::ByteSpan cookedData, int filter)
+{
+	CookedTextureHeader header;
+	vector<CookedTextureLevel> levels;
+	if (!TextureCooker::Read(cookedData, header, levels))
+	{
+		spdlog::warn("Failed to load cooked texture - invalid or unsupported version");
+		return false;
+	}
+
+	const bool compressed = TextureCooker::IsCompressed(header.Format);
+	if (compressed && !SupportsS3TC())
+	{
+		spdlog::error("Failed to load cooked texture - block compressed textures are not supported by this device");
+		return false;
+	}
+
+#ifndef NDEBUG
+	Timer profileTimer;
+#endif
+
+	// Get texture format
+	GLenum internalFormat = GL_INVALID_ENUM, textureFormat = GL_INVALID_ENUM, type = GL_UNSIGNED_BYTE;
+	switch (header.Format)
+	{
+	case CookedTextureFormat::R8:		internalFormat = GL_R8;		textureFormat = GL_RED;		break;
+	case CookedTextureFormat::RGB8:		internalFormat = GL_RGB8;	textureFormat = GL_RGB;		break;
+	case CookedTextureFormat::RGBA8:	internalFormat = GL_RGBA8;	textureFormat = GL_RGBA;	break;
+	case CookedTextureFormat::R32F:		internalFormat = GL_R16F;	textureFormat = GL_RED;		type = GL_FLOAT; break;
+	case CookedTextureFormat::RGB32F:	internalFormat = GL_RGB16F;	textureFormat = GL_RGB;		type = GL_FLOAT; break;
+	case CookedTextureFormat::RGBA32F:	internalFormat = GL_RGBA16F; textureFormat = GL_RGBA;	type = GL_FLOAT; break;
+	case CookedTextureFormat::BC1:		internalFormat = GL_COMPRESSED_RGB_S3TC_DXT1_EXT;	break;
+	case CookedTextureFormat::BC3:		internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;	break;
+	}
+
+	m_HDR = type == GL_FLOAT;
+	m_Filter = filter;
+
+	// Generate texture ID
+	if (m_ID == GL_INVALID_VALUE)
+		glGenTextures(1, &m_ID);
+	glBindTexture(GL_TEXTURE_2D, m_ID);
+
+	// Set texture parameters
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_Filter);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_Filter);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)header.LevelCount - 1);
+
+	// Rows of cooked levels are tightly packed
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+	for (unsigned int i = 0; i < header.LevelCount; i++)
+	{
+		const CookedTextureLevel& level = levels[i];
+		const unsigned char* levelData = cookedData.data() + level.Offset;
+		if (compressed)
+			glCompressedTexImage2D(GL_TEXTURE_2D, i, internalFormat, level.Width, level.Height, 0, (GLsizei)level.Size, levelData);
+		else
+			glTexImage2D(GL_TEXTURE_2D, i, internalFormat, level.Width, level.Height, 0, textureFormat, type, levelData);
+	}
+
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+	m_Resolution = glm::ivec2(header.Width, header.Height);
 
 #ifndef NDEBUG
 	profileTimer.Stop();
-	spdlog::debug("Loaded texture ({}x{}) in {}ms {}", width, height, profileTimer.ElapsedTime().count(), m_HDR ? "[HDR]" : "");
+	spdlog::debug("Loaded cooked texture ({}x{}, {} levels) in {}ms {}", header.Width, header.Height, header.LevelCount, profileTimer.ElapsedTime().count(), m_HDR ? "[HDR]" : "");
 #endif
 
 	return true;
@@ -109,20 +284,51 @@ bool Texture::GetHDR() { return m_HDR; }
 int Texture::GetFilter() { return m_Filter; }
 unsigned int Texture::GetID() { return m_ID; }
 bool Texture::IsValid() { return m_ID != GL_INVALID_VALUE; }
+bool Texture::IsLoading() { return m_PendingLoad != nullptr; }
 glm::ivec2& Texture::GetResolution() { return m_Resolution; }
 
 void Texture::Bind(unsigned int index)
 {
-	if (m_ID == GL_INVALID_VALUE)
+	// Use placeholder while loading, keeping previous contents bound when reloading
+	unsigned int id = m_ID;
+	if (id == GL_INVALID_VALUE && m_PendingLoad)
+		id = TextureLoader::GetPlaceholder();
+
+	if (id == GL_INVALID_VALUE)
 		return;
 	glActiveTexture(GL_TEXTURE0 + index);
-	glBindTexture(GL_TEXTURE_2D, m_ID);
+	glBindTexture(GL_TEXTURE_2D, id);
 }
 
 #pragma region Managed Binding
 #include <Yonai/Resource.hpp>
+#include <Yonai/Scripting/ScriptEngine.hpp>
 #include <Yonai/Scripting/InternalCalls.hpp>
 
+using namespace Yonai::Scripting;
+
+typedef void (*TextureUploadedManagedFn)(uint64_t, bool, MonoException**);
+
+/// <summary>
+/// Informs scripting side an asynchronous upload has finished, via Texture._OnUploaded
+/// </summary>
+void TextureUploadedManaged(uint64_t resourceID, bool success)
+{
+	if (!ScriptEngine::IsLoaded())
+		return;
+
+	// Method is found on each call, as it changes when the script engine reloads
+	MonoClass* klass = ScriptEngine::GetCoreAssembly()->GetClassFromName("Yonai.Graphics", "Texture");
+	MonoMethod* method = klass ? mono_class_get_method_from_name(klass, "_OnUploaded", 2) : nullptr;
+	if (!method)
+		return;
+
+	MonoException* exception = nullptr;
+	((TextureUploadedManagedFn)mono_method_get_unmanaged_thunk(method))(resourceID, success, &exception);
+	if (exception)
+		mono_print_unhandled_exception((MonoObject*)exception);
+}
+
 ADD_MANAGED_METHOD(Texture, Load, void, (MonoString* pathRaw, uint64_t* outResourceID, void** outHandle), Yonai.Graphics)
 {
 	char* path = mono_string_to_utf8(pathRaw);
@@ -137,14 +343,32 @@ ADD_MANAGED_METHOD(Texture, Load, void, (MonoString* pathRaw, uint64_t* outResou
 
 ADD_MANAGED_METHOD(Texture, Upload, bool, (void* instance, MonoArray* textureDataRaw, bool hdr, int filter), Yonai.Graphics)
 {
-	vector<unsigned char> textureData;
-	textureData.resize(mono_array_length(textureDataRaw));
-	for (size_t i = 0; i < textureData.size(); i++)
-		textureData[i] = mono_array_get(textureDataRaw, unsigned char, i);
-
+	// Decoded directly from the managed array, which is not moved by the GC during an internal call
+	IO::ByteSpan textureData(mono_array_addr(textureDataRaw, unsigned char, 0), mono_array_length(textureDataRaw));
 	return ((Texture*)instance)->Upload(textureData, hdr, filter);
 }
 
+ADD_MANAGED_METHOD(Texture, UploadAsync, void, (void* instance, uint64_t resourceID, MonoArray* textureDataRaw, bool hdr, int filter), Yonai.Graphics)
+{
+	vector<unsigned char> textureData(mono_array_length(textureDataRaw));
+	if (!textureData.empty())
+		memcpy(textureData.data(), mono_array_addr(textureDataRaw, unsigned char, 0), textureData.size());
+
+	((Texture*)instance)->UploadAsync(std::move(textureData), hdr, filter,
+		[resourceID](Texture*, bool success) { TextureUploadedManaged(resourceID, success); });
+}
+
+ADD_MANAGED_METHOD(Texture, ImportAsync, void, (void* instance, uint64_t resourceID, MonoString* pathRaw, bool hdr, int filter), Yonai.Graphics)
+{
+	char* path = mono_string_to_utf8(pathRaw);
+	((Texture*)instance)->ImportAsync(path, hdr, filter,
+		[resourceID](Texture*, bool success) { TextureUploadedManaged(resourceID, success); });
+	mono_free(path);
+}
+
+ADD_MANAGED_METHOD(Texture, IsLoading, bool, (void* instance), Yonai.Graphics)
+{ return ((Texture*)instance)->IsLoading(); }
+
 ADD_MANAGED_METHOD(Texture, Bind, void, (void* instance, unsigned int index), Yonai.Graphics)
 { ((Texture*)instance)->Bind(index); }
 
@@ -0,0 +1,522 @@
+#include <cmath>
+#include <cfloat>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
+#include <spdlog/spdlog.h>
+#include <Yonai/IO/Files.hpp>
+#include <Yonai/IO/MappedFile.hpp>
+#include <Yonai/Graphics/TextureCooker.hpp>
+
+using namespace std;
+using namespace Yonai;
+using namespace Yonai::Graphics;
+
+/// <summary>
+/// Halves an image in each dimension using a box filter, odd edges are clamped
+/// </summary>
+template<typename T>
+static vector<T> Downsample(const vector<T>& input, unsigned int width, unsigned int height, unsigned int channels)
+{
+	unsigned int outputWidth = std::max(width / 2, 1u);
+	unsigned int outputHeight = std::max(height / 2, 1u);
+	vector<T> output((size_t)outputWidth * outputHeight * channels);
+
+	for (unsigned int y = 0; y < outputHeight; y++)
+	{
+		unsigned int y0 = std::min(y * 2, height - 1), y1 = std::min(y * 2 + 1, height - 1);
+		for (unsigned int x = 0; x < outputWidth; x++)
+		{
+			unsigned int x0 = std::min(x * 2, width - 1), x1 = std::min(x * 2 + 1, width - 1);
+			for (unsigned int c = 0; c < channels; c++)
+			{
+				float sum =
+					(float)input[((size_t)y0 * width + x0) * channels + c] +
+					(float)input[((size_t)y0 * width + x1) * channels + c] +
+					(float)input[((size_t)y1 * width + x0) * channels + c] +
+					(float)input[((size_t)y1 * width + x1) * channels + c];
+
+				if constexpr (std::is_floating_point<T>())
+					output[((size_t)y * outputWidth + x) * channels + c] = sum * 0.25f;
+				else
+					output[((size_t)y * outputWidth + x) * channels + c] = (T)std::min(sum * 0.25f + 0.5f, 255.0f);
+			}
+		}
+	}
+	return output;
+}
+
+static size_t AlignOffset(size_t offset) { return (offset + TextureCooker::DataAlignment - 1) & ~(size_t)(TextureCooker::DataAlignment - 1); }
+
+/// <summary>
+/// Converts pixels with any channel count to RGBA
+/// </summary>
+static vector<unsigned char> ToRGBA(const unsigned char* pixels, unsigned int width, unsigned int height, unsigned int channels)
+{
+	vector<unsigned char> output((size_t)width * height * 4);
+	for (size_t i = 0; i < (size_t)width * height; i++)
+	{
+		const unsigned char* input = &pixels[i * channels];
+		unsigned char* pixel = &output[i * 4];
+		switch (channels)
+		{
+		case 1: pixel[0] = pixel[1] = pixel[2] = input[0]; pixel[3] = 255; break;
+		case 2: pixel[0] = pixel[1] = pixel[2] = input[0]; pixel[3] = input[1]; break;
+		case 3: pixel[0] = input[0]; pixel[1] = input[1]; pixel[2] = input[2]; pixel[3] = 255; break;
+		default: memcpy(pixel, input, 4); break;
+		}
+	}
+	return output;
+}
+
+#pragma region Block Compression
+static uint16_t ToRGB565(const float* colour)
+{
+	auto quantise = [](float value, int max) { return (uint16_t)std::clamp((int)(value / 255.0f * max + 0.5f), 0, max); };
+	return (quantise(colour[0], 31) << 11) | (quantise(colour[1], 63) << 5) | quantise(colour[2], 31);
+}
+
+static void FromRGB565(uint16_t value, int* colour)
+{
+	int r = (value >> 11) & 31, g = (value >> 5) & 63, b = value & 31;
+	colour[0] = (r << 3) | (r >> 2);
+	colour[1] = (g << 2) | (g >> 4);
+	colour[2] = (b << 3) | (b >> 2);
+}
+
+/// <summary>
+/// Copies a 4x4 block of RGBA pixels, clamping at image edges
+/// </summary>
+static void ExtractBlock(const unsigned char* rgba, unsigned int width, unsigned int height, unsigned int blockX, unsigned int blockY, unsigned char* block)
+{
+	for (unsigned int y = 0; y < 4; y++)
+	{
+		unsigned int sourceY = std::min(blockY * 4 + y, height - 1);
+		for (unsigned int x = 0; x < 4; x++)
+		{
+			unsigned int sourceX = std::min(blockX * 4 + x, width - 1);
+			memcpy(&block[(y * 4 + x) * 4], &rgba[((size_t)sourceY * width + sourceX) * 4], 4);
+		}
+	}
+}
+
+/// <summary>
+/// Encodes RGB of a block in to 8 bytes. Endpoints are found along the principal axis of the block's colours.
+/// </summary>
+static void CompressColourBlock(const unsigned char* block, unsigned char* output)
+{
+	float mean[3] = { 0, 0, 0 };
+	for (unsigned int i = 0; i < 16; i++)
+		for (unsigned int c = 0; c < 3; c++)
+			mean[c] += block[i * 4 + c] / 16.0f;
+
+	// Covariance, stored as xx, xy, xz, yy, yz, zz
+	float covariance[6] = { 0, 0, 0, 0, 0, 0 };
+	for (unsigned int i = 0; i < 16; i++)
+	{
+		float r = block[i * 4 + 0] - mean[0];
+		float g = block[i * 4 + 1] - mean[1];
+		float b = block[i * 4 + 2] - mean[2];
+		covariance[0] += r * r; covariance[1] += r * g; covariance[2] += r * b;
+		covariance[3] += g * g; covariance[4] += g * b; covariance[5] += b * b;
+	}
+
+	// Power iteration for the principal axis
+	float axis[3] = { 1, 1, 1 };
+	for (unsigned int iteration = 0; iteration < 4; iteration++)
+	{
+		float next[3] =
+		{
+			covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2],
+			covariance[1] * axis[0] + covariance[3] * axis[1] + covariance[4] * axis[2],
+			covariance[2] * axis[0] + covariance[4] * axis[1] + covariance[5] * axis[2]
+		};
+		float length = std::max({ std::abs(next[0]), std::abs(next[1]), std::abs(next[2]) });
+		if (length < 1e-6f)
+			break;
+		for (unsigned int c = 0; c < 3; c++)
+			axis[c] = next[c] / length;
+	}
+
+	// Project colours on to axis, endpoints are the extremes
+	float minProjection = FLT_MAX, maxProjection = -FLT_MAX;
+	for (unsigned int i = 0; i < 16; i++)
+	{
+		float projection =
+			(block[i * 4 + 0] - mean[0]) * axis[0] +
+			(block[i * 4 + 1] - mean[1]) * axis[1] +
+			(block[i * 4 + 2] - mean[2]) * axis[2];
+		minProjection = std::min(minProjection, projection);
+		maxProjection = std::max(maxProjection, projection);
+	}
+
+	float axisLengthSquared = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+	float start[3], end[3];
+	for (unsigned int c = 0; c < 3; c++)
+	{
+		float scale = axisLengthSquared > 0 ? axis[c] / axisLengthSquared : 0.0f;
+		start[c] = std::clamp(mean[c] + maxProjection * scale, 0.0f, 255.0f);
+		end[c] = std::clamp(mean[c] + minProjection * scale, 0.0f, 255.0f);
+	}
+
+	uint16_t colour0 = ToRGB565(start), colour1 = ToRGB565(end);
+
+	// colour0 > colour1 selects 4 colour mode
+	if (colour0 < colour1)
+		std::swap(colour0, colour1);
+
+	int palette[4][3];
+	FromRGB565(colour0, palette[0]);
+	FromRGB565(colour1, palette[1]);
+	for (unsigned int c = 0; c < 3; c++)
+	{
+		palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+		palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+	}
+
+	uint32_t indices = 0;
+	if (colour0 != colour1)
+	{
+		for (unsigned int i = 0; i < 16; i++)
+		{
+			int bestDistance = INT32_MAX;
+			uint32_t bestIndex = 0;
+			for (uint32_t p = 0; p < 4; p++)
+			{
+				int dr = block[i * 4 + 0] - palette[p][0];
+				int dg = block[i * 4 + 1] - palette[p][1];
+				int db = block[i * 4 + 2] - palette[p][2];
+				int distance = dr * dr + dg * dg + db * db;
+				if (distance < bestDistance)
+				{
+					bestDistance = distance;
+					bestIndex = p;
+				}
+			}
+			indices |= bestIndex << (i * 2);
+		}
+	}
+
+	output[0] = colour0 & 0xFF;
+	output[1] = colour0 >> 8;
+	output[2] = colour1 & 0xFF;
+	output[3] = colour1 >> 8;
+	for (unsigned int i = 0; i < 4; i++)
+		output[4 + i] = (indices >> (i * 8)) & 0xFF;
+}
+
+/// <summary>
+/// Encodes alpha of a block in to 8 bytes, using 8 interpolated values between the minimum and maximum
+/// </summary>
+static void CompressAlphaBlock(const unsigned char* block, unsigned char* output)
+{
+	unsigned char alpha0 = 0, alpha1 = 255;
+	for (unsigned int i = 0; i < 16; i++)
+	{
+		alpha0 = std::max(alpha0, block[i * 4 + 3]);
+		alpha1 = std::min(alpha1, block[i * 4 + 3]);
+	}
+
+	uint64_t indices = 0;
+	if (alpha0 != alpha1)
+	{
+		// alpha0 > alpha1 selects 8 value mode
+		int palette[8] = { alpha0, alpha1 };
+		for (int i = 2; i < 8; i++)
+			palette[i] = ((8 - i) * alpha0 + (i - 1) * alpha1) / 7;
+
+		for (unsigned int i = 0; i < 16; i++)
+		{
+			int bestDistance = INT32_MAX;
+			uint64_t bestIndex = 0;
+			for (uint64_t p = 0; p < 8; p++)
+			{
+				int distance = std::abs(block[i * 4 + 3] - palette[p]);
+				if (distance < bestDistance)
+				{
+					bestDistance = distance;
+					bestIndex = p;
+				}
+			}
+			indices |= bestIndex << (i * 3);
+		}
+	}
+
+	output[0] = alpha0;
+	output[1] = alpha1;
+	for (unsigned int i = 0; i < 6; i++)
+		output[2 + i] = (indices >> (i * 8)) & 0xFF;
+}
+
+void TextureCooker::CompressBC1(const unsigned char* rgba, unsigned int width, unsigned int height, unsigned char* output)
+{
+	unsigned char block[16 * 4];
+	unsigned int blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+	for (unsigned int y = 0; y < blocksY; y++)
+		for (unsigned int x = 0; x < blocksX; x++)
+		{
+			ExtractBlock(rgba, width, height, x, y, block);
+			CompressColourBlock(block, &output[((size_t)y * blocksX + x) * 8]);
+		}
+}
+
+void TextureCooker::CompressBC3(const unsigned char* rgba, unsigned int width, unsigned int height, unsigned char* output)
+{
+	unsigned char block[16 * 4];
+	unsigned int blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+	for (unsigned int y = 0; y < blocksY; y++)
+		for (unsigned int x = 0; x < blocksX; x++)
+		{
+			unsigned char* blockOutput = &output[((size_t)y * blocksX + x) * 16];
+			ExtractBlock(rgba, width, height, x, y, block);
+			CompressAlphaBlock(block, blockOutput);
+			CompressColourBlock(block, blockOutput + 8);
+		}
+}
+#pragma endregion
+
+uint32_t TextureCookSettings::GetFlags() const { return (HDR ? 1 : 0) | (GenerateMips ? 2 : 0) | (Compress ? 4 : 0); }
+
+TextureCookSettings TextureCookSettings::FromFlags(uint32_t flags)
+{
+	TextureCookSettings settings;
+	settings.HDR = flags & 1;
+	settings.GenerateMips = flags & 2;
+	settings.Compress = flags & 4;
+	return settings;
+}
+
+bool TextureCooker::Cook(IO::ByteSpan source, const TextureCookSettings& settings, vector<unsigned char>& output)
+{
+	TexturePixels pixels;
+	if (!Texture::Decode(source, settings.HDR, pixels))
+		return false;
+
+	bool success = Cook(pixels, settings, output);
+	Texture::FreePixels(pixels);
+	return success;
+}
+
+bool TextureCooker::Cook(const TexturePixels& pixels, const TextureCookSettings& settings, vector<unsigned char>& output)
+{
+	if (!pixels.Data || pixels.Resolution.x <= 0 || pixels.Resolution.y <= 0 || pixels.Channels <= 0 || pixels.Channels > 4)
+	{
+		spdlog::warn("Cannot cook texture - invalid pixel data");
+		return false;
+	}
+
+	const unsigned int width = (unsigned int)pixels.Resolution.x;
+	const unsigned int height = (unsigned int)pixels.Resolution.y;
+	const unsigned int levelCount = settings.GenerateMips ? GetLevelCount(width, height) : 1;
+	const size_t pixelCount = (size_t)width * height;
+
+	// Two channel images are expanded, as they have no matching upload format
+	unsigned int channels = pixels.Channels == 2 ? 4 : pixels.Channels;
+
+	CookedTextureFormat format;
+	if (pixels.HDR)
+		format = channels == 1 ? CookedTextureFormat::R32F : (channels == 3 ? CookedTextureFormat::RGB32F : CookedTextureFormat::RGBA32F);
+	else if (settings.Compress && channels >= 3)
+		format = channels == 3 ? CookedTextureFormat::BC1 : CookedTextureFormat::BC3;
+	else
+		format = channels == 1 ? CookedTextureFormat::R8 : (channels == 3 ? CookedTextureFormat::RGB8 : CookedTextureFormat::RGBA8);
+
+	// Block compression always reads RGBA
+	if (IsCompressed(format))
+		channels = 4;
+
+	// Lay out header, level table and level data
+	CookedTextureHeader header = { FileMagic, FileVersion, format, width, height, levelCount };
+	vector<CookedTextureLevel> levels(levelCount);
+
+	size_t offset = AlignOffset(sizeof(CookedTextureHeader) + sizeof(CookedTextureLevel) * levelCount);
+	for (unsigned int i = 0; i < levelCount; i++)
+	{
+		levels[i].Width = std::max(width >> i, 1u);
+		levels[i].Height = std::max(height >> i, 1u);
+		levels[i].Offset = offset;
+		levels[i].Size = GetLevelSize(format, levels[i].Width, levels[i].Height);
+		offset = AlignOffset(offset + levels[i].Size);
+	}
+
+	output.clear();
+	output.resize(offset, 0);
+	memcpy(output.data(), &header, sizeof(header));
+	memcpy(output.data() + sizeof(header), levels.data(), sizeof(CookedTextureLevel) * levelCount);
+
+	if (pixels.HDR)
+	{
+		vector<float> level((const float*)pixels.Data, (const float*)pixels.Data + pixelCount * pixels.Channels);
+		if (pixels.Channels == 2)
+		{
+			// Expand grey & alpha to RGBA
+			vector<float> expanded(pixelCount * 4);
+			for (size_t i = 0; i < pixelCount; i++)
+			{
+				expanded[i * 4 + 0] = expanded[i * 4 + 1] = expanded[i * 4 + 2] = level[i * 2];
+				expanded[i * 4 + 3] = level[i * 2 + 1];
+			}
+			level = std::move(expanded);
+		}
+
+		for (unsigned int i = 0; i < levelCount; i++)
+		{
+			if (i > 0)
+				level = Downsample(level, levels[i - 1].Width, levels[i - 1].Height, channels);
+			memcpy(output.data() + levels[i].Offset, level.data(), levels[i].Size);
+		}
+		return true;
+	}
+
+	const unsigned char* source = (const unsigned char*)pixels.Data;
+	vector<unsigned char> level = channels == (unsigned int)pixels.Channels ?
+		vector<unsigned char>(source, source + pixelCount * pixels.Channels) :
+		ToRGBA(source, width, height, pixels.Channels);
+
+	for (unsigned int i = 0; i < levelCount; i++)
+	{
+		if (i > 0)
+			level = Downsample(level, levels[i - 1].Width, levels[i - 1].Height, channels);
+
+		unsigned char* destination = output.data() + levels[i].Offset;
+		if (format == CookedTextureFormat::BC1)
+			CompressBC1(level.data(), levels[i].Width, levels[i].Height, destination);
+		else if (format == CookedTextureFormat::BC3)
+			CompressBC3(level.data(), levels[i].Width, levels[i].Height, destination);
+		else
+			memcpy(destination, level.data(), levels[i].Size);
+	}
+	return true;
+}
+
+bool TextureCooker::CookFile(const string& inputPath, const string& outputPath, const TextureCookSettings& settings)
+{
+	IO::MappedFile source(inputPath);
+	if (source.GetSize() == 0)
+		return false;
+
+	if (IsCooked(source))
+	{
+		spdlog::debug("Texture '{}' is already cooked", inputPath);
+		if (inputPath != outputPath)
+			IO::Write(outputPath, source);
+		return true;
+	}
+
+	vector<unsigned char> output;
+	if (!Cook(source, settings, output))
+	{
+		spdlog::warn("Failed to cook texture '{}'", inputPath);
+		return false;
+	}
+
+	// Unmap before writing, output path can be the source
+	source.Close();
+	IO::Write(outputPath, output);
+	return true;
+}
+
+bool TextureCooker::IsCooked(IO::ByteSpan data)
+{
+	if (data.size() < sizeof(CookedTextureHeader))
+		return false;
+
+	uint32_t magic;
+	memcpy(&magic, data.data(), sizeof(magic));
+	return magic == FileMagic;
+}
+
+bool TextureCooker::Read(IO::ByteSpan data, CookedTextureHeader& header, vector<CookedTextureLevel>& levels)
+{
+	if (!IsCooked(data))
+		return false;
+
+	memcpy(&header, data.data(), sizeof(header));
+	if (header.Version != FileVersion ||
+		header.Format > CookedTextureFormat::BC3 ||
+		header.Width == 0 || header.Height == 0 ||
+		header.LevelCount == 0 || header.LevelCount > GetLevelCount(header.Width, header.Height))
+		return false;
+
+	size_t tableSize = sizeof(CookedTextureLevel) * header.LevelCount;
+	if (data.size() < sizeof(header) + tableSize)
+		return false;
+
+	levels.resize(header.LevelCount);
+	memcpy(levels.data(), data.data() + sizeof(header), tableSize);
+
+	for (unsigned int i = 0; i < header.LevelCount; i++)
+	{
+		const CookedTextureLevel& level = levels[i];
+		if (level.Width != std::max(header.Width >> i, 1u) ||
+			level.Height != std::max(header.Height >> i, 1u) ||
+			level.Size != GetLevelSize(header.Format, level.Width, level.Height) ||
+			level.Offset > data.size() ||
+			level.Size > data.size() - level.Offset)
+			return false;
+	}
+	return true;
+}
+
+size_t TextureCooker::GetLevelSize(CookedTextureFormat format, unsigned int width, unsigned int height)
+{
+	size_t blocks = (size_t)((width + 3) / 4) * ((height + 3) / 4);
+	size_t pixels = (size_t)width * height;
+	switch (format)
+	{
+	case CookedTextureFormat::R8:		return pixels;
+	case CookedTextureFormat::RGB8:		return pixels * 3;
+	case CookedTextureFormat::RGBA8:	return pixels * 4;
+	case CookedTextureFormat::R32F:		return pixels * sizeof(float);
+	case CookedTextureFormat::RGB32F:	return pixels * sizeof(float) * 3;
+	case CookedTextureFormat::RGBA32F:	return pixels * sizeof(float) * 4;
+	case CookedTextureFormat::BC1:		return blocks * 8;
+	case CookedTextureFormat::BC3:		return blocks * 16;
+	}
+	return 0;
+}
+
+unsigned int TextureCooker::GetLevelCount(unsigned int width, unsigned int height)
+{
+	unsigned int levels = 1;
+	for (unsigned int size = std::max(width, height); size > 1; size >>= 1)
+		levels++;
+	return levels;
+}
+
+bool TextureCooker::IsCompressed(CookedTextureFormat format) { return format == CookedTextureFormat::BC1 || format == CookedTextureFormat::BC3; }
+
+#pragma region Managed Binding
+#include <Yonai/Scripting/InternalCalls.hpp>
+
+ADD_MANAGED_METHOD(TextureCooker, Cook, MonoArray*, (MonoArray* sourceRaw, bool hdr, bool generateMips, bool compress), Yonai.Graphics)
+{
+	IO::ByteSpan source(mono_array_addr(sourceRaw, unsigned char, 0), mono_array_length(sourceRaw));
+
+	TextureCookSettings settings;
+	settings.HDR = hdr;
+	settings.GenerateMips = generateMips;
+	settings.Compress = compress;
+
+	vector<unsigned char> output;
+	if (!TextureCooker::Cook(source, settings, output))
+		return nullptr;
+
+	MonoArray* outputRaw = mono_array_new(mono_domain_get(), mono_get_byte_class(), output.size());
+	memcpy(mono_array_addr(outputRaw, unsigned char, 0), output.data(), output.size());
+	return outputRaw;
+}
+
+ADD_MANAGED_METHOD(TextureCooker, IsCooked, bool, (MonoArray* dataRaw), Yonai.Graphics)
+{
+	size_t length = mono_array_length(dataRaw);
+	if (length < sizeof(CookedTextureHeader))
+		return false;
+
+	uint32_t magic;
+	memcpy(&magic, mono_array_addr(dataRaw, unsigned char, 0), sizeof(magic));
+	return magic == TextureCooker::FileMagic;
+}
+
+#pragma endregion
@@ -0,0 +1,162 @@
+#include <chrono>
+#include <limits>
+#include <glad/glad.h>
+#include <spdlog/spdlog.h>
+#include <Yonai/IO/ImportCache.hpp>
+#include <Yonai/Graphics/TextureLoader.hpp>
+#include <Yonai/Graphics/TextureCooker.hpp>
+
+using namespace std;
+using namespace Yonai;
+using namespace Yonai::Graphics;
+
+ThreadPool* TextureLoader::s_Pool = nullptr;
+mutex TextureLoader::s_Mutex;
+float TextureLoader::s_UploadBudget = TextureLoader::DefaultUploadBudget;
+unsigned int TextureLoader::s_Placeholder = GL_INVALID_VALUE;
+atomic_uint TextureLoader::s_PendingCount = 0;
+deque<shared_ptr<TextureLoadJob>> TextureLoader::s_Decoded;
+
+void TextureLoader::Enqueue(shared_ptr<TextureLoadJob> job)
+{
+	if (!job)
+		return;
+
+	if (!s_Pool)
+	{
+		s_Pool = new ThreadPool();
+		spdlog::debug("Texture loader started with {} worker thread(s)", s_Pool->GetThreadCount());
+	}
+
+	s_PendingCount++;
+	s_Pool->Enqueue([job]() { Decode(job); });
+}
+
+void TextureLoader::Decode(shared_ptr<TextureLoadJob> job)
+{
+	// Output is the unmodified source when it cannot be cooked, such as when already cooked
+	if (!job->SourcePath.empty() && !job->Cancelled)
+	{
+		TextureCookSettings settings;
+		settings.HDR = job->HDR;
+		IO::ImportCache::Import("Texture", job->SourcePath, settings.GetFlags(), job->Data);
+	}
+
+	if (TextureCooker::IsCooked(job->Data))
+		job->Decoded = job->Cooked = true;
+	else
+	{
+		if (!job->Cancelled)
+			job->Decoded = Texture::Decode(job->Data, job->HDR, job->Pixels);
+
+		// Encoded data is no longer needed
+		vector<unsigned char>().swap(job->Data);
+	}
+
+	lock_guard lock(s_Mutex);
+	s_Decoded.emplace_back(job);
+}
+
+void TextureLoader::Finish(shared_ptr<TextureLoadJob>& job)
+{
+	s_PendingCount--;
+
+	if (job->Cancelled)
+	{
+		Texture::FreePixels(job->Pixels);
+		return;
+	}
+
+	Texture* texture = job->Target;
+	bool success = false;
+	if (job->Cooked)
+		success = texture->UploadCooked(job->Data, job->Filter);
+	else if (job->Decoded)
+		success = texture->Upload(job->Pixels, job->Filter);
+
+	Texture::FreePixels(job->Pixels);
+	vector<unsigned char>().swap(job->Data);
+
+	texture->m_PendingLoad = nullptr;
+
+	if (job->Callback)
+		job->Callback(texture, success);
+}
+
+unsigned int TextureLoader::ProcessUploads() { return ProcessUploads(s_UploadBudget); }
+
+unsigned int TextureLoader::ProcessUploads(float budget)
+{
+	auto start = chrono::high_resolution_clock::now();
+
+	unsigned int processed = 0;
+	while (true)
+	{
+		shared_ptr<TextureLoadJob> job;
+		{
+			lock_guard lock(s_Mutex);
+			if (s_Decoded.empty())
+				break;
+			job = s_Decoded.front();
+			s_Decoded.pop_front();
+		}
+
+		Finish(job);
+		processed++;
+
+		if (chrono::duration<float, milli>(chrono::high_resolution_clock::now() - start).count() >= budget)
+			break;
+	}
+	return processed;
+}
+
+void TextureLoader::Flush()
+{
+	if (!s_Pool)
+		return;
+
+	s_Pool->Wait();
+	while (ProcessUploads(numeric_limits<float>::max()) > 0);
+}
+
+void TextureLoader::Shutdown()
+{
+	// Finishes any decodes in progress
+	if (s_Pool)
+		delete s_Pool;
+	s_Pool = nullptr;
+
+	for (auto& job : s_Decoded)
+	{
+		Texture::FreePixels(job->Pixels);
+		if (!job->Cancelled)
+			job->Target->m_PendingLoad = nullptr;
+	}
+	s_Decoded.clear();
+	s_PendingCount = 0;
+
+	if (s_Placeholder != GL_INVALID_VALUE)
+		glDeleteTextures(1, &s_Placeholder);
+	s_Placeholder = GL_INVALID_VALUE;
+}
+
+unsigned int TextureLoader::GetPendingCount() { return s_PendingCount; }
+
+float TextureLoader::GetUploadBudget() { return s_UploadBudget; }
+void TextureLoader::SetUploadBudget(float milliseconds) { s_UploadBudget = milliseconds; }
+
+unsigned int TextureLoader::GetPlaceholder()
+{
+	if (s_Placeholder != GL_INVALID_VALUE)
+		return s_Placeholder;
+
+	// Single white texel, so tinting still applies
+	const unsigned char white[] = { 255, 255, 255, 255 };
+
+	glGenTextures(1, &s_Placeholder);
+	glBindTexture(GL_TEXTURE_2D, s_Placeholder);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, white);
+	return s_Placeholder;
+}
@@ -1,112 +1,545 @@
 #include <thread>
+#include <algorithm>
 #include <unordered_map>
 #include <spdlog/spdlog.h>
 #include <Yonai/IO/FileWatcher.hpp>
 
+#if defined(YONAI_PLATFORM_LINUX)
+	#include <poll.h>
+	#include <cerrno>
+	#include <cstring>
+	#include <unistd.h>
+	#include <sys/inotify.h>
+	#include <sys/eventfd.h>
+#endif
+
 using namespace std;
 using namespace Yonai;
 using namespace Yonai::IO;
 
-FileWatcher::FileWatcher(string path, int intervalMs, bool multithread) :
+namespace fs = std::filesystem;
+
+mutex FileWatcher::s_Mutex;
+mutex FileWatcher::s_EventMutex;
+thread FileWatcher::s_Thread;
+atomic_bool FileWatcher::s_Running = false;
+atomic_uint FileWatcher::s_NextID = 0;
+unordered_map<unsigned int, FileWatcher*> FileWatcher::s_Watchers;
+unordered_map<unsigned int, FileWatchCallback> FileWatcher::s_Callbacks;
+map<pair<unsigned int, string>, FileWatcher::PendingEvent> FileWatcher::s_Pending;
+vector<FileWatchEvent> FileWatcher::s_Queue;
+
+#if defined(YONAI_PLATFORM_LINUX)
+int FileWatcher::s_INotify = -1;
+int FileWatcher::s_WakeEvent = -1;
+unordered_map<int, FileWatcher::WatchedDirectory> FileWatcher::s_Directories;
+
+static constexpr uint32_t WatchMask =
+	IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE |
+	IN_ATTRIB | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+#else
+bool FileWatcher::s_WakeRequested = false;
+condition_variable FileWatcher::s_WakeCondition;
+#endif
+
+namespace Yonai::IO
+{
+	/// <summary>
+	/// Stops the watch thread before the static members it uses are destroyed, if a watcher was never stopped
+	/// </summary>
+	struct FileWatcherShutdown
+	{
+		~FileWatcherShutdown() { FileWatcher::StopThread(); }
+	};
+}
+
+static FileWatcherShutdown s_Shutdown;
+
+FileWatcher::FileWatcher(string path, int intervalMs) :
+	m_ID(++s_NextID),
+	m_Watching(false),
+	m_IsDirectory(fs::is_directory(path)),
 	m_Path(path),
-	m_LoopThread(),
-	m_Running(false),
-	m_WatchedPaths(),
 	m_Interval(intervalMs),
-	m_Multithread(multithread)
+	m_WatchedPaths() { }
+
+FileWatcher::~FileWatcher() { Unwatch(); }
+
+const string& FileWatcher::GetPath() { return m_Path; }
+
+void FileWatcher::Start(FileWatchCallback callback)
 {
-	if (filesystem::is_regular_file(m_Path) && filesystem::exists(m_Path))
+	if (!callback)
 	{
-		m_WatchedPaths[m_Path] = filesystem::last_write_time(m_Path);
+		spdlog::warn("Cannot watch '{}' - no callback was registered", m_Path);
+		return;
 	}
-	else if (filesystem::is_directory(m_Path))
+
+	Unwatch();
+
+	{
+		lock_guard lock(s_Mutex);
+#if defined(YONAI_PLATFORM_LINUX)
+		if (s_INotify < 0)
+		{
+			s_INotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+			s_WakeEvent = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+			if (s_INotify < 0 || s_WakeEvent < 0)
+			{
+				spdlog::error("Cannot watch '{}' - failed to initialise inotify ({})", m_Path, strerror(errno));
+				return;
+			}
+		}
+
+		// Files are watched through their directory, so changes are still seen when a file is replaced
+		if (m_IsDirectory)
+			AddDirectory(m_Path, true);
+		else
+			AddDirectory(fs::path(m_Path).parent_path().string(), false);
+#else
+		error_code error;
+		if (m_IsDirectory)
+		{
+			for (fs::recursive_directory_iterator it(m_Path, error), end; !error && it != end; it.increment(error))
+				m_WatchedPaths[it->path().string()] = it->last_write_time(error);
+		}
+		else if (fs::is_regular_file(m_Path, error))
+			m_WatchedPaths[m_Path] = fs::last_write_time(m_Path, error);
+		m_NextPoll = chrono::steady_clock::now() + m_Interval;
+#endif
+		s_Watchers[m_ID] = this;
+	}
+
+	{
+		lock_guard lock(s_EventMutex);
+		s_Callbacks[m_ID] = callback;
+	}
+
+	m_Watching = true;
+	spdlog::trace("Watching '{}' for changes", m_Path);
+
+	StartThread();
+	Wake();
+}
+
+void FileWatcher::Stop() { Unwatch(); }
+
+void FileWatcher::Unwatch()
+{
+	if (!m_Watching)
+		return;
+	m_Watching = false;
+
+	bool lastWatcher = false;
+	{
+		lock_guard lock(s_Mutex);
+		s_Watchers.erase(m_ID);
+#if defined(YONAI_PLATFORM_LINUX)
+		RemoveDirectories();
+#endif
+		m_WatchedPaths.clear();
+		lastWatcher = s_Watchers.empty();
+	}
+
 	{
-		for (auto& file : filesystem::recursive_directory_iterator(m_Path))
-			m_WatchedPaths[file.path().string()] = file.last_write_time();
+		// Queued events are discarded by ProcessEvents once the callback is removed
+		lock_guard lock(s_EventMutex);
+		s_Callbacks.erase(m_ID);
+		for (auto it = s_Pending.begin(); it != s_Pending.end();)
+		{
+			if (it->first.first == m_ID)
+				it = s_Pending.erase(it);
+			else
+				it++;
+		}
 	}
+
+	if (lastWatcher)
+		StopThread();
 }
 
-FileWatcher::FileWatcher(string path, bool multithread) : FileWatcher(path, 1000, multithread) { }
+void FileWatcher::StartThread()
+{
+	if (s_Running.exchange(true))
+		return; // Already running
 
-FileWatcher::~FileWatcher()
+	if (s_Thread.joinable())
+		s_Thread.join();
+	s_Thread = thread(&FileWatcher::WatchLoop);
+}
+
+void FileWatcher::StopThread()
 {
-	m_Running.store(false);
-	if(m_LoopThread.joinable())
-		m_LoopThread.join();
+	if (!s_Running.exchange(false))
+		return; // Not running
+
+	Wake();
+	if (s_Thread.joinable())
+		s_Thread.join();
+
+#if defined(YONAI_PLATFORM_LINUX)
+	lock_guard lock(s_Mutex);
+	if (!s_Watchers.empty())
+		return;
+
+	close(s_INotify);
+	close(s_WakeEvent);
+	s_INotify = s_WakeEvent = -1;
+	s_Directories.clear();
+#endif
 }
 
-void FileWatcher::Start(function<void(const string&, FileWatchStatus)> callback)
+void FileWatcher::Wake()
 {
-	m_Callback = callback;
-	m_Running.store(true);
+#if defined(YONAI_PLATFORM_LINUX)
+	if (s_WakeEvent >= 0)
+		eventfd_write(s_WakeEvent, 1);
+#else
+	{
+		lock_guard lock(s_EventMutex);
+		s_WakeRequested = true;
+	}
+	s_WakeCondition.notify_all();
+#endif
+}
+
+void FileWatcher::WatchLoop()
+{
+	while (s_Running)
+	{
+		int pendingTimeout = FlushPending();
+
+#if defined(YONAI_PLATFORM_LINUX)
+		pollfd files[] =
+		{
+			{ s_INotify, POLLIN, 0 },
+			{ s_WakeEvent, POLLIN, 0 }
+		};
+		if (poll(files, 2, pendingTimeout) < 0 && errno != EINTR)
+		{
+			spdlog::error("Stopped watching files - {}", strerror(errno));
+			break;
+		}
 
-	if (m_Multithread)
-		m_LoopThread = thread(&FileWatcher::BeginWatching, this);
+		if (files[1].revents & POLLIN)
+		{
+			eventfd_t value;
+			eventfd_read(s_WakeEvent, &value);
+		}
+		if (files[0].revents & POLLIN)
+			ReadEvents();
+#else
+		auto now = chrono::steady_clock::now();
+		auto wakeTime = now + chrono::seconds(1);
+		{
+			lock_guard lock(s_Mutex);
+			for (auto& pair : s_Watchers)
+			{
+				FileWatcher* watcher = pair.second;
+				if (watcher->m_NextPoll <= now)
+				{
+					watcher->Poll();
+					watcher->m_NextPoll = now + watcher->m_Interval;
+				}
+				wakeTime = min(wakeTime, watcher->m_NextPoll);
+			}
+		}
+		if (pendingTimeout >= 0)
+			wakeTime = min(wakeTime, now + chrono::milliseconds(pendingTimeout));
+
+		unique_lock lock(s_EventMutex);
+		s_WakeCondition.wait_until(lock, wakeTime, []() { return s_WakeRequested || !s_Running; });
+		s_WakeRequested = false;
+#endif
+	}
+}
+
+void FileWatcher::AddEvent(unsigned int watcherID, const string& path, FileWatchStatus status)
+{
+	lock_guard lock(s_EventMutex);
+	auto now = chrono::steady_clock::now();
+	auto it = s_Pending.find({ watcherID, path });
+	if (it == s_Pending.end())
+	{
+		s_Pending.emplace(make_pair(watcherID, path), PendingEvent { status, now });
+		return;
+	}
+
+	PendingEvent& pending = it->second;
+	pending.LastChange = now;
+	if (pending.Status == FileWatchStatus::Created)
+	{
+		// Temporary files are never seen by callbacks
+		if (status == FileWatchStatus::Removed)
+			s_Pending.erase(it);
+		return;
+	}
+
+	// Replaced, e.g. saved through a temporary file
+	if (pending.Status == FileWatchStatus::Removed && status == FileWatchStatus::Created)
+		pending.Status = FileWatchStatus::Modified;
 	else
-		BeginWatching(); // Call synchronously
+		pending.Status = status;
 }
 
-void FileWatcher::BeginWatching()
+int FileWatcher::FlushPending()
 {
-	if (!m_Callback)
+	lock_guard lock(s_EventMutex);
+	const chrono::milliseconds delay(CoalesceDelay);
+	auto now = chrono::steady_clock::now();
+	int timeout = -1;
+	for (auto it = s_Pending.begin(); it != s_Pending.end();)
 	{
-		spdlog::warn("Cannot watch '{}' - no callback was registered", m_Path);
+		auto elapsed = now - it->second.LastChange;
+		if (elapsed >= delay)
+		{
+			s_Queue.push_back({ it->first.first, it->first.second, it->second.Status });
+			it = s_Pending.erase(it);
+			continue;
+		}
+
+		int remaining = (int)chrono::ceil<chrono::milliseconds>(delay - elapsed).count();
+		timeout = timeout < 0 ? remaining : min(timeout, remaining);
+		it++;
+	}
+	return timeout;
+}
+
+unsigned int FileWatcher::ProcessEvents()
+{
+	vector<FileWatchEvent> events;
+	{
+		lock_guard lock(s_EventMutex);
+		events.swap(s_Queue);
+	}
+
+	// Callbacks are copied, as they are free to start and stop watchers
+	unsigned int delivered = 0;
+	for (FileWatchEvent& event : events)
+	{
+		FileWatchCallback callback;
+		{
+			lock_guard lock(s_EventMutex);
+			auto it = s_Callbacks.find(event.WatcherID);
+			if (it == s_Callbacks.end())
+				continue; // Watcher has stopped
+			callback = it->second;
+		}
+
+		callback(event.Path, event.Status);
+		delivered++;
+	}
+	return delivered;
+}
+
+#if defined(YONAI_PLATFORM_LINUX)
+void FileWatcher::AddDirectory(const string& path, bool recursive)
+{
+	int descriptor = inotify_add_watch(s_INotify, path.empty() ? "." : path.c_str(), WatchMask);
+	if (descriptor < 0)
+	{
+		spdlog::warn("Cannot watch '{}' - {}", path, strerror(errno));
 		return;
 	}
 
-	spdlog::trace("Watching '{}' for changes", m_Path);
-	while (m_Running.load())
+	// Descriptors are shared when watchers overlap
+	WatchedDirectory& directory = s_Directories[descriptor];
+	directory.Path = path;
+	if (find(directory.Watchers.begin(), directory.Watchers.end(), m_ID) == directory.Watchers.end())
+		directory.Watchers.push_back(m_ID);
+
+	if (!recursive)
+		return;
+
+	error_code error;
+	for (fs::recursive_directory_iterator it(path, fs::directory_options::skip_permission_denied, error), end;
+		!error && it != end; it.increment(error))
+		if (it->is_directory(error))
+			AddDirectory(it->path().string(), false);
+}
+
+void FileWatcher::RemoveDirectories()
+{
+	for (auto it = s_Directories.begin(); it != s_Directories.end();)
+	{
+		vector<unsigned int>& watchers = it->second.Watchers;
+		watchers.erase(remove(watchers.begin(), watchers.end(), m_ID), watchers.end());
+		if (!watchers.empty())
+		{
+			it++;
+			continue;
+		}
+
+		inotify_rm_watch(s_INotify, it->first);
+		it = s_Directories.erase(it);
+	}
+}
+
+void FileWatcher::ReadEvents()
+{
+	alignas(inotify_event) char buffer[4096];
+	ssize_t length;
+	while ((length = read(s_INotify, buffer, sizeof(buffer))) > 0)
 	{
-		// Check for deleted files
-		for(auto it = m_WatchedPaths.begin(); it != m_WatchedPaths.end();)
+		lock_guard lock(s_Mutex);
+		const inotify_event* event = nullptr;
+		for (char* position = buffer; position < buffer + length; position += sizeof(inotify_event) + event->len)
 		{
-			if (filesystem::exists(it->first))
+			event = (const inotify_event*)position;
+			if (event->mask & IN_Q_OVERFLOW)
 			{
-				it++;
+				spdlog::warn("File changes were missed, too many changes happened at once");
 				continue;
 			}
 
-			m_Callback(it->first, FileWatchStatus::Removed);
-			m_WatchedPaths.erase(it++);
-		}
+			auto directoryIt = s_Directories.find(event->wd);
+			if (directoryIt == s_Directories.end())
+				continue;
+			if (event->mask & IN_IGNORED)
+			{
+				// Directory was removed, or is no longer watched
+				s_Directories.erase(directoryIt);
+				continue;
+			}
+			if (event->len == 0)
+				continue; // Changes to the directory itself are reported by its parent
 
-		// Check for modified or created files
-		if (filesystem::is_directory(m_Path))
-		{
-			for (auto& file : filesystem::recursive_directory_iterator(m_Path))
+			const string& directory = directoryIt->second.Path;
+			string path = directory.empty() ? string(event->name) : (fs::path(directory) / event->name).string();
+
+			FileWatchStatus status = FileWatchStatus::Modified;
+			if (event->mask & (IN_CREATE | IN_MOVED_TO))
+				status = FileWatchStatus::Created;
+			else if (event->mask & (IN_DELETE | IN_MOVED_FROM))
+				status = FileWatchStatus::Removed;
+			bool createdDirectory = (event->mask & IN_ISDIR) && status == FileWatchStatus::Created;
+
+			// Copied, as watching new directories can modify s_Directories
+			vector<unsigned int> watcherIDs = directoryIt->second.Watchers;
+			for (unsigned int watcherID : watcherIDs)
 			{
-				string filepath = file.path().string();
-				if (m_WatchedPaths.find(filepath) == m_WatchedPaths.end())
-				{
-					// File was created
-					m_WatchedPaths[filepath] = file.last_write_time();
-					m_Callback(filepath, FileWatchStatus::Created);
-				}
-				else if (file.last_write_time() != m_WatchedPaths[filepath])
+				auto watcherIt = s_Watchers.find(watcherID);
+				if (watcherIt == s_Watchers.end())
+					continue;
+				FileWatcher* watcher = watcherIt->second;
+
+				if (!watcher->m_IsDirectory)
 				{
-					m_WatchedPaths[filepath] = file.last_write_time();
-					m_Callback(filepath, FileWatchStatus::Modified);
+					if (path == watcher->m_Path)
+						AddEvent(watcherID, path, status);
+					continue;
 				}
+
+				AddEvent(watcherID, path, status);
+				if (!createdDirectory)
+					continue;
+
+				// Contents may have been created before the new directory was watched
+				watcher->AddDirectory(path, true);
+				error_code error;
+				for (fs::recursive_directory_iterator it(path, fs::directory_options::skip_permission_denied, error), end;
+					!error && it != end; it.increment(error))
+					AddEvent(watcherID, it->path().string(), FileWatchStatus::Created);
 			}
 		}
-		if (filesystem::is_regular_file(m_Path))
+	}
+}
+#else
+void FileWatcher::Poll()
+{
+	error_code error;
+
+	// Check for deleted files
+	for (auto it = m_WatchedPaths.begin(); it != m_WatchedPaths.end();)
+	{
+		if (fs::exists(it->first, error))
+		{
+			it++;
+			continue;
+		}
+
+		AddEvent(m_ID, it->first, FileWatchStatus::Removed);
+		it = m_WatchedPaths.erase(it);
+	}
+
+	// Check for modified or created files
+	if (m_IsDirectory)
+	{
+		for (fs::recursive_directory_iterator it(m_Path, error), end; !error && it != end; it.increment(error))
 		{
-			auto lastWriteTime = filesystem::last_write_time(m_Path);
-			if (lastWriteTime != m_WatchedPaths[m_Path])
+			string filepath = it->path().string();
+			auto lastWriteTime = it->last_write_time(error);
+			auto watchedIt = m_WatchedPaths.find(filepath);
+			if (watchedIt == m_WatchedPaths.end())
 			{
-				m_WatchedPaths[m_Path] = lastWriteTime;
-				m_Callback(m_Path, FileWatchStatus::Modified);
+				m_WatchedPaths[filepath] = lastWriteTime;
+				AddEvent(m_ID, filepath, FileWatchStatus::Created);
+			}
+			else if (watchedIt->second != lastWriteTime)
+			{
+				watchedIt->second = lastWriteTime;
+				AddEvent(m_ID, filepath, FileWatchStatus::Modified);
 			}
 		}
-
-		this_thread::sleep_for(m_Interval);
 	}
+	else if (fs::is_regular_file(m_Path, error))
+	{
+		auto lastWriteTime = fs::last_write_time(m_Path, error);
+		auto watchedIt = m_WatchedPaths.find(m_Path);
+		if (watchedIt == m_WatchedPaths.end())
+		{
+			m_WatchedPaths[m_Path] = lastWriteTime;
+			AddEvent(m_ID, m_Path, FileWatchStatus::Created);
+		}
+		else if (watchedIt->second != lastWriteTime)
+		{
+			watchedIt->second = lastWriteTime;
+			AddEvent(m_ID, m_Path, FileWatchStatus::Modified);
+		}
+	}
+}
+#endif
+
+#pragma region Managed Binding
+#include <Yonai/Scripting/ScriptEngine.hpp>
+#include <Yonai/Scripting/InternalCalls.hpp>
+
+using namespace Yonai::Scripting;
+
+typedef void (*FileWatcherChangedManagedFn)(void*, MonoString*, int, MonoException**);
+
+/// <summary>
+/// Informs scripting side of a change to a watched path, via FileWatcher._OnChanged
+/// </summary>
+void FileWatcherChangedManaged(FileWatcher* watcher, const string& path, FileWatchStatus status)
+{
+	if (!ScriptEngine::IsLoaded() || !ScriptEngine::GetCoreAssembly())
+		return;
+
+	// Method is found on each call, as it changes when the script engine reloads
+	MonoClass* klass = ScriptEngine::GetCoreAssembly()->GetClassFromName("Yonai.IO", "FileWatcher");
+	MonoMethod* method = klass ? mono_class_get_method_from_name(klass, "_OnChanged", 3) : nullptr;
+	if (!method)
+		return;
+
+	MonoException* exception = nullptr;
+	MonoString* pathString = mono_string_new(mono_domain_get(), path.c_str());
+	((FileWatcherChangedManagedFn)mono_method_get_unmanaged_thunk(method))(watcher, pathString, (int)status, &exception);
+	if (exception)
+		mono_print_unhandled_exception((MonoObject*)exception);
 }
 
-void FileWatcher::Stop()
+ADD_MANAGED_METHOD(FileWatcher, Create, void*, (MonoString* pathRaw, int intervalMs), Yonai.IO)
 {
-	m_Running.store(false);
+	char* path = mono_string_to_utf8(pathRaw);
+	FileWatcher* watcher = new FileWatcher(path, intervalMs);
+	mono_free(path);
 
-	if (m_Multithread)
-		m_LoopThread.join();
+	watcher->Start([watcher](const string& changedPath, FileWatchStatus status)
+		{ FileWatcherChangedManaged(watcher, changedPath, status); });
+	return watcher;
 }
+
+ADD_MANAGED_METHOD(FileWatcher, Destroy, void, (void* handle), Yonai.IO)
+{ delete (FileWatcher*)handle; }
+#pragma endregion
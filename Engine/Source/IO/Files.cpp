@@ -1,8 +1,9 @@
-#include <regex>
+#include <cstring>
 #include <fstream>
 #include <filesystem>
 #include <spdlog/spdlog.h>
 #include <Yonai/IO/Files.hpp>
+#include <Yonai/IO/MappedFile.hpp>
 
 using namespace std;
 using namespace Yonai::IO;
@@ -17,20 +18,47 @@ string Yonai::IO::ReadText(string path)
 		return "";
 	}
 
-	// Open file for read and get size
-	ifstream filestream(path, ios::in | ios::binary);
-
-	// Get file length
-	streampos size = fs::file_size(path);
+	// Mapped file is copied once, while converting CRLF -> LF
+	MappedFile file(path);
+	return NormaliseLineEndings(file.GetSpan());
+}
 
-	// Read in contents of file
-	string contents(size, '\0');
-	filestream.read(contents.data(), size);
+string Yonai::IO::NormaliseLineEndings(ByteSpan text)
+{
+	string output;
+	output.reserve(text.size());
 
-	// Convert CRLF -> LF
-	contents = regex_replace(contents, regex("\r\n"), "\n");
+	const char* start = (const char*)text.data();
+	const char* end = start + text.size();
+	while (start < end)
+	{
+		// Copy everything up to the next carriage return
+		const char* carriageReturn = (const char*)memchr(start, '\r', end - start);
+		if (!carriageReturn)
+		{
+			output.append(start, end);
+			break;
+		}
+		output.append(start, carriageReturn);
+
+		// Drop carriage return when followed by a line feed, lone carriage returns are kept
+		if (carriageReturn + 1 == end || carriageReturn[1] != '\n')
+			output.push_back('\r');
+		start = carriageReturn + 1;
+	}
+	return output;
+}
 
-	return contents;
+void Yonai::IO::NormaliseLineEndings(string& text)
+{
+	size_t write = 0;
+	for (size_t read = 0; read < text.size(); read++)
+	{
+		if (text[read] == '\r' && read + 1 < text.size() && text[read + 1] == '\n')
+			continue;
+		text[write++] = text[read];
+	}
+	text.resize(write);
 }
 
 vector<unsigned char> Yonai::IO::Read(string path)
@@ -52,7 +80,7 @@ vector<unsigned char> Yonai::IO::Read(string path)
 	// Prepare vector
 	vector<unsigned char> contents(filesize);
 
-	filestream.read((char*)&contents[0], filesize);
+	filestream.read((char*)contents.data(), filesize);
 	filestream.close();
 
 	return contents;
@@ -66,7 +94,7 @@ void Yonai::IO::Write(string path, string& contents)
 	filestream.close();
 }
 
-void Yonai::IO::Write(string path, vector<unsigned char>& data)
+void Yonai::IO::Write(string path, ByteSpan data)
 {
 	ofstream filestream(path, ios::out | ios::binary);
 	filestream.write((const char*)data.data(), data.size());
@@ -0,0 +1,499 @@
+#include <thread>
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+#include <filesystem>
+#include <spdlog/spdlog.h>
+#include <Yonai/Utils.hpp>
+#include <Yonai/ThreadPool.hpp>
+#include <Yonai/Application.hpp>
+#include <Yonai/IO/Files.hpp>
+#include <Yonai/IO/MappedFile.hpp>
+#include <Yonai/IO/ImportCache.hpp>
+#include <Yonai/Graphics/Model.hpp>
+#include <Yonai/Graphics/ModelCache.hpp>
+#include <Yonai/Graphics/TextureCooker.hpp>
+
+using namespace std;
+using namespace Yonai;
+using namespace Yonai::IO;
+using namespace Yonai::Graphics;
+
+namespace fs = std::filesystem;
+
+atomic<bool> ImportCache::s_Enabled = true;
+bool ImportCache::s_SourcesLoaded = false;
+bool ImportCache::s_SourcesDirty = false;
+string ImportCache::s_Directory = "";
+mutex ImportCache::s_Mutex;
+unordered_map<string, ImportCache::RegisteredImporter> ImportCache::s_Importers;
+unordered_map<string, ImportCache::SourceInfo> ImportCache::s_Sources;
+
+/// <summary>
+/// Filename of the source index, inside the cache directory
+/// </summary>
+static const char* SourcesFilename = "Sources.bin";
+
+/// <summary>
+/// Start of each cache entry, followed by the imported data
+/// </summary>
+struct ImportCacheHeader
+{
+	uint32_t Magic;
+	uint32_t Version;
+	uint32_t ImporterVersion;
+	uint32_t Reserved;
+	uint64_t SourceHash;
+	uint64_t DataSize;
+};
+
+/// <summary>
+/// Start of the source index, followed by each source's path length, path and SourceInfo
+/// </summary>
+struct ImportCacheSourcesHeader
+{
+	uint32_t Magic;
+	uint32_t Version;
+	uint64_t Count;
+};
+
+/// <summary>
+/// Writes to a temporary file beside path, then replaces path with it.
+/// Readers never see a partially written file, even when importing in parallel.
+/// </summary>
+static bool WriteReplace(const string& path, const vector<ByteSpan>& parts)
+{
+	string temporaryPath = path + "." + to_string(hash<thread::id>()(this_thread::get_id())) + ".tmp";
+	{
+		ofstream file(temporaryPath, ios::binary | ios::trunc);
+		for (const ByteSpan& part : parts)
+			file.write((const char*)part.data(), part.size());
+		if (!file)
+		{
+			spdlog::warn("Failed to write import cache file '{}'", temporaryPath);
+			file.close();
+			error_code error;
+			fs::remove(temporaryPath, error);
+			return false;
+		}
+	}
+
+	error_code error;
+	fs::rename(temporaryPath, path, error);
+	if (!error)
+		return true;
+
+	spdlog::warn("Failed to write import cache file '{}' - {}", path, error.message());
+	fs::remove(temporaryPath, error);
+	return false;
+}
+
+void ImportCache::RegisterDefaultImporters()
+{
+	static once_flag registered;
+	call_once(registered, []()
+	{
+		lock_guard lock(s_Mutex);
+
+		// Already cooked sources are used as they are
+		s_Importers.emplace("Texture", RegisteredImporter { TextureCooker::FileVersion,
+			[](ByteSpan source, const string& extension, uint32_t flags, vector<unsigned char>& output)
+			{
+				if (TextureCooker::IsCooked(source))
+					return false;
+				return TextureCooker::Cook(source, TextureCookSettings::FromFlags(flags), output);
+			}});
+
+		s_Importers.emplace("Model", RegisteredImporter { ModelCache::FileVersion,
+			[](ByteSpan source, const string& extension, uint32_t flags, vector<unsigned char>& output)
+			{
+				CachedModel model;
+				if (!Model::ImportScene(source, extension, flags, model))
+					return false;
+				ModelCache::Serialize(model, output);
+				return true;
+			}});
+	});
+}
+
+void ImportCache::RegisterImporter(const string& name, uint32_t version, ImportFunction importer)
+{
+	RegisterDefaultImporters();
+
+	lock_guard lock(s_Mutex);
+	s_Importers[name] = { version, importer };
+}
+
+void ImportCache::UnregisterImporter(const string& name)
+{
+	RegisterDefaultImporters();
+
+	lock_guard lock(s_Mutex);
+	s_Importers.erase(name);
+}
+
+bool ImportCache::GetImporter(const string& name, RegisteredImporter& output)
+{
+	RegisterDefaultImporters();
+
+	lock_guard lock(s_Mutex);
+	auto it = s_Importers.find(name);
+	if (it == s_Importers.end())
+	{
+		spdlog::warn("Cannot import '{}' - importer is not registered", name);
+		return false;
+	}
+	output = it->second;
+	return true;
+}
+
+uint64_t ImportCache::GetKey(const string& importer, uint32_t importerVersion, uint64_t sourceHash, const string& extension, uint32_t flags)
+{
+	uint64_t key = Hash(&sourceHash, sizeof(sourceHash));
+	key = Hash(&importerVersion, sizeof(importerVersion), key);
+	key = Hash(&flags, sizeof(flags), key);
+
+	// Extension selects how the source is read, so the same contents can import differently
+	return Hash(extension, Hash(importer, key));
+}
+
+string ImportCache::GetExtension(const string& path)
+{
+	string extension = fs::path(path).extension().string();
+	transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+	return extension;
+}
+
+#pragma region Source Index
+/// <summary>
+/// Must be called with s_Mutex held
+/// </summary>
+void ImportCache::LoadSources()
+{
+	if (s_SourcesLoaded)
+		return;
+	s_SourcesLoaded = true;
+	s_Sources.clear();
+
+	string path = GetDirectoryLocked() + SourcesFilename;
+	if (!fs::exists(path))
+		return;
+
+	MappedFile file(path);
+	ByteSpan data = file.GetSpan();
+
+	ImportCacheSourcesHeader header;
+	if (data.size() < sizeof(header))
+		return;
+	memcpy(&header, data.data(), sizeof(header));
+	if (header.Magic != FileMagic || header.Version != FileVersion)
+		return;
+
+	size_t offset = sizeof(header);
+	for (uint64_t i = 0; i < header.Count; i++)
+	{
+		uint32_t length;
+		if (sizeof(length) > data.size() - offset)
+			break;
+		memcpy(&length, data.data() + offset, sizeof(length));
+		offset += sizeof(length);
+
+		if ((size_t)length + sizeof(SourceInfo) > data.size() - offset)
+			break;
+		string sourcePath((const char*)data.data() + offset, length);
+		offset += length;
+
+		SourceInfo info;
+		memcpy(&info, data.data() + offset, sizeof(info));
+		offset += sizeof(info);
+		s_Sources.emplace(std::move(sourcePath), info);
+	}
+}
+
+bool ImportCache::GetSourceHash(const string& path, uint64_t& output, vector<unsigned char>* contents)
+{
+	error_code error;
+	SourceInfo info;
+	info.Size = fs::file_size(path, error);
+	if (error)
+	{
+		spdlog::warn("Cannot import '{}' - {}", path, error.message());
+		return false;
+	}
+	info.ModifiedTime = (int64_t)fs::last_write_time(path, error).time_since_epoch().count();
+
+	{
+		lock_guard lock(s_Mutex);
+		LoadSources();
+		auto it = s_Sources.find(path);
+		if (it != s_Sources.end() && it->second.Size == info.Size && it->second.ModifiedTime == info.ModifiedTime)
+		{
+			output = it->second.Hash;
+			return true;
+		}
+	}
+
+	// Changed since last hashed
+	vector<unsigned char> data = Read(path);
+	if (data.size() != info.Size)
+		return false; // Read failed, or modified while reading
+
+	info.Hash = output = Hash(data.data(), data.size());
+	if (contents)
+		*contents = std::move(data);
+
+	lock_guard lock(s_Mutex);
+	LoadSources();
+	s_Sources[path] = info;
+	s_SourcesDirty = true;
+	return true;
+}
+
+void ImportCache::Flush()
+{
+	lock_guard lock(s_Mutex);
+	if (!s_SourcesDirty || !s_Enabled)
+		return;
+	s_SourcesDirty = false;
+
+	vector<unsigned char> contents;
+	ImportCacheSourcesHeader header = { FileMagic, FileVersion, (uint64_t)s_Sources.size() };
+	contents.insert(contents.end(), (unsigned char*)&header, (unsigned char*)&header + sizeof(header));
+	for (const auto& [path, info] : s_Sources)
+	{
+		uint32_t length = (uint32_t)path.size();
+		contents.insert(contents.end(), (unsigned char*)&length, (unsigned char*)&length + sizeof(length));
+		contents.insert(contents.end(), path.begin(), path.end());
+		contents.insert(contents.end(), (unsigned char*)&info, (unsigned char*)&info + sizeof(info));
+	}
+
+	error_code error;
+	fs::create_directories(GetDirectoryLocked(), error);
+	WriteReplace(GetDirectoryLocked() + SourcesFilename, { contents });
+}
+#pragma endregion
+
+#pragma region Entries
+string ImportCache::GetEntryPath(const string& importer, uint64_t key)
+{
+	char filename[32];
+	snprintf(filename, sizeof(filename), "%016llx.bin", (unsigned long long)key);
+	return GetDirectory() + importer + "/" + filename;
+}
+
+bool ImportCache::LoadEntry(const string& path, uint32_t importerVersion, uint64_t sourceHash, vector<unsigned char>& output)
+{
+	if (!fs::exists(path))
+		return false;
+
+	// Unmapped before removing, which fails on some platforms while mapped
+	{
+		MappedFile file(path);
+		ByteSpan data = file.GetSpan();
+
+		ImportCacheHeader header;
+		if (data.size() >= sizeof(header))
+		{
+			memcpy(&header, data.data(), sizeof(header));
+			if (header.Magic == FileMagic &&
+				header.Version == FileVersion &&
+				header.ImporterVersion == importerVersion &&
+				header.SourceHash == sourceHash &&
+				header.DataSize == data.size() - sizeof(header))
+			{
+				output.assign(data.begin() + sizeof(header), data.end());
+				return true;
+			}
+		}
+	}
+
+	// Invalid or outdated, remove so it is replaced on next import
+	spdlog::debug("Removing invalid import cache entry '{}'", path);
+	error_code error;
+	fs::remove(path, error);
+	return false;
+}
+
+void ImportCache::SaveEntry(const string& path, uint32_t importerVersion, uint64_t sourceHash, ByteSpan data)
+{
+	error_code error;
+	fs::create_directories(fs::path(path).parent_path(), error);
+	if (error)
+	{
+		spdlog::warn("Failed to create import cache directory '{}' - {}", fs::path(path).parent_path().string(), error.message());
+		return;
+	}
+
+	ImportCacheHeader header = { FileMagic, FileVersion, importerVersion, 0, sourceHash, (uint64_t)data.size() };
+	WriteReplace(path, { ByteSpan((const unsigned char*)&header, sizeof(header)), data });
+}
+#pragma endregion
+
+#pragma region Importing
+bool ImportCache::Import(const string& importer, const RegisteredImporter& registered, ByteSpan source, uint64_t sourceHash, const string& extension, uint32_t flags, vector<unsigned char>& output)
+{
+	output.clear();
+	if (!registered.Function(source, extension, flags, output))
+	{
+		output.assign(source.begin(), source.end());
+		return false;
+	}
+
+	if (s_Enabled)
+		SaveEntry(GetEntryPath(importer, GetKey(importer, registered.Version, sourceHash, extension, flags)), registered.Version, sourceHash, output);
+	return true;
+}
+
+bool ImportCache::Import(const string& importer, ByteSpan source, const string& extension, uint32_t flags, vector<unsigned char>& output, bool* fromCache)
+{
+	if (fromCache)
+		*fromCache = false;
+
+	RegisteredImporter registered;
+	if (!GetImporter(importer, registered))
+		return false;
+
+	string lowerExtension = extension;
+	transform(lowerExtension.begin(), lowerExtension.end(), lowerExtension.begin(), ::tolower);
+
+	uint64_t sourceHash = Hash(source.data(), source.size());
+	if (s_Enabled && LoadEntry(GetEntryPath(importer, GetKey(importer, registered.Version, sourceHash, lowerExtension, flags)), registered.Version, sourceHash, output))
+	{
+		if (fromCache)
+			*fromCache = true;
+		return true;
+	}
+
+	return Import(importer, registered, source, sourceHash, lowerExtension, flags, output);
+}
+
+bool ImportCache::Import(const string& importer, const string& sourcePath, uint32_t flags, vector<unsigned char>& output, bool* fromCache)
+{
+	if (fromCache)
+		*fromCache = false;
+
+	RegisteredImporter registered;
+	if (!GetImporter(importer, registered))
+		return false;
+
+	// Source is only read when it has changed since it was last hashed
+	vector<unsigned char> source;
+	uint64_t sourceHash;
+	if (!GetSourceHash(sourcePath, sourceHash, &source))
+		return false;
+
+	string extension = GetExtension(sourcePath);
+	if (s_Enabled && LoadEntry(GetEntryPath(importer, GetKey(importer, registered.Version, sourceHash, extension, flags)), registered.Version, sourceHash, output))
+	{
+		if (fromCache)
+			*fromCache = true;
+		return true;
+	}
+
+	if (source.empty())
+	{
+		source = Read(sourcePath);
+		sourceHash = Hash(source.data(), source.size());
+	}
+	return Import(importer, registered, source, sourceHash, extension, flags, output);
+}
+
+bool ImportCache::IsCached(const string& importer, const string& sourcePath, uint32_t flags)
+{
+	RegisteredImporter registered;
+	uint64_t sourceHash;
+	if (!s_Enabled || !GetImporter(importer, registered) || !GetSourceHash(sourcePath, sourceHash))
+		return false;
+	return fs::exists(GetEntryPath(importer, GetKey(importer, registered.Version, sourceHash, GetExtension(sourcePath), flags)));
+}
+
+ImportCacheWarmResult ImportCache::Warm(const vector<ImportCacheJob>& jobs, unsigned int threadCount)
+{
+	atomic_uint cached = 0, imported = 0, failed = 0;
+
+	ThreadPool pool(threadCount);
+	pool.ParallelFor(jobs.size(), [&](size_t i)
+	{
+		const ImportCacheJob& job = jobs[i];
+		if (IsCached(job.Importer, job.SourcePath, job.Flags))
+		{
+			cached++;
+			return;
+		}
+
+		vector<unsigned char> output;
+		bool fromCache = false;
+		if (!Import(job.Importer, job.SourcePath, job.Flags, output, &fromCache))
+			failed++;
+		else if (fromCache)
+			cached++; // Identical source imported by another job
+		else
+			imported++;
+	});
+
+	Flush();
+	return { cached, imported, failed };
+}
+#pragma endregion
+
+void ImportCache::Clear()
+{
+	lock_guard lock(s_Mutex);
+
+	error_code error;
+	fs::remove_all(GetDirectoryLocked(), error);
+
+	s_Sources.clear();
+	s_SourcesLoaded = true;
+	s_SourcesDirty = false;
+}
+
+const string& ImportCache::GetDirectoryLocked()
+{
+	if (s_Directory.empty())
+		s_Directory = Application::GetPersistentDirectory() + "ImportCache/";
+	return s_Directory;
+}
+
+string ImportCache::GetDirectory()
+{
+	lock_guard lock(s_Mutex);
+	return GetDirectoryLocked();
+}
+
+void ImportCache::SetDirectory(string directory)
+{
+	if (!directory.empty() && directory.back() != '/' && directory.back() != '\\')
+		directory += "/";
+
+	Flush();
+
+	lock_guard lock(s_Mutex);
+	s_Directory = directory;
+	s_Sources.clear();
+	s_SourcesLoaded = false;
+	s_SourcesDirty = false;
+}
+
+bool ImportCache::IsEnabled() { return s_Enabled; }
+void ImportCache::SetEnabled(bool enabled) { s_Enabled = enabled; }
+
+#pragma region Managed Binding
+#include <Yonai/Scripting/InternalCalls.hpp>
+
+ADD_MANAGED_METHOD(ImportCache, GetDirectory, MonoString*, (), Yonai.IO)
+{ return mono_string_new(mono_domain_get(), ImportCache::GetDirectory().c_str()); }
+
+ADD_MANAGED_METHOD(ImportCache, SetDirectory, void, (MonoString* directoryRaw), Yonai.IO)
+{
+	char* directory = mono_string_to_utf8(directoryRaw);
+	ImportCache::SetDirectory(directory);
+	mono_free(directory);
+}
+
+ADD_MANAGED_METHOD(ImportCache, Flush, void, (), Yonai.IO)
+{ ImportCache::Flush(); }
+
+ADD_MANAGED_METHOD(ImportCache, Clear, void, (), Yonai.IO)
+{ ImportCache::Clear(); }
+#pragma endregion
@@ -0,0 +1,186 @@
+#include <cstring>
+#include <algorithm>
+#include <Yonai/IO/LZ4.hpp>
+
+using namespace std;
+using namespace Yonai::IO;
+
+/// <summary>
+/// Shortest match that can be encoded
+/// </summary>
+static constexpr size_t MinMatch = 4;
+
+/// <summary>
+/// Last bytes of a block are always literals
+/// </summary>
+static constexpr size_t LastLiterals = 5;
+
+/// <summary>
+/// Last match must start at least this many bytes before the end of a block
+/// </summary>
+static constexpr size_t MatchStartLimit = 12;
+
+static constexpr size_t MaxOffset = 65535;
+static constexpr unsigned int HashBits = 16;
+
+static uint32_t Read32(const unsigned char* data)
+{
+	uint32_t value;
+	memcpy(&value, data, sizeof(value));
+	return value;
+}
+
+static uint32_t HashSequence(uint32_t sequence) { return (sequence * 2654435761u) >> (32 - HashBits); }
+
+static unsigned char* WriteLength(unsigned char* output, size_t length)
+{
+	for (; length >= 255; length -= 255)
+		*output++ = 255;
+	*output++ = (unsigned char)length;
+	return output;
+}
+
+static unsigned char* WriteSequence(unsigned char* output, const unsigned char* literals, size_t literalLength, size_t offset, size_t matchLength)
+{
+	unsigned char* token = output++;
+	*token = (unsigned char)(min<size_t>(literalLength, 15) << 4);
+	if (literalLength >= 15)
+		output = WriteLength(output, literalLength - 15);
+	memcpy(output, literals, literalLength);
+	output += literalLength;
+
+	// Final sequence only contains literals
+	if (matchLength == 0)
+		return output;
+
+	*output++ = (unsigned char)(offset & 0xFF);
+	*output++ = (unsigned char)(offset >> 8);
+
+	matchLength -= MinMatch;
+	*token |= (unsigned char)min<size_t>(matchLength, 15);
+	if (matchLength >= 15)
+		output = WriteLength(output, matchLength - 15);
+	return output;
+}
+
+size_t LZ4::GetMaxCompressedSize(size_t inputSize) { return inputSize + inputSize / 255 + 16; }
+
+// Each extra byte of match length costs at least one byte of input, limiting the ratio to about 255:1
+uint64_t LZ4::GetMaxDecompressedSize(uint64_t compressedSize) { return compressedSize * 255 + 16; }
+
+void LZ4::Compress(ByteSpan input, vector<unsigned char>& output)
+{
+	output.resize(GetMaxCompressedSize(input.size()));
+
+	const unsigned char* source = input.data();
+	const size_t size = input.size();
+	unsigned char* write = output.data();
+	size_t anchor = 0;
+
+	if (size > MatchStartLimit)
+	{
+		// Most recent position of each hashed 4 byte sequence
+		vector<uint32_t> table((size_t)1 << HashBits, 0);
+
+		const size_t matchStartLimit = size - MatchStartLimit;
+		const size_t matchEndLimit = size - LastLiterals;
+		size_t position = 0;
+		unsigned int misses = 0;
+		while (position <= matchStartLimit)
+		{
+			uint32_t sequence = Read32(source + position);
+			uint32_t& entry = table[HashSequence(sequence)];
+			size_t candidate = entry;
+			entry = (uint32_t)position;
+
+			if (candidate >= position || position - candidate > MaxOffset || Read32(source + candidate) != sequence)
+			{
+				// Step further through data that is not compressing
+				position += 1 + (misses++ >> 6);
+				continue;
+			}
+			misses = 0;
+
+			size_t matchLength = MinMatch;
+			while (position + matchLength < matchEndLimit && source[candidate + matchLength] == source[position + matchLength])
+				matchLength++;
+
+			write = WriteSequence(write, source + anchor, position - anchor, position - candidate, matchLength);
+			position += matchLength;
+			anchor = position;
+		}
+	}
+
+	write = WriteSequence(write, source + anchor, size - anchor, 0, 0);
+	output.resize(write - output.data());
+}
+
+bool LZ4::Decompress(ByteSpan input, unsigned char* output, size_t outputSize)
+{
+	const unsigned char* read = input.data();
+	const unsigned char* readEnd = read + input.size();
+	unsigned char* write = output;
+	unsigned char* writeEnd = output + outputSize;
+
+	while (read < readEnd)
+	{
+		const unsigned char token = *read++;
+
+		size_t literalLength = token >> 4;
+		if (literalLength == 15)
+		{
+			unsigned char extra;
+			do
+			{
+				if (read == readEnd)
+					return false;
+				extra = *read++;
+				literalLength += extra;
+			} while (extra == 255);
+		}
+
+		if (literalLength > (size_t)(readEnd - read) || literalLength > (size_t)(writeEnd - write))
+			return false;
+		memcpy(write, read, literalLength);
+		read += literalLength;
+		write += literalLength;
+
+		// Final sequence has no match
+		if (read == readEnd)
+			break;
+
+		if (readEnd - read < 2)
+			return false;
+		size_t offset = read[0] | (read[1] << 8);
+		read += 2;
+		if (offset == 0 || offset > (size_t)(write - output))
+			return false;
+
+		size_t matchLength = token & 15;
+		if (matchLength == 15)
+		{
+			unsigned char extra;
+			do
+			{
+				if (read == readEnd)
+					return false;
+				extra = *read++;
+				matchLength += extra;
+			} while (extra == 255);
+		}
+		matchLength += MinMatch;
+		if (matchLength > (size_t)(writeEnd - write))
+			return false;
+
+		// Matches can overlap the bytes being written, repeating a pattern
+		const unsigned char* match = write - offset;
+		if (offset >= matchLength)
+			memcpy(write, match, matchLength);
+		else
+			for (size_t i = 0; i < matchLength; i++)
+				write[i] = match[i];
+		write += matchLength;
+	}
+
+	return write == writeEnd;
+}
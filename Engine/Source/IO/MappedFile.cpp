@@ -0,0 +1,152 @@
+#include <utility>
+#include <spdlog/spdlog.h>
+#include <Yonai/IO/MappedFile.hpp>
+
+#if defined(YONAI_PLATFORM_WINDOWS)
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+using namespace std;
+using namespace Yonai::IO;
+
+MappedFile::MappedFile(const string& path) { Open(path); }
+MappedFile::~MappedFile() { Close(); }
+
+MappedFile::MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+	if (this == &other)
+		return *this;
+
+	Close();
+	swap(m_Open, other.m_Open);
+	swap(m_Size, other.m_Size);
+	swap(m_Data, other.m_Data);
+#if defined(YONAI_PLATFORM_WINDOWS)
+	swap(m_File, other.m_File);
+	swap(m_Mapping, other.m_Mapping);
+#endif
+	return *this;
+}
+
+#if defined(YONAI_PLATFORM_WINDOWS)
+bool MappedFile::Open(const string& path)
+{
+	Close();
+
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		spdlog::warn("Cannot map '{}' - failed to open file", path);
+		return false;
+	}
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size))
+	{
+		spdlog::warn("Cannot map '{}' - failed to get file size", path);
+		CloseHandle(file);
+		return false;
+	}
+
+	m_File = file;
+	m_Open = true;
+
+	// Empty files cannot be mapped
+	if (size.QuadPart == 0)
+		return true;
+
+	m_Mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (m_Mapping)
+		m_Data = (const unsigned char*)MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!m_Data)
+	{
+		spdlog::warn("Cannot map '{}' - error {}", path, GetLastError());
+		Close();
+		return false;
+	}
+
+	m_Size = (size_t)size.QuadPart;
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (m_Data)
+		UnmapViewOfFile(m_Data);
+	if (m_Mapping)
+		CloseHandle(m_Mapping);
+	if (m_File)
+		CloseHandle(m_File);
+
+	m_Open = false;
+	m_Size = 0;
+	m_Data = nullptr;
+	m_File = m_Mapping = nullptr;
+}
+#else
+bool MappedFile::Open(const string& path)
+{
+	Close();
+
+	int file = open(path.c_str(), O_RDONLY);
+	if (file < 0)
+	{
+		spdlog::warn("Cannot map '{}' - failed to open file", path);
+		return false;
+	}
+
+	struct stat info;
+	if (fstat(file, &info) != 0 || !S_ISREG(info.st_mode))
+	{
+		spdlog::warn("Cannot map '{}' - not a regular file", path);
+		close(file);
+		return false;
+	}
+
+	// Empty files cannot be mapped
+	if (info.st_size > 0)
+	{
+		void* data = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+		if (data == MAP_FAILED)
+		{
+			spdlog::warn("Cannot map '{}' - mmap failed", path);
+			close(file);
+			return false;
+		}
+
+		// Most consumers read the whole file front to back
+		madvise(data, (size_t)info.st_size, MADV_SEQUENTIAL);
+
+		m_Data = (const unsigned char*)data;
+		m_Size = (size_t)info.st_size;
+	}
+
+	// Mapping stays valid after the descriptor is closed
+	close(file);
+	m_Open = true;
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (m_Data)
+		munmap((void*)m_Data, m_Size);
+
+	m_Open = false;
+	m_Size = 0;
+	m_Data = nullptr;
+}
+#endif
+
+bool MappedFile::IsOpen() const { return m_Open; }
+size_t MappedFile::GetSize() const { return m_Size; }
+const unsigned char* MappedFile::GetData() const { return m_Data; }
+ByteSpan MappedFile::GetSpan() const { return ByteSpan(m_Data, m_Size); }
@@ -0,0 +1,382 @@
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+#include <string_view>
+#include <spdlog/spdlog.h>
+#include <Yonai/Utils.hpp>
+#include <Yonai/IO/LZ4.hpp>
+#include <Yonai/IO/PackArchive.hpp>
+
+using namespace std;
+using namespace Yonai;
+using namespace Yonai::IO;
+
+#pragma region PackArchive
+PackArchive::PackArchive(const string& path) { Open(path); }
+
+bool PackArchive::Open(const string& path)
+{
+	Close();
+	if (!m_File.Open(path))
+		return false;
+
+	auto invalid = [&](const char* reason)
+	{
+		spdlog::warn("Cannot open pack '{}' - {}", path, reason);
+		Close();
+		return false;
+	};
+
+	const ByteSpan data = m_File.GetSpan();
+	if (data.size() < sizeof(PackHeader))
+		return invalid("file too small");
+
+	// Mappings are page aligned, so the header and table can be used in place
+	const PackHeader* header = (const PackHeader*)data.data();
+	if (header->Magic != FileMagic)
+		return invalid("not a pack file");
+	if (header->Version != FileVersion)
+		return invalid("unsupported version");
+
+	const uint64_t tableSize = (uint64_t)header->EntryCount * sizeof(PackEntry);
+	if (header->TableOffset % alignof(PackEntry) != 0 ||
+		header->TableOffset > data.size() || tableSize > data.size() - header->TableOffset ||
+		header->PathsOffset > data.size() || header->PathsSize > data.size() - header->PathsOffset)
+		return invalid("table out of range");
+
+	const PackEntry* entries = (const PackEntry*)(data.data() + header->TableOffset);
+	for (uint32_t i = 0; i < header->EntryCount; i++)
+	{
+		const PackEntry& entry = entries[i];
+		if (entry.Offset > data.size() || entry.Size > data.size() - entry.Offset ||
+			(uint64_t)entry.PathOffset + entry.PathLength > header->PathsSize)
+			return invalid("entry out of range");
+		if (entry.Compression > PackCompression::LZ4 ||
+			(entry.Compression == PackCompression::None && entry.Size != entry.UncompressedSize))
+			return invalid("invalid compression");
+
+		// Uncompressed size is allocated when reading, don't trust it past what the data could decompress to
+		if (entry.Compression == PackCompression::LZ4 && entry.UncompressedSize > LZ4::GetMaxDecompressedSize(entry.Size))
+			return invalid("uncompressed size out of range");
+		if (i > 0 && entries[i - 1].PathHash > entry.PathHash)
+			return invalid("table not sorted");
+	}
+
+	m_Path = path;
+	m_Header = header;
+	m_Entries = entries;
+	m_Paths = (const char*)data.data() + header->PathsOffset;
+	return true;
+}
+
+void PackArchive::Close()
+{
+	m_File.Close();
+	m_Path.clear();
+	m_Header = nullptr;
+	m_Entries = nullptr;
+	m_Paths = nullptr;
+}
+
+bool PackArchive::IsOpen() const { return m_Header != nullptr; }
+const string& PackArchive::GetPath() const { return m_Path; }
+size_t PackArchive::GetEntryCount() const { return m_Header ? m_Header->EntryCount : 0; }
+const PackEntry& PackArchive::GetEntry(size_t index) const { return m_Entries[index]; }
+string PackArchive::GetPath(const PackEntry& entry) const { return string(m_Paths + entry.PathOffset, entry.PathLength); }
+
+const PackEntry* PackArchive::Find(const string& path) const
+{
+	if (!m_Header)
+		return nullptr;
+
+	const string normalised = NormalisePath(path);
+	const uint64_t hash = Hash(normalised);
+
+	const PackEntry* end = m_Entries + m_Header->EntryCount;
+	const PackEntry* entry = lower_bound(m_Entries, end, hash,
+		[](const PackEntry& entry, uint64_t hash) { return entry.PathHash < hash; });
+
+	// Compare paths in case of hash collisions
+	for (; entry != end && entry->PathHash == hash; entry++)
+		if (entry->PathLength == normalised.size() &&
+			memcmp(m_Paths + entry->PathOffset, normalised.data(), normalised.size()) == 0)
+			return entry;
+	return nullptr;
+}
+
+bool PackArchive::Exists(const string& path) const { return Find(path) != nullptr; }
+
+ByteSpan PackArchive::GetData(const PackEntry& entry) const { return m_File.GetSpan().subspan(entry.Offset, entry.Size); }
+
+bool PackArchive::Read(const PackEntry& entry, vector<unsigned char>& output) const
+{
+	output.resize(entry.UncompressedSize);
+	ByteSpan data = GetData(entry);
+
+	if (entry.Compression == PackCompression::None)
+	{
+		if (!data.empty())
+			memcpy(output.data(), data.data(), data.size());
+		return true;
+	}
+
+	if (!LZ4::Decompress(data, output.data(), output.size()))
+	{
+		spdlog::warn("Failed to decompress '{}' from pack '{}'", GetPath(entry), m_Path);
+		output.clear();
+		return false;
+	}
+	return true;
+}
+
+bool PackArchive::Read(const string& path, vector<unsigned char>& output) const
+{
+	const PackEntry* entry = Find(path);
+	if (!entry)
+	{
+		output.clear();
+		return false;
+	}
+	return Read(*entry, output);
+}
+
+string PackArchive::NormalisePath(string path)
+{
+	replace(path.begin(), path.end(), '\\', '/');
+
+	size_t start = 0;
+	while (true)
+	{
+		if (path.compare(start, 2, "./") == 0)
+			start += 2;
+		else if (path.compare(start, 1, "/") == 0)
+			start++;
+		else
+			break;
+	}
+	return path.substr(start);
+}
+#pragma endregion
+
+#pragma region PackWriter
+PackWriter::Source& PackWriter::AddSource(const string& path, PackCompression compression)
+{
+	string normalised = PackArchive::NormalisePath(path);
+
+	auto existing = m_SourceIndices.find(normalised);
+	if (existing == m_SourceIndices.end())
+	{
+		m_SourceIndices.emplace(normalised, m_Sources.size());
+		m_Sources.emplace_back();
+		existing = m_SourceIndices.find(normalised);
+	}
+
+	Source& source = m_Sources[existing->second];
+	source = { normalised, "", {}, compression };
+	return source;
+}
+
+void PackWriter::Add(const string& path, ByteSpan data, PackCompression compression)
+{ AddSource(path, compression).Data.assign(data.begin(), data.end()); }
+
+void PackWriter::AddFile(const string& path, const string& filePath, PackCompression compression)
+{ AddSource(path, compression).FilePath = filePath; }
+
+size_t PackWriter::GetEntryCount() const { return m_Sources.size(); }
+
+/// <summary>
+/// Writes zeroes until offset is a multiple of alignment
+/// </summary>
+/// <returns>Aligned offset</returns>
+static uint64_t WritePadding(ofstream& file, uint64_t offset, uint64_t alignment)
+{
+	for (; offset % alignment != 0; offset++)
+		file.put(0);
+	return offset;
+}
+
+bool PackWriter::Write(const string& outputPath, uint32_t alignment)
+{
+	if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+	{
+		spdlog::error("Failed to write pack '{}' - alignment must be a power of two", outputPath);
+		return false;
+	}
+
+	ofstream file(outputPath, ios::out | ios::binary | ios::trunc);
+	if (!file)
+	{
+		spdlog::error("Failed to write pack '{}' - could not open file", outputPath);
+		return false;
+	}
+
+	// Header is written again once offsets are known
+	PackHeader header = { PackArchive::FileMagic, PackArchive::FileVersion, (uint32_t)m_Sources.size(), alignment, 0, 0, 0 };
+	file.write((const char*)&header, sizeof(header));
+	uint64_t offset = sizeof(header);
+
+	string paths;
+	vector<PackEntry> entries;
+	entries.reserve(m_Sources.size());
+	vector<unsigned char> compressed;
+	for (const Source& source : m_Sources)
+	{
+		MappedFile mappedFile;
+		ByteSpan data = source.Data;
+		if (!source.FilePath.empty())
+		{
+			if (!mappedFile.Open(source.FilePath))
+			{
+				spdlog::error("Failed to write pack '{}' - could not read '{}'", outputPath, source.FilePath);
+				return false;
+			}
+			data = mappedFile;
+		}
+
+		PackEntry entry = {};
+		entry.PathHash = Hash(source.Path);
+		entry.PathOffset = (uint32_t)paths.size();
+		entry.PathLength = (uint32_t)source.Path.size();
+		entry.UncompressedSize = data.size();
+		entry.Compression = PackCompression::None;
+		paths += source.Path;
+
+		if (source.Compression == PackCompression::LZ4 && !data.empty())
+		{
+			LZ4::Compress(data, compressed);
+			if (compressed.size() < data.size())
+			{
+				data = compressed;
+				entry.Compression = PackCompression::LZ4;
+			}
+		}
+
+		offset = WritePadding(file, offset, alignment);
+		entry.Offset = offset;
+		entry.Size = data.size();
+		file.write((const char*)data.data(), data.size());
+		offset += data.size();
+
+		entries.push_back(entry);
+	}
+
+	sort(entries.begin(), entries.end(), [&](const PackEntry& a, const PackEntry& b)
+	{
+		if (a.PathHash != b.PathHash)
+			return a.PathHash < b.PathHash;
+		return string_view(paths.data() + a.PathOffset, a.PathLength) < string_view(paths.data() + b.PathOffset, b.PathLength);
+	});
+
+	offset = WritePadding(file, offset, alignof(PackEntry));
+	header.TableOffset = offset;
+	file.write((const char*)entries.data(), entries.size() * sizeof(PackEntry));
+	offset += entries.size() * sizeof(PackEntry);
+
+	header.PathsOffset = offset;
+	header.PathsSize = paths.size();
+	file.write(paths.data(), paths.size());
+
+	file.seekp(0);
+	file.write((const char*)&header, sizeof(header));
+	file.flush();
+
+	if (!file)
+	{
+		spdlog::error("Failed to write pack '{}'", outputPath);
+		return false;
+	}
+	return true;
+}
+#pragma endregion
+
+#pragma region Managed Binding
+#include <Yonai/Scripting/InternalCalls.hpp>
+
+ADD_MANAGED_METHOD(PackArchive, Open, void*, (MonoString* pathRaw), Yonai.IO)
+{
+	char* path = mono_string_to_utf8(pathRaw);
+	PackArchive* archive = new PackArchive(path);
+	mono_free(path);
+
+	if (archive->IsOpen())
+		return archive;
+	delete archive;
+	return nullptr;
+}
+
+ADD_MANAGED_METHOD(PackArchive, Close, void, (void* handle), Yonai.IO)
+{ delete (PackArchive*)handle; }
+
+ADD_MANAGED_METHOD(PackArchive, Exists, bool, (void* handle, MonoString* pathRaw), Yonai.IO)
+{
+	char* path = mono_string_to_utf8(pathRaw);
+	bool exists = ((PackArchive*)handle)->Exists(path);
+	mono_free(path);
+	return exists;
+}
+
+ADD_MANAGED_METHOD(PackArchive, GetEntry, bool, (void* handle, MonoString* pathRaw, unsigned long long* outSize, bool* outCompressed), Yonai.IO)
+{
+	char* path = mono_string_to_utf8(pathRaw);
+	const PackEntry* entry = ((PackArchive*)handle)->Find(path);
+	mono_free(path);
+	if (!entry)
+		return false;
+
+	*outSize = entry->UncompressedSize;
+	*outCompressed = entry->Compression != PackCompression::None;
+	return true;
+}
+
+ADD_MANAGED_METHOD(PackArchive, Read, MonoArray*, (void* handle, MonoString* pathRaw), Yonai.IO)
+{
+	PackArchive* archive = (PackArchive*)handle;
+	char* path = mono_string_to_utf8(pathRaw);
+	const PackEntry* entry = archive->Find(path);
+	mono_free(path);
+	if (!entry)
+		return nullptr;
+
+	// Copied or decompressed straight in to the managed array
+	MonoArray* output = mono_array_new(mono_domain_get(), mono_get_byte_class(), entry->UncompressedSize);
+	unsigned char* outputData = mono_array_addr(output, unsigned char, 0);
+	ByteSpan data = archive->GetData(*entry);
+	if (entry->Compression == PackCompression::None)
+		memcpy(outputData, data.data(), data.size());
+	else if (!LZ4::Decompress(data, outputData, entry->UncompressedSize))
+	{
+		spdlog::warn("Failed to decompress '{}' from pack '{}'", archive->GetPath(*entry), archive->GetPath());
+		return nullptr;
+	}
+	return output;
+}
+
+ADD_MANAGED_METHOD(PackArchive, GetFiles, MonoArray*, (void* handle), Yonai.IO)
+{
+	PackArchive* archive = (PackArchive*)handle;
+	MonoArray* output = mono_array_new(mono_domain_get(), mono_get_string_class(), archive->GetEntryCount());
+	for (size_t i = 0; i < archive->GetEntryCount(); i++)
+		mono_array_setref(output, i, mono_string_new(mono_domain_get(), archive->GetPath(archive->GetEntry(i)).c_str()));
+	return output;
+}
+
+ADD_MANAGED_METHOD(PackArchive, Create, bool, (MonoString* outputPathRaw, MonoArray* pathsRaw, MonoArray* filePathsRaw, MonoArray* compressRaw), Yonai.IO)
+{
+	PackWriter writer;
+	size_t count = std::min({ mono_array_length(pathsRaw), mono_array_length(filePathsRaw), mono_array_length(compressRaw) });
+	for (size_t i = 0; i < count; i++)
+	{
+		char* path = mono_string_to_utf8(mono_array_get(pathsRaw, MonoString*, i));
+		char* filePath = mono_string_to_utf8(mono_array_get(filePathsRaw, MonoString*, i));
+		bool compress = mono_array_get(compressRaw, bool, i);
+		writer.AddFile(path, filePath, compress ? PackCompression::LZ4 : PackCompression::None);
+		mono_free(path);
+		mono_free(filePath);
+	}
+
+	char* outputPath = mono_string_to_utf8(outputPathRaw);
+	bool success = writer.Write(outputPath);
+	mono_free(outputPath);
+	return success;
+}
+#pragma endregion
@@ -1,132 +1,653 @@
+#include <queue>
+#include <chrono>
+#include <unordered_set>
 #include <Yonai/Resource.hpp>
 
 using namespace std;
 using namespace Yonai;
 
-vector<Resource::ResourceInstance> Resource::s_Instances;
+atomic<Resource::ResourceSlot*> Resource::s_Pages[MaxPages];
+atomic<uint32_t> Resource::s_SlotCount = 0;
+vector<uint32_t> Resource::s_FreeSlots;
 unordered_map<string, ResourceID> Resource::s_InstancePaths;
-unordered_map<ResourceID, size_t> Resource::s_ResourceIDs;
+unordered_map<ResourceID, ResourceHandle> Resource::s_ResourceIDs;
+vector<Resource::PendingDestruction> Resource::s_PendingDestruction;
+shared_mutex Resource::s_Mutex;
+condition_variable_any Resource::s_LoadedCondition;
+unordered_map<ResourceID, vector<ResourceID>> Resource::s_Dependencies;
+unordered_map<ResourceID, vector<ResourceID>> Resource::s_Dependents;
+unordered_map<ResourceID, vector<string>> Resource::s_FileDependencies;
+unordered_map<string, vector<ResourceID>> Resource::s_FileDependents;
+unordered_map<type_index, ResourceReloader> Resource::s_Reloaders;
+ResourceReloader Resource::s_DefaultReloader;
+vector<ResourceID> Resource::s_Invalidated;
+mutex Resource::s_DependencyMutex;
+
+Resource::ResourceSlot* Resource::GetSlot(uint32_t index)
+{
+	if (index >= MaxPages * SlotsPerPage)
+		return nullptr;
+	ResourceSlot* page = s_Pages[index / SlotsPerPage].load(memory_order_acquire);
+	return page ? &page[index % SlotsPerPage] : nullptr;
+}
+
+ResourceID Resource::Reserve(ResourceID id, const string& path, type_index type, ResourceState state, bool& created)
+{
+	created = false;
+	unique_lock lock(s_Mutex);
+
+	// Check if instance already exists
+	auto cacheIt = s_InstancePaths.find(path);
+	if (cacheIt != s_InstancePaths.end())
+	{
+		ResourceSlot* slot = GetSlot(s_ResourceIDs[cacheIt->second].Index);
+		if (slot->Type != type)
+		{
+			spdlog::error("Tried loading cached resource '{}' of type '{}' but expected '{}'", path, slot->Type.name(), type.name());
+			return InvalidResourceID;
+		}
+		slot->References++;
+		return cacheIt->second;
+	}
+
+	if (id == InvalidResourceID || s_ResourceIDs.find(id) != s_ResourceIDs.end())
+	{
+		spdlog::error("Failed to load resource '{}' - ID [{}] is invalid or already in use", path, id);
+		return InvalidResourceID;
+	}
+
+	uint32_t index;
+	if (!s_FreeSlots.empty())
+	{
+		index = s_FreeSlots.back();
+		s_FreeSlots.pop_back();
+	}
+	else
+	{
+		index = s_SlotCount;
+		if (index >= MaxPages * SlotsPerPage)
+		{
+			spdlog::error("Failed to load resource '{}' - too many resources loaded", path);
+			return InvalidResourceID;
+		}
+
+		if (index % SlotsPerPage == 0)
+			s_Pages[index / SlotsPerPage].store(new ResourceSlot[SlotsPerPage], memory_order_release);
+		s_SlotCount++;
+	}
+
+	ResourceSlot* slot = GetSlot(index);
+	slot->Type = type;
+	slot->ID = id;
+	slot->Path = path;
+	slot->Deleter = nullptr;
+	slot->References = 1;
+	slot->State = state;
+
+	s_InstancePaths.emplace(path, id);
+	s_ResourceIDs.emplace(id, ResourceHandle { index, slot->Generation.load() });
+
+	created = true;
+	return id;
+}
+
+void Resource::Publish(ResourceID id, void* data, ResourceDeleter deleter)
+{
+	{
+		unique_lock lock(s_Mutex);
+		auto it = s_ResourceIDs.find(id);
+		if (it != s_ResourceIDs.end())
+		{
+			ResourceSlot* slot = GetSlot(it->second.Index);
+			ResourceState state = slot->State;
+			if (state == ResourceState::Queued || state == ResourceState::Loading)
+			{
+				slot->Deleter = deleter;
+				slot->Data = data;
+				slot->State = data ? ResourceState::Ready : ResourceState::Failed;
+				s_LoadedCondition.notify_all();
+				return;
+			}
+		}
+	}
+
+	// Unloaded while loading
+	if (data && deleter)
+		deleter(data);
+}
+
+void Resource::SetState(ResourceID id, ResourceState state)
+{
+	shared_lock lock(s_Mutex);
+	auto it = s_ResourceIDs.find(id);
+	if (it != s_ResourceIDs.end())
+		GetSlot(it->second.Index)->State = state;
+}
+
+ResourceState Resource::GetState(ResourceID id)
+{
+	shared_lock lock(s_Mutex);
+	auto it = s_ResourceIDs.find(id);
+	return it == s_ResourceIDs.end() ? ResourceState::Unloaded : GetSlot(it->second.Index)->State.load();
+}
+
+void Resource::WaitUntilLoaded(ResourceID id)
+{
+	shared_lock lock(s_Mutex);
+	s_LoadedCondition.wait(lock, [id]()
+	{
+		auto it = s_ResourceIDs.find(id);
+		if (it == s_ResourceIDs.end())
+			return true; // Released
+		ResourceState state = GetSlot(it->second.Index)->State;
+		return state != ResourceState::Queued && state != ResourceState::Loading;
+	});
+}
+
+ThreadPool& Resource::GetLoadPool()
+{
+	static ThreadPool pool;
+	return pool;
+}
 
 string Resource::GetPath(ResourceID id)
 {
-	for (auto it = s_InstancePaths.begin(); it != s_InstancePaths.end(); it++)
-		if (it->second == id)
-			return it->first;
-	return "";
+	shared_lock lock(s_Mutex);
+	auto it = s_ResourceIDs.find(id);
+	return it == s_ResourceIDs.end() ? "" : GetSlot(it->second.Index)->Path;
 }
 
 ResourceID Resource::GetID(const string& path)
 {
-	return s_InstancePaths.find(path) == s_InstancePaths.end() ?
-		InvalidResourceID : s_InstancePaths[path];
+	shared_lock lock(s_Mutex);
+	auto it = s_InstancePaths.find(path);
+	return it == s_InstancePaths.end() ? InvalidResourceID : it->second;
 }
 
-void* Resource::Get(ResourceID id)
+ResourceHandle Resource::GetHandle(ResourceID id)
 {
-	ResourceInstance* instance = GetInstance(id);
-	return instance ? instance->Data : nullptr;
+	shared_lock lock(s_Mutex);
+	auto it = s_ResourceIDs.find(id);
+	return it == s_ResourceIDs.end() ? ResourceHandle() : it->second;
 }
 
-void* Resource::Get(string path)
+bool Resource::IsValid(ResourceHandle handle) { return Get(handle) != nullptr; }
+
+void* Resource::Get(ResourceHandle handle)
 {
-	if (!Exists(path))
+	ResourceSlot* slot = GetSlot(handle.Index);
+	if (!slot || slot->Generation.load(memory_order_acquire) != handle.Generation)
 		return nullptr;
-	ResourceInstance* instance = GetInstance(s_InstancePaths[path]);
-	return instance ? instance->Data : nullptr;
+
+	// Generation is checked again in case the slot was released while reading data.
+	// Released data is destroyed at the end of the frame, so is still valid when returned.
+	void* data = slot->Data.load(memory_order_acquire);
+	return slot->Generation.load(memory_order_acquire) == handle.Generation ? data : nullptr;
+}
+
+void* Resource::Get(ResourceID id, type_index type)
+{
+	shared_lock lock(s_Mutex);
+	auto it = s_ResourceIDs.find(id);
+	if (it == s_ResourceIDs.end())
+		return nullptr;
+	ResourceSlot* slot = GetSlot(it->second.Index);
+	return slot->Type == type ? slot->Data.load() : nullptr;
+}
+
+void* Resource::Get(ResourceID id)
+{
+	shared_lock lock(s_Mutex);
+	auto it = s_ResourceIDs.find(id);
+	return it == s_ResourceIDs.end() ? nullptr : GetSlot(it->second.Index)->Data.load();
+}
+
+void* Resource::Get(string path) { return Get(GetID(path)); }
+
+void Resource::AddReference(ResourceID id)
+{
+	shared_lock lock(s_Mutex);
+	auto it = s_ResourceIDs.find(id);
+	if (it != s_ResourceIDs.end())
+		GetSlot(it->second.Index)->References++;
+}
+
+void Resource::Release(ResourceID id)
+{
+	unique_lock lock(s_Mutex);
+	auto it = s_ResourceIDs.find(id);
+	if (it == s_ResourceIDs.end())
+		return;
+
+	if (--GetSlot(it->second.Index)->References <= 0)
+		ReleaseSlot(id);
+}
+
+int Resource::GetReferenceCount(ResourceID id)
+{
+	shared_lock lock(s_Mutex);
+	auto it = s_ResourceIDs.find(id);
+	return it == s_ResourceIDs.end() ? 0 : GetSlot(it->second.Index)->References.load();
 }
 
 void Resource::Unload(ResourceID resource)
 {
-	if (!IsValidResourceID(resource))
+	unique_lock lock(s_Mutex);
+	if (resource == InvalidResourceID || s_ResourceIDs.find(resource) == s_ResourceIDs.end())
 	{
 		spdlog::error("Failed to unload resource [{}] - invalid ID", resource);
 		return;
 	}
 
-	// Unload data & remove from instances
-	size_t instanceIndex = s_ResourceIDs[resource];
+	ReleaseSlot(resource);
+}
+
+void Resource::ReleaseSlot(ResourceID id)
+{
+	auto it = s_ResourceIDs.find(id);
+	uint32_t index = it->second.Index;
+	ResourceSlot* slot = GetSlot(index);
+	s_ResourceIDs.erase(it);
+
+	auto pathIt = s_InstancePaths.find(slot->Path);
+	if (pathIt != s_InstancePaths.end() && pathIt->second == id)
+		s_InstancePaths.erase(pathIt);
+
+	// Existing handles are invalidated by the new generation.
+	// Slot is reused once the data is destroyed, so lock-free readers never see another resource's data.
+	slot->Generation++;
+	void* data = slot->Data.exchange(nullptr);
+	slot->State = ResourceState::Unloaded;
+	slot->References = 0;
+	s_LoadedCondition.notify_all();
+	s_PendingDestruction.push_back({ data, slot->Deleter, index });
+
+	slot->Type = typeid(void);
+	slot->Deleter = nullptr;
+	slot->ID = InvalidResourceID;
+	slot->Path.clear();
+
+	// Resources depending on this one keep their edges, in case it is loaded again with the same ID
+	lock_guard dependencyLock(s_DependencyMutex);
+	ClearDependencies(id);
+}
+
+void Resource::DestroyPending()
+{
+	vector<PendingDestruction> pending;
+	{
+		unique_lock lock(s_Mutex);
+		pending.swap(s_PendingDestruction);
+	}
+	if (pending.empty())
+		return;
+
+	// Destructors can unload other resources, so are called without holding the lock
+	for (PendingDestruction& resource : pending)
+		if (resource.Data && resource.Deleter)
+			resource.Deleter(resource.Data);
+
+	unique_lock lock(s_Mutex);
+	for (PendingDestruction& resource : pending)
+		s_FreeSlots.push_back(resource.SlotIndex);
+}
+
+void Resource::UnloadAll()
+{
+	// Finish in-progress loads, otherwise they complete after their resource is released
+	GetLoadPool().Wait();
+
+	{
+		unique_lock lock(s_Mutex);
+		vector<ResourceID> ids;
+		ids.reserve(s_ResourceIDs.size());
+		for (auto& pair : s_ResourceIDs)
+			ids.emplace_back(pair.first);
+		for (ResourceID id : ids)
+			ReleaseSlot(id);
+
+		lock_guard dependencyLock(s_DependencyMutex);
+		s_Dependencies.clear();
+		s_Dependents.clear();
+		s_FileDependencies.clear();
+		s_FileDependents.clear();
+		s_Invalidated.clear();
+	}
+
+	DestroyPending();
+}
+
+bool Resource::Exists(string path)
+{
+	shared_lock lock(s_Mutex);
+	return s_InstancePaths.find(path) != s_InstancePaths.end();
+}
+
+bool Resource::IsValidResourceID(ResourceID id)
+{
+	shared_lock lock(s_Mutex);
+	return id != InvalidResourceID &&
+		s_ResourceIDs.find(id) != s_ResourceIDs.end();
+}
 
-	// Call destructor if inherits from ResourceBase
-	ResourceInstance& resourceInstance = s_Instances[instanceIndex];
-	if (resourceInstance.IsResourceBaseType)
-		((ResourceBase*)resourceInstance.Data)->~ResourceBase();
+void Resource::PrintResourceTypes() { PrintResourceTypes(nullptr); }
 
-	delete s_Instances[instanceIndex].Data;
-	s_Instances[instanceIndex].Data = nullptr;
+void Resource::PrintResourceTypes(const type_index* type)
+{
+	shared_lock lock(s_Mutex);
+	if (type)
+		spdlog::trace("Printing resources [{}]", type->name());
+	else
+		spdlog::trace("Printing resources:");
 
-	// Put last instance into removed index, then erase the last element.
-	// This is done because with a traditional vector::erase all elements get relocated,
-	//	moving the final element to override the erased instance provides more efficiency
-	size_t lastIndex = s_Instances.size() - 1;
-	if (instanceIndex < lastIndex)
+	for (auto& pair : s_InstancePaths)
 	{
-		// Move last instance to override erased one
-		s_Instances[instanceIndex] = s_Instances[lastIndex];
+		ResourceHandle handle = s_ResourceIDs[pair.second];
+		ResourceSlot* slot = GetSlot(handle.Index);
+		if (!type)
+			spdlog::trace(" [{}->{}][{}] \t{}", pair.second, handle.Index, slot->Type.name(), pair.first);
+		else if (slot->Type == *type)
+			spdlog::trace(" [{}->{}] {}", pair.second, handle.Index, pair.first);
+	}
+}
 
-		// Update ResourceID<->InstanceIndex mapping
-		for (auto& it : s_ResourceIDs)
+type_index Resource::GetType(ResourceID id)
+{
+	shared_lock lock(s_Mutex);
+	auto it = s_ResourceIDs.find(id);
+	return it == s_ResourceIDs.end() ? type_index(typeid(void)) : GetSlot(it->second.Index)->Type;
+}
+
+static void RemoveValue(vector<ResourceID>& values, ResourceID value)
+{ values.erase(remove(values.begin(), values.end(), value), values.end()); }
+
+void Resource::ClearDependencies(ResourceID id)
+{
+	auto it = s_Dependencies.find(id);
+	if (it != s_Dependencies.end())
+	{
+		for (ResourceID dependency : it->second)
 		{
-			if (it.second == lastIndex)
-			{
-				s_ResourceIDs[it.first] = instanceIndex;
-				break;
-			}
+			auto dependentsIt = s_Dependents.find(dependency);
+			if (dependentsIt == s_Dependents.end())
+				continue;
+			RemoveValue(dependentsIt->second, id);
+			if (dependentsIt->second.empty())
+				s_Dependents.erase(dependentsIt);
+		}
+		s_Dependencies.erase(it);
+	}
+
+	auto fileIt = s_FileDependencies.find(id);
+	if (fileIt != s_FileDependencies.end())
+	{
+		for (const string& path : fileIt->second)
+		{
+			auto dependentsIt = s_FileDependents.find(path);
+			if (dependentsIt == s_FileDependents.end())
+				continue;
+			RemoveValue(dependentsIt->second, id);
+			if (dependentsIt->second.empty())
+				s_FileDependents.erase(dependentsIt);
 		}
+		s_FileDependencies.erase(fileIt);
 	}
+}
 
-	s_Instances.pop_back();
+void Resource::AddDependency(ResourceID dependent, ResourceID dependency)
+{
+	if (dependent == InvalidResourceID || dependency == InvalidResourceID)
+		return;
+	if (dependent == dependency)
+	{
+		spdlog::warn("Resource [{}] cannot depend on itself", dependent);
+		return;
+	}
+
+	lock_guard lock(s_DependencyMutex);
+	vector<ResourceID>& dependencies = s_Dependencies[dependent];
+	if (find(dependencies.begin(), dependencies.end(), dependency) != dependencies.end())
+		return;
+	dependencies.emplace_back(dependency);
+	s_Dependents[dependency].emplace_back(dependent);
+}
 
-	// Remove resource ID from pool
-	s_ResourceIDs.erase(resource);
+void Resource::RemoveDependency(ResourceID dependent, ResourceID dependency)
+{
+	lock_guard lock(s_DependencyMutex);
+	auto it = s_Dependencies.find(dependent);
+	if (it == s_Dependencies.end())
+		return;
+	RemoveValue(it->second, dependency);
+	if (it->second.empty())
+		s_Dependencies.erase(it);
 
-	// Remove from instance paths
-	for (auto it = s_InstancePaths.begin(); it != s_InstancePaths.end(); ++it)
+	auto dependentsIt = s_Dependents.find(dependency);
+	if (dependentsIt == s_Dependents.end())
+		return;
+	RemoveValue(dependentsIt->second, dependent);
+	if (dependentsIt->second.empty())
+		s_Dependents.erase(dependentsIt);
+}
+
+void Resource::SetDependencies(ResourceID dependent, const vector<ResourceID>& dependencies)
+{
+	if (dependent == InvalidResourceID)
+		return;
+
+	lock_guard lock(s_DependencyMutex);
+	// Keep file dependencies
+	auto fileIt = s_FileDependencies.find(dependent);
+	vector<string> files = fileIt == s_FileDependencies.end() ? vector<string>() : fileIt->second;
+	ClearDependencies(dependent);
+	for (const string& path : files)
 	{
-		if (it->second == resource)
+		s_FileDependencies[dependent].emplace_back(path);
+		s_FileDependents[path].emplace_back(dependent);
+	}
+
+	for (ResourceID dependency : dependencies)
+	{
+		if (dependency == InvalidResourceID || dependency == dependent)
+			continue;
+		vector<ResourceID>& current = s_Dependencies[dependent];
+		if (find(current.begin(), current.end(), dependency) != current.end())
+			continue;
+		current.emplace_back(dependency);
+		s_Dependents[dependency].emplace_back(dependent);
+	}
+}
+
+void Resource::SetFileDependencies(ResourceID dependent, const vector<string>& paths)
+{
+	if (dependent == InvalidResourceID)
+		return;
+
+	lock_guard lock(s_DependencyMutex);
+	auto fileIt = s_FileDependencies.find(dependent);
+	if (fileIt != s_FileDependencies.end())
+	{
+		for (const string& path : fileIt->second)
 		{
-			s_InstancePaths.erase(it);
-			break;
+			auto dependentsIt = s_FileDependents.find(path);
+			if (dependentsIt == s_FileDependents.end())
+				continue;
+			RemoveValue(dependentsIt->second, dependent);
+			if (dependentsIt->second.empty())
+				s_FileDependents.erase(dependentsIt);
 		}
+		s_FileDependencies.erase(fileIt);
+	}
+
+	for (const string& path : paths)
+	{
+		if (path.empty())
+			continue;
+		vector<string>& current = s_FileDependencies[dependent];
+		if (find(current.begin(), current.end(), path) != current.end())
+			continue;
+		current.emplace_back(path);
+		s_FileDependents[path].emplace_back(dependent);
 	}
 }
 
-void Resource::UnloadAll()
+vector<ResourceID> Resource::GetDependencies(ResourceID id)
 {
-	for (auto& instance : s_Instances)
-		delete instance.Data;
-	s_Instances.clear();
-	s_ResourceIDs.clear();
-	s_InstancePaths.clear();
+	lock_guard lock(s_DependencyMutex);
+	auto it = s_Dependencies.find(id);
+	return it == s_Dependencies.end() ? vector<ResourceID>() : it->second;
 }
 
-Resource::ResourceInstance* Resource::GetInstance(ResourceID id)
+vector<ResourceID> Resource::GetDependents(ResourceID id)
 {
-	return IsValidResourceID(id) ? &s_Instances[s_ResourceIDs[id]] : nullptr;
+	lock_guard lock(s_DependencyMutex);
+	auto it = s_Dependents.find(id);
+	return it == s_Dependents.end() ? vector<ResourceID>() : it->second;
 }
 
-bool Resource::Exists(string path)
+vector<ResourceID> Resource::GetReloadOrder(const vector<ResourceID>& changed)
 {
-	return s_InstancePaths.find(path) != s_InstancePaths.end();
+	lock_guard lock(s_DependencyMutex);
+
+	// Find all affected resources, in the order they were discovered
+	vector<ResourceID> affected;
+	unordered_set<ResourceID> visited;
+	for (size_t i = 0; i < changed.size(); i++)
+		if (changed[i] != InvalidResourceID && visited.emplace(changed[i]).second)
+			affected.emplace_back(changed[i]);
+	for (size_t i = 0; i < affected.size(); i++)
+	{
+		auto it = s_Dependents.find(affected[i]);
+		if (it == s_Dependents.end())
+			continue;
+		for (ResourceID dependent : it->second)
+			if (visited.emplace(dependent).second)
+				affected.emplace_back(dependent);
+	}
+
+	// Topological sort of the affected resources, only counting dependencies that are also being reloaded
+	unordered_map<ResourceID, unsigned int> remaining;
+	for (ResourceID id : affected)
+	{
+		unsigned int count = 0;
+		auto it = s_Dependencies.find(id);
+		if (it != s_Dependencies.end())
+			for (ResourceID dependency : it->second)
+				count += visited.find(dependency) != visited.end() ? 1 : 0;
+		remaining[id] = count;
+	}
+
+	vector<ResourceID> order;
+	order.reserve(affected.size());
+	queue<ResourceID> ready;
+	for (ResourceID id : affected)
+		if (remaining[id] == 0)
+			ready.push(id);
+	while (!ready.empty())
+	{
+		ResourceID id = ready.front();
+		ready.pop();
+		order.emplace_back(id);
+
+		auto it = s_Dependents.find(id);
+		if (it == s_Dependents.end())
+			continue;
+		for (ResourceID dependent : it->second)
+			if (--remaining[dependent] == 0)
+				ready.push(dependent);
+	}
+
+	if (order.size() != affected.size())
+	{
+		spdlog::warn("Resource dependency cycle found, {} resource(s) reloaded in no particular order", affected.size() - order.size());
+		for (ResourceID id : affected)
+			if (remaining[id] > 0)
+				order.emplace_back(id);
+	}
+	return order;
 }
 
-bool Resource::IsValidResourceID(ResourceID id)
+void Resource::Invalidate(ResourceID id)
 {
-	return id != InvalidResourceID &&
-		s_ResourceIDs.find(id) != s_ResourceIDs.end();
+	if (id == InvalidResourceID)
+		return;
+	lock_guard lock(s_DependencyMutex);
+	s_Invalidated.emplace_back(id);
 }
 
-void Resource::PrintResourceTypes()
+void Resource::Invalidate(string path)
 {
-	spdlog::trace("Printing resources:");
-	for (auto& pair : s_InstancePaths)
+	ResourceID id = GetID(path);
+
+	lock_guard lock(s_DependencyMutex);
+	if (id != InvalidResourceID)
+		s_Invalidated.emplace_back(id);
+
+	auto it = s_FileDependents.find(path);
+	if (it != s_FileDependents.end())
+		s_Invalidated.insert(s_Invalidated.end(), it->second.begin(), it->second.end());
+}
+
+void Resource::SetDefaultReloader(ResourceReloader reloader)
+{
+	lock_guard lock(s_DependencyMutex);
+	s_DefaultReloader = reloader;
+}
+
+vector<ResourceReload> Resource::ProcessReloads()
+{
+	vector<ResourceID> invalidated;
 	{
-		ResourceInstance* instance = GetInstance(pair.second);
-		spdlog::trace(" [{}->{}][{}] \t{}", pair.second, s_ResourceIDs[pair.second], instance->Type.name(), pair.first);
+		lock_guard lock(s_DependencyMutex);
+		if (s_Invalidated.empty())
+			return {};
+		invalidated.swap(s_Invalidated);
 	}
+	return Reload(invalidated);
 }
 
-type_index Resource::GetType(ResourceID id)
+vector<ResourceReload> Resource::Reload(ResourceID id) { return Reload(vector<ResourceID> { id }); }
+
+vector<ResourceReload> Resource::Reload(const vector<ResourceID>& changed)
 {
-	ResourceInstance* instance = GetInstance(id);
-	return instance ? instance->Type : typeid(void);
+	vector<ResourceID> order = GetReloadOrder(changed);
+	unordered_set<ResourceID> sourceChanged(changed.begin(), changed.end());
+
+	vector<ResourceReload> reloads;
+	reloads.reserve(order.size());
+	for (ResourceID id : order)
+	{
+		ResourceReload reload;
+		reload.ID = id;
+		reload.Path = GetPath(id);
+		reload.SourceChanged = sourceChanged.find(id) != sourceChanged.end();
+
+		type_index type = GetType(id);
+		ResourceReloader reloader;
+		{
+			lock_guard lock(s_DependencyMutex);
+			auto it = s_Reloaders.find(type);
+			reloader = it != s_Reloaders.end() ? it->second : s_DefaultReloader;
+		}
+
+		// Reloaders can load or invalidate other resources, so are called without holding any lock
+		void* data = Get(id);
+		auto start = chrono::high_resolution_clock::now();
+		if (reloader && (data || type == typeid(void)))
+			reload.Reloaded = reloader(id, data, reload.SourceChanged);
+		reload.Milliseconds = chrono::duration<float, milli>(chrono::high_resolution_clock::now() - start).count();
+
+		if (reload.Reloaded)
+			spdlog::debug("Reloaded '{}' [{}] in {:.2f}ms", reload.Path, id, reload.Milliseconds);
+		reloads.emplace_back(reload);
+	}
+
+	if (!reloads.empty())
+	{
+		float total = 0.0f;
+		for (ResourceReload& reload : reloads)
+			total += reload.Milliseconds;
+		spdlog::debug("Reloaded {} resource(s) in {:.2f}ms", reloads.size(), total);
+	}
+	return reloads;
 }
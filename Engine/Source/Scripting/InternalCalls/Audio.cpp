@@ -17,4 +17,63 @@ ADD_MANAGED_METHOD(Audio, SetOutputDevice, void, (unsigned int index))
 { AudioSystem::SetOutputDevice(index); }
 
 ADD_MANAGED_METHOD(Audio, GetOutputDevice, unsigned int)
-{ return AudioSystem::GetOutputDevice(); }
\ No newline at end of file
+{ return AudioSystem::GetOutputDevice(); }
+
+ADD_MANAGED_METHOD(Audio, GetMaxVoices, unsigned int)
+{ return AudioSystem::GetVoiceManager().GetMaxRealVoices(); }
+
+ADD_MANAGED_METHOD(Audio, SetMaxVoices, void, (unsigned int count))
+{ AudioSystem::GetVoiceManager().SetMaxRealVoices(count); }
+
+ADD_MANAGED_METHOD(Audio, GetRealVoiceCount, unsigned int)
+{ return AudioSystem::GetVoiceManager().GetRealCount(); }
+
+ADD_MANAGED_METHOD(Audio, GetVirtualVoiceCount, unsigned int)
+{ return AudioSystem::GetVoiceManager().GetVirtualCount(); }
+
+ADD_MANAGED_METHOD(Audio, GetCulledSourceCount, unsigned int)
+{ return AudioSystem::GetCulledCount(); }
+
+ADD_MANAGED_METHOD(Audio, GetCullingCellSize, float)
+{ return AudioSystem::GetCullingGrid().GetCellSize(); }
+
+ADD_MANAGED_METHOD(Audio, SetCullingCellSize, void, (float size))
+{ AudioSystem::GetCullingGrid().SetCellSize(size); }
+
+ADD_MANAGED_METHOD(Audio, GetDecodeCacheBudget, uint64_t)
+{ return AudioSystem::GetDecodeCache().GetBudget(); }
+
+ADD_MANAGED_METHOD(Audio, SetDecodeCacheBudget, void, (uint64_t bytes))
+{ AudioSystem::GetDecodeCache().SetBudget((size_t)bytes); }
+
+ADD_MANAGED_METHOD(Audio, GetDecodeCacheMaxClipLength, float)
+{ return AudioSystem::GetDecodeCache().GetMaxClipLength(); }
+
+ADD_MANAGED_METHOD(Audio, SetDecodeCacheMaxClipLength, void, (float seconds))
+{ AudioSystem::GetDecodeCache().SetMaxClipLength(seconds); }
+
+ADD_MANAGED_METHOD(Audio, GetDecodeCacheMemoryUsage, uint64_t)
+{ return AudioSystem::GetDecodeCache().GetMemoryUsage(); }
+
+ADD_MANAGED_METHOD(Audio, GetDecodeCacheHits, unsigned int)
+{ return AudioSystem::GetDecodeCache().GetHits(); }
+
+ADD_MANAGED_METHOD(Audio, GetDecodeCacheMisses, unsigned int)
+{ return AudioSystem::GetDecodeCache().GetMisses(); }
+
+ADD_MANAGED_METHOD(Audio, GetDecodeCacheEvictions, unsigned int)
+{ return AudioSystem::GetDecodeCache().GetEvictions(); }
+
+ADD_MANAGED_METHOD(Audio, ResetDecodeCacheStats, void)
+{ AudioSystem::GetDecodeCache().ResetStats(); }
+
+ADD_MANAGED_METHOD(Audio, IsOffline, bool)
+{ return AudioSystem::IsOffline(); }
+
+ADD_MANAGED_METHOD(Audio, RenderToFile, bool, (MonoString* pathRaw, float seconds))
+{
+	char* path = mono_string_to_utf8(pathRaw);
+	bool success = AudioSystem::RenderToFile(path, (ma_uint64)(seconds * AudioSystem::GetSampleRate()));
+	mono_free(path);
+	return success;
+}
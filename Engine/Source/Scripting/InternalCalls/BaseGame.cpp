@@ -8,11 +8,8 @@ using namespace Yonai::Scripting;
 
 ADD_MANAGED_METHOD(BaseGameLauncher, LoadAssembly, bool, (MonoArray* dataRaw, MonoString* friendlyNameRaw))
 {
-	// Get data
-	vector<unsigned char> data;
-	data.resize(mono_array_length(dataRaw));
-	for (size_t i = 0; i < data.size(); i++)
-		data[i] = mono_array_get(dataRaw, unsigned char, i);
+	// Get data, mono copies the image so the managed array is used directly
+	Yonai::IO::ByteSpan data(mono_array_addr(dataRaw, unsigned char, 0), mono_array_length(dataRaw));
 
 	// Get friendly name
 	char* friendlyName = mono_string_to_utf8(friendlyNameRaw);
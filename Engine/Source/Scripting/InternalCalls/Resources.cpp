@@ -29,4 +29,29 @@ ADD_MANAGED_METHOD(Resource, Exists, bool, (uint64_t resourceID))
 { return Resource::IsValidResourceID(resourceID); }
 
 ADD_MANAGED_METHOD(Resource, Print)
-{ Resource::PrintResourceTypes(); }
\ No newline at end of file
+{ Resource::PrintResourceTypes(); }
+
+ADD_MANAGED_METHOD(Resource, Invalidate, void, (uint64_t resourceID))
+{ Resource::Invalidate(resourceID); }
+
+ADD_MANAGED_METHOD(Resource, InvalidatePath, void, (MonoString* pathRaw))
+{
+	char* path = mono_string_to_utf8(pathRaw);
+	Resource::Invalidate(string(path));
+	mono_free(path);
+}
+
+ADD_MANAGED_METHOD(Resource, AddDependency, void, (uint64_t dependent, uint64_t dependency))
+{ Resource::AddDependency(dependent, dependency); }
+
+ADD_MANAGED_METHOD(Resource, RemoveDependency, void, (uint64_t dependent, uint64_t dependency))
+{ Resource::RemoveDependency(dependent, dependency); }
+
+ADD_MANAGED_METHOD(Resource, GetDependents, MonoArray*, (uint64_t resourceID))
+{
+	vector<ResourceID> dependents = Resource::GetDependents(resourceID);
+	MonoArray* output = mono_array_new(mono_domain_get(), mono_get_uint64_class(), dependents.size());
+	for (size_t i = 0; i < dependents.size(); i++)
+		mono_array_set(output, uint64_t, i, (uint64_t)dependents[i]);
+	return output;
+}
@@ -4,6 +4,7 @@
 #include <Yonai/Utils.hpp>
 #include <mono/metadata/threads.h>
 #include <Yonai/IO/Files.hpp>
+#include <Yonai/IO/MappedFile.hpp>
 #include <mono/metadata/assembly.h>
 #include <mono/metadata/mono-debug.h>
 #include <Yonai/Application.hpp>
@@ -71,12 +72,38 @@ bool TryLoadDebugSymbols(MonoImage* image, fs::path& path)
 	if (!fs::exists(path.string()))
 		return false;
 
-	auto pdbContents = IO::Read(path.string());
-	mono_debug_open_image_from_memory(image, (const mono_byte*)pdbContents.data(), (int)pdbContents.size());
+	IO::MappedFile pdbContents(path.string());
+	mono_debug_open_image_from_memory(image, (const mono_byte*)pdbContents.GetData(), (int)pdbContents.GetSize());
 	spdlog::trace("Added debug symbols found at '{}'", path.string().c_str());
 	return true;
 }
 
+typedef bool (*ReloadManagedResourceFn)(uint64_t, bool, MonoException**);
+
+/// <summary>
+/// Reloads resources without a native reloader via Resource._Reload, including resources only known to scripts
+/// </summary>
+bool ReloadManagedResource(ResourceID id, void*, bool sourceChanged)
+{
+	if (!ScriptEngine::IsLoaded() || !ScriptEngine::GetCoreAssembly())
+		return false;
+
+	// Method is found on each call, as it changes when the script engine reloads
+	MonoClass* klass = ScriptEngine::GetCoreAssembly()->GetClassFromName("Yonai", "Resource");
+	MonoMethod* method = klass ? mono_class_get_method_from_name(klass, "_Reload", 2) : nullptr;
+	if (!method)
+		return false;
+
+	MonoException* exception = nullptr;
+	bool reloaded = ((ReloadManagedResourceFn)mono_method_get_unmanaged_thunk(method))(id, sourceChanged, &exception);
+	if (exception)
+	{
+		mono_print_unhandled_exception((MonoObject*)exception);
+		return false;
+	}
+	return reloaded;
+}
+
 void ScriptEngine::Init(std::string assembliesPath, bool allowDebugging)
 {
 	s_CoreDLLPath = assembliesPath + "/" + ScriptCoreFilename;
@@ -126,6 +153,8 @@ void ScriptEngine::Init(std::string assembliesPath, bool allowDebugging)
 
 	// Add YonaiScriptCore internal methods
 	AddInternalCalls(_InternalMethods);
+
+	Resource::SetDefaultReloader(ReloadManagedResource);
 }
 
 void ScriptEngine::Destroy()
@@ -137,6 +166,7 @@ void ScriptEngine::Destroy()
 		delete watcher;
 	s_FileWatchers.clear();
 
+	Resource::SetDefaultReloader(nullptr);
 	mono_jit_cleanup(s_RootDomain);
 
 	s_AppDomain = nullptr;
@@ -158,8 +188,9 @@ Assembly* ScriptEngine::LoadAssembly(string& path, bool isCoreAssembly, bool sho
 	}
 
 	spdlog::debug("Loading C# script from '{}'", path);
-	auto data = IO::Read(path);
-	if (data.empty())
+	// Mono copies the image, so the file is only mapped while loading
+	IO::MappedFile data(path);
+	if (data.GetSize() == 0)
 	{
 		spdlog::warn("Failed to load '{}' - failed to read", path);
 		return nullptr;
@@ -180,8 +211,8 @@ Assembly* ScriptEngine::LoadAssembly(string& path, bool isCoreAssembly, bool sho
 
 	MonoImageOpenStatus status;
 	MonoImage* image = mono_image_open_from_data_full(
-		reinterpret_cast<char*>(data.data()),
-		(uint32_t)data.size(),
+		(char*)data.GetData(),
+		(uint32_t)data.GetSize(),
 		1, 	// Bool. Copy data to internal mono buffer
 		&status,
 		0	// Bool. Load in reflection mode
@@ -223,14 +254,14 @@ Assembly* ScriptEngine::LoadAssembly(string& path, bool isCoreAssembly, bool sho
 	return instance;
 }
 
-Assembly* ScriptEngine::LoadAssembly(vector<unsigned char>& data, const char* friendlyName)
+Assembly* ScriptEngine::LoadAssembly(IO::ByteSpan data, const char* friendlyName)
 {
 	if (data.empty())
 		return nullptr;
 
 	MonoImageOpenStatus status;
 	MonoImage* image = mono_image_open_from_data_full(
-		reinterpret_cast<char*>(data.data()),
+		(char*)data.data(),
 		(uint32_t)data.size(),
 		1, 	// Bool. Copy data to internal mono buffer
 		&status,
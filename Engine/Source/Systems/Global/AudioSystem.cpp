@@ -4,7 +4,10 @@ using namespace Yonai::Systems;
 
 #define MINIAUDIO_IMPLEMENTATION
 #include <miniaudio.h>
+#include <cfloat>
 #include <spdlog/spdlog.h>
+#include <glm/glm.hpp>
+#include <Yonai/Application.hpp>
 #include <Yonai/Scripting/Class.hpp>
 #include <Yonai/Components/Transform.hpp>
 #include <Yonai/Components/AudioSource.hpp>
@@ -32,10 +35,30 @@ ma_device_info* AudioSystem::s_PlaybackDeviceInfos = nullptr;
 
 // Resource Manager //
 ma_resource_manager AudioSystem::s_ResourceManager = {};
+bool AudioSystem::s_ResourceManagerReady = false;
+AudioDecodeCache AudioSystem::s_DecodeCache;
 
 // Engine //
 ma_engine AudioSystem::s_Engine = {};
 
+AudioCommandQueue AudioSystem::s_Commands;
+
+bool AudioSystem::s_Offline = false;
+AudioRenderer AudioSystem::s_Renderer(&AudioSystem::s_Engine, &AudioSystem::s_Commands);
+
+// Voices //
+VoiceManager AudioSystem::s_VoiceManager;
+vector<AudioVoice> AudioSystem::s_Voices;
+vector<AudioSource*> AudioSystem::s_VoiceSources;
+vector<glm::vec3> AudioSystem::s_ListenerPositions;
+
+// Culling //
+AudioCullingGrid AudioSystem::s_CullingGrid;
+unsigned int AudioSystem::s_CullingQuery = 0;
+unsigned int AudioSystem::s_CulledCount = 0;
+vector<AudioSource*> AudioSystem::s_PlayingSources;
+vector<const void*> AudioSystem::s_InRangeSources;
+
 // Set large value by default because we compare this in SetOutputDevice, if they're both '0' then no output device is set
 ma_uint32 AudioSystem::s_CurrentDevice = 99999;
 
@@ -58,6 +81,15 @@ void AudioSystem::Init()
 
 	RefreshDevices();
 
+	// Headless machines, such as build servers, mix without a device
+	if (s_PlaybackDeviceCount == 0 || Application::Current()->HasArg("OfflineAudio"))
+	{
+		if (s_PlaybackDeviceCount == 0)
+			spdlog::warn("No audio playback devices found, mixing offline");
+		SetOffline();
+		return;
+	}
+
 	// Initialise engine using default device
 	SetOutputDevice(s_DefaultDeviceIndex);
 }
@@ -78,30 +110,66 @@ void AudioSystem::Destroy()
 {
 	ScriptSystem::Destroy();
 
-	// Check if device is initialised
-	if (!s_Device.type)
+	// Check if engine is initialised
+	if (!s_Device.type && !s_Offline)
 		return;
 
 	spdlog::debug("AudioData engine shutting down");
 
-	ma_engine_uninit(&s_Engine);
-	ma_device_uninit(&s_Device);
+	ReleaseEngine();
 	ma_context_uninit(&s_Context);
 
 	delete s_ScriptClass;
 }
 
-void AudioSystem::Update()
+/// <returns>Volume of a source heard at the closest listener</returns>
+static float GetAudibility(AudioSource* source, const glm::vec3& position, const vector<glm::vec3>& listeners)
 {
-	static SceneSystem* sceneSystem = nullptr;
+	if (!source->Get3D())
+		return source->GetVolume();
 
-	if (!sceneSystem)
-		sceneSystem = SystemManager::Global()->Get<SceneSystem>();
+	float closest = FLT_MAX;
+	for (const glm::vec3& listener : listeners)
+		closest = (std::min)(closest, glm::distance(position, listener));
+
+	glm::vec2 range = source->GetRolloffDistance();
+	glm::vec2 gain = source->GetRolloffGain();
+	return source->GetVolume() * VoiceManager::GetAttenuation(
+		source->GetAttenuationModel(), closest, range.x, range.y, source->GetAttenuationRolloff(), gain.x, gain.y);
+}
 
+void AudioSystem::Update()
+{
 	int listenerIndex = 0;
+	const vector<World*>& scenes = SceneSystem::GetActiveScenes();
+
+	// Audio Listener, gathered first to find how audible each source is
+	s_ListenerPositions.clear();
+	for (World* scene : scenes)
+	{
+		vector<AudioListener*> listeners = scene->GetComponents<AudioListener>();
+		for (AudioListener* listener : listeners)
+		{
+			Transform* transform = listener->Entity.GetComponent<Transform>();
+			if (!transform)
+				continue;
+
+			glm::vec3 pos = transform->GetGlobalPosition();
+			glm::vec3 forward = transform->GlobalForward();
+			ma_engine_listener_set_position(&s_Engine, listenerIndex, pos.x, pos.y, pos.z);
+			ma_engine_listener_set_direction(&s_Engine, listenerIndex, forward.x, forward.y, forward.z);
+			s_ListenerPositions.emplace_back(pos);
+
+			listenerIndex++;
+		}
+	}
+
+	// Default listener is at the origin
+	if (s_ListenerPositions.empty())
+		s_ListenerPositions.emplace_back(0.0f);
 
 	// Audio Source
-	vector<World*> scenes = sceneSystem->GetActiveScenes();
+	s_PlayingSources.clear();
 	for (World* scene : scenes)
 	{
 		vector<AudioSource*> sources = scene->GetComponents<AudioSource>();
@@ -112,30 +180,91 @@ void AudioSystem::Update()
 				source->GetPlayTime() >= source->GetLength())
 				source->Stop();
 
+			// Position is only read, and sent to the audio thread, after the transform or rolloff changes
 			Transform* transform = source->Entity.GetComponent<Transform>();
-			if (!transform)
-				continue;
-
-			glm::vec3 pos = transform->GetGlobalPosition();
-			ma_sound_set_position(&source->m_Data, pos.x, pos.y, pos.z);
+			uint64_t transformChange = transform ? transform->GetLastChange() : 0;
+			float cullRadius = source->GetCullRadius();
+			if (!source->m_CullingTracked ||
+				source->m_TransformChange != transformChange ||
+				source->m_CullRadius != cullRadius)
+			{
+				bool moved = !source->m_CullingTracked || source->m_TransformChange != transformChange;
+				source->m_Position = transform ? transform->GetGlobalPosition() : glm::vec3(0.0f);
+				source->m_TransformChange = transformChange;
+				source->m_CullRadius = cullRadius;
+				source->m_CullingTracked = true;
+				s_CullingGrid.Update(source, source->m_Position, cullRadius);
+
+				// Virtual sources are not mixed, so are left untouched until they become real
+				if (moved && transform && !source->m_Virtual)
+				{
+					const glm::vec3& pos = source->m_Position;
+					source->Submit(AudioCommandType::SetPosition, pos.x, pos.y, pos.z);
+				}
+			}
+
+			if (source->IsPlaying())
+				s_PlayingSources.emplace_back(source);
 		}
+	}
 
-		vector<AudioListener*> listeners = scene->GetComponents<AudioListener>();
-		for (AudioListener* listener : listeners)
+	// Sources out of range of every listener are culled, marking those found in range with this query
+	s_CullingGrid.Query(s_ListenerPositions, s_InRangeSources);
+	if (++s_CullingQuery == 0)
+		s_CullingQuery = 1;
+	for (const void* key : s_InRangeSources)
+		((AudioSource*)key)->m_InRangeQuery = s_CullingQuery;
+
+	s_Voices.clear();
+	s_VoiceSources.clear();
+	s_CulledCount = 0;
+	for (AudioSource* source : s_PlayingSources)
+	{
+		source->m_Culled = source->m_InRangeQuery != s_CullingQuery;
+		if (source->m_Culled)
 		{
-			Transform* transform = listener->Entity.GetComponent<Transform>();
-			if (!transform)
-				continue;
+			// Play time continues to advance, ready to resume when back in range
+			source->MakeVirtual();
+			s_CulledCount++;
+			continue;
+		}
 
-			glm::vec3 pos = transform->GetGlobalPosition();
-			glm::vec3 forward = transform->GlobalForward();
-			ma_engine_listener_set_position(&s_Engine, listenerIndex, pos.x, pos.y, pos.z);
-			ma_engine_listener_set_direction(&s_Engine, listenerIndex, forward.x, forward.y, forward.z);
+		AudioVoice voice;
+		voice.Priority = source->m_Priority;
+		voice.Audibility = GetAudibility(source, source->m_Position, s_ListenerPositions);
+		voice.Real = !source->m_Virtual;
+		s_Voices.emplace_back(voice);
+		s_VoiceSources.emplace_back(source);
+	}
 
-			listenerIndex++;
+	s_VoiceManager.Assign(s_Voices);
+	for (size_t i = 0; i < s_Voices.size(); i++)
+	{
+		AudioSource* source = s_VoiceSources[i];
+		if (s_Voices[i].ShouldBeReal == s_Voices[i].Real)
+			continue;
+
+		if (!s_Voices[i].ShouldBeReal)
+		{
+			source->MakeVirtual();
+			continue;
+		}
+
+		// Position may have changed while virtual
+		if (source->Entity.GetComponent<Transform>())
+		{
+			const glm::vec3& pos = source->m_Position;
+			source->Submit(AudioCommandType::SetPosition, pos.x, pos.y, pos.z);
 		}
+		source->MakeReal();
 	}
 
+	// Changes made this frame are applied together, at the start of the next buffer mixed.
+	// Without a running device there is no audio thread to apply them.
+	s_Commands.Flush();
+	if (!ma_device_is_started(&s_Device))
+		s_Commands.Synchronise();
+
 	ScriptSystem::Update();
 }
 
@@ -170,6 +299,7 @@ void AudioSystem::RefreshDevices()
 void AudioSystem::AudioDataCallback(ma_device* pDevice, void* pOutput, const void* pInput, ma_uint32 frameCount)
 {
 	(void)pInput;
+	s_Commands.Apply();
 	ma_engine_read_pcm_frames(&s_Engine, pOutput, frameCount, nullptr);
 }
 
@@ -184,13 +314,14 @@ void AudioSystem::SetOutputDevice(unsigned int deviceIndex)
 	if (deviceIndex == s_CurrentDevice)
 		return; // No change
 
-	// Check if device has been initialised
-	if (s_Device.type)
+	if (deviceIndex >= s_PlaybackDeviceCount)
 	{
-		ma_engine_uninit(&s_Engine);
-		ma_device_uninit(&s_Device);
+		spdlog::error("Failed to set output device, no playback device at index {}", deviceIndex);
+		return;
 	}
 
+	ReleaseEngine();
+
 	// Get device info
 	ma_device_info deviceInfo = s_PlaybackDeviceInfos[deviceIndex];
 	
@@ -218,12 +349,106 @@ void AudioSystem::SetOutputDevice(unsigned int deviceIndex)
 
 void AudioSystem::SetupEngine()
 {
+	if (!s_ResourceManagerReady)
+		SetupResourceManager();
+
 	ma_engine_config config = ma_engine_config_init();
 	config.pDevice = &s_Device;
-	config.pResourceManager = &s_ResourceManager;
+	config.pResourceManager = s_ResourceManagerReady ? &s_ResourceManager : nullptr;
 	ma_engine_init(&config, &s_Engine);
 }
 
+bool AudioSystem::SetNullDevice(unsigned int channels, unsigned int sampleRate)
+{
+	ReleaseEngine();
+
+	ma_device_config deviceConfig = ma_device_config_init(ma_device_type_playback);
+	deviceConfig.playback.format = ma_format_f32;
+	deviceConfig.playback.channels = channels;
+	deviceConfig.sampleRate = sampleRate;
+	deviceConfig.dataCallback = AudioDataCallback;
+
+	// Device owns a context limited to the null backend, released with the device
+	ma_backend backend = ma_backend_null;
+	ma_result result = ma_device_init_ex(&backend, 1, nullptr, &deviceConfig, &s_Device);
+	if (result != MA_SUCCESS)
+	{
+		spdlog::error("Failed to initialise null output device [{}]", (int)result);
+		s_Device = {};
+		return false;
+	}
+
+	SetupEngine();
+
+	s_CurrentDevice = 99999;
+	spdlog::debug("Mixing audio to a null device, {} channels at {}Hz", channels, sampleRate);
+	return true;
+}
+
+void AudioSystem::ReleaseEngine()
+{
+	// Sources are mixed by the engine, apply their pending changes first
+	s_Commands.Synchronise();
+
+	if (s_Device.type)
+	{
+		ma_engine_uninit(&s_Engine);
+		ma_device_uninit(&s_Device);
+		s_Device = {};
+	}
+	else if (s_Offline)
+		ma_engine_uninit(&s_Engine);
+
+	s_Offline = false;
+}
+
+bool AudioSystem::SetOffline(unsigned int channels, unsigned int sampleRate)
+{
+	ReleaseEngine();
+
+	if (!s_ResourceManagerReady)
+		SetupResourceManager();
+
+	ma_engine_config config = ma_engine_config_init();
+	config.noDevice = MA_TRUE;
+	config.channels = channels;
+	config.sampleRate = sampleRate;
+	config.pResourceManager = s_ResourceManagerReady ? &s_ResourceManager : nullptr;
+
+	ma_result result = ma_engine_init(&config, &s_Engine);
+	if (result != MA_SUCCESS)
+	{
+		spdlog::error("Failed to initialise offline audio engine [{}]", (int)result);
+		return false;
+	}
+
+	s_Offline = true;
+	s_CurrentDevice = 99999;
+	s_Renderer.ResetStats();
+	spdlog::debug("Mixing audio offline, {} channels at {}Hz", channels, sampleRate);
+	return true;
+}
+
+ma_uint64 AudioSystem::Render(vector<float>& output, ma_uint64 frameCount)
+{
+	if (!s_Offline)
+	{
+		spdlog::warn("Cannot render audio while using an output device");
+		return 0;
+	}
+	return s_Renderer.Render(output, frameCount);
+}
+
+bool AudioSystem::RenderToFile(const string& path, ma_uint64 frameCount)
+{
+	if (!s_Offline)
+	{
+		spdlog::warn("Cannot render audio while using an output device");
+		return false;
+	}
+	return s_Renderer.RenderToFile(path, frameCount);
+}
+
 void AudioSystem::GetScriptClass()
 {
 	if(s_ScriptClass)
@@ -251,13 +476,21 @@ void AudioSystem::SetupResourceManager()
 	ma_result result = ma_resource_manager_init(&config, &s_ResourceManager);
 	if(result != MA_SUCCESS)
 		spdlog::error("Failed to initialise audio resource manager [{}]", (int)result);
+	s_ResourceManagerReady = result == MA_SUCCESS;
 }
 
-unsigned int AudioSystem::GetSampleRate() { return s_Device.sampleRate; }
+unsigned int AudioSystem::GetSampleRate() { return s_Offline ? ma_engine_get_sample_rate(&s_Engine) : s_Device.sampleRate; }
 unsigned int AudioSystem::GetOutputDevice() { return s_CurrentDevice; }
 unsigned int AudioSystem::GetDeviceCount() { return s_PlaybackDeviceCount; }
 unsigned int AudioSystem::GetDefaultDevice() { return s_DefaultDeviceIndex; }
 ma_engine* AudioSystem::GetEngine() { return &s_Engine; }
+VoiceManager& AudioSystem::GetVoiceManager() { return s_VoiceManager; }
+AudioCullingGrid& AudioSystem::GetCullingGrid() { return s_CullingGrid; }
+AudioDecodeCache& AudioSystem::GetDecodeCache() { return s_DecodeCache; }
+unsigned int AudioSystem::GetCulledCount() { return s_CulledCount; }
+bool AudioSystem::IsOffline() { return s_Offline; }
+AudioCommandQueue& AudioSystem::GetCommands() { return s_Commands; }
+AudioRenderer& AudioSystem::GetRenderer() { return s_Renderer; }
 const char* AudioSystem::GetDeviceName(unsigned int index)
 {
 	if(s_PlaybackDeviceCount == 0)
@@ -5,6 +5,7 @@
 #include <glm/gtx/quaternion.hpp>
 #include <Yonai/Resource.hpp>
 #include <Yonai/Graphics/Texture.hpp>
+#include <Yonai/Graphics/TextureLoader.hpp>
 #include <Yonai/Graphics/Material.hpp>
 #include <Yonai/Graphics/Pipelines/Forward.hpp>
 #include <Yonai/Systems/Global/SceneSystem.hpp>
@@ -30,6 +31,9 @@ void RenderSystem::OnEnabled()
 	m_SceneSystem = SystemManager::Global()->Get<SceneSystem>();
 }
 
+void RenderSystem::Update() { TextureLoader::ProcessUploads(); }
+void RenderSystem::Destroy() { TextureLoader::Shutdown(); }
+
 RenderPipeline* RenderSystem::GetPipeline()
 {
 	if (!m_Pipeline)
@@ -0,0 +1,118 @@
+#include <atomic>
+#include <memory>
+#include <algorithm>
+#include <Yonai/ThreadPool.hpp>
+
+using namespace std;
+using namespace Yonai;
+
+ThreadPool::ThreadPool(unsigned int threadCount) : m_Running(true), m_ActiveJobs(0)
+{
+	if (threadCount == 0)
+		threadCount = std::max(thread::hardware_concurrency(), 2u) - 1;
+
+	m_Threads.reserve(threadCount);
+	for (unsigned int i = 0; i < threadCount; i++)
+		m_Threads.emplace_back(&ThreadPool::WorkerLoop, this);
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		lock_guard lock(m_Mutex);
+		m_Running = false;
+	}
+	m_JobAvailable.notify_all();
+
+	for (thread& worker : m_Threads)
+		worker.join();
+}
+
+void ThreadPool::Enqueue(ThreadPoolJob job)
+{
+	{
+		lock_guard lock(m_Mutex);
+		m_Jobs.emplace(std::move(job));
+	}
+	m_JobAvailable.notify_one();
+}
+
+void ThreadPool::Wait()
+{
+	unique_lock lock(m_Mutex);
+	m_JobsFinished.wait(lock, [this]() { return m_Jobs.empty() && m_ActiveJobs == 0; });
+}
+
+void ThreadPool::ParallelFor(size_t count, const function<void(size_t)>& job)
+{
+	if (count == 0)
+		return;
+
+	// Shared with workers, which may only start after all indices have been claimed and this has returned
+	struct ParallelForState
+	{
+		atomic<size_t> Next = 0;
+		size_t Completed = 0;
+		function<void(size_t)> Job;
+
+		mutex Mutex;
+		condition_variable Finished;
+	};
+	shared_ptr<ParallelForState> state = make_shared<ParallelForState>();
+	state->Job = job;
+
+	auto run = [state, count]()
+	{
+		size_t processed = 0;
+		for (size_t i = state->Next++; i < count; i = state->Next++, processed++)
+			state->Job(i);
+
+		if (processed == 0)
+			return;
+
+		lock_guard lock(state->Mutex);
+		state->Completed += processed;
+		if (state->Completed == count)
+			state->Finished.notify_all();
+	};
+
+	size_t helpers = std::min<size_t>(m_Threads.size(), count - 1);
+	for (size_t i = 0; i < helpers; i++)
+		Enqueue(run);
+
+	// Calling thread also processes indices, so this cannot deadlock when called from a job
+	run();
+
+	unique_lock lock(state->Mutex);
+	state->Finished.wait(lock, [&]() { return state->Completed == count; });
+}
+
+unsigned int ThreadPool::GetThreadCount() { return (unsigned int)m_Threads.size(); }
+
+void ThreadPool::WorkerLoop()
+{
+	while (true)
+	{
+		ThreadPoolJob job;
+		{
+			unique_lock lock(m_Mutex);
+			m_JobAvailable.wait(lock, [this]() { return !m_Running || !m_Jobs.empty(); });
+
+			// Remaining jobs are finished before shutting down
+			if (m_Jobs.empty())
+				return;
+
+			job = std::move(m_Jobs.front());
+			m_Jobs.pop();
+			m_ActiveJobs++;
+		}
+
+		job();
+
+		{
+			lock_guard lock(m_Mutex);
+			m_ActiveJobs--;
+		}
+		m_JobsFinished.notify_all();
+	}
+}
@@ -1,3 +1,4 @@
+#include <mutex>
 #include <random>
 #include <unordered_map>
 #include <Yonai/UUID.hpp>
@@ -6,11 +7,22 @@ using namespace std;
 using namespace Yonai;
 
 static random_device s_RandomDevice;
-static mt19937_64 s_Engine(s_RandomDevice());
-static uniform_int_distribution<uint64_t> s_UniformDistribution;
+static mutex s_RandomDeviceMutex;
+
+static uint64_t GenerateUUID()
+{
+	// Each thread has its own engine, as resources are created from worker threads
+	thread_local mt19937_64 engine = []()
+	{
+		lock_guard lock(s_RandomDeviceMutex);
+		return mt19937_64(s_RandomDevice());
+	}();
+	thread_local uniform_int_distribution<uint64_t> distribution;
+	return distribution(engine);
+}
 
 // Generate UUID
-UUID::UUID() : m_UUID(s_UniformDistribution(s_Engine)) { }
+UUID::UUID() : m_UUID(GenerateUUID()) { }
 
 // Set UUID
 UUID::UUID(uint64_t uuid) : m_UUID(uuid) { }
\ No newline at end of file
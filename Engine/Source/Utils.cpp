@@ -12,3 +12,19 @@ string& Yonai::ToLower(string& input)
 	transform(input.begin(), input.end(), input.begin(), ::tolower);
 	return input;
 }
+
+uint64_t Yonai::Hash(const void* data, size_t size, uint64_t seed)
+{
+	const uint64_t Prime = 0x100000001b3ull;
+
+	uint64_t hash = seed;
+	const unsigned char* bytes = (const unsigned char*)data;
+	for (size_t i = 0; i < size; i++)
+	{
+		hash ^= bytes[i];
+		hash *= Prime;
+	}
+	return hash;
+}
+
+uint64_t Yonai::Hash(const string& input, uint64_t seed) { return Hash(input.data(), input.size(), seed); }
@@ -0,0 +1,250 @@
+#include <cmath>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <functional>
+#include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
+#include <Yonai/Audio/AudioCommandQueue.hpp>
+#include <Yonai/Systems/Global/AudioSystem.hpp>
+
+using namespace std;
+using namespace Yonai;
+using namespace Yonai::Systems;
+
+/// <summary>
+/// Commands applied by RecordCommand, in order
+/// </summary>
+static vector<AudioCommand> s_Recorded;
+
+static void RecordCommand(const AudioCommand& command) { s_Recorded.emplace_back(command); }
+
+static AudioCommand MakeCommand(AudioCommandType type, float value = 0.0f, ma_uint64 frame = 0)
+{
+	AudioCommand command;
+	command.Type = type;
+	command.Values[0] = value;
+	command.Frame = frame;
+	return command;
+}
+
+class AudioCommandQueueTest : public ::testing::Test
+{
+protected:
+	void SetUp() override { s_Recorded.clear(); }
+};
+
+TEST_F(AudioCommandQueueTest, AppliedInOrder)
+{
+	AudioCommandQueue queue(RecordCommand, 16);
+	queue.Push(MakeCommand(AudioCommandType::SetVolume, 0.5f));
+	queue.Push(MakeCommand(AudioCommandType::Seek, 0.0f, 1234));
+	queue.Push(MakeCommand(AudioCommandType::Start));
+	queue.Flush();
+
+	EXPECT_EQ(queue.Apply(), 3u);
+	ASSERT_EQ(s_Recorded.size(), 3u);
+	EXPECT_EQ(s_Recorded[0].Type, AudioCommandType::SetVolume);
+	EXPECT_EQ(s_Recorded[0].Values[0], 0.5f);
+	EXPECT_EQ(s_Recorded[1].Type, AudioCommandType::Seek);
+	EXPECT_EQ(s_Recorded[1].Frame, 1234u);
+	EXPECT_EQ(s_Recorded[2].Type, AudioCommandType::Start);
+	EXPECT_EQ(queue.GetPending(), 0u);
+}
+
+TEST_F(AudioCommandQueueTest, AppliedAfterFlush)
+{
+	AudioCommandQueue queue(RecordCommand, 16);
+	queue.Push(MakeCommand(AudioCommandType::Start));
+	queue.Push(MakeCommand(AudioCommandType::SetPan, -1.0f));
+
+	// Commands pushed during a frame are not seen until the frame is flushed
+	EXPECT_EQ(queue.Apply(), 0u);
+	EXPECT_TRUE(s_Recorded.empty());
+	EXPECT_EQ(queue.GetPending(), 2u);
+
+	queue.Flush();
+	queue.Push(MakeCommand(AudioCommandType::Stop));
+	EXPECT_EQ(queue.Apply(), 2u);
+	EXPECT_EQ(s_Recorded.size(), 2u);
+	EXPECT_EQ(queue.GetPending(), 1u);
+
+	queue.Flush();
+	EXPECT_EQ(queue.Apply(), 1u);
+	EXPECT_EQ(s_Recorded.back().Type, AudioCommandType::Stop);
+}
+
+TEST_F(AudioCommandQueueTest, CapacityRoundedToPowerOfTwo)
+{
+	EXPECT_EQ(AudioCommandQueue(RecordCommand, 1).GetCapacity(), 1u);
+	EXPECT_EQ(AudioCommandQueue(RecordCommand, 100).GetCapacity(), 128u);
+	EXPECT_EQ(AudioCommandQueue(RecordCommand, 256).GetCapacity(), 256u);
+}
+
+TEST_F(AudioCommandQueueTest, FullQueueAppliesOnCaller)
+{
+	AudioCommandQueue queue(RecordCommand, 8);
+	for (int i = 0; i < 20; i++)
+		queue.Push(MakeCommand(AudioCommandType::SetPitch, (float)i));
+
+	// Waiting commands were applied to make space, without losing any
+	EXPECT_EQ(s_Recorded.size(), 16u);
+	EXPECT_LE(queue.GetPending(), queue.GetCapacity());
+
+	queue.Synchronise();
+	ASSERT_EQ(s_Recorded.size(), 20u);
+	for (int i = 0; i < 20; i++)
+		EXPECT_EQ(s_Recorded[i].Values[0], (float)i);
+}
+
+TEST_F(AudioCommandQueueTest, Synchronise)
+{
+	AudioCommandQueue queue(RecordCommand, 16);
+	queue.Push(MakeCommand(AudioCommandType::Stop));
+	queue.Synchronise();
+
+	EXPECT_EQ(s_Recorded.size(), 1u);
+	EXPECT_EQ(queue.GetPending(), 0u);
+	EXPECT_EQ(queue.Apply(), 0u);
+}
+
+static atomic<size_t> s_Applied = 0;
+static atomic<bool> s_OutOfOrder = false;
+
+static void CountCommand(const AudioCommand& command)
+{
+	// Frame holds the index of each command, which must arrive in order
+	if (command.Frame != s_Applied.load(memory_order_relaxed))
+		s_OutOfOrder = true;
+	s_Applied.fetch_add(1, memory_order_relaxed);
+}
+
+/// <summary>
+/// Game thread pushes commands in frames while an audio thread applies them, as with a running device
+/// </summary>
+TEST_F(AudioCommandQueueTest, DISABLED_ProducerConsumerBenchmark)
+{
+	const size_t Frames = 2000;
+	const size_t CommandsPerFrame = 250;
+
+	s_Applied = 0;
+	s_OutOfOrder = false;
+	AudioCommandQueue queue(CountCommand, 1024);
+
+	atomic<bool> running = true;
+	thread audioThread([&]()
+	{
+		while (running.load())
+		{
+			queue.Apply();
+			this_thread::yield();
+		}
+	});
+
+	auto start = chrono::high_resolution_clock::now();
+	size_t index = 0;
+	for (size_t frame = 0; frame < Frames; frame++)
+	{
+		for (size_t i = 0; i < CommandsPerFrame; i++)
+			queue.Push(MakeCommand(AudioCommandType::SetPosition, 1.0f, index++));
+		queue.Flush();
+	}
+	auto duration = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start);
+
+	queue.Synchronise();
+	running = false;
+	audioThread.join();
+
+	EXPECT_EQ(s_Applied.load(), Frames * CommandsPerFrame);
+	EXPECT_FALSE(s_OutOfOrder.load());
+	EXPECT_EQ(queue.GetPending(), 0u);
+
+	spdlog::info("Pushed {} commands over {} frames in {:.2f}ms, {:.1f}ns per command",
+		Frames * CommandsPerFrame, Frames, duration.count(), duration.count() * 1000000.0 / (Frames * CommandsPerFrame));
+}
+
+/// <summary>
+/// Waits for condition to be true, as changed by the audio device's thread
+/// </summary>
+/// <returns>False if timed out</returns>
+static bool WaitFor(const function<bool()>& condition, chrono::milliseconds timeout = chrono::seconds(5))
+{
+	auto end = chrono::steady_clock::now() + timeout;
+	while (!condition())
+	{
+		if (chrono::steady_clock::now() > end)
+			return false;
+		this_thread::sleep_for(chrono::milliseconds(1));
+	}
+	return true;
+}
+
+/// <summary>
+/// Applies commands to a real sound from AudioSystem's device callback, using an output device on the null backend
+/// </summary>
+TEST(AudioCommandQueue, AppliedToSound)
+{
+	const ma_uint32 SampleRate = 48000;
+	ASSERT_TRUE(AudioSystem::SetNullDevice(2, SampleRate));
+	ma_engine* engine = AudioSystem::GetEngine();
+
+	ma_waveform waveform;
+	ma_waveform_config waveformConfig = ma_waveform_config_init(ma_format_f32, 2, SampleRate, ma_waveform_type_sine, 0.5, 440.0);
+	ASSERT_EQ(ma_waveform_init(&waveformConfig, &waveform), MA_SUCCESS);
+
+	ma_sound sound;
+	ASSERT_EQ(ma_sound_init_from_data_source(engine, &waveform, 0, nullptr, &sound), MA_SUCCESS);
+	ma_sound_set_fade_in_pcm_frames(&sound, 1.0f, 1.0f, 0);
+
+	AudioCommandQueue& queue = AudioSystem::GetCommands();
+	auto submit = [&](AudioCommandType type, float x = 0.0f, float y = 0.0f, ma_uint64 frame = 0)
+	{
+		AudioCommand command = MakeCommand(type, x, frame);
+		command.Sound = &sound;
+		command.Values[1] = y;
+		queue.Push(command);
+	};
+
+	submit(AudioCommandType::Start);
+	submit(AudioCommandType::SetPan, -0.5f);
+	submit(AudioCommandType::SetPitch, 2.0f);
+	submit(AudioCommandType::SetVolume, 0.25f);
+	submit(AudioCommandType::Set3D, 0.0f);
+	submit(AudioCommandType::SetRolloffDistance, 2.0f, 20.0f);
+	submit(AudioCommandType::SetRolloffGain, 0.1f, 0.9f);
+	submit(AudioCommandType::SetAttenuationRolloff, 0.5f);
+	submit(AudioCommandType::SetAttenuationModel, 0.0f, 0.0f, ma_attenuation_model_linear);
+
+	// Nothing changes until flushed and applied by the device's thread
+	this_thread::sleep_for(chrono::milliseconds(20));
+	EXPECT_FALSE(ma_sound_is_playing(&sound));
+	EXPECT_EQ(queue.GetPending(), 9u);
+
+	queue.Flush();
+	ASSERT_TRUE(WaitFor([&] { return queue.GetPending() == 0; }));
+	EXPECT_TRUE(ma_sound_is_playing(&sound));
+	EXPECT_FLOAT_EQ(ma_sound_get_pan(&sound), -0.5f);
+	EXPECT_FLOAT_EQ(ma_sound_get_pitch(&sound), 2.0f);
+	EXPECT_FALSE(ma_sound_is_spatialization_enabled(&sound));
+	EXPECT_FLOAT_EQ(ma_sound_get_min_distance(&sound), 2.0f);
+	EXPECT_FLOAT_EQ(ma_sound_get_max_distance(&sound), 20.0f);
+	EXPECT_FLOAT_EQ(ma_sound_get_min_gain(&sound), 0.1f);
+	EXPECT_FLOAT_EQ(ma_sound_get_max_gain(&sound), 0.9f);
+	EXPECT_FLOAT_EQ(ma_sound_get_rolloff(&sound), 0.5f);
+	EXPECT_EQ(ma_sound_get_attenuation_model(&sound), ma_attenuation_model_linear);
+
+	// Volume is ramped while the device mixes, instead of changing immediately
+	EXPECT_TRUE(WaitFor([&] { return fabs(ma_sound_get_current_fade_volume(&sound) - 0.25f) < 0.0001f; }));
+
+	submit(AudioCommandType::Stop);
+	queue.Flush();
+	ASSERT_TRUE(WaitFor([&] { return queue.GetPending() == 0; }));
+	EXPECT_FALSE(ma_sound_is_playing(&sound));
+
+	ma_sound_uninit(&sound);
+	ma_waveform_uninit(&waveform);
+
+	// Releases the device
+	EXPECT_TRUE(AudioSystem::SetOffline(2, SampleRate));
+}
@@ -0,0 +1,195 @@
+#include <cmath>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
+#include <glm/glm.hpp>
+#include <Yonai/Audio/AudioCullingGrid.hpp>
+
+using namespace std;
+using namespace Yonai;
+
+struct TestSource
+{
+	glm::vec3 Position;
+	float Radius;
+};
+
+/// <returns>Indices of sources within their radius of any listener, found by testing every source</returns>
+static vector<size_t> FindInRange(const vector<TestSource>& sources, const vector<glm::vec3>& listeners)
+{
+	vector<size_t> found;
+	for (size_t i = 0; i < sources.size(); i++)
+		for (const glm::vec3& listener : listeners)
+			if (glm::distance(sources[i].Position, listener) <= sources[i].Radius)
+			{
+				found.emplace_back(i);
+				break;
+			}
+	return found;
+}
+
+static vector<size_t> Query(AudioCullingGrid& grid, const vector<TestSource>& sources, const vector<glm::vec3>& listeners)
+{
+	vector<const void*> keys;
+	grid.Query(listeners, keys);
+
+	vector<size_t> found;
+	for (const void* key : keys)
+		found.emplace_back((const TestSource*)key - sources.data());
+	sort(found.begin(), found.end());
+	return found;
+}
+
+TEST(AudioCullingGrid, InRange)
+{
+	AudioCullingGrid grid(10.0f);
+	vector<TestSource> sources =
+	{
+		{ { 0, 0, 0 }, 5.0f },
+		{ { 12, 0, 0 }, 5.0f },		// Neighbouring cell, out of range
+		{ { 14, 0, 0 }, 15.0f },	// Neighbouring cell, in range
+		{ { -18, 3, 0 }, 20.0f },	// Two cells away, in range
+		{ { 500, 0, 0 }, INFINITY },	// Never culled
+		{ { 0, 0, 900 }, 1000.0f }	// Too large for the grid
+	};
+	for (TestSource& source : sources)
+		grid.Update(&source, source.Position, source.Radius);
+
+	EXPECT_EQ(grid.GetCount(), sources.size());
+	EXPECT_EQ(grid.GetUnboundedCount(), 2u);
+	EXPECT_EQ(Query(grid, sources, { glm::vec3(0.0f) }), vector<size_t>({ 0, 2, 3, 4, 5 }));
+
+	// Nothing is in range without listeners
+	EXPECT_TRUE(Query(grid, sources, {}).empty());
+}
+
+TEST(AudioCullingGrid, MultipleListeners)
+{
+	AudioCullingGrid grid(10.0f);
+	vector<TestSource> sources =
+	{
+		{ { 0, 0, 0 }, 5.0f },
+		{ { 100, 0, 0 }, 5.0f },
+		{ { 50, 0, 0 }, 5.0f }
+	};
+	for (TestSource& source : sources)
+		grid.Update(&source, source.Position, source.Radius);
+
+	// In range of both listeners, found once
+	sources[0].Radius = 20.0f;
+	grid.Update(&sources[0], sources[0].Position, sources[0].Radius);
+	EXPECT_EQ(Query(grid, sources, { glm::vec3(2, 0, 0), glm::vec3(-2, 0, 0), glm::vec3(101, 0, 0) }), vector<size_t>({ 0, 1 }));
+}
+
+TEST(AudioCullingGrid, Move)
+{
+	AudioCullingGrid grid(10.0f);
+	vector<TestSource> sources = { { { 0, 0, 0 }, 5.0f } };
+	grid.Update(&sources[0], sources[0].Position, sources[0].Radius);
+	vector<glm::vec3> listeners = { glm::vec3(100, 0, 0) };
+	EXPECT_TRUE(Query(grid, sources, listeners).empty());
+
+	// Between cells
+	sources[0].Position = glm::vec3(98, 0, 0);
+	grid.Update(&sources[0], sources[0].Position, sources[0].Radius);
+	EXPECT_EQ(Query(grid, sources, listeners).size(), 1u);
+
+	// Out of the grid, and back
+	grid.Update(&sources[0], glm::vec3(0.0f), INFINITY);
+	EXPECT_EQ(grid.GetUnboundedCount(), 1u);
+	EXPECT_EQ(Query(grid, sources, listeners).size(), 1u);
+
+	grid.Update(&sources[0], glm::vec3(0.0f), 5.0f);
+	EXPECT_EQ(grid.GetUnboundedCount(), 0u);
+	EXPECT_TRUE(Query(grid, sources, listeners).empty());
+
+	grid.Remove(&sources[0]);
+	EXPECT_FALSE(grid.Contains(&sources[0]));
+	EXPECT_EQ(grid.GetCount(), 0u);
+}
+
+TEST(AudioCullingGrid, MatchesBruteForce)
+{
+	mt19937 random(42);
+	uniform_real_distribution<float> coordinate(-500.0f, 500.0f);
+	uniform_real_distribution<float> radius(1.0f, 80.0f);
+
+	vector<TestSource> sources(2000);
+	for (TestSource& source : sources)
+		source = { glm::vec3(coordinate(random), coordinate(random) * 0.1f, coordinate(random)), radius(random) };
+
+	AudioCullingGrid grid(25.0f);
+	for (TestSource& source : sources)
+		grid.Update(&source, source.Position, source.Radius);
+
+	for (int i = 0; i < 20; i++)
+	{
+		vector<glm::vec3> listeners = { glm::vec3(coordinate(random), 0, coordinate(random)) };
+		if (i % 2)
+			listeners.emplace_back(coordinate(random), 0, coordinate(random));
+
+		ASSERT_EQ(Query(grid, sources, listeners), FindInRange(sources, listeners));
+
+		// Move some sources, across and within cells
+		for (size_t j = i; j < sources.size(); j += 7)
+		{
+			sources[j].Position += glm::vec3(coordinate(random), 0, coordinate(random)) * 0.05f;
+			grid.Update(&sources[j], sources[j].Position, sources[j].Radius);
+		}
+	}
+
+	// Resizing cells keeps every source
+	grid.SetCellSize(7.0f);
+	vector<glm::vec3> listeners = { glm::vec3(0.0f) };
+	EXPECT_EQ(grid.GetCount(), sources.size());
+	EXPECT_EQ(Query(grid, sources, listeners), FindInRange(sources, listeners));
+}
+
+/// <summary>
+/// Compares finding sources in range of a listener against testing every source
+/// </summary>
+TEST(AudioCullingGrid, DISABLED_QueryBenchmark)
+{
+	const unsigned int SourceCount = 10000;
+	const unsigned int Iterations = 500;
+
+	mt19937 random(1234);
+	uniform_real_distribution<float> coordinate(-2000.0f, 2000.0f);
+	uniform_real_distribution<float> radius(10.0f, 60.0f);
+
+	vector<TestSource> sources(SourceCount);
+	for (TestSource& source : sources)
+		source = { glm::vec3(coordinate(random), 0, coordinate(random)), radius(random) };
+
+	AudioCullingGrid grid(32.0f);
+	for (TestSource& source : sources)
+		grid.Update(&source, source.Position, source.Radius);
+
+	vector<glm::vec3> listeners = { glm::vec3(0.0f) };
+	vector<const void*> found;
+	size_t foundCount = 0, bruteForceCount = 0;
+
+	auto start = chrono::high_resolution_clock::now();
+	for (unsigned int i = 0; i < Iterations; i++)
+	{
+		listeners[0].x = (float)i;
+		grid.Query(listeners, found);
+		foundCount += found.size();
+	}
+	auto gridDuration = chrono::duration<double, micro>(chrono::high_resolution_clock::now() - start);
+
+	start = chrono::high_resolution_clock::now();
+	for (unsigned int i = 0; i < Iterations; i++)
+	{
+		listeners[0].x = (float)i;
+		bruteForceCount += FindInRange(sources, listeners).size();
+	}
+	auto bruteForceDuration = chrono::duration<double, micro>(chrono::high_resolution_clock::now() - start);
+
+	EXPECT_EQ(foundCount, bruteForceCount);
+	spdlog::info("{} sources, {:.1f} in range - {:.2f}us per grid query, {:.2f}us testing every source",
+		SourceCount, foundCount / (double)Iterations, gridDuration.count() / Iterations, bruteForceDuration.count() / Iterations);
+}
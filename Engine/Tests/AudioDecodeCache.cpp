@@ -0,0 +1,216 @@
+#include <chrono>
+#include <random>
+#include <vector>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
+#include <Yonai/Audio/AudioDecodeCache.hpp>
+
+using namespace std;
+using namespace Yonai;
+
+static constexpr ma_uint32 Channels = 2;
+static constexpr ma_uint32 SampleRate = 44100;
+
+/// <summary>
+/// Creates a 16-bit stereo WAV clip in memory, with samples offset by seed
+/// </summary>
+static vector<unsigned char> MakeClip(ma_uint64 frames, int seed = 0)
+{
+	vector<int16_t> samples(frames * Channels);
+	for (ma_uint64 i = 0; i < frames; i++)
+	{
+		samples[i * Channels + 0] = (int16_t)((i + seed) & 0x7FFF);
+		samples[i * Channels + 1] = (int16_t)(-(int)((i + seed) & 0x7FFF));
+	}
+
+	const uint32_t dataSize = (uint32_t)(samples.size() * sizeof(int16_t));
+	const uint16_t format = 1, channels = Channels, bitsPerSample = 16, blockAlign = Channels * 2;
+	const uint32_t sampleRate = SampleRate, byteRate = SampleRate * blockAlign, fmtSize = 16, riffSize = 36 + dataSize;
+
+	vector<unsigned char> clip;
+	auto write = [&](const void* data, size_t size)
+	{ clip.insert(clip.end(), (const unsigned char*)data, (const unsigned char*)data + size); };
+	write("RIFF", 4);
+	write(&riffSize, 4);
+	write("WAVEfmt ", 8);
+	write(&fmtSize, 4);
+	write(&format, 2);
+	write(&channels, 2);
+	write(&sampleRate, 4);
+	write(&byteRate, 4);
+	write(&blockAlign, 2);
+	write(&bitsPerSample, 2);
+	write("data", 4);
+	write(&dataSize, 4);
+	write(samples.data(), dataSize);
+	return clip;
+}
+
+TEST(AudioDecodeCache, HitAndMiss)
+{
+	AudioDecodeCache cache;
+	vector<unsigned char> encoded = MakeClip(1000);
+
+	shared_ptr<AudioDecodedClip> clip = cache.Get(&encoded, encoded);
+	ASSERT_NE(clip, nullptr);
+	EXPECT_EQ(cache.GetMisses(), 1u);
+	EXPECT_EQ(cache.GetHits(), 0u);
+
+	EXPECT_EQ(clip->Format, ma_format_s16);
+	EXPECT_EQ(clip->Channels, Channels);
+	EXPECT_EQ(clip->SampleRate, SampleRate);
+	EXPECT_EQ(clip->FrameCount, 1000u);
+	ASSERT_EQ(clip->Frames.size(), 1000u * Channels * sizeof(int16_t));
+	const int16_t* samples = (const int16_t*)clip->Frames.data();
+	EXPECT_EQ(samples[10 * Channels], 10);
+	EXPECT_EQ(samples[10 * Channels + 1], -10);
+
+	// Shared by every user of the clip
+	EXPECT_EQ(cache.Get(&encoded, encoded), clip);
+	EXPECT_EQ(cache.GetHits(), 1u);
+	EXPECT_EQ(cache.GetMisses(), 1u);
+	EXPECT_EQ(cache.GetMemoryUsage(), clip->Frames.size());
+
+	cache.ResetStats();
+	EXPECT_EQ(cache.GetHits(), 0u);
+	EXPECT_EQ(cache.GetMisses(), 0u);
+}
+
+TEST(AudioDecodeCache, Float)
+{
+	AudioDecodeCache cache;
+	cache.SetFormat(ma_format_f32);
+	vector<unsigned char> encoded = MakeClip(100);
+
+	shared_ptr<AudioDecodedClip> clip = cache.Get(&encoded, encoded);
+	ASSERT_NE(clip, nullptr);
+	EXPECT_EQ(clip->Format, ma_format_f32);
+	ASSERT_EQ(clip->Frames.size(), 100u * Channels * sizeof(float));
+	EXPECT_NEAR(((const float*)clip->Frames.data())[50 * Channels], 50 / 32768.0f, 0.0001f);
+
+	// Changing format clears clips in the old format
+	cache.SetFormat(ma_format_s16);
+	EXPECT_FALSE(cache.Contains(&encoded));
+	EXPECT_EQ(cache.GetMemoryUsage(), 0u);
+
+	// Only 16-bit and float are supported
+	cache.SetFormat(ma_format_u8);
+	EXPECT_EQ(cache.GetFormat(), ma_format_s16);
+}
+
+TEST(AudioDecodeCache, LeastRecentlyUsed)
+{
+	const ma_uint64 Frames = 1000;
+	const size_t ClipSize = Frames * Channels * sizeof(int16_t);
+	vector<unsigned char> clips[3] = { MakeClip(Frames, 0), MakeClip(Frames, 1), MakeClip(Frames, 2) };
+
+	// Room for two clips
+	AudioDecodeCache cache(ClipSize * 2);
+	cache.Get(&clips[0], clips[0]);
+	shared_ptr<AudioDecodedClip> second = cache.Get(&clips[1], clips[1]);
+	cache.Get(&clips[0], clips[0]);
+	cache.Get(&clips[2], clips[2]);
+
+	// Second clip was least recently used
+	EXPECT_TRUE(cache.Contains(&clips[0]));
+	EXPECT_FALSE(cache.Contains(&clips[1]));
+	EXPECT_TRUE(cache.Contains(&clips[2]));
+	EXPECT_EQ(cache.GetEvictions(), 1u);
+	EXPECT_EQ(cache.GetCount(), 2u);
+	EXPECT_LE(cache.GetMemoryUsage(), cache.GetBudget());
+
+	// Evicted clips remain valid while still in use
+	ASSERT_NE(second, nullptr);
+	EXPECT_EQ(((const int16_t*)second->Frames.data())[0], 1);
+
+	// Lowering the budget evicts immediately
+	cache.SetBudget(ClipSize);
+	EXPECT_EQ(cache.GetCount(), 1u);
+	EXPECT_TRUE(cache.Contains(&clips[2]));
+	EXPECT_EQ(cache.GetEvictions(), 2u);
+
+	cache.Remove(&clips[2]);
+	EXPECT_EQ(cache.GetCount(), 0u);
+	EXPECT_EQ(cache.GetMemoryUsage(), 0u);
+}
+
+TEST(AudioDecodeCache, NotCached)
+{
+	vector<unsigned char> encoded = MakeClip(SampleRate * 2);
+
+	// Too long
+	AudioDecodeCache cache(64 * 1024 * 1024, 1.0f);
+	EXPECT_EQ(cache.Get(&encoded, encoded), nullptr);
+	EXPECT_FALSE(cache.Contains(&encoded));
+	EXPECT_EQ(cache.GetMisses(), 1u);
+
+	// Larger than the budget
+	cache.SetMaxClipLength(10.0f);
+	cache.SetBudget(1024);
+	EXPECT_EQ(cache.Get(&encoded, encoded), nullptr);
+
+	// Disabled
+	cache.SetBudget(0);
+	EXPECT_EQ(cache.Get(&encoded, encoded), nullptr);
+
+	// Not audio
+	cache.SetBudget(64 * 1024 * 1024);
+	vector<unsigned char> invalid(100, 0xAB);
+	EXPECT_EQ(cache.Get(&invalid, invalid), nullptr);
+	EXPECT_EQ(cache.GetCount(), 0u);
+}
+
+/// <summary>
+/// Compares playing short clips from the cache against decoding them each time they play,
+/// and the memory held decoded against the encoded clips
+/// </summary>
+TEST(AudioDecodeCache, DISABLED_Benchmark)
+{
+	const unsigned int ClipCount = 64;
+	const unsigned int Plays = 2000;
+	const ma_uint64 Frames = SampleRate / 2;
+
+	vector<vector<unsigned char>> clips;
+	size_t encodedSize = 0;
+	for (unsigned int i = 0; i < ClipCount; i++)
+	{
+		clips.emplace_back(MakeClip(Frames, i));
+		encodedSize += clips.back().size();
+	}
+
+	// A budget for a quarter of the clips, with some clips played much more often than others
+	AudioDecodeCache cache(ClipCount / 4 * Frames * Channels * sizeof(int16_t));
+	vector<unsigned int> order(Plays);
+	mt19937 random(1234);
+	exponential_distribution<float> popularity(0.1f);
+	for (unsigned int& index : order)
+		index = (std::min)((unsigned int)popularity(random), ClipCount - 1);
+	auto pick = [&](unsigned int play) { return order[play]; };
+
+	auto start = chrono::high_resolution_clock::now();
+	for (unsigned int i = 0; i < Plays; i++)
+	{
+		unsigned int index = pick(i);
+		ASSERT_NE(cache.Get(&clips[index], clips[index]), nullptr);
+	}
+	auto cachedDuration = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start);
+
+	vector<int16_t> decoded(Frames * Channels);
+	start = chrono::high_resolution_clock::now();
+	for (unsigned int i = 0; i < Plays; i++)
+	{
+		vector<unsigned char>& clip = clips[pick(i)];
+		ma_decoder decoder;
+		ma_decoder_config config = ma_decoder_config_init(ma_format_s16, 0, 0);
+		ASSERT_EQ(ma_decoder_init_memory(clip.data(), clip.size(), &config, &decoder), MA_SUCCESS);
+		ma_decoder_read_pcm_frames(&decoder, decoded.data(), Frames, nullptr);
+		ma_decoder_uninit(&decoder);
+	}
+	auto uncachedDuration = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start);
+
+	spdlog::info("{} plays of {} clips - {:.1f}% hit rate, {} evictions, {:.2f}ms cached, {:.2f}ms decoding every play",
+		Plays, ClipCount, 100.0 * cache.GetHits() / Plays, cache.GetEvictions(), cachedDuration.count(), uncachedDuration.count());
+	spdlog::info("{:.1f}MB decoded in cache, {:.1f}MB of encoded clips",
+		cache.GetMemoryUsage() / (1024.0 * 1024.0), encodedSize / (1024.0 * 1024.0));
+}
@@ -0,0 +1,448 @@
+#include <cmath>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
+#include <Yonai/Audio/AudioMixer.hpp>
+#include <Yonai/Audio/AudioEffects.hpp>
+#include <Yonai/Audio/AudioKernels.hpp>
+#include <Yonai/Audio/AudioRenderer.hpp>
+#include <Yonai/Systems/Global/AudioSystem.hpp>
+
+using namespace std;
+using namespace Yonai;
+using namespace Yonai::Systems;
+
+#pragma region Kernels
+/// <summary>
+/// Deterministic noise in the range [-1, 1]
+/// </summary>
+static vector<float> Noise(size_t count, unsigned int seed = 1)
+{
+	vector<float> samples(count);
+	for (float& sample : samples)
+	{
+		seed = seed * 1664525u + 1013904223u;
+		sample = (float)(seed >> 8) / (float)(1u << 23) - 1.0f;
+	}
+	return samples;
+}
+
+static void ReferenceBiquad(const float* input, float* output, ma_uint32 frameCount, ma_uint32 channels, const AudioKernels::BiquadCoefficients& c, float* state)
+{
+	for (ma_uint32 i = 0; i < frameCount; i++)
+		for (ma_uint32 ch = 0; ch < channels; ch++)
+		{
+			float x = input[i * channels + ch];
+			float& z1 = state[ch];
+			float& z2 = state[channels + ch];
+			float y = c.B0 * x + z1;
+			z1 = c.B1 * x - c.A1 * y + z2;
+			z2 = c.B2 * x - c.A2 * y;
+			output[i * channels + ch] = y;
+		}
+}
+
+TEST(AudioKernels, Biquad)
+{
+	const ma_uint32 FrameCount = 1001;
+	AudioKernels::BiquadCoefficients coefficients = AudioKernels::LowPass(48000, 1200.0f, 0.9f);
+
+	// Channel counts covering each of the vectorised and scalar paths
+	for (ma_uint32 channels : { 1u, 2u, 3u, 4u, 6u, 8u })
+	{
+		vector<float> input = Noise(FrameCount * channels, channels);
+		vector<float> expected(input.size()), actual(input.size());
+		vector<float> expectedState(channels * 2, 0.0f), actualState(channels * 2, 0.0f);
+
+		ReferenceBiquad(input.data(), expected.data(), FrameCount, channels, coefficients, expectedState.data());
+		AudioKernels::Biquad(input.data(), actual.data(), FrameCount, channels, coefficients, actualState.data());
+
+		for (size_t i = 0; i < input.size(); i++)
+			ASSERT_NEAR(actual[i], expected[i], 1e-5f) << channels << " channels, sample " << i;
+		for (size_t i = 0; i < expectedState.size(); i++)
+			EXPECT_NEAR(actualState[i], expectedState[i], 1e-5f) << channels << " channels";
+	}
+}
+
+TEST(AudioKernels, BiquadInPlace)
+{
+	const ma_uint32 FrameCount = 512, Channels = 2;
+	AudioKernels::BiquadCoefficients coefficients = AudioKernels::HighPass(44100, 300.0f, 0.7071f);
+
+	vector<float> samples = Noise(FrameCount * Channels);
+	vector<float> expected(samples.size());
+	vector<float> expectedState(Channels * 2, 0.0f), actualState(Channels * 2, 0.0f);
+
+	ReferenceBiquad(samples.data(), expected.data(), FrameCount, Channels, coefficients, expectedState.data());
+	AudioKernels::Biquad(samples.data(), samples.data(), FrameCount, Channels, coefficients, actualState.data());
+
+	for (size_t i = 0; i < samples.size(); i++)
+		ASSERT_NEAR(samples[i], expected[i], 1e-5f);
+}
+
+TEST(AudioKernels, FilterResponse)
+{
+	const ma_uint32 SampleRate = 48000, FrameCount = SampleRate / 4;
+	auto measure = [&](const AudioKernels::BiquadCoefficients& coefficients, float frequency)
+	{
+		vector<float> samples(FrameCount);
+		for (ma_uint32 i = 0; i < FrameCount; i++)
+			samples[i] = sinf(2.0f * 3.14159265f * frequency * i / SampleRate);
+
+		float state[2] = { 0.0f, 0.0f };
+		AudioKernels::Biquad(samples.data(), samples.data(), FrameCount, 1, coefficients, state);
+
+		// RMS of the second half, ignoring the filter settling, scaled to match a sine's peak
+		float sum = 0.0f;
+		for (ma_uint32 i = FrameCount / 2; i < FrameCount; i++)
+			sum += samples[i] * samples[i];
+		return sqrtf(2.0f * sum / (FrameCount / 2));
+	};
+
+	AudioKernels::BiquadCoefficients lowPass = AudioKernels::LowPass(SampleRate, 1000.0f, 0.7071f);
+	EXPECT_NEAR(measure(lowPass, 100.0f), 1.0f, 0.02f);
+	EXPECT_LT(measure(lowPass, 8000.0f), 0.02f);
+
+	AudioKernels::BiquadCoefficients highPass = AudioKernels::HighPass(SampleRate, 1000.0f, 0.7071f);
+	EXPECT_LT(measure(highPass, 100.0f), 0.02f);
+	EXPECT_NEAR(measure(highPass, 8000.0f), 1.0f, 0.02f);
+}
+
+TEST(AudioKernels, Gain)
+{
+	vector<float> input = Noise(1027);
+	vector<float> samples = input;
+	AudioKernels::Gain(samples.data(), samples.size(), 0.25f);
+	for (size_t i = 0; i < samples.size(); i++)
+		ASSERT_FLOAT_EQ(samples[i], input[i] * 0.25f);
+
+	vector<float> output = Noise(input.size(), 7);
+	vector<float> expected = output;
+	for (size_t i = 0; i < expected.size(); i++)
+		expected[i] += input[i] * 0.5f;
+	AudioKernels::MixInto(output.data(), input.data(), output.size(), 0.5f);
+	for (size_t i = 0; i < output.size(); i++)
+		ASSERT_FLOAT_EQ(output[i], expected[i]);
+}
+
+TEST(AudioKernels, Peak)
+{
+	// Lengths not a multiple of the vector width
+	for (size_t count : { 1, 3, 4, 17, 1024 })
+	{
+		vector<float> samples = Noise(count, (unsigned int)count);
+		samples[count / 2] = -1.5f;
+		EXPECT_EQ(AudioKernels::Peak(samples.data(), count), 1.5f);
+	}
+	EXPECT_EQ(AudioKernels::Peak(nullptr, 0), 0.0f);
+}
+
+TEST(AudioKernels, PerFrame)
+{
+	const ma_uint32 FrameCount = 259;
+	for (ma_uint32 channels : { 1u, 2u, 3u, 6u })
+	{
+		vector<float> input = Noise(FrameCount * channels, channels);
+		vector<float> peaks(FrameCount);
+		AudioKernels::PeakPerFrame(input.data(), peaks.data(), FrameCount, channels);
+
+		vector<float> gains = Noise(FrameCount, channels + 100);
+		vector<float> output(input.size());
+		AudioKernels::GainPerFrame(input.data(), output.data(), gains.data(), FrameCount, channels);
+
+		for (ma_uint32 i = 0; i < FrameCount; i++)
+		{
+			float peak = 0.0f;
+			for (ma_uint32 ch = 0; ch < channels; ch++)
+			{
+				peak = (std::max)(peak, fabs(input[i * channels + ch]));
+				ASSERT_FLOAT_EQ(output[i * channels + ch], input[i * channels + ch] * gains[i]);
+			}
+			ASSERT_EQ(peaks[i], peak) << channels << " channels, frame " << i;
+		}
+	}
+}
+#pragma endregion
+
+#pragma region Effects
+/// <summary>
+/// Sine wave sources played through mixers with effects, mixed offline by AudioSystem
+/// </summary>
+class AudioEffectTest : public ::testing::Test
+{
+protected:
+	static constexpr ma_uint32 Channels = 2;
+	static constexpr ma_uint32 SampleRate = 48000;
+
+	struct Source
+	{
+		ma_waveform Waveform;
+		ma_sound Sound;
+	};
+
+	vector<unique_ptr<Source>> m_Sources;
+	vector<unique_ptr<AudioMixer>> m_Mixers;
+
+	void SetUp() override { ASSERT_TRUE(AudioSystem::SetOffline(Channels, SampleRate)); }
+
+	void TearDown() override
+	{
+		for (auto& source : m_Sources)
+		{
+			ma_sound_uninit(&source->Sound);
+			ma_waveform_uninit(&source->Waveform);
+		}
+		m_Sources.clear();
+		m_Mixers.clear();
+	}
+
+	AudioMixer* AddMixer(string name = "Mixer")
+	{
+		m_Mixers.emplace_back(make_unique<AudioMixer>(name));
+		return m_Mixers.back().get();
+	}
+
+	ma_sound* AddSource(AudioMixer* mixer, double frequency, double amplitude = 0.1)
+	{
+		unique_ptr<Source> source = make_unique<Source>();
+		ma_waveform_config config = ma_waveform_config_init(ma_format_f32, Channels, SampleRate, ma_waveform_type_sine, amplitude, frequency);
+		if (ma_waveform_init(&config, &source->Waveform) != MA_SUCCESS ||
+			ma_sound_init_from_data_source(AudioSystem::GetEngine(), &source->Waveform, 0, mixer->GetHandle(), &source->Sound) != MA_SUCCESS)
+			return nullptr;
+
+		ma_sound_set_looping(&source->Sound, MA_TRUE);
+		ma_sound_set_spatialization_enabled(&source->Sound, MA_FALSE);
+		ma_sound_start(&source->Sound);
+		m_Sources.emplace_back(move(source));
+		return &m_Sources.back()->Sound;
+	}
+
+	/// <returns>Peak level of the mixed output over frameCount frames</returns>
+	float RenderPeak(ma_uint64 frameCount)
+	{
+		vector<float> output;
+		AudioSystem::Render(output, frameCount);
+		return AudioKernels::Peak(output.data(), output.size());
+	}
+};
+
+TEST_F(AudioEffectTest, Chain)
+{
+	AudioMixer* mixer = AddMixer();
+	AudioEffect* lowPass = mixer->AddEffect(AudioEffectType::LowPass);
+	AudioEffect* reverb = mixer->AddEffect(AudioEffectType::Reverb);
+	ASSERT_NE(lowPass, nullptr);
+	ASSERT_NE(reverb, nullptr);
+	EXPECT_EQ(mixer->GetEffectCount(), 2u);
+	EXPECT_EQ(mixer->GetEffect(0), lowPass);
+	EXPECT_EQ(mixer->GetEffect(1), reverb);
+	EXPECT_EQ(mixer->GetEffect(2), nullptr);
+
+	mixer->RemoveEffect(lowPass);
+	EXPECT_EQ(mixer->GetEffectCount(), 1u);
+	EXPECT_EQ(mixer->GetEffect(0), reverb);
+
+	// Audio still reaches the output after changing the chain
+	ASSERT_NE(AddSource(mixer, 440.0), nullptr);
+	EXPECT_GT(RenderPeak(SampleRate / 4), 0.05f);
+
+	mixer->ClearEffects();
+	EXPECT_EQ(mixer->GetEffectCount(), 0u);
+	EXPECT_GT(RenderPeak(SampleRate / 4), 0.05f);
+}
+
+TEST_F(AudioEffectTest, Parameters)
+{
+	AudioMixer* mixer = AddMixer();
+	AudioEffect* compressor = mixer->AddEffect(AudioEffectType::Compressor);
+	ASSERT_NE(compressor, nullptr);
+
+	unsigned int count = 0;
+	const AudioEffectParameter* info = AudioEffect::GetParameterInfo(AudioEffectType::Compressor, &count);
+	ASSERT_EQ(compressor->GetParameterCount(), count);
+	for (unsigned int i = 0; i < count; i++)
+		EXPECT_EQ(compressor->GetParameter(i), info[i].Default) << info[i].Name;
+
+	// Values are clamped to each parameter's range
+	compressor->SetParameter(CompressorEffect::Ratio, 1000.0f);
+	EXPECT_EQ(compressor->GetParameter(CompressorEffect::Ratio), info[CompressorEffect::Ratio].Max);
+	compressor->SetParameter(CompressorEffect::Threshold, -1000.0f);
+	EXPECT_EQ(compressor->GetParameter(CompressorEffect::Threshold), info[CompressorEffect::Threshold].Min);
+
+	// Out of range indices are ignored
+	compressor->SetParameter(count, 1.0f);
+	EXPECT_EQ(compressor->GetParameter(count), 0.0f);
+}
+
+TEST_F(AudioEffectTest, Filters)
+{
+	auto measure = [&](AudioEffectType type, double frequency)
+	{
+		SetUp();
+		AudioMixer* mixer = AddMixer();
+		AudioEffect* filter = mixer->AddEffect(type);
+		filter->SetParameter(FilterEffect::Cutoff, 1000.0f);
+		AddSource(mixer, frequency);
+
+		RenderPeak(SampleRate / 10); // Settle
+		float peak = RenderPeak(SampleRate / 4);
+		TearDown();
+		return peak;
+	};
+
+	EXPECT_GT(measure(AudioEffectType::LowPass, 100.0), 0.09f);
+	EXPECT_LT(measure(AudioEffectType::LowPass, 7000.0), 0.005f);
+	EXPECT_LT(measure(AudioEffectType::HighPass, 100.0), 0.005f);
+	EXPECT_GT(measure(AudioEffectType::HighPass, 7000.0), 0.09f);
+}
+
+TEST_F(AudioEffectTest, Disabled)
+{
+	AudioMixer* mixer = AddMixer();
+	AudioEffect* filter = mixer->AddEffect(AudioEffectType::LowPass);
+	filter->SetParameter(FilterEffect::Cutoff, 100.0f);
+	AddSource(mixer, 7000.0);
+
+	RenderPeak(SampleRate / 10);
+	EXPECT_LT(RenderPeak(SampleRate / 10), 0.01f);
+
+	// Passes audio through unchanged
+	filter->SetEnabled(false);
+	EXPECT_NEAR(RenderPeak(SampleRate / 10), 0.1f, 0.005f);
+}
+
+TEST_F(AudioEffectTest, Compressor)
+{
+	AudioMixer* mixer = AddMixer();
+	AudioEffect* compressor = mixer->AddEffect(AudioEffectType::Compressor);
+	compressor->SetParameter(CompressorEffect::Threshold, -20.0f);
+	compressor->SetParameter(CompressorEffect::Ratio, 4.0f);
+	AddSource(mixer, 440.0, 0.5); // -6dB
+
+	RenderPeak(SampleRate / 2); // Settle
+
+	// 14dB over threshold is reduced to 3.5dB over, -16.5dB
+	float expected = powf(10.0f, -16.5f / 20.0f);
+	float peak = RenderPeak(SampleRate / 2);
+	EXPECT_LT(peak, 0.5f);
+	EXPECT_NEAR(peak, expected, expected * 0.25f);
+}
+
+TEST_F(AudioEffectTest, Limiter)
+{
+	AudioMixer* mixer = AddMixer();
+	AudioEffect* limiter = mixer->AddEffect(AudioEffectType::Limiter);
+	limiter->SetParameter(LimiterEffect::Threshold, -6.0f);
+
+	// Several loud sources summing well above full scale
+	for (int i = 0; i < 4; i++)
+		AddSource(mixer, 220.0 * (i + 1), 0.8);
+
+	// No settling, the limiter reacts instantly
+	EXPECT_LE(RenderPeak(SampleRate), powf(10.0f, -6.0f / 20.0f) + 0.0001f);
+}
+
+TEST_F(AudioEffectTest, ReverbTail)
+{
+	AudioMixer* mixer = AddMixer();
+	AudioEffect* reverb = mixer->AddEffect(AudioEffectType::Reverb);
+	reverb->SetParameter(ReverbEffect::RoomSize, 0.8f);
+	ma_sound* sound = AddSource(mixer, 440.0);
+
+	RenderPeak(SampleRate / 2);
+	ma_sound_stop(sound);
+
+	// Tail is heard after the source has stopped, then fades to silence
+	float tail = RenderPeak(SampleRate / 10);
+	EXPECT_GT(tail, 0.001f);
+
+	RenderPeak(SampleRate * 10);
+	EXPECT_LT(RenderPeak(SampleRate / 10), tail * 0.01f);
+}
+
+TEST_F(AudioEffectTest, Ducking)
+{
+	AudioMixer* dialog = AddMixer("Dialog");
+	AudioMixer* music = AddMixer("Music");
+
+	DuckingEffect* ducking = (DuckingEffect*)music->AddEffect(AudioEffectType::Ducking);
+	ASSERT_NE(ducking, nullptr);
+	ducking->SetParameter(DuckingEffect::Amount, 12.0f);
+	ducking->SetSidechain(dialog->GetMeter()->GetSharedLevel());
+
+	AddSource(music, 220.0);
+	RenderPeak(SampleRate / 2);
+	EXPECT_FLOAT_EQ(ducking->GetGain(), 1.0f);
+
+	// Music is lowered by the amount while dialog plays
+	ma_sound* line = AddSource(dialog, 880.0);
+	RenderPeak(SampleRate / 2);
+	EXPECT_GT(dialog->GetMeter()->GetLevel(), 0.05f);
+	EXPECT_NEAR(ducking->GetGain(), powf(10.0f, -12.0f / 20.0f), 0.01f);
+
+	// And recovers once dialog stops
+	ma_sound_stop(line);
+	RenderPeak(SampleRate * 2);
+	EXPECT_NEAR(ducking->GetGain(), 1.0f, 0.01f);
+}
+
+TEST_F(AudioEffectTest, DuckingKeepsReplacedSidechains)
+{
+	AudioMixer* music = AddMixer("Music");
+	DuckingEffect* ducking = (DuckingEffect*)music->AddEffect(AudioEffectType::Ducking);
+	ASSERT_NE(ducking, nullptr);
+	AddSource(music, 220.0);
+
+	shared_ptr<atomic<float>> first = make_shared<atomic<float>>(0.0f);
+	weak_ptr<atomic<float>> firstWeak = first;
+	ducking->SetSidechain(first);
+	first.reset();
+
+	// Replaced twice before a block is processed, audio thread may still be reading the first level
+	ducking->SetSidechain(make_shared<atomic<float>>(0.0f));
+	ducking->SetSidechain(nullptr);
+	EXPECT_FALSE(firstWeak.expired());
+
+	// Released on the next change after a block has been processed
+	RenderPeak(SampleRate / 10);
+	ducking->SetSidechain(nullptr);
+	EXPECT_TRUE(firstWeak.expired());
+}
+
+/// <summary>
+/// Measures the cost of common effect chains on a mixer playing 64 sources
+/// </summary>
+TEST_F(AudioEffectTest, DISABLED_Benchmark)
+{
+	const ma_uint64 Seconds = 10;
+	const vector<pair<string, vector<AudioEffectType>>> Chains =
+	{
+		{ "No effects", {} },
+		{ "Low-pass", { AudioEffectType::LowPass } },
+		{ "Compressor + limiter", { AudioEffectType::Compressor, AudioEffectType::Limiter } },
+		{ "Reverb", { AudioEffectType::Reverb } },
+		{ "Filters + compressor + reverb + limiter",
+			{ AudioEffectType::HighPass, AudioEffectType::LowPass, AudioEffectType::Compressor, AudioEffectType::Reverb, AudioEffectType::Limiter } }
+	};
+
+	for (auto& chain : Chains)
+	{
+		SetUp();
+		AudioMixer* mixer = AddMixer();
+		for (AudioEffectType type : chain.second)
+			ASSERT_NE(mixer->AddEffect(type), nullptr);
+		for (int i = 0; i < 64; i++)
+			AddSource(mixer, 110.0 + i * 3.0, 0.02);
+
+		AudioRenderer& renderer = AudioSystem::GetRenderer();
+		renderer.ResetStats();
+		RenderPeak(SampleRate * Seconds);
+
+		spdlog::info("{} - {:.3f}ms to mix each second of audio, {:.0f}x real time",
+			chain.first, renderer.GetCostPerSecond(), 1000.0 / renderer.GetCostPerSecond());
+		TearDown();
+	}
+}
+#pragma endregion
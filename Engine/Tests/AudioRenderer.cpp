@@ -0,0 +1,266 @@
+#include <cmath>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
+#include <Yonai/World.hpp>
+#include <Yonai/Resource.hpp>
+#include <Yonai/Audio/AudioData.hpp>
+#include <Yonai/Audio/AudioMixer.hpp>
+#include <Yonai/Audio/AudioRenderer.hpp>
+#include <Yonai/Components/Transform.hpp>
+#include <Yonai/Components/AudioSource.hpp>
+#include <Yonai/Systems/Global/AudioSystem.hpp>
+#include <Yonai/Systems/Global/SceneSystem.hpp>
+
+using namespace std;
+using namespace Yonai;
+using namespace Yonai::Systems;
+using namespace Yonai::Components;
+
+namespace fs = std::filesystem;
+
+/// <summary>
+/// Sources playing sine waves, optionally routed through mixers, mixed offline by AudioSystem
+/// </summary>
+class AudioRendererTest : public ::testing::Test
+{
+protected:
+	static constexpr ma_uint32 Channels = 2;
+	static constexpr ma_uint32 SampleRate = 48000;
+
+	struct Source
+	{
+		ma_waveform Waveform;
+		ma_sound Sound;
+	};
+
+	vector<unique_ptr<Source>> m_Sources;
+	vector<unique_ptr<AudioMixer>> m_Mixers;
+
+	void SetUp() override { ASSERT_TRUE(AudioSystem::SetOffline(Channels, SampleRate)); }
+
+	void TearDown() override
+	{
+		for (auto& source : m_Sources)
+		{
+			ma_sound_uninit(&source->Sound);
+			ma_waveform_uninit(&source->Waveform);
+		}
+		m_Sources.clear();
+
+		// Children are released before the mixers they output to
+		while (!m_Mixers.empty())
+			m_Mixers.pop_back();
+	}
+
+	ma_sound* AddSource(double frequency, AudioMixer* mixer = nullptr)
+	{
+		unique_ptr<Source> source = make_unique<Source>();
+		ma_waveform_config config = ma_waveform_config_init(ma_format_f32, Channels, SampleRate, ma_waveform_type_sine, 0.1, frequency);
+		if (ma_waveform_init(&config, &source->Waveform) != MA_SUCCESS ||
+			ma_sound_init_from_data_source(AudioSystem::GetEngine(), &source->Waveform, 0, mixer ? mixer->GetHandle() : nullptr, &source->Sound) != MA_SUCCESS)
+			return nullptr;
+
+		ma_sound_set_looping(&source->Sound, MA_TRUE);
+		ma_sound_set_spatialization_enabled(&source->Sound, MA_FALSE);
+		ma_sound_start(&source->Sound);
+		m_Sources.emplace_back(move(source));
+		return &m_Sources.back()->Sound;
+	}
+};
+
+TEST_F(AudioRendererTest, Offline)
+{
+	EXPECT_TRUE(AudioSystem::IsOffline());
+	EXPECT_EQ(AudioSystem::GetSampleRate(), SampleRate);
+	EXPECT_EQ(AudioSystem::GetRenderer().GetChannels(), Channels);
+}
+
+TEST_F(AudioRendererTest, Silence)
+{
+	vector<float> output;
+	EXPECT_EQ(AudioSystem::Render(output, SampleRate), SampleRate);
+	ASSERT_EQ(output.size(), SampleRate * Channels);
+	for (float sample : output)
+		ASSERT_EQ(sample, 0.0f);
+
+	EXPECT_EQ(AudioSystem::GetRenderer().GetFramesRendered(), SampleRate);
+	EXPECT_EQ(ma_engine_get_time(AudioSystem::GetEngine()), SampleRate);
+}
+
+TEST_F(AudioRendererTest, Deterministic)
+{
+	vector<float> outputs[2];
+	for (vector<float>& output : outputs)
+	{
+		// Same scene, mixed by a new engine
+		ASSERT_TRUE(AudioSystem::SetOffline(Channels, SampleRate));
+		m_Mixers.emplace_back(make_unique<AudioMixer>("Music"));
+		m_Mixers.back()->SetVolume(0.5f);
+		ASSERT_NE(AddSource(440.0, m_Mixers.back().get()), nullptr);
+		ASSERT_NE(AddSource(660.0), nullptr);
+
+		EXPECT_EQ(AudioSystem::Render(output, SampleRate / 2), SampleRate / 2);
+		TearDown();
+	}
+
+	ASSERT_EQ(outputs[0].size(), outputs[1].size());
+	EXPECT_EQ(memcmp(outputs[0].data(), outputs[1].data(), outputs[0].size() * sizeof(float)), 0);
+
+	// Both sources are heard, with the first at half volume
+	float peak = 0.0f;
+	for (float sample : outputs[0])
+		peak = (std::max)(peak, fabs(sample));
+	EXPECT_GT(peak, 0.1f);
+	EXPECT_LE(peak, 0.15f + 0.0001f);
+}
+
+TEST_F(AudioRendererTest, RenderToFile)
+{
+	ASSERT_NE(AddSource(440.0), nullptr);
+
+	fs::path path = fs::temp_directory_path() / "YonaiTest_AudioRenderer.wav";
+	ASSERT_TRUE(AudioSystem::RenderToFile(path.string(), SampleRate));
+
+	ma_decoder decoder;
+	ma_decoder_config config = ma_decoder_config_init(ma_format_f32, 0, 0);
+	ASSERT_EQ(ma_decoder_init_file(path.string().c_str(), &config, &decoder), MA_SUCCESS);
+
+	ma_uint64 length = 0;
+	ma_decoder_get_length_in_pcm_frames(&decoder, &length);
+	EXPECT_EQ(length, SampleRate);
+	ma_uint32 channels = 0, sampleRate = 0;
+	ma_decoder_get_data_format(&decoder, nullptr, &channels, &sampleRate, nullptr, 0);
+	EXPECT_EQ(channels, Channels);
+	EXPECT_EQ(sampleRate, SampleRate);
+
+	vector<float> samples(SampleRate * Channels);
+	ma_uint64 read = 0;
+	ma_decoder_read_pcm_frames(&decoder, samples.data(), SampleRate, &read);
+	ma_decoder_uninit(&decoder);
+	fs::remove(path);
+
+	EXPECT_EQ(read, SampleRate);
+	float peak = 0.0f;
+	for (float sample : samples)
+		peak = (std::max)(peak, fabs(sample));
+	EXPECT_GT(peak, 0.05f);
+}
+
+TEST_F(AudioRendererTest, InvalidDevice)
+{
+	// Offline engine is kept when there is no device to replace it
+	AudioSystem::SetOutputDevice(AudioSystem::GetDeviceCount());
+	EXPECT_TRUE(AudioSystem::IsOffline());
+
+	vector<float> output;
+	EXPECT_EQ(AudioSystem::Render(output, 100), 100u);
+}
+
+/// <returns>16-bit mono WAV file of a sine wave</returns>
+static vector<unsigned char> EncodeSine(ma_uint32 sampleRate, ma_uint32 frames, double frequency)
+{
+	const double Pi = 3.14159265358979;
+	const uint16_t format = 1, channels = 1, bitsPerSample = 16, blockAlign = 2;
+	const uint32_t byteRate = sampleRate * blockAlign, fmtSize = 16, dataSize = frames * blockAlign, riffSize = 36 + dataSize;
+
+	vector<unsigned char> output;
+	auto write = [&](const void* data, size_t size) { output.insert(output.end(), (const unsigned char*)data, (const unsigned char*)data + size); };
+	write("RIFF", 4);
+	write(&riffSize, 4);
+	write("WAVEfmt ", 8);
+	write(&fmtSize, 4);
+	write(&format, 2);
+	write(&channels, 2);
+	write(&sampleRate, 4);
+	write(&byteRate, 4);
+	write(&blockAlign, 2);
+	write(&bitsPerSample, 2);
+	write("data", 4);
+	write(&dataSize, 4);
+	for (ma_uint32 i = 0; i < frames; i++)
+	{
+		int16_t sample = (int16_t)(3000.0 * sin(2.0 * Pi * frequency * i / sampleRate));
+		write(&sample, 2);
+	}
+	return output;
+}
+
+/// <summary>
+/// Measures the time taken each frame to update many AudioSource components, including the command queue and voice manager,
+/// then to mix them through a hierarchy of mixers
+/// </summary>
+TEST_F(AudioRendererTest, DISABLED_MixBenchmark)
+{
+	const unsigned int SourceCounts[] = { 16, 64, 256 };
+	const unsigned int MixerCount = 8;
+	const unsigned int Seconds = 10;
+	const unsigned int UpdatesPerSecond = 60;
+	const ma_uint64 FramesPerUpdate = SampleRate / UpdatesPerSecond;
+
+	// Short enough to be decoded once by the decode cache, and shared by every source
+	ResourceID clip = Resource::Load<AudioData>("AudioRendererTest/Sine.wav", IO::ByteSpan(EncodeSine(SampleRate, SampleRate, 440.0)));
+
+	// Mixers output to a shared master group, like music/SFX/dialog under a master volume
+	ResourceID master = Resource::Load<AudioMixer>("AudioRendererTest/Master", string("Master"));
+	vector<ResourceID> groups;
+	for (unsigned int i = 0; i < MixerCount; i++)
+		groups.emplace_back(Resource::Load<AudioMixer>("AudioRendererTest/Group " + to_string(i), "Group " + to_string(i), master));
+
+	AudioSystem audioSystem;
+	for (unsigned int sourceCount : SourceCounts)
+	{
+		World world;
+		SceneSystem::AddScene(&world);
+
+		vector<Transform*> transforms;
+		for (unsigned int i = 0; i < sourceCount; i++)
+		{
+			Entity entity = world.CreateEntity();
+			Transform* transform = entity.AddComponent<Transform>();
+			transform->SetPosition({ cos(i * 0.1f) * (1.0f + i % 8), 0.0f, sin(i * 0.1f) * (1.0f + i % 8) });
+			transforms.emplace_back(transform);
+
+			AudioSource* source = entity.AddComponent<AudioSource>();
+			source->SetSound(clip);
+			source->SetMixer(groups[i % MixerCount]);
+			source->SetLooping(true);
+			source->Play();
+		}
+
+		AudioRenderer& renderer = AudioSystem::GetRenderer();
+		renderer.ResetStats();
+		vector<float> output;
+		chrono::duration<double, milli> updateDuration(0);
+		for (unsigned int update = 0; update < Seconds * UpdatesPerSecond; update++)
+		{
+			// Some sources move each frame, so their positions are sent to the audio thread
+			for (unsigned int i = update % 4; i < sourceCount; i += 4)
+				transforms[i]->SetPosition(transforms[i]->GetPosition() + glm::vec3(0.0f, 0.001f, 0.0f));
+
+			auto start = chrono::high_resolution_clock::now();
+			audioSystem.Update();
+			updateDuration += chrono::high_resolution_clock::now() - start;
+
+			EXPECT_EQ(AudioSystem::Render(output, FramesPerUpdate), FramesPerUpdate);
+		}
+
+		spdlog::info("{} sources, {} real, {} mixers - {:.3f}ms to update each frame, {:.3f}ms to mix each second of audio, {:.0f}x real time",
+			sourceCount, AudioSystem::GetVoiceManager().GetRealCount(), MixerCount, updateDuration.count() / (Seconds * UpdatesPerSecond),
+			renderer.GetCostPerSecond(), 1000.0 / renderer.GetCostPerSecond());
+
+		SceneSystem::UnloadScene(&world);
+	}
+
+	// Groups are released before the master mixer they output to
+	for (ResourceID group : groups)
+		Resource::Unload(group);
+	Resource::DestroyPending();
+	Resource::Unload(master);
+	Resource::Unload(clip);
+	Resource::DestroyPending();
+}
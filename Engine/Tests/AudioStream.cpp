@@ -0,0 +1,302 @@
+#include <cmath>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
+#include <Yonai/Audio/AudioData.hpp>
+#include <Yonai/Audio/AudioStream.hpp>
+#include <Yonai/IO/PackArchive.hpp>
+
+using namespace std;
+using namespace Yonai;
+
+namespace fs = std::filesystem;
+
+class AudioStreamTest : public ::testing::Test
+{
+protected:
+	fs::path m_Directory;
+
+	static constexpr ma_uint32 Channels = 2;
+	static constexpr ma_uint32 SampleRate = 44100;
+
+	void SetUp() override
+	{
+		m_Directory = fs::temp_directory_path() / "YonaiTest_AudioStream";
+		fs::remove_all(m_Directory);
+		fs::create_directories(m_Directory);
+	}
+
+	void TearDown() override { fs::remove_all(m_Directory); }
+
+	/// <summary>
+	/// Writes a 16-bit stereo WAV file, where every sample is unique within the first 65536 frames
+	/// </summary>
+	string WriteClip(const string& name, ma_uint64 frames)
+	{
+		vector<int16_t> samples(frames * Channels);
+		for (ma_uint64 i = 0; i < frames; i++)
+		{
+			samples[i * Channels + 0] = (int16_t)(i & 0xFFFF);
+			samples[i * Channels + 1] = (int16_t)(-(int)(i & 0x7FFF));
+		}
+
+		const uint32_t dataSize = (uint32_t)(samples.size() * sizeof(int16_t));
+		const uint16_t format = 1, channels = Channels, bitsPerSample = 16, blockAlign = Channels * 2;
+		const uint32_t sampleRate = SampleRate, byteRate = SampleRate * blockAlign, fmtSize = 16, riffSize = 36 + dataSize;
+
+		fs::path path = m_Directory / name;
+		ofstream file(path, ios::binary | ios::trunc);
+		file.write("RIFF", 4);
+		file.write((const char*)&riffSize, 4);
+		file.write("WAVEfmt ", 8);
+		file.write((const char*)&fmtSize, 4);
+		file.write((const char*)&format, 2);
+		file.write((const char*)&channels, 2);
+		file.write((const char*)&sampleRate, 4);
+		file.write((const char*)&byteRate, 4);
+		file.write((const char*)&blockAlign, 2);
+		file.write((const char*)&bitsPerSample, 2);
+		file.write("data", 4);
+		file.write((const char*)&dataSize, 4);
+		file.write((const char*)samples.data(), dataSize);
+		return path.string();
+	}
+
+	/// <summary>
+	/// Decodes an entire clip into memory, as when not streaming
+	/// </summary>
+	static vector<float> DecodeClip(const string& path)
+	{
+		ma_decoder decoder;
+		ma_decoder_config config = ma_decoder_config_init(ma_format_f32, 0, 0);
+		if (ma_decoder_init_file(path.c_str(), &config, &decoder) != MA_SUCCESS)
+			return {};
+
+		ma_uint64 length = 0;
+		ma_decoder_get_length_in_pcm_frames(&decoder, &length);
+		vector<float> output(length * Channels);
+		ma_uint64 read = 0;
+		ma_decoder_read_pcm_frames(&decoder, output.data(), length, &read);
+		output.resize(read * Channels);
+		ma_decoder_uninit(&decoder);
+		return output;
+	}
+
+	/// <summary>
+	/// Reads frames from the stream like the mixer, waiting on the decoding thread instead of underrunning
+	/// </summary>
+	/// <returns>Result of the final read</returns>
+	static ma_result Read(AudioStream& stream, ma_uint64 frameCount, vector<float>& output, ma_uint64 blockFrames = 512)
+	{
+		ma_result result = MA_SUCCESS;
+		vector<float> block(blockFrames * Channels);
+		for (ma_uint64 total = 0; total < frameCount;)
+		{
+			ma_uint64 request = (std::min)(blockFrames, frameCount - total);
+			while (stream.IsSeeking() || (stream.GetBufferedFrames() < request && !stream.IsDecodeFinished()))
+				this_thread::sleep_for(chrono::microseconds(100));
+
+			ma_uint64 read = 0;
+			result = ma_data_source_read_pcm_frames(stream.GetDataSource(), block.data(), request, &read);
+			output.insert(output.end(), block.begin(), block.begin() + read * Channels);
+			total += read;
+			if (result != MA_SUCCESS || read == 0)
+				break;
+		}
+		return result;
+	}
+};
+
+TEST_F(AudioStreamTest, MatchesBufferedDecode)
+{
+	const ma_uint64 Frames = AudioStream::ChunkFrames * AudioStream::BufferedChunks * 3 + 123;
+	string path = WriteClip("Clip.wav", Frames);
+
+	AudioStream stream(path);
+	ASSERT_TRUE(stream.IsValid());
+	EXPECT_EQ(stream.GetLength(), Frames);
+	EXPECT_EQ(stream.GetChannels(), Channels);
+	EXPECT_EQ(stream.GetSampleRate(), SampleRate);
+	EXPECT_NEAR(stream.GetLengthSeconds(), Frames / (float)SampleRate, 0.0001f);
+
+	// Buffer is filled before first read
+	EXPECT_EQ(stream.GetBufferedFrames(), (ma_uint64)AudioStream::ChunkFrames * AudioStream::BufferedChunks);
+
+	vector<float> streamed;
+	EXPECT_EQ(Read(stream, Frames + 1000, streamed), MA_AT_END);
+
+	vector<float> buffered = DecodeClip(path);
+	ASSERT_EQ(streamed.size(), buffered.size());
+	EXPECT_EQ(memcmp(streamed.data(), buffered.data(), buffered.size() * sizeof(float)), 0);
+	EXPECT_TRUE(stream.IsDecodeFinished());
+	EXPECT_EQ(stream.GetUnderrunCount(), 0u);
+}
+
+TEST_F(AudioStreamTest, Seek)
+{
+	const ma_uint64 Frames = SampleRate * 2;
+	const ma_uint64 SeekFrame = 60000;
+	string path = WriteClip("Clip.wav", Frames);
+	vector<float> buffered = DecodeClip(path);
+
+	AudioStream stream(path);
+	ASSERT_TRUE(stream.IsValid());
+
+	vector<float> output;
+	Read(stream, 1000, output);
+
+	ASSERT_EQ(ma_data_source_seek_to_pcm_frame(stream.GetDataSource(), SeekFrame), MA_SUCCESS);
+	ma_uint64 cursor = 0;
+	ma_data_source_get_cursor_in_pcm_frames(stream.GetDataSource(), &cursor);
+	EXPECT_EQ(cursor, SeekFrame);
+
+	output.clear();
+	Read(stream, 2000, output);
+	ASSERT_EQ(output.size(), 2000 * Channels);
+	EXPECT_EQ(memcmp(output.data(), buffered.data() + SeekFrame * Channels, output.size() * sizeof(float)), 0);
+
+	ma_data_source_get_cursor_in_pcm_frames(stream.GetDataSource(), &cursor);
+	EXPECT_EQ(cursor, SeekFrame + 2000);
+}
+
+TEST_F(AudioStreamTest, Looping)
+{
+	const ma_uint64 Frames = AudioStream::ChunkFrames * 3 + 17;
+	string path = WriteClip("Clip.wav", Frames);
+	vector<float> buffered = DecodeClip(path);
+
+	AudioStream stream(path);
+	ASSERT_TRUE(stream.IsValid());
+	ma_data_source_set_looping(stream.GetDataSource(), MA_TRUE);
+
+	// Whole clip fits in the buffer, so decoding reached the end before looping was enabled
+	while (stream.IsDecodeFinished())
+		this_thread::sleep_for(chrono::milliseconds(1));
+
+	vector<float> output;
+	EXPECT_EQ(Read(stream, Frames * 2 + 500, output), MA_SUCCESS);
+	ASSERT_EQ(output.size(), (Frames * 2 + 500) * Channels);
+
+	for (ma_uint64 i = 0; i < Frames * 2 + 500; i++)
+	{
+		ma_uint64 expected = (i % Frames) * Channels;
+		ASSERT_EQ(output[i * Channels], buffered[expected]) << "Frame " << i;
+		ASSERT_EQ(output[i * Channels + 1], buffered[expected + 1]) << "Frame " << i;
+	}
+
+	ma_uint64 cursor = 0;
+	ma_data_source_get_cursor_in_pcm_frames(stream.GetDataSource(), &cursor);
+	EXPECT_EQ(cursor, 500u);
+}
+
+TEST_F(AudioStreamTest, InvalidFile)
+{
+	AudioStream missing((m_Directory / "Missing.wav").string());
+	EXPECT_FALSE(missing.IsValid());
+
+	fs::path path = m_Directory / "Invalid.wav";
+	ofstream(path) << "Not audio";
+	AudioStream invalid(path.string());
+	EXPECT_FALSE(invalid.IsValid());
+}
+
+TEST_F(AudioStreamTest, AudioDataLength)
+{
+	const ma_uint64 Frames = SampleRate * 3 / 2;
+	string path = WriteClip("Clip.wav", Frames);
+
+	AudioData streamed;
+	streamed.ImportStream(path);
+	EXPECT_TRUE(streamed.IsStreaming());
+	EXPECT_NEAR(streamed.GetLength(), 1.5f, 0.0001f);
+
+	ifstream file(path, ios::binary);
+	vector<unsigned char> contents((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+	AudioData buffered(contents);
+	EXPECT_FALSE(buffered.IsStreaming());
+	EXPECT_NEAR(buffered.GetLength(), 1.5f, 0.0001f);
+}
+
+TEST_F(AudioStreamTest, PackStream)
+{
+	const ma_uint64 Frames = AudioStream::ChunkFrames * AudioStream::BufferedChunks * 2 + 123;
+	string path = WriteClip("Clip.wav", Frames);
+
+	// Silence, so LZ4 reduces its size and it is stored compressed
+	ifstream file(path, ios::binary);
+	vector<unsigned char> silent((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+	fill(silent.begin() + 44, silent.end(), 0);
+
+	string packPath = (m_Directory / "Audio.pak").string();
+	IO::PackWriter writer;
+	writer.AddFile("Clip.wav", path);
+	writer.Add("Compressed.wav", silent, IO::PackCompression::LZ4);
+	ASSERT_TRUE(writer.Write(packPath));
+
+	// Decoded straight from the mapped pack
+	IO::PackArchive pack(packPath);
+	const IO::PackEntry* entry = pack.Find("Clip.wav");
+	ASSERT_NE(entry, nullptr);
+	AudioStream stream(pack.GetData(*entry), "Clip.wav");
+	ASSERT_TRUE(stream.IsValid());
+	EXPECT_EQ(stream.GetLength(), Frames);
+
+	vector<float> streamed;
+	EXPECT_EQ(Read(stream, Frames + 1000, streamed), MA_AT_END);
+	vector<float> buffered = DecodeClip(path);
+	ASSERT_EQ(streamed.size(), buffered.size());
+	EXPECT_EQ(memcmp(streamed.data(), buffered.data(), buffered.size() * sizeof(float)), 0);
+
+	AudioData streamedData;
+	streamedData.ImportPackStream(packPath, "Clip.wav");
+	EXPECT_TRUE(streamedData.IsStreaming());
+	EXPECT_NEAR(streamedData.GetLength(), Frames / (float)SampleRate, 0.0001f);
+
+	// Compressed entries are held in memory instead
+	ASSERT_EQ(pack.Find("Compressed.wav")->Compression, IO::PackCompression::LZ4);
+	AudioData compressedData;
+	compressedData.ImportPackStream(packPath, "Compressed.wav");
+	EXPECT_FALSE(compressedData.IsStreaming());
+	EXPECT_NEAR(compressedData.GetLength(), Frames / (float)SampleRate, 0.0001f);
+}
+
+/// <summary>
+/// Compares memory held for a long clip when buffered, against streaming it
+/// </summary>
+TEST_F(AudioStreamTest, DISABLED_MemoryBenchmark)
+{
+	const ma_uint64 Frames = SampleRate * 60;
+	string path = WriteClip("Long.wav", Frames);
+
+	ifstream file(path, ios::binary);
+	vector<unsigned char> contents((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+	AudioData buffered(contents);
+	size_t decodedSize = Frames * Channels * sizeof(float);
+
+	AudioData streamedData;
+	streamedData.ImportStream(path);
+	AudioStream stream(path);
+	ASSERT_TRUE(stream.IsValid());
+	size_t streamedSize = streamedData.GetMemoryUsage() + stream.GetMemoryUsage();
+
+	// Decoding in real time, for the length of the buffer
+	auto start = chrono::high_resolution_clock::now();
+	vector<float> output;
+	Read(stream, Frames, output, 4096);
+	auto duration = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start);
+	EXPECT_EQ(output.size(), Frames * Channels);
+
+	spdlog::info("60 second clip - encoded in memory {:.1f}KB, fully decoded {:.1f}KB, streamed {:.1f}KB. Streamed all frames in {:.1f}ms",
+		buffered.GetMemoryUsage() / 1024.0, decodedSize / 1024.0, streamedSize / 1024.0, duration.count());
+
+	// Independent of clip length
+	EXPECT_LT(streamedSize, 256u * 1024u);
+	EXPECT_LT(streamedSize * 20, buffered.GetMemoryUsage());
+}
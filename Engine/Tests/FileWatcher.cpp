@@ -0,0 +1,225 @@
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fstream>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
+#include <Yonai/IO/FileWatcher.hpp>
+
+using namespace std;
+using namespace Yonai::IO;
+
+namespace fs = std::filesystem;
+
+/// <summary>
+/// Used when inotify is unavailable, so tests do not wait on the default interval
+/// </summary>
+static const int PollInterval = 10;
+
+struct WatchedChange
+{
+	string Path;
+	FileWatchStatus Status;
+	thread::id Thread;
+};
+
+class FileWatcherTest : public ::testing::Test
+{
+protected:
+	fs::path m_Directory;
+	vector<WatchedChange> m_Changes;
+
+	void SetUp() override
+	{
+		m_Directory = fs::temp_directory_path() / "YonaiTest_FileWatcher";
+		fs::remove_all(m_Directory);
+		fs::create_directories(m_Directory / "Nested");
+	}
+
+	void TearDown() override
+	{
+		FileWatcher::ProcessEvents();
+		fs::remove_all(m_Directory);
+	}
+
+	FileWatchCallback Record()
+	{
+		return [this](const string& path, FileWatchStatus status)
+		{
+			m_Changes.push_back({ path, status, this_thread::get_id() });
+		};
+	}
+
+	/// <summary>
+	/// Delivers events until at least <paramref name="count"/> changes were recorded, or the timeout passes
+	/// </summary>
+	void WaitForChanges(size_t count, chrono::milliseconds timeout = chrono::milliseconds(3000))
+	{
+		auto end = chrono::steady_clock::now() + timeout;
+		while (m_Changes.size() < count && chrono::steady_clock::now() < end)
+		{
+			FileWatcher::ProcessEvents();
+			this_thread::sleep_for(chrono::milliseconds(5));
+		}
+
+		// Catch any extra changes that would be delivered with them
+		this_thread::sleep_for(chrono::milliseconds(FileWatcher::CoalesceDelay * 2));
+		FileWatcher::ProcessEvents();
+	}
+
+	const WatchedChange* Find(const fs::path& path)
+	{
+		for (const WatchedChange& change : m_Changes)
+			if (fs::path(change.Path) == path)
+				return &change;
+		return nullptr;
+	}
+
+	static void WriteFile(const fs::path& path, const string& contents)
+	{
+		ofstream file(path, ios::binary | ios::trunc);
+		file << contents;
+	}
+};
+
+TEST_F(FileWatcherTest, DirectoryChanges)
+{
+	WriteFile(m_Directory / "Existing.txt", "A");
+
+	FileWatcher watcher(m_Directory.string(), PollInterval);
+	watcher.Start(Record());
+
+	WriteFile(m_Directory / "Nested" / "Created.txt", "B");
+	WriteFile(m_Directory / "Existing.txt", "Modified");
+	WaitForChanges(2);
+
+	// Polling also reports the modified time of the nested directory changing
+	ASSERT_GE(m_Changes.size(), 2u);
+	const WatchedChange* created = Find(m_Directory / "Nested" / "Created.txt");
+	const WatchedChange* modified = Find(m_Directory / "Existing.txt");
+	ASSERT_NE(created, nullptr);
+	ASSERT_NE(modified, nullptr);
+	EXPECT_EQ(created->Status, FileWatchStatus::Created);
+	EXPECT_EQ(modified->Status, FileWatchStatus::Modified);
+
+	// Callbacks are invoked on the thread processing events
+	for (const WatchedChange& change : m_Changes)
+		EXPECT_EQ(change.Thread, this_thread::get_id());
+
+	m_Changes.clear();
+	fs::remove(m_Directory / "Existing.txt");
+	WaitForChanges(1);
+	ASSERT_EQ(m_Changes.size(), 1u);
+	EXPECT_EQ(m_Changes[0].Status, FileWatchStatus::Removed);
+}
+
+TEST_F(FileWatcherTest, NewDirectoriesAreWatched)
+{
+	FileWatcher watcher(m_Directory.string(), PollInterval);
+	watcher.Start(Record());
+
+	fs::create_directories(m_Directory / "Created");
+	WaitForChanges(1);
+	m_Changes.clear();
+
+	WriteFile(m_Directory / "Created" / "Inner.txt", "A");
+	WaitForChanges(1);
+	const WatchedChange* inner = Find(m_Directory / "Created" / "Inner.txt");
+	ASSERT_NE(inner, nullptr);
+	EXPECT_EQ(inner->Status, FileWatchStatus::Created);
+}
+
+TEST_F(FileWatcherTest, CoalescesChanges)
+{
+	fs::path path = m_Directory / "Assembly.dll";
+	WriteFile(path, "Old");
+
+	FileWatcher watcher(path.string(), PollInterval);
+	watcher.Start(Record());
+
+	// Replaced, then written repeatedly, as a build would
+	fs::remove(path);
+	WriteFile(path, "New");
+	for (int i = 0; i < 20; i++)
+		WriteFile(path, "New " + to_string(i));
+
+	// Unrelated files in the same directory are ignored by file watchers
+	WriteFile(m_Directory / "Other.txt", "A");
+	WaitForChanges(1);
+
+	ASSERT_EQ(m_Changes.size(), 1u);
+	EXPECT_EQ(fs::path(m_Changes[0].Path), path);
+	EXPECT_EQ(m_Changes[0].Status, FileWatchStatus::Modified);
+
+	// Files created and removed before being delivered are never seen
+	m_Changes.clear();
+	FileWatcher directoryWatcher(m_Directory.string(), PollInterval);
+	directoryWatcher.Start(Record());
+	WriteFile(m_Directory / "Temporary.txt", "A");
+	fs::remove(m_Directory / "Temporary.txt");
+	this_thread::sleep_for(chrono::milliseconds(FileWatcher::CoalesceDelay * 3));
+	FileWatcher::ProcessEvents();
+	EXPECT_EQ(m_Changes.size(), 0u);
+}
+
+TEST_F(FileWatcherTest, StoppedWatchersAreNotNotified)
+{
+	FileWatcher first(m_Directory.string(), PollInterval);
+	FileWatcher second(m_Directory.string(), PollInterval);
+	first.Start(Record());
+	second.Start(Record());
+
+	WriteFile(m_Directory / "A.txt", "A");
+	WaitForChanges(2);
+	EXPECT_EQ(m_Changes.size(), 2u);
+
+	// Queued changes of a stopped watcher are discarded
+	m_Changes.clear();
+	WriteFile(m_Directory / "B.txt", "B");
+	this_thread::sleep_for(chrono::milliseconds(FileWatcher::CoalesceDelay * 3));
+	second.Stop();
+	FileWatcher::ProcessEvents();
+	EXPECT_EQ(m_Changes.size(), 1u);
+
+	m_Changes.clear();
+	first.Stop();
+	WriteFile(m_Directory / "C.txt", "C");
+	this_thread::sleep_for(chrono::milliseconds(FileWatcher::CoalesceDelay * 3));
+	FileWatcher::ProcessEvents();
+	EXPECT_EQ(m_Changes.size(), 0u);
+}
+
+TEST_F(FileWatcherTest, DISABLED_LatencyBenchmark)
+{
+	const int DirectoryCount = 50;
+	const int FilesPerDirectory = 100;
+	for (int i = 0; i < DirectoryCount; i++)
+	{
+		fs::path directory = m_Directory / ("Directory" + to_string(i));
+		fs::create_directories(directory);
+		for (int j = 0; j < FilesPerDirectory; j++)
+			WriteFile(directory / (to_string(j) + ".txt"), "A");
+	}
+
+	FileWatcher watcher(m_Directory.string(), PollInterval);
+	watcher.Start(Record());
+	this_thread::sleep_for(chrono::milliseconds(50));
+
+	WriteFile(m_Directory / "Directory25" / "50.txt", "Modified");
+	WaitForChanges(1);
+	ASSERT_EQ(m_Changes.size(), 1u);
+
+	// Time until delivered, without the extra wait of WaitForChanges
+	m_Changes.clear();
+	auto start = chrono::high_resolution_clock::now();
+	WriteFile(m_Directory / "Directory10" / "10.txt", "Modified");
+	while (m_Changes.empty() && chrono::high_resolution_clock::now() - start < chrono::seconds(3))
+		FileWatcher::ProcessEvents();
+	auto duration = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start);
+	ASSERT_EQ(m_Changes.size(), 1u);
+
+	spdlog::info("Change in {} watched files delivered after {:.3f}ms, coalesce delay is {}ms",
+		DirectoryCount * FilesPerDirectory, duration.count(), FileWatcher::CoalesceDelay);
+}
@@ -0,0 +1,108 @@
+#include <regex>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
+#include <Yonai/IO/Files.hpp>
+#include <Yonai/IO/MappedFile.hpp>
+
+using namespace std;
+using namespace Yonai;
+using namespace Yonai::IO;
+
+namespace fs = std::filesystem;
+
+static string GetTestPath(const string& name) { return (fs::temp_directory_path() / ("YonaiTest_" + name)).string(); }
+
+TEST(Files, MappedFile)
+{
+	string path = GetTestPath("Mapped.bin");
+	vector<unsigned char> contents(100000);
+	for (size_t i = 0; i < contents.size(); i++)
+		contents[i] = (unsigned char)(i * 31);
+	IO::Write(path, contents);
+
+	MappedFile file(path);
+	ASSERT_TRUE(file.IsOpen());
+	ASSERT_EQ(file.GetSize(), contents.size());
+	EXPECT_TRUE(equal(contents.begin(), contents.end(), file.GetSpan().begin()));
+
+	ByteSpan span = file;
+	EXPECT_EQ(span.subspan(99990).size(), 10);
+	EXPECT_EQ(span.subspan(5, 2)[1], contents[6]);
+	EXPECT_TRUE(span.subspan(200000).empty());
+
+	// Ownership moves with the mapping
+	MappedFile moved = std::move(file);
+	EXPECT_FALSE(file.IsOpen());
+	EXPECT_EQ(file.GetData(), nullptr);
+	ASSERT_TRUE(moved.IsOpen());
+	EXPECT_EQ(moved.GetData()[1], contents[1]);
+
+	moved.Close();
+	EXPECT_FALSE(moved.IsOpen());
+	EXPECT_EQ(moved.GetSize(), 0);
+	fs::remove(path);
+}
+
+TEST(Files, MappedFileEmptyAndMissing)
+{
+	string path = GetTestPath("Empty.bin");
+	vector<unsigned char> empty;
+	IO::Write(path, empty);
+
+	MappedFile file;
+	EXPECT_TRUE(file.Open(path));
+	EXPECT_TRUE(file.GetSpan().empty());
+	fs::remove(path);
+
+	EXPECT_FALSE(file.Open(GetTestPath("Missing.bin")));
+	EXPECT_FALSE(file.IsOpen());
+}
+
+TEST(Files, NormaliseLineEndings)
+{
+	const string expected = "first\nsecond\n\nlone\rreturn\r";
+	const string source = "first\r\nsecond\r\n\r\nlone\rreturn\r";
+
+	EXPECT_EQ(NormaliseLineEndings(ByteSpan((const unsigned char*)source.data(), source.size())), expected);
+
+	string inPlace = source;
+	NormaliseLineEndings(inPlace);
+	EXPECT_EQ(inPlace, expected);
+
+	EXPECT_EQ(NormaliseLineEndings(ByteSpan()), "");
+
+	string path = GetTestPath("Text.txt");
+	string contents = source;
+	IO::Write(path, contents);
+	EXPECT_EQ(ReadText(path), expected);
+	fs::remove(path);
+}
+
+TEST(Files, DISABLED_ReadTextBenchmark)
+{
+	// Roughly 16MB of CRLF terminated lines, similar to a large JSON scene
+	string contents;
+	while (contents.size() < 16 * 1024 * 1024)
+		contents += "\t\t{ \"Name\": \"Entity\", \"Position\": [ 1.0, 2.0, 3.0 ] },\r\n";
+
+	string path = GetTestPath("Large.json");
+	IO::Write(path, contents);
+
+	auto start = chrono::high_resolution_clock::now();
+	string text = ReadText(path);
+	auto readDuration = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start);
+
+	// Previous implementation, copying the file then replacing with a regex
+	start = chrono::high_resolution_clock::now();
+	vector<unsigned char> data = IO::Read(path);
+	string regexText = regex_replace(string(data.begin(), data.end()), regex("\r\n"), "\n");
+	auto regexDuration = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start);
+
+	spdlog::info("Read {}MB of text in {:.3f}ms, {:.3f}ms with regex", contents.size() / (1024 * 1024), readDuration.count(), regexDuration.count());
+	EXPECT_EQ(text, regexText);
+	fs::remove(path);
+}
@@ -0,0 +1,321 @@
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
+#include <Yonai/IO/ImportCache.hpp>
+#include <Yonai/Graphics/Model.hpp>
+#include <Yonai/Graphics/TextureCooker.hpp>
+
+using namespace std;
+using namespace Yonai::IO;
+using namespace Yonai::Graphics;
+
+namespace fs = std::filesystem;
+
+/// <summary>
+/// Amount of times the test importer has run
+/// </summary>
+static atomic_uint ImportCount = 0;
+
+/// <summary>
+/// Reverses the source, appending flags. Fails when the source begins with '!'.
+/// </summary>
+static bool TestImporter(ByteSpan source, const string& extension, uint32_t flags, vector<unsigned char>& output)
+{
+	ImportCount++;
+	if (!source.empty() && source[0] == '!')
+		return false;
+
+	output.assign(source.begin(), source.end());
+	reverse(output.begin(), output.end());
+	output.push_back((unsigned char)flags);
+	return true;
+}
+
+class ImportCacheTest : public ::testing::Test
+{
+protected:
+	fs::path m_Directory;
+
+	void SetUp() override
+	{
+		m_Directory = fs::temp_directory_path() / "YonaiTest_ImportCache";
+		fs::remove_all(m_Directory);
+		fs::create_directories(m_Directory / "Sources");
+
+		ImportCache::SetDirectory((m_Directory / "Cache").string());
+		ImportCache::RegisterImporter("Test", 1, TestImporter);
+		ImportCount = 0;
+	}
+
+	void TearDown() override
+	{
+		ImportCache::UnregisterImporter("Test");
+		ImportCache::SetDirectory((m_Directory / "Unused").string());
+		fs::remove_all(m_Directory);
+	}
+
+	string WriteSource(const string& name, const string& contents)
+	{
+		fs::path path = m_Directory / "Sources" / name;
+		ofstream file(path, ios::binary | ios::trunc);
+		file << contents;
+		return path.string();
+	}
+
+	static string ToString(const vector<unsigned char>& data) { return string(data.begin(), data.end()); }
+};
+
+TEST_F(ImportCacheTest, KeyChangesWithInputs)
+{
+	const uint64_t original = ImportCache::GetKey("Test", 1, 1234, ".png", 0);
+
+	EXPECT_EQ(ImportCache::GetKey("Test", 1, 1234, ".png", 0), original);
+	EXPECT_NE(ImportCache::GetKey("Other", 1, 1234, ".png", 0), original);
+	EXPECT_NE(ImportCache::GetKey("Test", 2, 1234, ".png", 0), original);
+	EXPECT_NE(ImportCache::GetKey("Test", 1, 1235, ".png", 0), original);
+	EXPECT_NE(ImportCache::GetKey("Test", 1, 1234, ".jpg", 0), original);
+	EXPECT_NE(ImportCache::GetKey("Test", 1, 1234, ".png", 1), original);
+}
+
+TEST_F(ImportCacheTest, ImportsOnce)
+{
+	string path = WriteSource("A.txt", "abc");
+
+	vector<unsigned char> output;
+	bool fromCache = true;
+	ASSERT_TRUE(ImportCache::Import("Test", path, 7, output, &fromCache));
+	EXPECT_FALSE(fromCache);
+	EXPECT_EQ(ToString(output), "cba\x07");
+	EXPECT_EQ(ImportCount, 1u);
+	EXPECT_TRUE(ImportCache::IsCached("Test", path, 7));
+
+	output.clear();
+	ASSERT_TRUE(ImportCache::Import("Test", path, 7, output, &fromCache));
+	EXPECT_TRUE(fromCache);
+	EXPECT_EQ(ToString(output), "cba\x07");
+	EXPECT_EQ(ImportCount, 1u);
+
+	// Data already in memory shares entries with files of the same contents
+	ASSERT_TRUE(ImportCache::Import("Test", vector<unsigned char>{ 'a', 'b', 'c' }, ".TXT", 7, output, &fromCache));
+	EXPECT_TRUE(fromCache);
+	EXPECT_EQ(ImportCount, 1u);
+}
+
+TEST_F(ImportCacheTest, ReimportsWhenInputsChange)
+{
+	string path = WriteSource("A.txt", "abc");
+
+	vector<unsigned char> output;
+	ASSERT_TRUE(ImportCache::Import("Test", path, 0, output));
+	EXPECT_EQ(ImportCount, 1u);
+
+	// Import settings
+	EXPECT_FALSE(ImportCache::IsCached("Test", path, 1));
+	ASSERT_TRUE(ImportCache::Import("Test", path, 1, output));
+	EXPECT_EQ(ImportCount, 2u);
+
+	// Importer version
+	ImportCache::RegisterImporter("Test", 2, TestImporter);
+	EXPECT_FALSE(ImportCache::IsCached("Test", path, 0));
+	ASSERT_TRUE(ImportCache::Import("Test", path, 0, output));
+	EXPECT_EQ(ImportCount, 3u);
+
+	// Source contents, with a different size so it is detected regardless of timestamp resolution
+	WriteSource("A.txt", "abcd");
+	EXPECT_FALSE(ImportCache::IsCached("Test", path, 0));
+	ASSERT_TRUE(ImportCache::Import("Test", path, 0, output));
+	EXPECT_EQ(ToString(output), string("dcba") + '\0');
+	EXPECT_EQ(ImportCount, 4u);
+
+	// Reverting to previously imported contents is already cached
+	WriteSource("A.txt", "ab");
+	ASSERT_TRUE(ImportCache::Import("Test", path, 0, output));
+	WriteSource("A.txt", "abcd");
+	bool fromCache = false;
+	ASSERT_TRUE(ImportCache::Import("Test", path, 0, output, &fromCache));
+	EXPECT_TRUE(fromCache);
+	EXPECT_EQ(ImportCount, 5u);
+}
+
+TEST_F(ImportCacheTest, IdenticalSourcesShareEntries)
+{
+	string first = WriteSource("A.txt", "abc");
+	string second = WriteSource("B.txt", "abc");
+	string differentExtension = WriteSource("C.bin", "abc");
+
+	vector<unsigned char> output;
+	ASSERT_TRUE(ImportCache::Import("Test", first, 0, output));
+	EXPECT_TRUE(ImportCache::IsCached("Test", second, 0));
+	EXPECT_FALSE(ImportCache::IsCached("Test", differentExtension, 0));
+	ASSERT_TRUE(ImportCache::Import("Test", second, 0, output));
+	EXPECT_EQ(ImportCount, 1u);
+}
+
+TEST_F(ImportCacheTest, PersistsBetweenSessions)
+{
+	string path = WriteSource("A.txt", "abc");
+
+	vector<unsigned char> output;
+	ASSERT_TRUE(ImportCache::Import("Test", path, 0, output));
+	ImportCache::Flush();
+	EXPECT_TRUE(fs::exists(m_Directory / "Cache" / "Sources.bin"));
+
+	// Changing directory discards everything remembered in memory
+	string directory = ImportCache::GetDirectory();
+	ImportCache::SetDirectory((m_Directory / "Other").string());
+	EXPECT_FALSE(ImportCache::IsCached("Test", path, 0));
+	ImportCache::SetDirectory(directory);
+
+	bool fromCache = false;
+	ASSERT_TRUE(ImportCache::Import("Test", path, 0, output, &fromCache));
+	EXPECT_TRUE(fromCache);
+	EXPECT_EQ(ImportCount, 1u);
+
+	ImportCache::Clear();
+	EXPECT_FALSE(fs::exists(m_Directory / "Cache"));
+	EXPECT_FALSE(ImportCache::IsCached("Test", path, 0));
+}
+
+TEST_F(ImportCacheTest, ReplacesInvalidEntries)
+{
+	string path = WriteSource("A.txt", "abc");
+
+	vector<unsigned char> output;
+	ASSERT_TRUE(ImportCache::Import("Test", path, 0, output));
+
+	// Truncate the only entry
+	fs::path entry;
+	for (const auto& file : fs::directory_iterator(m_Directory / "Cache" / "Test"))
+		entry = file.path();
+	ASSERT_FALSE(entry.empty());
+	fs::resize_file(entry, fs::file_size(entry) - 1);
+
+	bool fromCache = true;
+	ASSERT_TRUE(ImportCache::Import("Test", path, 0, output, &fromCache));
+	EXPECT_FALSE(fromCache);
+	EXPECT_EQ(ToString(output), string("cba") + '\0');
+	EXPECT_EQ(ImportCount, 2u);
+
+	ASSERT_TRUE(ImportCache::Import("Test", path, 0, output, &fromCache));
+	EXPECT_TRUE(fromCache);
+}
+
+TEST_F(ImportCacheTest, FailedImports)
+{
+	string path = WriteSource("A.txt", "!abc");
+
+	// Output is the unmodified source, and is not cached
+	vector<unsigned char> output;
+	EXPECT_FALSE(ImportCache::Import("Test", path, 0, output));
+	EXPECT_EQ(ToString(output), "!abc");
+	EXPECT_FALSE(ImportCache::IsCached("Test", path, 0));
+
+	EXPECT_FALSE(ImportCache::Import("Test", (m_Directory / "Missing.txt").string(), 0, output));
+	EXPECT_FALSE(ImportCache::Import("Unregistered", WriteSource("B.txt", "abc"), 0, output));
+}
+
+TEST_F(ImportCacheTest, Disabled)
+{
+	string path = WriteSource("A.txt", "abc");
+
+	ImportCache::SetEnabled(false);
+	vector<unsigned char> output;
+	ASSERT_TRUE(ImportCache::Import("Test", path, 0, output));
+	ASSERT_TRUE(ImportCache::Import("Test", path, 0, output));
+	EXPECT_FALSE(ImportCache::IsCached("Test", path, 0));
+	ImportCache::SetEnabled(true);
+
+	EXPECT_EQ(ImportCount, 2u);
+	EXPECT_FALSE(fs::exists(m_Directory / "Cache" / "Test"));
+}
+
+/// <summary>
+/// Greyscale PGM image with a gradient offset by seed
+/// </summary>
+static string CreateTestImage(unsigned int size, unsigned int seed)
+{
+	string image = "P5 " + to_string(size) + " " + to_string(size) + " 255\n";
+	for (unsigned int y = 0; y < size; y++)
+		for (unsigned int x = 0; x < size; x++)
+			image += (char)((x + y * seed) & 0xFF);
+	return image;
+}
+
+/// <summary>
+/// Wavefront OBJ grid of quads, raised by seed
+/// </summary>
+static string CreateTestModel(unsigned int gridSize, unsigned int seed)
+{
+	string model;
+	for (unsigned int y = 0; y <= gridSize; y++)
+		for (unsigned int x = 0; x <= gridSize; x++)
+			model += "v " + to_string(x) + " " + to_string((x * y + seed) % 7) + " " + to_string(y) + "\n";
+	for (unsigned int y = 0; y < gridSize; y++)
+		for (unsigned int x = 0; x < gridSize; x++)
+		{
+			unsigned int i = y * (gridSize + 1) + x + 1;
+			model += "f " + to_string(i) + " " + to_string(i + 1) + " " + to_string(i + gridSize + 2) + " " + to_string(i + gridSize + 1) + "\n";
+		}
+	return model;
+}
+
+/// <summary>
+/// Compares importing textures and models serially against warming the cache in parallel, then loading from the warm cache
+/// </summary>
+TEST_F(ImportCacheTest, DISABLED_WarmBenchmark)
+{
+	const unsigned int TextureCount = 64;
+	const unsigned int TextureSize = 512;
+	const unsigned int ModelCount = 16;
+	const unsigned int ModelGridSize = 64;
+
+	vector<ImportCacheJob> jobs;
+	for (unsigned int i = 0; i < TextureCount; i++)
+		jobs.push_back({ "Texture", WriteSource(to_string(i) + ".pgm", CreateTestImage(TextureSize, i + 1)), TextureCookSettings().GetFlags() });
+	for (unsigned int i = 0; i < ModelCount; i++)
+		jobs.push_back({ "Model", WriteSource(to_string(i) + ".obj", CreateTestModel(ModelGridSize, i)), Model::GetImportFlags(true, 2) });
+
+	// Every source imported one after another, without the cache
+	ImportCache::SetEnabled(false);
+	vector<unsigned char> output;
+	auto start = chrono::high_resolution_clock::now();
+	for (const ImportCacheJob& job : jobs)
+		ASSERT_TRUE(ImportCache::Import(job.Importer, job.SourcePath, job.Flags, output));
+	auto serialDuration = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start);
+	ImportCache::SetEnabled(true);
+
+	start = chrono::high_resolution_clock::now();
+	ImportCacheWarmResult result = ImportCache::Warm(jobs, thread::hardware_concurrency());
+	auto warmDuration = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start);
+	EXPECT_EQ(result.Failed, 0u);
+	EXPECT_EQ(result.Imported, jobs.size());
+
+	// Loading every source from the warm cache, as a fresh session would
+	ImportCache::Flush();
+	string directory = ImportCache::GetDirectory();
+	ImportCache::SetDirectory((m_Directory / "Other").string());
+	ImportCache::SetDirectory(directory);
+
+	start = chrono::high_resolution_clock::now();
+	for (const ImportCacheJob& job : jobs)
+	{
+		bool fromCache = false;
+		ASSERT_TRUE(ImportCache::Import(job.Importer, job.SourcePath, job.Flags, output, &fromCache));
+		ASSERT_TRUE(fromCache) << job.SourcePath;
+	}
+	auto cachedDuration = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start);
+
+	spdlog::info("{} textures and {} models - importing serially {:.1f}ms, warming in parallel {:.1f}ms, loading from cache {:.1f}ms",
+		TextureCount, ModelCount, serialDuration.count(), warmDuration.count(), cachedDuration.count());
+
+	if (thread::hardware_concurrency() > 1)
+		EXPECT_LT(warmDuration.count(), serialDuration.count());
+	EXPECT_LT(cachedDuration.count(), serialDuration.count());
+}
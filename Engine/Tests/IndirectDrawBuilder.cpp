@@ -0,0 +1,110 @@
+#include <glm/glm.hpp>
+#include <gtest/gtest.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <Yonai/Graphics/IndirectDrawBuilder.hpp>
+
+using namespace Yonai;
+using namespace Yonai::Graphics;
+
+static MeshArena::Allocation CreateAllocation(unsigned int baseVertex, unsigned int firstIndex, unsigned int indexCount)
+{
+	MeshArena::Allocation allocation;
+	allocation.BaseVertex = baseVertex;
+	allocation.VertexCount = indexCount;
+	allocation.FirstIndex = firstIndex;
+	allocation.IndexCount = indexCount;
+	allocation.IsValid = true;
+	return allocation;
+}
+
+TEST(IndirectDrawBuilder, CommandGeneration)
+{
+	IndirectDrawBuilder builder;
+	builder.Begin();
+
+	glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(1, 2, 3));
+	EXPECT_TRUE(builder.Submit(nullptr, CreateAllocation(100, 300, 36), ResourceID(1), ResourceID(2), model));
+	builder.End();
+
+	auto& commands = builder.GetCommands();
+	ASSERT_EQ(commands.size(), 1);
+	EXPECT_EQ(commands[0].Count, 36);
+	EXPECT_EQ(commands[0].InstanceCount, 1);
+	EXPECT_EQ(commands[0].FirstIndex, 300);
+	EXPECT_EQ(commands[0].BaseVertex, 100);
+	EXPECT_EQ(commands[0].BaseInstance, 0);
+
+	auto& drawData = builder.GetDrawData();
+	ASSERT_EQ(drawData.size(), 1);
+	EXPECT_EQ(drawData[0].ModelMatrix, model);
+	EXPECT_EQ(drawData[0].MaterialIndex, 0);
+
+	// Layout must match std430 struct in DrawData.inc
+	EXPECT_EQ(sizeof(IndirectDrawBuilder::DrawElementsIndirectCommand), 5 * sizeof(unsigned int));
+	EXPECT_EQ(sizeof(IndirectDrawBuilder::DrawData) % 16, 0);
+}
+
+TEST(IndirectDrawBuilder, GroupByShaderAndMaterial)
+{
+	const ResourceID ShaderA = 1, ShaderB = 2;
+	const ResourceID Material1 = 10, Material2 = 20, Material3 = 30;
+
+	IndirectDrawBuilder builder;
+	builder.Begin();
+	builder.Submit(nullptr, CreateAllocation(0, 0, 3), ShaderB, Material3, glm::mat4(1.0f));
+	builder.Submit(nullptr, CreateAllocation(3, 3, 3), ShaderA, Material2, glm::mat4(1.0f));
+	builder.Submit(nullptr, CreateAllocation(6, 6, 3), ShaderA, Material1, glm::mat4(1.0f));
+	builder.Submit(nullptr, CreateAllocation(9, 9, 3), ShaderB, Material3, glm::mat4(1.0f));
+	builder.Submit(nullptr, CreateAllocation(12, 12, 3), ShaderA, Material2, glm::mat4(1.0f));
+	builder.End();
+
+	EXPECT_EQ(builder.GetDrawCount(), 5);
+
+	auto& groups = builder.GetGroups();
+	ASSERT_EQ(groups.size(), 3);
+
+	EXPECT_EQ(groups[0].Shader, ShaderA);
+	EXPECT_EQ(groups[0].Material, Material1);
+	EXPECT_EQ(groups[0].FirstCommand, 0);
+	EXPECT_EQ(groups[0].CommandCount, 1);
+
+	EXPECT_EQ(groups[1].Shader, ShaderA);
+	EXPECT_EQ(groups[1].Material, Material2);
+	EXPECT_EQ(groups[1].FirstCommand, 1);
+	EXPECT_EQ(groups[1].CommandCount, 2);
+
+	EXPECT_EQ(groups[2].Shader, ShaderB);
+	EXPECT_EQ(groups[2].FirstCommand, 3);
+	EXPECT_EQ(groups[2].CommandCount, 2);
+
+	// Submission order kept within a group
+	auto& commands = builder.GetCommands();
+	EXPECT_EQ(commands[1].BaseVertex, 3);
+	EXPECT_EQ(commands[2].BaseVertex, 12);
+
+	// Base instance indexes draw data, material index in to material list
+	auto& drawData = builder.GetDrawData();
+	for (unsigned int i = 0; i < (unsigned int)commands.size(); i++)
+		EXPECT_EQ(commands[i].BaseInstance, i);
+
+	ASSERT_EQ(builder.GetMaterials().size(), 3);
+	EXPECT_EQ(builder.GetMaterials()[drawData[0].MaterialIndex], Material1);
+	EXPECT_EQ(builder.GetMaterials()[drawData[2].MaterialIndex], Material2);
+	EXPECT_EQ(builder.GetMaterials()[drawData[4].MaterialIndex], Material3);
+}
+
+TEST(IndirectDrawBuilder, RejectsNonIndexedDraws)
+{
+	IndirectDrawBuilder builder;
+	builder.Begin();
+
+	MeshArena::Allocation arrays = CreateAllocation(0, 0, 0);
+	arrays.VertexCount = 36;
+	EXPECT_FALSE(builder.Submit(nullptr, arrays, ResourceID(1), ResourceID(2), glm::mat4(1.0f)));
+	EXPECT_FALSE(builder.Submit(nullptr, MeshArena::Allocation(), ResourceID(1), ResourceID(2), glm::mat4(1.0f)));
+
+	builder.End();
+	EXPECT_EQ(builder.GetDrawCount(), 0);
+	EXPECT_TRUE(builder.GetCommands().empty());
+	EXPECT_TRUE(builder.GetGroups().empty());
+}
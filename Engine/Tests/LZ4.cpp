@@ -0,0 +1,67 @@
+#include <random>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <Yonai/IO/LZ4.hpp>
+
+using namespace std;
+using namespace Yonai::IO;
+
+static vector<unsigned char> RoundTrip(const vector<unsigned char>& input)
+{
+	vector<unsigned char> compressed;
+	LZ4::Compress(input, compressed);
+	EXPECT_LE(compressed.size(), LZ4::GetMaxCompressedSize(input.size()));
+
+	vector<unsigned char> output(input.size());
+	EXPECT_TRUE(LZ4::Decompress(compressed, output.data(), output.size()));
+	EXPECT_EQ(output, input);
+	return compressed;
+}
+
+TEST(LZ4, RoundTrip)
+{
+	RoundTrip({});
+	RoundTrip({ 1 });
+	RoundTrip({ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13 });
+
+	// Repetitive data compresses well, including matches overlapping their own output
+	vector<unsigned char> repeated(100000, 7);
+	EXPECT_LT(RoundTrip(repeated).size(), repeated.size() / 100);
+
+	string text;
+	for (int i = 0; i < 2000; i++)
+		text += "{ \"Name\": \"Entity " + to_string(i % 50) + "\", \"Enabled\": true },\n";
+	vector<unsigned char> textData(text.begin(), text.end());
+	EXPECT_LT(RoundTrip(textData).size(), textData.size() / 4);
+
+	// Random data does not compress, and must not grow beyond the bound
+	mt19937 random(1234);
+	vector<unsigned char> noise(65536 * 3);
+	for (unsigned char& value : noise)
+		value = (unsigned char)random();
+	RoundTrip(noise);
+}
+
+TEST(LZ4, RejectInvalidData)
+{
+	vector<unsigned char> input(10000);
+	for (size_t i = 0; i < input.size(); i++)
+		input[i] = (unsigned char)(i % 37);
+
+	vector<unsigned char> compressed;
+	LZ4::Compress(input, compressed);
+
+	vector<unsigned char> output(input.size());
+	EXPECT_FALSE(LZ4::Decompress(compressed, output.data(), output.size() - 1));
+	output.resize(input.size() + 1);
+	EXPECT_FALSE(LZ4::Decompress(compressed, output.data(), output.size()));
+
+	// Truncated
+	vector<unsigned char> truncated(compressed.begin(), compressed.begin() + compressed.size() / 2);
+	EXPECT_FALSE(LZ4::Decompress(truncated, output.data(), input.size()));
+
+	// Offset before start of output
+	vector<unsigned char> badOffset = { 0x10, 'a', 0xFF, 0x00 };
+	EXPECT_FALSE(LZ4::Decompress(badOffset, output.data(), 10));
+}
@@ -0,0 +1,173 @@
+#include <chrono>
+#include <random>
+#include <glm/glm.hpp>
+#include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <Yonai/Graphics/LightClusters.hpp>
+
+using namespace glm;
+using namespace std;
+using namespace Yonai::Graphics;
+
+const float TestNear = 0.1f;
+const float TestFar = 100.0f;
+
+static mat4 TestProjection() { return perspective(radians(60.0f), 16.0f / 9.0f, TestNear, TestFar); }
+
+static LightClusters::LightData CreateLight(vec3 position, float radius)
+{
+	return LightClusters::LightData { vec4(position, radius), vec4(1.0f) };
+}
+
+static vector<LightClusters::LightData> CreateRandomLights(unsigned int count, unsigned int seed = 1234)
+{
+	mt19937 random(seed);
+	uniform_real_distribution<float> xy(-50.0f, 50.0f);
+	uniform_real_distribution<float> depth(-TestFar, 10.0f);
+	uniform_real_distribution<float> radius(0.5f, 8.0f);
+
+	vector<LightClusters::LightData> lights;
+	lights.reserve(count);
+	for (unsigned int i = 0; i < count; i++)
+		lights.emplace_back(CreateLight({ xy(random), xy(random), depth(random) }, radius(random)));
+	return lights;
+}
+
+/// <summary>
+/// Finds the cluster containing a view space point, the same way as ClusteredLights.inc
+/// </summary>
+static uvec3 GetPointCluster(LightClusters& clusters, vec3 viewPosition)
+{
+	uvec3 gridSize = clusters.GetGridSize();
+	vec4 clip = TestProjection() * vec4(viewPosition, 1.0f);
+	vec2 screen = (vec2(clip) / clip.w) * 0.5f + 0.5f;
+
+	float depth = -viewPosition.z;
+	unsigned int slice = (unsigned int)std::floor(std::log(depth / TestNear) / std::log(TestFar / TestNear) * gridSize.z);
+
+	return uvec3(
+		std::min((unsigned int)(screen.x * gridSize.x), gridSize.x - 1),
+		std::min((unsigned int)(screen.y * gridSize.y), gridSize.y - 1),
+		std::min(slice, gridSize.z - 1)
+	);
+}
+
+TEST(LightClusters, SingleLight)
+{
+	LightClusters clusters;
+	clusters.Build(mat4(1.0f), TestProjection(), TestNear, TestFar, false, { CreateLight({ 0, 0, -10 }, 1.0f) });
+
+	// Cluster at light's centre
+	uvec3 centre = GetPointCluster(clusters, { 0, 0, -10 });
+	vector<unsigned int> lights = clusters.GetClusterLights(centre);
+	ASSERT_EQ(lights.size(), 1);
+	EXPECT_EQ(lights[0], 0);
+
+	// Clusters far away from the light
+	EXPECT_TRUE(clusters.GetClusterLights(GetPointCluster(clusters, { 0, 0, -50 })).empty());
+	EXPECT_TRUE(clusters.GetClusterLights(uvec3(0, 0, centre.z)).empty());
+
+	// Light only covers a few clusters
+	EXPECT_GT(clusters.GetLightIndices().size(), 0);
+	EXPECT_LT(clusters.GetLightIndices().size(), 64);
+}
+
+TEST(LightClusters, CullsLightsOutsideFrustum)
+{
+	LightClusters clusters;
+	clusters.Build(mat4(1.0f), TestProjection(), TestNear, TestFar, false,
+		{
+			CreateLight({ 0, 0, 10 }, 2.0f),	// Behind camera
+			CreateLight({ 0, 0, -200 }, 5.0f),	// Past far plane
+			CreateLight({ 500, 0, -10 }, 5.0f)	// Off to the side
+		});
+
+	EXPECT_TRUE(clusters.GetLightIndices().empty());
+	for (auto& cluster : clusters.GetClusters())
+		EXPECT_EQ(cluster.Count, 0);
+}
+
+TEST(LightClusters, ViewMatrixApplied)
+{
+	// Camera at (100, 0, 0), looking down -Z
+	mat4 view = lookAt(vec3(100, 0, 0), vec3(100, 0, -1), vec3(0, 1, 0));
+
+	LightClusters clusters;
+	clusters.Build(view, TestProjection(), TestNear, TestFar, false,
+		{
+			CreateLight({ 0, 0, -10 }, 1.0f),	// Visible without view matrix, now off screen
+			CreateLight({ 100, 0, -10 }, 1.0f)	// Directly in front of camera
+		});
+
+	vector<unsigned int> lights = clusters.GetClusterLights(GetPointCluster(clusters, { 0, 0, -10 }));
+	ASSERT_EQ(lights.size(), 1);
+	EXPECT_EQ(lights[0], 1);
+}
+
+TEST(LightClusters, ConservativeBinning)
+{
+	vector<LightClusters::LightData> lights = CreateRandomLights(500);
+
+	LightClusters clusters;
+	clusters.Build(mat4(1.0f), TestProjection(), TestNear, TestFar, false, lights);
+
+	// Every light touching a point must be in the point's cluster
+	mt19937 random(5678);
+	uniform_real_distribution<float> screen(-0.99f, 0.99f);
+	uniform_real_distribution<float> depth(TestNear * 1.01f, TestFar * 0.99f);
+	mat4 inverseProjection = inverse(TestProjection());
+
+	for (unsigned int i = 0; i < 2000; i++)
+	{
+		vec4 nearPoint = inverseProjection * vec4(screen(random), screen(random), -1.0f, 1.0f);
+		nearPoint /= nearPoint.w;
+		vec3 point = vec3(nearPoint) * (depth(random) / -nearPoint.z);
+
+		vector<unsigned int> clusterLights = clusters.GetClusterLights(GetPointCluster(clusters, point));
+		for (unsigned int lightIndex = 0; lightIndex < (unsigned int)lights.size(); lightIndex++)
+		{
+			vec3 offset = vec3(lights[lightIndex].PositionRadius) - point;
+			if (length(offset) >= lights[lightIndex].PositionRadius.w)
+				continue;
+
+			EXPECT_NE(find(clusterLights.begin(), clusterLights.end(), lightIndex), clusterLights.end())
+				<< "Light " << lightIndex << " missing from cluster";
+		}
+	}
+}
+
+TEST(LightClusters, ClusterListsAreContiguous)
+{
+	LightClusters clusters(uvec3(8, 4, 8));
+	clusters.Build(mat4(1.0f), TestProjection(), TestNear, TestFar, false, CreateRandomLights(200));
+
+	auto& clusterList = clusters.GetClusters();
+	ASSERT_EQ(clusterList.size(), 8 * 4 * 8);
+
+	unsigned int expectedOffset = 0;
+	for (auto& cluster : clusterList)
+	{
+		EXPECT_EQ(cluster.Offset, expectedOffset);
+		expectedOffset += cluster.Count;
+	}
+	EXPECT_EQ(expectedOffset, clusters.GetLightIndices().size());
+}
+
+TEST(LightClusters, DISABLED_BenchmarkBinning)
+{
+	LightClusters clusters;
+	for (unsigned int lightCount : { 1000u, 5000u, 10000u })
+	{
+		vector<LightClusters::LightData> lights = CreateRandomLights(lightCount);
+
+		const unsigned int Iterations = 10;
+		auto start = chrono::high_resolution_clock::now();
+		for (unsigned int i = 0; i < Iterations; i++)
+			clusters.Build(mat4(1.0f), TestProjection(), TestNear, TestFar, false, lights);
+		auto duration = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start) / Iterations;
+
+		spdlog::info("Binned {} lights in {:.3f}ms ({} cluster entries)", lightCount, duration.count(), clusters.GetLightIndices().size());
+		EXPECT_EQ(clusters.GetLights().size(), lightCount);
+	}
+}
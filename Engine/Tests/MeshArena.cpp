@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include <Yonai/Graphics/MeshArena.hpp>
+
+using namespace Yonai::Graphics;
+
+TEST(MeshArena, RangeAllocation)
+{
+	RangeAllocator allocator(100);
+
+	unsigned int a = allocator.Allocate(10);
+	unsigned int b = allocator.Allocate(20);
+	unsigned int c = allocator.Allocate(30);
+
+	EXPECT_EQ(a, 0);
+	EXPECT_EQ(b, 10);
+	EXPECT_EQ(c, 30);
+	EXPECT_EQ(allocator.GetUsed(), 60);
+	EXPECT_EQ(allocator.GetLargestFreeBlock(), 40);
+
+	// Too large for remaining space
+	EXPECT_EQ(allocator.Allocate(50), RangeAllocator::InvalidOffset);
+	EXPECT_EQ(allocator.Allocate(0), RangeAllocator::InvalidOffset);
+}
+
+TEST(MeshArena, RangeFreeCoalesces)
+{
+	RangeAllocator allocator(100);
+
+	unsigned int a = allocator.Allocate(10);
+	unsigned int b = allocator.Allocate(10);
+	unsigned int c = allocator.Allocate(10);
+	allocator.Allocate(70);
+	EXPECT_EQ(allocator.GetFreeBlockCount(), 0);
+
+	allocator.Free(a);
+	allocator.Free(c);
+	EXPECT_EQ(allocator.GetFreeBlockCount(), 2);
+
+	// Freeing middle block joins both neighbours
+	allocator.Free(b);
+	EXPECT_EQ(allocator.GetFreeBlockCount(), 1);
+	EXPECT_EQ(allocator.GetLargestFreeBlock(), 30);
+
+	// First fit reuses start of buffer
+	EXPECT_EQ(allocator.Allocate(25), 0);
+}
+
+TEST(MeshArena, RangeGrow)
+{
+	RangeAllocator allocator(10);
+	allocator.Allocate(5);
+
+	allocator.Grow(20);
+	EXPECT_EQ(allocator.GetCapacity(), 20);
+
+	// Trailing free space merges with new space
+	EXPECT_EQ(allocator.GetFreeBlockCount(), 1);
+	EXPECT_EQ(allocator.Allocate(15), 5);
+}
+
+TEST(MeshArena, RangeCompact)
+{
+	RangeAllocator allocator(100);
+
+	unsigned int a = allocator.Allocate(10);
+	unsigned int b = allocator.Allocate(20);
+	unsigned int c = allocator.Allocate(30);
+	unsigned int d = allocator.Allocate(5);
+
+	allocator.Free(a);
+	allocator.Free(c);
+
+	auto moves = allocator.Compact();
+	ASSERT_EQ(moves.size(), 2);
+
+	EXPECT_EQ(moves[0].From, b);
+	EXPECT_EQ(moves[0].To, 0);
+	EXPECT_EQ(moves[0].Size, 20);
+
+	EXPECT_EQ(moves[1].From, d);
+	EXPECT_EQ(moves[1].To, 20);
+	EXPECT_EQ(moves[1].Size, 5);
+
+	EXPECT_EQ(allocator.GetUsed(), 25);
+	EXPECT_EQ(allocator.GetFreeBlockCount(), 1);
+	EXPECT_EQ(allocator.GetLargestFreeBlock(), 75);
+	EXPECT_EQ(allocator.GetSize(0), 20);
+	EXPECT_EQ(allocator.GetSize(20), 5);
+
+	// Old offsets are no longer allocated
+	EXPECT_EQ(allocator.GetSize(d), 0);
+}
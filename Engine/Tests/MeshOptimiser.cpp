@@ -0,0 +1,314 @@
+#include <chrono>
+#include <random>
+#include <limits>
+#include <vector>
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
+#include <Yonai/Graphics/MeshOptimiser.hpp>
+
+using namespace glm;
+using namespace std;
+using namespace Yonai::Graphics;
+
+/// <summary>
+/// Flat grid of quads, with triangles in a random order
+/// </summary>
+static void CreateShuffledGrid(unsigned int gridSize, vector<Mesh::Vertex>& vertices, vector<unsigned int>& indices)
+{
+	vertices.clear();
+	for (unsigned int y = 0; y <= gridSize; y++)
+		for (unsigned int x = 0; x <= gridSize; x++)
+			vertices.push_back({ { (float)x, 0, (float)y }, { 0, 1, 0 }, { x / (float)gridSize, y / (float)gridSize } });
+
+	vector<unsigned int> triangles;
+	for (unsigned int y = 0; y < gridSize; y++)
+		for (unsigned int x = 0; x < gridSize; x++)
+		{
+			unsigned int i = y * (gridSize + 1) + x;
+			for (unsigned int index : { i, i + gridSize + 1, i + 1, i + 1, i + gridSize + 1, i + gridSize + 2 })
+				triangles.push_back(index);
+		}
+
+	vector<unsigned int> order(triangles.size() / 3);
+	for (unsigned int i = 0; i < order.size(); i++)
+		order[i] = i;
+	shuffle(order.begin(), order.end(), mt19937(1234));
+
+	indices.clear();
+	for (unsigned int triangle : order)
+		indices.insert(indices.end(), triangles.begin() + triangle * 3, triangles.begin() + triangle * 3 + 3);
+}
+
+/// <returns>Each triangle's vertex positions, in a canonical order for comparing meshes</returns>
+static vector<vector<float>> GetTriangles(const vector<Mesh::Vertex>& vertices, const vector<unsigned int>& indices)
+{
+	vector<vector<float>> output;
+	for (size_t i = 0; i < indices.size(); i += 3)
+	{
+		vector<vector<float>> corners;
+		for (unsigned int j = 0; j < 3; j++)
+		{
+			const vec3& position = vertices[indices[i + j]].Position;
+			corners.push_back({ position.x, position.y, position.z });
+		}
+
+		// Rotate so the smallest corner is first, keeping winding order
+		size_t first = min_element(corners.begin(), corners.end()) - corners.begin();
+		vector<float> triangle;
+		for (unsigned int j = 0; j < 3; j++)
+			for (float value : corners[(first + j) % 3])
+				triangle.push_back(value);
+		output.push_back(triangle);
+	}
+	sort(output.begin(), output.end());
+	return output;
+}
+
+TEST(MeshOptimiser, ACMR)
+{
+	// Single triangle, every vertex misses
+	EXPECT_FLOAT_EQ(MeshOptimiser::CalculateACMR({ 0, 1, 2 }, 3), 3.0f);
+
+	// Second triangle shares two vertices
+	EXPECT_FLOAT_EQ(MeshOptimiser::CalculateACMR({ 0, 1, 2, 2, 1, 3 }, 4), 2.0f);
+}
+
+TEST(MeshOptimiser, VertexCacheImprovesACMR)
+{
+	vector<Mesh::Vertex> vertices;
+	vector<unsigned int> indices;
+	CreateShuffledGrid(32, vertices, indices);
+
+	vector<unsigned int> optimised = indices;
+	MeshOptimiser::OptimiseVertexCache(optimised, vertices.size());
+
+	ASSERT_EQ(optimised.size(), indices.size());
+	EXPECT_EQ(GetTriangles(vertices, optimised), GetTriangles(vertices, indices));
+	EXPECT_LT(MeshOptimiser::CalculateACMR(optimised, vertices.size()), 1.0f);
+	EXPECT_LT(MeshOptimiser::CalculateACMR(optimised, vertices.size()), MeshOptimiser::CalculateACMR(indices, vertices.size()));
+}
+
+TEST(MeshOptimiser, OptimisePreservesTriangles)
+{
+	vector<Mesh::Vertex> vertices;
+	vector<unsigned int> indices;
+	CreateShuffledGrid(16, vertices, indices);
+
+	// Unused vertex is removed
+	vertices.push_back({ { -1, -1, -1 }, { 0, 1, 0 }, { 0, 0 } });
+
+	vector<Mesh::Vertex> optimisedVertices = vertices;
+	vector<unsigned int> optimisedIndices = indices;
+	MeshOptimiser::Optimise(optimisedVertices, optimisedIndices);
+
+	EXPECT_EQ(optimisedVertices.size(), vertices.size() - 1);
+	EXPECT_EQ(GetTriangles(optimisedVertices, optimisedIndices), GetTriangles(vertices, indices));
+}
+
+TEST(MeshOptimiser, VertexFetchOrder)
+{
+	vector<Mesh::Vertex> vertices(4);
+	for (unsigned int i = 0; i < vertices.size(); i++)
+		vertices[i].Position = vec3((float)i);
+	vector<unsigned int> indices = { 3, 1, 2, 2, 1, 3 };
+
+	MeshOptimiser::OptimiseVertexFetch(vertices, indices);
+
+	// Vertices are ordered by first use, vertex 0 is unused
+	EXPECT_EQ(indices, (vector<unsigned int>{ 0, 1, 2, 2, 1, 0 }));
+	ASSERT_EQ(vertices.size(), 3u);
+	EXPECT_EQ(vertices[0].Position, vec3(3.0f));
+	EXPECT_EQ(vertices[1].Position, vec3(1.0f));
+	EXPECT_EQ(vertices[2].Position, vec3(2.0f));
+}
+
+TEST(MeshOptimiser, IgnoresInvalidIndices)
+{
+	vector<unsigned int> indices = { 0, 1, 5 };
+	MeshOptimiser::OptimiseVertexCache(indices, 3);
+	EXPECT_EQ(indices, (vector<unsigned int>{ 0, 1, 5 }));
+}
+
+/// <returns>Indices of vertices on the grid's outer edge</returns>
+static vector<unsigned int> GetGridBorder(unsigned int gridSize)
+{
+	vector<unsigned int> border;
+	for (unsigned int y = 0; y <= gridSize; y++)
+		for (unsigned int x = 0; x <= gridSize; x++)
+			if (x == 0 || y == 0 || x == gridSize || y == gridSize)
+				border.push_back(y * (gridSize + 1) + x);
+	return border;
+}
+
+TEST(MeshOptimiser, SimplifyReducesTriangles)
+{
+	const unsigned int GridSize = 32;
+
+	vector<Mesh::Vertex> vertices;
+	vector<unsigned int> indices;
+	CreateShuffledGrid(GridSize, vertices, indices);
+
+	vector<unsigned int> simplified;
+	MeshOptimiser::Simplify(vertices, indices, indices.size() / 4, simplified);
+
+	ASSERT_EQ(simplified.size() % 3, 0u);
+	EXPECT_LE(simplified.size(), indices.size() / 4 + 3);
+	for (unsigned int index : simplified)
+		ASSERT_LT(index, vertices.size());
+
+	// Border is unchanged, so the simplified grid still covers the same area
+	for (unsigned int border : GetGridBorder(GridSize))
+		EXPECT_NE(find(simplified.begin(), simplified.end(), border), simplified.end()) << "Border vertex " << border;
+
+	float area = 0.0f;
+	for (size_t i = 0; i < simplified.size(); i += 3)
+	{
+		vec3 a = vertices[simplified[i]].Position;
+		vec3 normal = cross(vertices[simplified[i + 1]].Position - a, vertices[simplified[i + 2]].Position - a);
+		EXPECT_GT(normal.y, 0.0f); // Facing up, matching the source grid
+		area += length(normal) * 0.5f;
+	}
+	EXPECT_NEAR(area, (float)(GridSize * GridSize), 0.01f);
+}
+
+TEST(MeshOptimiser, SimplifyKeepsSeams)
+{
+	const unsigned int GridSize = 8;
+
+	vector<Mesh::Vertex> vertices;
+	vector<unsigned int> indices;
+	CreateShuffledGrid(GridSize, vertices, indices);
+
+	// Duplicate the middle column with different texture coordinates, used by triangles on the right half
+	const unsigned int seamX = GridSize / 2;
+	vector<unsigned int> duplicates(vertices.size(), 0);
+	for (unsigned int y = 0; y <= GridSize; y++)
+	{
+		unsigned int original = y * (GridSize + 1) + seamX;
+		duplicates[original] = (unsigned int)vertices.size();
+		Mesh::Vertex duplicate = vertices[original];
+		duplicate.TexCoords.x += 1.0f;
+		vertices.push_back(duplicate);
+	}
+	for (size_t i = 0; i < indices.size(); i += 3)
+	{
+		float centreX = (vertices[indices[i]].Position.x + vertices[indices[i + 1]].Position.x + vertices[indices[i + 2]].Position.x) / 3.0f;
+		if (centreX > seamX)
+			for (unsigned int j = 0; j < 3; j++)
+				if (vertices[indices[i + j]].Position.x == seamX)
+					indices[i + j] = duplicates[indices[i + j]];
+	}
+
+	vector<unsigned int> simplified;
+	MeshOptimiser::Simplify(vertices, indices, 0, simplified);
+	EXPECT_LT(simplified.size(), indices.size());
+
+	// Every seam position is still referenced by both sides
+	for (unsigned int y = 0; y <= GridSize; y++)
+	{
+		unsigned int original = y * (GridSize + 1) + seamX;
+		EXPECT_NE(find(simplified.begin(), simplified.end(), original), simplified.end());
+		EXPECT_NE(find(simplified.begin(), simplified.end(), duplicates[original]), simplified.end());
+	}
+}
+
+TEST(MeshOptimiser, SimplifyIgnoresInvalidInput)
+{
+	vector<Mesh::Vertex> vertices(3);
+	vector<unsigned int> simplified;
+
+	MeshOptimiser::Simplify(vertices, { 0, 1, 5 }, 0, simplified);
+	EXPECT_EQ(simplified, (vector<unsigned int>{ 0, 1, 5 }));
+
+	MeshOptimiser::Simplify(vertices, { 0, 1 }, 0, simplified);
+	EXPECT_EQ(simplified, (vector<unsigned int>{ 0, 1 }));
+}
+
+TEST(MeshOptimiser, SelectLOD)
+{
+	const float Infinity = numeric_limits<float>::infinity();
+	vector<Mesh::LOD> lods = { { 0, 6, Infinity }, { 6, 3, 0.5f }, { 9, 3, 0.25f } };
+
+	EXPECT_EQ(Mesh::SelectLOD(lods, 1.0f, 0, 0.1f), 0u);
+	EXPECT_EQ(Mesh::SelectLOD(lods, 0.4f, 0, 0.1f), 1u);
+	EXPECT_EQ(Mesh::SelectLOD(lods, 0.1f, 0, 0.1f), 2u);
+	EXPECT_EQ(Mesh::SelectLOD(lods, 0.1f, 5, 0.1f), 2u); // Current level is clamped
+
+	// Within hysteresis of a threshold, the current level is kept
+	EXPECT_EQ(Mesh::SelectLOD(lods, 0.48f, 0, 0.1f), 0u);
+	EXPECT_EQ(Mesh::SelectLOD(lods, 0.52f, 1, 0.1f), 1u);
+
+	// Passing a threshold by more than hysteresis switches
+	EXPECT_EQ(Mesh::SelectLOD(lods, 0.44f, 0, 0.1f), 1u);
+	EXPECT_EQ(Mesh::SelectLOD(lods, 0.56f, 1, 0.1f), 0u);
+	EXPECT_EQ(Mesh::SelectLOD(lods, 0.56f, 2, 0.1f), 0u);
+
+	// Single level always selects full detail
+	EXPECT_EQ(Mesh::SelectLOD({ lods[0] }, 0.0f, 0, 0.1f), 0u);
+}
+
+TEST(MeshOptimiser, PackNormal)
+{
+	for (vec3 normal : { vec3(1, 0, 0), vec3(0, -1, 0), vec3(0, 0, 1), normalize(vec3(1, -2, 3)) })
+	{
+		vec3 unpacked = MeshOptimiser::UnpackNormal(MeshOptimiser::PackNormal(normal));
+		EXPECT_NEAR(unpacked.x, normal.x, 1.0f / 511.0f);
+		EXPECT_NEAR(unpacked.y, normal.y, 1.0f / 511.0f);
+		EXPECT_NEAR(unpacked.z, normal.z, 1.0f / 511.0f);
+	}
+}
+
+TEST(MeshOptimiser, HalfFloat)
+{
+	EXPECT_EQ(MeshOptimiser::ToHalf(0.0f), 0x0000);
+	EXPECT_EQ(MeshOptimiser::ToHalf(1.0f), 0x3C00);
+	EXPECT_EQ(MeshOptimiser::ToHalf(-2.0f), 0xC000);
+	EXPECT_EQ(MeshOptimiser::ToHalf(65504.0f), 0x7BFF);
+	EXPECT_EQ(MeshOptimiser::ToHalf(1e6f), 0x7C00); // Overflow to infinity
+	EXPECT_EQ(MeshOptimiser::ToHalf(ldexpf(1.0f, -24)), 0x0001); // Smallest denormal
+
+	for (float value : { 0.0f, 0.5f, 0.333f, 1.0f, -7.25f, 1024.5f, 0.0001f })
+		EXPECT_NEAR(MeshOptimiser::FromHalf(MeshOptimiser::ToHalf(value)), value, std::max(fabsf(value) / 1024.0f, 1e-7f));
+}
+
+TEST(MeshOptimiser, PackedVertexSize)
+{
+	EXPECT_EQ(sizeof(Mesh::PackedVertex), 20u);
+	EXPECT_LT(sizeof(Mesh::PackedVertex), sizeof(Mesh::Vertex));
+}
+
+TEST(MeshOptimiser, DISABLED_Benchmark)
+{
+	const unsigned int GridSize = 256;
+
+	vector<Mesh::Vertex> vertices;
+	vector<unsigned int> indices;
+	CreateShuffledGrid(GridSize, vertices, indices);
+	float before = MeshOptimiser::CalculateACMR(indices, vertices.size());
+
+	auto start = chrono::high_resolution_clock::now();
+	MeshOptimiser::Optimise(vertices, indices);
+	auto duration = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start);
+
+	float after = MeshOptimiser::CalculateACMR(indices, vertices.size());
+	spdlog::info("Optimised {} triangles in {:.3f}ms, ACMR {:.3f} -> {:.3f}", indices.size() / 3, duration.count(), before, after);
+	EXPECT_LT(after, before);
+}
+
+TEST(MeshOptimiser, DISABLED_SimplifyBenchmark)
+{
+	const unsigned int GridSize = 256;
+
+	vector<Mesh::Vertex> vertices;
+	vector<unsigned int> indices;
+	CreateShuffledGrid(GridSize, vertices, indices);
+
+	vector<unsigned int> simplified;
+	auto start = chrono::high_resolution_clock::now();
+	MeshOptimiser::Simplify(vertices, indices, indices.size() / 2, simplified);
+	auto duration = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start);
+
+	spdlog::info("Simplified {} triangles to {} in {:.3f}ms", indices.size() / 3, simplified.size() / 3, duration.count());
+	EXPECT_LT(simplified.size(), indices.size());
+}
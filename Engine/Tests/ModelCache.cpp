@@ -0,0 +1,324 @@
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
+#include <Yonai/IO/MappedFile.hpp>
+#include <Yonai/IO/ImportCache.hpp>
+#include <Yonai/Graphics/Model.hpp>
+#include <Yonai/Graphics/ModelCache.hpp>
+
+using namespace std;
+using namespace Yonai::IO;
+using namespace Yonai::Graphics;
+
+namespace fs = std::filesystem;
+
+/// <summary>
+/// Grid of quads, split in to two meshes with a child node
+/// </summary>
+static CachedModel CreateTestModel(unsigned int gridSize = 4)
+{
+	CachedModel model;
+	model.Materials.resize(2);
+	model.Materials[0].Name = "Ground";
+	model.Materials[0].AlbedoMap = "Textures/Ground.png";
+	model.Materials[1].Name = "Detail";
+	model.Materials[1].NormalMap = "Textures/Detail_Normal.png";
+
+	model.Meshes.resize(2);
+	for (unsigned int m = 0; m < model.Meshes.size(); m++)
+	{
+		CachedMesh& mesh = model.Meshes[m];
+		mesh.Name = "Mesh" + to_string(m);
+		mesh.MaterialIndex = m;
+		for (unsigned int y = 0; y <= gridSize; y++)
+			for (unsigned int x = 0; x <= gridSize; x++)
+				mesh.Vertices.push_back({ { (float)x, (float)m, (float)y }, { 0, 1, 0 }, { x / (float)gridSize, y / (float)gridSize } });
+
+		for (unsigned int y = 0; y < gridSize; y++)
+			for (unsigned int x = 0; x < gridSize; x++)
+			{
+				unsigned int i = y * (gridSize + 1) + x;
+				for (unsigned int index : { i, i + gridSize + 1, i + 1, i + 1, i + gridSize + 1, i + gridSize + 2 })
+					mesh.Indices.push_back(index);
+			}
+	}
+
+	// Level of detail using the first half of the triangles
+	model.Meshes[0].LODs.emplace_back(model.Meshes[0].Indices.begin(), model.Meshes[0].Indices.begin() + model.Meshes[0].Indices.size() / 2);
+
+	model.Root.Name = "Root";
+	model.Root.MeshIndices = { 0 };
+	model.Root.Children.resize(1);
+	model.Root.Children[0].Name = "Child";
+	model.Root.Children[0].Transformation[3] = 5.0f; // Translate X
+	model.Root.Children[0].MeshIndices = { 1 };
+	return model;
+}
+
+static string EncodeBase64(const vector<unsigned char>& data)
+{
+	static const char* Characters = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+	string output;
+	output.reserve((data.size() + 2) / 3 * 4);
+	for (size_t i = 0; i < data.size(); i += 3)
+	{
+		uint32_t value = data[i] << 16;
+		if (i + 1 < data.size()) value |= data[i + 1] << 8;
+		if (i + 2 < data.size()) value |= data[i + 2];
+
+		output += Characters[(value >> 18) & 0x3F];
+		output += Characters[(value >> 12) & 0x3F];
+		output += i + 1 < data.size() ? Characters[(value >> 6) & 0x3F] : '=';
+		output += i + 2 < data.size() ? Characters[value & 0x3F] : '=';
+	}
+	return output;
+}
+
+/// <summary>
+/// glTF source with a grid mesh, material and child node per mesh. Buffers are embedded as a data URI.
+/// </summary>
+static string CreateTestGLTF(unsigned int meshCount, unsigned int gridSize)
+{
+	const unsigned int Float = 5126, UnsignedInt = 5125;
+	const unsigned int VertexCount = (gridSize + 1) * (gridSize + 1);
+
+	vector<unsigned char> buffer;
+	string bufferViews, accessors, meshes, materials, nodes, children;
+	unsigned int accessorCount = 0;
+
+	// Appends data to the buffer, with a buffer view and accessor of the same index
+	auto addAccessor = [&](const void* data, size_t size, unsigned int count, unsigned int componentType, const string& type, const string& bounds = "")
+	{
+		string separator = accessorCount > 0 ? "," : "";
+		bufferViews += separator + "{\"buffer\":0,\"byteOffset\":" + to_string(buffer.size()) + ",\"byteLength\":" + to_string(size) + "}";
+		accessors += separator + "{\"bufferView\":" + to_string(accessorCount) + ",\"componentType\":" + to_string(componentType) +
+			",\"count\":" + to_string(count) + ",\"type\":\"" + type + "\"" + bounds + "}";
+
+		buffer.insert(buffer.end(), (const unsigned char*)data, (const unsigned char*)data + size);
+		return to_string(accessorCount++);
+	};
+
+	for (unsigned int m = 0; m < meshCount; m++)
+	{
+		vector<float> positions, normals, texCoords;
+		vector<unsigned int> indices;
+		for (unsigned int y = 0; y <= gridSize; y++)
+			for (unsigned int x = 0; x <= gridSize; x++)
+			{
+				positions.insert(positions.end(), { (float)x, 0.0f, (float)y });
+				normals.insert(normals.end(), { 0.0f, 1.0f, 0.0f });
+				texCoords.insert(texCoords.end(), { x / (float)gridSize, (y + m) / (float)gridSize });
+			}
+
+		for (unsigned int y = 0; y < gridSize; y++)
+			for (unsigned int x = 0; x < gridSize; x++)
+			{
+				unsigned int i = y * (gridSize + 1) + x;
+				indices.insert(indices.end(), { i, i + gridSize + 1, i + 1, i + 1, i + gridSize + 1, i + gridSize + 2 });
+			}
+
+		string position = addAccessor(positions.data(), positions.size() * sizeof(float), VertexCount, Float, "VEC3",
+			",\"min\":[0,0,0],\"max\":[" + to_string(gridSize) + ",0," + to_string(gridSize) + "]");
+		string normal = addAccessor(normals.data(), normals.size() * sizeof(float), VertexCount, Float, "VEC3");
+		string texCoord = addAccessor(texCoords.data(), texCoords.size() * sizeof(float), VertexCount, Float, "VEC2");
+		string index = addAccessor(indices.data(), indices.size() * sizeof(unsigned int), (unsigned int)indices.size(), UnsignedInt, "SCALAR");
+
+		string separator = m > 0 ? "," : "";
+		meshes += separator + "{\"name\":\"Mesh" + to_string(m) + "\",\"primitives\":[{\"attributes\":{\"POSITION\":" + position +
+			",\"NORMAL\":" + normal + ",\"TEXCOORD_0\":" + texCoord + "},\"indices\":" + index + ",\"material\":" + to_string(m) + "}]}";
+		materials += separator + "{\"name\":\"Material" + to_string(m) + "\"}";
+		nodes += ",{\"name\":\"Node" + to_string(m) + "\",\"mesh\":" + to_string(m) + ",\"translation\":[0," + to_string(m) + ",0]}";
+		children += separator + to_string(m + 1);
+	}
+
+	return "{\"asset\":{\"version\":\"2.0\"},\"scene\":0,\"scenes\":[{\"nodes\":[0]}],"
+		"\"nodes\":[{\"name\":\"Root\",\"children\":[" + children + "]}" + nodes + "]," +
+		"\"meshes\":[" + meshes + "],\"materials\":[" + materials + "]," +
+		"\"accessors\":[" + accessors + "],\"bufferViews\":[" + bufferViews + "]," +
+		"\"buffers\":[{\"byteLength\":" + to_string(buffer.size()) + ",\"uri\":\"data:application/octet-stream;base64," + EncodeBase64(buffer) + "\"}]}";
+}
+
+TEST(ModelCache, RoundTrip)
+{
+	CachedModel model = CreateTestModel();
+	vector<unsigned char> data;
+	ModelCache::Serialize(model, data);
+
+	CachedModel output;
+	ASSERT_TRUE(ModelCache::Deserialize(data, output));
+
+	ASSERT_EQ(output.Materials.size(), 2u);
+	EXPECT_EQ(output.Materials[0].Name, "Ground");
+	EXPECT_EQ(output.Materials[0].AlbedoMap, "Textures/Ground.png");
+	EXPECT_TRUE(output.Materials[0].NormalMap.empty());
+	EXPECT_EQ(output.Materials[1].NormalMap, "Textures/Detail_Normal.png");
+
+	ASSERT_EQ(output.Meshes.size(), 2u);
+	for (size_t i = 0; i < output.Meshes.size(); i++)
+	{
+		EXPECT_EQ(output.Meshes[i].Name, model.Meshes[i].Name);
+		EXPECT_EQ(output.Meshes[i].MaterialIndex, model.Meshes[i].MaterialIndex);
+		EXPECT_EQ(output.Meshes[i].Indices, model.Meshes[i].Indices);
+		EXPECT_EQ(output.Meshes[i].LODs, model.Meshes[i].LODs);
+		ASSERT_EQ(output.Meshes[i].Vertices.size(), model.Meshes[i].Vertices.size());
+		EXPECT_EQ(memcmp(output.Meshes[i].Vertices.data(), model.Meshes[i].Vertices.data(), model.Meshes[i].Vertices.size() * sizeof(Mesh::Vertex)), 0);
+	}
+
+	EXPECT_EQ(output.Root.Name, "Root");
+	EXPECT_EQ(output.Root.MeshIndices, vector<unsigned int>{ 0 });
+	ASSERT_EQ(output.Root.Children.size(), 1u);
+	EXPECT_EQ(output.Root.Children[0].Name, "Child");
+	EXPECT_EQ(output.Root.Children[0].Transformation[3], 5.0f);
+	EXPECT_EQ(output.Root.Children[0].MeshIndices, vector<unsigned int>{ 1 });
+}
+
+TEST(ModelCache, RejectInvalidData)
+{
+	vector<unsigned char> data;
+	ModelCache::Serialize(CreateTestModel(), data);
+
+	CachedModel output;
+	EXPECT_FALSE(ModelCache::Deserialize({}, output));
+
+	// Truncated at every length
+	for (size_t length = 0; length < data.size(); length += 7)
+	{
+		vector<unsigned char> truncated(data.begin(), data.begin() + length);
+		EXPECT_FALSE(ModelCache::Deserialize(truncated, output)) << "Length " << length;
+	}
+
+	// Unknown version
+	vector<unsigned char> newerVersion = data;
+	uint32_t version = ModelCache::FileVersion + 1;
+	memcpy(newerVersion.data() + sizeof(uint32_t), &version, sizeof(version));
+	EXPECT_FALSE(ModelCache::Deserialize(newerVersion, output));
+
+	// Node referencing a mesh that does not exist
+	CachedModel model = CreateTestModel();
+	model.Root.MeshIndices.push_back(5);
+	ModelCache::Serialize(model, data);
+	EXPECT_FALSE(ModelCache::Deserialize(data, output));
+
+	// Index past the end of vertices
+	model = CreateTestModel();
+	model.Meshes[0].Indices.push_back((unsigned int)model.Meshes[0].Vertices.size());
+	ModelCache::Serialize(model, data);
+	EXPECT_FALSE(ModelCache::Deserialize(data, output));
+
+	// Level of detail index past the end of vertices
+	model = CreateTestModel();
+	model.Meshes[0].LODs[0].push_back((unsigned int)model.Meshes[0].Vertices.size());
+	ModelCache::Serialize(model, data);
+	EXPECT_FALSE(ModelCache::Deserialize(data, output));
+}
+
+TEST(ModelCache, RejectDeepHierarchy)
+{
+	CachedModel model;
+	CachedNode* node = &model.Root;
+	for (unsigned int i = 0; i <= ModelCache::MaxNodeDepth; i++)
+	{
+		node->Children.resize(1);
+		node = &node->Children[0];
+	}
+
+	vector<unsigned char> data;
+	ModelCache::Serialize(model, data);
+
+	CachedModel output;
+	EXPECT_FALSE(ModelCache::Deserialize(data, output));
+}
+
+TEST(ModelCache, ParallelImportMatchesSerial)
+{
+	const unsigned int MeshCount = 8;
+	string gltf = CreateTestGLTF(MeshCount, 16);
+	vector<unsigned char> source(gltf.begin(), gltf.end());
+
+	bool parallelImport = Model::IsParallelImport();
+	for (uint32_t flags : { Model::GetImportFlags(false, 0), Model::GetImportFlags(true, 2) })
+	{
+		CachedModel serialModel, parallelModel;
+		Model::SetParallelImport(false);
+		ASSERT_TRUE(Model::ImportScene(source, ".gltf", flags, serialModel));
+		Model::SetParallelImport(true);
+		ASSERT_TRUE(Model::ImportScene(source, ".gltf", flags, parallelModel));
+
+		ASSERT_EQ(serialModel.Meshes.size(), MeshCount);
+		ASSERT_EQ(serialModel.Materials.size(), MeshCount);
+		for (unsigned int i = 0; i < MeshCount; i++)
+		{
+			EXPECT_EQ(parallelModel.Meshes[i].Name, "Mesh" + to_string(i));
+			EXPECT_EQ(parallelModel.Materials[parallelModel.Meshes[i].MaterialIndex].Name, "Material" + to_string(i));
+		}
+
+		vector<unsigned char> serial, parallel;
+		ModelCache::Serialize(serialModel, serial);
+		ModelCache::Serialize(parallelModel, parallel);
+		EXPECT_EQ(parallel, serial) << "Flags " << flags;
+	}
+	Model::SetParallelImport(parallelImport);
+}
+
+/// <summary>
+/// Compares importing a glTF model with Assimp against loading it through the import cache, from the same source file
+/// </summary>
+TEST(ModelCache, DISABLED_LoadBenchmark)
+{
+	const unsigned int MeshCount = 8;
+	const unsigned int GridSize = 128;
+	const unsigned int Iterations = 3;
+	const uint32_t ImportFlags = Model::GetImportFlags(false, 0);
+
+	fs::path directory = fs::temp_directory_path() / "YonaiTest_ModelCache";
+	fs::remove_all(directory);
+	fs::create_directories(directory);
+
+	string sourcePath = (directory / "Grid.gltf").string();
+	{
+		ofstream file(sourcePath, ios::binary | ios::trunc);
+		file << CreateTestGLTF(MeshCount, GridSize);
+	}
+
+	auto start = chrono::high_resolution_clock::now();
+	for (unsigned int i = 0; i < Iterations; i++)
+	{
+		MappedFile file(sourcePath);
+		CachedModel output;
+		ASSERT_TRUE(Model::ImportScene(file.GetSpan(), ".gltf", ImportFlags, output));
+		ASSERT_EQ(output.Meshes.size(), MeshCount);
+	}
+	auto sourceDuration = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start) / Iterations;
+
+	// First import converts the source and stores it in the cache
+	string previousDirectory = ImportCache::GetDirectory();
+	ImportCache::SetDirectory((directory / "Cache").string());
+
+	vector<unsigned char> cached;
+	bool fromCache = true;
+	ASSERT_TRUE(ImportCache::Import("Model", sourcePath, ImportFlags, cached, &fromCache));
+	EXPECT_FALSE(fromCache);
+
+	start = chrono::high_resolution_clock::now();
+	for (unsigned int i = 0; i < Iterations; i++)
+	{
+		CachedModel output;
+		ASSERT_TRUE(ImportCache::Import("Model", sourcePath, ImportFlags, cached, &fromCache));
+		ASSERT_TRUE(fromCache);
+		ASSERT_TRUE(ModelCache::Deserialize(cached, output));
+		ASSERT_EQ(output.Meshes.size(), MeshCount);
+	}
+	auto cachedDuration = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start) / Iterations;
+
+	ImportCache::SetDirectory(previousDirectory);
+	fs::remove_all(directory);
+
+	spdlog::info("{} mesh {}x{} grid glTF - Assimp {:.3f}ms, cached {:.3f}ms ({} bytes)", MeshCount, GridSize, GridSize, sourceDuration.count(), cachedDuration.count(), cached.size());
+	EXPECT_LT(cachedDuration.count(), sourceDuration.count());
+}
@@ -0,0 +1,180 @@
+#include <chrono>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
+#include <Yonai/IO/Files.hpp>
+#include <Yonai/IO/PackArchive.hpp>
+
+using namespace std;
+using namespace Yonai;
+using namespace Yonai::IO;
+
+namespace fs = std::filesystem;
+
+static string GetTestPath(const string& name) { return (fs::temp_directory_path() / ("YonaiTest_" + name)).string(); }
+
+static vector<unsigned char> CreateContents(size_t size, unsigned int seed)
+{
+	vector<unsigned char> contents(size);
+	for (size_t i = 0; i < size; i++)
+		contents[i] = (unsigned char)((i / 16) * seed);
+	return contents;
+}
+
+TEST(PackArchive, WriteAndRead)
+{
+	string packPath = GetTestPath("Test.pak");
+	string sourcePath = GetTestPath("PackSource.bin");
+	vector<unsigned char> fileContents = CreateContents(5000, 3);
+	IO::Write(sourcePath, fileContents);
+
+	PackWriter writer;
+	writer.Add("Textures/A.png", CreateContents(100, 1));
+	writer.Add("./Textures\\B.png", CreateContents(1000, 2), PackCompression::LZ4);
+	writer.Add("Empty.txt", {});
+	writer.AddFile("/Scenes/Main.json", sourcePath, PackCompression::LZ4);
+	writer.Add("Replaced.txt", CreateContents(10, 1));
+	writer.Add("Replaced.txt", CreateContents(20, 5));
+	EXPECT_EQ(writer.GetEntryCount(), 5);
+	ASSERT_TRUE(writer.Write(packPath, 64));
+
+	PackArchive archive(packPath);
+	ASSERT_TRUE(archive.IsOpen());
+	EXPECT_EQ(archive.GetEntryCount(), 5);
+
+	vector<unsigned char> data;
+	ASSERT_TRUE(archive.Read("Textures/A.png", data));
+	EXPECT_EQ(data, CreateContents(100, 1));
+
+	// Paths are normalised when looking up
+	ASSERT_TRUE(archive.Read(".\\Textures/B.png", data));
+	EXPECT_EQ(data, CreateContents(1000, 2));
+	EXPECT_EQ(archive.Find("Textures/B.png")->Compression, PackCompression::LZ4);
+
+	ASSERT_TRUE(archive.Read("Scenes/Main.json", data));
+	EXPECT_EQ(data, fileContents);
+
+	ASSERT_TRUE(archive.Read("Replaced.txt", data));
+	EXPECT_EQ(data, CreateContents(20, 5));
+
+	ASSERT_TRUE(archive.Exists("Empty.txt"));
+	ASSERT_TRUE(archive.Read("Empty.txt", data));
+	EXPECT_TRUE(data.empty());
+
+	EXPECT_FALSE(archive.Exists("Textures/C.png"));
+	EXPECT_FALSE(archive.Exists("Textures"));
+	EXPECT_FALSE(archive.Read("Missing", data));
+
+	// Uncompressed data is viewed in place and aligned
+	const PackEntry* entry = archive.Find("Textures/A.png");
+	ASSERT_NE(entry, nullptr);
+	EXPECT_EQ(entry->Offset % 64, 0);
+	ByteSpan view = archive.GetData(*entry);
+	EXPECT_TRUE(equal(view.begin(), view.end(), CreateContents(100, 1).begin()));
+	EXPECT_EQ(archive.GetPath(*entry), "Textures/A.png");
+
+	archive.Close();
+	fs::remove(packPath);
+	fs::remove(sourcePath);
+}
+
+TEST(PackArchive, RejectInvalidData)
+{
+	string packPath = GetTestPath("Invalid.pak");
+
+	PackWriter writer;
+	writer.Add("A", CreateContents(100, 1));
+	ASSERT_TRUE(writer.Write(packPath));
+
+	vector<unsigned char> valid = IO::Read(packPath);
+	PackArchive archive;
+
+	// Truncated table
+	vector<unsigned char> truncated(valid.begin(), valid.end() - 10);
+	IO::Write(packPath, truncated);
+	EXPECT_FALSE(archive.Open(packPath));
+
+	// Wrong magic
+	vector<unsigned char> badMagic = valid;
+	badMagic[0] ^= 0xFF;
+	IO::Write(packPath, badMagic);
+	EXPECT_FALSE(archive.Open(packPath));
+
+	// Entry out of range
+	vector<unsigned char> badEntry = valid;
+	PackHeader header;
+	memcpy(&header, valid.data(), sizeof(header));
+	PackEntry entry;
+	memcpy(&entry, valid.data() + header.TableOffset, sizeof(entry));
+	entry.Size = valid.size();
+	memcpy(badEntry.data() + header.TableOffset, &entry, sizeof(entry));
+	IO::Write(packPath, badEntry);
+	EXPECT_FALSE(archive.Open(packPath));
+	EXPECT_FALSE(archive.IsOpen());
+
+	IO::Write(packPath, valid);
+	EXPECT_TRUE(archive.Open(packPath));
+	archive.Close();
+
+	// Uncompressed size larger than the compressed data could produce
+	writer.Add("A", CreateContents(100, 1), PackCompression::LZ4);
+	ASSERT_TRUE(writer.Write(packPath));
+	vector<unsigned char> badSize = IO::Read(packPath);
+	memcpy(&header, badSize.data(), sizeof(header));
+	memcpy(&entry, badSize.data() + header.TableOffset, sizeof(entry));
+	entry.UncompressedSize = ~0ull;
+	memcpy(badSize.data() + header.TableOffset, &entry, sizeof(entry));
+	IO::Write(packPath, badSize);
+	EXPECT_FALSE(archive.Open(packPath));
+
+	archive.Close();
+	fs::remove(packPath);
+}
+
+TEST(PackArchive, DISABLED_LoadBenchmark)
+{
+	const int FileCount = 2000;
+
+	string looseDirectory = GetTestPath("Loose");
+	fs::create_directories(looseDirectory);
+	string packPath = GetTestPath("Benchmark.pak");
+
+	PackWriter writer;
+	vector<string> paths;
+	for (int i = 0; i < FileCount; i++)
+	{
+		string path = "Assets/" + to_string(i % 20) + "/" + to_string(i) + ".json";
+		vector<unsigned char> contents = CreateContents(512 + (i % 7) * 256, i);
+
+		fs::create_directories(fs::path(looseDirectory + "/" + path).parent_path());
+		IO::Write(looseDirectory + "/" + path, contents);
+		writer.Add(path, contents);
+		paths.push_back(path);
+	}
+	ASSERT_TRUE(writer.Write(packPath));
+
+	size_t looseBytes = 0, packBytes = 0;
+	auto start = chrono::high_resolution_clock::now();
+	for (const string& path : paths)
+		if (IO::Exists(looseDirectory + "/" + path))
+			looseBytes += IO::Read(looseDirectory + "/" + path).size();
+	auto looseDuration = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start);
+
+	start = chrono::high_resolution_clock::now();
+	PackArchive archive(packPath);
+	vector<unsigned char> data;
+	for (const string& path : paths)
+		if (archive.Read(path, data))
+			packBytes += data.size();
+	auto packDuration = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start);
+
+	spdlog::info("Read {} files, loose {:.3f}ms, from pack {:.3f}ms", FileCount, looseDuration.count(), packDuration.count());
+	EXPECT_EQ(looseBytes, packBytes);
+
+	archive.Close();
+	fs::remove_all(looseDirectory);
+	fs::remove(packPath);
+}
@@ -0,0 +1,509 @@
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
+#include <Yonai/Resource.hpp>
+
+using namespace std;
+using namespace Yonai;
+
+struct TestResource
+{
+	int Value = 0;
+
+	TestResource() = default;
+	TestResource(int value) : Value(value) { }
+};
+
+struct OtherResource { };
+
+static atomic_int DestroyedCount = 0;
+
+struct DerivedResource : public ResourceBase
+{
+	vector<int> Data = vector<int>(1000);
+
+	~DerivedResource() override { DestroyedCount++; }
+};
+
+class ResourceTest : public ::testing::Test
+{
+protected:
+	void TearDown() override
+	{
+		Resource::UnloadAll();
+		Resource::SetReloader<TestResource>(nullptr);
+		Resource::SetDefaultReloader(nullptr);
+	}
+};
+
+TEST_F(ResourceTest, LoadAndGet)
+{
+	ResourceID id = Resource::Load<TestResource>("Test/A", 5);
+	ASSERT_NE(id, InvalidResourceID);
+
+	TestResource* resource = Resource::Get<TestResource>(id);
+	ASSERT_NE(resource, nullptr);
+	EXPECT_EQ(resource->Value, 5);
+
+	// Same path returns the existing resource
+	EXPECT_EQ(Resource::Load<TestResource>("Test/A", 10), id);
+	EXPECT_EQ(resource->Value, 5);
+
+	// Wrong type
+	EXPECT_EQ(Resource::Get<OtherResource>(id), nullptr);
+	EXPECT_EQ(Resource::Load<OtherResource>("Test/A"), InvalidResourceID);
+}
+
+TEST_F(ResourceTest, PathLookup)
+{
+	ResourceID a = Resource::Load<TestResource>("Test\\A");
+	ResourceID b = Resource::Load<TestResource>("Test/B");
+
+	EXPECT_EQ(Resource::GetPath(a), "Test/A");
+	EXPECT_EQ(Resource::GetPath(b), "Test/B");
+	EXPECT_EQ(Resource::GetID("Test/A"), a);
+	EXPECT_EQ(Resource::GetID("Test/C"), InvalidResourceID);
+
+	Resource::Unload(a);
+	EXPECT_TRUE(Resource::GetPath(a).empty());
+	EXPECT_FALSE(Resource::Exists("Test/A"));
+	EXPECT_EQ(Resource::GetPath(b), "Test/B");
+}
+
+TEST_F(ResourceTest, HandlesInvalidatedOnUnload)
+{
+	ResourceID a = Resource::Load<TestResource>("Test/A", 1);
+	TypedResourceHandle<TestResource> handle = Resource::GetHandle<TestResource>(a);
+	ASSERT_TRUE(Resource::IsValid(handle));
+	EXPECT_EQ(Resource::Get(handle)->Value, 1);
+
+	// Typed handle of the wrong type is invalid
+	EXPECT_FALSE(Resource::IsValid(Resource::GetHandle<OtherResource>(a)));
+
+	Resource::Unload(a);
+	EXPECT_FALSE(Resource::IsValid(handle));
+	EXPECT_EQ(Resource::Get(handle), nullptr);
+
+	// Slot is reused by the next resource once destroyed, with a new generation
+	Resource::DestroyPending();
+	ResourceID b = Resource::Load<TestResource>("Test/B", 2);
+	ResourceHandle reused = Resource::GetHandle(b);
+	EXPECT_EQ(reused.Index, handle.Index);
+	EXPECT_NE(reused.Generation, handle.Generation);
+	EXPECT_EQ(Resource::Get(handle), nullptr);
+	EXPECT_FALSE(Resource::IsValidResourceID(a));
+	EXPECT_TRUE(Resource::IsValidResourceID(b));
+}
+
+TEST_F(ResourceTest, UnloadKeepsOtherResources)
+{
+	vector<ResourceID> ids;
+	for (int i = 0; i < 10; i++)
+		ids.push_back(Resource::Load<TestResource>("Test/" + to_string(i), i));
+
+	for (int i = 0; i < 10; i += 2)
+		Resource::Unload(ids[i]);
+
+	for (int i = 0; i < 10; i++)
+	{
+		TestResource* resource = Resource::Get<TestResource>(ids[i]);
+		if (i % 2 == 0)
+			EXPECT_EQ(resource, nullptr);
+		else
+		{
+			ASSERT_NE(resource, nullptr);
+			EXPECT_EQ(resource->Value, i);
+			EXPECT_EQ(Resource::GetPath(ids[i]), "Test/" + to_string(i));
+		}
+	}
+}
+
+TEST_F(ResourceTest, CachedResource)
+{
+	ResourceID a = Resource::Load<TestResource>("Test/A", 1);
+	ResourceID b = Resource::Load<TestResource>("Test/B", 2);
+
+	CachedResource<TestResource> cache;
+	ASSERT_NE(cache.Get(a), nullptr);
+	EXPECT_EQ(cache.Get(a)->Value, 1);
+	EXPECT_EQ(cache.Get(b)->Value, 2);
+	EXPECT_EQ(cache.Get(InvalidResourceID), nullptr);
+
+	// Refreshed after the resource is unloaded and its slot reused
+	EXPECT_EQ(cache.Get(a)->Value, 1);
+	Resource::Unload(a);
+	Resource::DestroyPending();
+	Resource::Load<TestResource>("Test/C", 3);
+	EXPECT_EQ(cache.Get(a), nullptr);
+
+	// Refreshed after all resources are unloaded
+	EXPECT_EQ(cache.Get(b)->Value, 2);
+	Resource::UnloadAll();
+	EXPECT_EQ(cache.Get(b), nullptr);
+}
+
+TEST_F(ResourceTest, DeferredDestruction)
+{
+	DestroyedCount = 0;
+	ResourceID id = Resource::Load<DerivedResource>("Test/Derived");
+	ASSERT_NE(Resource::Get<DerivedResource>(id), nullptr);
+	EXPECT_EQ(Resource::Get<DerivedResource>(id)->ID(), id);
+
+	Resource::Unload(id);
+	EXPECT_EQ(Resource::Get<DerivedResource>(id), nullptr);
+	EXPECT_EQ(DestroyedCount, 0); // Destroyed at the end of the frame
+
+	// Path can be loaded again before the previous resource is destroyed
+	ResourceID reloaded = Resource::Load<DerivedResource>("Test/Derived");
+	EXPECT_NE(reloaded, id);
+
+	Resource::DestroyPending();
+	EXPECT_EQ(DestroyedCount, 1);
+	EXPECT_NE(Resource::Get<DerivedResource>(reloaded), nullptr);
+
+	Resource::UnloadAll();
+	EXPECT_EQ(DestroyedCount, 2);
+}
+
+TEST_F(ResourceTest, ReferenceCounting)
+{
+	ResourceID id = Resource::Load<TestResource>("Test/A");
+	EXPECT_EQ(Resource::GetReferenceCount(id), 1);
+
+	EXPECT_EQ(Resource::Load<TestResource>("Test/A"), id);
+	Resource::AddReference(id);
+	EXPECT_EQ(Resource::GetReferenceCount(id), 3);
+
+	Resource::Release(id);
+	Resource::Release(id);
+	EXPECT_TRUE(Resource::IsValidResourceID(id));
+
+	Resource::Release(id);
+	EXPECT_FALSE(Resource::IsValidResourceID(id));
+	EXPECT_EQ(Resource::GetReferenceCount(id), 0);
+}
+
+TEST_F(ResourceTest, LoadAsync)
+{
+	atomic_bool release = false;
+	ResourceID id = Resource::LoadAsync<TestResource>("Test/Async", [&]()
+	{
+		while (!release)
+			this_thread::yield();
+		return new TestResource(7);
+	});
+	ASSERT_NE(id, InvalidResourceID);
+
+	ResourceState state = Resource::GetState(id);
+	EXPECT_TRUE(state == ResourceState::Queued || state == ResourceState::Loading);
+	EXPECT_EQ(Resource::Get<TestResource>(id), nullptr);
+
+	// Loading the same path waits for the worker to finish
+	release = true;
+	EXPECT_EQ(Resource::Load<TestResource>("Test/Async"), id);
+	EXPECT_EQ(Resource::GetState(id), ResourceState::Ready);
+	EXPECT_EQ(Resource::Get<TestResource>(id)->Value, 7);
+
+	ResourceID failed = Resource::LoadAsync<TestResource>("Test/Failed", []() { return (TestResource*)nullptr; });
+	while (Resource::GetState(failed) != ResourceState::Failed)
+		this_thread::yield();
+	EXPECT_EQ(Resource::Get<TestResource>(failed), nullptr);
+	EXPECT_TRUE(Resource::IsValidResourceID(failed));
+}
+
+TEST_F(ResourceTest, ConcurrentLoad)
+{
+	const int ThreadCount = 8;
+	const int PathCount = 100;
+
+	vector<vector<ResourceID>> ids(ThreadCount, vector<ResourceID>(PathCount));
+	vector<thread> threads;
+	for (int t = 0; t < ThreadCount; t++)
+		threads.emplace_back([&, t]()
+		{
+			for (int i = 0; i < PathCount; i++)
+			{
+				ids[t][i] = Resource::Load<TestResource>("Test/" + to_string(i), i);
+				TestResource* resource = Resource::Get<TestResource>(ids[t][i]);
+				EXPECT_TRUE(resource && resource->Value == i);
+			}
+		});
+	for (thread& t : threads)
+		t.join();
+
+	// Every thread received the same resource for each path
+	for (int t = 1; t < ThreadCount; t++)
+		EXPECT_EQ(ids[t], ids[0]);
+	for (int i = 0; i < PathCount; i++)
+		EXPECT_EQ(Resource::GetReferenceCount(ids[0][i]), ThreadCount);
+}
+
+TEST_F(ResourceTest, ConcurrentHandleReads)
+{
+	const int ResourceCount = 64;
+
+	vector<ResourceID> ids;
+	for (int i = 0; i < ResourceCount; i++)
+		ids.push_back(Resource::Load<TestResource>("Test/" + to_string(i), i));
+
+	// Readers only use handles, while resources are unloaded and reloaded
+	atomic_bool running = true;
+	vector<thread> readers;
+	for (int t = 0; t < 4; t++)
+		readers.emplace_back([&]()
+		{
+			vector<TypedResourceHandle<TestResource>> handles;
+			for (ResourceID id : ids)
+				handles.push_back(Resource::GetHandle<TestResource>(id));
+			while (running)
+				for (int i = 0; i < ResourceCount; i++)
+				{
+					TestResource* resource = Resource::Get(handles[i]);
+					if (resource)
+						EXPECT_EQ(resource->Value, i);
+				}
+		});
+
+	for (int i = 0; i < ResourceCount; i++)
+		Resource::Unload(ids[i]);
+	for (int i = 0; i < ResourceCount; i++)
+		Resource::Load<TestResource>("Test/" + to_string(i), -1);
+
+	running = false;
+	for (thread& reader : readers)
+		reader.join();
+}
+
+TEST_F(ResourceTest, DISABLED_LookupBenchmark)
+{
+	const int ResourceCount = 10000;
+	const int Lookups = 1000000;
+
+	vector<ResourceID> ids;
+	for (int i = 0; i < ResourceCount; i++)
+		ids.push_back(Resource::Load<TestResource>("Test/" + to_string(i), i));
+
+	vector<CachedResource<TestResource>> caches(ResourceCount);
+	long long idSum = 0, cachedSum = 0;
+
+	auto start = chrono::high_resolution_clock::now();
+	for (int i = 0; i < Lookups; i++)
+		idSum += Resource::Get<TestResource>(ids[i % ResourceCount])->Value;
+	auto idDuration = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start);
+
+	start = chrono::high_resolution_clock::now();
+	for (int i = 0; i < Lookups; i++)
+		cachedSum += caches[i % ResourceCount].Get(ids[i % ResourceCount])->Value;
+	auto cachedDuration = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start);
+
+	start = chrono::high_resolution_clock::now();
+	for (int i = ResourceCount - 1; i >= 0; i -= 2)
+		Resource::GetPath(ids[i]);
+	auto pathDuration = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start);
+
+	spdlog::info("{} lookups by ID {:.3f}ms, cached {:.3f}ms. {} path lookups {:.3f}ms",
+		Lookups, idDuration.count(), cachedDuration.count(), ResourceCount / 2, pathDuration.count());
+	EXPECT_EQ(idSum, cachedSum);
+}
+
+/// <summary>
+/// Reloads test resources by incrementing their value
+/// </summary>
+static void CountReloads()
+{
+	Resource::SetReloader<TestResource>([](ResourceID, TestResource& resource, bool)
+	{
+		resource.Value++;
+		return true;
+	});
+}
+
+static size_t IndexOf(const vector<ResourceReload>& reloads, ResourceID id)
+{
+	for (size_t i = 0; i < reloads.size(); i++)
+		if (reloads[i].ID == id)
+			return i;
+	return reloads.size();
+}
+
+TEST_F(ResourceTest, ReloadsOnlyAffectedResources)
+{
+	CountReloads();
+	ResourceID shader = Resource::Load<TestResource>("Shaders/Lit");
+	ResourceID texture = Resource::Load<TestResource>("Textures/Albedo");
+	ResourceID material = Resource::Load<TestResource>("Materials/Brick");
+	ResourceID model = Resource::Load<TestResource>("Models/Wall");
+	ResourceID mesh = Resource::Load<TestResource>("Models/Wall/Mesh/0");
+	Resource::SetDependencies(material, { shader, texture, model });
+	Resource::AddDependency(mesh, model);
+
+	EXPECT_EQ(Resource::GetDependents(shader), vector<ResourceID> { material });
+	EXPECT_EQ(Resource::GetDependencies(material), (vector<ResourceID> { shader, texture, model }));
+
+	vector<ResourceReload> reloads = Resource::Reload(shader);
+	ASSERT_EQ(reloads.size(), 2u);
+	EXPECT_EQ(reloads[0].ID, shader);
+	EXPECT_EQ(reloads[0].Path, "Shaders/Lit");
+	EXPECT_TRUE(reloads[0].SourceChanged);
+	EXPECT_EQ(reloads[1].ID, material);
+	EXPECT_FALSE(reloads[1].SourceChanged);
+	for (ResourceReload& reload : reloads)
+	{
+		EXPECT_TRUE(reload.Reloaded);
+		EXPECT_GE(reload.Milliseconds, 0.0f);
+	}
+
+	EXPECT_EQ(Resource::Get<TestResource>(texture)->Value, 0);
+	EXPECT_EQ(Resource::Get<TestResource>(mesh)->Value, 0);
+
+	// Model change reaches meshes and materials it created
+	reloads = Resource::Reload(model);
+	ASSERT_EQ(reloads.size(), 3u);
+	EXPECT_EQ(reloads[0].ID, model);
+	EXPECT_NE(IndexOf(reloads, mesh), reloads.size());
+	EXPECT_NE(IndexOf(reloads, material), reloads.size());
+	EXPECT_EQ(Resource::Get<TestResource>(material)->Value, 2);
+}
+
+TEST_F(ResourceTest, ReloadsDependenciesFirstAndOnce)
+{
+	CountReloads();
+	// a <- b <- d, a <- c <- d, with d also depending directly on a
+	ResourceID a = Resource::Load<TestResource>("Test/A");
+	ResourceID b = Resource::Load<TestResource>("Test/B");
+	ResourceID c = Resource::Load<TestResource>("Test/C");
+	ResourceID d = Resource::Load<TestResource>("Test/D");
+	Resource::SetDependencies(d, { c, a, b });
+	Resource::AddDependency(b, a);
+	Resource::AddDependency(c, a);
+	Resource::AddDependency(c, a);
+
+	// Both a and b changed in the same frame
+	Resource::Invalidate(b);
+	Resource::Invalidate(a);
+	Resource::Invalidate(a);
+	vector<ResourceReload> reloads = Resource::ProcessReloads();
+	ASSERT_EQ(reloads.size(), 4u);
+	EXPECT_EQ(reloads[0].ID, a);
+	EXPECT_EQ(reloads[3].ID, d);
+	EXPECT_TRUE(reloads[IndexOf(reloads, b)].SourceChanged);
+	EXPECT_FALSE(reloads[IndexOf(reloads, c)].SourceChanged);
+	for (ResourceID id : { a, b, c, d })
+		EXPECT_EQ(Resource::Get<TestResource>(id)->Value, 1);
+
+	// Nothing left to reload
+	EXPECT_TRUE(Resource::ProcessReloads().empty());
+
+	// Cycles are reloaded once each, after resources outside the cycle
+	Resource::AddDependency(b, d);
+	reloads = Resource::Reload(a);
+	ASSERT_EQ(reloads.size(), 4u);
+	EXPECT_EQ(reloads[0].ID, a);
+}
+
+TEST_F(ResourceTest, FileDependencies)
+{
+	CountReloads();
+	ResourceID shader = Resource::Load<TestResource>("Shaders/Lit");
+	ResourceID material = Resource::Load<TestResource>("Materials/Brick");
+	ResourceID other = Resource::Load<TestResource>("Shaders/Unlit");
+	Resource::SetFileDependencies(shader, { "assets://Shaders/Lit.vert", "assets://Shaders/Lit.frag" });
+	Resource::SetFileDependencies(other, { "assets://Shaders/Unlit.vert" });
+	Resource::AddDependency(material, shader);
+
+	Resource::Invalidate("assets://Shaders/Lit.frag");
+	vector<ResourceReload> reloads = Resource::ProcessReloads();
+	ASSERT_EQ(reloads.size(), 2u);
+	EXPECT_EQ(reloads[0].ID, shader);
+	EXPECT_TRUE(reloads[0].SourceChanged);
+	EXPECT_EQ(reloads[1].ID, material);
+
+	// Changing files replaces the previous ones, and keeps resource dependencies
+	Resource::SetFileDependencies(shader, { "assets://Shaders/Lit.glsl" });
+	Resource::Invalidate("assets://Shaders/Lit.vert");
+	EXPECT_TRUE(Resource::ProcessReloads().empty());
+	Resource::Invalidate("assets://Shaders/Lit.glsl");
+	EXPECT_EQ(Resource::ProcessReloads().size(), 2u);
+
+	// Resource paths invalidate the resource itself
+	Resource::Invalidate("Materials/Brick");
+	reloads = Resource::ProcessReloads();
+	ASSERT_EQ(reloads.size(), 1u);
+	EXPECT_EQ(reloads[0].ID, material);
+}
+
+TEST_F(ResourceTest, UnloadRemovesDependencies)
+{
+	CountReloads();
+	ResourceID texture = Resource::Load<TestResource>("Textures/Albedo");
+	ResourceID material = Resource::Load<TestResource>("Materials/Brick");
+	Resource::AddDependency(material, texture);
+	Resource::SetFileDependencies(material, { "assets://Brick.json" });
+
+	Resource::Unload(material);
+	EXPECT_TRUE(Resource::GetDependents(texture).empty());
+	EXPECT_TRUE(Resource::GetDependencies(material).empty());
+
+	Resource::Invalidate("assets://Brick.json");
+	EXPECT_TRUE(Resource::ProcessReloads().empty());
+	EXPECT_EQ(Resource::Reload(texture).size(), 1u);
+}
+
+TEST_F(ResourceTest, DefaultReloader)
+{
+	ResourceID native = Resource::Load<OtherResource>("Test/Native");
+	ResourceID managed = UUID(); // Resource only known to scripts
+	Resource::AddDependency(managed, native);
+
+	vector<pair<ResourceID, bool>> reloaded;
+	Resource::SetDefaultReloader([&](ResourceID id, void* data, bool sourceChanged)
+	{
+		reloaded.push_back({ id, data != nullptr });
+		return sourceChanged;
+	});
+
+	vector<ResourceReload> reloads = Resource::Reload(native);
+	ASSERT_EQ(reloaded.size(), 2u);
+	EXPECT_EQ(reloaded[0], make_pair(native, true));
+	EXPECT_EQ(reloaded[1], make_pair(managed, false));
+	EXPECT_TRUE(reloads[0].Reloaded);
+	EXPECT_FALSE(reloads[1].Reloaded);
+}
+
+TEST_F(ResourceTest, DISABLED_ReloadBenchmark)
+{
+	const int TextureCount = 100;
+	const int MaterialsPerTexture = 10;
+
+	CountReloads();
+	vector<ResourceID> textures, materials;
+	for (int i = 0; i < TextureCount; i++)
+	{
+		textures.push_back(Resource::Load<TestResource>("Textures/" + to_string(i)));
+		for (int j = 0; j < MaterialsPerTexture; j++)
+		{
+			materials.push_back(Resource::Load<TestResource>("Materials/" + to_string(i) + "/" + to_string(j)));
+			Resource::SetDependencies(materials.back(), { textures.back(), textures[i / 2] });
+		}
+	}
+
+	vector<ResourceID> all = textures;
+	all.insert(all.end(), materials.begin(), materials.end());
+	auto start = chrono::high_resolution_clock::now();
+	vector<ResourceReload> reloads = Resource::Reload(all);
+	auto allDuration = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start);
+	ASSERT_EQ(reloads.size(), all.size());
+
+	start = chrono::high_resolution_clock::now();
+	Resource::Invalidate("Textures/75");
+	reloads = Resource::ProcessReloads();
+	auto changedDuration = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start);
+	ASSERT_EQ(reloads.size(), 1u + MaterialsPerTexture);
+
+	spdlog::info("Reloading all {} resources {:.3f}ms, one changed texture and its {} materials {:.3f}ms",
+		all.size(), allDuration.count(), MaterialsPerTexture, changedDuration.count());
+}
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include <Yonai/Utils.hpp>
+#include <Yonai/Graphics/ShaderCache.hpp>
+
+using namespace std;
+using namespace Yonai;
+using namespace Yonai::Graphics;
+
+const string TestDriver = "Vendor|Renderer|4.6.0";
+
+static ShaderStageInfo CreateStages()
+{
+	ShaderStageInfo stages = {};
+	stages.VertexPath = "Test.vert";
+	stages.VertexContents = "#version 330 core\nvoid main() { gl_Position = vec4(0.0); }";
+	stages.FragmentPath = "Test.frag";
+	stages.FragmentContents = "#version 330 core\nout vec4 colour;\nvoid main() { colour = vec4(1.0); }";
+	return stages;
+}
+
+TEST(ShaderCache, HashMatchesFNV1a)
+{
+	EXPECT_EQ(Hash(""), 0xcbf29ce484222325ull);
+	EXPECT_EQ(Hash("a"), 0xaf63dc4c8601ec8cull);
+	EXPECT_EQ(Hash("foobar"), 0x85944171f73967e8ull);
+}
+
+TEST(ShaderCache, KeyIsDeterministic)
+{
+	EXPECT_EQ(ShaderCache::GetKey(CreateStages(), TestDriver), ShaderCache::GetKey(CreateStages(), TestDriver));
+}
+
+TEST(ShaderCache, KeyIgnoresPaths)
+{
+	ShaderStageInfo stages = CreateStages();
+	stages.VertexPath = "Other.vert";
+	EXPECT_EQ(ShaderCache::GetKey(CreateStages(), TestDriver), ShaderCache::GetKey(stages, TestDriver));
+}
+
+TEST(ShaderCache, KeyChangesWithContents)
+{
+	const uint64_t original = ShaderCache::GetKey(CreateStages(), TestDriver);
+
+	ShaderStageInfo stages = CreateStages();
+	stages.FragmentContents += "\n";
+	EXPECT_NE(ShaderCache::GetKey(stages, TestDriver), original);
+
+	stages = CreateStages();
+	stages.GeometryContents = "#version 330 core\nvoid main() { }";
+	EXPECT_NE(ShaderCache::GetKey(stages, TestDriver), original);
+
+	// Same text, different stage
+	ShaderStageInfo a = {}, b = {};
+	a.VertexContents = "ab";
+	b.VertexContents = "a";
+	b.FragmentContents = "b";
+	EXPECT_NE(ShaderCache::GetKey(a, TestDriver), ShaderCache::GetKey(b, TestDriver));
+}
+
+TEST(ShaderCache, KeyChangesWithDriver)
+{
+	EXPECT_NE(
+		ShaderCache::GetKey(CreateStages(), TestDriver),
+		ShaderCache::GetKey(CreateStages(), "Vendor|Renderer|4.6.1")
+	);
+}
@@ -0,0 +1,119 @@
+#include <glm/glm.hpp>
+#include <gtest/gtest.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <Yonai/Graphics/SpriteBatch.hpp>
+
+using namespace Yonai;
+using namespace Yonai::Graphics;
+
+TEST(SpriteBatch, VertexGeneration)
+{
+	SpriteBatch batch;
+	batch.Begin();
+
+	glm::vec4 colour(0.5f, 0.25f, 1.0f, 1.0f);
+	glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(10, 20, 30));
+	model = glm::scale(model, glm::vec3(2, 3, 1));
+	batch.Submit(ResourceID(1), ResourceID(2), model, colour);
+	batch.End();
+
+	auto& vertices = batch.GetVertices();
+	ASSERT_EQ(vertices.size(), SpriteBatch::QuadVertexCount);
+
+	// Corners of unit quad, scaled then translated
+	EXPECT_EQ(vertices[0].Position, glm::vec3(12, 23, 30));
+	EXPECT_EQ(vertices[1].Position, glm::vec3(12, 17, 30));
+	EXPECT_EQ(vertices[2].Position, glm::vec3( 8, 17, 30));
+	EXPECT_EQ(vertices[3].Position, glm::vec3( 8, 23, 30));
+
+	EXPECT_EQ(vertices[0].TexCoords, glm::vec2(1, 1));
+	EXPECT_EQ(vertices[2].TexCoords, glm::vec2(0, 0));
+
+	for (auto& vertex : vertices)
+	{
+		EXPECT_EQ(vertex.Colour, colour);
+		EXPECT_EQ(vertex.TextureSlot, 0.0f);
+	}
+}
+
+TEST(SpriteBatch, MergeConsecutiveSprites)
+{
+	const ResourceID ShaderA = 1, ShaderB = 2;
+	const ResourceID Texture1 = 10, Texture2 = 20;
+
+	SpriteBatch batch;
+	batch.Begin();
+	batch.Submit(ShaderB, Texture1, glm::mat4(1.0f));
+	batch.Submit(ShaderA, Texture2, glm::mat4(1.0f));
+	batch.Submit(ShaderA, Texture1, glm::mat4(1.0f));
+	batch.Submit(ShaderA, Texture2, glm::mat4(1.0f));
+	batch.Submit(ShaderB, Texture1, glm::mat4(1.0f));
+	batch.End();
+
+	EXPECT_EQ(batch.GetSpriteCount(), 5);
+	EXPECT_EQ(batch.GetVertices().size(), 5 * SpriteBatch::QuadVertexCount);
+
+	// Submission order is kept, only consecutive sprites with the same shader share a batch
+	auto& batches = batch.GetBatches();
+	ASSERT_EQ(batches.size(), 3);
+
+	EXPECT_EQ(batches[0].Shader, ShaderB);
+	EXPECT_EQ(batches[0].FirstSprite, 0);
+	EXPECT_EQ(batches[0].SpriteCount, 1);
+
+	// Textures share a batch using different slots
+	EXPECT_EQ(batches[1].Shader, ShaderA);
+	EXPECT_EQ(batches[1].FirstSprite, 1);
+	EXPECT_EQ(batches[1].SpriteCount, 3);
+	ASSERT_EQ(batches[1].Textures.size(), 2);
+	EXPECT_EQ(batches[1].Textures[0], Texture2);
+	EXPECT_EQ(batches[1].Textures[1], Texture1);
+
+	EXPECT_EQ(batches[2].Shader, ShaderB);
+	EXPECT_EQ(batches[2].FirstSprite, 4);
+	EXPECT_EQ(batches[2].SpriteCount, 1);
+
+	// Texture slots written to vertices match the batch's texture list
+	auto& vertices = batch.GetVertices();
+	EXPECT_EQ(vertices[1 * SpriteBatch::QuadVertexCount].TextureSlot, 0.0f);
+	EXPECT_EQ(vertices[2 * SpriteBatch::QuadVertexCount].TextureSlot, 1.0f);
+	EXPECT_EQ(vertices[3 * SpriteBatch::QuadVertexCount].TextureSlot, 0.0f);
+	EXPECT_EQ(vertices[4 * SpriteBatch::QuadVertexCount].TextureSlot, 0.0f);
+}
+
+TEST(SpriteBatch, SplitWhenOutOfTextureSlots)
+{
+	const ResourceID Shader = 1;
+
+	SpriteBatch batch;
+	batch.Begin();
+	for (uint64_t i = 0; i < 5; i++)
+		batch.Submit(Shader, ResourceID(100 + i), glm::mat4(1.0f));
+
+	// Shader only supports two textures per draw
+	batch.End([](ResourceID) { return 2u; });
+
+	auto& batches = batch.GetBatches();
+	ASSERT_EQ(batches.size(), 3);
+	EXPECT_EQ(batches[0].SpriteCount, 2);
+	EXPECT_EQ(batches[1].SpriteCount, 2);
+	EXPECT_EQ(batches[2].SpriteCount, 1);
+	EXPECT_EQ(batches[2].FirstSprite, 4);
+	EXPECT_EQ(batches[2].Textures.size(), 1);
+	EXPECT_EQ(batch.GetVertices()[4 * SpriteBatch::QuadVertexCount].TextureSlot, 0.0f);
+}
+
+TEST(SpriteBatch, BeginClearsPreviousSprites)
+{
+	SpriteBatch batch;
+	batch.Begin();
+	batch.Submit(ResourceID(1), ResourceID(2), glm::mat4(1.0f));
+	batch.End();
+	EXPECT_EQ(batch.GetSpriteCount(), 1);
+
+	batch.Begin();
+	batch.End();
+	EXPECT_EQ(batch.GetSpriteCount(), 0);
+	EXPECT_TRUE(batch.GetBatches().empty());
+	EXPECT_TRUE(batch.GetVertices().empty());
+}
@@ -0,0 +1,339 @@
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <fstream>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
+#include <Yonai/IO/MappedFile.hpp>
+#include <Yonai/Graphics/Texture.hpp>
+#include <Yonai/Graphics/TextureCooker.hpp>
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb_image_write.h>
+
+using namespace std;
+using namespace Yonai::IO;
+using namespace Yonai::Graphics;
+
+namespace fs = std::filesystem;
+
+/// <summary>
+/// Greyscale PGM image with a diagonal gradient
+/// </summary>
+static vector<unsigned char> CreateTestImage(unsigned int width, unsigned int height)
+{
+	string header = "P5 " + to_string(width) + " " + to_string(height) + " 255\n";
+	vector<unsigned char> data(header.begin(), header.end());
+	for (unsigned int y = 0; y < height; y++)
+		for (unsigned int x = 0; x < width; x++)
+			data.push_back((unsigned char)((x + y) & 0xFF));
+	return data;
+}
+
+/// <summary>
+/// PNG encoded RGBA image with a gradient and noise, so it does not compress to almost nothing
+/// </summary>
+static vector<unsigned char> CreateTestPNG(unsigned int width, unsigned int height)
+{
+	vector<unsigned char> pixels;
+	pixels.reserve(width * height * 4);
+	uint32_t random = 1;
+	for (unsigned int y = 0; y < height; y++)
+		for (unsigned int x = 0; x < width; x++)
+		{
+			random = random * 1664525 + 1013904223;
+			unsigned char noise = (unsigned char)(random >> 28);
+			pixels.insert(pixels.end(), { (unsigned char)(x + noise), (unsigned char)(y + noise), (unsigned char)(x + y), 255 });
+		}
+
+	vector<unsigned char> output;
+	stbi_write_png_to_func([](void* context, void* data, int size)
+		{
+			vector<unsigned char>* output = (vector<unsigned char>*)context;
+			output->insert(output->end(), (unsigned char*)data, (unsigned char*)data + size);
+		}, &output, (int)width, (int)height, 4, pixels.data(), (int)width * 4);
+	return output;
+}
+
+/// <returns>Sum of all bytes, so every byte has to be read</returns>
+static uint64_t TouchBytes(const unsigned char* data, size_t size)
+{
+	uint64_t sum = 0;
+	for (size_t i = 0; i < size; i++)
+		sum += data[i];
+	return sum;
+}
+
+static void WriteFile(const fs::path& path, const vector<unsigned char>& data)
+{
+	ofstream file(path, ios::binary | ios::trunc);
+	file.write((const char*)data.data(), data.size());
+}
+
+static void DecodeRGB565(uint16_t value, int* colour)
+{
+	colour[0] = ((value >> 11) & 0x1F) * 255 / 31;
+	colour[1] = ((value >> 5) & 0x3F) * 255 / 63;
+	colour[2] = (value & 0x1F) * 255 / 31;
+}
+
+/// <summary>
+/// Decodes the colour of a single pixel in a 4-colour BC1 block
+/// </summary>
+static void DecodeBC1Pixel(const unsigned char* block, unsigned int index, int* colour)
+{
+	int palette[4][3];
+	DecodeRGB565(block[0] | (block[1] << 8), palette[0]);
+	DecodeRGB565(block[2] | (block[3] << 8), palette[1]);
+	for (int c = 0; c < 3; c++)
+	{
+		palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+		palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+	}
+
+	uint32_t indices = block[4] | (block[5] << 8) | (block[6] << 16) | ((uint32_t)block[7] << 24);
+	unsigned int paletteIndex = (indices >> (index * 2)) & 0x3;
+	for (int c = 0; c < 3; c++)
+		colour[c] = palette[paletteIndex][c];
+}
+
+TEST(TextureCooker, LevelCount)
+{
+	EXPECT_EQ(TextureCooker::GetLevelCount(1, 1), 1u);
+	EXPECT_EQ(TextureCooker::GetLevelCount(2, 2), 2u);
+	EXPECT_EQ(TextureCooker::GetLevelCount(256, 256), 9u);
+	EXPECT_EQ(TextureCooker::GetLevelCount(256, 16), 9u);
+	EXPECT_EQ(TextureCooker::GetLevelCount(5, 3), 3u);
+}
+
+TEST(TextureCooker, LevelSize)
+{
+	EXPECT_EQ(TextureCooker::GetLevelSize(CookedTextureFormat::R8, 4, 4), 16u);
+	EXPECT_EQ(TextureCooker::GetLevelSize(CookedTextureFormat::RGBA8, 4, 4), 64u);
+	EXPECT_EQ(TextureCooker::GetLevelSize(CookedTextureFormat::RGB32F, 2, 2), 48u);
+
+	// Compressed levels are rounded up to whole blocks
+	EXPECT_EQ(TextureCooker::GetLevelSize(CookedTextureFormat::BC1, 4, 4), 8u);
+	EXPECT_EQ(TextureCooker::GetLevelSize(CookedTextureFormat::BC1, 1, 1), 8u);
+	EXPECT_EQ(TextureCooker::GetLevelSize(CookedTextureFormat::BC3, 8, 5), 64u);
+}
+
+TEST(TextureCooker, CookImage)
+{
+	vector<unsigned char> cooked;
+	ASSERT_TRUE(TextureCooker::Cook(CreateTestImage(16, 8), {}, cooked));
+	EXPECT_TRUE(TextureCooker::IsCooked(cooked));
+
+	CookedTextureHeader header;
+	vector<CookedTextureLevel> levels;
+	ASSERT_TRUE(TextureCooker::Read(cooked, header, levels));
+
+	EXPECT_EQ(header.Format, CookedTextureFormat::R8);
+	EXPECT_EQ(header.Width, 16u);
+	EXPECT_EQ(header.Height, 8u);
+	ASSERT_EQ(header.LevelCount, 5u);
+	ASSERT_EQ(levels.size(), 5u);
+
+	for (unsigned int i = 0; i < levels.size(); i++)
+	{
+		EXPECT_EQ(levels[i].Width, std::max(16u >> i, 1u));
+		EXPECT_EQ(levels[i].Height, std::max(8u >> i, 1u));
+		EXPECT_EQ(levels[i].Size, TextureCooker::GetLevelSize(header.Format, levels[i].Width, levels[i].Height));
+		EXPECT_EQ(levels[i].Offset % TextureCooker::DataAlignment, 0u);
+	}
+}
+
+TEST(TextureCooker, NoMips)
+{
+	TextureCookSettings settings;
+	settings.GenerateMips = false;
+
+	vector<unsigned char> cooked;
+	ASSERT_TRUE(TextureCooker::Cook(CreateTestImage(16, 16), settings, cooked));
+
+	CookedTextureHeader header;
+	vector<CookedTextureLevel> levels;
+	ASSERT_TRUE(TextureCooker::Read(cooked, header, levels));
+	EXPECT_EQ(header.LevelCount, 1u);
+}
+
+TEST(TextureCooker, MipAverage)
+{
+	unsigned char pixels[] = { 0, 100, 200, 100 };
+	TexturePixels input;
+	input.Data = pixels;
+	input.Resolution = { 2, 2 };
+	input.Channels = 1;
+
+	vector<unsigned char> cooked;
+	ASSERT_TRUE(TextureCooker::Cook(input, {}, cooked));
+
+	CookedTextureHeader header;
+	vector<CookedTextureLevel> levels;
+	ASSERT_TRUE(TextureCooker::Read(cooked, header, levels));
+	ASSERT_EQ(levels.size(), 2u);
+	EXPECT_EQ(cooked[levels[1].Offset], 100);
+}
+
+TEST(TextureCooker, RejectInvalidData)
+{
+	CookedTextureHeader header;
+	vector<CookedTextureLevel> levels;
+
+	vector<unsigned char> source = CreateTestImage(4, 4);
+	EXPECT_FALSE(TextureCooker::IsCooked(source));
+	EXPECT_FALSE(TextureCooker::Read(source, header, levels));
+	EXPECT_FALSE(TextureCooker::Read({}, header, levels));
+
+	vector<unsigned char> cooked;
+	EXPECT_FALSE(TextureCooker::Cook(vector<unsigned char>{ 1, 2, 3 }, {}, cooked));
+	ASSERT_TRUE(TextureCooker::Cook(source, {}, cooked));
+	ASSERT_TRUE(TextureCooker::Read(cooked, header, levels));
+
+	// Truncated level data
+	vector<unsigned char> truncated(cooked.begin(), cooked.begin() + (levels.back().Offset + levels.back().Size - 1));
+	EXPECT_FALSE(TextureCooker::Read(truncated, header, levels));
+
+	// Unknown version
+	vector<unsigned char> newerVersion = cooked;
+	reinterpret_cast<CookedTextureHeader*>(newerVersion.data())->Version = TextureCooker::FileVersion + 1;
+	EXPECT_FALSE(TextureCooker::Read(newerVersion, header, levels));
+}
+
+TEST(TextureCooker, CompressBC1)
+{
+	const unsigned int Size = 8;
+	vector<unsigned char> rgba(Size * Size * 4);
+	for (unsigned int y = 0; y < Size; y++)
+		for (unsigned int x = 0; x < Size; x++)
+		{
+			unsigned char* pixel = &rgba[(y * Size + x) * 4];
+			// Gradient between two colours, which BC1 endpoints can represent
+			float t = (x % 4) / 3.0f;
+			pixel[0] = (unsigned char)(255 * (1.0f - t));
+			pixel[1] = (unsigned char)(64 + 128 * t);
+			pixel[2] = (unsigned char)((y / 4) * 128);
+			pixel[3] = 255;
+		}
+
+	vector<unsigned char> compressed(TextureCooker::GetLevelSize(CookedTextureFormat::BC1, Size, Size));
+	TextureCooker::CompressBC1(rgba.data(), Size, Size, compressed.data());
+
+	int maxError = 0;
+	for (unsigned int y = 0; y < Size; y++)
+		for (unsigned int x = 0; x < Size; x++)
+		{
+			int colour[3];
+			const unsigned char* block = &compressed[((y / 4) * (Size / 4) + (x / 4)) * 8];
+			DecodeBC1Pixel(block, (y % 4) * 4 + (x % 4), colour);
+
+			for (int c = 0; c < 3; c++)
+				maxError = std::max(maxError, std::abs(colour[c] - rgba[(y * Size + x) * 4 + c]));
+		}
+	EXPECT_LE(maxError, 8);
+}
+
+TEST(TextureCooker, CompressBC3Alpha)
+{
+	vector<unsigned char> rgba(4 * 4 * 4, 255);
+	for (unsigned int i = 0; i < 16; i++)
+		rgba[i * 4 + 3] = i < 8 ? 0 : 255;
+
+	unsigned char compressed[16];
+	TextureCooker::CompressBC3(rgba.data(), 4, 4, compressed);
+
+	unsigned char alpha0 = compressed[0], alpha1 = compressed[1];
+	EXPECT_EQ(alpha0, 255);
+	EXPECT_EQ(alpha1, 0);
+
+	uint64_t indices = 0;
+	for (unsigned int i = 0; i < 6; i++)
+		indices |= (uint64_t)compressed[2 + i] << (i * 8);
+	for (unsigned int i = 0; i < 16; i++)
+	{
+		uint64_t index = (indices >> (i * 3)) & 0x7;
+		EXPECT_EQ(index, i < 8 ? 1u : 0u);
+	}
+}
+
+TEST(TextureCooker, CompressedCook)
+{
+	const unsigned int Size = 32;
+	vector<unsigned char> rgba(Size * Size * 4, 200);
+	TexturePixels input;
+	input.Data = rgba.data();
+	input.Resolution = { (int)Size, (int)Size };
+	input.Channels = 4;
+
+	TextureCookSettings settings;
+	settings.Compress = true;
+
+	vector<unsigned char> cooked;
+	ASSERT_TRUE(TextureCooker::Cook(input, settings, cooked));
+
+	CookedTextureHeader header;
+	vector<CookedTextureLevel> levels;
+	ASSERT_TRUE(TextureCooker::Read(cooked, header, levels));
+	EXPECT_EQ(header.Format, CookedTextureFormat::BC3);
+	EXPECT_EQ(levels.size(), TextureCooker::GetLevelCount(Size, Size));
+	EXPECT_EQ(levels.back().Size, 16u);
+}
+
+/// <summary>
+/// Compares loading a PNG from disk and decoding it, as Texture does at runtime, against reading a cooked texture
+/// and accessing every mip level. Mips of the decoded source are generated on the GPU, so are not included.
+/// </summary>
+TEST(TextureCooker, DISABLED_LoadBenchmark)
+{
+	const unsigned int Size = 1024;
+	const unsigned int Iterations = 10;
+
+	fs::path directory = fs::temp_directory_path() / "YonaiTest_TextureCooker";
+	fs::remove_all(directory);
+	fs::create_directories(directory);
+
+	vector<unsigned char> source = CreateTestPNG(Size, Size);
+	vector<unsigned char> cooked;
+	ASSERT_TRUE(TextureCooker::Cook(source, {}, cooked));
+
+	fs::path sourcePath = directory / "Gradient.png";
+	fs::path cookedPath = directory / "Gradient.ytex";
+	WriteFile(sourcePath, source);
+	WriteFile(cookedPath, cooked);
+
+	uint64_t checksum = 0;
+	auto start = chrono::high_resolution_clock::now();
+	for (unsigned int i = 0; i < Iterations; i++)
+	{
+		MappedFile file(sourcePath.string());
+		TexturePixels pixels;
+		ASSERT_TRUE(Texture::Decode(file.GetSpan(), false, pixels));
+		ASSERT_EQ(pixels.Resolution.x, (int)Size);
+		ASSERT_EQ(pixels.Resolution.y, (int)Size);
+
+		checksum += TouchBytes((const unsigned char*)pixels.Data, (size_t)Size * Size * pixels.Channels);
+		Texture::FreePixels(pixels);
+	}
+	auto sourceDuration = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start) / Iterations;
+
+	start = chrono::high_resolution_clock::now();
+	for (unsigned int i = 0; i < Iterations; i++)
+	{
+		MappedFile file(cookedPath.string());
+		CookedTextureHeader header;
+		vector<CookedTextureLevel> levels;
+		ASSERT_TRUE(TextureCooker::Read(file.GetSpan(), header, levels));
+		ASSERT_EQ(levels.size(), TextureCooker::GetLevelCount(Size, Size));
+
+		for (const CookedTextureLevel& level : levels)
+			checksum += TouchBytes(file.GetData() + level.Offset, level.Size);
+	}
+	auto cookedDuration = chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start) / Iterations;
+
+	fs::remove_all(directory);
+
+	spdlog::info("{}x{} texture - PNG decode {:.3f}ms, cooked read with mips {:.3f}ms (checksum {})", Size, Size, sourceDuration.count(), cookedDuration.count(), checksum);
+	EXPECT_LT(cookedDuration.count(), sourceDuration.count());
+}
@@ -0,0 +1,61 @@
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <Yonai/Graphics/Texture.hpp>
+#include <Yonai/Graphics/TextureLoader.hpp>
+
+using namespace std;
+using namespace Yonai::Graphics;
+
+/// <summary>
+/// 2x2 greyscale PGM image
+/// </summary>
+static vector<unsigned char> CreateTestImage()
+{
+	string header = "P5 2 2 255\n";
+	vector<unsigned char> data(header.begin(), header.end());
+	for (unsigned char value : { 0, 64, 128, 255 })
+		data.push_back(value);
+	return data;
+}
+
+TEST(TextureLoader, DecodeImage)
+{
+	TexturePixels pixels;
+	ASSERT_TRUE(Texture::Decode(CreateTestImage(), false, pixels));
+
+	EXPECT_NE(pixels.Data, nullptr);
+	EXPECT_EQ(pixels.Resolution.x, 2);
+	EXPECT_EQ(pixels.Resolution.y, 2);
+	EXPECT_EQ(pixels.Channels, 1);
+	EXPECT_FALSE(pixels.HDR);
+
+	Texture::FreePixels(pixels);
+	EXPECT_EQ(pixels.Data, nullptr);
+}
+
+TEST(TextureLoader, DecodeInvalidData)
+{
+	TexturePixels pixels;
+	EXPECT_FALSE(Texture::Decode({}, false, pixels));
+	EXPECT_FALSE(Texture::Decode(vector<unsigned char>{ 1, 2, 3, 4 }, false, pixels));
+	EXPECT_EQ(pixels.Data, nullptr);
+}
+
+TEST(TextureLoader, CancelledJobsAreDiscarded)
+{
+	bool callbackInvoked = false;
+	for (unsigned int i = 0; i < 8; i++)
+	{
+		auto job = make_shared<TextureLoadJob>();
+		job->Data = CreateTestImage();
+		job->Callback = [&callbackInvoked](Texture*, bool) { callbackInvoked = true; };
+		job->Cancelled = true;
+		TextureLoader::Enqueue(job);
+	}
+
+	// Cancelled jobs never reach the GPU, so no context is required
+	TextureLoader::Flush();
+	EXPECT_EQ(TextureLoader::GetPendingCount(), 0);
+	EXPECT_FALSE(callbackInvoked);
+}
@@ -0,0 +1,66 @@
+#include <atomic>
+#include <vector>
+#include <gtest/gtest.h>
+#include <Yonai/ThreadPool.hpp>
+
+using namespace std;
+using namespace Yonai;
+
+TEST(ThreadPool, ExecutesAllJobs)
+{
+	ThreadPool pool(4);
+	EXPECT_EQ(pool.GetThreadCount(), 4);
+
+	atomic_uint counter = 0;
+	for (unsigned int i = 0; i < 1000; i++)
+		pool.Enqueue([&counter]() { counter++; });
+
+	pool.Wait();
+	EXPECT_EQ(counter, 1000);
+}
+
+TEST(ThreadPool, DefaultThreadCount)
+{
+	ThreadPool pool;
+	EXPECT_GE(pool.GetThreadCount(), 1);
+}
+
+TEST(ThreadPool, DestructorFinishesQueuedJobs)
+{
+	atomic_uint counter = 0;
+	{
+		ThreadPool pool(2);
+		for (unsigned int i = 0; i < 100; i++)
+			pool.Enqueue([&counter]() { counter++; });
+	}
+	EXPECT_EQ(counter, 100);
+}
+
+TEST(ThreadPool, WaitWithoutJobs)
+{
+	ThreadPool pool(1);
+	pool.Wait();
+	SUCCEED();
+}
+
+TEST(ThreadPool, ParallelForProcessesEachIndex)
+{
+	ThreadPool pool(4);
+
+	vector<unsigned int> visits(1000, 0);
+	pool.ParallelFor(visits.size(), [&visits](size_t i) { visits[i]++; });
+
+	for (unsigned int count : visits)
+		EXPECT_EQ(count, 1);
+}
+
+TEST(ThreadPool, ParallelForInsideJob)
+{
+	ThreadPool pool(1);
+
+	atomic_uint counter = 0;
+	pool.Enqueue([&pool, &counter]() { pool.ParallelFor(100, [&counter](size_t) { counter++; }); });
+	pool.Wait();
+
+	EXPECT_EQ(counter, 100);
+}
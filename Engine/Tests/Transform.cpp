@@ -228,4 +228,41 @@ TEST(Transform, ModelMatrixDecompose)
 	EXPECT_EQ(position, child.GetGlobalPosition());
 	EXPECT_EQ(euler, child.GetGlobalEulerRotation());
 	EXPECT_EQ(scale, child.GetGlobalScale());
-}
\ No newline at end of file
+}
+
+TEST(Transform, LastChange)
+{
+	Yonai::Components::Transform parent, child, other;
+	child.SetParent(&parent);
+
+	uint64_t change = child.GetLastChange();
+	EXPECT_EQ(child.GetLastChange(), change);
+
+	// Reading does not count as a change
+	child.GetGlobalPosition();
+	child.GetModelMatrix();
+	EXPECT_EQ(child.GetLastChange(), change);
+
+	child.SetPosition(glm::vec3(1, 2, 3));
+	EXPECT_GT(child.GetLastChange(), change);
+	change = child.GetLastChange();
+
+	// Moving a parent changes its children
+	parent.SetRotation(glm::vec3(0, 90, 0));
+	EXPECT_GT(child.GetLastChange(), change);
+	change = child.GetLastChange();
+
+	// Unrelated transforms do not
+	other.SetScale(glm::vec3(2));
+	EXPECT_EQ(child.GetLastChange(), change);
+
+	child.SetParent(&other);
+	EXPECT_GT(child.GetLastChange(), change);
+
+	// Changes reach every level below the changed transform
+	Yonai::Components::Transform grandchild;
+	grandchild.SetParent(&child);
+	change = grandchild.GetLastChange();
+	other.SetPosition(glm::vec3(1));
+	EXPECT_GT(grandchild.GetLastChange(), change);
+}
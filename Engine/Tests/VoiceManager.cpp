@@ -0,0 +1,166 @@
+#include <chrono>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
+#include <Yonai/Audio/VoiceManager.hpp>
+
+using namespace std;
+using namespace Yonai;
+
+static AudioVoice MakeVoice(float audibility, int priority = 0, bool real = false)
+{
+	AudioVoice voice;
+	voice.Audibility = audibility;
+	voice.Priority = priority;
+	voice.Real = real;
+	return voice;
+}
+
+static unsigned int CountReal(const vector<AudioVoice>& voices)
+{
+	unsigned int count = 0;
+	for (const AudioVoice& voice : voices)
+		count += voice.ShouldBeReal ? 1 : 0;
+	return count;
+}
+
+TEST(VoiceManager, LimitsRealVoices)
+{
+	VoiceManager manager(4);
+	vector<AudioVoice> voices;
+	for (int i = 0; i < 10; i++)
+		voices.push_back(MakeVoice(0.1f * (i + 1)));
+
+	EXPECT_EQ(manager.Assign(voices), 4u);
+	EXPECT_EQ(manager.GetRealCount(), 4u);
+	EXPECT_EQ(manager.GetVirtualCount(), 6u);
+	EXPECT_EQ(manager.GetPromotions(), 4u);
+	EXPECT_EQ(manager.GetDemotions(), 0u);
+
+	// Loudest voices are mixed
+	for (int i = 0; i < 10; i++)
+		EXPECT_EQ(voices[i].ShouldBeReal, i >= 6) << "Voice " << i;
+}
+
+TEST(VoiceManager, PriorityBeforeAudibility)
+{
+	VoiceManager manager(2);
+	vector<AudioVoice> voices =
+	{
+		MakeVoice(1.0f),
+		MakeVoice(0.01f, 10),
+		MakeVoice(0.9f),
+		MakeVoice(0.02f, 5)
+	};
+
+	manager.Assign(voices);
+	EXPECT_FALSE(voices[0].ShouldBeReal);
+	EXPECT_TRUE(voices[1].ShouldBeReal);
+	EXPECT_FALSE(voices[2].ShouldBeReal);
+	EXPECT_TRUE(voices[3].ShouldBeReal);
+}
+
+TEST(VoiceManager, InaudibleVoicesAreVirtual)
+{
+	VoiceManager manager(8);
+	manager.SetAudibilityThreshold(0.001f);
+
+	vector<AudioVoice> voices = { MakeVoice(0.5f), MakeVoice(0.0f, 100), MakeVoice(0.0005f, 0, true) };
+	EXPECT_EQ(manager.Assign(voices), 1u);
+	EXPECT_TRUE(voices[0].ShouldBeReal);
+	EXPECT_FALSE(voices[1].ShouldBeReal);
+	EXPECT_FALSE(voices[2].ShouldBeReal);
+	EXPECT_EQ(manager.GetDemotions(), 1u);
+}
+
+TEST(VoiceManager, Hysteresis)
+{
+	VoiceManager manager(1);
+	manager.SetHysteresis(0.25f);
+
+	// Slightly louder virtual voice does not replace the real voice
+	vector<AudioVoice> voices = { MakeVoice(0.5f, 0, true), MakeVoice(0.55f) };
+	manager.Assign(voices);
+	EXPECT_TRUE(voices[0].ShouldBeReal);
+	EXPECT_FALSE(voices[1].ShouldBeReal);
+	EXPECT_EQ(manager.GetPromotions(), 0u);
+
+	// Much louder voice does
+	voices[1].Audibility = 0.7f;
+	manager.Assign(voices);
+	EXPECT_FALSE(voices[0].ShouldBeReal);
+	EXPECT_TRUE(voices[1].ShouldBeReal);
+	EXPECT_EQ(manager.GetPromotions(), 1u);
+	EXPECT_EQ(manager.GetDemotions(), 1u);
+}
+
+TEST(VoiceManager, Unlimited)
+{
+	VoiceManager manager(0);
+	vector<AudioVoice> voices(100, MakeVoice(0.5f));
+	EXPECT_EQ(manager.Assign(voices), 100u);
+	EXPECT_EQ(manager.GetVirtualCount(), 0u);
+
+	voices.clear();
+	EXPECT_EQ(manager.Assign(voices), 0u);
+}
+
+TEST(VoiceManager, Attenuation)
+{
+	const float Epsilon = 0.0001f;
+
+	EXPECT_NEAR(VoiceManager::GetAttenuation(ma_attenuation_model_none, 100.0f, 1.0f, 10.0f, 1.0f, 0.0f, 1.0f), 1.0f, Epsilon);
+
+	// Closer than minimum distance is full volume
+	EXPECT_NEAR(VoiceManager::GetAttenuation(ma_attenuation_model_inverse, 0.5f, 1.0f, 100.0f, 1.0f, 0.0f, 1.0f), 1.0f, Epsilon);
+	EXPECT_NEAR(VoiceManager::GetAttenuation(ma_attenuation_model_inverse, 2.0f, 1.0f, 100.0f, 1.0f, 0.0f, 1.0f), 0.5f, Epsilon);
+
+	EXPECT_NEAR(VoiceManager::GetAttenuation(ma_attenuation_model_linear, 5.5f, 1.0f, 10.0f, 1.0f, 0.0f, 1.0f), 0.5f, Epsilon);
+	EXPECT_NEAR(VoiceManager::GetAttenuation(ma_attenuation_model_linear, 50.0f, 1.0f, 10.0f, 1.0f, 0.0f, 1.0f), 0.0f, Epsilon);
+
+	EXPECT_NEAR(VoiceManager::GetAttenuation(ma_attenuation_model_exponential, 2.0f, 1.0f, 100.0f, 1.0f, 0.0f, 1.0f), 0.5f, Epsilon);
+	EXPECT_NEAR(VoiceManager::GetAttenuation(ma_attenuation_model_exponential, 4.0f, 1.0f, 100.0f, 2.0f, 0.0f, 1.0f), 1.0f / 16.0f, Epsilon);
+
+	// Clamped to gain range, and beyond maximum distance
+	EXPECT_NEAR(VoiceManager::GetAttenuation(ma_attenuation_model_inverse, 1000.0f, 1.0f, 100.0f, 1.0f, 0.2f, 1.0f), 0.2f, Epsilon);
+	EXPECT_NEAR(VoiceManager::GetAttenuation(ma_attenuation_model_inverse, 1000.0f, 1.0f, 4.0f, 1.0f, 0.0f, 1.0f), 0.25f, Epsilon);
+}
+
+/// <summary>
+/// Assigns voices for thousands of playing sources, as each audio update would
+/// </summary>
+TEST(VoiceManager, DISABLED_AssignBenchmark)
+{
+	const unsigned int VoiceCount = 2000;
+	const unsigned int MaxRealVoices = 64;
+	const unsigned int Iterations = 500;
+
+	mt19937 random(1234);
+	uniform_real_distribution<float> audibility(0.0f, 1.0f);
+	uniform_int_distribution<int> priority(0, 3);
+
+	vector<AudioVoice> voices(VoiceCount);
+	for (AudioVoice& voice : voices)
+		voice = MakeVoice(audibility(random), priority(random));
+
+	VoiceManager manager(MaxRealVoices);
+	unsigned int changes = 0;
+	auto start = chrono::high_resolution_clock::now();
+	for (unsigned int i = 0; i < Iterations; i++)
+	{
+		// Sources move, changing audibility
+		for (unsigned int j = i % 16; j < VoiceCount; j += 16)
+			voices[j].Audibility = audibility(random);
+
+		manager.Assign(voices);
+		changes += manager.GetPromotions() + manager.GetDemotions();
+		for (AudioVoice& voice : voices)
+			voice.Real = voice.ShouldBeReal;
+	}
+	auto duration = chrono::duration<double, micro>(chrono::high_resolution_clock::now() - start);
+
+	EXPECT_EQ(CountReal(voices), MaxRealVoices);
+	spdlog::info("{} voices, {} real - {:.1f}us per assign, {:.2f} voices changed per assign",
+		VoiceCount, MaxRealVoices, duration.count() / Iterations, changes / (double)Iterations);
+}
@@ -0,0 +1,91 @@
+#include <string>
+#include <iostream>
+#include <algorithm>
+#include <filesystem>
+#include <Yonai/Graphics/TextureCooker.hpp>
+
+using namespace std;
+using namespace Yonai::Graphics;
+
+namespace fs = std::filesystem;
+
+const string SupportedExtensions[] = { ".png", ".jpg", ".jpeg", ".tga", ".bmp", ".psd", ".gif", ".hdr" };
+
+bool IsSupportedImage(const fs::path& path)
+{
+	string extension = path.extension().string();
+	transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+	return find(begin(SupportedExtensions), end(SupportedExtensions), extension) != end(SupportedExtensions);
+}
+
+bool CookFile(const fs::path& input, const fs::path& output, TextureCookSettings settings)
+{
+	string extension = input.extension().string();
+	transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+	if (extension == ".hdr")
+		settings.HDR = true;
+
+	if (output.has_parent_path())
+		fs::create_directories(output.parent_path());
+
+	bool success = TextureCooker::CookFile(input.string(), output.string(), settings);
+	cout << (success ? "Cooked " : "Failed ") << input.string() << " -> " << output.string() << endl;
+	return success;
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 3)
+	{
+		cout << "Usage: " << argv[0] << " [options] <Input> <Output>" << endl;
+		cout << "Input can be a single image, or a directory that is cooked recursively in to the output directory." << endl;
+		cout << "Options:" << endl;
+		cout << " -compress\tBlock compress 8-bit RGB(A) textures to BC1/BC3" << endl;
+		cout << " -nomips\tOnly store the base level" << endl;
+		cout << " -hdr\t\tDecode images as floating point, always set for .hdr files" << endl;
+		return -1;
+	}
+
+	fs::path input = argv[argc - 2];
+	fs::path output = argv[argc - 1];
+
+	TextureCookSettings settings;
+	for (int i = 1; i < argc - 2; i++)
+	{
+		string arg(argv[i]);
+		if (arg == "-compress")
+			settings.Compress = true;
+		else if (arg == "-nomips")
+			settings.GenerateMips = false;
+		else if (arg == "-hdr")
+			settings.HDR = true;
+		else
+			cerr << "Unknown option '" << arg << "'" << endl;
+	}
+
+	if (!fs::exists(input))
+	{
+		cerr << "Input '" << input.string() << "' could not be found" << endl;
+		return -2;
+	}
+
+	if (!fs::is_directory(input))
+		return CookFile(input, output, settings) ? 0 : -3;
+
+	unsigned int cooked = 0, failed = 0;
+	for (fs::recursive_directory_iterator it(input), end; it != end; it++)
+	{
+		if (!it->is_regular_file() || !IsSupportedImage(it->path()))
+			continue;
+
+		// Keep original filename, so resource paths remain valid
+		fs::path outputPath = output / fs::relative(it->path(), input);
+		if (CookFile(it->path(), outputPath, settings))
+			cooked++;
+		else
+			failed++;
+	}
+
+	cout << "Cooked " << cooked << " texture(s), " << failed << " failed" << endl;
+	return failed > 0 ? -3 : 0;
+}